@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include <chunk_pool.hpp>
+
+extern "C"
+{
+#include <sys/mman.h>
+}
+
+namespace
+{
+/*
+ * Chunks a thread keeps per chunk size before returning them to the pool.
+ */
+constexpr std::size_t thread_cache_chunks = 16;
+
+/*
+ * Chunks moved from the shared list to a thread at once.
+ */
+constexpr std::size_t refill_chunks = 4;
+
+std::atomic<uint64_t> next_pool_id{1};
+
+/*
+ * Chunks handed out to one OTF2 buffer, kept in its perBufferData.
+ */
+struct BufferChunks
+{
+    uint64_t            chunk_size;
+    std::vector<void *> chunks;
+};
+} // namespace
+
+const OTF2_MemoryCallbacks ChunkPool::m_callbacks = {.otf2_allocate = ChunkPool::otf2_allocate,
+                                                     .otf2_free_all = ChunkPool::otf2_free_all};
+
+/*
+ * With a memory limit, threads do not cache chunks, a chunk cached by one
+ * thread could not be used by another one reaching the limit.
+ */
+ChunkPool::ChunkPool(bool huge_pages, std::size_t buffer_chunks, std::size_t memory_limit)
+    : m_id(next_pool_id++), m_huge_pages(huge_pages), m_buffer_chunks(std::max<std::size_t>(buffer_chunks, 1)),
+      m_memory_limit(memory_limit), m_cache_chunks(memory_limit == 0 ? thread_cache_chunks : 0)
+{
+}
+
+ChunkPool::~ChunkPool()
+{
+    for (auto *slab : m_slabs)
+    {
+        std::free(slab);
+    }
+}
+
+void
+ChunkPool::install(OTF2_Archive *archive)
+{
+    OTF2_Archive_SetMemoryCallbacks(archive, &m_callbacks, this);
+}
+
+void *
+ChunkPool::allocate(uint64_t chunk_size, bool required)
+{
+    auto &cached = thread_cache().chunks[chunk_size];
+    if (cached.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto &                      shared = m_shared[chunk_size];
+        if (shared.empty())
+        {
+            return allocate_slab(chunk_size, required);
+        }
+        auto count = std::min(m_cache_chunks == 0 ? 1 : refill_chunks, shared.size());
+        cached.insert(cached.end(), shared.end() - count, shared.end());
+        shared.resize(shared.size() - count);
+    }
+    void *chunk = cached.back();
+    cached.pop_back();
+    return chunk;
+}
+
+void
+ChunkPool::release(void *chunk, uint64_t chunk_size)
+{
+    auto &cached = thread_cache().chunks[chunk_size];
+    cached.push_back(chunk);
+    if (cached.size() > m_cache_chunks)
+    {
+        /* keep the most recently used chunks, those are likely still cached */
+        auto                        count = cached.size() - m_cache_chunks / 2;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto &                      shared = m_shared[chunk_size];
+        shared.insert(shared.end(), cached.begin(), cached.begin() + count);
+        cached.erase(cached.begin(), cached.begin() + count);
+    }
+}
+
+ChunkPool::ThreadCache &
+ChunkPool::thread_cache()
+{
+    /*
+     * Pools are identified by an id instead of their address, a new pool
+     * may reuse the address of a destroyed one.
+     */
+    static thread_local std::unordered_map<uint64_t, ThreadCache *> caches;
+
+    auto search = caches.find(m_id);
+    if (search != caches.end())
+    {
+        return *search->second;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_caches.push_back(std::make_unique<ThreadCache>());
+    caches.emplace(m_id, m_caches.back().get());
+    return *m_caches.back();
+}
+
+/*
+ * Allocate a slab of at least huge_page_size bytes, return its first chunk
+ * and put the others into the shared list. Called with m_mutex held.
+ */
+void *
+ChunkPool::allocate_slab(uint64_t chunk_size, bool required)
+{
+    std::size_t count     = std::max<std::size_t>(1, huge_page_size / chunk_size);
+    std::size_t slab_size = count * chunk_size;
+    if (m_huge_pages)
+    {
+        slab_size = (slab_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+    if (!required && m_memory_limit != 0 && reserved() + slab_size > m_memory_limit)
+    {
+        return nullptr;
+    }
+
+    char *slab = nullptr;
+    if (m_huge_pages)
+    {
+        slab = static_cast<char *>(std::aligned_alloc(huge_page_size, slab_size));
+        if (slab != nullptr)
+        {
+            madvise(slab, slab_size, MADV_HUGEPAGE);
+        }
+    }
+    else
+    {
+        slab = static_cast<char *>(std::malloc(slab_size));
+    }
+    if (slab == nullptr)
+    {
+        return nullptr;
+    }
+    m_slabs.push_back(slab);
+    m_reserved.fetch_add(slab_size, std::memory_order_relaxed);
+
+    auto &shared = m_shared[chunk_size];
+    for (std::size_t i = 1; i < count; i++)
+    {
+        shared.push_back(slab + i * chunk_size);
+    }
+    return slab;
+}
+
+void *
+ChunkPool::otf2_allocate(void *           userData,
+                         OTF2_FileType    fileType,
+                         OTF2_LocationRef location,
+                         void **          perBufferData,
+                         uint64_t         chunkSize)
+{
+    auto *pool   = static_cast<ChunkPool *>(userData);
+    auto *buffer = static_cast<BufferChunks *>(*perBufferData);
+    if (buffer == nullptr)
+    {
+        buffer         = new BufferChunks{chunkSize, {}};
+        *perBufferData = buffer;
+    }
+    if (buffer->chunks.size() >= pool->m_buffer_chunks)
+    {
+        /* let OTF2 flush the buffer */
+        return nullptr;
+    }
+
+    /* an empty buffer cannot be flushed, its first chunk is always allocated */
+    void *chunk = pool->allocate(chunkSize, buffer->chunks.empty());
+    if (chunk != nullptr)
+    {
+        buffer->chunks.push_back(chunk);
+    }
+    return chunk;
+}
+
+void
+ChunkPool::otf2_free_all(void *           userData,
+                         OTF2_FileType    fileType,
+                         OTF2_LocationRef location,
+                         void **          perBufferData,
+                         bool             final)
+{
+    auto *pool   = static_cast<ChunkPool *>(userData);
+    auto *buffer = static_cast<BufferChunks *>(*perBufferData);
+    if (buffer == nullptr)
+    {
+        return;
+    }
+
+    for (auto *chunk : buffer->chunks)
+    {
+        pool->release(chunk, buffer->chunk_size);
+    }
+    buffer->chunks.clear();
+
+    if (final)
+    {
+        delete buffer;
+        *perBufferData = nullptr;
+    }
+}
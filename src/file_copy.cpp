@@ -0,0 +1,143 @@
+#include <cerrno>
+#include <system_error>
+
+#include <file_copy.hpp>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+namespace
+{
+/*
+ * Closes a file descriptor when leaving the scope.
+ */
+class FileDescriptor
+{
+  public:
+    explicit FileDescriptor(int fd) : m_fd(fd)
+    {
+    }
+    ~FileDescriptor()
+    {
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+    }
+
+    FileDescriptor(const FileDescriptor &) = delete;
+    FileDescriptor &
+    operator=(const FileDescriptor &) = delete;
+
+    inline int
+    get() const
+    {
+        return m_fd;
+    }
+
+  private:
+    int m_fd;
+};
+
+bool
+copy_range(int source, int target, off_t size)
+{
+    off_t copied = 0;
+    while (copied < size)
+    {
+        ssize_t bytes = copy_file_range(source, nullptr, target, nullptr, size - copied, 0);
+        if (bytes <= 0)
+        {
+            return false;
+        }
+        copied += bytes;
+    }
+    return true;
+}
+
+bool
+copy_buffered(int source, int target)
+{
+    char buffer[64 * 1024];
+    if (lseek(source, 0, SEEK_SET) < 0 || lseek(target, 0, SEEK_SET) < 0 || ftruncate(target, 0) < 0)
+    {
+        return false;
+    }
+    while (true)
+    {
+        ssize_t bytes = read(source, buffer, sizeof(buffer));
+        if (bytes == 0)
+        {
+            return true;
+        }
+        if (bytes < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        for (ssize_t written = 0; written < bytes;)
+        {
+            ssize_t count = write(target, buffer + written, bytes - written);
+            if (count < 0 && errno != EINTR)
+            {
+                return false;
+            }
+            written += count > 0 ? count : 0;
+        }
+    }
+}
+
+bool
+copy_data(int source, int target, off_t size)
+{
+    if (ioctl(target, FICLONE, source) == 0)
+    {
+        return true;
+    }
+    if (copy_range(source, target, size))
+    {
+        return true;
+    }
+    /*
+     * copy_file_range() fails e.g. across file systems on older kernels,
+     * a partial copy is restarted from the beginning.
+     */
+    return copy_buffered(source, target);
+}
+} // namespace
+
+bool
+clone_file(const std::filesystem::path &source, const std::filesystem::path &target)
+{
+    FileDescriptor in(open(source.c_str(), O_RDONLY | O_CLOEXEC));
+    struct stat    status;
+    if (in.get() < 0 || fstat(in.get(), &status) < 0)
+    {
+        return false;
+    }
+
+    bool copied = false;
+    {
+        FileDescriptor out(open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666));
+        if (out.get() < 0)
+        {
+            return false;
+        }
+        copied = copy_data(in.get(), out.get(), status.st_size);
+    }
+    if (!copied)
+    {
+        std::error_code ec;
+        std::filesystem::remove(target, ec);
+    }
+    return copied;
+}
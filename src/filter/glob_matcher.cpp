@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+
+#include <glob_matcher.hpp>
+
+extern "C"
+{
+#include <fnmatch.h>
+}
+
+namespace
+{
+constexpr uint32_t no_node = std::numeric_limits<uint32_t>::max();
+
+constexpr int fnmatch_flags = FNM_PATHNAME | FNM_LEADING_DIR;
+
+/*
+ * Visited marks of automaton states, reused between matches of a thread.
+ */
+struct StateMarks
+{
+    std::vector<uint32_t> marks;
+    uint32_t              generation = 0;
+
+    inline uint32_t
+    next(std::size_t states)
+    {
+        if (marks.size() < states)
+        {
+            marks.resize(states, 0);
+        }
+        if (++generation == 0)
+        {
+            std::fill(marks.begin(), marks.end(), 0);
+            generation = 1;
+        }
+        return generation;
+    }
+};
+
+bool
+add_char_class(const std::string &name, std::bitset<256> &set)
+{
+    int (*is_class)(int) = nullptr;
+    if (name == "alnum")
+        is_class = isalnum;
+    else if (name == "alpha")
+        is_class = isalpha;
+    else if (name == "blank")
+        is_class = isblank;
+    else if (name == "cntrl")
+        is_class = iscntrl;
+    else if (name == "digit")
+        is_class = isdigit;
+    else if (name == "graph")
+        is_class = isgraph;
+    else if (name == "lower")
+        is_class = islower;
+    else if (name == "print")
+        is_class = isprint;
+    else if (name == "punct")
+        is_class = ispunct;
+    else if (name == "space")
+        is_class = isspace;
+    else if (name == "upper")
+        is_class = isupper;
+    else if (name == "xdigit")
+        is_class = isxdigit;
+    else
+        return false;
+
+    for (int c = 0; c < 256; ++c)
+    {
+        if (is_class(c))
+        {
+            set.set(c);
+        }
+    }
+    return true;
+}
+} // namespace
+
+GlobMatcher::GlobMatcher() : m_trie(1)
+{
+}
+
+GlobMatcher::GlobMatcher(const std::vector<std::string> &patterns) : GlobMatcher()
+{
+    for (const auto &pattern : patterns)
+    {
+        add(pattern);
+    }
+}
+
+std::size_t
+GlobMatcher::add(const std::string &pattern)
+{
+    const std::size_t index = m_patterns.size();
+    m_patterns.push_back(pattern);
+
+    std::vector<Token> tokens;
+    if (!compile(pattern, tokens))
+    {
+        m_fallback.push_back(index);
+        return index;
+    }
+
+    uint32_t    node = 0;
+    std::size_t i    = 0;
+    for (; tokens[i].type == TokenType::Char; ++i)
+    {
+        node = insert_child(node, tokens[i].c);
+    }
+
+    m_trie[node].starts.push_back(static_cast<uint32_t>(m_tokens.size()));
+    for (; i < tokens.size(); ++i)
+    {
+        tokens[i].pattern = static_cast<uint32_t>(index);
+        m_tokens.push_back(tokens[i]);
+    }
+    return index;
+}
+
+bool
+GlobMatcher::match(const std::string &path) const
+{
+    if (run(path, nullptr))
+    {
+        return true;
+    }
+    return std::any_of(m_fallback.begin(), m_fallback.end(), [this, &path](std::size_t i) {
+        return fnmatch(m_patterns[i].c_str(), path.c_str(), fnmatch_flags) == 0;
+    });
+}
+
+void
+GlobMatcher::matches(const std::string &path, std::vector<std::size_t> &indices) const
+{
+    indices.clear();
+    run(path, &indices);
+    for (auto i : m_fallback)
+    {
+        if (fnmatch(m_patterns[i].c_str(), path.c_str(), fnmatch_flags) == 0)
+        {
+            indices.push_back(i);
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+/*
+ * Translate a pattern into tokens terminated by an End token.
+ *
+ * @return false if the pattern has to be matched by fnmatch
+ */
+bool
+GlobMatcher::compile(const std::string &pattern, std::vector<Token> &tokens)
+{
+    std::size_t pos = 0;
+    while (pos < pattern.size())
+    {
+        Token token = {TokenType::Char, static_cast<uint8_t>(pattern[pos]), 0, 0};
+        switch (pattern[pos])
+        {
+        case '\\':
+            /*
+             * fnmatch never matches a trailing backslash, and does not find
+             * an escaped '/' following a '*'.
+             */
+            if (pos + 1 >= pattern.size() || pattern[pos + 1] == '/')
+            {
+                return false;
+            }
+            token.c = static_cast<uint8_t>(pattern[pos + 1]);
+            pos += 2;
+            break;
+        case '?':
+            token.type = TokenType::Any;
+            ++pos;
+            break;
+        case '*':
+            token.type = TokenType::Star;
+            ++pos;
+            if (!tokens.empty() && tokens.back().type == TokenType::Star)
+            {
+                continue;
+            }
+            break;
+        case '[':
+            if (!compile_bracket(pattern, pos, token))
+            {
+                return false;
+            }
+            break;
+        default:
+            ++pos;
+            break;
+        }
+        tokens.push_back(token);
+    }
+    tokens.push_back({TokenType::End, 0, 0, 0});
+    return true;
+}
+
+/*
+ * Translate a bracket expression starting at pos into a Class token.
+ *
+ * @return false if the expression has to be matched by fnmatch
+ */
+bool
+GlobMatcher::compile_bracket(const std::string &pattern, std::size_t &pos, Token &token)
+{
+    static const bool caret_negates = std::getenv("POSIXLY_CORRECT") == nullptr;
+
+    std::bitset<256> set;
+    std::size_t      i      = pos + 1;
+    bool             negate = false;
+    if (i < pattern.size() && (pattern[i] == '!' || (caret_negates && pattern[i] == '^')))
+    {
+        negate = true;
+        ++i;
+    }
+
+    for (bool first = true;; first = false)
+    {
+        if (i >= pattern.size())
+        {
+            /* unterminated */
+            return false;
+        }
+        if (pattern[i] == ']' && !first)
+        {
+            ++i;
+            break;
+        }
+
+        uint8_t low;
+        if (pattern[i] == '\\')
+        {
+            if (i + 1 >= pattern.size())
+            {
+                return false;
+            }
+            low = static_cast<uint8_t>(pattern[i + 1]);
+            i += 2;
+        }
+        else if (pattern[i] == '[' && i + 1 < pattern.size() && pattern[i + 1] == ':')
+        {
+            auto end = pattern.find(":]", i + 2);
+            if (end == std::string::npos || !add_char_class(pattern.substr(i + 2, end - i - 2), set))
+            {
+                return false;
+            }
+            i = end + 2;
+            if (i + 1 < pattern.size() && pattern[i] == '-' && pattern[i + 1] != ']')
+            {
+                return false;
+            }
+            continue;
+        }
+        else if (pattern[i] == '[' && i + 1 < pattern.size() && (pattern[i + 1] == '=' || pattern[i + 1] == '.'))
+        {
+            return false;
+        }
+        else
+        {
+            low = static_cast<uint8_t>(pattern[i]);
+            ++i;
+        }
+
+        uint8_t high = low;
+        if (i + 1 < pattern.size() && pattern[i] == '-' && pattern[i + 1] != ']')
+        {
+            ++i;
+            if (pattern[i] == '\\')
+            {
+                if (i + 1 >= pattern.size())
+                {
+                    return false;
+                }
+                high = static_cast<uint8_t>(pattern[i + 1]);
+                i += 2;
+            }
+            else if (pattern[i] == '[' && i + 1 < pattern.size() &&
+                     (pattern[i + 1] == '=' || pattern[i + 1] == '.' || pattern[i + 1] == ':'))
+            {
+                return false;
+            }
+            else
+            {
+                high = static_cast<uint8_t>(pattern[i]);
+                ++i;
+            }
+        }
+        for (unsigned c = low; c <= high; ++c)
+        {
+            set.set(c);
+        }
+    }
+
+    if (negate)
+    {
+        set.flip();
+    }
+    set.reset('/');
+
+    token.type = TokenType::Class;
+    token.set  = static_cast<uint32_t>(m_sets.size());
+    m_sets.push_back(set);
+    pos = i;
+    return true;
+}
+
+uint32_t
+GlobMatcher::insert_child(uint32_t node, uint8_t c)
+{
+    auto &children = m_trie[node].children;
+    auto  search   = std::lower_bound(
+        children.begin(), children.end(), c, [](const std::pair<uint8_t, uint32_t> &e, uint8_t v) {
+            return e.first < v;
+        });
+    if (search != children.end() && search->first == c)
+    {
+        return search->second;
+    }
+
+    auto child = static_cast<uint32_t>(m_trie.size());
+    children.insert(search, {c, child});
+    m_trie.emplace_back();
+    return child;
+}
+
+uint32_t
+GlobMatcher::find_child(uint32_t node, uint8_t c) const
+{
+    const auto &children = m_trie[node].children;
+    auto        search   = std::lower_bound(
+        children.begin(), children.end(), c, [](const std::pair<uint8_t, uint32_t> &e, uint8_t v) {
+            return e.first < v;
+        });
+    if (search != children.end() && search->first == c)
+    {
+        return search->second;
+    }
+    return no_node;
+}
+
+/*
+ * Walk the path through the trie and the automaton.
+ *
+ * @param indices if null, return at the first match, otherwise append the
+ *                index of every matching pattern
+ */
+bool
+GlobMatcher::run(const std::string &path, std::vector<std::size_t> *indices) const
+{
+    static thread_local StateMarks            marks;
+    static thread_local std::vector<uint32_t> current;
+    static thread_local std::vector<uint32_t> next;
+
+    bool found = false;
+    current.clear();
+    uint32_t generation = marks.next(m_tokens.size());
+
+    /*
+     * Add a state and, as a star may match nothing, the states following
+     * stars.
+     */
+    auto activate = [this, &generation](std::vector<uint32_t> &states, uint32_t state) {
+        while (marks.marks[state] != generation)
+        {
+            marks.marks[state] = generation;
+            states.push_back(state);
+            if (m_tokens[state].type != TokenType::Star)
+            {
+                break;
+            }
+            ++state;
+        }
+    };
+
+    uint32_t node = 0;
+    for (std::size_t i = 0;; ++i)
+    {
+        if (node != no_node)
+        {
+            for (auto start : m_trie[node].starts)
+            {
+                activate(current, start);
+            }
+        }
+
+        if (i == path.size() || path[i] == '/')
+        {
+            for (auto state : current)
+            {
+                if (m_tokens[state].type == TokenType::End)
+                {
+                    if (indices == nullptr)
+                    {
+                        return true;
+                    }
+                    indices->push_back(m_tokens[state].pattern);
+                    found = true;
+                }
+            }
+        }
+
+        if (i == path.size())
+        {
+            break;
+        }
+
+        const auto c = static_cast<uint8_t>(path[i]);
+        if (node != no_node)
+        {
+            node = find_child(node, c);
+        }
+
+        next.clear();
+        generation = marks.next(m_tokens.size());
+        for (auto state : current)
+        {
+            const auto &token = m_tokens[state];
+            switch (token.type)
+            {
+            case TokenType::Char:
+                if (token.c == c)
+                {
+                    activate(next, state + 1);
+                }
+                break;
+            case TokenType::Any:
+                if (c != '/')
+                {
+                    activate(next, state + 1);
+                }
+                break;
+            case TokenType::Class:
+                if (m_sets[token.set].test(c))
+                {
+                    activate(next, state + 1);
+                }
+                break;
+            case TokenType::Star:
+                if (c != '/')
+                {
+                    activate(next, state);
+                }
+                break;
+            case TokenType::End:
+                break;
+            }
+        }
+        current.swap(next);
+
+        if (node == no_node && current.empty())
+        {
+            break;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Set of OTF2 references stored as a bitmap.
+ *
+ * OTF2 definitions are numbered densely from zero, so one bit per reference
+ * keeps the set small and a lookup is a single load. References outside the
+ * bitmap, e.g. the OTF2_UNDEFINED_* values, are never contained.
+ *
+ * Insertion is not thread-safe. Concurrent lookups are, as long as no
+ * insertion happens at the same time, which holds for sets filled while
+ * reading the global definitions and queried while reading events.
+ */
+class DenseRefSet
+{
+  public:
+    inline void
+    insert(uint64_t ref)
+    {
+        const std::size_t word = ref / bits_per_word;
+        if (word >= m_words.size())
+        {
+            m_words.resize(word + 1, 0);
+        }
+        m_words[word] |= uint64_t(1) << (ref % bits_per_word);
+    }
+
+    inline bool
+    contains(uint64_t ref) const
+    {
+        const std::size_t word = ref / bits_per_word;
+        return word < m_words.size() && (m_words[word] >> (ref % bits_per_word)) & 1;
+    }
+
+    inline bool
+    empty() const
+    {
+        return m_words.empty();
+    }
+
+  private:
+    static constexpr std::size_t bits_per_word = 64;
+
+    std::vector<uint64_t> m_words;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Matches a path against many shell wildcard patterns at once.
+ *
+ * Patterns behave like fnmatch(3) with FNM_PATHNAME | FNM_LEADING_DIR:
+ * '*', '?' and bracket expressions never match '/', a backslash escapes the
+ * next character and a pattern matching a directory also matches every path
+ * below it.
+ *
+ * The literal prefixes of all patterns are kept in a trie and the wildcard
+ * parts following them are compiled into one nondeterministic automaton. A
+ * path is matched in a single pass: while the path is walked down the trie,
+ * the automaton states of the patterns whose prefix was found are activated
+ * and advanced together with it. Patterns using constructs the automaton
+ * does not cover, e.g. collating symbols or unterminated brackets, are
+ * passed to fnmatch.
+ */
+class GlobMatcher
+{
+  public:
+    GlobMatcher();
+    explicit GlobMatcher(const std::vector<std::string> &patterns);
+
+    /*
+     * @return index of the added pattern
+     */
+    std::size_t
+    add(const std::string &pattern);
+
+    /*
+     * @return true if any pattern matches the path
+     */
+    bool
+    match(const std::string &path) const;
+
+    /*
+     * Collect the indices of all patterns matching the path.
+     *
+     * @param indices cleared and filled in ascending order
+     */
+    void
+    matches(const std::string &path, std::vector<std::size_t> &indices) const;
+
+    inline std::size_t
+    size() const
+    {
+        return m_patterns.size();
+    }
+
+  private:
+    enum class TokenType : uint8_t
+    {
+        Char,
+        Any,
+        Star,
+        Class,
+        End
+    };
+
+    struct Token
+    {
+        TokenType type;
+        uint8_t   c;
+        uint32_t  set;
+        uint32_t  pattern;
+    };
+
+    struct TrieNode
+    {
+        std::vector<std::pair<uint8_t, uint32_t>> children;
+        std::vector<uint32_t>                     starts;
+    };
+
+    bool
+    compile(const std::string &pattern, std::vector<Token> &tokens);
+    bool
+    compile_bracket(const std::string &pattern, std::size_t &pos, Token &token);
+    uint32_t
+    insert_child(uint32_t node, uint8_t c);
+    uint32_t
+    find_child(uint32_t node, uint8_t c) const;
+    bool
+    run(const std::string &path, std::vector<std::size_t> *indices) const;
+
+    std::vector<std::string>      m_patterns;
+    std::vector<Token>            m_tokens;
+    std::vector<std::bitset<256>> m_sets;
+    std::vector<TrieNode>         m_trie;
+    std::vector<std::size_t>      m_fallback;
+};
@@ -1,8 +1,7 @@
 #pragma once
 #include <filesystem>
-#include <map>
-#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 extern "C"
@@ -10,7 +9,11 @@ extern "C"
 #include <otf2/otf2.h>
 }
 
+#include <dense_ref_set.hpp>
 #include <filter.hpp>
+#include <glob_matcher.hpp>
+#include <location_index.hpp>
+#include <string_table.hpp>
 
 namespace fs = std::filesystem;
 
@@ -21,7 +24,21 @@ class IoFilterPattern
     bool
     filterFile(const std::string &file);
 
+    /*
+     * @return index of the first pattern matching the file or
+     *         std::string::npos
+     */
+    std::size_t
+    firstMatch(const std::string &file) const;
+
+    inline const std::vector<std::string> &
+    patterns() const
+    {
+        return m_patterns;
+    }
+
   private:
+    GlobMatcher              m_matcher;
     std::vector<std::string> m_patterns;
 };
 
@@ -32,15 +49,156 @@ class IoFileFilter : public IFilterCallbacks
     virtual ~IoFileFilter();
     virtual Callbacks
     get_callbacks() override;
+    virtual std::vector<GlobalDefinition>
+    string_references() const override;
+
+    /*
+     * A location is affected if a filtered handle is in the scope of its
+     * process or a filtered file in the scope of its system tree node.
+     * Handles without a communicator as scope may be used anywhere.
+     *
+     * Locations in the location index are affected if they use a filtered
+     * handle or file.
+     */
+    virtual bool
+    affects_location(OTF2_LocationRef location) override;
+
+    /*
+     * Use the index of a previous run instead of the scopes for the
+     * locations it knows.
+     */
+    void
+    set_location_index(LocationIndex index);
+
+    /*
+     * @return names of the files whose records are filtered
+     */
+    inline const std::vector<std::string> &
+    filtered_files() const
+    {
+        return m_filtered_files;
+    }
+
+    /*
+     * Records dropped because of one pattern. A file matching several
+     * patterns counts for the first of them.
+     */
+    struct PatternHits
+    {
+        std::string pattern;
+        uint64_t    files   = 0;
+        uint64_t    handles = 0;
+        uint64_t    events  = 0;
+    };
+
+    /*
+     * Count the records each pattern drops, see pattern_hits(). Has to be
+     * called before get_callbacks().
+     */
+    void
+    count_pattern_hits();
+
+    /*
+     * Merge the hits of all locations, call it once the events were read.
+     */
+    std::vector<PatternHits>
+    pattern_hits() const;
 
   private:
-    IoFilterPattern                       m_pattern;
-    std::map<OTF2_StringRef, std::string> m_strings;
-    std::set<OTF2_IoFileRef>              m_io_files;
-    std::set<OTF2_IoHandleRef>            m_file_handles;
+    IoFilterPattern m_pattern;
+    /*
+     * Strings of the trace, used if no writer attached its string table.
+     */
+    StringTable              m_strings;
+    DenseRefSet              m_io_files;
+    DenseRefSet              m_file_handles;
+    std::vector<std::string> m_filtered_files;
+
+    /*
+     * Definitions locating the processes, i.e. location groups, a filtered
+     * handle or file is visible to. Groups are only kept if a communicator
+     * may refer to their members.
+     */
+    struct GroupMembers
+    {
+        OTF2_GroupType        type;
+        OTF2_Paradigm         paradigm;
+        std::vector<uint64_t> members;
+    };
+
+    std::unordered_map<OTF2_LocationRef, OTF2_LocationGroupRef>        m_location_groups;
+    std::unordered_map<OTF2_LocationGroupRef, OTF2_SystemTreeNodeRef>  m_group_nodes;
+    std::unordered_map<OTF2_SystemTreeNodeRef, OTF2_SystemTreeNodeRef> m_node_parents;
+    std::unordered_map<OTF2_CommRef, OTF2_GroupRef>                    m_comm_groups;
+    std::unordered_map<OTF2_GroupRef, GroupMembers>                    m_groups;
+    std::vector<OTF2_CommRef>                                          m_handle_scopes;
+    std::vector<OTF2_SystemTreeNodeRef>                                m_file_scopes;
+
+    /*
+     * Location groups affected by the filter, resolved on the first call
+     * of affects_location().
+     */
+    bool        m_scopes_resolved = false;
+    bool        m_affects_all     = false;
+    DenseRefSet m_affected_groups;
+
+    LocationIndex m_location_index;
+
+    /*
+     * Pattern of each dropped file and handle and the events each location
+     * dropped per pattern, only kept with count_pattern_hits(). The vector
+     * of a location is created with its definition and only written by the
+     * worker reading the location.
+     */
+    bool                                                        m_count_hits = false;
+    std::unordered_map<OTF2_IoFileRef, std::size_t>             m_file_patterns;
+    std::unordered_map<OTF2_IoHandleRef, std::size_t>           m_handle_patterns;
+    std::vector<PatternHits>                                    m_pattern_hits;
+    std::unordered_map<OTF2_LocationRef, std::vector<uint64_t>> m_location_hits;
+
+    /*
+     * Count a dropped event, both return true to be chained to the check
+     * whether the event is dropped.
+     */
+    inline bool
+    count_handle_hit(OTF2_LocationRef location, OTF2_IoHandleRef handle)
+    {
+        if (m_count_hits)
+        {
+            auto pattern = m_handle_patterns.find(handle);
+            add_event_hit(location, pattern != m_handle_patterns.end() ? pattern->second : 0);
+        }
+        return true;
+    }
+
+    inline bool
+    count_file_hit(OTF2_LocationRef location, OTF2_IoFileRef file)
+    {
+        if (m_count_hits)
+        {
+            auto pattern = m_file_patterns.find(file);
+            add_event_hit(location, pattern != m_file_patterns.end() ? pattern->second : 0);
+        }
+        return true;
+    }
+
+    void
+    add_file_hit(OTF2_IoFileRef file, const std::string &name);
+    void
+    add_handle_hit(OTF2_IoHandleRef handle, std::size_t pattern);
+    void
+    add_event_hit(OTF2_LocationRef location, std::size_t pattern);
 
     void
     add_definition_callbacks(Callbacks &c);
     void
+    add_scope_callbacks(Callbacks &c);
+    void
     add_event_callbacks(Callbacks &c);
+    void
+    resolve_scopes();
+    void
+    add_comm_scope(OTF2_CommRef comm);
+    void
+    add_node_scope(OTF2_SystemTreeNodeRef node);
 };
\ No newline at end of file
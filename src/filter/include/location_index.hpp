@@ -0,0 +1,175 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <filter.hpp>
+#include <otf2_handler.hpp>
+
+/*
+ * What the events of one location refer to.
+ */
+struct LocationUsage
+{
+    /*
+     * Size of the event file the usage was recorded from, a location whose
+     * file changed since is not trusted.
+     */
+    uint64_t event_file_size = 0;
+
+    /*
+     * Number of events, indexed by EventType.
+     */
+    std::vector<uint64_t> event_counts;
+
+    /*
+     * Sorted references of the I/O handles and files used by the events.
+     */
+    std::vector<OTF2_IoHandleRef> io_handles;
+    std::vector<OTF2_IoFileRef>   io_files;
+};
+
+/*
+ * Index of the I/O handles, files and event types each location of a trace
+ * uses, stored in a file next to the trace.
+ *
+ * The index is recorded while the trace is filtered once, see
+ * LocationIndexRecorder. Later runs with other patterns tell from it which
+ * locations a filter affects without reading their events.
+ */
+class LocationIndex
+{
+  public:
+    /*
+     * @param trace anchor file of the trace
+     * @return path of the index of the trace
+     */
+    static std::filesystem::path
+    path_of(const std::filesystem::path &trace);
+
+    /*
+     * Read the index of a trace. Locations whose event file changed since
+     * the index was written are left out.
+     *
+     * @param trace anchor file of the trace
+     * @throws std::runtime_error if the index cannot be read
+     */
+    static LocationIndex
+    read(const std::filesystem::path &index, const std::filesystem::path &trace);
+
+    /*
+     * @throws std::runtime_error if the index cannot be written
+     */
+    void
+    write(const std::filesystem::path &index) const;
+
+    void
+    add(OTF2_LocationRef location, LocationUsage usage);
+
+    /*
+     * @return usage of the location or nullptr if it is not indexed
+     */
+    const LocationUsage *
+    find(OTF2_LocationRef location) const;
+
+    inline std::size_t
+    size() const
+    {
+        return m_locations.size();
+    }
+
+    /*
+     * @return name of the event type, e.g. "IoOperationBegin"
+     */
+    static const char *
+    event_name(EventType type);
+
+  private:
+    std::unordered_map<OTF2_LocationRef, LocationUsage> m_locations;
+};
+
+/*
+ * Records a LocationIndex while a trace is read, never drops a record.
+ *
+ * Register it with a lower priority value than all other filters, it has
+ * to see every event. The usage of a location is only written by the worker
+ * reading the location.
+ */
+class LocationIndexRecorder : public IFilterCallbacks
+{
+  public:
+    /*
+     * @param trace anchor file of the recorded trace
+     */
+    explicit LocationIndexRecorder(const std::filesystem::path &trace);
+
+    virtual Callbacks
+    get_callbacks() override;
+
+    /*
+     * @return usage of all locations recorded so far
+     */
+    LocationIndex
+    index() const;
+
+  private:
+    struct Usage
+    {
+        std::vector<uint64_t>        event_counts;
+        std::unordered_set<uint64_t> io_handles;
+        std::unordered_set<uint64_t> io_files;
+    };
+
+    inline Usage *
+    usage(OTF2_LocationRef location)
+    {
+        auto search = m_usage.find(location);
+        return search != m_usage.end() ? search->second.get() : nullptr;
+    }
+
+    inline void
+    record(OTF2_LocationRef location, EventType type, OTF2_IoHandleRef handle = OTF2_UNDEFINED_IO_HANDLE)
+    {
+        if (auto *u = usage(location))
+        {
+            u->event_counts[static_cast<std::size_t>(type)]++;
+            if (handle != OTF2_UNDEFINED_IO_HANDLE)
+            {
+                u->io_handles.insert(handle);
+            }
+        }
+    }
+
+    inline void
+    record_handle(OTF2_LocationRef location, OTF2_IoHandleRef handle)
+    {
+        if (auto *u = usage(location))
+        {
+            u->io_handles.insert(handle);
+        }
+    }
+
+    inline void
+    record_file(OTF2_LocationRef location, EventType type, OTF2_IoFileRef file)
+    {
+        if (auto *u = usage(location))
+        {
+            u->event_counts[static_cast<std::size_t>(type)]++;
+            u->io_files.insert(file);
+        }
+    }
+
+    std::filesystem::path m_trace;
+    /*
+     * Created with the location definitions, before any event is read.
+     */
+    std::unordered_map<OTF2_LocationRef, std::unique_ptr<Usage>> m_usage;
+};
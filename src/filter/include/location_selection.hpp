@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <filter.hpp>
+#include <glob_matcher.hpp>
+#include <string_table.hpp>
+
+/*
+ * Keeps only the locations matching a selection and drops the definitions
+ * of all others.
+ *
+ * A location is selected if its name matches a location pattern or the
+ * name of its location group or of a system tree node above it matches a
+ * group pattern, and if its type is one of the selected types. Without
+ * patterns every name is selected, without types every type.
+ *
+ * A TraceWriter or DryRunHandler the selection is registered at does not
+ * let the reader select or open the dropped locations, see
+ * Otf2Handler::selectsLocation(). A TraceWriter also removes them from the
+ * members of groups of locations, and drops the metric class recorders and
+ * metric instances that refer to them.
+ */
+class LocationSelection : public IFilterCallbacks
+{
+  public:
+    /*
+     * Select locations whose name matches a shell wildcard pattern.
+     */
+    void
+    add_location_pattern(const std::string &pattern);
+
+    /*
+     * Select locations whose location group or a system tree node above it
+     * matches a shell wildcard pattern, e.g. "MPI Rank 0".
+     */
+    void
+    add_group_pattern(const std::string &pattern);
+
+    void
+    add_type(OTF2_LocationType type);
+
+    /*
+     * @param name "cpu_thread", "gpu", "metric" or "unknown"
+     * @throws std::invalid_argument for other names
+     */
+    static OTF2_LocationType
+    parse_type(const std::string &name);
+
+    virtual Callbacks
+    get_callbacks() override;
+    virtual std::vector<GlobalDefinition>
+    string_references() const override;
+
+    /*
+     * @return number of locations dropped so far
+     */
+    inline std::size_t
+    dropped_locations() const
+    {
+        return m_dropped;
+    }
+
+  private:
+    bool
+    selects(OTF2_StringRef name, OTF2_LocationType type, OTF2_LocationGroupRef group) const;
+    bool
+    group_matches(OTF2_LocationGroupRef group) const;
+
+    inline bool
+    matches(const GlobMatcher &matcher, OTF2_StringRef name) const
+    {
+        const char *s = m_string_table->get(name);
+        return s != nullptr && matcher.match(s);
+    }
+
+    GlobMatcher                    m_location_patterns;
+    GlobMatcher                    m_group_patterns;
+    std::vector<OTF2_LocationType> m_types;
+
+    /*
+     * Strings of the trace, used if no writer attached its string table.
+     */
+    StringTable m_strings;
+
+    struct Node
+    {
+        OTF2_StringRef         name;
+        OTF2_SystemTreeNodeRef parent;
+    };
+
+    struct Group
+    {
+        OTF2_StringRef         name;
+        OTF2_SystemTreeNodeRef node;
+    };
+
+    std::unordered_map<OTF2_SystemTreeNodeRef, Node> m_nodes;
+    std::unordered_map<OTF2_LocationGroupRef, Group> m_groups;
+    std::size_t                                      m_dropped = 0;
+};
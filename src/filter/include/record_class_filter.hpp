@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <filter.hpp>
+#include <otf2_handler.hpp>
+
+/*
+ * Classes of records that are dropped as a whole.
+ */
+enum class RecordClass
+{
+    OpenMp,
+    Thread,
+    Rma,
+    CallingContext,
+};
+
+/*
+ * Drops all events of some record classes, e.g. to keep only the I/O and
+ * MPI events of a trace.
+ *
+ * The events are not filtered one by one. The filter announces their types,
+ * see dropped_event_types(), and a TraceWriter it is registered at lets the
+ * reader skip them while decoding. The global definitions only these
+ * events refer to are dropped as well: RMA windows for RMA, calling
+ * contexts, their properties, source code locations and interrupt
+ * generators for calling contexts. OpenMP and thread events only refer to
+ * definitions other records may use, e.g. communicators of thread teams,
+ * those are kept.
+ *
+ * Attribute values referring to the dropped definitions are removed from
+ * the events, see dropped_attribute_types(). Attribute definitions and
+ * properties of other definitions with values of these types are dropped.
+ */
+class RecordClassFilter : public IFilterCallbacks
+{
+  public:
+    void
+    add_class(RecordClass record_class);
+
+    /*
+     * @param name "omp", "thread", "rma" or "calling_context"
+     * @throws std::invalid_argument for other names
+     */
+    static RecordClass
+    parse_class(const std::string &name);
+
+    virtual Callbacks
+    get_callbacks() override;
+    virtual std::vector<EventType>
+    dropped_event_types() const override;
+    virtual std::vector<OTF2_Type>
+    dropped_attribute_types() const override;
+
+  private:
+    inline bool
+    drops(RecordClass record_class) const
+    {
+        return m_classes[static_cast<std::size_t>(record_class)];
+    }
+
+    bool
+    drops_type(OTF2_Type type) const;
+
+    std::array<bool, 4> m_classes{};
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <dense_ref_set.hpp>
+#include <filter.hpp>
+#include <string_table.hpp>
+
+/*
+ * Rules deciding which regions are filtered, read from a pattern file.
+ *
+ * A file with one shell wildcard pattern per line excludes the regions
+ * whose name matches any of them, surrounding whitespace and text after a
+ * '#' are ignored. Filter files of Score-P are read as
+ * well, e.g.
+ *
+ *     SCOREP_REGION_NAMES_BEGIN
+ *       EXCLUDE *
+ *       INCLUDE main MPI_*
+ *       EXCLUDE MANGLED _ZNK3Foo*
+ *     SCOREP_REGION_NAMES_END
+ *     SCOREP_FILE_NAMES_BEGIN
+ *       EXCLUDE *.h
+ *     SCOREP_FILE_NAMES_END
+ *
+ * As in Score-P, the last matching rule of a block decides and regions no
+ * rule matches are kept. A region is excluded if its name or its source
+ * file is, MANGLED rules match the canonical name of the region. Text
+ * after a '#' is a comment.
+ */
+class RegionFilterPattern
+{
+  public:
+    /*
+     * @throws std::runtime_error if the file cannot be read or is not
+     *         valid Score-P syntax
+     */
+    explicit RegionFilterPattern(const std::filesystem::path &pattern_file);
+
+    bool
+    filterRegion(const char *name, const char *canonical_name, const char *source_file) const;
+
+  private:
+    struct Rule
+    {
+        bool        exclude;
+        bool        mangled;
+        std::string pattern;
+    };
+
+    void
+    parse_scorep(const std::vector<std::string> &lines, const std::filesystem::path &pattern_file);
+
+    static bool
+    excludes(const std::vector<Rule> &rules, const char *name, const char *canonical_name);
+
+    std::vector<Rule> m_region_rules;
+    std::vector<Rule> m_file_rules;
+};
+
+/*
+ * Drops the Enter and Leave events of filtered regions, e.g. small
+ * functions called at a high rate.
+ *
+ * The rules are matched once per region definition and the filtered
+ * regions kept in a bitmap, checking an event costs a single bit test. The
+ * Enter and Leave of a region are always dropped together, the remaining
+ * events stay properly nested. Region definitions are kept, other
+ * definitions and events may still refer to them.
+ */
+class RegionFilter : public IFilterCallbacks
+{
+  public:
+    explicit RegionFilter(const std::filesystem::path &pattern_file);
+
+    virtual Callbacks
+    get_callbacks() override;
+    virtual std::vector<GlobalDefinition>
+    string_references() const override;
+
+    /*
+     * Every location may enter a filtered region, none is affected if no
+     * region is filtered.
+     */
+    virtual bool
+    affects_location(OTF2_LocationRef location) override;
+
+    /*
+     * @return names of the filtered regions
+     */
+    inline const std::vector<std::string> &
+    filtered_regions() const
+    {
+        return m_filtered_regions;
+    }
+
+  private:
+    inline const char *
+    string(OTF2_StringRef ref) const
+    {
+        const char *s = m_string_table->get(ref);
+        return s != nullptr ? s : "";
+    }
+
+    RegionFilterPattern m_pattern;
+    /*
+     * Strings of the trace, used if no writer attached its string table.
+     */
+    StringTable              m_strings;
+    DenseRefSet              m_regions;
+    std::vector<std::string> m_filtered_regions;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <dense_ref_set.hpp>
+
+/*
+ * Global string definitions, indexed by their reference.
+ *
+ * Strings are copied into large blocks, so storing one costs its length
+ * plus a pointer in the index instead of a map node and a std::string.
+ * In Referenced mode only strings passed to reference() before they are
+ * added are kept, which lets a filter resolve e.g. file names without
+ * holding every region or parameter name of the trace.
+ *
+ * Adding strings is not thread-safe. Lookups are, as long as no string is
+ * added at the same time.
+ */
+class StringTable
+{
+  public:
+    enum class Mode
+    {
+        All,
+        Referenced
+    };
+
+    explicit StringTable(Mode mode = Mode::All, std::size_t block_size = 1024 * 1024);
+
+    StringTable(const StringTable &) = delete;
+    StringTable &
+    operator=(const StringTable &) = delete;
+
+    void
+    set_mode(Mode mode);
+
+    inline Mode
+    mode() const
+    {
+        return m_mode;
+    }
+
+    /*
+     * Keep the string with the given reference in Referenced mode.
+     */
+    void
+    reference(OTF2_StringRef ref);
+
+    /*
+     * Store a string if the mode asks for it.
+     *
+     * @return true if the string was stored
+     */
+    bool
+    add(OTF2_StringRef ref, const char *string);
+
+    /*
+     * @return the stored string or nullptr if it was not stored
+     */
+    inline const char *
+    get(OTF2_StringRef ref) const
+    {
+        return ref < m_index.size() ? m_index[ref] : nullptr;
+    }
+
+    /*
+     * @return number of stored strings
+     */
+    inline std::size_t
+    size() const
+    {
+        return m_count;
+    }
+
+  private:
+    char *
+    allocate(std::size_t length);
+
+    Mode                                 m_mode;
+    std::size_t                          m_block_size;
+    DenseRefSet                          m_referenced;
+    std::vector<const char *>            m_index;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char *                               m_block_position = nullptr;
+    std::size_t                          m_block_free     = 0;
+    std::size_t                          m_count          = 0;
+};
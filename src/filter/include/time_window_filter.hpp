@@ -0,0 +1,33 @@
+#pragma once
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <filter.hpp>
+#include <otf2_handler.hpp>
+
+/*
+ * Drops all events outside of a time window.
+ *
+ * Bounds are timestamps of the trace in ticks of its clock, as printed by
+ * otf2-print. A TraceWriter the filter is registered at shrinks the clock
+ * properties of the output to the window, and locations are only read up
+ * to the end of it. Regions and operations the window cuts through are
+ * entered at its begin and left at its end by the TraceWriter.
+ */
+class TimeWindowFilter : public IFilterCallbacks
+{
+  public:
+    explicit TimeWindowFilter(TimeWindow window);
+
+    virtual Callbacks
+    get_callbacks() override;
+
+    virtual TimeWindow
+    time_window() const override;
+
+  private:
+    TimeWindow m_window;
+};
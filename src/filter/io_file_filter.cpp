@@ -1,14 +1,8 @@
-#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 
 #include <io_file_filter.hpp>
 
-extern "C"
-{
-#include <fnmatch.h>
-}
-
 IoFilterPattern::IoFilterPattern(const fs::path &pattern_file)
 {
     std::ifstream in(pattern_file, std::ios::in);
@@ -19,16 +13,23 @@ IoFilterPattern::IoFilterPattern(const fs::path &pattern_file)
     std::string line;
     while (std::getline(in, line))
     {
+        m_matcher.add(line);
         m_patterns.push_back(line);
     }
 }
 
+std::size_t
+IoFilterPattern::firstMatch(const std::string &file) const
+{
+    std::vector<std::size_t> indices;
+    m_matcher.matches(file, indices);
+    return indices.empty() ? std::string::npos : indices.front();
+}
+
 bool
 IoFilterPattern::filterFile(const std::string &file)
 {
-    return std::any_of(m_patterns.begin(), m_patterns.end(), [&file](const std::string &p) -> bool {
-        return fnmatch(p.c_str(), file.c_str(), FNM_PATHNAME | FNM_LEADING_DIR) == 0;
-    });
+    return m_matcher.match(file);
 }
 
 IoFileFilter::IoFileFilter(const fs::path &pattern_file) : m_pattern(pattern_file)
@@ -45,24 +46,234 @@ IoFileFilter::get_callbacks()
     Callbacks c;
 
     add_definition_callbacks(c);
+    add_scope_callbacks(c);
     add_event_callbacks(c);
 
     return c;
 }
 
+std::vector<GlobalDefinition>
+IoFileFilter::string_references() const
+{
+    return {GlobalDefinition::IoRegularFile};
+}
+
+bool
+IoFileFilter::affects_location(OTF2_LocationRef location)
+{
+    if (m_io_files.empty())
+    {
+        return false;
+    }
+    if (const auto *usage = m_location_index.find(location))
+    {
+        for (auto handle : usage->io_handles)
+        {
+            if (m_file_handles.contains(handle))
+            {
+                return true;
+            }
+        }
+        for (auto file : usage->io_files)
+        {
+            if (m_io_files.contains(file))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (!m_scopes_resolved)
+    {
+        resolve_scopes();
+    }
+    if (m_affects_all)
+    {
+        return true;
+    }
+    auto search = m_location_groups.find(location);
+    return search == m_location_groups.end() || m_affected_groups.contains(search->second);
+}
+
+void
+IoFileFilter::count_pattern_hits()
+{
+    m_count_hits = true;
+    m_pattern_hits.clear();
+    for (const auto &pattern : m_pattern.patterns())
+    {
+        m_pattern_hits.push_back({pattern});
+    }
+}
+
+std::vector<IoFileFilter::PatternHits>
+IoFileFilter::pattern_hits() const
+{
+    auto result = m_pattern_hits;
+    for (const auto &location : m_location_hits)
+    {
+        for (std::size_t pattern = 0; pattern < location.second.size(); pattern++)
+        {
+            result[pattern].events += location.second[pattern];
+        }
+    }
+    return result;
+}
+
+void
+IoFileFilter::add_file_hit(OTF2_IoFileRef file, const std::string &name)
+{
+    auto pattern = m_pattern.firstMatch(name);
+    if (pattern < m_pattern_hits.size())
+    {
+        m_file_patterns[file] = pattern;
+        m_pattern_hits[pattern].files++;
+    }
+}
+
+void
+IoFileFilter::add_handle_hit(OTF2_IoHandleRef handle, std::size_t pattern)
+{
+    if (pattern < m_pattern_hits.size())
+    {
+        m_handle_patterns[handle] = pattern;
+        m_pattern_hits[pattern].handles++;
+    }
+}
+
+void
+IoFileFilter::add_event_hit(OTF2_LocationRef location, std::size_t pattern)
+{
+    auto hits = m_location_hits.find(location);
+    if (hits != m_location_hits.end() && pattern < hits->second.size())
+    {
+        hits->second[pattern]++;
+    }
+}
+
+void
+IoFileFilter::set_location_index(LocationIndex index)
+{
+    m_location_index = std::move(index);
+}
+
+void
+IoFileFilter::resolve_scopes()
+{
+    m_scopes_resolved = true;
+    for (auto comm : m_handle_scopes)
+    {
+        add_comm_scope(comm);
+    }
+    for (auto node : m_file_scopes)
+    {
+        add_node_scope(node);
+    }
+}
+
+/*
+ * Members of communication groups are ranks, i.e. indices into the list of
+ * locations of the same paradigm.
+ */
+void
+IoFileFilter::add_comm_scope(OTF2_CommRef comm)
+{
+    auto comm_group = m_comm_groups.find(comm);
+    auto group      = comm_group != m_comm_groups.end() ? m_groups.find(comm_group->second) : m_groups.end();
+    if (group == m_groups.end())
+    {
+        m_affects_all = true;
+        return;
+    }
+
+    const GroupMembers *locations = &group->second;
+    if (group->second.type == OTF2_GROUP_TYPE_COMM_GROUP)
+    {
+        locations = nullptr;
+        for (const auto &candidate : m_groups)
+        {
+            if (candidate.second.type == OTF2_GROUP_TYPE_COMM_LOCATIONS &&
+                candidate.second.paradigm == group->second.paradigm)
+            {
+                locations = &candidate.second;
+            }
+        }
+    }
+    if (locations == nullptr)
+    {
+        m_affects_all = true;
+        return;
+    }
+
+    for (auto member : group->second.members)
+    {
+        uint64_t location = member;
+        if (locations != &group->second)
+        {
+            if (member >= locations->members.size())
+            {
+                m_affects_all = true;
+                return;
+            }
+            location = locations->members[member];
+        }
+        auto location_group = m_location_groups.find(location);
+        if (location_group == m_location_groups.end())
+        {
+            m_affects_all = true;
+            return;
+        }
+        m_affected_groups.insert(location_group->second);
+    }
+}
+
+void
+IoFileFilter::add_node_scope(OTF2_SystemTreeNodeRef node)
+{
+    if (node == OTF2_UNDEFINED_SYSTEM_TREE_NODE)
+    {
+        m_affects_all = true;
+        return;
+    }
+    for (const auto &group : m_group_nodes)
+    {
+        for (auto ancestor = group.second; ancestor != OTF2_UNDEFINED_SYSTEM_TREE_NODE;)
+        {
+            if (ancestor == node)
+            {
+                m_affected_groups.insert(group.first);
+                break;
+            }
+            auto parent = m_node_parents.find(ancestor);
+            ancestor    = parent != m_node_parents.end() ? parent->second : OTF2_UNDEFINED_SYSTEM_TREE_NODE;
+        }
+    }
+}
+
 void
 IoFileFilter::add_definition_callbacks(Callbacks &c)
 {
-    c.global_string_callback = [this](OTF2_StringRef self, const char *string) {
-        m_strings.insert({self, string});
-        return false;
-    };
+    if (m_string_table == nullptr)
+    {
+        /* not registered at a writer, collect the strings on our own */
+        m_string_table           = &m_strings;
+        c.global_string_callback = [this](OTF2_StringRef self, const char *string) {
+            m_strings.add(self, string);
+            return false;
+        };
+    }
 
     c.global_io_regular_file_callback = [this](OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope) {
-        auto search = m_strings.find(name);
-        if (search != m_strings.end() && m_pattern.filterFile(search->second))
+        const char *file_name = m_string_table->get(name);
+        if (file_name != nullptr && m_pattern.filterFile(file_name))
         {
             m_io_files.insert(self);
+            m_filtered_files.emplace_back(file_name);
+            if (m_count_hits)
+            {
+                add_file_hit(self, file_name);
+            }
+            m_file_scopes.push_back(scope);
             return true;
         }
         return false;
@@ -70,7 +281,7 @@ IoFileFilter::add_definition_callbacks(Callbacks &c)
 
     c.global_io_file_property_callback =
         [this](OTF2_IoFileRef ioFile, OTF2_StringRef name, OTF2_Type type, OTF2_AttributeValue value) {
-            return m_io_files.find(ioFile) != m_io_files.end();
+            return m_io_files.contains(ioFile);
         };
 
     c.global_io_handle_callback = [this](OTF2_IoHandleRef   self,
@@ -80,22 +291,85 @@ IoFileFilter::add_definition_callbacks(Callbacks &c)
                                          OTF2_IoHandleFlag  ioHandleFlags,
                                          OTF2_CommRef       comm,
                                          OTF2_IoHandleRef   parent) {
-        auto search_file = m_io_files.find(file);
-        if (search_file != m_io_files.end())
+        if (m_io_files.contains(file))
         {
             m_file_handles.insert(self);
+            m_handle_scopes.push_back(comm);
+            if (m_count_hits)
+            {
+                add_handle_hit(self, m_file_patterns[file]);
+            }
             return true;
         }
 
-        auto search_handle = m_file_handles.find(parent);
-        if (search_handle != m_file_handles.end())
+        if (m_file_handles.contains(parent))
         {
+            if (m_count_hits)
+            {
+                add_handle_hit(self, m_handle_patterns[parent]);
+            }
             return true;
         }
         return false;
     };
 }
 
+/*
+ * The callbacks only observe the definitions, none of them is dropped.
+ */
+void
+IoFileFilter::add_scope_callbacks(Callbacks &c)
+{
+    c.global_system_tree_node_callback = [this](OTF2_SystemTreeNodeRef self,
+                                                OTF2_StringRef         name,
+                                                OTF2_StringRef         className,
+                                                OTF2_SystemTreeNodeRef parent) {
+        m_node_parents[self] = parent;
+        return false;
+    };
+
+    c.global_location_group_callback = [this](OTF2_LocationGroupRef  self,
+                                              OTF2_StringRef         name,
+                                              OTF2_LocationGroupType locationGroupType,
+                                              OTF2_SystemTreeNodeRef systemTreeParent) {
+        m_group_nodes[self] = systemTreeParent;
+        return false;
+    };
+
+    c.global_location_callback = [this](OTF2_LocationRef      self,
+                                        OTF2_StringRef        name,
+                                        OTF2_LocationType     locationType,
+                                        uint64_t              numberOfEvents,
+                                        OTF2_LocationGroupRef locationGroup) {
+        m_location_groups[self] = locationGroup;
+        if (m_count_hits)
+        {
+            m_location_hits[self].assign(m_pattern_hits.size(), 0);
+        }
+        return false;
+    };
+
+    c.global_group_callback = [this](OTF2_GroupRef   self,
+                                     OTF2_StringRef  name,
+                                     OTF2_GroupType  groupType,
+                                     OTF2_Paradigm   paradigm,
+                                     OTF2_GroupFlag  groupFlags,
+                                     uint32_t        numberOfMembers,
+                                     const uint64_t *members) {
+        if (groupType == OTF2_GROUP_TYPE_LOCATIONS || groupType == OTF2_GROUP_TYPE_COMM_LOCATIONS ||
+            groupType == OTF2_GROUP_TYPE_COMM_GROUP)
+        {
+            m_groups[self] = {groupType, paradigm, std::vector<uint64_t>(members, members + numberOfMembers)};
+        }
+        return false;
+    };
+
+    c.global_comm_callback = [this](OTF2_CommRef self, OTF2_StringRef name, OTF2_GroupRef group, OTF2_CommRef parent) {
+        m_comm_groups[self] = group;
+        return false;
+    };
+}
+
 void
 IoFileFilter::add_event_callbacks(Callbacks &c)
 {
@@ -106,13 +380,13 @@ IoFileFilter::add_event_callbacks(Callbacks &c)
                                                OTF2_IoAccessMode   mode,
                                                OTF2_IoCreationFlag creationFlags,
                                                OTF2_IoStatusFlag   statusFlags) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_destroy_handle_callback = [this](OTF2_LocationRef    location,
                                                 OTF2_TimeStamp      time,
                                                 OTF2_AttributeList *attributes,
                                                 OTF2_IoHandleRef    handle) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_seek_callback = [this](OTF2_LocationRef    location,
                                       OTF2_TimeStamp      time,
@@ -121,14 +395,14 @@ IoFileFilter::add_event_callbacks(Callbacks &c)
                                       int64_t             offsetRequest,
                                       OTF2_IoSeekOption   whence,
                                       uint64_t            offsetResult) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_change_status_flags_callback = [this](OTF2_LocationRef    location,
                                                      OTF2_TimeStamp      time,
                                                      OTF2_AttributeList *attributes,
                                                      OTF2_IoHandleRef    handle,
                                                      OTF2_IoStatusFlag   statusFlags) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_operation_begin_callback = [this](OTF2_LocationRef     location,
                                                  OTF2_TimeStamp       time,
@@ -138,21 +412,21 @@ IoFileFilter::add_event_callbacks(Callbacks &c)
                                                  OTF2_IoOperationFlag operationFlags,
                                                  uint64_t             bytesRequest,
                                                  uint64_t             matchingId) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_operation_test_callback = [this](OTF2_LocationRef    location,
                                                 OTF2_TimeStamp      time,
                                                 OTF2_AttributeList *attributes,
                                                 OTF2_IoHandleRef    handle,
                                                 uint64_t            matchingId) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_operation_issued_callback = [this](OTF2_LocationRef    location,
                                                   OTF2_TimeStamp      time,
                                                   OTF2_AttributeList *attributes,
                                                   OTF2_IoHandleRef    handle,
                                                   uint64_t            matchingId) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_operation_complete_callback = [this](OTF2_LocationRef    location,
                                                     OTF2_TimeStamp      time,
@@ -160,35 +434,35 @@ IoFileFilter::add_event_callbacks(Callbacks &c)
                                                     OTF2_IoHandleRef    handle,
                                                     uint64_t            bytesResult,
                                                     uint64_t            matchingId) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_operation_cancelled_callback = [this](OTF2_LocationRef    location,
                                                      OTF2_TimeStamp      time,
                                                      OTF2_AttributeList *attributes,
                                                      OTF2_IoHandleRef    handle,
                                                      uint64_t            matchingId) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_acquire_lock_callback = [this](OTF2_LocationRef    location,
                                               OTF2_TimeStamp      time,
                                               OTF2_AttributeList *attributes,
                                               OTF2_IoHandleRef    handle,
                                               OTF2_LockType       lockType) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_release_lock_callback = [this](OTF2_LocationRef    location,
                                               OTF2_TimeStamp      time,
                                               OTF2_AttributeList *attributes,
                                               OTF2_IoHandleRef    handle,
                                               OTF2_LockType       lockType) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
     c.event_io_try_lock_callback = [this](OTF2_LocationRef    location,
                                           OTF2_TimeStamp      time,
                                           OTF2_AttributeList *attributes,
                                           OTF2_IoHandleRef    handle,
                                           OTF2_LockType       lockType) {
-        return m_file_handles.find(handle) != m_file_handles.end();
+        return m_file_handles.contains(handle) && count_handle_hit(location, handle);
     };
 
     c.event_io_duplicate_handle_callback = [this](OTF2_LocationRef    location,
@@ -197,14 +471,15 @@ IoFileFilter::add_event_callbacks(Callbacks &c)
                                                   OTF2_IoHandleRef    oldHandle,
                                                   OTF2_IoHandleRef    newHandle,
                                                   OTF2_IoStatusFlag   statusFlags) {
-        bool filter = m_file_handles.find(oldHandle) != m_file_handles.end() &&
-                      m_file_handles.find(newHandle) != m_file_handles.end();
-        return filter;
+        bool filter = m_file_handles.contains(oldHandle) && m_file_handles.contains(newHandle);
+        return filter && count_handle_hit(location, oldHandle);
     };
 
     c.event_io_delete_file_callback = [this](OTF2_LocationRef    location,
                                              OTF2_TimeStamp      time,
                                              OTF2_AttributeList *attributes,
                                              OTF2_IoParadigmRef  ioParadigm,
-                                             OTF2_IoFileRef file) { return m_io_files.find(file) != m_io_files.end(); };
+                                             OTF2_IoFileRef      file) {
+        return m_io_files.contains(file) && count_file_hit(location, file);
+    };
 }
\ No newline at end of file
@@ -0,0 +1,840 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <location_index.hpp>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char *index_header = "otf2_filter_io location index 1";
+
+fs::path
+event_file(const fs::path &trace, OTF2_LocationRef location)
+{
+    return fs::path(trace).replace_extension() / (std::to_string(location) + ".evt");
+}
+} // namespace
+
+fs::path
+LocationIndex::path_of(const fs::path &trace)
+{
+    return fs::path(trace).replace_extension(".index");
+}
+
+const char *
+LocationIndex::event_name(EventType type)
+{
+    return event_type_names[static_cast<std::size_t>(type)];
+}
+
+void
+LocationIndex::add(OTF2_LocationRef location, LocationUsage usage)
+{
+    m_locations[location] = std::move(usage);
+}
+
+const LocationUsage *
+LocationIndex::find(OTF2_LocationRef location) const
+{
+    auto search = m_locations.find(location);
+    return search != m_locations.end() ? &search->second : nullptr;
+}
+
+/*
+ * One line per location, followed by lines with its event counts, handles
+ * and files:
+ *
+ *     location <ref> <event file size>
+ *     events <event type> <count>
+ *     handles <ref>...
+ *     files <ref>...
+ */
+void
+LocationIndex::write(const fs::path &index) const
+{
+    std::ofstream out(index, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+    {
+        throw std::runtime_error("Could not write location index: " + index.string());
+    }
+    out << index_header << '\n';
+    for (const auto &location : m_locations)
+    {
+        const auto &usage = location.second;
+        out << "location " << location.first << ' ' << usage.event_file_size << '\n';
+        for (std::size_t type = 0; type < usage.event_counts.size(); type++)
+        {
+            if (usage.event_counts[type] != 0)
+            {
+                out << "events " << event_type_names[type] << ' ' << usage.event_counts[type] << '\n';
+            }
+        }
+        out << "handles";
+        for (auto handle : usage.io_handles)
+        {
+            out << ' ' << handle;
+        }
+        out << "\nfiles";
+        for (auto file : usage.io_files)
+        {
+            out << ' ' << file;
+        }
+        out << '\n';
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Could not write location index: " + index.string());
+    }
+}
+
+LocationIndex
+LocationIndex::read(const fs::path &index, const fs::path &trace)
+{
+    std::ifstream in(index, std::ios::in);
+    std::string   line;
+    if (!in.is_open() || !std::getline(in, line) || line != index_header)
+    {
+        throw std::runtime_error("Could not read location index: " + index.string());
+    }
+
+    std::unordered_map<std::string, std::size_t> event_types;
+    for (std::size_t type = 0; type < number_of_event_types; type++)
+    {
+        event_types[event_type_names[type]] = type;
+    }
+
+    LocationIndex     result;
+    OTF2_LocationRef  location = OTF2_UNDEFINED_LOCATION;
+    LocationUsage *   usage    = nullptr;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string        keyword;
+        fields >> keyword;
+        if (keyword == "location")
+        {
+            fields >> location;
+            usage = &result.m_locations[location];
+            fields >> usage->event_file_size;
+            usage->event_counts.assign(number_of_event_types, 0);
+        }
+        else if (usage != nullptr && keyword == "events")
+        {
+            std::string name;
+            uint64_t    count = 0;
+            fields >> name >> count;
+            auto type = event_types.find(name);
+            if (type != event_types.end())
+            {
+                usage->event_counts[type->second] = count;
+            }
+        }
+        else if (usage != nullptr && keyword == "handles")
+        {
+            usage->io_handles.assign(std::istream_iterator<uint64_t>(fields), std::istream_iterator<uint64_t>());
+        }
+        else if (usage != nullptr && keyword == "files")
+        {
+            usage->io_files.assign(std::istream_iterator<uint64_t>(fields), std::istream_iterator<uint64_t>());
+        }
+        else
+        {
+            throw std::runtime_error("Invalid location index: " + index.string());
+        }
+        if (fields.fail() && !fields.eof())
+        {
+            throw std::runtime_error("Invalid location index: " + index.string());
+        }
+    }
+
+    for (auto it = result.m_locations.begin(); it != result.m_locations.end();)
+    {
+        std::error_code ec;
+        auto            size = fs::file_size(event_file(trace, it->first), ec);
+        if (ec || size != it->second.event_file_size)
+        {
+            it = result.m_locations.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return result;
+}
+
+LocationIndexRecorder::LocationIndexRecorder(const fs::path &trace) : m_trace(trace)
+{
+}
+
+LocationIndex
+LocationIndexRecorder::index() const
+{
+    LocationIndex result;
+    for (const auto &location : m_usage)
+    {
+        LocationUsage usage;
+        std::error_code ec;
+        usage.event_file_size = fs::file_size(event_file(m_trace, location.first), ec);
+        usage.event_counts    = location.second->event_counts;
+        usage.io_handles.assign(location.second->io_handles.begin(), location.second->io_handles.end());
+        usage.io_files.assign(location.second->io_files.begin(), location.second->io_files.end());
+        std::sort(usage.io_handles.begin(), usage.io_handles.end());
+        std::sort(usage.io_files.begin(), usage.io_files.end());
+        result.add(location.first, std::move(usage));
+    }
+    return result;
+}
+
+IFilterCallbacks::Callbacks
+LocationIndexRecorder::get_callbacks()
+{
+    Callbacks c;
+
+    c.global_location_callback = [this](OTF2_LocationRef      self,
+                                        OTF2_StringRef        name,
+                                        OTF2_LocationType     locationType,
+                                        uint64_t              numberOfEvents,
+                                        OTF2_LocationGroupRef locationGroup) {
+        auto &usage = m_usage[self];
+        if (!usage)
+        {
+            usage = std::make_unique<Usage>();
+            usage->event_counts.assign(number_of_event_types, 0);
+        }
+        return false;
+    };
+
+    c.event_buffer_flush_callback = [this](OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes,
+                                           OTF2_TimeStamp      stopTime) {
+        record(location, EventType::BufferFlush);
+        return false;
+    };
+    c.event_measurement_on_off_callback = [this](OTF2_LocationRef     location,
+                                                 OTF2_TimeStamp       time,
+                                                 OTF2_AttributeList * attributes,
+                                                 OTF2_MeasurementMode measurementMode) {
+        record(location, EventType::MeasurementOnOff);
+        return false;
+    };
+    c.event_enter_callback = [this](OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_RegionRef      region) {
+        record(location, EventType::Enter);
+        return false;
+    };
+    c.event_leave_callback = [this](OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_RegionRef      region) {
+        record(location, EventType::Leave);
+        return false;
+    };
+    c.event_mpi_send_callback = [this](OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint32_t            receiver,
+                                       OTF2_CommRef        communicator,
+                                       uint32_t            msgTag,
+                                       uint64_t            msgLength) {
+        record(location, EventType::MpiSend);
+        return false;
+    };
+    c.event_mpi_isend_callback = [this](OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        uint32_t            receiver,
+                                        OTF2_CommRef        communicator,
+                                        uint32_t            msgTag,
+                                        uint64_t            msgLength,
+                                        uint64_t            requestID) {
+        record(location, EventType::MpiIsend);
+        return false;
+    };
+    c.event_mpi_isend_complete_callback = [this](OTF2_LocationRef    location,
+                                                 OTF2_TimeStamp      time,
+                                                 OTF2_AttributeList *attributes,
+                                                 uint64_t            requestID) {
+        record(location, EventType::MpiIsendComplete);
+        return false;
+    };
+    c.event_mpi_irecv_request_callback = [this](OTF2_LocationRef    location,
+                                                OTF2_TimeStamp      time,
+                                                OTF2_AttributeList *attributes,
+                                                uint64_t            requestID) {
+        record(location, EventType::MpiIrecvRequest);
+        return false;
+    };
+    c.event_mpi_recv_callback = [this](OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint32_t            sender,
+                                       OTF2_CommRef        communicator,
+                                       uint32_t            msgTag,
+                                       uint64_t            msgLength) {
+        record(location, EventType::MpiRecv);
+        return false;
+    };
+    c.event_mpi_irecv_callback = [this](OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        uint32_t            sender,
+                                        OTF2_CommRef        communicator,
+                                        uint32_t            msgTag,
+                                        uint64_t            msgLength,
+                                        uint64_t            requestID) {
+        record(location, EventType::MpiIrecv);
+        return false;
+    };
+    c.event_mpi_request_test_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               uint64_t            requestID) {
+        record(location, EventType::MpiRequestTest);
+        return false;
+    };
+    c.event_mpi_request_cancelled_callback = [this](OTF2_LocationRef    location,
+                                                    OTF2_TimeStamp      time,
+                                                    OTF2_AttributeList *attributes,
+                                                    uint64_t            requestID) {
+        record(location, EventType::MpiRequestCancelled);
+        return false;
+    };
+    c.event_mpi_collective_begin_callback = [this](OTF2_LocationRef    location,
+                                                   OTF2_TimeStamp      time,
+                                                   OTF2_AttributeList *attributes) {
+        record(location, EventType::MpiCollectiveBegin);
+        return false;
+    };
+    c.event_mpi_collective_end_callback = [this](OTF2_LocationRef    location,
+                                                 OTF2_TimeStamp      time,
+                                                 OTF2_AttributeList *attributes,
+                                                 OTF2_CollectiveOp   collectiveOp,
+                                                 OTF2_CommRef        communicator,
+                                                 uint32_t            root,
+                                                 uint64_t            sizeSent,
+                                                 uint64_t            sizeReceived) {
+        record(location, EventType::MpiCollectiveEnd);
+        return false;
+    };
+    c.event_omp_fork_callback = [this](OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint32_t            numberOfRequestedThreads) {
+        record(location, EventType::OmpFork);
+        return false;
+    };
+    c.event_omp_join_callback = [this](OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes) {
+        record(location, EventType::OmpJoin);
+        return false;
+    };
+    c.event_omp_acquire_lock_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               uint32_t            lockID,
+                                               uint32_t            acquisitionOrder) {
+        record(location, EventType::OmpAcquireLock);
+        return false;
+    };
+    c.event_omp_release_lock_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               uint32_t            lockID,
+                                               uint32_t            acquisitionOrder) {
+        record(location, EventType::OmpReleaseLock);
+        return false;
+    };
+    c.event_omp_task_create_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              uint64_t            taskID) {
+        record(location, EventType::OmpTaskCreate);
+        return false;
+    };
+    c.event_omp_task_switch_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              uint64_t            taskID) {
+        record(location, EventType::OmpTaskSwitch);
+        return false;
+    };
+    c.event_omp_task_complete_callback = [this](OTF2_LocationRef    location,
+                                                OTF2_TimeStamp      time,
+                                                OTF2_AttributeList *attributes,
+                                                uint64_t            taskID) {
+        record(location, EventType::OmpTaskComplete);
+        return false;
+    };
+    c.event_metric_callback = [this](OTF2_LocationRef        location,
+                                     OTF2_TimeStamp          time,
+                                     OTF2_AttributeList *    attributes,
+                                     OTF2_MetricRef          metric,
+                                     uint8_t                 numberOfMetrics,
+                                     const OTF2_Type *       typeIDs,
+                                     const OTF2_MetricValue *metricValues) {
+        record(location, EventType::Metric);
+        return false;
+    };
+    c.event_parameter_string_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               OTF2_ParameterRef   parameter,
+                                               OTF2_StringRef      string) {
+        record(location, EventType::ParameterString);
+        return false;
+    };
+    c.event_parameter_int_callback = [this](OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_ParameterRef   parameter,
+                                            int64_t             value) {
+        record(location, EventType::ParameterInt);
+        return false;
+    };
+    c.event_parameter_unsigned_int_callback = [this](OTF2_LocationRef    location,
+                                                     OTF2_TimeStamp      time,
+                                                     OTF2_AttributeList *attributes,
+                                                     OTF2_ParameterRef   parameter,
+                                                     uint64_t            value) {
+        record(location, EventType::ParameterUnsignedInt);
+        return false;
+    };
+    c.event_rma_win_create_callback = [this](OTF2_LocationRef    location,
+                                             OTF2_TimeStamp      time,
+                                             OTF2_AttributeList *attributes,
+                                             OTF2_RmaWinRef      win) {
+        record(location, EventType::RmaWinCreate);
+        return false;
+    };
+    c.event_rma_win_destroy_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              OTF2_RmaWinRef      win) {
+        record(location, EventType::RmaWinDestroy);
+        return false;
+    };
+    c.event_rma_collective_begin_callback = [this](OTF2_LocationRef    location,
+                                                   OTF2_TimeStamp      time,
+                                                   OTF2_AttributeList *attributes) {
+        record(location, EventType::RmaCollectiveBegin);
+        return false;
+    };
+    c.event_rma_collective_end_callback = [this](OTF2_LocationRef    location,
+                                                 OTF2_TimeStamp      time,
+                                                 OTF2_AttributeList *attributes,
+                                                 OTF2_CollectiveOp   collectiveOp,
+                                                 OTF2_RmaSyncLevel   syncLevel,
+                                                 OTF2_RmaWinRef      win,
+                                                 uint32_t            root,
+                                                 uint64_t            bytesSent,
+                                                 uint64_t            bytesReceived) {
+        record(location, EventType::RmaCollectiveEnd);
+        return false;
+    };
+    c.event_rma_group_sync_callback = [this](OTF2_LocationRef    location,
+                                             OTF2_TimeStamp      time,
+                                             OTF2_AttributeList *attributes,
+                                             OTF2_RmaSyncLevel   syncLevel,
+                                             OTF2_RmaWinRef      win,
+                                             OTF2_GroupRef       group) {
+        record(location, EventType::RmaGroupSync);
+        return false;
+    };
+    c.event_rma_request_lock_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               OTF2_RmaWinRef      win,
+                                               uint32_t            remote,
+                                               uint64_t            lockId,
+                                               OTF2_LockType       lockType) {
+        record(location, EventType::RmaRequestLock);
+        return false;
+    };
+    c.event_rma_acquire_lock_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               OTF2_RmaWinRef      win,
+                                               uint32_t            remote,
+                                               uint64_t            lockId,
+                                               OTF2_LockType       lockType) {
+        record(location, EventType::RmaAcquireLock);
+        return false;
+    };
+    c.event_rma_try_lock_callback = [this](OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes,
+                                           OTF2_RmaWinRef      win,
+                                           uint32_t            remote,
+                                           uint64_t            lockId,
+                                           OTF2_LockType       lockType) {
+        record(location, EventType::RmaTryLock);
+        return false;
+    };
+    c.event_rma_release_lock_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               OTF2_RmaWinRef      win,
+                                               uint32_t            remote,
+                                               uint64_t            lockId) {
+        record(location, EventType::RmaReleaseLock);
+        return false;
+    };
+    c.event_rma_sync_callback = [this](OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_RmaWinRef      win,
+                                       uint32_t            remote,
+                                       OTF2_RmaSyncType    syncType) {
+        record(location, EventType::RmaSync);
+        return false;
+    };
+    c.event_rma_wait_change_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              OTF2_RmaWinRef      win) {
+        record(location, EventType::RmaWaitChange);
+        return false;
+    };
+    c.event_rma_put_callback = [this](OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_RmaWinRef      win,
+                                      uint32_t            remote,
+                                      uint64_t            bytes,
+                                      uint64_t            matchingId) {
+        record(location, EventType::RmaPut);
+        return false;
+    };
+    c.event_rma_get_callback = [this](OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_RmaWinRef      win,
+                                      uint32_t            remote,
+                                      uint64_t            bytes,
+                                      uint64_t            matchingId) {
+        record(location, EventType::RmaGet);
+        return false;
+    };
+    c.event_rma_atomic_callback = [this](OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_RmaWinRef      win,
+                                         uint32_t            remote,
+                                         OTF2_RmaAtomicType  type,
+                                         uint64_t            bytesSent,
+                                         uint64_t            bytesReceived,
+                                         uint64_t            matchingId) {
+        record(location, EventType::RmaAtomic);
+        return false;
+    };
+    c.event_rma_op_complete_blocking_callback = [this](OTF2_LocationRef    location,
+                                                       OTF2_TimeStamp      time,
+                                                       OTF2_AttributeList *attributes,
+                                                       OTF2_RmaWinRef      win,
+                                                       uint64_t            matchingId) {
+        record(location, EventType::RmaOpCompleteBlocking);
+        return false;
+    };
+    c.event_rma_op_complete_non_blocking_callback = [this](OTF2_LocationRef    location,
+                                                           OTF2_TimeStamp      time,
+                                                           OTF2_AttributeList *attributes,
+                                                           OTF2_RmaWinRef      win,
+                                                           uint64_t            matchingId) {
+        record(location, EventType::RmaOpCompleteNonBlocking);
+        return false;
+    };
+    c.event_rma_op_test_callback = [this](OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_RmaWinRef      win,
+                                          uint64_t            matchingId) {
+        record(location, EventType::RmaOpTest);
+        return false;
+    };
+    c.event_rma_op_complete_remote_callback = [this](OTF2_LocationRef    location,
+                                                     OTF2_TimeStamp      time,
+                                                     OTF2_AttributeList *attributes,
+                                                     OTF2_RmaWinRef      win,
+                                                     uint64_t            matchingId) {
+        record(location, EventType::RmaOpCompleteRemote);
+        return false;
+    };
+    c.event_thread_fork_callback = [this](OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_Paradigm       model,
+                                          uint32_t            numberOfRequestedThreads) {
+        record(location, EventType::ThreadFork);
+        return false;
+    };
+    c.event_thread_join_callback = [this](OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_Paradigm       model) {
+        record(location, EventType::ThreadJoin);
+        return false;
+    };
+    c.event_thread_team_begin_callback = [this](OTF2_LocationRef    location,
+                                                OTF2_TimeStamp      time,
+                                                OTF2_AttributeList *attributes,
+                                                OTF2_CommRef        threadTeam) {
+        record(location, EventType::ThreadTeamBegin);
+        return false;
+    };
+    c.event_thread_team_end_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              OTF2_CommRef        threadTeam) {
+        record(location, EventType::ThreadTeamEnd);
+        return false;
+    };
+    c.event_thread_acquire_lock_callback = [this](OTF2_LocationRef    location,
+                                                  OTF2_TimeStamp      time,
+                                                  OTF2_AttributeList *attributes,
+                                                  OTF2_Paradigm       model,
+                                                  uint32_t            lockID,
+                                                  uint32_t            acquisitionOrder) {
+        record(location, EventType::ThreadAcquireLock);
+        return false;
+    };
+    c.event_thread_release_lock_callback = [this](OTF2_LocationRef    location,
+                                                  OTF2_TimeStamp      time,
+                                                  OTF2_AttributeList *attributes,
+                                                  OTF2_Paradigm       model,
+                                                  uint32_t            lockID,
+                                                  uint32_t            acquisitionOrder) {
+        record(location, EventType::ThreadReleaseLock);
+        return false;
+    };
+    c.event_thread_task_create_callback = [this](OTF2_LocationRef    location,
+                                                 OTF2_TimeStamp      time,
+                                                 OTF2_AttributeList *attributes,
+                                                 OTF2_CommRef        threadTeam,
+                                                 uint32_t            creatingThread,
+                                                 uint32_t            generationNumber) {
+        record(location, EventType::ThreadTaskCreate);
+        return false;
+    };
+    c.event_thread_task_switch_callback = [this](OTF2_LocationRef    location,
+                                                 OTF2_TimeStamp      time,
+                                                 OTF2_AttributeList *attributes,
+                                                 OTF2_CommRef        threadTeam,
+                                                 uint32_t            creatingThread,
+                                                 uint32_t            generationNumber) {
+        record(location, EventType::ThreadTaskSwitch);
+        return false;
+    };
+    c.event_thread_task_complete_callback = [this](OTF2_LocationRef    location,
+                                                   OTF2_TimeStamp      time,
+                                                   OTF2_AttributeList *attributes,
+                                                   OTF2_CommRef        threadTeam,
+                                                   uint32_t            creatingThread,
+                                                   uint32_t            generationNumber) {
+        record(location, EventType::ThreadTaskComplete);
+        return false;
+    };
+    c.event_thread_create_callback = [this](OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_CommRef        threadContingent,
+                                            uint64_t            sequenceCount) {
+        record(location, EventType::ThreadCreate);
+        return false;
+    };
+    c.event_thread_begin_callback = [this](OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes,
+                                           OTF2_CommRef        threadContingent,
+                                           uint64_t            sequenceCount) {
+        record(location, EventType::ThreadBegin);
+        return false;
+    };
+    c.event_thread_wait_callback = [this](OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_CommRef        threadContingent,
+                                          uint64_t            sequenceCount) {
+        record(location, EventType::ThreadWait);
+        return false;
+    };
+    c.event_thread_end_callback = [this](OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_CommRef        threadContingent,
+                                         uint64_t            sequenceCount) {
+        record(location, EventType::ThreadEnd);
+        return false;
+    };
+    c.event_calling_context_enter_callback = [this](OTF2_LocationRef       location,
+                                                    OTF2_TimeStamp         time,
+                                                    OTF2_AttributeList *   attributes,
+                                                    OTF2_CallingContextRef callingContext,
+                                                    uint32_t               unwindDistance) {
+        record(location, EventType::CallingContextEnter);
+        return false;
+    };
+    c.event_calling_context_leave_callback = [this](OTF2_LocationRef       location,
+                                                    OTF2_TimeStamp         time,
+                                                    OTF2_AttributeList *   attributes,
+                                                    OTF2_CallingContextRef callingContext) {
+        record(location, EventType::CallingContextLeave);
+        return false;
+    };
+    c.event_calling_context_sample_callback = [this](OTF2_LocationRef           location,
+                                                     OTF2_TimeStamp             time,
+                                                     OTF2_AttributeList *       attributes,
+                                                     OTF2_CallingContextRef     callingContext,
+                                                     uint32_t                   unwindDistance,
+                                                     OTF2_InterruptGeneratorRef interruptGenerator) {
+        record(location, EventType::CallingContextSample);
+        return false;
+    };
+    c.event_io_create_handle_callback = [this](OTF2_LocationRef    location,
+                                               OTF2_TimeStamp      time,
+                                               OTF2_AttributeList *attributes,
+                                               OTF2_IoHandleRef    handle,
+                                               OTF2_IoAccessMode   mode,
+                                               OTF2_IoCreationFlag creationFlags,
+                                               OTF2_IoStatusFlag   statusFlags) {
+        record(location, EventType::IoCreateHandle, handle);
+        return false;
+    };
+    c.event_io_destroy_handle_callback = [this](OTF2_LocationRef    location,
+                                                OTF2_TimeStamp      time,
+                                                OTF2_AttributeList *attributes,
+                                                OTF2_IoHandleRef    handle) {
+        record(location, EventType::IoDestroyHandle, handle);
+        return false;
+    };
+    c.event_io_duplicate_handle_callback = [this](OTF2_LocationRef    location,
+                                                  OTF2_TimeStamp      time,
+                                                  OTF2_AttributeList *attributes,
+                                                  OTF2_IoHandleRef    oldHandle,
+                                                  OTF2_IoHandleRef    newHandle,
+                                                  OTF2_IoStatusFlag   statusFlags) {
+        record(location, EventType::IoDuplicateHandle, oldHandle);
+        record_handle(location, newHandle);
+        return false;
+    };
+    c.event_io_seek_callback = [this](OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_IoHandleRef    handle,
+                                      int64_t             offsetRequest,
+                                      OTF2_IoSeekOption   whence,
+                                      uint64_t            offsetResult) {
+        record(location, EventType::IoSeek, handle);
+        return false;
+    };
+    c.event_io_change_status_flags_callback = [this](OTF2_LocationRef    location,
+                                                     OTF2_TimeStamp      time,
+                                                     OTF2_AttributeList *attributes,
+                                                     OTF2_IoHandleRef    handle,
+                                                     OTF2_IoStatusFlag   statusFlags) {
+        record(location, EventType::IoChangeStatusFlags, handle);
+        return false;
+    };
+    c.event_io_delete_file_callback = [this](OTF2_LocationRef    location,
+                                             OTF2_TimeStamp      time,
+                                             OTF2_AttributeList *attributes,
+                                             OTF2_IoParadigmRef  ioParadigm,
+                                             OTF2_IoFileRef      file) {
+        record_file(location, EventType::IoDeleteFile, file);
+        return false;
+    };
+    c.event_io_operation_begin_callback = [this](OTF2_LocationRef     location,
+                                                 OTF2_TimeStamp       time,
+                                                 OTF2_AttributeList * attributes,
+                                                 OTF2_IoHandleRef     handle,
+                                                 OTF2_IoOperationMode mode,
+                                                 OTF2_IoOperationFlag operationFlags,
+                                                 uint64_t             bytesRequest,
+                                                 uint64_t             matchingId) {
+        record(location, EventType::IoOperationBegin, handle);
+        return false;
+    };
+    c.event_io_operation_test_callback = [this](OTF2_LocationRef    location,
+                                                OTF2_TimeStamp      time,
+                                                OTF2_AttributeList *attributes,
+                                                OTF2_IoHandleRef    handle,
+                                                uint64_t            matchingId) {
+        record(location, EventType::IoOperationTest, handle);
+        return false;
+    };
+    c.event_io_operation_issued_callback = [this](OTF2_LocationRef    location,
+                                                  OTF2_TimeStamp      time,
+                                                  OTF2_AttributeList *attributes,
+                                                  OTF2_IoHandleRef    handle,
+                                                  uint64_t            matchingId) {
+        record(location, EventType::IoOperationIssued, handle);
+        return false;
+    };
+    c.event_io_operation_complete_callback = [this](OTF2_LocationRef    location,
+                                                    OTF2_TimeStamp      time,
+                                                    OTF2_AttributeList *attributes,
+                                                    OTF2_IoHandleRef    handle,
+                                                    uint64_t            bytesResult,
+                                                    uint64_t            matchingId) {
+        record(location, EventType::IoOperationComplete, handle);
+        return false;
+    };
+    c.event_io_operation_cancelled_callback = [this](OTF2_LocationRef    location,
+                                                     OTF2_TimeStamp      time,
+                                                     OTF2_AttributeList *attributes,
+                                                     OTF2_IoHandleRef    handle,
+                                                     uint64_t            matchingId) {
+        record(location, EventType::IoOperationCancelled, handle);
+        return false;
+    };
+    c.event_io_acquire_lock_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              OTF2_IoHandleRef    handle,
+                                              OTF2_LockType       lockType) {
+        record(location, EventType::IoAcquireLock, handle);
+        return false;
+    };
+    c.event_io_release_lock_callback = [this](OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              OTF2_IoHandleRef    handle,
+                                              OTF2_LockType       lockType) {
+        record(location, EventType::IoReleaseLock, handle);
+        return false;
+    };
+    c.event_io_try_lock_callback = [this](OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_IoHandleRef    handle,
+                                          OTF2_LockType       lockType) {
+        record(location, EventType::IoTryLock, handle);
+        return false;
+    };
+    c.event_program_begin_callback = [this](OTF2_LocationRef      location,
+                                            OTF2_TimeStamp        time,
+                                            OTF2_AttributeList *  attributes,
+                                            OTF2_StringRef        programName,
+                                            uint32_t              numberOfArguments,
+                                            const OTF2_StringRef *programArguments) {
+        record(location, EventType::ProgramBegin);
+        return false;
+    };
+    c.event_program_end_callback = [this](OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          int64_t             exitStatus) {
+        record(location, EventType::ProgramEnd);
+        return false;
+    };
+
+    return c;
+}
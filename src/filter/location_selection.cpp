@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <location_selection.hpp>
+
+void
+LocationSelection::add_location_pattern(const std::string &pattern)
+{
+    m_location_patterns.add(pattern);
+}
+
+void
+LocationSelection::add_group_pattern(const std::string &pattern)
+{
+    m_group_patterns.add(pattern);
+}
+
+void
+LocationSelection::add_type(OTF2_LocationType type)
+{
+    m_types.push_back(type);
+}
+
+OTF2_LocationType
+LocationSelection::parse_type(const std::string &name)
+{
+    if (name == "cpu_thread")
+    {
+        return OTF2_LOCATION_TYPE_CPU_THREAD;
+    }
+    if (name == "gpu")
+    {
+        return OTF2_LOCATION_TYPE_GPU;
+    }
+    if (name == "metric")
+    {
+        return OTF2_LOCATION_TYPE_METRIC;
+    }
+    if (name == "unknown")
+    {
+        return OTF2_LOCATION_TYPE_UNKNOWN;
+    }
+    throw std::invalid_argument("Unknown location type: " + name);
+}
+
+IFilterCallbacks::Callbacks
+LocationSelection::get_callbacks()
+{
+    Callbacks c;
+
+    if (m_string_table == nullptr)
+    {
+        /* not registered at a writer, collect the strings on our own */
+        m_string_table           = &m_strings;
+        c.global_string_callback = [this](OTF2_StringRef self, const char *string) {
+            m_strings.add(self, string);
+            return false;
+        };
+    }
+
+    c.global_system_tree_node_callback = [this](OTF2_SystemTreeNodeRef self,
+                                                OTF2_StringRef         name,
+                                                OTF2_StringRef         className,
+                                                OTF2_SystemTreeNodeRef parent) {
+        m_nodes[self] = {name, parent};
+        return false;
+    };
+
+    c.global_location_group_callback = [this](OTF2_LocationGroupRef  self,
+                                              OTF2_StringRef         name,
+                                              OTF2_LocationGroupType locationGroupType,
+                                              OTF2_SystemTreeNodeRef systemTreeParent) {
+        m_groups[self] = {name, systemTreeParent};
+        return false;
+    };
+
+    c.global_location_callback = [this](OTF2_LocationRef      self,
+                                        OTF2_StringRef        name,
+                                        OTF2_LocationType     locationType,
+                                        uint64_t              numberOfEvents,
+                                        OTF2_LocationGroupRef locationGroup) {
+        if (selects(name, locationType, locationGroup))
+        {
+            return false;
+        }
+        m_dropped++;
+        return true;
+    };
+
+    return c;
+}
+
+std::vector<GlobalDefinition>
+LocationSelection::string_references() const
+{
+    return {GlobalDefinition::SystemTreeNode, GlobalDefinition::LocationGroup, GlobalDefinition::Location};
+}
+
+bool
+LocationSelection::selects(OTF2_StringRef name, OTF2_LocationType type, OTF2_LocationGroupRef group) const
+{
+    if (!m_types.empty() && std::find(m_types.begin(), m_types.end(), type) == m_types.end())
+    {
+        return false;
+    }
+    if (m_location_patterns.size() == 0 && m_group_patterns.size() == 0)
+    {
+        return true;
+    }
+    return matches(m_location_patterns, name) || group_matches(group);
+}
+
+/*
+ * The system tree is walked from the node of the group up to its root, a
+ * cycle ends the walk after as many steps as there are nodes.
+ */
+bool
+LocationSelection::group_matches(OTF2_LocationGroupRef group) const
+{
+    auto search = m_groups.find(group);
+    if (m_group_patterns.size() == 0 || search == m_groups.end())
+    {
+        return false;
+    }
+    if (matches(m_group_patterns, search->second.name))
+    {
+        return true;
+    }
+    auto node = m_nodes.find(search->second.node);
+    for (std::size_t depth = 0; node != m_nodes.end() && depth < m_nodes.size(); depth++)
+    {
+        if (matches(m_group_patterns, node->second.name))
+        {
+            return true;
+        }
+        node = m_nodes.find(node->second.parent);
+    }
+    return false;
+}
@@ -0,0 +1,197 @@
+#include <stdexcept>
+
+#include <record_class_filter.hpp>
+
+void
+RecordClassFilter::add_class(RecordClass record_class)
+{
+    m_classes[static_cast<std::size_t>(record_class)] = true;
+}
+
+RecordClass
+RecordClassFilter::parse_class(const std::string &name)
+{
+    if (name == "omp")
+    {
+        return RecordClass::OpenMp;
+    }
+    if (name == "thread")
+    {
+        return RecordClass::Thread;
+    }
+    if (name == "rma")
+    {
+        return RecordClass::Rma;
+    }
+    if (name == "calling_context")
+    {
+        return RecordClass::CallingContext;
+    }
+    throw std::invalid_argument("Unknown record class: " + name);
+}
+
+IFilterCallbacks::Callbacks
+RecordClassFilter::get_callbacks()
+{
+    Callbacks c;
+
+    if (drops(RecordClass::Rma))
+    {
+        c.global_rma_win_callback = [](OTF2_RmaWinRef self, OTF2_StringRef name, OTF2_CommRef comm) { return true; };
+    }
+
+    if (drops(RecordClass::CallingContext))
+    {
+        c.global_source_code_location_callback =
+            [](OTF2_SourceCodeLocationRef self, OTF2_StringRef file, uint32_t lineNumber) { return true; };
+
+        c.global_calling_context_callback = [](OTF2_CallingContextRef     self,
+                                               OTF2_RegionRef             region,
+                                               OTF2_SourceCodeLocationRef sourceCodeLocation,
+                                               OTF2_CallingContextRef     parent) { return true; };
+
+        c.global_calling_context_property_callback = [](OTF2_CallingContextRef callingContext,
+                                                        OTF2_StringRef         name,
+                                                        OTF2_Type              type,
+                                                        OTF2_AttributeValue    value) { return true; };
+
+        c.global_interrupt_generator_callback = [](OTF2_InterruptGeneratorRef  self,
+                                                   OTF2_StringRef              name,
+                                                   OTF2_InterruptGeneratorMode interruptGeneratorMode,
+                                                   OTF2_Base                   base,
+                                                   int64_t                     exponent,
+                                                   uint64_t                    period) { return true; };
+    }
+
+    if (drops(RecordClass::Rma) || drops(RecordClass::CallingContext))
+    {
+        c.global_attribute_callback =
+            [this](OTF2_AttributeRef self, OTF2_StringRef name, OTF2_StringRef description, OTF2_Type type) {
+                return drops_type(type);
+            };
+
+        c.global_paradigm_property_callback =
+            [this](OTF2_Paradigm paradigm, OTF2_ParadigmProperty property, OTF2_Type type, OTF2_AttributeValue value) {
+                return drops_type(type);
+            };
+
+        c.global_system_tree_node_property_callback = [this](OTF2_SystemTreeNodeRef systemTreeNode,
+                                                             OTF2_StringRef         name,
+                                                             OTF2_Type              type,
+                                                             OTF2_AttributeValue    value) {
+            return drops_type(type);
+        };
+
+        c.global_location_group_property_callback = [this](OTF2_LocationGroupRef locationGroup,
+                                                           OTF2_StringRef        name,
+                                                           OTF2_Type             type,
+                                                           OTF2_AttributeValue   value) { return drops_type(type); };
+
+        c.global_location_property_callback =
+            [this](OTF2_LocationRef location, OTF2_StringRef name, OTF2_Type type, OTF2_AttributeValue value) {
+                return drops_type(type);
+            };
+
+        c.global_io_file_property_callback =
+            [this](OTF2_IoFileRef ioFile, OTF2_StringRef name, OTF2_Type type, OTF2_AttributeValue value) {
+                return drops_type(type);
+            };
+
+        c.global_callpath_parameter_callback =
+            [this](OTF2_CallpathRef callpath, OTF2_ParameterRef parameter, OTF2_Type type, OTF2_AttributeValue value) {
+                return drops_type(type);
+            };
+    }
+
+    return c;
+}
+
+std::vector<OTF2_Type>
+RecordClassFilter::dropped_attribute_types() const
+{
+    std::vector<OTF2_Type> types;
+    if (drops(RecordClass::Rma))
+    {
+        types.push_back(OTF2_TYPE_RMA_WIN);
+    }
+    if (drops(RecordClass::CallingContext))
+    {
+        types.insert(types.end(),
+                     {OTF2_TYPE_CALLING_CONTEXT, OTF2_TYPE_SOURCE_CODE_LOCATION, OTF2_TYPE_INTERRUPT_GENERATOR});
+    }
+    return types;
+}
+
+bool
+RecordClassFilter::drops_type(OTF2_Type type) const
+{
+    if (type == OTF2_TYPE_RMA_WIN)
+    {
+        return drops(RecordClass::Rma);
+    }
+    return (type == OTF2_TYPE_CALLING_CONTEXT || type == OTF2_TYPE_SOURCE_CODE_LOCATION ||
+            type == OTF2_TYPE_INTERRUPT_GENERATOR) &&
+           drops(RecordClass::CallingContext);
+}
+
+std::vector<EventType>
+RecordClassFilter::dropped_event_types() const
+{
+    std::vector<EventType> types;
+    if (drops(RecordClass::OpenMp))
+    {
+        types.insert(types.end(),
+                     {EventType::OmpFork,
+                      EventType::OmpJoin,
+                      EventType::OmpAcquireLock,
+                      EventType::OmpReleaseLock,
+                      EventType::OmpTaskCreate,
+                      EventType::OmpTaskSwitch,
+                      EventType::OmpTaskComplete});
+    }
+    if (drops(RecordClass::Thread))
+    {
+        types.insert(types.end(),
+                     {EventType::ThreadFork,
+                      EventType::ThreadJoin,
+                      EventType::ThreadTeamBegin,
+                      EventType::ThreadTeamEnd,
+                      EventType::ThreadAcquireLock,
+                      EventType::ThreadReleaseLock,
+                      EventType::ThreadTaskCreate,
+                      EventType::ThreadTaskSwitch,
+                      EventType::ThreadTaskComplete,
+                      EventType::ThreadCreate,
+                      EventType::ThreadBegin,
+                      EventType::ThreadWait,
+                      EventType::ThreadEnd});
+    }
+    if (drops(RecordClass::Rma))
+    {
+        types.insert(types.end(),
+                     {EventType::RmaWinCreate,
+                      EventType::RmaWinDestroy,
+                      EventType::RmaCollectiveBegin,
+                      EventType::RmaCollectiveEnd,
+                      EventType::RmaGroupSync,
+                      EventType::RmaRequestLock,
+                      EventType::RmaAcquireLock,
+                      EventType::RmaTryLock,
+                      EventType::RmaReleaseLock,
+                      EventType::RmaSync,
+                      EventType::RmaWaitChange,
+                      EventType::RmaPut,
+                      EventType::RmaGet,
+                      EventType::RmaAtomic,
+                      EventType::RmaOpCompleteBlocking,
+                      EventType::RmaOpCompleteNonBlocking,
+                      EventType::RmaOpTest,
+                      EventType::RmaOpCompleteRemote});
+    }
+    if (drops(RecordClass::CallingContext))
+    {
+        types.insert(types.end(),
+                     {EventType::CallingContextEnter, EventType::CallingContextLeave, EventType::CallingContextSample});
+    }
+    return types;
+}
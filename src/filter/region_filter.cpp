@@ -0,0 +1,223 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <region_filter.hpp>
+
+extern "C"
+{
+#include <fnmatch.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace
+{
+/*
+ * Remove a comment, a '#' escaped by a backslash is kept.
+ */
+std::string
+strip_comment(const std::string &line)
+{
+    for (std::size_t i = 0; i < line.size(); i++)
+    {
+        if (line[i] == '\\')
+        {
+            i++;
+        }
+        else if (line[i] == '#')
+        {
+            return line.substr(0, i);
+        }
+    }
+    return line;
+}
+
+/*
+ * Remove leading and trailing whitespace.
+ */
+std::string
+trim(const std::string &line)
+{
+    const char *whitespace = " \t\r\n\f\v";
+    auto        begin      = line.find_first_not_of(whitespace);
+    if (begin == std::string::npos)
+    {
+        return "";
+    }
+    return line.substr(begin, line.find_last_not_of(whitespace) - begin + 1);
+}
+
+bool
+is_scorep_keyword(const std::string &token)
+{
+    return token == "SCOREP_REGION_NAMES_BEGIN" || token == "SCOREP_REGION_NAMES_END" ||
+           token == "SCOREP_FILE_NAMES_BEGIN" || token == "SCOREP_FILE_NAMES_END";
+}
+} // namespace
+
+RegionFilterPattern::RegionFilterPattern(const fs::path &pattern_file)
+{
+    std::ifstream in(pattern_file, std::ios::in);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("Could not load pattern file: " + pattern_file.string());
+    }
+    std::vector<std::string> lines;
+    bool                     scorep = false;
+    std::string              line;
+    while (std::getline(in, line))
+    {
+        std::istringstream tokens(strip_comment(line));
+        std::string        token;
+        scorep = scorep || ((tokens >> token) && is_scorep_keyword(token));
+        lines.push_back(line);
+    }
+
+    if (scorep)
+    {
+        parse_scorep(lines, pattern_file);
+        return;
+    }
+    for (const auto &line : lines)
+    {
+        auto pattern = trim(strip_comment(line));
+        if (!pattern.empty())
+        {
+            m_region_rules.push_back({true, false, pattern});
+        }
+    }
+}
+
+void
+RegionFilterPattern::parse_scorep(const std::vector<std::string> &lines, const fs::path &pattern_file)
+{
+    std::vector<Rule> *rules   = nullptr;
+    bool               exclude = false;
+    bool               mangled = false;
+    bool               in_rule = false;
+    for (const auto &line : lines)
+    {
+        std::istringstream tokens(strip_comment(line));
+        std::string        token;
+        while (tokens >> token)
+        {
+            if (token == "SCOREP_REGION_NAMES_BEGIN" || token == "SCOREP_FILE_NAMES_BEGIN")
+            {
+                rules   = token == "SCOREP_REGION_NAMES_BEGIN" ? &m_region_rules : &m_file_rules;
+                in_rule = false;
+            }
+            else if (token == "SCOREP_REGION_NAMES_END" || token == "SCOREP_FILE_NAMES_END")
+            {
+                rules = nullptr;
+            }
+            else if (rules == nullptr)
+            {
+                throw std::runtime_error("Pattern outside of a filter block: " + pattern_file.string());
+            }
+            else if (token == "EXCLUDE" || token == "INCLUDE")
+            {
+                exclude = token == "EXCLUDE";
+                mangled = false;
+                in_rule = true;
+            }
+            else if (token == "MANGLED" && in_rule && rules == &m_region_rules)
+            {
+                mangled = true;
+            }
+            else if (!in_rule)
+            {
+                throw std::runtime_error("Pattern without EXCLUDE or INCLUDE: " + pattern_file.string());
+            }
+            else
+            {
+                rules->push_back({exclude, mangled, token});
+            }
+        }
+    }
+}
+
+bool
+RegionFilterPattern::excludes(const std::vector<Rule> &rules, const char *name, const char *canonical_name)
+{
+    for (auto rule = rules.rbegin(); rule != rules.rend(); ++rule)
+    {
+        if (fnmatch(rule->pattern.c_str(), rule->mangled ? canonical_name : name, 0) == 0)
+        {
+            return rule->exclude;
+        }
+    }
+    return false;
+}
+
+bool
+RegionFilterPattern::filterRegion(const char *name, const char *canonical_name, const char *source_file) const
+{
+    if (*source_file != '\0' && excludes(m_file_rules, source_file, source_file))
+    {
+        return true;
+    }
+    return excludes(m_region_rules, name, canonical_name);
+}
+
+RegionFilter::RegionFilter(const fs::path &pattern_file) : m_pattern(pattern_file)
+{
+}
+
+IFilterCallbacks::Callbacks
+RegionFilter::get_callbacks()
+{
+    Callbacks c;
+
+    if (m_string_table == nullptr)
+    {
+        /* not registered at a writer, collect the strings on our own */
+        m_string_table           = &m_strings;
+        c.global_string_callback = [this](OTF2_StringRef self, const char *string) {
+            m_strings.add(self, string);
+            return false;
+        };
+    }
+
+    c.global_region_callback = [this](OTF2_RegionRef  self,
+                                      OTF2_StringRef  name,
+                                      OTF2_StringRef  canonicalName,
+                                      OTF2_StringRef  description,
+                                      OTF2_RegionRole regionRole,
+                                      OTF2_Paradigm   paradigm,
+                                      OTF2_RegionFlag regionFlags,
+                                      OTF2_StringRef  sourceFile,
+                                      uint32_t        beginLineNumber,
+                                      uint32_t        endLineNumber) {
+        if (m_pattern.filterRegion(string(name), string(canonicalName), string(sourceFile)))
+        {
+            m_regions.insert(self);
+            m_filtered_regions.emplace_back(string(name));
+        }
+        return false;
+    };
+
+    c.event_enter_callback =
+        [this](OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes, OTF2_RegionRef region) {
+            return m_regions.contains(region);
+        };
+
+    c.event_leave_callback =
+        [this](OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes, OTF2_RegionRef region) {
+            return m_regions.contains(region);
+        };
+
+    return c;
+}
+
+std::vector<GlobalDefinition>
+RegionFilter::string_references() const
+{
+    return {GlobalDefinition::Region};
+}
+
+bool
+RegionFilter::affects_location(OTF2_LocationRef location)
+{
+    return !m_regions.empty();
+}
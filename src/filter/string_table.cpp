@@ -0,0 +1,70 @@
+#include <cstring>
+
+#include <string_table.hpp>
+
+StringTable::StringTable(Mode mode, std::size_t block_size) : m_mode(mode), m_block_size(block_size)
+{
+}
+
+void
+StringTable::set_mode(Mode mode)
+{
+    m_mode = mode;
+}
+
+void
+StringTable::reference(OTF2_StringRef ref)
+{
+    if (ref != OTF2_UNDEFINED_STRING)
+    {
+        m_referenced.insert(ref);
+    }
+}
+
+bool
+StringTable::add(OTF2_StringRef ref, const char *string)
+{
+    if (ref == OTF2_UNDEFINED_STRING || (m_mode == Mode::Referenced && !m_referenced.contains(ref)))
+    {
+        return false;
+    }
+
+    const std::size_t length  = std::strlen(string) + 1;
+    char *            storage = allocate(length);
+    std::memcpy(storage, string, length);
+
+    if (ref >= m_index.size())
+    {
+        m_index.resize(ref + 1, nullptr);
+    }
+    if (m_index[ref] == nullptr)
+    {
+        m_count++;
+    }
+    m_index[ref] = storage;
+    return true;
+}
+
+char *
+StringTable::allocate(std::size_t length)
+{
+    if (length > m_block_free)
+    {
+        /*
+         * Strings larger than a block get a block of their own, the
+         * remainder of the current block stays in use.
+         */
+        if (length > m_block_size / 4)
+        {
+            m_blocks.emplace_back(new char[length]);
+            return m_blocks.back().get();
+        }
+        m_blocks.emplace_back(new char[m_block_size]);
+        m_block_position = m_blocks.back().get();
+        m_block_free     = m_block_size;
+    }
+    char *storage = m_block_position;
+    m_block_position += length;
+    m_block_free -= length;
+    return storage;
+}
@@ -0,0 +1,100 @@
+#include <time_window_filter.hpp>
+
+TimeWindowFilter::TimeWindowFilter(TimeWindow window) : m_window(window)
+{
+}
+
+TimeWindow
+TimeWindowFilter::time_window() const
+{
+    return m_window;
+}
+
+IFilterCallbacks::Callbacks
+TimeWindowFilter::get_callbacks()
+{
+    Callbacks c;
+
+    auto outside =
+        [this](OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes, auto... args) {
+            return !m_window.contains(time);
+        };
+
+    c.event_buffer_flush_callback                 = outside;
+    c.event_measurement_on_off_callback           = outside;
+    c.event_enter_callback                        = outside;
+    c.event_leave_callback                        = outside;
+    c.event_mpi_send_callback                     = outside;
+    c.event_mpi_isend_callback                    = outside;
+    c.event_mpi_isend_complete_callback           = outside;
+    c.event_mpi_irecv_request_callback            = outside;
+    c.event_mpi_recv_callback                     = outside;
+    c.event_mpi_irecv_callback                    = outside;
+    c.event_mpi_request_test_callback             = outside;
+    c.event_mpi_request_cancelled_callback        = outside;
+    c.event_mpi_collective_begin_callback         = outside;
+    c.event_mpi_collective_end_callback           = outside;
+    c.event_omp_fork_callback                     = outside;
+    c.event_omp_join_callback                     = outside;
+    c.event_omp_acquire_lock_callback             = outside;
+    c.event_omp_release_lock_callback             = outside;
+    c.event_omp_task_create_callback              = outside;
+    c.event_omp_task_switch_callback              = outside;
+    c.event_omp_task_complete_callback            = outside;
+    c.event_metric_callback                       = outside;
+    c.event_parameter_string_callback             = outside;
+    c.event_parameter_int_callback                = outside;
+    c.event_parameter_unsigned_int_callback       = outside;
+    c.event_rma_win_create_callback               = outside;
+    c.event_rma_win_destroy_callback              = outside;
+    c.event_rma_collective_begin_callback         = outside;
+    c.event_rma_collective_end_callback           = outside;
+    c.event_rma_group_sync_callback               = outside;
+    c.event_rma_request_lock_callback             = outside;
+    c.event_rma_acquire_lock_callback             = outside;
+    c.event_rma_try_lock_callback                 = outside;
+    c.event_rma_release_lock_callback             = outside;
+    c.event_rma_sync_callback                     = outside;
+    c.event_rma_wait_change_callback              = outside;
+    c.event_rma_put_callback                      = outside;
+    c.event_rma_get_callback                      = outside;
+    c.event_rma_atomic_callback                   = outside;
+    c.event_rma_op_complete_blocking_callback     = outside;
+    c.event_rma_op_complete_non_blocking_callback = outside;
+    c.event_rma_op_test_callback                  = outside;
+    c.event_rma_op_complete_remote_callback       = outside;
+    c.event_thread_fork_callback                  = outside;
+    c.event_thread_join_callback                  = outside;
+    c.event_thread_team_begin_callback            = outside;
+    c.event_thread_team_end_callback              = outside;
+    c.event_thread_acquire_lock_callback          = outside;
+    c.event_thread_release_lock_callback          = outside;
+    c.event_thread_task_create_callback           = outside;
+    c.event_thread_task_switch_callback           = outside;
+    c.event_thread_task_complete_callback         = outside;
+    c.event_thread_create_callback                = outside;
+    c.event_thread_begin_callback                 = outside;
+    c.event_thread_wait_callback                  = outside;
+    c.event_thread_end_callback                   = outside;
+    c.event_calling_context_enter_callback        = outside;
+    c.event_calling_context_leave_callback        = outside;
+    c.event_calling_context_sample_callback       = outside;
+    c.event_io_create_handle_callback             = outside;
+    c.event_io_destroy_handle_callback            = outside;
+    c.event_io_duplicate_handle_callback          = outside;
+    c.event_io_seek_callback                      = outside;
+    c.event_io_change_status_flags_callback       = outside;
+    c.event_io_delete_file_callback               = outside;
+    c.event_io_operation_begin_callback           = outside;
+    c.event_io_operation_test_callback            = outside;
+    c.event_io_operation_issued_callback          = outside;
+    c.event_io_operation_complete_callback        = outside;
+    c.event_io_operation_cancelled_callback       = outside;
+    c.event_io_acquire_lock_callback              = outside;
+    c.event_io_release_lock_callback              = outside;
+    c.event_io_try_lock_callback                  = outside;
+    c.event_program_begin_callback                = outside;
+    c.event_program_end_callback                  = outside;
+
+    return c;
+}
@@ -0,0 +1,123 @@
+#ifndef CHUNK_POOL_H
+#define CHUNK_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+/*
+ * Recycles the chunks OTF2 buffers records in.
+ *
+ * Installed as memory callbacks of an archive, every chunk of an event or
+ * definition writer is taken from the pool and returns to it when the
+ * writer is flushed or closed. Returned chunks are cached by the thread
+ * returning them, so the next location a worker writes reuses the chunks
+ * of the previous one, which are already backed by pages. Chunks exceeding
+ * the cache of a thread are moved to a list shared by all threads.
+ *
+ * OTF2 flushes a buffer to its file when no further chunk can be
+ * allocated for it. A buffer therefore gets at most buffer_chunks chunks,
+ * afterwards the allocation fails, the buffer is flushed and its chunks
+ * are returned. With a memory limit, allocations also fail once the pool
+ * would exceed it, so buffers are flushed early instead of growing. Only
+ * the first chunk of a buffer is always allocated, the number of buffers
+ * filled at once has to be bounded by the caller.
+ *
+ * Chunks are carved out of slabs of at least huge_page_size bytes. With
+ * huge pages enabled, slabs are aligned to and advised as transparent huge
+ * pages. Slabs are only freed with the pool, which therefore has to
+ * outlive the archives using it.
+ */
+class ChunkPool
+{
+  public:
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    /*
+     * @param huge_pages back the chunks with transparent huge pages
+     * @param buffer_chunks chunks a buffer fills before it is flushed
+     * @param memory_limit bytes of slabs the pool may allocate, 0 for no limit
+     */
+    explicit ChunkPool(bool huge_pages = false, std::size_t buffer_chunks = 1, std::size_t memory_limit = 0);
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool &) = delete;
+    ChunkPool &
+    operator=(const ChunkPool &) = delete;
+
+    /*
+     * Allocate the chunks of the archive from this pool. OTF2 only accepts
+     * memory callbacks for archives opened for writing.
+     */
+    void
+    install(OTF2_Archive *archive);
+
+    /*
+     * @param required ignore the memory limit
+     * @return a chunk of chunk_size bytes or nullptr if out of memory
+     */
+    void *
+    allocate(uint64_t chunk_size, bool required = true);
+
+    void
+    release(void *chunk, uint64_t chunk_size);
+
+    /*
+     * @return bytes of all slabs allocated so far
+     */
+    inline std::size_t
+    reserved() const
+    {
+        return m_reserved.load(std::memory_order_relaxed);
+    }
+
+  private:
+    using ChunkList = std::vector<void *>;
+
+    /*
+     * Free chunks of one thread, only accessed by that thread.
+     */
+    struct ThreadCache
+    {
+        std::unordered_map<uint64_t, ChunkList> chunks;
+    };
+
+    ThreadCache &
+    thread_cache();
+    void *
+    allocate_slab(uint64_t chunk_size, bool required);
+
+    static void *
+    otf2_allocate(void *           userData,
+                  OTF2_FileType    fileType,
+                  OTF2_LocationRef location,
+                  void **          perBufferData,
+                  uint64_t         chunkSize);
+    static void
+    otf2_free_all(void *userData, OTF2_FileType fileType, OTF2_LocationRef location, void **perBufferData, bool final);
+
+    static const OTF2_MemoryCallbacks m_callbacks;
+
+    const uint64_t           m_id;
+    const bool               m_huge_pages;
+    const std::size_t        m_buffer_chunks;
+    const std::size_t        m_memory_limit;
+    const std::size_t        m_cache_chunks;
+    std::atomic<std::size_t> m_reserved{0};
+
+    std::mutex                                m_mutex;
+    std::unordered_map<uint64_t, ChunkList>   m_shared;
+    std::vector<std::unique_ptr<ThreadCache>> m_caches;
+    std::vector<void *>                       m_slabs;
+};
+
+#endif /* CHUNK_POOL_H */
@@ -0,0 +1,2370 @@
+#ifndef DRY_RUN_HANDLER_H
+#define DRY_RUN_HANDLER_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <filter.hpp>
+#include <otf2_handler.hpp>
+#include <string_table.hpp>
+#include <trace_stats.hpp>
+
+/*
+ * Applies registered filters like TraceWriter, but only counts the records
+ * they would drop instead of writing an archive.
+ *
+ * Only event types a filter has a callback for or drops as a whole are
+ * decoded, see handlesEvent(), and locations no filter affects are not
+ * read at all.
+ * Events are counted in the thread statistics of a TraceStats.
+ */
+class DryRunHandler : public Otf2Handler
+{
+  public:
+    /*
+     * Events of a location, the number is announced by its definition.
+     */
+    struct LocationEvents
+    {
+        uint64_t announced = 0;
+        uint64_t dropped   = 0;
+        uint64_t kept      = 0;
+        bool     read      = false;
+    };
+
+    /*
+     * @param stats statistics the events are counted in, has to outlive
+     *        the handler
+     * @param referenced_strings only keep the strings the filters resolve,
+     *        see TraceWriterOptions::referenced_strings
+     */
+    explicit DryRunHandler(TraceStats &stats, bool referenced_strings = false) : m_stats(stats)
+    {
+        if (referenced_strings)
+        {
+            m_strings.set_mode(StringTable::Mode::Referenced);
+        }
+    }
+
+    /*
+     * Register the callbacks of a filter, see TraceWriter::register_filter().
+     */
+    void
+    register_filter(IFilterCallbacks &filter, int priority = 0)
+    {
+        for (auto definition : filter.string_references())
+        {
+            if (definition == GlobalDefinition::String)
+            {
+                m_strings.set_mode(StringTable::Mode::All);
+            }
+            else if (std::find(m_string_references.begin(), m_string_references.end(), definition) ==
+                     m_string_references.end())
+            {
+                m_string_references.push_back(definition);
+            }
+        }
+        filter.set_string_table(m_strings);
+
+        auto window         = filter.time_window();
+        m_time_window.begin = std::max(m_time_window.begin, window.begin);
+        m_time_window.end   = std::min(m_time_window.end, window.end);
+
+        auto cbs            = filter.get_callbacks();
+        bool handles_events = false;
+
+        if (cbs.global_clock_properties_callback)
+        {
+            m_global_ClockProperties_filter.add(cbs.global_clock_properties_callback, priority);
+        }
+        if (cbs.global_paradigm_callback)
+        {
+            m_global_Paradigm_filter.add(cbs.global_paradigm_callback, priority);
+        }
+        if (cbs.global_paradigm_property_callback)
+        {
+            m_global_ParadigmProperty_filter.add(cbs.global_paradigm_property_callback, priority);
+        }
+        if (cbs.global_io_paradigm_callback)
+        {
+            m_global_IoParadigm_filter.add(cbs.global_io_paradigm_callback, priority);
+        }
+        if (cbs.global_string_callback)
+        {
+            m_global_String_filter.add(cbs.global_string_callback, priority);
+        }
+        if (cbs.global_attribute_callback)
+        {
+            m_global_Attribute_filter.add(cbs.global_attribute_callback, priority);
+        }
+        if (cbs.global_system_tree_node_callback)
+        {
+            m_global_SystemTreeNode_filter.add(cbs.global_system_tree_node_callback, priority);
+        }
+        if (cbs.global_location_group_callback)
+        {
+            m_global_LocationGroup_filter.add(cbs.global_location_group_callback, priority);
+        }
+        if (cbs.global_location_callback)
+        {
+            m_global_Location_filter.add(cbs.global_location_callback, priority);
+        }
+        if (cbs.global_region_callback)
+        {
+            m_global_Region_filter.add(cbs.global_region_callback, priority);
+        }
+        if (cbs.global_callsite_callback)
+        {
+            m_global_Callsite_filter.add(cbs.global_callsite_callback, priority);
+        }
+        if (cbs.global_callpath_callback)
+        {
+            m_global_Callpath_filter.add(cbs.global_callpath_callback, priority);
+        }
+        if (cbs.global_group_callback)
+        {
+            m_global_Group_filter.add(cbs.global_group_callback, priority);
+        }
+        if (cbs.global_metric_member_callback)
+        {
+            m_global_MetricMember_filter.add(cbs.global_metric_member_callback, priority);
+        }
+        if (cbs.global_metric_class_callback)
+        {
+            m_global_MetricClass_filter.add(cbs.global_metric_class_callback, priority);
+        }
+        if (cbs.global_metric_instance_callback)
+        {
+            m_global_MetricInstance_filter.add(cbs.global_metric_instance_callback, priority);
+        }
+        if (cbs.global_comm_callback)
+        {
+            m_global_Comm_filter.add(cbs.global_comm_callback, priority);
+        }
+        if (cbs.global_parameter_callback)
+        {
+            m_global_Parameter_filter.add(cbs.global_parameter_callback, priority);
+        }
+        if (cbs.global_rma_win_callback)
+        {
+            m_global_RmaWin_filter.add(cbs.global_rma_win_callback, priority);
+        }
+        if (cbs.global_metric_class_recorder_callback)
+        {
+            m_global_MetricClassRecorder_filter.add(cbs.global_metric_class_recorder_callback, priority);
+        }
+        if (cbs.global_system_tree_node_property_callback)
+        {
+            m_global_SystemTreeNodeProperty_filter.add(cbs.global_system_tree_node_property_callback, priority);
+        }
+        if (cbs.global_system_tree_node_domain_callback)
+        {
+            m_global_SystemTreeNodeDomain_filter.add(cbs.global_system_tree_node_domain_callback, priority);
+        }
+        if (cbs.global_location_group_property_callback)
+        {
+            m_global_LocationGroupProperty_filter.add(cbs.global_location_group_property_callback, priority);
+        }
+        if (cbs.global_location_property_callback)
+        {
+            m_global_LocationProperty_filter.add(cbs.global_location_property_callback, priority);
+        }
+        if (cbs.global_cart_dimension_callback)
+        {
+            m_global_CartDimension_filter.add(cbs.global_cart_dimension_callback, priority);
+        }
+        if (cbs.global_cart_topology_callback)
+        {
+            m_global_CartTopology_filter.add(cbs.global_cart_topology_callback, priority);
+        }
+        if (cbs.global_cart_coordinate_callback)
+        {
+            m_global_CartCoordinate_filter.add(cbs.global_cart_coordinate_callback, priority);
+        }
+        if (cbs.global_source_code_location_callback)
+        {
+            m_global_SourceCodeLocation_filter.add(cbs.global_source_code_location_callback, priority);
+        }
+        if (cbs.global_calling_context_callback)
+        {
+            m_global_CallingContext_filter.add(cbs.global_calling_context_callback, priority);
+        }
+        if (cbs.global_calling_context_property_callback)
+        {
+            m_global_CallingContextProperty_filter.add(cbs.global_calling_context_property_callback, priority);
+        }
+        if (cbs.global_interrupt_generator_callback)
+        {
+            m_global_InterruptGenerator_filter.add(cbs.global_interrupt_generator_callback, priority);
+        }
+        if (cbs.global_io_file_property_callback)
+        {
+            m_global_IoFileProperty_filter.add(cbs.global_io_file_property_callback, priority);
+        }
+        if (cbs.global_io_regular_file_callback)
+        {
+            m_global_IoRegularFile_filter.add(cbs.global_io_regular_file_callback, priority);
+        }
+        if (cbs.global_io_directory_callback)
+        {
+            m_global_IoDirectory_filter.add(cbs.global_io_directory_callback, priority);
+        }
+        if (cbs.global_io_handle_callback)
+        {
+            m_global_IoHandle_filter.add(cbs.global_io_handle_callback, priority);
+        }
+        if (cbs.global_io_pre_created_handle_state_callback)
+        {
+            m_global_IoPreCreatedHandleState_filter.add(cbs.global_io_pre_created_handle_state_callback, priority);
+        }
+        if (cbs.global_callpath_parameter_callback)
+        {
+            m_global_CallpathParameter_filter.add(cbs.global_callpath_parameter_callback, priority);
+        }
+
+        if (cbs.event_buffer_flush_callback)
+        {
+            m_event_BufferFlush_filter.add(cbs.event_buffer_flush_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::BufferFlush)] = true;
+            handles_events                                                     = true;
+        }
+        if (cbs.event_measurement_on_off_callback)
+        {
+            m_event_MeasurementOnOff_filter.add(cbs.event_measurement_on_off_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MeasurementOnOff)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_enter_callback)
+        {
+            m_event_Enter_filter.add(cbs.event_enter_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::Enter)] = true;
+            handles_events                                               = true;
+        }
+        if (cbs.event_leave_callback)
+        {
+            m_event_Leave_filter.add(cbs.event_leave_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::Leave)] = true;
+            handles_events                                               = true;
+        }
+        if (cbs.event_mpi_send_callback)
+        {
+            m_event_MpiSend_filter.add(cbs.event_mpi_send_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiSend)] = true;
+            handles_events                                                 = true;
+        }
+        if (cbs.event_mpi_isend_callback)
+        {
+            m_event_MpiIsend_filter.add(cbs.event_mpi_isend_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiIsend)] = true;
+            handles_events                                                  = true;
+        }
+        if (cbs.event_mpi_isend_complete_callback)
+        {
+            m_event_MpiIsendComplete_filter.add(cbs.event_mpi_isend_complete_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiIsendComplete)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_mpi_irecv_request_callback)
+        {
+            m_event_MpiIrecvRequest_filter.add(cbs.event_mpi_irecv_request_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiIrecvRequest)] = true;
+            handles_events                                                         = true;
+        }
+        if (cbs.event_mpi_recv_callback)
+        {
+            m_event_MpiRecv_filter.add(cbs.event_mpi_recv_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiRecv)] = true;
+            handles_events                                                 = true;
+        }
+        if (cbs.event_mpi_irecv_callback)
+        {
+            m_event_MpiIrecv_filter.add(cbs.event_mpi_irecv_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiIrecv)] = true;
+            handles_events                                                  = true;
+        }
+        if (cbs.event_mpi_request_test_callback)
+        {
+            m_event_MpiRequestTest_filter.add(cbs.event_mpi_request_test_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiRequestTest)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_mpi_request_cancelled_callback)
+        {
+            m_event_MpiRequestCancelled_filter.add(cbs.event_mpi_request_cancelled_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiRequestCancelled)] = true;
+            handles_events                                                             = true;
+        }
+        if (cbs.event_mpi_collective_begin_callback)
+        {
+            m_event_MpiCollectiveBegin_filter.add(cbs.event_mpi_collective_begin_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiCollectiveBegin)] = true;
+            handles_events                                                            = true;
+        }
+        if (cbs.event_mpi_collective_end_callback)
+        {
+            m_event_MpiCollectiveEnd_filter.add(cbs.event_mpi_collective_end_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::MpiCollectiveEnd)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_omp_fork_callback)
+        {
+            m_event_OmpFork_filter.add(cbs.event_omp_fork_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpFork)] = true;
+            handles_events                                                 = true;
+        }
+        if (cbs.event_omp_join_callback)
+        {
+            m_event_OmpJoin_filter.add(cbs.event_omp_join_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpJoin)] = true;
+            handles_events                                                 = true;
+        }
+        if (cbs.event_omp_acquire_lock_callback)
+        {
+            m_event_OmpAcquireLock_filter.add(cbs.event_omp_acquire_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpAcquireLock)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_omp_release_lock_callback)
+        {
+            m_event_OmpReleaseLock_filter.add(cbs.event_omp_release_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpReleaseLock)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_omp_task_create_callback)
+        {
+            m_event_OmpTaskCreate_filter.add(cbs.event_omp_task_create_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpTaskCreate)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_omp_task_switch_callback)
+        {
+            m_event_OmpTaskSwitch_filter.add(cbs.event_omp_task_switch_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpTaskSwitch)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_omp_task_complete_callback)
+        {
+            m_event_OmpTaskComplete_filter.add(cbs.event_omp_task_complete_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::OmpTaskComplete)] = true;
+            handles_events                                                         = true;
+        }
+        if (cbs.event_metric_callback)
+        {
+            m_event_Metric_filter.add(cbs.event_metric_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::Metric)] = true;
+            handles_events                                                = true;
+        }
+        if (cbs.event_parameter_string_callback)
+        {
+            m_event_ParameterString_filter.add(cbs.event_parameter_string_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ParameterString)] = true;
+            handles_events                                                         = true;
+        }
+        if (cbs.event_parameter_int_callback)
+        {
+            m_event_ParameterInt_filter.add(cbs.event_parameter_int_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ParameterInt)] = true;
+            handles_events                                                      = true;
+        }
+        if (cbs.event_parameter_unsigned_int_callback)
+        {
+            m_event_ParameterUnsignedInt_filter.add(cbs.event_parameter_unsigned_int_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ParameterUnsignedInt)] = true;
+            handles_events                                                              = true;
+        }
+        if (cbs.event_rma_win_create_callback)
+        {
+            m_event_RmaWinCreate_filter.add(cbs.event_rma_win_create_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaWinCreate)] = true;
+            handles_events                                                      = true;
+        }
+        if (cbs.event_rma_win_destroy_callback)
+        {
+            m_event_RmaWinDestroy_filter.add(cbs.event_rma_win_destroy_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaWinDestroy)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_rma_collective_begin_callback)
+        {
+            m_event_RmaCollectiveBegin_filter.add(cbs.event_rma_collective_begin_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaCollectiveBegin)] = true;
+            handles_events                                                            = true;
+        }
+        if (cbs.event_rma_collective_end_callback)
+        {
+            m_event_RmaCollectiveEnd_filter.add(cbs.event_rma_collective_end_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaCollectiveEnd)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_rma_group_sync_callback)
+        {
+            m_event_RmaGroupSync_filter.add(cbs.event_rma_group_sync_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaGroupSync)] = true;
+            handles_events                                                      = true;
+        }
+        if (cbs.event_rma_request_lock_callback)
+        {
+            m_event_RmaRequestLock_filter.add(cbs.event_rma_request_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaRequestLock)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_rma_acquire_lock_callback)
+        {
+            m_event_RmaAcquireLock_filter.add(cbs.event_rma_acquire_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaAcquireLock)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_rma_try_lock_callback)
+        {
+            m_event_RmaTryLock_filter.add(cbs.event_rma_try_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaTryLock)] = true;
+            handles_events                                                    = true;
+        }
+        if (cbs.event_rma_release_lock_callback)
+        {
+            m_event_RmaReleaseLock_filter.add(cbs.event_rma_release_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaReleaseLock)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_rma_sync_callback)
+        {
+            m_event_RmaSync_filter.add(cbs.event_rma_sync_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaSync)] = true;
+            handles_events                                                 = true;
+        }
+        if (cbs.event_rma_wait_change_callback)
+        {
+            m_event_RmaWaitChange_filter.add(cbs.event_rma_wait_change_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaWaitChange)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_rma_put_callback)
+        {
+            m_event_RmaPut_filter.add(cbs.event_rma_put_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaPut)] = true;
+            handles_events                                                = true;
+        }
+        if (cbs.event_rma_get_callback)
+        {
+            m_event_RmaGet_filter.add(cbs.event_rma_get_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaGet)] = true;
+            handles_events                                                = true;
+        }
+        if (cbs.event_rma_atomic_callback)
+        {
+            m_event_RmaAtomic_filter.add(cbs.event_rma_atomic_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaAtomic)] = true;
+            handles_events                                                   = true;
+        }
+        if (cbs.event_rma_op_complete_blocking_callback)
+        {
+            m_event_RmaOpCompleteBlocking_filter.add(cbs.event_rma_op_complete_blocking_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaOpCompleteBlocking)] = true;
+            handles_events                                                               = true;
+        }
+        if (cbs.event_rma_op_complete_non_blocking_callback)
+        {
+            m_event_RmaOpCompleteNonBlocking_filter.add(cbs.event_rma_op_complete_non_blocking_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaOpCompleteNonBlocking)] = true;
+            handles_events                                                                  = true;
+        }
+        if (cbs.event_rma_op_test_callback)
+        {
+            m_event_RmaOpTest_filter.add(cbs.event_rma_op_test_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaOpTest)] = true;
+            handles_events                                                   = true;
+        }
+        if (cbs.event_rma_op_complete_remote_callback)
+        {
+            m_event_RmaOpCompleteRemote_filter.add(cbs.event_rma_op_complete_remote_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::RmaOpCompleteRemote)] = true;
+            handles_events                                                             = true;
+        }
+        if (cbs.event_thread_fork_callback)
+        {
+            m_event_ThreadFork_filter.add(cbs.event_thread_fork_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadFork)] = true;
+            handles_events                                                    = true;
+        }
+        if (cbs.event_thread_join_callback)
+        {
+            m_event_ThreadJoin_filter.add(cbs.event_thread_join_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadJoin)] = true;
+            handles_events                                                    = true;
+        }
+        if (cbs.event_thread_team_begin_callback)
+        {
+            m_event_ThreadTeamBegin_filter.add(cbs.event_thread_team_begin_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadTeamBegin)] = true;
+            handles_events                                                         = true;
+        }
+        if (cbs.event_thread_team_end_callback)
+        {
+            m_event_ThreadTeamEnd_filter.add(cbs.event_thread_team_end_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadTeamEnd)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_thread_acquire_lock_callback)
+        {
+            m_event_ThreadAcquireLock_filter.add(cbs.event_thread_acquire_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadAcquireLock)] = true;
+            handles_events                                                           = true;
+        }
+        if (cbs.event_thread_release_lock_callback)
+        {
+            m_event_ThreadReleaseLock_filter.add(cbs.event_thread_release_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadReleaseLock)] = true;
+            handles_events                                                           = true;
+        }
+        if (cbs.event_thread_task_create_callback)
+        {
+            m_event_ThreadTaskCreate_filter.add(cbs.event_thread_task_create_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadTaskCreate)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_thread_task_switch_callback)
+        {
+            m_event_ThreadTaskSwitch_filter.add(cbs.event_thread_task_switch_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadTaskSwitch)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_thread_task_complete_callback)
+        {
+            m_event_ThreadTaskComplete_filter.add(cbs.event_thread_task_complete_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadTaskComplete)] = true;
+            handles_events                                                            = true;
+        }
+        if (cbs.event_thread_create_callback)
+        {
+            m_event_ThreadCreate_filter.add(cbs.event_thread_create_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadCreate)] = true;
+            handles_events                                                      = true;
+        }
+        if (cbs.event_thread_begin_callback)
+        {
+            m_event_ThreadBegin_filter.add(cbs.event_thread_begin_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadBegin)] = true;
+            handles_events                                                     = true;
+        }
+        if (cbs.event_thread_wait_callback)
+        {
+            m_event_ThreadWait_filter.add(cbs.event_thread_wait_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadWait)] = true;
+            handles_events                                                    = true;
+        }
+        if (cbs.event_thread_end_callback)
+        {
+            m_event_ThreadEnd_filter.add(cbs.event_thread_end_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ThreadEnd)] = true;
+            handles_events                                                   = true;
+        }
+        if (cbs.event_calling_context_enter_callback)
+        {
+            m_event_CallingContextEnter_filter.add(cbs.event_calling_context_enter_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::CallingContextEnter)] = true;
+            handles_events                                                             = true;
+        }
+        if (cbs.event_calling_context_leave_callback)
+        {
+            m_event_CallingContextLeave_filter.add(cbs.event_calling_context_leave_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::CallingContextLeave)] = true;
+            handles_events                                                             = true;
+        }
+        if (cbs.event_calling_context_sample_callback)
+        {
+            m_event_CallingContextSample_filter.add(cbs.event_calling_context_sample_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::CallingContextSample)] = true;
+            handles_events                                                              = true;
+        }
+        if (cbs.event_io_create_handle_callback)
+        {
+            m_event_IoCreateHandle_filter.add(cbs.event_io_create_handle_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoCreateHandle)] = true;
+            handles_events                                                        = true;
+        }
+        if (cbs.event_io_destroy_handle_callback)
+        {
+            m_event_IoDestroyHandle_filter.add(cbs.event_io_destroy_handle_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoDestroyHandle)] = true;
+            handles_events                                                         = true;
+        }
+        if (cbs.event_io_duplicate_handle_callback)
+        {
+            m_event_IoDuplicateHandle_filter.add(cbs.event_io_duplicate_handle_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoDuplicateHandle)] = true;
+            handles_events                                                           = true;
+        }
+        if (cbs.event_io_seek_callback)
+        {
+            m_event_IoSeek_filter.add(cbs.event_io_seek_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoSeek)] = true;
+            handles_events                                                = true;
+        }
+        if (cbs.event_io_change_status_flags_callback)
+        {
+            m_event_IoChangeStatusFlags_filter.add(cbs.event_io_change_status_flags_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoChangeStatusFlags)] = true;
+            handles_events                                                             = true;
+        }
+        if (cbs.event_io_delete_file_callback)
+        {
+            m_event_IoDeleteFile_filter.add(cbs.event_io_delete_file_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoDeleteFile)] = true;
+            handles_events                                                      = true;
+        }
+        if (cbs.event_io_operation_begin_callback)
+        {
+            m_event_IoOperationBegin_filter.add(cbs.event_io_operation_begin_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoOperationBegin)] = true;
+            handles_events                                                          = true;
+        }
+        if (cbs.event_io_operation_test_callback)
+        {
+            m_event_IoOperationTest_filter.add(cbs.event_io_operation_test_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoOperationTest)] = true;
+            handles_events                                                         = true;
+        }
+        if (cbs.event_io_operation_issued_callback)
+        {
+            m_event_IoOperationIssued_filter.add(cbs.event_io_operation_issued_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoOperationIssued)] = true;
+            handles_events                                                           = true;
+        }
+        if (cbs.event_io_operation_complete_callback)
+        {
+            m_event_IoOperationComplete_filter.add(cbs.event_io_operation_complete_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoOperationComplete)] = true;
+            handles_events                                                             = true;
+        }
+        if (cbs.event_io_operation_cancelled_callback)
+        {
+            m_event_IoOperationCancelled_filter.add(cbs.event_io_operation_cancelled_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoOperationCancelled)] = true;
+            handles_events                                                              = true;
+        }
+        if (cbs.event_io_acquire_lock_callback)
+        {
+            m_event_IoAcquireLock_filter.add(cbs.event_io_acquire_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoAcquireLock)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_io_release_lock_callback)
+        {
+            m_event_IoReleaseLock_filter.add(cbs.event_io_release_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoReleaseLock)] = true;
+            handles_events                                                       = true;
+        }
+        if (cbs.event_io_try_lock_callback)
+        {
+            m_event_IoTryLock_filter.add(cbs.event_io_try_lock_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::IoTryLock)] = true;
+            handles_events                                                   = true;
+        }
+        if (cbs.event_program_begin_callback)
+        {
+            m_event_ProgramBegin_filter.add(cbs.event_program_begin_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ProgramBegin)] = true;
+            handles_events                                                      = true;
+        }
+        if (cbs.event_program_end_callback)
+        {
+            m_event_ProgramEnd_filter.add(cbs.event_program_end_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::ProgramEnd)] = true;
+            handles_events                                                    = true;
+        }
+
+        /*
+         * The writer would not decode events of dropped types, they are
+         * still read here to count them.
+         */
+        for (auto type : filter.dropped_event_types())
+        {
+            m_handled_events[static_cast<std::size_t>(type)] = true;
+            m_dropped_events[static_cast<std::size_t>(type)] = true;
+            handles_events                                   = true;
+        }
+
+        if (handles_events)
+        {
+            m_location_filters.push_back(&filter);
+        }
+    }
+
+    /*
+     * Global definitions handled and dropped, indexed by GlobalDefinition.
+     */
+    inline const std::array<uint64_t, number_of_global_definitions> &
+    definitions() const
+    {
+        return m_definitions;
+    }
+
+    inline const std::array<uint64_t, number_of_global_definitions> &
+    dropped_definitions() const
+    {
+        return m_dropped_definitions;
+    }
+
+    inline const std::unordered_map<OTF2_LocationRef, LocationEvents> &
+    locations() const
+    {
+        return m_locations;
+    }
+
+    virtual std::vector<GlobalDefinition>
+    stringReferencingDefinitions() override
+    {
+        if (m_strings.mode() == StringTable::Mode::All)
+        {
+            return {};
+        }
+        return m_string_references;
+    }
+
+    virtual void
+    handleStringReference(GlobalDefinition definition, OTF2_StringRef string) override
+    {
+        m_strings.reference(string);
+    }
+
+    /*
+     * Begin and end of the time window of the registered filters, the
+     * locations are read like by a TraceWriter.
+     */
+    virtual OTF2_TimeStamp
+    eventsBegin() override
+    {
+        return m_time_window.begin;
+    }
+
+    virtual OTF2_TimeStamp
+    eventsEnd() override
+    {
+        return m_time_window.end;
+    }
+
+    virtual bool
+    handlesEvent(EventType type) override
+    {
+        return m_handled_events[static_cast<std::size_t>(type)];
+    }
+
+    /*
+     * Locations no filter affects need not be read, nothing is copied.
+     */
+    virtual bool
+    copyLocation(const ArchiveLayout &input, OTF2_LocationRef location) override
+    {
+        return std::none_of(m_location_filters.begin(), m_location_filters.end(), [location](IFilterCallbacks *filter) {
+            return filter->affects_location(location);
+        });
+    }
+
+    /*
+     * Locations whose definition a filter dropped are not read.
+     */
+    virtual bool
+    selectsLocation(OTF2_LocationRef location) override
+    {
+        return m_locations.count(location) > 0;
+    }
+
+    virtual void
+    beginLocation(OTF2_LocationRef location) override
+    {
+        auto            search = m_locations.find(location);
+        LocationEvents *events = search != m_locations.end() ? &search->second : nullptr;
+        if (events != nullptr)
+        {
+            events->read = true;
+        }
+        m_thread_location = {.owner = this, .events = events, .counters = &m_stats.thread_stats().events};
+    }
+
+    virtual void
+    endLocation(OTF2_LocationRef location) override
+    {
+        /*
+         * With a time window every event type is decoded, the events not
+         * read lie outside of the window and are dropped.
+         */
+        auto *events = m_thread_location.events;
+        if (events != nullptr && (m_time_window.begin != 0 || m_time_window.end != OTF2_UNDEFINED_TIMESTAMP))
+        {
+            events->dropped = std::max(events->dropped, events->announced - std::min(events->announced, events->kept));
+        }
+        m_thread_location = {.owner = nullptr, .events = nullptr, .counters = nullptr};
+    }
+
+    /*
+     * Handle global definitions
+     */
+
+    virtual void
+    handleGlobalClockProperties(uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength) override
+    {
+        bool dropped = !m_global_ClockProperties_filter.empty() &&
+                       m_global_ClockProperties_filter.process(timerResolution, globalOffset, traceLength);
+        count_definition(GlobalDefinition::ClockProperties, dropped);
+    }
+
+    virtual void
+    handleGlobalParadigm(OTF2_Paradigm paradigm, OTF2_StringRef name, OTF2_ParadigmClass paradigmClass) override
+    {
+        bool dropped = !m_global_Paradigm_filter.empty() &&
+                       m_global_Paradigm_filter.process(paradigm, name, paradigmClass);
+        count_definition(GlobalDefinition::Paradigm, dropped);
+    }
+
+    virtual void
+    handleGlobalParadigmProperty(OTF2_Paradigm         paradigm,
+                                 OTF2_ParadigmProperty property,
+                                 OTF2_Type             type,
+                                 OTF2_AttributeValue   value) override
+    {
+        bool dropped = !m_global_ParadigmProperty_filter.empty() &&
+                       m_global_ParadigmProperty_filter.process(paradigm, property, type, value);
+        count_definition(GlobalDefinition::ParadigmProperty, dropped);
+    }
+
+    virtual void
+    handleGlobalIoParadigm(OTF2_IoParadigmRef             self,
+                           OTF2_StringRef                 identification,
+                           OTF2_StringRef                 name,
+                           OTF2_IoParadigmClass           ioParadigmClass,
+                           OTF2_IoParadigmFlag            ioParadigmFlags,
+                           uint8_t                        numberOfProperties,
+                           const OTF2_IoParadigmProperty *properties,
+                           const OTF2_Type *              types,
+                           const OTF2_AttributeValue *    values) override
+    {
+        bool dropped = !m_global_IoParadigm_filter.empty() &&
+                       m_global_IoParadigm_filter.process(self,
+                                                          identification,
+                                                          name,
+                                                          ioParadigmClass,
+                                                          ioParadigmFlags,
+                                                          numberOfProperties,
+                                                          properties,
+                                                          types,
+                                                          values);
+        count_definition(GlobalDefinition::IoParadigm, dropped);
+    }
+
+    virtual void
+    handleGlobalString(OTF2_StringRef self, const char *string) override
+    {
+        m_strings.add(self, string);
+        bool dropped = !m_global_String_filter.empty() && m_global_String_filter.process(self, string);
+        count_definition(GlobalDefinition::String, dropped);
+    }
+
+    virtual void
+    handleGlobalAttribute(OTF2_AttributeRef self,
+                          OTF2_StringRef    name,
+                          OTF2_StringRef    description,
+                          OTF2_Type         type) override
+    {
+        bool dropped = !m_global_Attribute_filter.empty() &&
+                       m_global_Attribute_filter.process(self, name, description, type);
+        count_definition(GlobalDefinition::Attribute, dropped);
+    }
+
+    virtual void
+    handleGlobalSystemTreeNode(OTF2_SystemTreeNodeRef self,
+                               OTF2_StringRef         name,
+                               OTF2_StringRef         className,
+                               OTF2_SystemTreeNodeRef parent) override
+    {
+        bool dropped = !m_global_SystemTreeNode_filter.empty() &&
+                       m_global_SystemTreeNode_filter.process(self, name, className, parent);
+        count_definition(GlobalDefinition::SystemTreeNode, dropped);
+    }
+
+    virtual void
+    handleGlobalLocationGroup(OTF2_LocationGroupRef  self,
+                              OTF2_StringRef         name,
+                              OTF2_LocationGroupType locationGroupType,
+                              OTF2_SystemTreeNodeRef systemTreeParent) override
+    {
+        bool dropped = !m_global_LocationGroup_filter.empty() &&
+                       m_global_LocationGroup_filter.process(self, name, locationGroupType, systemTreeParent);
+        count_definition(GlobalDefinition::LocationGroup, dropped);
+    }
+
+    virtual void
+    handleGlobalLocation(OTF2_LocationRef      self,
+                         OTF2_StringRef        name,
+                         OTF2_LocationType     locationType,
+                         uint64_t              numberOfEvents,
+                         OTF2_LocationGroupRef locationGroup) override
+    {
+        m_locations[self].announced = numberOfEvents;
+        bool dropped = !m_global_Location_filter.empty() &&
+                       m_global_Location_filter.process(self, name, locationType, numberOfEvents, locationGroup);
+        count_definition(GlobalDefinition::Location, dropped);
+        if (dropped)
+        {
+            m_locations.erase(self);
+        }
+    }
+
+    virtual void
+    handleGlobalRegion(OTF2_RegionRef  self,
+                       OTF2_StringRef  name,
+                       OTF2_StringRef  canonicalName,
+                       OTF2_StringRef  description,
+                       OTF2_RegionRole regionRole,
+                       OTF2_Paradigm   paradigm,
+                       OTF2_RegionFlag regionFlags,
+                       OTF2_StringRef  sourceFile,
+                       uint32_t        beginLineNumber,
+                       uint32_t        endLineNumber) override
+    {
+        bool dropped = !m_global_Region_filter.empty() &&
+                       m_global_Region_filter.process(self,
+                                                      name,
+                                                      canonicalName,
+                                                      description,
+                                                      regionRole,
+                                                      paradigm,
+                                                      regionFlags,
+                                                      sourceFile,
+                                                      beginLineNumber,
+                                                      endLineNumber);
+        count_definition(GlobalDefinition::Region, dropped);
+    }
+
+    virtual void
+    handleGlobalCallsite(OTF2_CallsiteRef self,
+                         OTF2_StringRef   sourceFile,
+                         uint32_t         lineNumber,
+                         OTF2_RegionRef   enteredRegion,
+                         OTF2_RegionRef   leftRegion) override
+    {
+        bool dropped = !m_global_Callsite_filter.empty() &&
+                       m_global_Callsite_filter.process(self, sourceFile, lineNumber, enteredRegion, leftRegion);
+        count_definition(GlobalDefinition::Callsite, dropped);
+    }
+
+    virtual void
+    handleGlobalCallpath(OTF2_CallpathRef self, OTF2_CallpathRef parent, OTF2_RegionRef region) override
+    {
+        bool dropped = !m_global_Callpath_filter.empty() && m_global_Callpath_filter.process(self, parent, region);
+        count_definition(GlobalDefinition::Callpath, dropped);
+    }
+
+    virtual void
+    handleGlobalGroup(OTF2_GroupRef   self,
+                      OTF2_StringRef  name,
+                      OTF2_GroupType  groupType,
+                      OTF2_Paradigm   paradigm,
+                      OTF2_GroupFlag  groupFlags,
+                      uint32_t        numberOfMembers,
+                      const uint64_t *members) override
+    {
+        bool dropped = !m_global_Group_filter.empty() &&
+                       m_global_Group_filter.process(
+                           self, name, groupType, paradigm, groupFlags, numberOfMembers, members);
+        count_definition(GlobalDefinition::Group, dropped);
+    }
+
+    virtual void
+    handleGlobalMetricMember(OTF2_MetricMemberRef self,
+                             OTF2_StringRef       name,
+                             OTF2_StringRef       description,
+                             OTF2_MetricType      metricType,
+                             OTF2_MetricMode      metricMode,
+                             OTF2_Type            valueType,
+                             OTF2_Base            base,
+                             int64_t              exponent,
+                             OTF2_StringRef       unit) override
+    {
+        bool dropped = !m_global_MetricMember_filter.empty() &&
+                       m_global_MetricMember_filter.process(
+                           self, name, description, metricType, metricMode, valueType, base, exponent, unit);
+        count_definition(GlobalDefinition::MetricMember, dropped);
+    }
+
+    virtual void
+    handleGlobalMetricClass(OTF2_MetricRef              self,
+                            uint8_t                     numberOfMetrics,
+                            const OTF2_MetricMemberRef *metricMembers,
+                            OTF2_MetricOccurrence       metricOccurrence,
+                            OTF2_RecorderKind           recorderKind) override
+    {
+        bool dropped = !m_global_MetricClass_filter.empty() &&
+                       m_global_MetricClass_filter.process(
+                           self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind);
+        count_definition(GlobalDefinition::MetricClass, dropped);
+    }
+
+    virtual void
+    handleGlobalMetricInstance(OTF2_MetricRef   self,
+                               OTF2_MetricRef   metricClass,
+                               OTF2_LocationRef recorder,
+                               OTF2_MetricScope metricScope,
+                               uint64_t         scope) override
+    {
+        bool dropped = !m_global_MetricInstance_filter.empty() &&
+                       m_global_MetricInstance_filter.process(self, metricClass, recorder, metricScope, scope);
+        count_definition(GlobalDefinition::MetricInstance, dropped);
+    }
+
+    virtual void
+    handleGlobalComm(OTF2_CommRef self, OTF2_StringRef name, OTF2_GroupRef group, OTF2_CommRef parent) override
+    {
+        bool dropped = !m_global_Comm_filter.empty() && m_global_Comm_filter.process(self, name, group, parent);
+        count_definition(GlobalDefinition::Comm, dropped);
+    }
+
+    virtual void
+    handleGlobalParameter(OTF2_ParameterRef self, OTF2_StringRef name, OTF2_ParameterType parameterType) override
+    {
+        bool dropped = !m_global_Parameter_filter.empty() &&
+                       m_global_Parameter_filter.process(self, name, parameterType);
+        count_definition(GlobalDefinition::Parameter, dropped);
+    }
+
+    virtual void
+    handleGlobalRmaWin(OTF2_RmaWinRef self, OTF2_StringRef name, OTF2_CommRef comm) override
+    {
+        bool dropped = !m_global_RmaWin_filter.empty() && m_global_RmaWin_filter.process(self, name, comm);
+        count_definition(GlobalDefinition::RmaWin, dropped);
+    }
+
+    virtual void
+    handleGlobalMetricClassRecorder(OTF2_MetricRef metric, OTF2_LocationRef recorder) override
+    {
+        bool dropped = !m_global_MetricClassRecorder_filter.empty() &&
+                       m_global_MetricClassRecorder_filter.process(metric, recorder);
+        count_definition(GlobalDefinition::MetricClassRecorder, dropped);
+    }
+
+    virtual void
+    handleGlobalSystemTreeNodeProperty(OTF2_SystemTreeNodeRef systemTreeNode,
+                                       OTF2_StringRef         name,
+                                       OTF2_Type              type,
+                                       OTF2_AttributeValue    value) override
+    {
+        bool dropped = !m_global_SystemTreeNodeProperty_filter.empty() &&
+                       m_global_SystemTreeNodeProperty_filter.process(systemTreeNode, name, type, value);
+        count_definition(GlobalDefinition::SystemTreeNodeProperty, dropped);
+    }
+
+    virtual void
+    handleGlobalSystemTreeNodeDomain(OTF2_SystemTreeNodeRef systemTreeNode,
+                                     OTF2_SystemTreeDomain  systemTreeDomain) override
+    {
+        bool dropped = !m_global_SystemTreeNodeDomain_filter.empty() &&
+                       m_global_SystemTreeNodeDomain_filter.process(systemTreeNode, systemTreeDomain);
+        count_definition(GlobalDefinition::SystemTreeNodeDomain, dropped);
+    }
+
+    virtual void
+    handleGlobalLocationGroupProperty(OTF2_LocationGroupRef locationGroup,
+                                      OTF2_StringRef        name,
+                                      OTF2_Type             type,
+                                      OTF2_AttributeValue   value) override
+    {
+        bool dropped = !m_global_LocationGroupProperty_filter.empty() &&
+                       m_global_LocationGroupProperty_filter.process(locationGroup, name, type, value);
+        count_definition(GlobalDefinition::LocationGroupProperty, dropped);
+    }
+
+    virtual void
+    handleGlobalLocationProperty(OTF2_LocationRef    location,
+                                 OTF2_StringRef      name,
+                                 OTF2_Type           type,
+                                 OTF2_AttributeValue value) override
+    {
+        bool dropped = !m_global_LocationProperty_filter.empty() &&
+                       m_global_LocationProperty_filter.process(location, name, type, value);
+        count_definition(GlobalDefinition::LocationProperty, dropped);
+    }
+
+    virtual void
+    handleGlobalCartDimension(OTF2_CartDimensionRef self,
+                              OTF2_StringRef        name,
+                              uint32_t              size,
+                              OTF2_CartPeriodicity  cartPeriodicity) override
+    {
+        bool dropped = !m_global_CartDimension_filter.empty() &&
+                       m_global_CartDimension_filter.process(self, name, size, cartPeriodicity);
+        count_definition(GlobalDefinition::CartDimension, dropped);
+    }
+
+    virtual void
+    handleGlobalCartTopology(OTF2_CartTopologyRef         self,
+                             OTF2_StringRef               name,
+                             OTF2_CommRef                 communicator,
+                             uint8_t                      numberOfDimensions,
+                             const OTF2_CartDimensionRef *cartDimensions) override
+    {
+        bool dropped = !m_global_CartTopology_filter.empty() &&
+                       m_global_CartTopology_filter.process(
+                           self, name, communicator, numberOfDimensions, cartDimensions);
+        count_definition(GlobalDefinition::CartTopology, dropped);
+    }
+
+    virtual void
+    handleGlobalCartCoordinate(OTF2_CartTopologyRef cartTopology,
+                               uint32_t             rank,
+                               uint8_t              numberOfDimensions,
+                               const uint32_t *     coordinates) override
+    {
+        bool dropped = !m_global_CartCoordinate_filter.empty() &&
+                       m_global_CartCoordinate_filter.process(cartTopology, rank, numberOfDimensions, coordinates);
+        count_definition(GlobalDefinition::CartCoordinate, dropped);
+    }
+
+    virtual void
+    handleGlobalSourceCodeLocation(OTF2_SourceCodeLocationRef self, OTF2_StringRef file, uint32_t lineNumber) override
+    {
+        bool dropped = !m_global_SourceCodeLocation_filter.empty() &&
+                       m_global_SourceCodeLocation_filter.process(self, file, lineNumber);
+        count_definition(GlobalDefinition::SourceCodeLocation, dropped);
+    }
+
+    virtual void
+    handleGlobalCallingContext(OTF2_CallingContextRef     self,
+                               OTF2_RegionRef             region,
+                               OTF2_SourceCodeLocationRef sourceCodeLocation,
+                               OTF2_CallingContextRef     parent) override
+    {
+        bool dropped = !m_global_CallingContext_filter.empty() &&
+                       m_global_CallingContext_filter.process(self, region, sourceCodeLocation, parent);
+        count_definition(GlobalDefinition::CallingContext, dropped);
+    }
+
+    virtual void
+    handleGlobalCallingContextProperty(OTF2_CallingContextRef callingContext,
+                                       OTF2_StringRef         name,
+                                       OTF2_Type              type,
+                                       OTF2_AttributeValue    value) override
+    {
+        bool dropped = !m_global_CallingContextProperty_filter.empty() &&
+                       m_global_CallingContextProperty_filter.process(callingContext, name, type, value);
+        count_definition(GlobalDefinition::CallingContextProperty, dropped);
+    }
+
+    virtual void
+    handleGlobalInterruptGenerator(OTF2_InterruptGeneratorRef  self,
+                                   OTF2_StringRef              name,
+                                   OTF2_InterruptGeneratorMode interruptGeneratorMode,
+                                   OTF2_Base                   base,
+                                   int64_t                     exponent,
+                                   uint64_t                    period) override
+    {
+        bool dropped = !m_global_InterruptGenerator_filter.empty() &&
+                       m_global_InterruptGenerator_filter.process(
+                           self, name, interruptGeneratorMode, base, exponent, period);
+        count_definition(GlobalDefinition::InterruptGenerator, dropped);
+    }
+
+    virtual void
+    handleGlobalIoFileProperty(OTF2_IoFileRef      ioFile,
+                               OTF2_StringRef      name,
+                               OTF2_Type           type,
+                               OTF2_AttributeValue value) override
+    {
+        bool dropped = !m_global_IoFileProperty_filter.empty() &&
+                       m_global_IoFileProperty_filter.process(ioFile, name, type, value);
+        count_definition(GlobalDefinition::IoFileProperty, dropped);
+    }
+
+    virtual void
+    handleGlobalIoRegularFile(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope) override
+    {
+        bool dropped = !m_global_IoRegularFile_filter.empty() &&
+                       m_global_IoRegularFile_filter.process(self, name, scope);
+        count_definition(GlobalDefinition::IoRegularFile, dropped);
+    }
+
+    virtual void
+    handleGlobalIoDirectory(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope) override
+    {
+        bool dropped = !m_global_IoDirectory_filter.empty() && m_global_IoDirectory_filter.process(self, name, scope);
+        count_definition(GlobalDefinition::IoDirectory, dropped);
+    }
+
+    virtual void
+    handleGlobalIoHandle(OTF2_IoHandleRef   self,
+                         OTF2_StringRef     name,
+                         OTF2_IoFileRef     file,
+                         OTF2_IoParadigmRef ioParadigm,
+                         OTF2_IoHandleFlag  ioHandleFlags,
+                         OTF2_CommRef       comm,
+                         OTF2_IoHandleRef   parent) override
+    {
+        bool dropped = !m_global_IoHandle_filter.empty() &&
+                       m_global_IoHandle_filter.process(self, name, file, ioParadigm, ioHandleFlags, comm, parent);
+        count_definition(GlobalDefinition::IoHandle, dropped);
+    }
+
+    virtual void
+    handleGlobalIoPreCreatedHandleState(OTF2_IoHandleRef  ioHandle,
+                                        OTF2_IoAccessMode mode,
+                                        OTF2_IoStatusFlag statusFlags) override
+    {
+        bool dropped = !m_global_IoPreCreatedHandleState_filter.empty() &&
+                       m_global_IoPreCreatedHandleState_filter.process(ioHandle, mode, statusFlags);
+        count_definition(GlobalDefinition::IoPreCreatedHandleState, dropped);
+    }
+
+    virtual void
+    handleGlobalCallpathParameter(OTF2_CallpathRef    callpath,
+                                  OTF2_ParameterRef   parameter,
+                                  OTF2_Type           type,
+                                  OTF2_AttributeValue value) override
+    {
+        bool dropped = !m_global_CallpathParameter_filter.empty() &&
+                       m_global_CallpathParameter_filter.process(callpath, parameter, type, value);
+        count_definition(GlobalDefinition::CallpathParameter, dropped);
+    }
+
+    /*
+     * Local definitions are not filtered.
+     */
+
+    virtual void
+    handleLocalMappingTable(OTF2_LocationRef  readLocation,
+                            OTF2_MappingType  mappingType,
+                            const OTF2_IdMap *idMap) override
+    {
+    }
+
+    virtual void
+    handleLocalClockOffset(OTF2_LocationRef readLocation,
+                           OTF2_TimeStamp   time,
+                           int64_t          offset,
+                           double           standardDeviation) override
+    {
+    }
+
+    /*
+     * Handle events.
+     */
+
+    virtual void
+    handleBufferFlushEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_TimeStamp      stopTime) override
+    {
+        bool dropped = !m_event_BufferFlush_filter.empty() &&
+                       m_event_BufferFlush_filter.process(location, time, attributes, stopTime);
+        count_event(EventType::BufferFlush, dropped);
+    }
+
+    virtual void
+    handleMeasurementOnOffEvent(OTF2_LocationRef     location,
+                                OTF2_TimeStamp       time,
+                                OTF2_AttributeList * attributes,
+                                OTF2_MeasurementMode measurementMode) override
+    {
+        bool dropped = !m_event_MeasurementOnOff_filter.empty() &&
+                       m_event_MeasurementOnOff_filter.process(location, time, attributes, measurementMode);
+        count_event(EventType::MeasurementOnOff, dropped);
+    }
+
+    virtual void
+    handleEnterEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef      region) override
+    {
+        bool dropped = !m_event_Enter_filter.empty() &&
+                       m_event_Enter_filter.process(location, time, attributes, region);
+        count_event(EventType::Enter, dropped);
+    }
+
+    virtual void
+    handleLeaveEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef      region) override
+    {
+        bool dropped = !m_event_Leave_filter.empty() &&
+                       m_event_Leave_filter.process(location, time, attributes, region);
+        count_event(EventType::Leave, dropped);
+    }
+
+    virtual void
+    handleMpiSendEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            receiver,
+                       OTF2_CommRef        communicator,
+                       uint32_t            msgTag,
+                       uint64_t            msgLength) override
+    {
+        bool dropped = !m_event_MpiSend_filter.empty() &&
+                       m_event_MpiSend_filter.process(
+                           location, time, attributes, receiver, communicator, msgTag, msgLength);
+        count_event(EventType::MpiSend, dropped);
+    }
+
+    virtual void
+    handleMpiIsendEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        uint32_t            receiver,
+                        OTF2_CommRef        communicator,
+                        uint32_t            msgTag,
+                        uint64_t            msgLength,
+                        uint64_t            requestID) override
+    {
+        bool dropped = !m_event_MpiIsend_filter.empty() &&
+                       m_event_MpiIsend_filter.process(
+                           location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+        count_event(EventType::MpiIsend, dropped);
+    }
+
+    virtual void
+    handleMpiIsendCompleteEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                uint64_t            requestID) override
+    {
+        bool dropped = !m_event_MpiIsendComplete_filter.empty() &&
+                       m_event_MpiIsendComplete_filter.process(location, time, attributes, requestID);
+        count_event(EventType::MpiIsendComplete, dropped);
+    }
+
+    virtual void
+    handleMpiIrecvRequestEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint64_t            requestID) override
+    {
+        bool dropped = !m_event_MpiIrecvRequest_filter.empty() &&
+                       m_event_MpiIrecvRequest_filter.process(location, time, attributes, requestID);
+        count_event(EventType::MpiIrecvRequest, dropped);
+    }
+
+    virtual void
+    handleMpiRecvEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            sender,
+                       OTF2_CommRef        communicator,
+                       uint32_t            msgTag,
+                       uint64_t            msgLength) override
+    {
+        bool dropped = !m_event_MpiRecv_filter.empty() &&
+                       m_event_MpiRecv_filter.process(
+                           location, time, attributes, sender, communicator, msgTag, msgLength);
+        count_event(EventType::MpiRecv, dropped);
+    }
+
+    virtual void
+    handleMpiIrecvEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        uint32_t            sender,
+                        OTF2_CommRef        communicator,
+                        uint32_t            msgTag,
+                        uint64_t            msgLength,
+                        uint64_t            requestID) override
+    {
+        bool dropped = !m_event_MpiIrecv_filter.empty() &&
+                       m_event_MpiIrecv_filter.process(
+                           location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+        count_event(EventType::MpiIrecv, dropped);
+    }
+
+    virtual void
+    handleMpiRequestTestEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint64_t            requestID) override
+    {
+        bool dropped = !m_event_MpiRequestTest_filter.empty() &&
+                       m_event_MpiRequestTest_filter.process(location, time, attributes, requestID);
+        count_event(EventType::MpiRequestTest, dropped);
+    }
+
+    virtual void
+    handleMpiRequestCancelledEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   uint64_t            requestID) override
+    {
+        bool dropped = !m_event_MpiRequestCancelled_filter.empty() &&
+                       m_event_MpiRequestCancelled_filter.process(location, time, attributes, requestID);
+        count_event(EventType::MpiRequestCancelled, dropped);
+    }
+
+    virtual void
+    handleMpiCollectiveBeginEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes) override
+    {
+        bool dropped = !m_event_MpiCollectiveBegin_filter.empty() &&
+                       m_event_MpiCollectiveBegin_filter.process(location, time, attributes);
+        count_event(EventType::MpiCollectiveBegin, dropped);
+    }
+
+    virtual void
+    handleMpiCollectiveEndEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CollectiveOp   collectiveOp,
+                                OTF2_CommRef        communicator,
+                                uint32_t            root,
+                                uint64_t            sizeSent,
+                                uint64_t            sizeReceived) override
+    {
+        bool dropped = !m_event_MpiCollectiveEnd_filter.empty() &&
+                       m_event_MpiCollectiveEnd_filter.process(
+                           location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
+        count_event(EventType::MpiCollectiveEnd, dropped);
+    }
+
+    virtual void
+    handleOmpForkEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            numberOfRequestedThreads) override
+    {
+        bool dropped = !m_event_OmpFork_filter.empty() &&
+                       m_event_OmpFork_filter.process(location, time, attributes, numberOfRequestedThreads);
+        count_event(EventType::OmpFork, dropped);
+    }
+
+    virtual void
+    handleOmpJoinEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes) override
+    {
+        bool dropped = !m_event_OmpJoin_filter.empty() && m_event_OmpJoin_filter.process(location, time, attributes);
+        count_event(EventType::OmpJoin, dropped);
+    }
+
+    virtual void
+    handleOmpAcquireLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint32_t            lockID,
+                              uint32_t            acquisitionOrder) override
+    {
+        bool dropped = !m_event_OmpAcquireLock_filter.empty() &&
+                       m_event_OmpAcquireLock_filter.process(location, time, attributes, lockID, acquisitionOrder);
+        count_event(EventType::OmpAcquireLock, dropped);
+    }
+
+    virtual void
+    handleOmpReleaseLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint32_t            lockID,
+                              uint32_t            acquisitionOrder) override
+    {
+        bool dropped = !m_event_OmpReleaseLock_filter.empty() &&
+                       m_event_OmpReleaseLock_filter.process(location, time, attributes, lockID, acquisitionOrder);
+        count_event(EventType::OmpReleaseLock, dropped);
+    }
+
+    virtual void
+    handleOmpTaskCreateEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint64_t            taskID) override
+    {
+        bool dropped = !m_event_OmpTaskCreate_filter.empty() &&
+                       m_event_OmpTaskCreate_filter.process(location, time, attributes, taskID);
+        count_event(EventType::OmpTaskCreate, dropped);
+    }
+
+    virtual void
+    handleOmpTaskSwitchEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint64_t            taskID) override
+    {
+        bool dropped = !m_event_OmpTaskSwitch_filter.empty() &&
+                       m_event_OmpTaskSwitch_filter.process(location, time, attributes, taskID);
+        count_event(EventType::OmpTaskSwitch, dropped);
+    }
+
+    virtual void
+    handleOmpTaskCompleteEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint64_t            taskID) override
+    {
+        bool dropped = !m_event_OmpTaskComplete_filter.empty() &&
+                       m_event_OmpTaskComplete_filter.process(location, time, attributes, taskID);
+        count_event(EventType::OmpTaskComplete, dropped);
+    }
+
+    virtual void
+    handleMetricEvent(OTF2_LocationRef        location,
+                      OTF2_TimeStamp          time,
+                      OTF2_AttributeList *    attributes,
+                      OTF2_MetricRef          metric,
+                      uint8_t                 numberOfMetrics,
+                      const OTF2_Type *       typeIDs,
+                      const OTF2_MetricValue *metricValues) override
+    {
+        bool dropped = !m_event_Metric_filter.empty() &&
+                       m_event_Metric_filter.process(
+                           location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+        count_event(EventType::Metric, dropped);
+    }
+
+    virtual void
+    handleParameterStringEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_ParameterRef   parameter,
+                               OTF2_StringRef      string) override
+    {
+        bool dropped = !m_event_ParameterString_filter.empty() &&
+                       m_event_ParameterString_filter.process(location, time, attributes, parameter, string);
+        count_event(EventType::ParameterString, dropped);
+    }
+
+    virtual void
+    handleParameterIntEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_ParameterRef   parameter,
+                            int64_t             value) override
+    {
+        bool dropped = !m_event_ParameterInt_filter.empty() &&
+                       m_event_ParameterInt_filter.process(location, time, attributes, parameter, value);
+        count_event(EventType::ParameterInt, dropped);
+    }
+
+    virtual void
+    handleParameterUnsignedIntEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_ParameterRef   parameter,
+                                    uint64_t            value) override
+    {
+        bool dropped = !m_event_ParameterUnsignedInt_filter.empty() &&
+                       m_event_ParameterUnsignedInt_filter.process(location, time, attributes, parameter, value);
+        count_event(EventType::ParameterUnsignedInt, dropped);
+    }
+
+    virtual void
+    handleRmaWinCreateEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_RmaWinRef      win) override
+    {
+        bool dropped = !m_event_RmaWinCreate_filter.empty() &&
+                       m_event_RmaWinCreate_filter.process(location, time, attributes, win);
+        count_event(EventType::RmaWinCreate, dropped);
+    }
+
+    virtual void
+    handleRmaWinDestroyEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win) override
+    {
+        bool dropped = !m_event_RmaWinDestroy_filter.empty() &&
+                       m_event_RmaWinDestroy_filter.process(location, time, attributes, win);
+        count_event(EventType::RmaWinDestroy, dropped);
+    }
+
+    virtual void
+    handleRmaCollectiveBeginEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes) override
+    {
+        bool dropped = !m_event_RmaCollectiveBegin_filter.empty() &&
+                       m_event_RmaCollectiveBegin_filter.process(location, time, attributes);
+        count_event(EventType::RmaCollectiveBegin, dropped);
+    }
+
+    virtual void
+    handleRmaCollectiveEndEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CollectiveOp   collectiveOp,
+                                OTF2_RmaSyncLevel   syncLevel,
+                                OTF2_RmaWinRef      win,
+                                uint32_t            root,
+                                uint64_t            bytesSent,
+                                uint64_t            bytesReceived) override
+    {
+        bool dropped = !m_event_RmaCollectiveEnd_filter.empty() &&
+                       m_event_RmaCollectiveEnd_filter.process(
+                           location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+        count_event(EventType::RmaCollectiveEnd, dropped);
+    }
+
+    virtual void
+    handleRmaGroupSyncEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_RmaSyncLevel   syncLevel,
+                            OTF2_RmaWinRef      win,
+                            OTF2_GroupRef       group) override
+    {
+        bool dropped = !m_event_RmaGroupSync_filter.empty() &&
+                       m_event_RmaGroupSync_filter.process(location, time, attributes, syncLevel, win, group);
+        count_event(EventType::RmaGroupSync, dropped);
+    }
+
+    virtual void
+    handleRmaRequestLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            lockId,
+                              OTF2_LockType       lockType) override
+    {
+        bool dropped = !m_event_RmaRequestLock_filter.empty() &&
+                       m_event_RmaRequestLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
+        count_event(EventType::RmaRequestLock, dropped);
+    }
+
+    virtual void
+    handleRmaAcquireLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            lockId,
+                              OTF2_LockType       lockType) override
+    {
+        bool dropped = !m_event_RmaAcquireLock_filter.empty() &&
+                       m_event_RmaAcquireLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
+        count_event(EventType::RmaAcquireLock, dropped);
+    }
+
+    virtual void
+    handleRmaTryLockEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_RmaWinRef      win,
+                          uint32_t            remote,
+                          uint64_t            lockId,
+                          OTF2_LockType       lockType) override
+    {
+        bool dropped = !m_event_RmaTryLock_filter.empty() &&
+                       m_event_RmaTryLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
+        count_event(EventType::RmaTryLock, dropped);
+    }
+
+    virtual void
+    handleRmaReleaseLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            lockId) override
+    {
+        bool dropped = !m_event_RmaReleaseLock_filter.empty() &&
+                       m_event_RmaReleaseLock_filter.process(location, time, attributes, win, remote, lockId);
+        count_event(EventType::RmaReleaseLock, dropped);
+    }
+
+    virtual void
+    handleRmaSyncEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       OTF2_RmaWinRef      win,
+                       uint32_t            remote,
+                       OTF2_RmaSyncType    syncType) override
+    {
+        bool dropped = !m_event_RmaSync_filter.empty() &&
+                       m_event_RmaSync_filter.process(location, time, attributes, win, remote, syncType);
+        count_event(EventType::RmaSync, dropped);
+    }
+
+    virtual void
+    handleRmaWaitChangeEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win) override
+    {
+        bool dropped = !m_event_RmaWaitChange_filter.empty() &&
+                       m_event_RmaWaitChange_filter.process(location, time, attributes, win);
+        count_event(EventType::RmaWaitChange, dropped);
+    }
+
+    virtual void
+    handleRmaPutEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_RmaWinRef      win,
+                      uint32_t            remote,
+                      uint64_t            bytes,
+                      uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaPut_filter.empty() &&
+                       m_event_RmaPut_filter.process(location, time, attributes, win, remote, bytes, matchingId);
+        count_event(EventType::RmaPut, dropped);
+    }
+
+    virtual void
+    handleRmaGetEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_RmaWinRef      win,
+                      uint32_t            remote,
+                      uint64_t            bytes,
+                      uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaGet_filter.empty() &&
+                       m_event_RmaGet_filter.process(location, time, attributes, win, remote, bytes, matchingId);
+        count_event(EventType::RmaGet, dropped);
+    }
+
+    virtual void
+    handleRmaAtomicEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_RmaWinRef      win,
+                         uint32_t            remote,
+                         OTF2_RmaAtomicType  type,
+                         uint64_t            bytesSent,
+                         uint64_t            bytesReceived,
+                         uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaAtomic_filter.empty() &&
+                       m_event_RmaAtomic_filter.process(
+                           location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
+        count_event(EventType::RmaAtomic, dropped);
+    }
+
+    virtual void
+    handleRmaOpCompleteBlockingEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_RmaWinRef      win,
+                                     uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaOpCompleteBlocking_filter.empty() &&
+                       m_event_RmaOpCompleteBlocking_filter.process(location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpCompleteBlocking, dropped);
+    }
+
+    virtual void
+    handleRmaOpCompleteNonBlockingEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_RmaWinRef      win,
+                                        uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaOpCompleteNonBlocking_filter.empty() &&
+                       m_event_RmaOpCompleteNonBlocking_filter.process(location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpCompleteNonBlocking, dropped);
+    }
+
+    virtual void
+    handleRmaOpTestEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_RmaWinRef      win,
+                         uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaOpTest_filter.empty() &&
+                       m_event_RmaOpTest_filter.process(location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpTest, dropped);
+    }
+
+    virtual void
+    handleRmaOpCompleteRemoteEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_RmaWinRef      win,
+                                   uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_RmaOpCompleteRemote_filter.empty() &&
+                       m_event_RmaOpCompleteRemote_filter.process(location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpCompleteRemote, dropped);
+    }
+
+    virtual void
+    handleThreadForkEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_Paradigm       model,
+                          uint32_t            numberOfRequestedThreads) override
+    {
+        bool dropped = !m_event_ThreadFork_filter.empty() &&
+                       m_event_ThreadFork_filter.process(location, time, attributes, model, numberOfRequestedThreads);
+        count_event(EventType::ThreadFork, dropped);
+    }
+
+    virtual void
+    handleThreadJoinEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_Paradigm       model) override
+    {
+        bool dropped = !m_event_ThreadJoin_filter.empty() &&
+                       m_event_ThreadJoin_filter.process(location, time, attributes, model);
+        count_event(EventType::ThreadJoin, dropped);
+    }
+
+    virtual void
+    handleThreadTeamBeginEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_CommRef        threadTeam) override
+    {
+        bool dropped = !m_event_ThreadTeamBegin_filter.empty() &&
+                       m_event_ThreadTeamBegin_filter.process(location, time, attributes, threadTeam);
+        count_event(EventType::ThreadTeamBegin, dropped);
+    }
+
+    virtual void
+    handleThreadTeamEndEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_CommRef        threadTeam) override
+    {
+        bool dropped = !m_event_ThreadTeamEnd_filter.empty() &&
+                       m_event_ThreadTeamEnd_filter.process(location, time, attributes, threadTeam);
+        count_event(EventType::ThreadTeamEnd, dropped);
+    }
+
+    virtual void
+    handleThreadAcquireLockEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_Paradigm       model,
+                                 uint32_t            lockID,
+                                 uint32_t            acquisitionOrder) override
+    {
+        bool dropped = !m_event_ThreadAcquireLock_filter.empty() &&
+                       m_event_ThreadAcquireLock_filter.process(
+                           location, time, attributes, model, lockID, acquisitionOrder);
+        count_event(EventType::ThreadAcquireLock, dropped);
+    }
+
+    virtual void
+    handleThreadReleaseLockEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_Paradigm       model,
+                                 uint32_t            lockID,
+                                 uint32_t            acquisitionOrder) override
+    {
+        bool dropped = !m_event_ThreadReleaseLock_filter.empty() &&
+                       m_event_ThreadReleaseLock_filter.process(
+                           location, time, attributes, model, lockID, acquisitionOrder);
+        count_event(EventType::ThreadReleaseLock, dropped);
+    }
+
+    virtual void
+    handleThreadTaskCreateEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CommRef        threadTeam,
+                                uint32_t            creatingThread,
+                                uint32_t            generationNumber) override
+    {
+        bool dropped = !m_event_ThreadTaskCreate_filter.empty() &&
+                       m_event_ThreadTaskCreate_filter.process(
+                           location, time, attributes, threadTeam, creatingThread, generationNumber);
+        count_event(EventType::ThreadTaskCreate, dropped);
+    }
+
+    virtual void
+    handleThreadTaskSwitchEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CommRef        threadTeam,
+                                uint32_t            creatingThread,
+                                uint32_t            generationNumber) override
+    {
+        bool dropped = !m_event_ThreadTaskSwitch_filter.empty() &&
+                       m_event_ThreadTaskSwitch_filter.process(
+                           location, time, attributes, threadTeam, creatingThread, generationNumber);
+        count_event(EventType::ThreadTaskSwitch, dropped);
+    }
+
+    virtual void
+    handleThreadTaskCompleteEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_CommRef        threadTeam,
+                                  uint32_t            creatingThread,
+                                  uint32_t            generationNumber) override
+    {
+        bool dropped = !m_event_ThreadTaskComplete_filter.empty() &&
+                       m_event_ThreadTaskComplete_filter.process(
+                           location, time, attributes, threadTeam, creatingThread, generationNumber);
+        count_event(EventType::ThreadTaskComplete, dropped);
+    }
+
+    virtual void
+    handleThreadCreateEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_CommRef        threadContingent,
+                            uint64_t            sequenceCount) override
+    {
+        bool dropped = !m_event_ThreadCreate_filter.empty() &&
+                       m_event_ThreadCreate_filter.process(location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadCreate, dropped);
+    }
+
+    virtual void
+    handleThreadBeginEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_CommRef        threadContingent,
+                           uint64_t            sequenceCount) override
+    {
+        bool dropped = !m_event_ThreadBegin_filter.empty() &&
+                       m_event_ThreadBegin_filter.process(location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadBegin, dropped);
+    }
+
+    virtual void
+    handleThreadWaitEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_CommRef        threadContingent,
+                          uint64_t            sequenceCount) override
+    {
+        bool dropped = !m_event_ThreadWait_filter.empty() &&
+                       m_event_ThreadWait_filter.process(location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadWait, dropped);
+    }
+
+    virtual void
+    handleThreadEndEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_CommRef        threadContingent,
+                         uint64_t            sequenceCount) override
+    {
+        bool dropped = !m_event_ThreadEnd_filter.empty() &&
+                       m_event_ThreadEnd_filter.process(location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadEnd, dropped);
+    }
+
+    virtual void
+    handleCallingContextEnterEvent(OTF2_LocationRef       location,
+                                   OTF2_TimeStamp         time,
+                                   OTF2_AttributeList *   attributes,
+                                   OTF2_CallingContextRef callingContext,
+                                   uint32_t               unwindDistance) override
+    {
+        bool dropped = !m_event_CallingContextEnter_filter.empty() &&
+                       m_event_CallingContextEnter_filter.process(
+                           location, time, attributes, callingContext, unwindDistance);
+        count_event(EventType::CallingContextEnter, dropped);
+    }
+
+    virtual void
+    handleCallingContextLeaveEvent(OTF2_LocationRef       location,
+                                   OTF2_TimeStamp         time,
+                                   OTF2_AttributeList *   attributes,
+                                   OTF2_CallingContextRef callingContext) override
+    {
+        bool dropped = !m_event_CallingContextLeave_filter.empty() &&
+                       m_event_CallingContextLeave_filter.process(location, time, attributes, callingContext);
+        count_event(EventType::CallingContextLeave, dropped);
+    }
+
+    virtual void
+    handleCallingContextSampleEvent(OTF2_LocationRef           location,
+                                    OTF2_TimeStamp             time,
+                                    OTF2_AttributeList *       attributes,
+                                    OTF2_CallingContextRef     callingContext,
+                                    uint32_t                   unwindDistance,
+                                    OTF2_InterruptGeneratorRef interruptGenerator) override
+    {
+        bool dropped = !m_event_CallingContextSample_filter.empty() &&
+                       m_event_CallingContextSample_filter.process(
+                           location, time, attributes, callingContext, unwindDistance, interruptGenerator);
+        count_event(EventType::CallingContextSample, dropped);
+    }
+
+    virtual void
+    handleIoCreateHandleEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_IoHandleRef    handle,
+                              OTF2_IoAccessMode   mode,
+                              OTF2_IoCreationFlag creationFlags,
+                              OTF2_IoStatusFlag   statusFlags) override
+    {
+        bool dropped = !m_event_IoCreateHandle_filter.empty() &&
+                       m_event_IoCreateHandle_filter.process(
+                           location, time, attributes, handle, mode, creationFlags, statusFlags);
+        count_event(EventType::IoCreateHandle, dropped);
+    }
+
+    virtual void
+    handleIoDestroyHandleEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_IoHandleRef    handle) override
+    {
+        bool dropped = !m_event_IoDestroyHandle_filter.empty() &&
+                       m_event_IoDestroyHandle_filter.process(location, time, attributes, handle);
+        count_event(EventType::IoDestroyHandle, dropped);
+    }
+
+    virtual void
+    handleIoDuplicateHandleEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_IoHandleRef    oldHandle,
+                                 OTF2_IoHandleRef    newHandle,
+                                 OTF2_IoStatusFlag   statusFlags) override
+    {
+        bool dropped = !m_event_IoDuplicateHandle_filter.empty() &&
+                       m_event_IoDuplicateHandle_filter.process(
+                           location, time, attributes, oldHandle, newHandle, statusFlags);
+        count_event(EventType::IoDuplicateHandle, dropped);
+    }
+
+    virtual void
+    handleIoSeekEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_IoHandleRef    handle,
+                      int64_t             offsetRequest,
+                      OTF2_IoSeekOption   whence,
+                      uint64_t            offsetResult) override
+    {
+        bool dropped = !m_event_IoSeek_filter.empty() &&
+                       m_event_IoSeek_filter.process(
+                           location, time, attributes, handle, offsetRequest, whence, offsetResult);
+        count_event(EventType::IoSeek, dropped);
+    }
+
+    virtual void
+    handleIoChangeStatusFlagsEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_IoHandleRef    handle,
+                                   OTF2_IoStatusFlag   statusFlags) override
+    {
+        bool dropped = !m_event_IoChangeStatusFlags_filter.empty() &&
+                       m_event_IoChangeStatusFlags_filter.process(location, time, attributes, handle, statusFlags);
+        count_event(EventType::IoChangeStatusFlags, dropped);
+    }
+
+    virtual void
+    handleIoDeleteFileEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_IoParadigmRef  ioParadigm,
+                            OTF2_IoFileRef      file) override
+    {
+        bool dropped = !m_event_IoDeleteFile_filter.empty() &&
+                       m_event_IoDeleteFile_filter.process(location, time, attributes, ioParadigm, file);
+        count_event(EventType::IoDeleteFile, dropped);
+    }
+
+    virtual void
+    handleIoOperationBeginEvent(OTF2_LocationRef     location,
+                                OTF2_TimeStamp       time,
+                                OTF2_AttributeList * attributes,
+                                OTF2_IoHandleRef     handle,
+                                OTF2_IoOperationMode mode,
+                                OTF2_IoOperationFlag operationFlags,
+                                uint64_t             bytesRequest,
+                                uint64_t             matchingId) override
+    {
+        bool dropped = !m_event_IoOperationBegin_filter.empty() &&
+                       m_event_IoOperationBegin_filter.process(
+                           location, time, attributes, handle, mode, operationFlags, bytesRequest, matchingId);
+        count_event(EventType::IoOperationBegin, dropped);
+    }
+
+    virtual void
+    handleIoOperationTestEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_IoHandleRef    handle,
+                               uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_IoOperationTest_filter.empty() &&
+                       m_event_IoOperationTest_filter.process(location, time, attributes, handle, matchingId);
+        count_event(EventType::IoOperationTest, dropped);
+    }
+
+    virtual void
+    handleIoOperationIssuedEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_IoHandleRef    handle,
+                                 uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_IoOperationIssued_filter.empty() &&
+                       m_event_IoOperationIssued_filter.process(location, time, attributes, handle, matchingId);
+        count_event(EventType::IoOperationIssued, dropped);
+    }
+
+    virtual void
+    handleIoOperationCompleteEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_IoHandleRef    handle,
+                                   uint64_t            bytesResult,
+                                   uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_IoOperationComplete_filter.empty() &&
+                       m_event_IoOperationComplete_filter.process(
+                           location, time, attributes, handle, bytesResult, matchingId);
+        count_event(EventType::IoOperationComplete, dropped);
+    }
+
+    virtual void
+    handleIoOperationCancelledEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_IoHandleRef    handle,
+                                    uint64_t            matchingId) override
+    {
+        bool dropped = !m_event_IoOperationCancelled_filter.empty() &&
+                       m_event_IoOperationCancelled_filter.process(location, time, attributes, handle, matchingId);
+        count_event(EventType::IoOperationCancelled, dropped);
+    }
+
+    virtual void
+    handleIoAcquireLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_IoHandleRef    handle,
+                             OTF2_LockType       lockType) override
+    {
+        bool dropped = !m_event_IoAcquireLock_filter.empty() &&
+                       m_event_IoAcquireLock_filter.process(location, time, attributes, handle, lockType);
+        count_event(EventType::IoAcquireLock, dropped);
+    }
+
+    virtual void
+    handleIoReleaseLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_IoHandleRef    handle,
+                             OTF2_LockType       lockType) override
+    {
+        bool dropped = !m_event_IoReleaseLock_filter.empty() &&
+                       m_event_IoReleaseLock_filter.process(location, time, attributes, handle, lockType);
+        count_event(EventType::IoReleaseLock, dropped);
+    }
+
+    virtual void
+    handleIoTryLockEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_IoHandleRef    handle,
+                         OTF2_LockType       lockType) override
+    {
+        bool dropped = !m_event_IoTryLock_filter.empty() &&
+                       m_event_IoTryLock_filter.process(location, time, attributes, handle, lockType);
+        count_event(EventType::IoTryLock, dropped);
+    }
+
+    virtual void
+    handleProgramBeginEvent(OTF2_LocationRef      location,
+                            OTF2_TimeStamp        time,
+                            OTF2_AttributeList *  attributes,
+                            OTF2_StringRef        programName,
+                            uint32_t              numberOfArguments,
+                            const OTF2_StringRef *programArguments) override
+    {
+        bool dropped = !m_event_ProgramBegin_filter.empty() &&
+                       m_event_ProgramBegin_filter.process(
+                           location, time, attributes, programName, numberOfArguments, programArguments);
+        count_event(EventType::ProgramBegin, dropped);
+    }
+
+    virtual void
+    handleProgramEndEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          int64_t             exitStatus) override
+    {
+        bool dropped = !m_event_ProgramEnd_filter.empty() &&
+                       m_event_ProgramEnd_filter.process(location, time, attributes, exitStatus);
+        count_event(EventType::ProgramEnd, dropped);
+    }
+
+  private:
+    /*
+     * Location the current thread is reading.
+     */
+    struct ThreadLocation
+    {
+        const DryRunHandler *owner;
+        LocationEvents *     events;
+        EventCounters *      counters;
+    };
+
+    inline void
+    count_definition(GlobalDefinition definition, bool dropped)
+    {
+        m_definitions[static_cast<std::size_t>(definition)]++;
+        m_dropped_definitions[static_cast<std::size_t>(definition)] += dropped;
+    }
+
+    inline void
+    count_event(EventType type, bool dropped)
+    {
+        if (m_thread_location.owner != this)
+        {
+            return;
+        }
+        dropped = dropped || m_dropped_events[static_cast<std::size_t>(type)];
+        m_thread_location.counters->read[static_cast<std::size_t>(type)]++;
+        m_thread_location.counters->filtered[static_cast<std::size_t>(type)] += dropped;
+        if (m_thread_location.events != nullptr)
+        {
+            m_thread_location.events->dropped += dropped;
+            m_thread_location.events->kept += !dropped;
+        }
+    }
+
+    static inline thread_local ThreadLocation m_thread_location = {
+        .owner = nullptr, .events = nullptr, .counters = nullptr};
+
+    TraceStats &                                       m_stats;
+    StringTable                                        m_strings;
+    std::vector<GlobalDefinition>                      m_string_references;
+    std::vector<IFilterCallbacks *>                    m_location_filters;
+    TimeWindow                                         m_time_window;
+    std::array<bool, number_of_event_types>            m_handled_events{};
+    std::array<bool, number_of_event_types>            m_dropped_events{};
+    std::array<uint64_t, number_of_global_definitions> m_definitions{};
+    std::array<uint64_t, number_of_global_definitions> m_dropped_definitions{};
+
+    /*
+     * Created with the location definitions, the entry of a location is
+     * only written by the worker reading it.
+     */
+    std::unordered_map<OTF2_LocationRef, LocationEvents> m_locations;
+
+    Filter<GlobalClockPropertiesFilter>         m_global_ClockProperties_filter;
+    Filter<GlobalParadigmFilter>                m_global_Paradigm_filter;
+    Filter<GlobalParadigmPropertyFilter>        m_global_ParadigmProperty_filter;
+    Filter<GlobalIoParadigmFilter>              m_global_IoParadigm_filter;
+    Filter<GlobalStringFilter>                  m_global_String_filter;
+    Filter<GlobalAttributeFilter>               m_global_Attribute_filter;
+    Filter<GlobalSystemTreeNodeFilter>          m_global_SystemTreeNode_filter;
+    Filter<GlobalLocationGroupFilter>           m_global_LocationGroup_filter;
+    Filter<GlobalLocationFilter>                m_global_Location_filter;
+    Filter<GlobalRegionFilter>                  m_global_Region_filter;
+    Filter<GlobalCallsiteFilter>                m_global_Callsite_filter;
+    Filter<GlobalCallpathFilter>                m_global_Callpath_filter;
+    Filter<GlobalGroupFilter>                   m_global_Group_filter;
+    Filter<GlobalMetricMemberFilter>            m_global_MetricMember_filter;
+    Filter<GlobalMetricClassFilter>             m_global_MetricClass_filter;
+    Filter<GlobalMetricInstanceFilter>          m_global_MetricInstance_filter;
+    Filter<GlobalCommFilter>                    m_global_Comm_filter;
+    Filter<GlobalParameterFilter>               m_global_Parameter_filter;
+    Filter<GlobalRmaWinFilter>                  m_global_RmaWin_filter;
+    Filter<GlobalMetricClassRecorderFilter>     m_global_MetricClassRecorder_filter;
+    Filter<GlobalSystemTreeNodePropertyFilter>  m_global_SystemTreeNodeProperty_filter;
+    Filter<GlobalSystemTreeNodeDomainFilter>    m_global_SystemTreeNodeDomain_filter;
+    Filter<GlobalLocationGroupPropertyFilter>   m_global_LocationGroupProperty_filter;
+    Filter<GlobalLocationPropertyFilter>        m_global_LocationProperty_filter;
+    Filter<GlobalCartDimensionFilter>           m_global_CartDimension_filter;
+    Filter<GlobalCartTopologyFilter>            m_global_CartTopology_filter;
+    Filter<GlobalCartCoordinateFilter>          m_global_CartCoordinate_filter;
+    Filter<GlobalSourceCodeLocationFilter>      m_global_SourceCodeLocation_filter;
+    Filter<GlobalCallingContextFilter>          m_global_CallingContext_filter;
+    Filter<GlobalCallingContextPropertyFilter>  m_global_CallingContextProperty_filter;
+    Filter<GlobalInterruptGeneratorFilter>      m_global_InterruptGenerator_filter;
+    Filter<GlobalIoFilePropertyFilter>          m_global_IoFileProperty_filter;
+    Filter<GlobalIoRegularFileFilter>           m_global_IoRegularFile_filter;
+    Filter<GlobalIoDirectoryFilter>             m_global_IoDirectory_filter;
+    Filter<GlobalIoHandleFilter>                m_global_IoHandle_filter;
+    Filter<GlobalIoPreCreatedHandleStateFilter> m_global_IoPreCreatedHandleState_filter;
+    Filter<GlobalCallpathParameterFilter>       m_global_CallpathParameter_filter;
+
+    Filter<EventBufferFlushFilter>              m_event_BufferFlush_filter;
+    Filter<EventMeasurementOnOffFilter>         m_event_MeasurementOnOff_filter;
+    Filter<EventEnterFilter>                    m_event_Enter_filter;
+    Filter<EventLeaveFilter>                    m_event_Leave_filter;
+    Filter<EventMpiSendFilter>                  m_event_MpiSend_filter;
+    Filter<EventMpiIsendFilter>                 m_event_MpiIsend_filter;
+    Filter<EventMpiIsendCompleteFilter>         m_event_MpiIsendComplete_filter;
+    Filter<EventMpiIrecvRequestFilter>          m_event_MpiIrecvRequest_filter;
+    Filter<EventMpiRecvFilter>                  m_event_MpiRecv_filter;
+    Filter<EventMpiIrecvFilter>                 m_event_MpiIrecv_filter;
+    Filter<EventMpiRequestTestFilter>           m_event_MpiRequestTest_filter;
+    Filter<EventMpiRequestCancelledFilter>      m_event_MpiRequestCancelled_filter;
+    Filter<EventMpiCollectiveBeginFilter>       m_event_MpiCollectiveBegin_filter;
+    Filter<EventMpiCollectiveEndFilter>         m_event_MpiCollectiveEnd_filter;
+    Filter<EventOmpForkFilter>                  m_event_OmpFork_filter;
+    Filter<EventOmpJoinFilter>                  m_event_OmpJoin_filter;
+    Filter<EventOmpAcquireLockFilter>           m_event_OmpAcquireLock_filter;
+    Filter<EventOmpReleaseLockFilter>           m_event_OmpReleaseLock_filter;
+    Filter<EventOmpTaskCreateFilter>            m_event_OmpTaskCreate_filter;
+    Filter<EventOmpTaskSwitchFilter>            m_event_OmpTaskSwitch_filter;
+    Filter<EventOmpTaskCompleteFilter>          m_event_OmpTaskComplete_filter;
+    Filter<EventMetricFilter>                   m_event_Metric_filter;
+    Filter<EventParameterStringFilter>          m_event_ParameterString_filter;
+    Filter<EventParameterIntFilter>             m_event_ParameterInt_filter;
+    Filter<EventParameterUnsignedIntFilter>     m_event_ParameterUnsignedInt_filter;
+    Filter<EventRmaWinCreateFilter>             m_event_RmaWinCreate_filter;
+    Filter<EventRmaWinDestroyFilter>            m_event_RmaWinDestroy_filter;
+    Filter<EventRmaCollectiveBeginFilter>       m_event_RmaCollectiveBegin_filter;
+    Filter<EventRmaCollectiveEndFilter>         m_event_RmaCollectiveEnd_filter;
+    Filter<EventRmaGroupSyncFilter>             m_event_RmaGroupSync_filter;
+    Filter<EventRmaRequestLockFilter>           m_event_RmaRequestLock_filter;
+    Filter<EventRmaAcquireLockFilter>           m_event_RmaAcquireLock_filter;
+    Filter<EventRmaTryLockFilter>               m_event_RmaTryLock_filter;
+    Filter<EventRmaReleaseLockFilter>           m_event_RmaReleaseLock_filter;
+    Filter<EventRmaSyncFilter>                  m_event_RmaSync_filter;
+    Filter<EventRmaWaitChangeFilter>            m_event_RmaWaitChange_filter;
+    Filter<EventRmaPutFilter>                   m_event_RmaPut_filter;
+    Filter<EventRmaGetFilter>                   m_event_RmaGet_filter;
+    Filter<EventRmaAtomicFilter>                m_event_RmaAtomic_filter;
+    Filter<EventRmaOpCompleteBlockingFilter>    m_event_RmaOpCompleteBlocking_filter;
+    Filter<EventRmaOpCompleteNonBlockingFilter> m_event_RmaOpCompleteNonBlocking_filter;
+    Filter<EventRmaOpTestFilter>                m_event_RmaOpTest_filter;
+    Filter<EventRmaOpCompleteRemoteFilter>      m_event_RmaOpCompleteRemote_filter;
+    Filter<EventThreadForkFilter>               m_event_ThreadFork_filter;
+    Filter<EventThreadJoinFilter>               m_event_ThreadJoin_filter;
+    Filter<EventThreadTeamBeginFilter>          m_event_ThreadTeamBegin_filter;
+    Filter<EventThreadTeamEndFilter>            m_event_ThreadTeamEnd_filter;
+    Filter<EventThreadAcquireLockFilter>        m_event_ThreadAcquireLock_filter;
+    Filter<EventThreadReleaseLockFilter>        m_event_ThreadReleaseLock_filter;
+    Filter<EventThreadTaskCreateFilter>         m_event_ThreadTaskCreate_filter;
+    Filter<EventThreadTaskSwitchFilter>         m_event_ThreadTaskSwitch_filter;
+    Filter<EventThreadTaskCompleteFilter>       m_event_ThreadTaskComplete_filter;
+    Filter<EventThreadCreateFilter>             m_event_ThreadCreate_filter;
+    Filter<EventThreadBeginFilter>              m_event_ThreadBegin_filter;
+    Filter<EventThreadWaitFilter>               m_event_ThreadWait_filter;
+    Filter<EventThreadEndFilter>                m_event_ThreadEnd_filter;
+    Filter<EventCallingContextEnterFilter>      m_event_CallingContextEnter_filter;
+    Filter<EventCallingContextLeaveFilter>      m_event_CallingContextLeave_filter;
+    Filter<EventCallingContextSampleFilter>     m_event_CallingContextSample_filter;
+    Filter<EventIoCreateHandleFilter>           m_event_IoCreateHandle_filter;
+    Filter<EventIoDestroyHandleFilter>          m_event_IoDestroyHandle_filter;
+    Filter<EventIoDuplicateHandleFilter>        m_event_IoDuplicateHandle_filter;
+    Filter<EventIoSeekFilter>                   m_event_IoSeek_filter;
+    Filter<EventIoChangeStatusFlagsFilter>      m_event_IoChangeStatusFlags_filter;
+    Filter<EventIoDeleteFileFilter>             m_event_IoDeleteFile_filter;
+    Filter<EventIoOperationBeginFilter>         m_event_IoOperationBegin_filter;
+    Filter<EventIoOperationTestFilter>          m_event_IoOperationTest_filter;
+    Filter<EventIoOperationIssuedFilter>        m_event_IoOperationIssued_filter;
+    Filter<EventIoOperationCompleteFilter>      m_event_IoOperationComplete_filter;
+    Filter<EventIoOperationCancelledFilter>     m_event_IoOperationCancelled_filter;
+    Filter<EventIoAcquireLockFilter>            m_event_IoAcquireLock_filter;
+    Filter<EventIoReleaseLockFilter>            m_event_IoReleaseLock_filter;
+    Filter<EventIoTryLockFilter>                m_event_IoTryLock_filter;
+    Filter<EventProgramBeginFilter>             m_event_ProgramBegin_filter;
+    Filter<EventProgramEndFilter>               m_event_ProgramEnd_filter;
+};
+
+#endif /* DRY_RUN_HANDLER_H */
@@ -0,0 +1,20 @@
+#ifndef FILE_COPY_H
+#define FILE_COPY_H
+
+#include <filesystem>
+
+/*
+ * Copy a file byte by byte, replacing the target.
+ *
+ * The target shares the extents of the source if the file system supports
+ * reflinks. Otherwise the data is copied by the kernel with
+ * copy_file_range(), falling back to read() and write() if that is not
+ * supported for the two files either.
+ *
+ * @return false if the file could not be copied, a partially written
+ *         target is removed
+ */
+bool
+clone_file(const std::filesystem::path &source, const std::filesystem::path &target);
+
+#endif /* FILE_COPY_H */
@@ -1,46 +1,182 @@
 #ifndef EVENT_CALLBACKS_HPP
 #define EVENT_CALLBACKS_HPP
 
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 extern "C"
 {
 #include <otf2/otf2.h>
 }
 
+#include <otf2_handler.hpp>
+
+template <typename Handler>
+class LocalReader;
+
+template <typename Handler>
+using ReaderLocationPair = std::pair<LocalReader<Handler> &, size_t>;
+
+/*
+ * The callbacks of a LocalReader<Handler> call the overrides of Handler
+ * directly. They are inlined where the overrides are defined in a header,
+ * as by TraceWriter and StaticTraceWriter. The dynamic type of the handler
+ * has to be Handler then. Only calls to an Otf2Handler are dispatched
+ * virtually.
+ */
+template <typename Handler>
+inline constexpr bool dispatch_virtually = std::is_same_v<Handler, Otf2Handler>;
+
+template <typename Handler>
+inline bool
+reads_past_end(Handler &handler, OTF2_LocationRef location)
+{
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        return handler.readsPastEnd(location);
+    }
+    else
+    {
+        return handler.Handler::readsPastEnd(location);
+    }
+}
+
 namespace event
 {
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalBufferFlushCb(OTF2_LocationRef    location,
                    OTF2_TimeStamp      time,
                    uint64_t            eventPosition,
                    void *              userData,
                    OTF2_AttributeList *attributes,
-                   OTF2_TimeStamp      stopTime);
+                   OTF2_TimeStamp      stopTime)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleBufferFlushEvent(location, time, attributes, stopTime);
+    }
+    else
+    {
+        tr->handler().Handler::handleBufferFlushEvent(location, time, attributes, stopTime);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMeasurementOnOffCb(OTF2_LocationRef     location,
                         OTF2_TimeStamp       time,
                         uint64_t             eventPosition,
                         void *               userData,
                         OTF2_AttributeList * attributes,
-                        OTF2_MeasurementMode measurementMode);
+                        OTF2_MeasurementMode measurementMode)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMeasurementOnOffEvent(location, time, attributes, measurementMode);
+    }
+    else
+    {
+        tr->handler().Handler::handleMeasurementOnOffEvent(location, time, attributes, measurementMode);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalEnterCb(OTF2_LocationRef    location,
              OTF2_TimeStamp      time,
              uint64_t            eventPosition,
              void *              userData,
              OTF2_AttributeList *attributes,
-             OTF2_RegionRef      region);
+             OTF2_RegionRef      region)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->open_event({EventType::Enter, time, region});
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleEnterEvent(location, time, attributes, region);
+    }
+    else
+    {
+        tr->handler().Handler::handleEnterEvent(location, time, attributes, region);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalLeaveCb(OTF2_LocationRef    location,
              OTF2_TimeStamp      time,
              uint64_t            eventPosition,
              void *              userData,
              OTF2_AttributeList *attributes,
-             OTF2_RegionRef      region);
+             OTF2_RegionRef      region)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->close_event(EventType::Enter);
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleLeaveEvent(location, time, attributes, region);
+    }
+    else
+    {
+        tr->handler().Handler::handleLeaveEvent(location, time, attributes, region);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiSendCb(OTF2_LocationRef    location,
                OTF2_TimeStamp      time,
@@ -50,8 +186,33 @@ LocalMpiSendCb(OTF2_LocationRef    location,
                uint32_t            receiver,
                OTF2_CommRef        communicator,
                uint32_t            msgTag,
-               uint64_t            msgLength);
+               uint64_t            msgLength)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiSendEvent(location, time, attributes, receiver, communicator, msgTag, msgLength);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiSendEvent(
+            location, time, attributes, receiver, communicator, msgTag, msgLength);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiIsendCb(OTF2_LocationRef    location,
                 OTF2_TimeStamp      time,
@@ -62,24 +223,98 @@ LocalMpiIsendCb(OTF2_LocationRef    location,
                 OTF2_CommRef        communicator,
                 uint32_t            msgTag,
                 uint64_t            msgLength,
-                uint64_t            requestID);
+                uint64_t            requestID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiIsendEvent(
+            location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiIsendEvent(
+            location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiIsendCompleteCb(OTF2_LocationRef    location,
                         OTF2_TimeStamp      time,
                         uint64_t            eventPosition,
                         void *              userData,
                         OTF2_AttributeList *attributes,
-                        uint64_t            requestID);
+                        uint64_t            requestID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiIsendCompleteEvent(location, time, attributes, requestID);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiIsendCompleteEvent(location, time, attributes, requestID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiIrecvRequestCb(OTF2_LocationRef    location,
                        OTF2_TimeStamp      time,
                        uint64_t            eventPosition,
                        void *              userData,
                        OTF2_AttributeList *attributes,
-                       uint64_t            requestID);
+                       uint64_t            requestID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiIrecvRequestEvent(location, time, attributes, requestID);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiIrecvRequestEvent(location, time, attributes, requestID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiRecvCb(OTF2_LocationRef    location,
                OTF2_TimeStamp      time,
@@ -89,8 +324,32 @@ LocalMpiRecvCb(OTF2_LocationRef    location,
                uint32_t            sender,
                OTF2_CommRef        communicator,
                uint32_t            msgTag,
-               uint64_t            msgLength);
+               uint64_t            msgLength)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiRecvEvent(location, time, attributes, sender, communicator, msgTag, msgLength);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiRecvEvent(location, time, attributes, sender, communicator, msgTag, msgLength);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiIrecvCb(OTF2_LocationRef    location,
                 OTF2_TimeStamp      time,
@@ -101,31 +360,130 @@ LocalMpiIrecvCb(OTF2_LocationRef    location,
                 OTF2_CommRef        communicator,
                 uint32_t            msgTag,
                 uint64_t            msgLength,
-                uint64_t            requestID);
+                uint64_t            requestID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiIrecvEvent(
+            location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiIrecvEvent(
+            location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiRequestTestCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
                       uint64_t            eventPosition,
                       void *              userData,
                       OTF2_AttributeList *attributes,
-                      uint64_t            requestID);
+                      uint64_t            requestID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiRequestTestEvent(location, time, attributes, requestID);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiRequestTestEvent(location, time, attributes, requestID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiRequestCancelledCb(OTF2_LocationRef    location,
                            OTF2_TimeStamp      time,
                            uint64_t            eventPosition,
                            void *              userData,
                            OTF2_AttributeList *attributes,
-                           uint64_t            requestID);
+                           uint64_t            requestID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiRequestCancelledEvent(location, time, attributes, requestID);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiRequestCancelledEvent(location, time, attributes, requestID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiCollectiveBeginCb(OTF2_LocationRef    location,
                           OTF2_TimeStamp      time,
                           uint64_t            eventPosition,
                           void *              userData,
-                          OTF2_AttributeList *attributes);
+                          OTF2_AttributeList *attributes)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->open_event({EventType::MpiCollectiveBegin, time});
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiCollectiveBeginEvent(location, time, attributes);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiCollectiveBeginEvent(location, time, attributes);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMpiCollectiveEndCb(OTF2_LocationRef    location,
                         OTF2_TimeStamp      time,
@@ -136,23 +494,98 @@ LocalMpiCollectiveEndCb(OTF2_LocationRef    location,
                         OTF2_CommRef        communicator,
                         uint32_t            root,
                         uint64_t            sizeSent,
-                        uint64_t            sizeReceived);
+                        uint64_t            sizeReceived)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->close_event(EventType::MpiCollectiveBegin);
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMpiCollectiveEndEvent(
+            location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
+    }
+    else
+    {
+        tr->handler().Handler::handleMpiCollectiveEndEvent(
+            location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpForkCb(OTF2_LocationRef    location,
                OTF2_TimeStamp      time,
                uint64_t            eventPosition,
                void *              userData,
                OTF2_AttributeList *attributes,
-               uint32_t            numberOfRequestedThreads);
+               uint32_t            numberOfRequestedThreads)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpForkEvent(location, time, attributes, numberOfRequestedThreads);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpForkEvent(location, time, attributes, numberOfRequestedThreads);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpJoinCb(OTF2_LocationRef    location,
                OTF2_TimeStamp      time,
                uint64_t            eventPosition,
                void *              userData,
-               OTF2_AttributeList *attributes);
+               OTF2_AttributeList *attributes)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpJoinEvent(location, time, attributes);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpJoinEvent(location, time, attributes);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpAcquireLockCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
@@ -160,8 +593,32 @@ LocalOmpAcquireLockCb(OTF2_LocationRef    location,
                       void *              userData,
                       OTF2_AttributeList *attributes,
                       uint32_t            lockID,
-                      uint32_t            acquisitionOrder);
+                      uint32_t            acquisitionOrder)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpAcquireLockEvent(location, time, attributes, lockID, acquisitionOrder);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpAcquireLockEvent(location, time, attributes, lockID, acquisitionOrder);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpReleaseLockCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
@@ -169,32 +626,128 @@ LocalOmpReleaseLockCb(OTF2_LocationRef    location,
                       void *              userData,
                       OTF2_AttributeList *attributes,
                       uint32_t            lockID,
-                      uint32_t            acquisitionOrder);
+                      uint32_t            acquisitionOrder)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpReleaseLockEvent(location, time, attributes, lockID, acquisitionOrder);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpReleaseLockEvent(location, time, attributes, lockID, acquisitionOrder);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpTaskCreateCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
                      uint64_t            eventPosition,
                      void *              userData,
                      OTF2_AttributeList *attributes,
-                     uint64_t            taskID);
+                     uint64_t            taskID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpTaskCreateEvent(location, time, attributes, taskID);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpTaskCreateEvent(location, time, attributes, taskID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpTaskSwitchCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
                      uint64_t            eventPosition,
                      void *              userData,
                      OTF2_AttributeList *attributes,
-                     uint64_t            taskID);
+                     uint64_t            taskID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpTaskSwitchEvent(location, time, attributes, taskID);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpTaskSwitchEvent(location, time, attributes, taskID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalOmpTaskCompleteCb(OTF2_LocationRef    location,
                        OTF2_TimeStamp      time,
                        uint64_t            eventPosition,
                        void *              userData,
                        OTF2_AttributeList *attributes,
-                       uint64_t            taskID);
+                       uint64_t            taskID)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleOmpTaskCompleteEvent(location, time, attributes, taskID);
+    }
+    else
+    {
+        tr->handler().Handler::handleOmpTaskCompleteEvent(location, time, attributes, taskID);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalMetricCb(OTF2_LocationRef        location,
               OTF2_TimeStamp          time,
@@ -204,8 +757,33 @@ LocalMetricCb(OTF2_LocationRef        location,
               OTF2_MetricRef          metric,
               uint8_t                 numberOfMetrics,
               const OTF2_Type *       typeIDs,
-              const OTF2_MetricValue *metricValues);
+              const OTF2_MetricValue *metricValues)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleMetricEvent(location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+    }
+    else
+    {
+        tr->handler().Handler::handleMetricEvent(
+            location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalParameterStringCb(OTF2_LocationRef    location,
                        OTF2_TimeStamp      time,
@@ -213,8 +791,32 @@ LocalParameterStringCb(OTF2_LocationRef    location,
                        void *              userData,
                        OTF2_AttributeList *attributes,
                        OTF2_ParameterRef   parameter,
-                       OTF2_StringRef      string);
+                       OTF2_StringRef      string)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleParameterStringEvent(location, time, attributes, parameter, string);
+    }
+    else
+    {
+        tr->handler().Handler::handleParameterStringEvent(location, time, attributes, parameter, string);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalParameterIntCb(OTF2_LocationRef    location,
                     OTF2_TimeStamp      time,
@@ -222,8 +824,32 @@ LocalParameterIntCb(OTF2_LocationRef    location,
                     void *              userData,
                     OTF2_AttributeList *attributes,
                     OTF2_ParameterRef   parameter,
-                    int64_t             value);
+                    int64_t             value)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleParameterIntEvent(location, time, attributes, parameter, value);
+    }
+    else
+    {
+        tr->handler().Handler::handleParameterIntEvent(location, time, attributes, parameter, value);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalParameterUnsignedIntCb(OTF2_LocationRef    location,
                             OTF2_TimeStamp      time,
@@ -231,31 +857,127 @@ LocalParameterUnsignedIntCb(OTF2_LocationRef    location,
                             void *              userData,
                             OTF2_AttributeList *attributes,
                             OTF2_ParameterRef   parameter,
-                            uint64_t            value);
+                            uint64_t            value)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleParameterUnsignedIntEvent(location, time, attributes, parameter, value);
+    }
+    else
+    {
+        tr->handler().Handler::handleParameterUnsignedIntEvent(location, time, attributes, parameter, value);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaWinCreateCb(OTF2_LocationRef    location,
                     OTF2_TimeStamp      time,
                     uint64_t            eventPosition,
                     void *              userData,
                     OTF2_AttributeList *attributes,
-                    OTF2_RmaWinRef      win);
+                    OTF2_RmaWinRef      win)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaWinCreateEvent(location, time, attributes, win);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaWinCreateEvent(location, time, attributes, win);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaWinDestroyCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
                      uint64_t            eventPosition,
                      void *              userData,
                      OTF2_AttributeList *attributes,
-                     OTF2_RmaWinRef      win);
+                     OTF2_RmaWinRef      win)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaWinDestroyEvent(location, time, attributes, win);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaWinDestroyEvent(location, time, attributes, win);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaCollectiveBeginCb(OTF2_LocationRef    location,
                           OTF2_TimeStamp      time,
                           uint64_t            eventPosition,
                           void *              userData,
-                          OTF2_AttributeList *attributes);
+                          OTF2_AttributeList *attributes)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaCollectiveBeginEvent(location, time, attributes);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaCollectiveBeginEvent(location, time, attributes);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaCollectiveEndCb(OTF2_LocationRef    location,
                         OTF2_TimeStamp      time,
@@ -267,8 +989,34 @@ LocalRmaCollectiveEndCb(OTF2_LocationRef    location,
                         OTF2_RmaWinRef      win,
                         uint32_t            root,
                         uint64_t            bytesSent,
-                        uint64_t            bytesReceived);
+                        uint64_t            bytesReceived)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaCollectiveEndEvent(
+            location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaCollectiveEndEvent(
+            location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaGroupSyncCb(OTF2_LocationRef    location,
                     OTF2_TimeStamp      time,
@@ -277,8 +1025,32 @@ LocalRmaGroupSyncCb(OTF2_LocationRef    location,
                     OTF2_AttributeList *attributes,
                     OTF2_RmaSyncLevel   syncLevel,
                     OTF2_RmaWinRef      win,
-                    OTF2_GroupRef       group);
+                    OTF2_GroupRef       group)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaGroupSyncEvent(location, time, attributes, syncLevel, win, group);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaGroupSyncEvent(location, time, attributes, syncLevel, win, group);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaRequestLockCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
@@ -288,8 +1060,32 @@ LocalRmaRequestLockCb(OTF2_LocationRef    location,
                       OTF2_RmaWinRef      win,
                       uint32_t            remote,
                       uint64_t            lockId,
-                      OTF2_LockType       lockType);
+                      OTF2_LockType       lockType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaRequestLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaRequestLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaAcquireLockCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
@@ -299,8 +1095,32 @@ LocalRmaAcquireLockCb(OTF2_LocationRef    location,
                       OTF2_RmaWinRef      win,
                       uint32_t            remote,
                       uint64_t            lockId,
-                      OTF2_LockType       lockType);
+                      OTF2_LockType       lockType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaAcquireLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaAcquireLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaTryLockCb(OTF2_LocationRef    location,
                   OTF2_TimeStamp      time,
@@ -310,8 +1130,32 @@ LocalRmaTryLockCb(OTF2_LocationRef    location,
                   OTF2_RmaWinRef      win,
                   uint32_t            remote,
                   uint64_t            lockId,
-                  OTF2_LockType       lockType);
+                  OTF2_LockType       lockType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaTryLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaTryLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaReleaseLockCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
@@ -320,8 +1164,32 @@ LocalRmaReleaseLockCb(OTF2_LocationRef    location,
                       OTF2_AttributeList *attributes,
                       OTF2_RmaWinRef      win,
                       uint32_t            remote,
-                      uint64_t            lockId);
+                      uint64_t            lockId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaReleaseLockEvent(location, time, attributes, win, remote, lockId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaReleaseLockEvent(location, time, attributes, win, remote, lockId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaSyncCb(OTF2_LocationRef    location,
                OTF2_TimeStamp      time,
@@ -330,16 +1198,64 @@ LocalRmaSyncCb(OTF2_LocationRef    location,
                OTF2_AttributeList *attributes,
                OTF2_RmaWinRef      win,
                uint32_t            remote,
-               OTF2_RmaSyncType    syncType);
+               OTF2_RmaSyncType    syncType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaSyncEvent(location, time, attributes, win, remote, syncType);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaSyncEvent(location, time, attributes, win, remote, syncType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaWaitChangeCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
                      uint64_t            eventPosition,
                      void *              userData,
                      OTF2_AttributeList *attributes,
-                     OTF2_RmaWinRef      win);
+                     OTF2_RmaWinRef      win)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaWaitChangeEvent(location, time, attributes, win);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaWaitChangeEvent(location, time, attributes, win);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaPutCb(OTF2_LocationRef    location,
               OTF2_TimeStamp      time,
@@ -349,8 +1265,32 @@ LocalRmaPutCb(OTF2_LocationRef    location,
               OTF2_RmaWinRef      win,
               uint32_t            remote,
               uint64_t            bytes,
-              uint64_t            matchingId);
+              uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaPutEvent(location, time, attributes, win, remote, bytes, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaPutEvent(location, time, attributes, win, remote, bytes, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaGetCb(OTF2_LocationRef    location,
               OTF2_TimeStamp      time,
@@ -360,8 +1300,32 @@ LocalRmaGetCb(OTF2_LocationRef    location,
               OTF2_RmaWinRef      win,
               uint32_t            remote,
               uint64_t            bytes,
-              uint64_t            matchingId);
+              uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaGetEvent(location, time, attributes, win, remote, bytes, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaGetEvent(location, time, attributes, win, remote, bytes, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaAtomicCb(OTF2_LocationRef    location,
                  OTF2_TimeStamp      time,
@@ -373,8 +1337,34 @@ LocalRmaAtomicCb(OTF2_LocationRef    location,
                  OTF2_RmaAtomicType  type,
                  uint64_t            bytesSent,
                  uint64_t            bytesReceived,
-                 uint64_t            matchingId);
+                 uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaAtomicEvent(
+            location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaAtomicEvent(
+            location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaOpCompleteBlockingCb(OTF2_LocationRef    location,
                              OTF2_TimeStamp      time,
@@ -382,8 +1372,32 @@ LocalRmaOpCompleteBlockingCb(OTF2_LocationRef    location,
                              void *              userData,
                              OTF2_AttributeList *attributes,
                              OTF2_RmaWinRef      win,
-                             uint64_t            matchingId);
+                             uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaOpCompleteBlockingEvent(location, time, attributes, win, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaOpCompleteBlockingEvent(location, time, attributes, win, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaOpCompleteNonBlockingCb(OTF2_LocationRef    location,
                                 OTF2_TimeStamp      time,
@@ -391,8 +1405,32 @@ LocalRmaOpCompleteNonBlockingCb(OTF2_LocationRef    location,
                                 void *              userData,
                                 OTF2_AttributeList *attributes,
                                 OTF2_RmaWinRef      win,
-                                uint64_t            matchingId);
+                                uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaOpCompleteNonBlockingEvent(location, time, attributes, win, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaOpCompleteNonBlockingEvent(location, time, attributes, win, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaOpTestCb(OTF2_LocationRef    location,
                  OTF2_TimeStamp      time,
@@ -400,8 +1438,32 @@ LocalRmaOpTestCb(OTF2_LocationRef    location,
                  void *              userData,
                  OTF2_AttributeList *attributes,
                  OTF2_RmaWinRef      win,
-                 uint64_t            matchingId);
+                 uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaOpTestEvent(location, time, attributes, win, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaOpTestEvent(location, time, attributes, win, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalRmaOpCompleteRemoteCb(OTF2_LocationRef    location,
                            OTF2_TimeStamp      time,
@@ -409,8 +1471,32 @@ LocalRmaOpCompleteRemoteCb(OTF2_LocationRef    location,
                            void *              userData,
                            OTF2_AttributeList *attributes,
                            OTF2_RmaWinRef      win,
-                           uint64_t            matchingId);
+                           uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleRmaOpCompleteRemoteEvent(location, time, attributes, win, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleRmaOpCompleteRemoteEvent(location, time, attributes, win, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadForkCb(OTF2_LocationRef    location,
                   OTF2_TimeStamp      time,
@@ -418,32 +1504,128 @@ LocalThreadForkCb(OTF2_LocationRef    location,
                   void *              userData,
                   OTF2_AttributeList *attributes,
                   OTF2_Paradigm       model,
-                  uint32_t            numberOfRequestedThreads);
+                  uint32_t            numberOfRequestedThreads)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadForkEvent(location, time, attributes, model, numberOfRequestedThreads);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadForkEvent(location, time, attributes, model, numberOfRequestedThreads);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadJoinCb(OTF2_LocationRef    location,
                   OTF2_TimeStamp      time,
                   uint64_t            eventPosition,
                   void *              userData,
                   OTF2_AttributeList *attributes,
-                  OTF2_Paradigm       model);
+                  OTF2_Paradigm       model)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadJoinEvent(location, time, attributes, model);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadJoinEvent(location, time, attributes, model);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadTeamBeginCb(OTF2_LocationRef    location,
                        OTF2_TimeStamp      time,
                        uint64_t            eventPosition,
                        void *              userData,
                        OTF2_AttributeList *attributes,
-                       OTF2_CommRef        threadTeam);
+                       OTF2_CommRef        threadTeam)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadTeamBeginEvent(location, time, attributes, threadTeam);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadTeamBeginEvent(location, time, attributes, threadTeam);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadTeamEndCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
                      uint64_t            eventPosition,
                      void *              userData,
                      OTF2_AttributeList *attributes,
-                     OTF2_CommRef        threadTeam);
+                     OTF2_CommRef        threadTeam)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadTeamEndEvent(location, time, attributes, threadTeam);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadTeamEndEvent(location, time, attributes, threadTeam);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadAcquireLockCb(OTF2_LocationRef    location,
                          OTF2_TimeStamp      time,
@@ -452,8 +1634,33 @@ LocalThreadAcquireLockCb(OTF2_LocationRef    location,
                          OTF2_AttributeList *attributes,
                          OTF2_Paradigm       model,
                          uint32_t            lockID,
-                         uint32_t            acquisitionOrder);
+                         uint32_t            acquisitionOrder)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadAcquireLockEvent(location, time, attributes, model, lockID, acquisitionOrder);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadAcquireLockEvent(
+            location, time, attributes, model, lockID, acquisitionOrder);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadReleaseLockCb(OTF2_LocationRef    location,
                          OTF2_TimeStamp      time,
@@ -462,8 +1669,33 @@ LocalThreadReleaseLockCb(OTF2_LocationRef    location,
                          OTF2_AttributeList *attributes,
                          OTF2_Paradigm       model,
                          uint32_t            lockID,
-                         uint32_t            acquisitionOrder);
+                         uint32_t            acquisitionOrder)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadReleaseLockEvent(location, time, attributes, model, lockID, acquisitionOrder);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadReleaseLockEvent(
+            location, time, attributes, model, lockID, acquisitionOrder);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadTaskCreateCb(OTF2_LocationRef    location,
                         OTF2_TimeStamp      time,
@@ -472,8 +1704,34 @@ LocalThreadTaskCreateCb(OTF2_LocationRef    location,
                         OTF2_AttributeList *attributes,
                         OTF2_CommRef        threadTeam,
                         uint32_t            creatingThread,
-                        uint32_t            generationNumber);
+                        uint32_t            generationNumber)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadTaskCreateEvent(
+            location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadTaskCreateEvent(
+            location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadTaskSwitchCb(OTF2_LocationRef    location,
                         OTF2_TimeStamp      time,
@@ -482,8 +1740,34 @@ LocalThreadTaskSwitchCb(OTF2_LocationRef    location,
                         OTF2_AttributeList *attributes,
                         OTF2_CommRef        threadTeam,
                         uint32_t            creatingThread,
-                        uint32_t            generationNumber);
+                        uint32_t            generationNumber)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadTaskSwitchEvent(
+            location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadTaskSwitchEvent(
+            location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadTaskCompleteCb(OTF2_LocationRef    location,
                           OTF2_TimeStamp      time,
@@ -492,8 +1776,34 @@ LocalThreadTaskCompleteCb(OTF2_LocationRef    location,
                           OTF2_AttributeList *attributes,
                           OTF2_CommRef        threadTeam,
                           uint32_t            creatingThread,
-                          uint32_t            generationNumber);
+                          uint32_t            generationNumber)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadTaskCompleteEvent(
+            location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadTaskCompleteEvent(
+            location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadCreateCb(OTF2_LocationRef    location,
                     OTF2_TimeStamp      time,
@@ -501,8 +1811,32 @@ LocalThreadCreateCb(OTF2_LocationRef    location,
                     void *              userData,
                     OTF2_AttributeList *attributes,
                     OTF2_CommRef        threadContingent,
-                    uint64_t            sequenceCount);
+                    uint64_t            sequenceCount)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadCreateEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadCreateEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadBeginCb(OTF2_LocationRef    location,
                    OTF2_TimeStamp      time,
@@ -510,8 +1844,32 @@ LocalThreadBeginCb(OTF2_LocationRef    location,
                    void *              userData,
                    OTF2_AttributeList *attributes,
                    OTF2_CommRef        threadContingent,
-                   uint64_t            sequenceCount);
+                   uint64_t            sequenceCount)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadBeginEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadBeginEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadWaitCb(OTF2_LocationRef    location,
                   OTF2_TimeStamp      time,
@@ -519,8 +1877,32 @@ LocalThreadWaitCb(OTF2_LocationRef    location,
                   void *              userData,
                   OTF2_AttributeList *attributes,
                   OTF2_CommRef        threadContingent,
-                  uint64_t            sequenceCount);
+                  uint64_t            sequenceCount)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadWaitEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadWaitEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalThreadEndCb(OTF2_LocationRef    location,
                  OTF2_TimeStamp      time,
@@ -528,8 +1910,32 @@ LocalThreadEndCb(OTF2_LocationRef    location,
                  void *              userData,
                  OTF2_AttributeList *attributes,
                  OTF2_CommRef        threadContingent,
-                 uint64_t            sequenceCount);
+                 uint64_t            sequenceCount)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleThreadEndEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+    else
+    {
+        tr->handler().Handler::handleThreadEndEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalCallingContextEnterCb(OTF2_LocationRef       location,
                            OTF2_TimeStamp         time,
@@ -537,16 +1943,65 @@ LocalCallingContextEnterCb(OTF2_LocationRef       location,
                            void *                 userData,
                            OTF2_AttributeList *   attributes,
                            OTF2_CallingContextRef callingContext,
-                           uint32_t               unwindDistance);
+                           uint32_t               unwindDistance)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleCallingContextEnterEvent(location, time, attributes, callingContext, unwindDistance);
+    }
+    else
+    {
+        tr->handler().Handler::handleCallingContextEnterEvent(
+            location, time, attributes, callingContext, unwindDistance);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalCallingContextLeaveCb(OTF2_LocationRef       location,
                            OTF2_TimeStamp         time,
                            uint64_t               eventPosition,
                            void *                 userData,
                            OTF2_AttributeList *   attributes,
-                           OTF2_CallingContextRef callingContext);
+                           OTF2_CallingContextRef callingContext)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleCallingContextLeaveEvent(location, time, attributes, callingContext);
+    }
+    else
+    {
+        tr->handler().Handler::handleCallingContextLeaveEvent(location, time, attributes, callingContext);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalCallingContextSampleCb(OTF2_LocationRef           location,
                             OTF2_TimeStamp             time,
@@ -555,8 +2010,34 @@ LocalCallingContextSampleCb(OTF2_LocationRef           location,
                             OTF2_AttributeList *       attributes,
                             OTF2_CallingContextRef     callingContext,
                             uint32_t                   unwindDistance,
-                            OTF2_InterruptGeneratorRef interruptGenerator);
+                            OTF2_InterruptGeneratorRef interruptGenerator)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleCallingContextSampleEvent(
+            location, time, attributes, callingContext, unwindDistance, interruptGenerator);
+    }
+    else
+    {
+        tr->handler().Handler::handleCallingContextSampleEvent(
+            location, time, attributes, callingContext, unwindDistance, interruptGenerator);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoCreateHandleCb(OTF2_LocationRef    location,
                       OTF2_TimeStamp      time,
@@ -566,16 +2047,65 @@ LocalIoCreateHandleCb(OTF2_LocationRef    location,
                       OTF2_IoHandleRef    handle,
                       OTF2_IoAccessMode   mode,
                       OTF2_IoCreationFlag creationFlags,
-                      OTF2_IoStatusFlag   statusFlags);
+                      OTF2_IoStatusFlag   statusFlags)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoCreateHandleEvent(location, time, attributes, handle, mode, creationFlags, statusFlags);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoCreateHandleEvent(
+            location, time, attributes, handle, mode, creationFlags, statusFlags);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoDestroyHandleCb(OTF2_LocationRef    location,
                        OTF2_TimeStamp      time,
                        uint64_t            eventPosition,
                        void *              userData,
                        OTF2_AttributeList *attributes,
-                       OTF2_IoHandleRef    handle);
+                       OTF2_IoHandleRef    handle)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoDestroyHandleEvent(location, time, attributes, handle);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoDestroyHandleEvent(location, time, attributes, handle);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoDuplicateHandleCb(OTF2_LocationRef    location,
                          OTF2_TimeStamp      time,
@@ -584,8 +2114,33 @@ LocalIoDuplicateHandleCb(OTF2_LocationRef    location,
                          OTF2_AttributeList *attributes,
                          OTF2_IoHandleRef    oldHandle,
                          OTF2_IoHandleRef    newHandle,
-                         OTF2_IoStatusFlag   statusFlags);
+                         OTF2_IoStatusFlag   statusFlags)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoDuplicateHandleEvent(location, time, attributes, oldHandle, newHandle, statusFlags);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoDuplicateHandleEvent(
+            location, time, attributes, oldHandle, newHandle, statusFlags);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoSeekCb(OTF2_LocationRef    location,
               OTF2_TimeStamp      time,
@@ -595,8 +2150,33 @@ LocalIoSeekCb(OTF2_LocationRef    location,
               OTF2_IoHandleRef    handle,
               int64_t             offsetRequest,
               OTF2_IoSeekOption   whence,
-              uint64_t            offsetResult);
+              uint64_t            offsetResult)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoSeekEvent(location, time, attributes, handle, offsetRequest, whence, offsetResult);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoSeekEvent(
+            location, time, attributes, handle, offsetRequest, whence, offsetResult);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoChangeStatusFlagsCb(OTF2_LocationRef    location,
                            OTF2_TimeStamp      time,
@@ -604,8 +2184,32 @@ LocalIoChangeStatusFlagsCb(OTF2_LocationRef    location,
                            void *              userData,
                            OTF2_AttributeList *attributes,
                            OTF2_IoHandleRef    handle,
-                           OTF2_IoStatusFlag   statusFlags);
+                           OTF2_IoStatusFlag   statusFlags)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoChangeStatusFlagsEvent(location, time, attributes, handle, statusFlags);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoChangeStatusFlagsEvent(location, time, attributes, handle, statusFlags);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoDeleteFileCb(OTF2_LocationRef    location,
                     OTF2_TimeStamp      time,
@@ -613,8 +2217,32 @@ LocalIoDeleteFileCb(OTF2_LocationRef    location,
                     void *              userData,
                     OTF2_AttributeList *attributes,
                     OTF2_IoParadigmRef  ioParadigm,
-                    OTF2_IoFileRef      file);
+                    OTF2_IoFileRef      file)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoDeleteFileEvent(location, time, attributes, ioParadigm, file);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoDeleteFileEvent(location, time, attributes, ioParadigm, file);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoOperationBeginCb(OTF2_LocationRef     location,
                         OTF2_TimeStamp       time,
@@ -625,8 +2253,42 @@ LocalIoOperationBeginCb(OTF2_LocationRef     location,
                         OTF2_IoOperationMode mode,
                         OTF2_IoOperationFlag operationFlags,
                         uint64_t             bytesRequest,
-                        uint64_t             matchingId);
+                        uint64_t             matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->open_event({EventType::IoOperationBegin,
+                    time,
+                    OTF2_UNDEFINED_REGION,
+                    handle,
+                    mode,
+                    operationFlags,
+                    bytesRequest,
+                    matchingId});
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoOperationBeginEvent(
+            location, time, attributes, handle, mode, operationFlags, bytesRequest, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoOperationBeginEvent(
+            location, time, attributes, handle, mode, operationFlags, bytesRequest, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoOperationTestCb(OTF2_LocationRef    location,
                        OTF2_TimeStamp      time,
@@ -634,8 +2296,32 @@ LocalIoOperationTestCb(OTF2_LocationRef    location,
                        void *              userData,
                        OTF2_AttributeList *attributes,
                        OTF2_IoHandleRef    handle,
-                       uint64_t            matchingId);
+                       uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoOperationTestEvent(location, time, attributes, handle, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoOperationTestEvent(location, time, attributes, handle, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoOperationIssuedCb(OTF2_LocationRef    location,
                          OTF2_TimeStamp      time,
@@ -643,8 +2329,32 @@ LocalIoOperationIssuedCb(OTF2_LocationRef    location,
                          void *              userData,
                          OTF2_AttributeList *attributes,
                          OTF2_IoHandleRef    handle,
-                         uint64_t            matchingId);
+                         uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoOperationIssuedEvent(location, time, attributes, handle, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoOperationIssuedEvent(location, time, attributes, handle, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoOperationCompleteCb(OTF2_LocationRef    location,
                            OTF2_TimeStamp      time,
@@ -653,8 +2363,34 @@ LocalIoOperationCompleteCb(OTF2_LocationRef    location,
                            OTF2_AttributeList *attributes,
                            OTF2_IoHandleRef    handle,
                            uint64_t            bytesResult,
-                           uint64_t            matchingId);
+                           uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->close_event(EventType::IoOperationBegin, handle, matchingId);
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoOperationCompleteEvent(location, time, attributes, handle, bytesResult, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoOperationCompleteEvent(
+            location, time, attributes, handle, bytesResult, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoOperationCancelledCb(OTF2_LocationRef    location,
                             OTF2_TimeStamp      time,
@@ -662,8 +2398,33 @@ LocalIoOperationCancelledCb(OTF2_LocationRef    location,
                             void *              userData,
                             OTF2_AttributeList *attributes,
                             OTF2_IoHandleRef    handle,
-                            uint64_t            matchingId);
+                            uint64_t            matchingId)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+    tr->close_event(EventType::IoOperationBegin, handle, matchingId);
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoOperationCancelledEvent(location, time, attributes, handle, matchingId);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoOperationCancelledEvent(location, time, attributes, handle, matchingId);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoAcquireLockCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
@@ -671,8 +2432,32 @@ LocalIoAcquireLockCb(OTF2_LocationRef    location,
                      void *              userData,
                      OTF2_AttributeList *attributes,
                      OTF2_IoHandleRef    handle,
-                     OTF2_LockType       lockType);
+                     OTF2_LockType       lockType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoAcquireLockEvent(location, time, attributes, handle, lockType);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoAcquireLockEvent(location, time, attributes, handle, lockType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoReleaseLockCb(OTF2_LocationRef    location,
                      OTF2_TimeStamp      time,
@@ -680,8 +2465,32 @@ LocalIoReleaseLockCb(OTF2_LocationRef    location,
                      void *              userData,
                      OTF2_AttributeList *attributes,
                      OTF2_IoHandleRef    handle,
-                     OTF2_LockType       lockType);
+                     OTF2_LockType       lockType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoReleaseLockEvent(location, time, attributes, handle, lockType);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoReleaseLockEvent(location, time, attributes, handle, lockType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalIoTryLockCb(OTF2_LocationRef    location,
                  OTF2_TimeStamp      time,
@@ -689,8 +2498,32 @@ LocalIoTryLockCb(OTF2_LocationRef    location,
                  void *              userData,
                  OTF2_AttributeList *attributes,
                  OTF2_IoHandleRef    handle,
-                 OTF2_LockType       lockType);
+                 OTF2_LockType       lockType)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleIoTryLockEvent(location, time, attributes, handle, lockType);
+    }
+    else
+    {
+        tr->handler().Handler::handleIoTryLockEvent(location, time, attributes, handle, lockType);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalProgramBeginCb(OTF2_LocationRef      location,
                     OTF2_TimeStamp        time,
@@ -699,26 +2532,105 @@ LocalProgramBeginCb(OTF2_LocationRef      location,
                     OTF2_AttributeList *  attributes,
                     OTF2_StringRef        programName,
                     uint32_t              numberOfArguments,
-                    const OTF2_StringRef *programArguments);
+                    const OTF2_StringRef *programArguments)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleProgramBeginEvent(
+            location, time, attributes, programName, numberOfArguments, programArguments);
+    }
+    else
+    {
+        tr->handler().Handler::handleProgramBeginEvent(
+            location, time, attributes, programName, numberOfArguments, programArguments);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
 LocalProgramEndCb(OTF2_LocationRef    location,
                   OTF2_TimeStamp      time,
                   uint64_t            eventPosition,
                   void *              userData,
                   OTF2_AttributeList *attributes,
-                  int64_t             exitStatus);
+                  int64_t             exitStatus)
+{
+    auto *tr = static_cast<LocalReader<Handler> *>(userData);
+    assert(tr != nullptr);
+    if (time > tr->events_end() && !reads_past_end(tr->handler(), location))
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    if (eventPosition >= tr->next_sample())
+    {
+        tr->sample(time, eventPosition);
+    }
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->handler().handleProgramEndEvent(location, time, attributes, exitStatus);
+    }
+    else
+    {
+        tr->handler().Handler::handleProgramEndEvent(location, time, attributes, exitStatus);
+    }
+
+    return OTF2_CALLBACK_SUCCESS;
+}
 
 } // namespace event
 
 namespace definition
 {
 
+template <typename Handler>
 OTF2_CallbackCode
-LocalMappingTableCb(void *userData, OTF2_MappingType mappingType, const OTF2_IdMap *idMap);
+LocalMappingTableCb(void *userData, OTF2_MappingType mappingType, const OTF2_IdMap *idMap)
+{
+    auto * tr            = static_cast<ReaderLocationPair<Handler> *>(userData);
+    size_t self_location = tr->second;
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->first.handler().handleLocalMappingTable(self_location, mappingType, idMap);
+    }
+    else
+    {
+        tr->first.handler().Handler::handleLocalMappingTable(self_location, mappingType, idMap);
+    }
+    return OTF2_CALLBACK_SUCCESS;
+}
 
+template <typename Handler>
 OTF2_CallbackCode
-LocalClockOffsetCb(void *userData, OTF2_TimeStamp time, int64_t offset, double standardDeviation);
+LocalClockOffsetCb(void *userData, OTF2_TimeStamp time, int64_t offset, double standardDeviation)
+{
+    auto * tr            = static_cast<ReaderLocationPair<Handler> *>(userData);
+    size_t self_location = tr->second;
+
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        tr->first.handler().handleLocalClockOffset(self_location, time, offset, standardDeviation);
+    }
+    else
+    {
+        tr->first.handler().Handler::handleLocalClockOffset(self_location, time, offset, standardDeviation);
+    }
+    return OTF2_CALLBACK_SUCCESS;
+}
 
 } // namespace definition
-#endif /* EVENT_CALLBACKS_HPP */
\ No newline at end of file
+#endif /* EVENT_CALLBACKS_HPP */
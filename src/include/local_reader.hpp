@@ -1,27 +1,57 @@
+#ifndef LOCAL_READER_H
+#define LOCAL_READER_H
+
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <vector>
 
+#include <local_callbacks.hpp>
+#include <location_queue.hpp>
 #include <otf2_handler.hpp>
+#include <position_index.hpp>
+#include <trace_stats.hpp>
 
 extern "C"
 {
 #include <otf2/otf2.h>
 }
 
-class LocalReader;
-
-using ReaderLocationPair = std::pair<LocalReader &, size_t>;
-
+/*
+ * Reads the events and local definitions of locations and passes them to a
+ * handler.
+ *
+ * The decoding callbacks are instantiated for the handler type, the calls
+ * of a concrete Handler are bound at compile time. The handler has to be
+ * of exactly that type, see TraceReader. LocalReader<Otf2Handler> accepts
+ * any handler and dispatches virtually.
+ */
+template <typename Handler>
 class LocalReader
 {
   public:
-    LocalReader(Otf2Handler &handler) : m_handler(handler)
+    /*
+     * @param stats statistics the time spent reading is added to, may be
+     *        nullptr
+     * @param positions index the locations are sought in before reading
+     *        them, may be nullptr
+     * @param position_recorder receives samples of the positions of the
+     *        events read, may be nullptr
+     */
+    LocalReader(Handler &              handler,
+                TraceStats *           stats             = nullptr,
+                const PositionIndex *  positions         = nullptr,
+                PositionIndexRecorder *position_recorder = nullptr)
+        : m_handler(handler), m_stats(stats), m_positions(positions), m_position_recorder(position_recorder)
     {
     }
 
+    /*
+     * Read events and local definitions of the locations taken from the queue
+     * until no location is left.
+     */
     void
-    operator()(OTF2_Reader *reader, std::vector<size_t> locations);
+    operator()(OTF2_Reader *reader, LocationQueue &queue, size_t worker);
 
     size_t
     current_location()
@@ -29,19 +59,624 @@ class LocalReader
         return m_current_location;
     }
 
-    Otf2Handler &
+    Handler &
     handler()
     {
         return m_handler;
     }
 
-  private:
+    /*
+     * Events after this time interrupt reading their location, see
+     * Otf2Handler::eventsEnd() and Otf2Handler::readsPastEnd().
+     */
+    inline OTF2_TimeStamp
+    events_end() const
+    {
+        return m_events_end;
+    }
+
+    /*
+     * Position of the next event sampled for the PositionIndexRecorder,
+     * never reached without one.
+     */
+    inline uint64_t
+    next_sample() const
+    {
+        return m_next_sample;
+    }
+
     inline void
-    read_events(OTF2_Reader *reader, const std::vector<size_t> &locations);
+    sample(OTF2_TimeStamp time, uint64_t position)
+    {
+        m_samples.push_back({time, position, m_open});
+        m_next_sample = position + m_position_recorder->interval();
+    }
+
+    /*
+     * Track the events open at the next sample, only while recording.
+     */
+    inline void
+    open_event(const OpenEvent &event)
+    {
+        if (m_position_recorder != nullptr)
+        {
+            m_open.push_back(event);
+        }
+    }
+
+    inline void
+    close_event(EventType opening_type, OTF2_IoHandleRef handle = OTF2_UNDEFINED_IO_HANDLE, uint64_t matching_id = 0)
+    {
+        if (m_position_recorder != nullptr)
+        {
+            auto open = find_open(m_open, opening_type, handle, matching_id);
+            if (open != m_open.end())
+            {
+                m_open.erase(open);
+            }
+        }
+    }
+
+  private:
+    inline std::vector<size_t>
+    read_events(OTF2_Reader *reader, LocationQueue &queue, size_t worker);
 
     inline void
     read_definitions(OTF2_Reader *reader, const std::vector<size_t> &locations);
 
-    Otf2Handler &m_handler;
-    size_t       m_current_location;
-};
\ No newline at end of file
+    /*
+     * Pass the events open at the sought sample to the handler, as if they
+     * were read.
+     */
+    inline void
+    replay_open(OTF2_LocationRef location, const PositionSample &sample);
+
+    Handler &              m_handler;
+    TraceStats *           m_stats;
+    const PositionIndex *  m_positions;
+    PositionIndexRecorder *m_position_recorder;
+    size_t                 m_current_location;
+    OTF2_TimeStamp         m_events_begin = 0;
+    OTF2_TimeStamp         m_events_end   = OTF2_UNDEFINED_TIMESTAMP;
+
+    /*
+     * Samples of the location being read.
+     */
+    std::vector<PositionSample> m_samples;
+    uint64_t                    m_next_sample = std::numeric_limits<uint64_t>::max();
+    std::vector<OpenEvent>      m_open;
+};
+
+template <typename Handler>
+void
+LocalReader<Handler>::replay_open(OTF2_LocationRef location, const PositionSample &sample)
+{
+    for (const auto &event : sample.open)
+    {
+        open_event(event);
+        if (!m_handler.handlesEvent(event.type))
+        {
+            continue;
+        }
+        switch (event.type)
+        {
+            case EventType::Enter:
+                m_handler.handleEnterEvent(location, event.time, nullptr, event.region);
+                break;
+            case EventType::MpiCollectiveBegin:
+                m_handler.handleMpiCollectiveBeginEvent(location, event.time, nullptr);
+                break;
+            case EventType::IoOperationBegin:
+                m_handler.handleIoOperationBeginEvent(location,
+                                                      event.time,
+                                                      nullptr,
+                                                      event.handle,
+                                                      event.mode,
+                                                      event.flags,
+                                                      event.bytes_request,
+                                                      event.matching_id);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+template <typename Handler>
+void
+LocalReader<Handler>::read_definitions(OTF2_Reader *reader, const std::vector<size_t> &locations)
+{
+    bool successful_open_def_files = OTF2_Reader_OpenDefFiles(reader) == OTF2_SUCCESS;
+
+    OTF2_DefReaderCallbacks *def_callbacks = OTF2_DefReaderCallbacks_New();
+
+    OTF2_DefReaderCallbacks_SetMappingTableCallback(def_callbacks, definition::LocalMappingTableCb<Handler>);
+
+    OTF2_DefReaderCallbacks_SetClockOffsetCallback(def_callbacks, definition::LocalClockOffsetCb<Handler>);
+
+    for (auto location : locations)
+    {
+        if (successful_open_def_files)
+        {
+            OTF2_DefReader *def_reader = OTF2_Reader_GetDefReader(reader, location);
+
+            ReaderLocationPair<Handler> reader_location{*this, location};
+            OTF2_Reader_RegisterDefCallbacks(reader, def_reader, def_callbacks, &reader_location);
+            if (def_reader)
+            {
+                uint64_t def_reads = 0;
+                // FIXME Assume to save state is not good
+                // but put all in a pair pointer is also not great
+                m_current_location = location;
+                OTF2_Reader_ReadAllLocalDefinitions(reader, def_reader, &def_reads);
+                OTF2_Reader_CloseDefReader(reader, def_reader);
+            }
+        }
+        m_handler.endLocalDefinitions(location);
+        [[maybe_unused]] OTF2_EvtReader *evt_reader = OTF2_Reader_GetEvtReader(reader, location);
+    }
+    if (successful_open_def_files)
+    {
+        OTF2_Reader_CloseDefFiles(reader);
+    }
+}
+
+template <typename Handler>
+std::vector<size_t>
+LocalReader<Handler>::read_events(OTF2_Reader *reader, LocationQueue &queue, size_t worker)
+{
+    std::vector<size_t> locations;
+
+    OTF2_Reader_OpenEvtFiles(reader);
+    m_events_begin = m_handler.eventsBegin();
+    m_events_end   = m_handler.eventsEnd();
+
+    OTF2_EvtReaderCallbacks *evt_callbacks = OTF2_EvtReaderCallbacks_New();
+
+    if (m_handler.handlesEvent(EventType::BufferFlush))
+    {
+        OTF2_EvtReaderCallbacks_SetBufferFlushCallback(evt_callbacks, event::LocalBufferFlushCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MeasurementOnOff))
+    {
+        OTF2_EvtReaderCallbacks_SetMeasurementOnOffCallback(evt_callbacks, event::LocalMeasurementOnOffCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::Enter))
+    {
+        OTF2_EvtReaderCallbacks_SetEnterCallback(evt_callbacks, event::LocalEnterCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::Leave))
+    {
+        OTF2_EvtReaderCallbacks_SetLeaveCallback(evt_callbacks, event::LocalLeaveCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiSend))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiSendCallback(evt_callbacks, event::LocalMpiSendCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiIsend))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiIsendCallback(evt_callbacks, event::LocalMpiIsendCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiIsendComplete))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiIsendCompleteCallback(evt_callbacks, event::LocalMpiIsendCompleteCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiIrecvRequest))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiIrecvRequestCallback(evt_callbacks, event::LocalMpiIrecvRequestCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiRecv))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiRecvCallback(evt_callbacks, event::LocalMpiRecvCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiIrecv))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiIrecvCallback(evt_callbacks, event::LocalMpiIrecvCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiRequestTest))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiRequestTestCallback(evt_callbacks, event::LocalMpiRequestTestCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiRequestCancelled))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiRequestCancelledCallback(
+            evt_callbacks, event::LocalMpiRequestCancelledCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiCollectiveBegin))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiCollectiveBeginCallback(evt_callbacks, event::LocalMpiCollectiveBeginCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::MpiCollectiveEnd))
+    {
+        OTF2_EvtReaderCallbacks_SetMpiCollectiveEndCallback(evt_callbacks, event::LocalMpiCollectiveEndCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpFork))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpForkCallback(evt_callbacks, event::LocalOmpForkCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpJoin))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpJoinCallback(evt_callbacks, event::LocalOmpJoinCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpAcquireLock))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpAcquireLockCallback(evt_callbacks, event::LocalOmpAcquireLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpReleaseLock))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpReleaseLockCallback(evt_callbacks, event::LocalOmpReleaseLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpTaskCreate))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpTaskCreateCallback(evt_callbacks, event::LocalOmpTaskCreateCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpTaskSwitch))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpTaskSwitchCallback(evt_callbacks, event::LocalOmpTaskSwitchCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::OmpTaskComplete))
+    {
+        OTF2_EvtReaderCallbacks_SetOmpTaskCompleteCallback(evt_callbacks, event::LocalOmpTaskCompleteCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::Metric))
+    {
+        OTF2_EvtReaderCallbacks_SetMetricCallback(evt_callbacks, event::LocalMetricCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ParameterString))
+    {
+        OTF2_EvtReaderCallbacks_SetParameterStringCallback(evt_callbacks, event::LocalParameterStringCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ParameterInt))
+    {
+        OTF2_EvtReaderCallbacks_SetParameterIntCallback(evt_callbacks, event::LocalParameterIntCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ParameterUnsignedInt))
+    {
+        OTF2_EvtReaderCallbacks_SetParameterUnsignedIntCallback(
+            evt_callbacks, event::LocalParameterUnsignedIntCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaWinCreate))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaWinCreateCallback(evt_callbacks, event::LocalRmaWinCreateCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaWinDestroy))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaWinDestroyCallback(evt_callbacks, event::LocalRmaWinDestroyCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaCollectiveBegin))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaCollectiveBeginCallback(evt_callbacks, event::LocalRmaCollectiveBeginCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaCollectiveEnd))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaCollectiveEndCallback(evt_callbacks, event::LocalRmaCollectiveEndCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaGroupSync))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaGroupSyncCallback(evt_callbacks, event::LocalRmaGroupSyncCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaRequestLock))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaRequestLockCallback(evt_callbacks, event::LocalRmaRequestLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaAcquireLock))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaAcquireLockCallback(evt_callbacks, event::LocalRmaAcquireLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaTryLock))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaTryLockCallback(evt_callbacks, event::LocalRmaTryLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaReleaseLock))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaReleaseLockCallback(evt_callbacks, event::LocalRmaReleaseLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaSync))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaSyncCallback(evt_callbacks, event::LocalRmaSyncCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaWaitChange))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaWaitChangeCallback(evt_callbacks, event::LocalRmaWaitChangeCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaPut))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaPutCallback(evt_callbacks, event::LocalRmaPutCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaGet))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaGetCallback(evt_callbacks, event::LocalRmaGetCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaAtomic))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaAtomicCallback(evt_callbacks, event::LocalRmaAtomicCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaOpCompleteBlocking))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaOpCompleteBlockingCallback(
+            evt_callbacks, event::LocalRmaOpCompleteBlockingCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaOpCompleteNonBlocking))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaOpCompleteNonBlockingCallback(
+            evt_callbacks, event::LocalRmaOpCompleteNonBlockingCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaOpTest))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaOpTestCallback(evt_callbacks, event::LocalRmaOpTestCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::RmaOpCompleteRemote))
+    {
+        OTF2_EvtReaderCallbacks_SetRmaOpCompleteRemoteCallback(
+            evt_callbacks, event::LocalRmaOpCompleteRemoteCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadFork))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadForkCallback(evt_callbacks, event::LocalThreadForkCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadJoin))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadJoinCallback(evt_callbacks, event::LocalThreadJoinCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadTeamBegin))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadTeamBeginCallback(evt_callbacks, event::LocalThreadTeamBeginCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadTeamEnd))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadTeamEndCallback(evt_callbacks, event::LocalThreadTeamEndCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadAcquireLock))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadAcquireLockCallback(evt_callbacks, event::LocalThreadAcquireLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadReleaseLock))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadReleaseLockCallback(evt_callbacks, event::LocalThreadReleaseLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadTaskCreate))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadTaskCreateCallback(evt_callbacks, event::LocalThreadTaskCreateCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadTaskSwitch))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadTaskSwitchCallback(evt_callbacks, event::LocalThreadTaskSwitchCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadTaskComplete))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadTaskCompleteCallback(evt_callbacks, event::LocalThreadTaskCompleteCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadCreate))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadCreateCallback(evt_callbacks, event::LocalThreadCreateCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadBegin))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadBeginCallback(evt_callbacks, event::LocalThreadBeginCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadWait))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadWaitCallback(evt_callbacks, event::LocalThreadWaitCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ThreadEnd))
+    {
+        OTF2_EvtReaderCallbacks_SetThreadEndCallback(evt_callbacks, event::LocalThreadEndCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::CallingContextEnter))
+    {
+        OTF2_EvtReaderCallbacks_SetCallingContextEnterCallback(
+            evt_callbacks, event::LocalCallingContextEnterCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::CallingContextLeave))
+    {
+        OTF2_EvtReaderCallbacks_SetCallingContextLeaveCallback(
+            evt_callbacks, event::LocalCallingContextLeaveCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::CallingContextSample))
+    {
+        OTF2_EvtReaderCallbacks_SetCallingContextSampleCallback(
+            evt_callbacks, event::LocalCallingContextSampleCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoCreateHandle))
+    {
+        OTF2_EvtReaderCallbacks_SetIoCreateHandleCallback(evt_callbacks, event::LocalIoCreateHandleCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoDestroyHandle))
+    {
+        OTF2_EvtReaderCallbacks_SetIoDestroyHandleCallback(evt_callbacks, event::LocalIoDestroyHandleCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoDuplicateHandle))
+    {
+        OTF2_EvtReaderCallbacks_SetIoDuplicateHandleCallback(evt_callbacks, event::LocalIoDuplicateHandleCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoSeek))
+    {
+        OTF2_EvtReaderCallbacks_SetIoSeekCallback(evt_callbacks, event::LocalIoSeekCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoChangeStatusFlags))
+    {
+        OTF2_EvtReaderCallbacks_SetIoChangeStatusFlagsCallback(
+            evt_callbacks, event::LocalIoChangeStatusFlagsCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoDeleteFile))
+    {
+        OTF2_EvtReaderCallbacks_SetIoDeleteFileCallback(evt_callbacks, event::LocalIoDeleteFileCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoOperationBegin))
+    {
+        OTF2_EvtReaderCallbacks_SetIoOperationBeginCallback(evt_callbacks, event::LocalIoOperationBeginCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoOperationTest))
+    {
+        OTF2_EvtReaderCallbacks_SetIoOperationTestCallback(evt_callbacks, event::LocalIoOperationTestCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoOperationIssued))
+    {
+        OTF2_EvtReaderCallbacks_SetIoOperationIssuedCallback(evt_callbacks, event::LocalIoOperationIssuedCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoOperationComplete))
+    {
+        OTF2_EvtReaderCallbacks_SetIoOperationCompleteCallback(
+            evt_callbacks, event::LocalIoOperationCompleteCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoOperationCancelled))
+    {
+        OTF2_EvtReaderCallbacks_SetIoOperationCancelledCallback(
+            evt_callbacks, event::LocalIoOperationCancelledCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoAcquireLock))
+    {
+        OTF2_EvtReaderCallbacks_SetIoAcquireLockCallback(evt_callbacks, event::LocalIoAcquireLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoReleaseLock))
+    {
+        OTF2_EvtReaderCallbacks_SetIoReleaseLockCallback(evt_callbacks, event::LocalIoReleaseLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::IoTryLock))
+    {
+        OTF2_EvtReaderCallbacks_SetIoTryLockCallback(evt_callbacks, event::LocalIoTryLockCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ProgramBegin))
+    {
+        OTF2_EvtReaderCallbacks_SetProgramBeginCallback(evt_callbacks, event::LocalProgramBeginCb<Handler>);
+    }
+
+    if (m_handler.handlesEvent(EventType::ProgramEnd))
+    {
+        OTF2_EvtReaderCallbacks_SetProgramEndCallback(evt_callbacks, event::LocalProgramEndCb<Handler>);
+    }
+
+    OTF2_LocationRef location;
+    while (queue.pop(worker, location))
+    {
+        locations.push_back(location);
+
+        OTF2_EvtReader *evt_reader = OTF2_Reader_GetEvtReader(reader, location);
+        OTF2_Reader_RegisterEvtCallbacks(reader, evt_reader, evt_callbacks, this);
+        if (evt_reader)
+        {
+            m_handler.beginLocation(location);
+
+            if (m_position_recorder != nullptr)
+            {
+                m_samples.clear();
+                m_open.clear();
+                m_next_sample = 0;
+            }
+            const PositionSample *sample =
+                m_positions != nullptr ? m_positions->seek_sample(location, m_events_begin) : nullptr;
+            if (sample != nullptr)
+            {
+                OTF2_EvtReader_Seek(evt_reader, sample->position);
+                replay_open(location, *sample);
+            }
+
+            uint64_t events_read;
+            OTF2_Reader_ReadAllLocalEvents(reader, evt_reader, &events_read);
+
+            if (m_position_recorder != nullptr)
+            {
+                m_position_recorder->add(location, std::move(m_samples));
+            }
+            m_handler.endLocation(location);
+
+            OTF2_Reader_CloseEvtReader(reader, evt_reader);
+        }
+    }
+    OTF2_EvtReaderCallbacks_Delete(evt_callbacks);
+    OTF2_Reader_CloseEvtFiles(reader);
+
+    return locations;
+}
+
+template <typename Handler>
+void
+LocalReader<Handler>::operator()(OTF2_Reader *reader, LocationQueue &queue, size_t worker)
+{
+    std::vector<size_t> locations;
+    {
+        PhaseTimer timer(m_stats, Phase::Events);
+        locations = read_events(reader, queue, worker);
+    }
+
+    if (!locations.empty())
+    {
+        PhaseTimer timer(m_stats, Phase::LocalDefinitions);
+        read_definitions(reader, locations);
+    }
+}
+
+#endif /* LOCAL_READER_H */
@@ -0,0 +1,78 @@
+#ifndef LOCATION_QUEUE_H
+#define LOCATION_QUEUE_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <location_scheduler.hpp>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+/*
+ * Locations shared by the event reading workers.
+ *
+ * Every worker owns a deque which is seeded with its part of the schedule.
+ * A worker takes locations from the front of its own deque, and once that
+ * is empty it steals from the back of the other deques, so workers which
+ * finish early take over the remaining locations instead of idling.
+ */
+class LocationQueue
+{
+  public:
+    /*
+     * @param schedule initial locations per worker, empty lists get no worker
+     */
+    explicit LocationQueue(const LocationSchedule &schedule);
+
+    /*
+     * Take the next location for a worker.
+     *
+     * @param worker index of the calling worker
+     * @param location set to the taken location
+     * @return false if no location is left in any deque
+     */
+    bool
+    pop(std::size_t worker, OTF2_LocationRef &location);
+
+    /*
+     * Call a function with every location taken, e.g. to prefetch the files
+     * of the following locations. Set it before the workers start.
+     */
+    void
+    set_observer(std::function<void(OTF2_LocationRef)> observer)
+    {
+        m_observer = std::move(observer);
+    }
+
+    /*
+     * Number of workers, i.e. number of non empty lists in the schedule.
+     */
+    std::size_t
+    workers() const
+    {
+        return m_queues.size();
+    }
+
+  private:
+    struct WorkerQueue
+    {
+        std::mutex                   mutex;
+        std::deque<OTF2_LocationRef> locations;
+    };
+
+    bool
+    steal(std::size_t worker, OTF2_LocationRef &location);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::function<void(OTF2_LocationRef)>     m_observer;
+};
+
+#endif /* LOCATION_QUEUE_H */
@@ -0,0 +1,41 @@
+#ifndef LOCATION_SCHEDULER_H
+#define LOCATION_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+/*
+ * A location together with the number of events announced
+ * by its global definition.
+ */
+struct LocationWeight
+{
+    OTF2_LocationRef location;
+    uint64_t         number_of_events;
+};
+
+using LocationSchedule = std::vector<std::vector<OTF2_LocationRef>>;
+
+/*
+ * Distribute locations over threads by their number of events.
+ *
+ * Locations are assigned largest first to the thread with the least
+ * events so far (longest processing time first), so the busiest thread
+ * ends up with roughly total events / threads instead of whatever the
+ * heaviest ranks add up to. Every location costs at least one unit,
+ * which spreads locations without events evenly as well.
+ *
+ * @param locations locations and their number of events
+ * @param nthreads number of threads, always at least one list is returned
+ * @return one list of locations per thread, heaviest location first
+ */
+LocationSchedule
+schedule_locations(const std::vector<LocationWeight> &locations, std::size_t nthreads);
+
+#endif /* LOCATION_SCHEDULER_H */
@@ -0,0 +1,56 @@
+#ifndef OPEN_EVENTS_H
+#define OPEN_EVENTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <otf2_handler.hpp>
+
+/*
+ * Event opening a region, an MPI collective or an I/O operation, closed by
+ * a later event of the same location: an Enter by a Leave, an
+ * MpiCollectiveBegin by an MpiCollectiveEnd and an IoOperationBegin by an
+ * IoOperationComplete or IoOperationCancelled.
+ */
+struct OpenEvent
+{
+    EventType            type;
+    OTF2_TimeStamp       time          = 0;
+    OTF2_RegionRef       region        = OTF2_UNDEFINED_REGION;
+    OTF2_IoHandleRef     handle        = OTF2_UNDEFINED_IO_HANDLE;
+    OTF2_IoOperationMode mode          = OTF2_IO_OPERATION_MODE_READ;
+    OTF2_IoOperationFlag flags         = OTF2_IO_OPERATION_FLAG_NONE;
+    uint64_t             bytes_request = 0;
+    uint64_t             matching_id   = 0;
+};
+
+/*
+ * Last open event of the type, I/O operations are matched by their handle
+ * and matching id.
+ *
+ * @param open events in the order they were opened, of OpenEvent or a type
+ *        derived from it
+ * @return open.end() if no event matches
+ */
+template <typename Event>
+typename std::vector<Event>::iterator
+find_open(std::vector<Event> &open,
+          EventType           type,
+          OTF2_IoHandleRef    handle      = OTF2_UNDEFINED_IO_HANDLE,
+          uint64_t            matching_id = 0)
+{
+    auto search = std::find_if(open.rbegin(), open.rend(), [&](const OpenEvent &event) {
+        return event.type == type &&
+               (type != EventType::IoOperationBegin || (event.handle == handle && event.matching_id == matching_id));
+    });
+    return search == open.rend() ? open.end() : std::prev(search.base());
+}
+
+#endif /* OPEN_EVENTS_H */
@@ -0,0 +1,19 @@
+#ifndef OTF2_LOCKING_H
+#define OTF2_LOCKING_H
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+/*
+ * Register std::mutex based OTF2 locking callbacks, so the internal state of
+ * an archive or reader can be shared by several threads.
+ */
+OTF2_ErrorCode
+set_locking_callbacks(OTF2_Archive *archive);
+
+OTF2_ErrorCode
+set_locking_callbacks(OTF2_Reader *reader);
+
+#endif /* OTF2_LOCKING_H */
@@ -0,0 +1,152 @@
+#ifndef POSITION_INDEX_H
+#define POSITION_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <open_events.hpp>
+
+/*
+ * Time and position of an event within its location, positions count from
+ * 1 like the eventPosition passed to the event callbacks.
+ *
+ * The events opened before the sampled one and not closed yet are kept
+ * with it. A reader seeking to the sample passes them to the handler
+ * first, the events closing them are then handled as without seeking.
+ */
+struct PositionSample
+{
+    OTF2_TimeStamp         time;
+    uint64_t               position;
+    std::vector<OpenEvent> open;
+};
+
+/*
+ * Samples of the event positions of one location, ordered by position.
+ */
+struct LocationPositions
+{
+    /*
+     * Size of the event file the samples were recorded from, a location
+     * whose file changed since is not trusted.
+     */
+    uint64_t                    event_file_size = 0;
+    std::vector<PositionSample> samples;
+};
+
+/*
+ * Sparse index from times to event positions of the locations of a trace,
+ * stored in a file next to the trace.
+ *
+ * A reader given the index seeks every location to the last sampled event
+ * before Otf2Handler::eventsBegin() with OTF2_EvtReader_Seek(), the events
+ * before a time window are not decoded. The index is recorded while the
+ * trace is read once, see PositionIndexRecorder.
+ */
+class PositionIndex
+{
+  public:
+    /*
+     * @param trace anchor file of the trace
+     * @return path of the position index of the trace
+     */
+    static std::filesystem::path
+    path_of(const std::filesystem::path &trace);
+
+    /*
+     * Read the index of a trace. Locations whose event file changed since
+     * the index was written are left out.
+     *
+     * @param trace anchor file of the trace
+     * @throws std::runtime_error if the index cannot be read
+     */
+    static PositionIndex
+    read(const std::filesystem::path &index, const std::filesystem::path &trace);
+
+    /*
+     * @throws std::runtime_error if the index cannot be written
+     */
+    void
+    write(const std::filesystem::path &index) const;
+
+    void
+    add(OTF2_LocationRef location, LocationPositions positions);
+
+    /*
+     * Every event of the location at or after the time is at or after the
+     * returned position, events of a location are ordered by time.
+     *
+     * @return position to seek the location to, 0 to read it from its start
+     */
+    uint64_t
+    seek_position(OTF2_LocationRef location, OTF2_TimeStamp time) const;
+
+    /*
+     * Sample to seek the location to, see seek_position().
+     *
+     * @return nullptr to read the location from its start
+     */
+    const PositionSample *
+    seek_sample(OTF2_LocationRef location, OTF2_TimeStamp time) const;
+
+    inline std::size_t
+    size() const
+    {
+        return m_locations.size();
+    }
+
+  private:
+    std::unordered_map<OTF2_LocationRef, LocationPositions> m_locations;
+};
+
+/*
+ * Collects the samples of the locations read by all workers, see
+ * TraceReaderOptions::position_recorder.
+ */
+class PositionIndexRecorder
+{
+  public:
+    static constexpr uint64_t default_interval = 16384;
+
+    /*
+     * @param trace anchor file of the recorded trace
+     * @param interval minimal number of events between two samples
+     */
+    explicit PositionIndexRecorder(const std::filesystem::path &trace, uint64_t interval = default_interval);
+
+    inline uint64_t
+    interval() const
+    {
+        return m_interval;
+    }
+
+    /*
+     * Called by the worker that read the location, thread safe.
+     */
+    void
+    add(OTF2_LocationRef location, std::vector<PositionSample> samples);
+
+    /*
+     * @return samples of all locations recorded so far
+     */
+    PositionIndex
+    index() const;
+
+  private:
+    std::filesystem::path m_trace;
+    uint64_t              m_interval;
+
+    mutable std::mutex                                                m_mutex;
+    std::unordered_map<OTF2_LocationRef, std::vector<PositionSample>> m_samples;
+};
+
+#endif /* POSITION_INDEX_H */
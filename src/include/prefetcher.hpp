@@ -0,0 +1,75 @@
+#ifndef PREFETCHER_H
+#define PREFETCHER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include <otf2/otf2.h>
+}
+
+#include <location_scheduler.hpp>
+
+/*
+ * Asks the kernel to read the event and definition files of locations
+ * before the workers open them, so the latency of the first read overlaps
+ * with decoding the previous locations.
+ *
+ * A background thread advises the files with posix_fadvise(WILLNEED) in
+ * the order the workers are expected to take the locations: the first
+ * location of every worker, then the second and so on. It stays at most a
+ * given number of locations ahead of the locations taken so far, the page
+ * cache is not flooded with files read much later.
+ */
+class Prefetcher
+{
+  public:
+    using AdviseFunction = std::function<void(const std::filesystem::path &)>;
+
+    /*
+     * @param directory folder of the event and definition files
+     * @param schedule locations of each worker in the order they are read
+     * @param distance number of locations advised ahead of the workers
+     * @param advise called on the prefetch thread for every file, empty to
+     *        advise the files to the kernel
+     */
+    Prefetcher(const std::filesystem::path &directory,
+               const LocationSchedule &     schedule,
+               std::size_t                  distance,
+               AdviseFunction               advise = {});
+    ~Prefetcher();
+
+    Prefetcher(const Prefetcher &) = delete;
+    Prefetcher &
+    operator=(const Prefetcher &) = delete;
+
+    /*
+     * Called whenever a worker takes a location.
+     */
+    void
+    advance();
+
+  private:
+    void
+    run();
+
+    std::filesystem::path         m_directory;
+    std::vector<OTF2_LocationRef> m_order;
+    std::size_t                   m_distance;
+    AdviseFunction                m_advise;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_condition;
+    std::size_t             m_taken   = 0;
+    std::size_t             m_advised = 0;
+    bool                    m_stop    = false;
+    std::thread             m_thread;
+};
+
+#endif /* PREFETCHER_H */
@@ -0,0 +1,2018 @@
+#ifndef STATIC_TRACE_WRITER_H
+#define STATIC_TRACE_WRITER_H
+
+#include <string>
+#include <utility>
+
+#include <filter.hpp>
+#include <trace_writer.hpp>
+
+/*
+ * Trace writer with a filter chain composed at compile time.
+ *
+ * The filters are passed as template parameters, see StaticFilter for the
+ * interface a filter has to provide. Filters can be held by value or, by
+ * passing a reference type, refer to an object owned by the caller.
+ * Records no filter is interested in are written directly.
+ *
+ * Filters registered at runtime are not supported, use TraceWriter for
+ * these. As with registered filters, definitions of dropped locations are
+ * left out and the clock properties shrunk to the time window of the
+ * filters with a time_window() member, see StaticFilter::time_window().
+ */
+template <typename... Filters>
+class StaticTraceWriter : public TraceWriter
+{
+  public:
+    /*
+     * @param path specify the folder of trace to be written
+     * @param filters filters applied to every record in the given order
+     */
+    StaticTraceWriter(const std::string &path, Filters... filters)
+        : TraceWriter(path), m_filters(std::forward<Filters>(filters)...)
+    {
+        restrict_time_window(m_filters.time_window());
+    }
+
+    /*
+     * @param options compression and chunk sizes of the archive
+     */
+    StaticTraceWriter(const std::string &path, const TraceWriterOptions &options, Filters... filters)
+        : TraceWriter(path, options), m_filters(std::forward<Filters>(filters)...)
+    {
+        restrict_time_window(m_filters.time_window());
+    }
+
+    void
+    register_filter(IFilterCallbacks &filter, int priority = 0) = delete;
+
+    /*
+     * Definitions handled by one of the filters are read before the events.
+     */
+    virtual bool
+    eventsDependOn(GlobalDefinition definition) override
+    {
+        switch (definition)
+        {
+        case GlobalDefinition::ClockProperties:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalClockProperties, GlobalClockPropertiesFilter>;
+        case GlobalDefinition::Paradigm:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalParadigm, GlobalParadigmFilter>;
+        case GlobalDefinition::ParadigmProperty:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalParadigmProperty, GlobalParadigmPropertyFilter>;
+        case GlobalDefinition::IoParadigm:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalIoParadigm, GlobalIoParadigmFilter>;
+        case GlobalDefinition::String:
+            return TraceWriter::eventsDependOn(definition) || filters_handle<record::GlobalString, GlobalStringFilter>;
+        case GlobalDefinition::Attribute:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalAttribute, GlobalAttributeFilter>;
+        case GlobalDefinition::SystemTreeNode:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalSystemTreeNode, GlobalSystemTreeNodeFilter>;
+        case GlobalDefinition::LocationGroup:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalLocationGroup, GlobalLocationGroupFilter>;
+        case GlobalDefinition::Location:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalLocation, GlobalLocationFilter>;
+        case GlobalDefinition::Region:
+            return TraceWriter::eventsDependOn(definition) || filters_handle<record::GlobalRegion, GlobalRegionFilter>;
+        case GlobalDefinition::Callsite:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCallsite, GlobalCallsiteFilter>;
+        case GlobalDefinition::Callpath:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCallpath, GlobalCallpathFilter>;
+        case GlobalDefinition::Group:
+            return TraceWriter::eventsDependOn(definition) || filters_handle<record::GlobalGroup, GlobalGroupFilter>;
+        case GlobalDefinition::MetricMember:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalMetricMember, GlobalMetricMemberFilter>;
+        case GlobalDefinition::MetricClass:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalMetricClass, GlobalMetricClassFilter>;
+        case GlobalDefinition::MetricInstance:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalMetricInstance, GlobalMetricInstanceFilter>;
+        case GlobalDefinition::Comm:
+            return TraceWriter::eventsDependOn(definition) || filters_handle<record::GlobalComm, GlobalCommFilter>;
+        case GlobalDefinition::Parameter:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalParameter, GlobalParameterFilter>;
+        case GlobalDefinition::RmaWin:
+            return TraceWriter::eventsDependOn(definition) || filters_handle<record::GlobalRmaWin, GlobalRmaWinFilter>;
+        case GlobalDefinition::MetricClassRecorder:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalMetricClassRecorder, GlobalMetricClassRecorderFilter>;
+        case GlobalDefinition::SystemTreeNodeProperty:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalSystemTreeNodeProperty, GlobalSystemTreeNodePropertyFilter>;
+        case GlobalDefinition::SystemTreeNodeDomain:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalSystemTreeNodeDomain, GlobalSystemTreeNodeDomainFilter>;
+        case GlobalDefinition::LocationGroupProperty:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalLocationGroupProperty, GlobalLocationGroupPropertyFilter>;
+        case GlobalDefinition::LocationProperty:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalLocationProperty, GlobalLocationPropertyFilter>;
+        case GlobalDefinition::CartDimension:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCartDimension, GlobalCartDimensionFilter>;
+        case GlobalDefinition::CartTopology:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCartTopology, GlobalCartTopologyFilter>;
+        case GlobalDefinition::CartCoordinate:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCartCoordinate, GlobalCartCoordinateFilter>;
+        case GlobalDefinition::SourceCodeLocation:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalSourceCodeLocation, GlobalSourceCodeLocationFilter>;
+        case GlobalDefinition::CallingContext:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCallingContext, GlobalCallingContextFilter>;
+        case GlobalDefinition::CallingContextProperty:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCallingContextProperty, GlobalCallingContextPropertyFilter>;
+        case GlobalDefinition::InterruptGenerator:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalInterruptGenerator, GlobalInterruptGeneratorFilter>;
+        case GlobalDefinition::IoFileProperty:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalIoFileProperty, GlobalIoFilePropertyFilter>;
+        case GlobalDefinition::IoRegularFile:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalIoRegularFile, GlobalIoRegularFileFilter>;
+        case GlobalDefinition::IoDirectory:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalIoDirectory, GlobalIoDirectoryFilter>;
+        case GlobalDefinition::IoHandle:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalIoHandle, GlobalIoHandleFilter>;
+        case GlobalDefinition::IoPreCreatedHandleState:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalIoPreCreatedHandleState, GlobalIoPreCreatedHandleStateFilter>;
+        case GlobalDefinition::CallpathParameter:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::GlobalCallpathParameter, GlobalCallpathParameterFilter>;
+        }
+        return true;
+    }
+
+    /*
+     * Static filters cannot tell which locations they affect, locations are
+     * only copied if no filter handles events.
+     */
+    virtual bool
+    filters_location(OTF2_LocationRef location) override
+    {
+        return filters_events || TraceWriter::filters_location(location);
+    }
+
+    /*
+     * Handle global definitions
+     */
+
+    virtual void
+    handleGlobalClockProperties(uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength) override
+    {
+        if (!m_filters.process(record::GlobalClockProperties{}, timerResolution, globalOffset, traceLength))
+        {
+            writeGlobalClockProperties(timerResolution, globalOffset, traceLength);
+        }
+    }
+
+    virtual void
+    handleGlobalParadigm(OTF2_Paradigm paradigm, OTF2_StringRef name, OTF2_ParadigmClass paradigmClass) override
+    {
+        if (!m_filters.process(record::GlobalParadigm{}, paradigm, name, paradigmClass))
+        {
+            writeGlobalParadigm(paradigm, name, paradigmClass);
+        }
+    }
+
+    virtual void
+    handleGlobalParadigmProperty(OTF2_Paradigm         paradigm,
+                                 OTF2_ParadigmProperty property,
+                                 OTF2_Type             type,
+                                 OTF2_AttributeValue   value) override
+    {
+        if (!m_filters.process(record::GlobalParadigmProperty{}, paradigm, property, type, value))
+        {
+            writeGlobalParadigmProperty(paradigm, property, type, value);
+        }
+    }
+
+    virtual void
+    handleGlobalIoParadigm(OTF2_IoParadigmRef             self,
+                           OTF2_StringRef                 identification,
+                           OTF2_StringRef                 name,
+                           OTF2_IoParadigmClass           ioParadigmClass,
+                           OTF2_IoParadigmFlag            ioParadigmFlags,
+                           uint8_t                        numberOfProperties,
+                           const OTF2_IoParadigmProperty *properties,
+                           const OTF2_Type *              types,
+                           const OTF2_AttributeValue *    values) override
+    {
+        if (!m_filters.process(record::GlobalIoParadigm{},
+                               self,
+                               identification,
+                               name,
+                               ioParadigmClass,
+                               ioParadigmFlags,
+                               numberOfProperties,
+                               properties,
+                               types,
+                               values))
+        {
+            writeGlobalIoParadigm(self,
+                                  identification,
+                                  name,
+                                  ioParadigmClass,
+                                  ioParadigmFlags,
+                                  numberOfProperties,
+                                  properties,
+                                  types,
+                                  values);
+        }
+    }
+
+    virtual void
+    handleGlobalString(OTF2_StringRef self, const char *string) override
+    {
+        string_table().add(self, string);
+
+        if (!m_filters.process(record::GlobalString{}, self, string))
+        {
+            writeGlobalString(self, string);
+        }
+    }
+
+    virtual void
+    handleGlobalAttribute(OTF2_AttributeRef self,
+                          OTF2_StringRef    name,
+                          OTF2_StringRef    description,
+                          OTF2_Type         type) override
+    {
+        if (!m_filters.process(record::GlobalAttribute{}, self, name, description, type))
+        {
+            writeGlobalAttribute(self, name, description, type);
+        }
+    }
+
+    virtual void
+    handleGlobalSystemTreeNode(OTF2_SystemTreeNodeRef self,
+                               OTF2_StringRef         name,
+                               OTF2_StringRef         className,
+                               OTF2_SystemTreeNodeRef parent) override
+    {
+        if (!m_filters.process(record::GlobalSystemTreeNode{}, self, name, className, parent))
+        {
+            writeGlobalSystemTreeNode(self, name, className, parent);
+        }
+    }
+
+    virtual void
+    handleGlobalLocationGroup(OTF2_LocationGroupRef  self,
+                              OTF2_StringRef         name,
+                              OTF2_LocationGroupType locationGroupType,
+                              OTF2_SystemTreeNodeRef systemTreeParent) override
+    {
+        if (!m_filters.process(record::GlobalLocationGroup{}, self, name, locationGroupType, systemTreeParent))
+        {
+            writeGlobalLocationGroup(self, name, locationGroupType, systemTreeParent);
+        }
+    }
+
+    virtual void
+    handleGlobalLocation(OTF2_LocationRef      self,
+                         OTF2_StringRef        name,
+                         OTF2_LocationType     locationType,
+                         uint64_t              numberOfEvents,
+                         OTF2_LocationGroupRef locationGroup) override
+    {
+
+        if (!m_filters.process(record::GlobalLocation{}, self, name, locationType, numberOfEvents, locationGroup))
+        {
+            writeGlobalLocation(self, name, locationType, numberOfEvents, locationGroup);
+        }
+        else
+        {
+            drop_location(self);
+        }
+    }
+
+    virtual void
+    handleGlobalRegion(OTF2_RegionRef  self,
+                       OTF2_StringRef  name,
+                       OTF2_StringRef  canonicalName,
+                       OTF2_StringRef  description,
+                       OTF2_RegionRole regionRole,
+                       OTF2_Paradigm   paradigm,
+                       OTF2_RegionFlag regionFlags,
+                       OTF2_StringRef  sourceFile,
+                       uint32_t        beginLineNumber,
+                       uint32_t        endLineNumber) override
+    {
+        if (!m_filters.process(record::GlobalRegion{},
+                               self,
+                               name,
+                               canonicalName,
+                               description,
+                               regionRole,
+                               paradigm,
+                               regionFlags,
+                               sourceFile,
+                               beginLineNumber,
+                               endLineNumber))
+        {
+            writeGlobalRegion(self,
+                              name,
+                              canonicalName,
+                              description,
+                              regionRole,
+                              paradigm,
+                              regionFlags,
+                              sourceFile,
+                              beginLineNumber,
+                              endLineNumber);
+        }
+    }
+
+    virtual void
+    handleGlobalCallsite(OTF2_CallsiteRef self,
+                         OTF2_StringRef   sourceFile,
+                         uint32_t         lineNumber,
+                         OTF2_RegionRef   enteredRegion,
+                         OTF2_RegionRef   leftRegion) override
+    {
+        if (!m_filters.process(record::GlobalCallsite{}, self, sourceFile, lineNumber, enteredRegion, leftRegion))
+        {
+            writeGlobalCallsite(self, sourceFile, lineNumber, enteredRegion, leftRegion);
+        }
+    }
+
+    virtual void
+    handleGlobalCallpath(OTF2_CallpathRef self, OTF2_CallpathRef parent, OTF2_RegionRef region) override
+    {
+        if (!m_filters.process(record::GlobalCallpath{}, self, parent, region))
+        {
+            writeGlobalCallpath(self, parent, region);
+        }
+    }
+
+    virtual void
+    handleGlobalGroup(OTF2_GroupRef   self,
+                      OTF2_StringRef  name,
+                      OTF2_GroupType  groupType,
+                      OTF2_Paradigm   paradigm,
+                      OTF2_GroupFlag  groupFlags,
+                      uint32_t        numberOfMembers,
+                      const uint64_t *members) override
+    {
+        if (!m_filters.process(record::GlobalGroup{},
+                               self,
+                               name,
+                               groupType,
+                               paradigm,
+                               groupFlags,
+                               numberOfMembers,
+                               members))
+        {
+            writeGlobalGroup(self, name, groupType, paradigm, groupFlags, numberOfMembers, members);
+        }
+    }
+
+    virtual void
+    handleGlobalMetricMember(OTF2_MetricMemberRef self,
+                             OTF2_StringRef       name,
+                             OTF2_StringRef       description,
+                             OTF2_MetricType      metricType,
+                             OTF2_MetricMode      metricMode,
+                             OTF2_Type            valueType,
+                             OTF2_Base            base,
+                             int64_t              exponent,
+                             OTF2_StringRef       unit) override
+    {
+        if (!m_filters.process(record::GlobalMetricMember{},
+                               self,
+                               name,
+                               description,
+                               metricType,
+                               metricMode,
+                               valueType,
+                               base,
+                               exponent,
+                               unit))
+        {
+            writeGlobalMetricMember(self, name, description, metricType, metricMode, valueType, base, exponent, unit);
+        }
+    }
+
+    virtual void
+    handleGlobalMetricClass(OTF2_MetricRef              self,
+                            uint8_t                     numberOfMetrics,
+                            const OTF2_MetricMemberRef *metricMembers,
+                            OTF2_MetricOccurrence       metricOccurrence,
+                            OTF2_RecorderKind           recorderKind) override
+    {
+        if (!m_filters.process(record::GlobalMetricClass{},
+                               self,
+                               numberOfMetrics,
+                               metricMembers,
+                               metricOccurrence,
+                               recorderKind))
+        {
+            writeGlobalMetricClass(self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind);
+        }
+    }
+
+    virtual void
+    handleGlobalMetricInstance(OTF2_MetricRef   self,
+                               OTF2_MetricRef   metricClass,
+                               OTF2_LocationRef recorder,
+                               OTF2_MetricScope metricScope,
+                               uint64_t         scope) override
+    {
+        if (!m_filters.process(record::GlobalMetricInstance{}, self, metricClass, recorder, metricScope, scope))
+        {
+            writeGlobalMetricInstance(self, metricClass, recorder, metricScope, scope);
+        }
+    }
+
+    virtual void
+    handleGlobalComm(OTF2_CommRef self, OTF2_StringRef name, OTF2_GroupRef group, OTF2_CommRef parent) override
+    {
+        if (!m_filters.process(record::GlobalComm{}, self, name, group, parent))
+        {
+            writeGlobalComm(self, name, group, parent);
+        }
+    }
+
+    virtual void
+    handleGlobalParameter(OTF2_ParameterRef self, OTF2_StringRef name, OTF2_ParameterType parameterType) override
+    {
+        if (!m_filters.process(record::GlobalParameter{}, self, name, parameterType))
+        {
+            writeGlobalParameter(self, name, parameterType);
+        }
+    }
+
+    virtual void
+    handleGlobalRmaWin(OTF2_RmaWinRef self, OTF2_StringRef name, OTF2_CommRef comm) override
+    {
+        if (!m_filters.process(record::GlobalRmaWin{}, self, name, comm))
+        {
+            writeGlobalRmaWin(self, name, comm);
+        }
+    }
+
+    virtual void
+    handleGlobalMetricClassRecorder(OTF2_MetricRef metric, OTF2_LocationRef recorder) override
+    {
+        if (!m_filters.process(record::GlobalMetricClassRecorder{}, metric, recorder))
+        {
+            writeGlobalMetricClassRecorder(metric, recorder);
+        }
+    }
+
+    virtual void
+    handleGlobalSystemTreeNodeProperty(OTF2_SystemTreeNodeRef systemTreeNode,
+                                       OTF2_StringRef         name,
+                                       OTF2_Type              type,
+                                       OTF2_AttributeValue    value) override
+    {
+        if (!m_filters.process(record::GlobalSystemTreeNodeProperty{}, systemTreeNode, name, type, value))
+        {
+            writeGlobalSystemTreeNodeProperty(systemTreeNode, name, type, value);
+        }
+    }
+
+    virtual void
+    handleGlobalSystemTreeNodeDomain(OTF2_SystemTreeNodeRef systemTreeNode,
+                                     OTF2_SystemTreeDomain  systemTreeDomain) override
+    {
+        if (!m_filters.process(record::GlobalSystemTreeNodeDomain{}, systemTreeNode, systemTreeDomain))
+        {
+            writeGlobalSystemTreeNodeDomain(systemTreeNode, systemTreeDomain);
+        }
+    }
+
+    virtual void
+    handleGlobalLocationGroupProperty(OTF2_LocationGroupRef locationGroup,
+                                      OTF2_StringRef        name,
+                                      OTF2_Type             type,
+                                      OTF2_AttributeValue   value) override
+    {
+        if (!m_filters.process(record::GlobalLocationGroupProperty{}, locationGroup, name, type, value))
+        {
+            writeGlobalLocationGroupProperty(locationGroup, name, type, value);
+        }
+    }
+
+    virtual void
+    handleGlobalLocationProperty(OTF2_LocationRef    location,
+                                 OTF2_StringRef      name,
+                                 OTF2_Type           type,
+                                 OTF2_AttributeValue value) override
+    {
+        if (!m_filters.process(record::GlobalLocationProperty{}, location, name, type, value))
+        {
+            writeGlobalLocationProperty(location, name, type, value);
+        }
+    }
+
+    virtual void
+    handleGlobalCartDimension(OTF2_CartDimensionRef self,
+                              OTF2_StringRef        name,
+                              uint32_t              size,
+                              OTF2_CartPeriodicity  cartPeriodicity) override
+    {
+        if (!m_filters.process(record::GlobalCartDimension{}, self, name, size, cartPeriodicity))
+        {
+            writeGlobalCartDimension(self, name, size, cartPeriodicity);
+        }
+    }
+
+    virtual void
+    handleGlobalCartTopology(OTF2_CartTopologyRef         self,
+                             OTF2_StringRef               name,
+                             OTF2_CommRef                 communicator,
+                             uint8_t                      numberOfDimensions,
+                             const OTF2_CartDimensionRef *cartDimensions) override
+    {
+        if (!m_filters.process(record::GlobalCartTopology{},
+                               self,
+                               name,
+                               communicator,
+                               numberOfDimensions,
+                               cartDimensions))
+        {
+            writeGlobalCartTopology(self, name, communicator, numberOfDimensions, cartDimensions);
+        }
+    }
+
+    virtual void
+    handleGlobalCartCoordinate(OTF2_CartTopologyRef cartTopology,
+                               uint32_t             rank,
+                               uint8_t              numberOfDimensions,
+                               const uint32_t *     coordinates) override
+    {
+        if (!m_filters.process(record::GlobalCartCoordinate{}, cartTopology, rank, numberOfDimensions, coordinates))
+        {
+            writeGlobalCartCoordinate(cartTopology, rank, numberOfDimensions, coordinates);
+        }
+    }
+
+    virtual void
+    handleGlobalSourceCodeLocation(OTF2_SourceCodeLocationRef self, OTF2_StringRef file, uint32_t lineNumber) override
+    {
+        if (!m_filters.process(record::GlobalSourceCodeLocation{}, self, file, lineNumber))
+        {
+            writeGlobalSourceCodeLocation(self, file, lineNumber);
+        }
+    }
+
+    virtual void
+    handleGlobalCallingContext(OTF2_CallingContextRef     self,
+                               OTF2_RegionRef             region,
+                               OTF2_SourceCodeLocationRef sourceCodeLocation,
+                               OTF2_CallingContextRef     parent) override
+    {
+        if (!m_filters.process(record::GlobalCallingContext{}, self, region, sourceCodeLocation, parent))
+        {
+            writeGlobalCallingContext(self, region, sourceCodeLocation, parent);
+        }
+    }
+
+    virtual void
+    handleGlobalCallingContextProperty(OTF2_CallingContextRef callingContext,
+                                       OTF2_StringRef         name,
+                                       OTF2_Type              type,
+                                       OTF2_AttributeValue    value) override
+    {
+        if (!m_filters.process(record::GlobalCallingContextProperty{}, callingContext, name, type, value))
+        {
+            writeGlobalCallingContextProperty(callingContext, name, type, value);
+        }
+    }
+
+    virtual void
+    handleGlobalInterruptGenerator(OTF2_InterruptGeneratorRef  self,
+                                   OTF2_StringRef              name,
+                                   OTF2_InterruptGeneratorMode interruptGeneratorMode,
+                                   OTF2_Base                   base,
+                                   int64_t                     exponent,
+                                   uint64_t                    period) override
+    {
+        if (!m_filters.process(record::GlobalInterruptGenerator{},
+                               self,
+                               name,
+                               interruptGeneratorMode,
+                               base,
+                               exponent,
+                               period))
+        {
+            writeGlobalInterruptGenerator(self, name, interruptGeneratorMode, base, exponent, period);
+        }
+    }
+
+    virtual void
+    handleGlobalIoFileProperty(OTF2_IoFileRef      ioFile,
+                               OTF2_StringRef      name,
+                               OTF2_Type           type,
+                               OTF2_AttributeValue value) override
+    {
+        if (!m_filters.process(record::GlobalIoFileProperty{}, ioFile, name, type, value))
+        {
+            writeGlobalIoFileProperty(ioFile, name, type, value);
+        }
+    }
+
+    virtual void
+    handleGlobalIoRegularFile(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope) override
+    {
+        if (!m_filters.process(record::GlobalIoRegularFile{}, self, name, scope))
+        {
+            writeGlobalIoRegularFile(self, name, scope);
+        }
+    }
+
+    virtual void
+    handleGlobalIoDirectory(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope) override
+    {
+        if (!m_filters.process(record::GlobalIoDirectory{}, self, name, scope))
+        {
+            writeGlobalIoDirectory(self, name, scope);
+        }
+    }
+
+    virtual void
+    handleGlobalIoHandle(OTF2_IoHandleRef   self,
+                         OTF2_StringRef     name,
+                         OTF2_IoFileRef     file,
+                         OTF2_IoParadigmRef ioParadigm,
+                         OTF2_IoHandleFlag  ioHandleFlags,
+                         OTF2_CommRef       comm,
+                         OTF2_IoHandleRef   parent) override
+    {
+        if (!m_filters.process(record::GlobalIoHandle{}, self, name, file, ioParadigm, ioHandleFlags, comm, parent))
+        {
+            writeGlobalIoHandle(self, name, file, ioParadigm, ioHandleFlags, comm, parent);
+        }
+    }
+
+    virtual void
+    handleGlobalIoPreCreatedHandleState(OTF2_IoHandleRef  ioHandle,
+                                        OTF2_IoAccessMode mode,
+                                        OTF2_IoStatusFlag statusFlags) override
+    {
+        if (!m_filters.process(record::GlobalIoPreCreatedHandleState{}, ioHandle, mode, statusFlags))
+        {
+            writeGlobalIoPreCreatedHandleState(ioHandle, mode, statusFlags);
+        }
+    }
+
+    virtual void
+    handleGlobalCallpathParameter(OTF2_CallpathRef    callpath,
+                                  OTF2_ParameterRef   parameter,
+                                  OTF2_Type           type,
+                                  OTF2_AttributeValue value) override
+    {
+        if (!m_filters.process(record::GlobalCallpathParameter{}, callpath, parameter, type, value))
+        {
+            writeGlobalCallpathParameter(callpath, parameter, type, value);
+        }
+    }
+
+    /*
+     * Handle events.
+     */
+
+    virtual void
+    handleBufferFlushEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_TimeStamp      stopTime) override
+    {
+        bool filtered = m_filters.process(record::EventBufferFlush{}, location, time, attributes, stopTime);
+        count_event(EventType::BufferFlush, filtered);
+        if (!filtered)
+        {
+            writeBufferFlushEvent(location, time, attributes, stopTime);
+        }
+    }
+
+    virtual void
+    handleMeasurementOnOffEvent(OTF2_LocationRef     location,
+                                OTF2_TimeStamp       time,
+                                OTF2_AttributeList * attributes,
+                                OTF2_MeasurementMode measurementMode) override
+    {
+        bool filtered = m_filters.process(record::EventMeasurementOnOff{}, location, time, attributes, measurementMode);
+        count_event(EventType::MeasurementOnOff, filtered);
+        if (!filtered)
+        {
+            writeMeasurementOnOffEvent(location, time, attributes, measurementMode);
+        }
+    }
+
+    virtual void
+    handleEnterEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef      region) override
+    {
+        bool filtered = m_filters.process(record::EventEnter{}, location, time, attributes, region);
+        count_event(EventType::Enter, filtered);
+        if (!filtered)
+        {
+            writeEnterEvent(location, time, attributes, region);
+        }
+    }
+
+    virtual void
+    handleLeaveEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef      region) override
+    {
+        bool filtered = m_filters.process(record::EventLeave{}, location, time, attributes, region);
+        count_event(EventType::Leave, filtered);
+        if (!filtered)
+        {
+            writeLeaveEvent(location, time, attributes, region);
+        }
+    }
+
+    virtual void
+    handleMpiSendEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            receiver,
+                       OTF2_CommRef        communicator,
+                       uint32_t            msgTag,
+                       uint64_t            msgLength) override
+    {
+        bool filtered = m_filters.process(
+            record::EventMpiSend{}, location, time, attributes, receiver, communicator, msgTag, msgLength);
+        count_event(EventType::MpiSend, filtered);
+        if (!filtered)
+        {
+            writeMpiSendEvent(location, time, attributes, receiver, communicator, msgTag, msgLength);
+        }
+    }
+
+    virtual void
+    handleMpiIsendEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        uint32_t            receiver,
+                        OTF2_CommRef        communicator,
+                        uint32_t            msgTag,
+                        uint64_t            msgLength,
+                        uint64_t            requestID) override
+    {
+        bool filtered = m_filters.process(
+            record::EventMpiIsend{}, location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+        count_event(EventType::MpiIsend, filtered);
+        if (!filtered)
+        {
+            writeMpiIsendEvent(location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+        }
+    }
+
+    virtual void
+    handleMpiIsendCompleteEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                uint64_t            requestID) override
+    {
+        bool filtered = m_filters.process(record::EventMpiIsendComplete{}, location, time, attributes, requestID);
+        count_event(EventType::MpiIsendComplete, filtered);
+        if (!filtered)
+        {
+            writeMpiIsendCompleteEvent(location, time, attributes, requestID);
+        }
+    }
+
+    virtual void
+    handleMpiIrecvRequestEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint64_t            requestID) override
+    {
+        bool filtered = m_filters.process(record::EventMpiIrecvRequest{}, location, time, attributes, requestID);
+        count_event(EventType::MpiIrecvRequest, filtered);
+        if (!filtered)
+        {
+            writeMpiIrecvRequestEvent(location, time, attributes, requestID);
+        }
+    }
+
+    virtual void
+    handleMpiRecvEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            sender,
+                       OTF2_CommRef        communicator,
+                       uint32_t            msgTag,
+                       uint64_t            msgLength) override
+    {
+        bool filtered = m_filters.process(
+            record::EventMpiRecv{}, location, time, attributes, sender, communicator, msgTag, msgLength);
+        count_event(EventType::MpiRecv, filtered);
+        if (!filtered)
+        {
+            writeMpiRecvEvent(location, time, attributes, sender, communicator, msgTag, msgLength);
+        }
+    }
+
+    virtual void
+    handleMpiIrecvEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        uint32_t            sender,
+                        OTF2_CommRef        communicator,
+                        uint32_t            msgTag,
+                        uint64_t            msgLength,
+                        uint64_t            requestID) override
+    {
+        bool filtered = m_filters.process(
+            record::EventMpiIrecv{}, location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+        count_event(EventType::MpiIrecv, filtered);
+        if (!filtered)
+        {
+            writeMpiIrecvEvent(location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+        }
+    }
+
+    virtual void
+    handleMpiRequestTestEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint64_t            requestID) override
+    {
+        bool filtered = m_filters.process(record::EventMpiRequestTest{}, location, time, attributes, requestID);
+        count_event(EventType::MpiRequestTest, filtered);
+        if (!filtered)
+        {
+            writeMpiRequestTestEvent(location, time, attributes, requestID);
+        }
+    }
+
+    virtual void
+    handleMpiRequestCancelledEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   uint64_t            requestID) override
+    {
+        bool filtered = m_filters.process(record::EventMpiRequestCancelled{}, location, time, attributes, requestID);
+        count_event(EventType::MpiRequestCancelled, filtered);
+        if (!filtered)
+        {
+            writeMpiRequestCancelledEvent(location, time, attributes, requestID);
+        }
+    }
+
+    virtual void
+    handleMpiCollectiveBeginEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes) override
+    {
+        bool filtered = m_filters.process(record::EventMpiCollectiveBegin{}, location, time, attributes);
+        count_event(EventType::MpiCollectiveBegin, filtered);
+        if (!filtered)
+        {
+            writeMpiCollectiveBeginEvent(location, time, attributes);
+        }
+    }
+
+    virtual void
+    handleMpiCollectiveEndEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CollectiveOp   collectiveOp,
+                                OTF2_CommRef        communicator,
+                                uint32_t            root,
+                                uint64_t            sizeSent,
+                                uint64_t            sizeReceived) override
+    {
+        bool filtered = m_filters.process(record::EventMpiCollectiveEnd{},
+                                          location,
+                                          time,
+                                          attributes,
+                                          collectiveOp,
+                                          communicator,
+                                          root,
+                                          sizeSent,
+                                          sizeReceived);
+        count_event(EventType::MpiCollectiveEnd, filtered);
+        if (!filtered)
+        {
+            writeMpiCollectiveEndEvent(
+                location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
+        }
+    }
+
+    virtual void
+    handleOmpForkEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            numberOfRequestedThreads) override
+    {
+        bool filtered = m_filters.process(record::EventOmpFork{}, location, time, attributes, numberOfRequestedThreads);
+        count_event(EventType::OmpFork, filtered);
+        if (!filtered)
+        {
+            writeOmpForkEvent(location, time, attributes, numberOfRequestedThreads);
+        }
+    }
+
+    virtual void
+    handleOmpJoinEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes) override
+    {
+        bool filtered = m_filters.process(record::EventOmpJoin{}, location, time, attributes);
+        count_event(EventType::OmpJoin, filtered);
+        if (!filtered)
+        {
+            writeOmpJoinEvent(location, time, attributes);
+        }
+    }
+
+    virtual void
+    handleOmpAcquireLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint32_t            lockID,
+                              uint32_t            acquisitionOrder) override
+    {
+        bool filtered = m_filters.process(
+            record::EventOmpAcquireLock{}, location, time, attributes, lockID, acquisitionOrder);
+        count_event(EventType::OmpAcquireLock, filtered);
+        if (!filtered)
+        {
+            writeOmpAcquireLockEvent(location, time, attributes, lockID, acquisitionOrder);
+        }
+    }
+
+    virtual void
+    handleOmpReleaseLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint32_t            lockID,
+                              uint32_t            acquisitionOrder) override
+    {
+        bool filtered = m_filters.process(
+            record::EventOmpReleaseLock{}, location, time, attributes, lockID, acquisitionOrder);
+        count_event(EventType::OmpReleaseLock, filtered);
+        if (!filtered)
+        {
+            writeOmpReleaseLockEvent(location, time, attributes, lockID, acquisitionOrder);
+        }
+    }
+
+    virtual void
+    handleOmpTaskCreateEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint64_t            taskID) override
+    {
+        bool filtered = m_filters.process(record::EventOmpTaskCreate{}, location, time, attributes, taskID);
+        count_event(EventType::OmpTaskCreate, filtered);
+        if (!filtered)
+        {
+            writeOmpTaskCreateEvent(location, time, attributes, taskID);
+        }
+    }
+
+    virtual void
+    handleOmpTaskSwitchEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint64_t            taskID) override
+    {
+        bool filtered = m_filters.process(record::EventOmpTaskSwitch{}, location, time, attributes, taskID);
+        count_event(EventType::OmpTaskSwitch, filtered);
+        if (!filtered)
+        {
+            writeOmpTaskSwitchEvent(location, time, attributes, taskID);
+        }
+    }
+
+    virtual void
+    handleOmpTaskCompleteEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint64_t            taskID) override
+    {
+        bool filtered = m_filters.process(record::EventOmpTaskComplete{}, location, time, attributes, taskID);
+        count_event(EventType::OmpTaskComplete, filtered);
+        if (!filtered)
+        {
+            writeOmpTaskCompleteEvent(location, time, attributes, taskID);
+        }
+    }
+
+    virtual void
+    handleMetricEvent(OTF2_LocationRef        location,
+                      OTF2_TimeStamp          time,
+                      OTF2_AttributeList *    attributes,
+                      OTF2_MetricRef          metric,
+                      uint8_t                 numberOfMetrics,
+                      const OTF2_Type *       typeIDs,
+                      const OTF2_MetricValue *metricValues) override
+    {
+        bool filtered = m_filters.process(
+            record::EventMetric{}, location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+        count_event(EventType::Metric, filtered);
+        if (!filtered)
+        {
+            writeMetricEvent(location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+        }
+    }
+
+    virtual void
+    handleParameterStringEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_ParameterRef   parameter,
+                               OTF2_StringRef      string) override
+    {
+        bool filtered = m_filters.process(
+            record::EventParameterString{}, location, time, attributes, parameter, string);
+        count_event(EventType::ParameterString, filtered);
+        if (!filtered)
+        {
+            writeParameterStringEvent(location, time, attributes, parameter, string);
+        }
+    }
+
+    virtual void
+    handleParameterIntEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_ParameterRef   parameter,
+                            int64_t             value) override
+    {
+        bool filtered = m_filters.process(record::EventParameterInt{}, location, time, attributes, parameter, value);
+        count_event(EventType::ParameterInt, filtered);
+        if (!filtered)
+        {
+            writeParameterIntEvent(location, time, attributes, parameter, value);
+        }
+    }
+
+    virtual void
+    handleParameterUnsignedIntEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_ParameterRef   parameter,
+                                    uint64_t            value) override
+    {
+        bool filtered = m_filters.process(
+            record::EventParameterUnsignedInt{}, location, time, attributes, parameter, value);
+        count_event(EventType::ParameterUnsignedInt, filtered);
+        if (!filtered)
+        {
+            writeParameterUnsignedIntEvent(location, time, attributes, parameter, value);
+        }
+    }
+
+    virtual void
+    handleRmaWinCreateEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_RmaWinRef      win) override
+    {
+        bool filtered = m_filters.process(record::EventRmaWinCreate{}, location, time, attributes, win);
+        count_event(EventType::RmaWinCreate, filtered);
+        if (!filtered)
+        {
+            writeRmaWinCreateEvent(location, time, attributes, win);
+        }
+    }
+
+    virtual void
+    handleRmaWinDestroyEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win) override
+    {
+        bool filtered = m_filters.process(record::EventRmaWinDestroy{}, location, time, attributes, win);
+        count_event(EventType::RmaWinDestroy, filtered);
+        if (!filtered)
+        {
+            writeRmaWinDestroyEvent(location, time, attributes, win);
+        }
+    }
+
+    virtual void
+    handleRmaCollectiveBeginEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes) override
+    {
+        bool filtered = m_filters.process(record::EventRmaCollectiveBegin{}, location, time, attributes);
+        count_event(EventType::RmaCollectiveBegin, filtered);
+        if (!filtered)
+        {
+            writeRmaCollectiveBeginEvent(location, time, attributes);
+        }
+    }
+
+    virtual void
+    handleRmaCollectiveEndEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CollectiveOp   collectiveOp,
+                                OTF2_RmaSyncLevel   syncLevel,
+                                OTF2_RmaWinRef      win,
+                                uint32_t            root,
+                                uint64_t            bytesSent,
+                                uint64_t            bytesReceived) override
+    {
+        bool filtered = m_filters.process(record::EventRmaCollectiveEnd{},
+                                          location,
+                                          time,
+                                          attributes,
+                                          collectiveOp,
+                                          syncLevel,
+                                          win,
+                                          root,
+                                          bytesSent,
+                                          bytesReceived);
+        count_event(EventType::RmaCollectiveEnd, filtered);
+        if (!filtered)
+        {
+            writeRmaCollectiveEndEvent(
+                location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+        }
+    }
+
+    virtual void
+    handleRmaGroupSyncEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_RmaSyncLevel   syncLevel,
+                            OTF2_RmaWinRef      win,
+                            OTF2_GroupRef       group) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaGroupSync{}, location, time, attributes, syncLevel, win, group);
+        count_event(EventType::RmaGroupSync, filtered);
+        if (!filtered)
+        {
+            writeRmaGroupSyncEvent(location, time, attributes, syncLevel, win, group);
+        }
+    }
+
+    virtual void
+    handleRmaRequestLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            lockId,
+                              OTF2_LockType       lockType) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaRequestLock{}, location, time, attributes, win, remote, lockId, lockType);
+        count_event(EventType::RmaRequestLock, filtered);
+        if (!filtered)
+        {
+            writeRmaRequestLockEvent(location, time, attributes, win, remote, lockId, lockType);
+        }
+    }
+
+    virtual void
+    handleRmaAcquireLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            lockId,
+                              OTF2_LockType       lockType) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaAcquireLock{}, location, time, attributes, win, remote, lockId, lockType);
+        count_event(EventType::RmaAcquireLock, filtered);
+        if (!filtered)
+        {
+            writeRmaAcquireLockEvent(location, time, attributes, win, remote, lockId, lockType);
+        }
+    }
+
+    virtual void
+    handleRmaTryLockEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_RmaWinRef      win,
+                          uint32_t            remote,
+                          uint64_t            lockId,
+                          OTF2_LockType       lockType) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaTryLock{}, location, time, attributes, win, remote, lockId, lockType);
+        count_event(EventType::RmaTryLock, filtered);
+        if (!filtered)
+        {
+            writeRmaTryLockEvent(location, time, attributes, win, remote, lockId, lockType);
+        }
+    }
+
+    virtual void
+    handleRmaReleaseLockEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            lockId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaReleaseLock{}, location, time, attributes, win, remote, lockId);
+        count_event(EventType::RmaReleaseLock, filtered);
+        if (!filtered)
+        {
+            writeRmaReleaseLockEvent(location, time, attributes, win, remote, lockId);
+        }
+    }
+
+    virtual void
+    handleRmaSyncEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       OTF2_RmaWinRef      win,
+                       uint32_t            remote,
+                       OTF2_RmaSyncType    syncType) override
+    {
+        bool filtered = m_filters.process(record::EventRmaSync{}, location, time, attributes, win, remote, syncType);
+        count_event(EventType::RmaSync, filtered);
+        if (!filtered)
+        {
+            writeRmaSyncEvent(location, time, attributes, win, remote, syncType);
+        }
+    }
+
+    virtual void
+    handleRmaWaitChangeEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win) override
+    {
+        bool filtered = m_filters.process(record::EventRmaWaitChange{}, location, time, attributes, win);
+        count_event(EventType::RmaWaitChange, filtered);
+        if (!filtered)
+        {
+            writeRmaWaitChangeEvent(location, time, attributes, win);
+        }
+    }
+
+    virtual void
+    handleRmaPutEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_RmaWinRef      win,
+                      uint32_t            remote,
+                      uint64_t            bytes,
+                      uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaPut{}, location, time, attributes, win, remote, bytes, matchingId);
+        count_event(EventType::RmaPut, filtered);
+        if (!filtered)
+        {
+            writeRmaPutEvent(location, time, attributes, win, remote, bytes, matchingId);
+        }
+    }
+
+    virtual void
+    handleRmaGetEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_RmaWinRef      win,
+                      uint32_t            remote,
+                      uint64_t            bytes,
+                      uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaGet{}, location, time, attributes, win, remote, bytes, matchingId);
+        count_event(EventType::RmaGet, filtered);
+        if (!filtered)
+        {
+            writeRmaGetEvent(location, time, attributes, win, remote, bytes, matchingId);
+        }
+    }
+
+    virtual void
+    handleRmaAtomicEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_RmaWinRef      win,
+                         uint32_t            remote,
+                         OTF2_RmaAtomicType  type,
+                         uint64_t            bytesSent,
+                         uint64_t            bytesReceived,
+                         uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(record::EventRmaAtomic{},
+                                          location,
+                                          time,
+                                          attributes,
+                                          win,
+                                          remote,
+                                          type,
+                                          bytesSent,
+                                          bytesReceived,
+                                          matchingId);
+        count_event(EventType::RmaAtomic, filtered);
+        if (!filtered)
+        {
+            writeRmaAtomicEvent(location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
+        }
+    }
+
+    virtual void
+    handleRmaOpCompleteBlockingEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_RmaWinRef      win,
+                                     uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaOpCompleteBlocking{}, location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpCompleteBlocking, filtered);
+        if (!filtered)
+        {
+            writeRmaOpCompleteBlockingEvent(location, time, attributes, win, matchingId);
+        }
+    }
+
+    virtual void
+    handleRmaOpCompleteNonBlockingEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_RmaWinRef      win,
+                                        uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaOpCompleteNonBlocking{}, location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpCompleteNonBlocking, filtered);
+        if (!filtered)
+        {
+            writeRmaOpCompleteNonBlockingEvent(location, time, attributes, win, matchingId);
+        }
+    }
+
+    virtual void
+    handleRmaOpTestEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_RmaWinRef      win,
+                         uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(record::EventRmaOpTest{}, location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpTest, filtered);
+        if (!filtered)
+        {
+            writeRmaOpTestEvent(location, time, attributes, win, matchingId);
+        }
+    }
+
+    virtual void
+    handleRmaOpCompleteRemoteEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_RmaWinRef      win,
+                                   uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventRmaOpCompleteRemote{}, location, time, attributes, win, matchingId);
+        count_event(EventType::RmaOpCompleteRemote, filtered);
+        if (!filtered)
+        {
+            writeRmaOpCompleteRemoteEvent(location, time, attributes, win, matchingId);
+        }
+    }
+
+    virtual void
+    handleThreadForkEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_Paradigm       model,
+                          uint32_t            numberOfRequestedThreads) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadFork{}, location, time, attributes, model, numberOfRequestedThreads);
+        count_event(EventType::ThreadFork, filtered);
+        if (!filtered)
+        {
+            writeThreadForkEvent(location, time, attributes, model, numberOfRequestedThreads);
+        }
+    }
+
+    virtual void
+    handleThreadJoinEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_Paradigm       model) override
+    {
+        bool filtered = m_filters.process(record::EventThreadJoin{}, location, time, attributes, model);
+        count_event(EventType::ThreadJoin, filtered);
+        if (!filtered)
+        {
+            writeThreadJoinEvent(location, time, attributes, model);
+        }
+    }
+
+    virtual void
+    handleThreadTeamBeginEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_CommRef        threadTeam) override
+    {
+        bool filtered = m_filters.process(record::EventThreadTeamBegin{}, location, time, attributes, threadTeam);
+        count_event(EventType::ThreadTeamBegin, filtered);
+        if (!filtered)
+        {
+            writeThreadTeamBeginEvent(location, time, attributes, threadTeam);
+        }
+    }
+
+    virtual void
+    handleThreadTeamEndEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_CommRef        threadTeam) override
+    {
+        bool filtered = m_filters.process(record::EventThreadTeamEnd{}, location, time, attributes, threadTeam);
+        count_event(EventType::ThreadTeamEnd, filtered);
+        if (!filtered)
+        {
+            writeThreadTeamEndEvent(location, time, attributes, threadTeam);
+        }
+    }
+
+    virtual void
+    handleThreadAcquireLockEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_Paradigm       model,
+                                 uint32_t            lockID,
+                                 uint32_t            acquisitionOrder) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadAcquireLock{}, location, time, attributes, model, lockID, acquisitionOrder);
+        count_event(EventType::ThreadAcquireLock, filtered);
+        if (!filtered)
+        {
+            writeThreadAcquireLockEvent(location, time, attributes, model, lockID, acquisitionOrder);
+        }
+    }
+
+    virtual void
+    handleThreadReleaseLockEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_Paradigm       model,
+                                 uint32_t            lockID,
+                                 uint32_t            acquisitionOrder) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadReleaseLock{}, location, time, attributes, model, lockID, acquisitionOrder);
+        count_event(EventType::ThreadReleaseLock, filtered);
+        if (!filtered)
+        {
+            writeThreadReleaseLockEvent(location, time, attributes, model, lockID, acquisitionOrder);
+        }
+    }
+
+    virtual void
+    handleThreadTaskCreateEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CommRef        threadTeam,
+                                uint32_t            creatingThread,
+                                uint32_t            generationNumber) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadTaskCreate{}, location, time, attributes, threadTeam, creatingThread, generationNumber);
+        count_event(EventType::ThreadTaskCreate, filtered);
+        if (!filtered)
+        {
+            writeThreadTaskCreateEvent(location, time, attributes, threadTeam, creatingThread, generationNumber);
+        }
+    }
+
+    virtual void
+    handleThreadTaskSwitchEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_CommRef        threadTeam,
+                                uint32_t            creatingThread,
+                                uint32_t            generationNumber) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadTaskSwitch{}, location, time, attributes, threadTeam, creatingThread, generationNumber);
+        count_event(EventType::ThreadTaskSwitch, filtered);
+        if (!filtered)
+        {
+            writeThreadTaskSwitchEvent(location, time, attributes, threadTeam, creatingThread, generationNumber);
+        }
+    }
+
+    virtual void
+    handleThreadTaskCompleteEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_CommRef        threadTeam,
+                                  uint32_t            creatingThread,
+                                  uint32_t            generationNumber) override
+    {
+        bool filtered = m_filters.process(record::EventThreadTaskComplete{},
+                                          location,
+                                          time,
+                                          attributes,
+                                          threadTeam,
+                                          creatingThread,
+                                          generationNumber);
+        count_event(EventType::ThreadTaskComplete, filtered);
+        if (!filtered)
+        {
+            writeThreadTaskCompleteEvent(location, time, attributes, threadTeam, creatingThread, generationNumber);
+        }
+    }
+
+    virtual void
+    handleThreadCreateEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_CommRef        threadContingent,
+                            uint64_t            sequenceCount) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadCreate{}, location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadCreate, filtered);
+        if (!filtered)
+        {
+            writeThreadCreateEvent(location, time, attributes, threadContingent, sequenceCount);
+        }
+    }
+
+    virtual void
+    handleThreadBeginEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_CommRef        threadContingent,
+                           uint64_t            sequenceCount) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadBegin{}, location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadBegin, filtered);
+        if (!filtered)
+        {
+            writeThreadBeginEvent(location, time, attributes, threadContingent, sequenceCount);
+        }
+    }
+
+    virtual void
+    handleThreadWaitEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_CommRef        threadContingent,
+                          uint64_t            sequenceCount) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadWait{}, location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadWait, filtered);
+        if (!filtered)
+        {
+            writeThreadWaitEvent(location, time, attributes, threadContingent, sequenceCount);
+        }
+    }
+
+    virtual void
+    handleThreadEndEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_CommRef        threadContingent,
+                         uint64_t            sequenceCount) override
+    {
+        bool filtered = m_filters.process(
+            record::EventThreadEnd{}, location, time, attributes, threadContingent, sequenceCount);
+        count_event(EventType::ThreadEnd, filtered);
+        if (!filtered)
+        {
+            writeThreadEndEvent(location, time, attributes, threadContingent, sequenceCount);
+        }
+    }
+
+    virtual void
+    handleCallingContextEnterEvent(OTF2_LocationRef       location,
+                                   OTF2_TimeStamp         time,
+                                   OTF2_AttributeList *   attributes,
+                                   OTF2_CallingContextRef callingContext,
+                                   uint32_t               unwindDistance) override
+    {
+        bool filtered = m_filters.process(
+            record::EventCallingContextEnter{}, location, time, attributes, callingContext, unwindDistance);
+        count_event(EventType::CallingContextEnter, filtered);
+        if (!filtered)
+        {
+            writeCallingContextEnterEvent(location, time, attributes, callingContext, unwindDistance);
+        }
+    }
+
+    virtual void
+    handleCallingContextLeaveEvent(OTF2_LocationRef       location,
+                                   OTF2_TimeStamp         time,
+                                   OTF2_AttributeList *   attributes,
+                                   OTF2_CallingContextRef callingContext) override
+    {
+        bool filtered = m_filters.process(
+            record::EventCallingContextLeave{}, location, time, attributes, callingContext);
+        count_event(EventType::CallingContextLeave, filtered);
+        if (!filtered)
+        {
+            writeCallingContextLeaveEvent(location, time, attributes, callingContext);
+        }
+    }
+
+    virtual void
+    handleCallingContextSampleEvent(OTF2_LocationRef           location,
+                                    OTF2_TimeStamp             time,
+                                    OTF2_AttributeList *       attributes,
+                                    OTF2_CallingContextRef     callingContext,
+                                    uint32_t                   unwindDistance,
+                                    OTF2_InterruptGeneratorRef interruptGenerator) override
+    {
+        bool filtered = m_filters.process(record::EventCallingContextSample{},
+                                          location,
+                                          time,
+                                          attributes,
+                                          callingContext,
+                                          unwindDistance,
+                                          interruptGenerator);
+        count_event(EventType::CallingContextSample, filtered);
+        if (!filtered)
+        {
+            writeCallingContextSampleEvent(
+                location, time, attributes, callingContext, unwindDistance, interruptGenerator);
+        }
+    }
+
+    virtual void
+    handleIoCreateHandleEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_IoHandleRef    handle,
+                              OTF2_IoAccessMode   mode,
+                              OTF2_IoCreationFlag creationFlags,
+                              OTF2_IoStatusFlag   statusFlags) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoCreateHandle{}, location, time, attributes, handle, mode, creationFlags, statusFlags);
+        count_event(EventType::IoCreateHandle, filtered);
+        if (!filtered)
+        {
+            writeIoCreateHandleEvent(location, time, attributes, handle, mode, creationFlags, statusFlags);
+        }
+    }
+
+    virtual void
+    handleIoDestroyHandleEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_IoHandleRef    handle) override
+    {
+        bool filtered = m_filters.process(record::EventIoDestroyHandle{}, location, time, attributes, handle);
+        count_event(EventType::IoDestroyHandle, filtered);
+        if (!filtered)
+        {
+            writeIoDestroyHandleEvent(location, time, attributes, handle);
+        }
+    }
+
+    virtual void
+    handleIoDuplicateHandleEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_IoHandleRef    oldHandle,
+                                 OTF2_IoHandleRef    newHandle,
+                                 OTF2_IoStatusFlag   statusFlags) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoDuplicateHandle{}, location, time, attributes, oldHandle, newHandle, statusFlags);
+        count_event(EventType::IoDuplicateHandle, filtered);
+        if (!filtered)
+        {
+            writeIoDuplicateHandleEvent(location, time, attributes, oldHandle, newHandle, statusFlags);
+        }
+    }
+
+    virtual void
+    handleIoSeekEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_IoHandleRef    handle,
+                      int64_t             offsetRequest,
+                      OTF2_IoSeekOption   whence,
+                      uint64_t            offsetResult) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoSeek{}, location, time, attributes, handle, offsetRequest, whence, offsetResult);
+        count_event(EventType::IoSeek, filtered);
+        if (!filtered)
+        {
+            writeIoSeekEvent(location, time, attributes, handle, offsetRequest, whence, offsetResult);
+        }
+    }
+
+    virtual void
+    handleIoChangeStatusFlagsEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_IoHandleRef    handle,
+                                   OTF2_IoStatusFlag   statusFlags) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoChangeStatusFlags{}, location, time, attributes, handle, statusFlags);
+        count_event(EventType::IoChangeStatusFlags, filtered);
+        if (!filtered)
+        {
+            writeIoChangeStatusFlagsEvent(location, time, attributes, handle, statusFlags);
+        }
+    }
+
+    virtual void
+    handleIoDeleteFileEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_IoParadigmRef  ioParadigm,
+                            OTF2_IoFileRef      file) override
+    {
+        bool filtered = m_filters.process(record::EventIoDeleteFile{}, location, time, attributes, ioParadigm, file);
+        count_event(EventType::IoDeleteFile, filtered);
+        if (!filtered)
+        {
+            writeIoDeleteFileEvent(location, time, attributes, ioParadigm, file);
+        }
+    }
+
+    virtual void
+    handleIoOperationBeginEvent(OTF2_LocationRef     location,
+                                OTF2_TimeStamp       time,
+                                OTF2_AttributeList * attributes,
+                                OTF2_IoHandleRef     handle,
+                                OTF2_IoOperationMode mode,
+                                OTF2_IoOperationFlag operationFlags,
+                                uint64_t             bytesRequest,
+                                uint64_t             matchingId) override
+    {
+        bool filtered = m_filters.process(record::EventIoOperationBegin{},
+                                          location,
+                                          time,
+                                          attributes,
+                                          handle,
+                                          mode,
+                                          operationFlags,
+                                          bytesRequest,
+                                          matchingId);
+        count_event(EventType::IoOperationBegin, filtered);
+        if (!filtered)
+        {
+            writeIoOperationBeginEvent(
+                location, time, attributes, handle, mode, operationFlags, bytesRequest, matchingId);
+        }
+    }
+
+    virtual void
+    handleIoOperationTestEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_IoHandleRef    handle,
+                               uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoOperationTest{}, location, time, attributes, handle, matchingId);
+        count_event(EventType::IoOperationTest, filtered);
+        if (!filtered)
+        {
+            writeIoOperationTestEvent(location, time, attributes, handle, matchingId);
+        }
+    }
+
+    virtual void
+    handleIoOperationIssuedEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_IoHandleRef    handle,
+                                 uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoOperationIssued{}, location, time, attributes, handle, matchingId);
+        count_event(EventType::IoOperationIssued, filtered);
+        if (!filtered)
+        {
+            writeIoOperationIssuedEvent(location, time, attributes, handle, matchingId);
+        }
+    }
+
+    virtual void
+    handleIoOperationCompleteEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_IoHandleRef    handle,
+                                   uint64_t            bytesResult,
+                                   uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoOperationComplete{}, location, time, attributes, handle, bytesResult, matchingId);
+        count_event(EventType::IoOperationComplete, filtered);
+        if (!filtered)
+        {
+            writeIoOperationCompleteEvent(location, time, attributes, handle, bytesResult, matchingId);
+        }
+    }
+
+    virtual void
+    handleIoOperationCancelledEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_IoHandleRef    handle,
+                                    uint64_t            matchingId) override
+    {
+        bool filtered = m_filters.process(
+            record::EventIoOperationCancelled{}, location, time, attributes, handle, matchingId);
+        count_event(EventType::IoOperationCancelled, filtered);
+        if (!filtered)
+        {
+            writeIoOperationCancelledEvent(location, time, attributes, handle, matchingId);
+        }
+    }
+
+    virtual void
+    handleIoAcquireLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_IoHandleRef    handle,
+                             OTF2_LockType       lockType) override
+    {
+        bool filtered = m_filters.process(record::EventIoAcquireLock{}, location, time, attributes, handle, lockType);
+        count_event(EventType::IoAcquireLock, filtered);
+        if (!filtered)
+        {
+            writeIoAcquireLockEvent(location, time, attributes, handle, lockType);
+        }
+    }
+
+    virtual void
+    handleIoReleaseLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_IoHandleRef    handle,
+                             OTF2_LockType       lockType) override
+    {
+        bool filtered = m_filters.process(record::EventIoReleaseLock{}, location, time, attributes, handle, lockType);
+        count_event(EventType::IoReleaseLock, filtered);
+        if (!filtered)
+        {
+            writeIoReleaseLockEvent(location, time, attributes, handle, lockType);
+        }
+    }
+
+    virtual void
+    handleIoTryLockEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_IoHandleRef    handle,
+                         OTF2_LockType       lockType) override
+    {
+        bool filtered = m_filters.process(record::EventIoTryLock{}, location, time, attributes, handle, lockType);
+        count_event(EventType::IoTryLock, filtered);
+        if (!filtered)
+        {
+            writeIoTryLockEvent(location, time, attributes, handle, lockType);
+        }
+    }
+
+    virtual void
+    handleProgramBeginEvent(OTF2_LocationRef      location,
+                            OTF2_TimeStamp        time,
+                            OTF2_AttributeList *  attributes,
+                            OTF2_StringRef        programName,
+                            uint32_t              numberOfArguments,
+                            const OTF2_StringRef *programArguments) override
+    {
+        bool filtered = m_filters.process(
+            record::EventProgramBegin{}, location, time, attributes, programName, numberOfArguments, programArguments);
+        count_event(EventType::ProgramBegin, filtered);
+        if (!filtered)
+        {
+            writeProgramBeginEvent(location, time, attributes, programName, numberOfArguments, programArguments);
+        }
+    }
+
+    virtual void
+    handleProgramEndEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          int64_t             exitStatus) override
+    {
+        bool filtered = m_filters.process(record::EventProgramEnd{}, location, time, attributes, exitStatus);
+        count_event(EventType::ProgramEnd, filtered);
+        if (!filtered)
+        {
+            writeProgramEndEvent(location, time, attributes, exitStatus);
+        }
+    }
+
+  private:
+    template <typename Record, typename Callback>
+    static constexpr bool filters_handle = StaticFilterHandles<StaticFilter<Filters...>, Record, Callback>::value;
+
+    static constexpr bool filters_events =
+        filters_handle<record::EventBufferFlush, EventBufferFlushFilter> ||
+        filters_handle<record::EventMeasurementOnOff, EventMeasurementOnOffFilter> ||
+        filters_handle<record::EventEnter, EventEnterFilter> ||
+        filters_handle<record::EventLeave, EventLeaveFilter> ||
+        filters_handle<record::EventMpiSend, EventMpiSendFilter> ||
+        filters_handle<record::EventMpiIsend, EventMpiIsendFilter> ||
+        filters_handle<record::EventMpiIsendComplete, EventMpiIsendCompleteFilter> ||
+        filters_handle<record::EventMpiIrecvRequest, EventMpiIrecvRequestFilter> ||
+        filters_handle<record::EventMpiRecv, EventMpiRecvFilter> ||
+        filters_handle<record::EventMpiIrecv, EventMpiIrecvFilter> ||
+        filters_handle<record::EventMpiRequestTest, EventMpiRequestTestFilter> ||
+        filters_handle<record::EventMpiRequestCancelled, EventMpiRequestCancelledFilter> ||
+        filters_handle<record::EventMpiCollectiveBegin, EventMpiCollectiveBeginFilter> ||
+        filters_handle<record::EventMpiCollectiveEnd, EventMpiCollectiveEndFilter> ||
+        filters_handle<record::EventOmpFork, EventOmpForkFilter> ||
+        filters_handle<record::EventOmpJoin, EventOmpJoinFilter> ||
+        filters_handle<record::EventOmpAcquireLock, EventOmpAcquireLockFilter> ||
+        filters_handle<record::EventOmpReleaseLock, EventOmpReleaseLockFilter> ||
+        filters_handle<record::EventOmpTaskCreate, EventOmpTaskCreateFilter> ||
+        filters_handle<record::EventOmpTaskSwitch, EventOmpTaskSwitchFilter> ||
+        filters_handle<record::EventOmpTaskComplete, EventOmpTaskCompleteFilter> ||
+        filters_handle<record::EventMetric, EventMetricFilter> ||
+        filters_handle<record::EventParameterString, EventParameterStringFilter> ||
+        filters_handle<record::EventParameterInt, EventParameterIntFilter> ||
+        filters_handle<record::EventParameterUnsignedInt, EventParameterUnsignedIntFilter> ||
+        filters_handle<record::EventRmaWinCreate, EventRmaWinCreateFilter> ||
+        filters_handle<record::EventRmaWinDestroy, EventRmaWinDestroyFilter> ||
+        filters_handle<record::EventRmaCollectiveBegin, EventRmaCollectiveBeginFilter> ||
+        filters_handle<record::EventRmaCollectiveEnd, EventRmaCollectiveEndFilter> ||
+        filters_handle<record::EventRmaGroupSync, EventRmaGroupSyncFilter> ||
+        filters_handle<record::EventRmaRequestLock, EventRmaRequestLockFilter> ||
+        filters_handle<record::EventRmaAcquireLock, EventRmaAcquireLockFilter> ||
+        filters_handle<record::EventRmaTryLock, EventRmaTryLockFilter> ||
+        filters_handle<record::EventRmaReleaseLock, EventRmaReleaseLockFilter> ||
+        filters_handle<record::EventRmaSync, EventRmaSyncFilter> ||
+        filters_handle<record::EventRmaWaitChange, EventRmaWaitChangeFilter> ||
+        filters_handle<record::EventRmaPut, EventRmaPutFilter> ||
+        filters_handle<record::EventRmaGet, EventRmaGetFilter> ||
+        filters_handle<record::EventRmaAtomic, EventRmaAtomicFilter> ||
+        filters_handle<record::EventRmaOpCompleteBlocking, EventRmaOpCompleteBlockingFilter> ||
+        filters_handle<record::EventRmaOpCompleteNonBlocking, EventRmaOpCompleteNonBlockingFilter> ||
+        filters_handle<record::EventRmaOpTest, EventRmaOpTestFilter> ||
+        filters_handle<record::EventRmaOpCompleteRemote, EventRmaOpCompleteRemoteFilter> ||
+        filters_handle<record::EventThreadFork, EventThreadForkFilter> ||
+        filters_handle<record::EventThreadJoin, EventThreadJoinFilter> ||
+        filters_handle<record::EventThreadTeamBegin, EventThreadTeamBeginFilter> ||
+        filters_handle<record::EventThreadTeamEnd, EventThreadTeamEndFilter> ||
+        filters_handle<record::EventThreadAcquireLock, EventThreadAcquireLockFilter> ||
+        filters_handle<record::EventThreadReleaseLock, EventThreadReleaseLockFilter> ||
+        filters_handle<record::EventThreadTaskCreate, EventThreadTaskCreateFilter> ||
+        filters_handle<record::EventThreadTaskSwitch, EventThreadTaskSwitchFilter> ||
+        filters_handle<record::EventThreadTaskComplete, EventThreadTaskCompleteFilter> ||
+        filters_handle<record::EventThreadCreate, EventThreadCreateFilter> ||
+        filters_handle<record::EventThreadBegin, EventThreadBeginFilter> ||
+        filters_handle<record::EventThreadWait, EventThreadWaitFilter> ||
+        filters_handle<record::EventThreadEnd, EventThreadEndFilter> ||
+        filters_handle<record::EventCallingContextEnter, EventCallingContextEnterFilter> ||
+        filters_handle<record::EventCallingContextLeave, EventCallingContextLeaveFilter> ||
+        filters_handle<record::EventCallingContextSample, EventCallingContextSampleFilter> ||
+        filters_handle<record::EventIoCreateHandle, EventIoCreateHandleFilter> ||
+        filters_handle<record::EventIoDestroyHandle, EventIoDestroyHandleFilter> ||
+        filters_handle<record::EventIoDuplicateHandle, EventIoDuplicateHandleFilter> ||
+        filters_handle<record::EventIoSeek, EventIoSeekFilter> ||
+        filters_handle<record::EventIoChangeStatusFlags, EventIoChangeStatusFlagsFilter> ||
+        filters_handle<record::EventIoDeleteFile, EventIoDeleteFileFilter> ||
+        filters_handle<record::EventIoOperationBegin, EventIoOperationBeginFilter> ||
+        filters_handle<record::EventIoOperationTest, EventIoOperationTestFilter> ||
+        filters_handle<record::EventIoOperationIssued, EventIoOperationIssuedFilter> ||
+        filters_handle<record::EventIoOperationComplete, EventIoOperationCompleteFilter> ||
+        filters_handle<record::EventIoOperationCancelled, EventIoOperationCancelledFilter> ||
+        filters_handle<record::EventIoAcquireLock, EventIoAcquireLockFilter> ||
+        filters_handle<record::EventIoReleaseLock, EventIoReleaseLockFilter> ||
+        filters_handle<record::EventIoTryLock, EventIoTryLockFilter> ||
+        filters_handle<record::EventProgramBegin, EventProgramBeginFilter> ||
+        filters_handle<record::EventProgramEnd, EventProgramEndFilter>;
+
+    StaticFilter<Filters...> m_filters;
+};
+
+#endif /* STATIC_TRACE_WRITER_H */
@@ -6,9 +6,17 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <typeinfo>
 
 #include <global_callbacks.hpp>
+#include <local_reader.hpp>
+#include <location_queue.hpp>
+#include <location_scheduler.hpp>
 #include <otf2_handler.hpp>
+#include <position_index.hpp>
+#include <prefetcher.hpp>
+#include <trace_stats.hpp>
 
 extern "C"
 {
@@ -18,13 +26,110 @@ extern "C"
 using reader_deleter = std::function<void(OTF2_Reader *)>;
 using reader_ptr     = std::unique_ptr<OTF2_Reader, reader_deleter>;
 
+/*
+ * Reads the locations a worker takes from the queue, see LocalReader.
+ */
+using local_reader_function = std::function<void(OTF2_Reader *, LocationQueue &, size_t)>;
+
+struct TraceReaderOptions
+{
+    /*
+     * Only handle the global definitions the events depend on, see
+     * Otf2Handler::eventsDependOn(), before reading events. The remaining
+     * definitions are handled by a separate thread while the events are
+     * read.
+     */
+    bool pipelined = false;
+
+    /*
+     * Number of global definitions read at once in the pipelined pass, 0
+     * reads all of them at once.
+     */
+    uint64_t definition_chunk = 4096;
+
+    /*
+     * Number of locations read at the same time, i.e. an upper bound for
+     * the number of workers. 0 for no bound.
+     */
+    std::size_t max_open_locations = 0;
+
+    /*
+     * Let the handler take over the files of locations it does not need
+     * to read, see Otf2Handler::copyLocation().
+     */
+    bool copy_locations = true;
+
+    /*
+     * Let every worker open its own reader on the archive for the events
+     * and local definitions of its locations, instead of sharing the
+     * reader and its locks. Global definitions are still read once.
+     */
+    bool reader_per_worker = false;
+
+    /*
+     * Number of locations whose event and definition files are advised to
+     * the kernel ahead of the workers, see Prefetcher. 0 to not prefetch.
+     */
+    std::size_t prefetch_distance = 0;
+
+    /*
+     * Seek every location to the last sampled event before
+     * Otf2Handler::eventsBegin() instead of decoding all earlier events,
+     * nullptr to read the locations from their start.
+     */
+    const PositionIndex *positions = nullptr;
+
+    /*
+     * Sample the positions of the events read, nullptr to sample none.
+     */
+    PositionIndexRecorder *position_recorder = nullptr;
+
+    /*
+     * Time reading the global definitions, the events and the local
+     * definitions, nullptr to gather no statistics.
+     */
+    TraceStats *stats = nullptr;
+};
+
 class TraceReader
 {
   public:
-    TraceReader(const std::string &path, Otf2Handler &handler, size_t nthreads = std::thread::hardware_concurrency());
+    /*
+     * Events are passed to the handler by virtual calls.
+     */
+    TraceReader(const std::string &       path,
+                Otf2Handler &             handler,
+                size_t                    nthreads = std::thread::hardware_concurrency(),
+                const TraceReaderOptions &options  = TraceReaderOptions());
+
+    /*
+     * Events are passed to a handler of a concrete type by direct calls,
+     * which lets the compiler inline the handler into the decoding
+     * callbacks. A handler whose dynamic type derives from Handler is
+     * called virtually.
+     */
+    template <typename Handler,
+              typename = std::enable_if_t<std::is_base_of_v<Otf2Handler, Handler> &&
+                                          !std::is_same_v<Handler, Otf2Handler>>>
+    TraceReader(const std::string &       path,
+                Handler &                 handler,
+                size_t                    nthreads = std::thread::hardware_concurrency(),
+                const TraceReaderOptions &options  = TraceReaderOptions())
+        : TraceReader(path, handler, nthreads, options, local_reader(handler, options))
+    {
+    }
 
     void
     read();
+
+    /*
+     * Read only the location definitions of a trace.
+     *
+     * @return locations and their announced number of events
+     */
+    static std::vector<LocationWeight>
+    read_locations(const std::string &path);
+
     void
     count()
     {
@@ -37,16 +142,62 @@ class TraceReader
     }
 
   private:
+    TraceReader(const std::string &       path,
+                Otf2Handler &             handler,
+                size_t                    nthreads,
+                const TraceReaderOptions &options,
+                local_reader_function     local_reader);
+
+    template <typename Handler>
+    static local_reader_function
+    local_reader(Handler &handler, const TraceReaderOptions &options)
+    {
+        if constexpr (!std::is_abstract_v<Handler>)
+        {
+            if (typeid(handler) == typeid(Handler))
+            {
+                return LocalReader<Handler>(handler, options.stats, options.positions, options.position_recorder);
+            }
+        }
+        return LocalReader<Otf2Handler>(handler, options.stats, options.positions, options.position_recorder);
+    }
+
     std::size_t m_def_count = 0;
 
+    enum class DefinitionPass
+    {
+        All,
+        EventDependencies,
+        Remaining
+    };
+
+    bool
+    select_definition(GlobalDefinition definition, DefinitionPass pass);
+    void
+    read_definitions(DefinitionPass pass);
+    void
+    read_string_references(const std::vector<GlobalDefinition> &definitions);
+    OTF2_FileSubstrate
+    file_substrate();
+    std::string
+    archive_directory() const;
+    void
+    select_locations();
+    void
+    copy_locations();
+    std::unique_ptr<Prefetcher>
+    start_prefetcher(const LocationSchedule &schedule);
     void
-    read_definitions();
+    read_worker(LocationQueue &queue, const std::vector<OTF2_LocationRef> &assigned, size_t worker);
 
-    Otf2Handler &                 m_handler;
-    reader_ptr                    m_reader;
-    std::size_t                   m_location_count;
-    std::size_t                   m_thread_count;
-    std::vector<OTF2_LocationRef> m_locations;
+    std::string                 m_path;
+    Otf2Handler &               m_handler;
+    reader_ptr                  m_reader;
+    std::size_t                 m_location_count;
+    std::size_t                 m_thread_count;
+    TraceReaderOptions          m_options;
+    std::vector<LocationWeight> m_locations;
+    local_reader_function       m_local_reader;
 
     friend OTF2_CallbackCode
     definition::GlobalLocationCb(void *                userData,
@@ -0,0 +1,150 @@
+#ifndef TRACE_STATS_H
+#define TRACE_STATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <otf2_handler.hpp>
+
+/*
+ * Phases of filtering a trace. Workers read the events and local
+ * definitions of their locations in parallel, the phases overlap.
+ * StringReferences is the pass over the global definitions collecting the
+ * strings to keep, only taken with TraceWriterOptions::referenced_strings.
+ */
+enum class Phase
+{
+    StringReferences,
+    GlobalDefinitions,
+    LocalDefinitions,
+    Events,
+    Close
+};
+
+constexpr std::size_t number_of_phases = 5;
+
+struct PhaseStats
+{
+    double wall_time = 0;
+    double cpu_time  = 0;
+
+    /*
+     * High-water mark of the resident set of the process at the end of
+     * the phase, in KiB.
+     */
+    uint64_t peak_rss = 0;
+};
+
+/*
+ * Events of each type, indexed by EventType. Written events are counted
+ * by the writer, they include records it adds to balance the time window
+ * and exclude filtered ones it drops.
+ */
+struct EventCounters
+{
+    std::array<uint64_t, number_of_event_types> read{};
+    std::array<uint64_t, number_of_event_types> filtered{};
+    std::array<uint64_t, number_of_event_types> written{};
+};
+
+/*
+ * Statistics gathered by one thread.
+ */
+struct ThreadStats
+{
+    EventCounters                            events;
+    std::array<PhaseStats, number_of_phases> phases;
+};
+
+/*
+ * Statistics of one run, reported with --stats.
+ *
+ * Counters and times are kept per thread and only merged when they are
+ * reported, counting an event needs neither a lock nor an atomic
+ * operation. A phase run by several threads at once reports the longest
+ * wall time of them and the sum of their CPU times.
+ */
+class TraceStats
+{
+  public:
+    TraceStats();
+
+    /*
+     * Statistics of the calling thread, valid as long as these.
+     */
+    ThreadStats &
+    thread_stats();
+
+    /*
+     * Merge the statistics of all threads. Call them once no thread
+     * counts events anymore.
+     */
+    EventCounters
+    events() const;
+    PhaseStats
+    phase(Phase phase) const;
+
+    void
+    add_copied_location();
+
+    /*
+     * Count a worker reading with a reader of its own, see
+     * TraceReaderOptions::reader_per_worker, or with the shared reader if
+     * it could not open the archive again.
+     */
+    void
+    add_worker_reader(bool own);
+    uint64_t
+    worker_readers() const;
+    uint64_t
+    shared_reader_fallbacks() const;
+
+    void
+    set_filtered_files(std::vector<std::string> files);
+
+    /*
+     * Write a table for humans or a JSON object.
+     */
+    void
+    write_text(std::ostream &out) const;
+    void
+    write_json(std::ostream &out) const;
+
+  private:
+    uint64_t                                  m_id;
+    mutable std::mutex                        m_mutex;
+    std::vector<std::unique_ptr<ThreadStats>> m_threads;
+    uint64_t                                  m_copied_locations = 0;
+    uint64_t                                  m_worker_readers   = 0;
+    uint64_t                                  m_shared_readers   = 0;
+    std::vector<std::string>                  m_filtered_files;
+};
+
+/*
+ * Measures the calling thread from construction to destruction and adds
+ * the time to a phase. Does nothing without statistics.
+ */
+class PhaseTimer
+{
+  public:
+    PhaseTimer(TraceStats *stats, Phase phase);
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &
+    operator=(const PhaseTimer &) = delete;
+
+  private:
+    TraceStats *m_stats;
+    Phase       m_phase;
+    double      m_wall_start = 0;
+    double      m_cpu_start  = 0;
+};
+
+#endif /* TRACE_STATS_H */
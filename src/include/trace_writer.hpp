@@ -1,20 +1,30 @@
 #ifndef TRACE_WRITER_H
 #define TRACE_WRITER_H
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <otf2/OTF2_GeneralDefinitions.h>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 extern "C"
 {
 #include <otf2/otf2.h>
 }
 
+#include <chunk_pool.hpp>
 #include <filter.hpp>
+#include <location_scheduler.hpp>
+#include <open_events.hpp>
 #include <otf2_handler.hpp>
+#include <string_table.hpp>
+#include <trace_stats.hpp>
 
 using archive_deleter = std::function<void(OTF2_Archive *)>;
 using archive_ptr     = std::unique_ptr<OTF2_Archive, archive_deleter>;
@@ -22,6 +32,94 @@ using archive_ptr     = std::unique_ptr<OTF2_Archive, archive_deleter>;
 using event_writer_deleter = std::function<void(OTF2_EvtWriter *)>;
 using event_writer_ptr     = std::unique_ptr<OTF2_EvtWriter, event_writer_deleter>;
 
+/*
+ * Chunk sizes accepted by OTF2_Archive_Open().
+ */
+inline constexpr uint64_t min_chunk_size = 256 * 1024;
+inline constexpr uint64_t max_chunk_size = 16 * 1024 * 1024;
+
+/*
+ * Layout of the written archive.
+ */
+struct TraceWriterOptions
+{
+    OTF2_Compression compression = OTF2_COMPRESSION_NONE;
+
+    /*
+     * Size of the chunks events are buffered in, every location with
+     * events holds at least one. See event_chunk_size() for deriving it
+     * from the input trace. Chunk sizes have to lie between
+     * min_chunk_size and max_chunk_size.
+     */
+    uint64_t event_chunk_size = 1024 * 1024;
+
+    uint64_t definition_chunk_size = 4 * 1024 * 1024;
+
+    /*
+     * Recycle chunks between the writers of a thread, see ChunkPool.
+     */
+    bool pool_chunks = true;
+
+    /*
+     * Back pooled chunks with transparent huge pages.
+     */
+    bool huge_pages = false;
+
+    /*
+     * Bytes the chunks of the archive may use, 0 for no limit. With a
+     * limit, chunks are always pooled, writers of a location only exist
+     * while it is read and buffers are flushed once the limit is reached.
+     * The number of locations read at once has to be bounded as well, see
+     * open_location_limit().
+     */
+    uint64_t memory_limit = 0;
+
+    /*
+     * Only keep the strings the registered filters resolve, e.g. file
+     * names, instead of every string of the trace. Costs a pass over the
+     * global definitions before reading, for traces whose strings do not
+     * fit into memory.
+     */
+    bool referenced_strings = false;
+
+    /*
+     * Count the handled events and time closing the archive, nullptr to
+     * gather no statistics. Has to outlive the writer.
+     */
+    TraceStats *stats = nullptr;
+};
+
+/*
+ * Event chunk size fitting the number of events announced by the
+ * locations, e.g. read with TraceReader::read_locations().
+ *
+ * A chunk holds the events of an average location, rounded up to a power
+ * of two and within the limits OTF2 accepts. Traces with many small
+ * locations get small chunks, traces with few large locations write in
+ * large blocks.
+ */
+uint64_t
+event_chunk_size(const std::vector<LocationWeight> &locations);
+
+/*
+ * Number of locations whose writers fit into the memory limit at once, each
+ * needs an event and a definition chunk.
+ *
+ * @return 0 if the options do not limit the memory
+ */
+std::size_t
+open_location_limit(const TraceWriterOptions &options);
+
+/*
+ * Writes all handled records into a new archive.
+ *
+ * Global definitions are handled by the thread reading them. Events of a
+ * location are enclosed by beginLocation() and endLocation() and handled
+ * by one worker at a time. That worker owns the event writer of the
+ * location while it reads it, so writing an event needs neither an archive
+ * lookup nor a lock. The remaining shared state of the archive, e.g.
+ * creating writers, is guarded by OTF2 locking callbacks.
+ */
 class TraceWriter : public Otf2Handler
 {
   public:
@@ -29,8 +127,10 @@ class TraceWriter : public Otf2Handler
      * Initialize OTF2 archive, event and definition writer.
      *
      * @param path specify the folder of trace to be written
+     * @param options compression and chunk sizes of the archive
+     * @throws std::runtime_error if the archive cannot be created
      */
-    TraceWriter(const std::string &path);
+    TraceWriter(const std::string &path, const TraceWriterOptions &options = TraceWriterOptions());
     virtual ~TraceWriter();
 
     constexpr const char *
@@ -825,128 +925,2768 @@ class TraceWriter : public Otf2Handler
                           OTF2_AttributeList *attributes,
                           int64_t             exitStatus) override;
 
+    virtual void
+    beginLocation(OTF2_LocationRef location) override;
+
+    virtual void
+    endLocation(OTF2_LocationRef location) override;
+
+    virtual void
+    endLocalDefinitions(OTF2_LocationRef location) override;
+
+    /*
+     * Register the callbacks of a filter.
+     *
+     * Callbacks of filters registered with a lower priority value are
+     * evaluated first, see Filter<T>. A record is dropped by the first
+     * callback returning true.
+     */
     void
-    register_filter(IFilterCallbacks &filter);
+    register_filter(IFilterCallbacks &filter, int priority = 0);
 
-  private:
-    static OTF2_FlushCallbacks           m_flush_callbacks;
-    archive_ptr                          m_archive;
-    OTF2_GlobalDefWriter *               m_def_writer;
-    std::unordered_set<OTF2_LocationRef> m_locations;
+    /*
+     * Strings of the trace, shared by all registered filters.
+     */
+    inline StringTable &
+    string_table()
+    {
+        return m_strings;
+    }
 
-    Filter<GlobalClockPropertiesFilter>         m_global_ClockProperties_filter;
-    Filter<GlobalParadigmFilter>                m_global_Paradigm_filter;
-    Filter<GlobalParadigmPropertyFilter>        m_global_ParadigmProperty_filter;
-    Filter<GlobalIoParadigmFilter>              m_global_IoParadigm_filter;
-    Filter<GlobalStringFilter>                  m_global_String_filter;
-    Filter<GlobalAttributeFilter>               m_global_Attribute_filter;
-    Filter<GlobalSystemTreeNodeFilter>          m_global_SystemTreeNode_filter;
-    Filter<GlobalLocationGroupFilter>           m_global_LocationGroup_filter;
-    Filter<GlobalLocationFilter>                m_global_Location_filter;
-    Filter<GlobalRegionFilter>                  m_global_Region_filter;
-    Filter<GlobalCallsiteFilter>                m_global_Callsite_filter;
-    Filter<GlobalCallpathFilter>                m_global_Callpath_filter;
-    Filter<GlobalGroupFilter>                   m_global_Group_filter;
-    Filter<GlobalMetricMemberFilter>            m_global_MetricMember_filter;
-    Filter<GlobalMetricClassFilter>             m_global_MetricClass_filter;
-    Filter<GlobalMetricInstanceFilter>          m_global_MetricInstance_filter;
-    Filter<GlobalCommFilter>                    m_global_Comm_filter;
-    Filter<GlobalParameterFilter>               m_global_Parameter_filter;
-    Filter<GlobalRmaWinFilter>                  m_global_RmaWin_filter;
-    Filter<GlobalMetricClassRecorderFilter>     m_global_MetricClassRecorder_filter;
-    Filter<GlobalSystemTreeNodePropertyFilter>  m_global_SystemTreeNodeProperty_filter;
-    Filter<GlobalSystemTreeNodeDomainFilter>    m_global_SystemTreeNodeDomain_filter;
-    Filter<GlobalLocationGroupPropertyFilter>   m_global_LocationGroupProperty_filter;
-    Filter<GlobalLocationPropertyFilter>        m_global_LocationProperty_filter;
-    Filter<GlobalCartDimensionFilter>           m_global_CartDimension_filter;
-    Filter<GlobalCartTopologyFilter>            m_global_CartTopology_filter;
-    Filter<GlobalCartCoordinateFilter>          m_global_CartCoordinate_filter;
-    Filter<GlobalSourceCodeLocationFilter>      m_global_SourceCodeLocation_filter;
-    Filter<GlobalCallingContextFilter>          m_global_CallingContext_filter;
-    Filter<GlobalCallingContextPropertyFilter>  m_global_CallingContextProperty_filter;
-    Filter<GlobalInterruptGeneratorFilter>      m_global_InterruptGenerator_filter;
-    Filter<GlobalIoFilePropertyFilter>          m_global_IoFileProperty_filter;
-    Filter<GlobalIoRegularFileFilter>           m_global_IoRegularFile_filter;
-    Filter<GlobalIoDirectoryFilter>             m_global_IoDirectory_filter;
-    Filter<GlobalIoHandleFilter>                m_global_IoHandle_filter;
-    Filter<GlobalIoPreCreatedHandleStateFilter> m_global_IoPreCreatedHandleState_filter;
-    Filter<GlobalCallpathParameterFilter>       m_global_CallpathParameter_filter;
+    virtual std::vector<GlobalDefinition>
+    stringReferencingDefinitions() override;
 
-    Filter<EventBufferFlushFilter>              m_event_BufferFlush_filter;
-    Filter<EventMeasurementOnOffFilter>         m_event_MeasurementOnOff_filter;
-    Filter<EventEnterFilter>                    m_event_Enter_filter;
-    Filter<EventLeaveFilter>                    m_event_Leave_filter;
-    Filter<EventMpiSendFilter>                  m_event_MpiSend_filter;
-    Filter<EventMpiIsendFilter>                 m_event_MpiIsend_filter;
-    Filter<EventMpiIsendCompleteFilter>         m_event_MpiIsendComplete_filter;
-    Filter<EventMpiIrecvRequestFilter>          m_event_MpiIrecvRequest_filter;
-    Filter<EventMpiRecvFilter>                  m_event_MpiRecv_filter;
-    Filter<EventMpiIrecvFilter>                 m_event_MpiIrecv_filter;
-    Filter<EventMpiRequestTestFilter>           m_event_MpiRequestTest_filter;
-    Filter<EventMpiRequestCancelledFilter>      m_event_MpiRequestCancelled_filter;
-    Filter<EventMpiCollectiveBeginFilter>       m_event_MpiCollectiveBegin_filter;
-    Filter<EventMpiCollectiveEndFilter>         m_event_MpiCollectiveEnd_filter;
-    Filter<EventOmpForkFilter>                  m_event_OmpFork_filter;
-    Filter<EventOmpJoinFilter>                  m_event_OmpJoin_filter;
-    Filter<EventOmpAcquireLockFilter>           m_event_OmpAcquireLock_filter;
-    Filter<EventOmpReleaseLockFilter>           m_event_OmpReleaseLock_filter;
-    Filter<EventOmpTaskCreateFilter>            m_event_OmpTaskCreate_filter;
-    Filter<EventOmpTaskSwitchFilter>            m_event_OmpTaskSwitch_filter;
-    Filter<EventOmpTaskCompleteFilter>          m_event_OmpTaskComplete_filter;
-    Filter<EventMetricFilter>                   m_event_Metric_filter;
-    Filter<EventParameterStringFilter>          m_event_ParameterString_filter;
-    Filter<EventParameterIntFilter>             m_event_ParameterInt_filter;
-    Filter<EventParameterUnsignedIntFilter>     m_event_ParameterUnsignedInt_filter;
-    Filter<EventRmaWinCreateFilter>             m_event_RmaWinCreate_filter;
-    Filter<EventRmaWinDestroyFilter>            m_event_RmaWinDestroy_filter;
-    Filter<EventRmaCollectiveBeginFilter>       m_event_RmaCollectiveBegin_filter;
-    Filter<EventRmaCollectiveEndFilter>         m_event_RmaCollectiveEnd_filter;
-    Filter<EventRmaGroupSyncFilter>             m_event_RmaGroupSync_filter;
-    Filter<EventRmaRequestLockFilter>           m_event_RmaRequestLock_filter;
-    Filter<EventRmaAcquireLockFilter>           m_event_RmaAcquireLock_filter;
-    Filter<EventRmaTryLockFilter>               m_event_RmaTryLock_filter;
-    Filter<EventRmaReleaseLockFilter>           m_event_RmaReleaseLock_filter;
-    Filter<EventRmaSyncFilter>                  m_event_RmaSync_filter;
-    Filter<EventRmaWaitChangeFilter>            m_event_RmaWaitChange_filter;
-    Filter<EventRmaPutFilter>                   m_event_RmaPut_filter;
-    Filter<EventRmaGetFilter>                   m_event_RmaGet_filter;
-    Filter<EventRmaAtomicFilter>                m_event_RmaAtomic_filter;
-    Filter<EventRmaOpCompleteBlockingFilter>    m_event_RmaOpCompleteBlocking_filter;
-    Filter<EventRmaOpCompleteNonBlockingFilter> m_event_RmaOpCompleteNonBlocking_filter;
-    Filter<EventRmaOpTestFilter>                m_event_RmaOpTest_filter;
-    Filter<EventRmaOpCompleteRemoteFilter>      m_event_RmaOpCompleteRemote_filter;
-    Filter<EventThreadForkFilter>               m_event_ThreadFork_filter;
-    Filter<EventThreadJoinFilter>               m_event_ThreadJoin_filter;
-    Filter<EventThreadTeamBeginFilter>          m_event_ThreadTeamBegin_filter;
-    Filter<EventThreadTeamEndFilter>            m_event_ThreadTeamEnd_filter;
-    Filter<EventThreadAcquireLockFilter>        m_event_ThreadAcquireLock_filter;
-    Filter<EventThreadReleaseLockFilter>        m_event_ThreadReleaseLock_filter;
-    Filter<EventThreadTaskCreateFilter>         m_event_ThreadTaskCreate_filter;
-    Filter<EventThreadTaskSwitchFilter>         m_event_ThreadTaskSwitch_filter;
-    Filter<EventThreadTaskCompleteFilter>       m_event_ThreadTaskComplete_filter;
-    Filter<EventThreadCreateFilter>             m_event_ThreadCreate_filter;
-    Filter<EventThreadBeginFilter>              m_event_ThreadBegin_filter;
-    Filter<EventThreadWaitFilter>               m_event_ThreadWait_filter;
-    Filter<EventThreadEndFilter>                m_event_ThreadEnd_filter;
-    Filter<EventCallingContextEnterFilter>      m_event_CallingContextEnter_filter;
-    Filter<EventCallingContextLeaveFilter>      m_event_CallingContextLeave_filter;
-    Filter<EventCallingContextSampleFilter>     m_event_CallingContextSample_filter;
-    Filter<EventIoCreateHandleFilter>           m_event_IoCreateHandle_filter;
-    Filter<EventIoDestroyHandleFilter>          m_event_IoDestroyHandle_filter;
-    Filter<EventIoDuplicateHandleFilter>        m_event_IoDuplicateHandle_filter;
-    Filter<EventIoSeekFilter>                   m_event_IoSeek_filter;
-    Filter<EventIoChangeStatusFlagsFilter>      m_event_IoChangeStatusFlags_filter;
-    Filter<EventIoDeleteFileFilter>             m_event_IoDeleteFile_filter;
-    Filter<EventIoOperationBeginFilter>         m_event_IoOperationBegin_filter;
-    Filter<EventIoOperationTestFilter>          m_event_IoOperationTest_filter;
-    Filter<EventIoOperationIssuedFilter>        m_event_IoOperationIssued_filter;
-    Filter<EventIoOperationCompleteFilter>      m_event_IoOperationComplete_filter;
-    Filter<EventIoOperationCancelledFilter>     m_event_IoOperationCancelled_filter;
-    Filter<EventIoAcquireLockFilter>            m_event_IoAcquireLock_filter;
-    Filter<EventIoReleaseLockFilter>            m_event_IoReleaseLock_filter;
-    Filter<EventIoTryLockFilter>                m_event_IoTryLock_filter;
-    Filter<EventProgramBeginFilter>             m_event_ProgramBegin_filter;
-    Filter<EventProgramEndFilter>               m_event_ProgramEnd_filter;
-};
+    virtual void
+    handleStringReference(GlobalDefinition definition, OTF2_StringRef string) override;
+
+    virtual bool
+    eventsDependOn(GlobalDefinition definition) override;
+
+    /*
+     * Begin and end of the time window of the registered filters.
+     */
+    virtual OTF2_TimeStamp
+    eventsBegin() override;
+    virtual OTF2_TimeStamp
+    eventsEnd() override;
+
+    /*
+     * Collective and I/O operations begun in the time window are read past
+     * its end, their end is written at it.
+     */
+    virtual bool
+    readsPastEnd(OTF2_LocationRef location) override;
+
+    /*
+     * Copy the event and local definition files of a location no filter
+     * affects, see filters_location(). Only uncompressed files split into
+     * chunks of the sizes of this archive are copied.
+     */
+    virtual bool
+    copyLocation(const ArchiveLayout &input, OTF2_LocationRef location) override;
+
+    /*
+     * Locations whose definition a filter dropped are not read.
+     */
+    virtual bool
+    selectsLocation(OTF2_LocationRef location) override;
+
+    /*
+     * Event types a filter drops as a whole are not decoded, see
+     * IFilterCallbacks::dropped_event_types().
+     */
+    virtual bool
+    handlesEvent(EventType type) override;
+
+  protected:
+    /*
+     * Write records to the archive, without applying any filter. Writers
+     * keep the global definitions consistent through them: the clock
+     * properties are shrunk to the time window, written locations get an
+     * event writer and definitions of locations dropped by
+     * drop_location() are left out or pruned. Attribute values of dropped
+     * types are removed from the events.
+     */
+
+    void
+    writeGlobalClockProperties(uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength);
+
+    void
+    writeGlobalParadigm(OTF2_Paradigm paradigm, OTF2_StringRef name, OTF2_ParadigmClass paradigmClass);
+
+    void
+    writeGlobalParadigmProperty(OTF2_Paradigm         paradigm,
+                                OTF2_ParadigmProperty property,
+                                OTF2_Type             type,
+                                OTF2_AttributeValue   value);
+
+    void
+    writeGlobalIoParadigm(OTF2_IoParadigmRef             self,
+                          OTF2_StringRef                 identification,
+                          OTF2_StringRef                 name,
+                          OTF2_IoParadigmClass           ioParadigmClass,
+                          OTF2_IoParadigmFlag            ioParadigmFlags,
+                          uint8_t                        numberOfProperties,
+                          const OTF2_IoParadigmProperty *properties,
+                          const OTF2_Type *              types,
+                          const OTF2_AttributeValue *    values);
+
+    void
+    writeGlobalString(OTF2_StringRef self, const char *string);
+
+    void
+    writeGlobalAttribute(OTF2_AttributeRef self, OTF2_StringRef name, OTF2_StringRef description, OTF2_Type type);
+
+    void
+    writeGlobalSystemTreeNode(OTF2_SystemTreeNodeRef self,
+                              OTF2_StringRef         name,
+                              OTF2_StringRef         className,
+                              OTF2_SystemTreeNodeRef parent);
+
+    void
+    writeGlobalLocationGroup(OTF2_LocationGroupRef  self,
+                             OTF2_StringRef         name,
+                             OTF2_LocationGroupType locationGroupType,
+                             OTF2_SystemTreeNodeRef systemTreeParent);
+
+    void
+    writeGlobalLocation(OTF2_LocationRef      self,
+                        OTF2_StringRef        name,
+                        OTF2_LocationType     locationType,
+                        uint64_t              numberOfEvents,
+                        OTF2_LocationGroupRef locationGroup);
+
+    void
+    writeGlobalRegion(OTF2_RegionRef  self,
+                      OTF2_StringRef  name,
+                      OTF2_StringRef  canonicalName,
+                      OTF2_StringRef  description,
+                      OTF2_RegionRole regionRole,
+                      OTF2_Paradigm   paradigm,
+                      OTF2_RegionFlag regionFlags,
+                      OTF2_StringRef  sourceFile,
+                      uint32_t        beginLineNumber,
+                      uint32_t        endLineNumber);
+
+    void
+    writeGlobalCallsite(OTF2_CallsiteRef self,
+                        OTF2_StringRef   sourceFile,
+                        uint32_t         lineNumber,
+                        OTF2_RegionRef   enteredRegion,
+                        OTF2_RegionRef   leftRegion);
+
+    void
+    writeGlobalCallpath(OTF2_CallpathRef self, OTF2_CallpathRef parent, OTF2_RegionRef region);
+
+    void
+    writeGlobalGroup(OTF2_GroupRef   self,
+                     OTF2_StringRef  name,
+                     OTF2_GroupType  groupType,
+                     OTF2_Paradigm   paradigm,
+                     OTF2_GroupFlag  groupFlags,
+                     uint32_t        numberOfMembers,
+                     const uint64_t *members);
+
+    void
+    writeGlobalMetricMember(OTF2_MetricMemberRef self,
+                            OTF2_StringRef       name,
+                            OTF2_StringRef       description,
+                            OTF2_MetricType      metricType,
+                            OTF2_MetricMode      metricMode,
+                            OTF2_Type            valueType,
+                            OTF2_Base            base,
+                            int64_t              exponent,
+                            OTF2_StringRef       unit);
+
+    void
+    writeGlobalMetricClass(OTF2_MetricRef              self,
+                           uint8_t                     numberOfMetrics,
+                           const OTF2_MetricMemberRef *metricMembers,
+                           OTF2_MetricOccurrence       metricOccurrence,
+                           OTF2_RecorderKind           recorderKind);
+
+    void
+    writeGlobalMetricInstance(OTF2_MetricRef   self,
+                              OTF2_MetricRef   metricClass,
+                              OTF2_LocationRef recorder,
+                              OTF2_MetricScope metricScope,
+                              uint64_t         scope);
+
+    void
+    writeGlobalComm(OTF2_CommRef self, OTF2_StringRef name, OTF2_GroupRef group, OTF2_CommRef parent);
+
+    void
+    writeGlobalParameter(OTF2_ParameterRef self, OTF2_StringRef name, OTF2_ParameterType parameterType);
+
+    void
+    writeGlobalRmaWin(OTF2_RmaWinRef self, OTF2_StringRef name, OTF2_CommRef comm);
+
+    void
+    writeGlobalMetricClassRecorder(OTF2_MetricRef metric, OTF2_LocationRef recorder);
+
+    void
+    writeGlobalSystemTreeNodeProperty(OTF2_SystemTreeNodeRef systemTreeNode,
+                                      OTF2_StringRef         name,
+                                      OTF2_Type              type,
+                                      OTF2_AttributeValue    value);
+
+    void
+    writeGlobalSystemTreeNodeDomain(OTF2_SystemTreeNodeRef systemTreeNode, OTF2_SystemTreeDomain systemTreeDomain);
+
+    void
+    writeGlobalLocationGroupProperty(OTF2_LocationGroupRef locationGroup,
+                                     OTF2_StringRef        name,
+                                     OTF2_Type             type,
+                                     OTF2_AttributeValue   value);
+
+    void
+    writeGlobalLocationProperty(OTF2_LocationRef    location,
+                                OTF2_StringRef      name,
+                                OTF2_Type           type,
+                                OTF2_AttributeValue value);
+
+    void
+    writeGlobalCartDimension(OTF2_CartDimensionRef self,
+                             OTF2_StringRef        name,
+                             uint32_t              size,
+                             OTF2_CartPeriodicity  cartPeriodicity);
+
+    void
+    writeGlobalCartTopology(OTF2_CartTopologyRef         self,
+                            OTF2_StringRef               name,
+                            OTF2_CommRef                 communicator,
+                            uint8_t                      numberOfDimensions,
+                            const OTF2_CartDimensionRef *cartDimensions);
+
+    void
+    writeGlobalCartCoordinate(OTF2_CartTopologyRef cartTopology,
+                              uint32_t             rank,
+                              uint8_t              numberOfDimensions,
+                              const uint32_t *     coordinates);
+
+    void
+    writeGlobalSourceCodeLocation(OTF2_SourceCodeLocationRef self, OTF2_StringRef file, uint32_t lineNumber);
+
+    void
+    writeGlobalCallingContext(OTF2_CallingContextRef     self,
+                              OTF2_RegionRef             region,
+                              OTF2_SourceCodeLocationRef sourceCodeLocation,
+                              OTF2_CallingContextRef     parent);
+
+    void
+    writeGlobalCallingContextProperty(OTF2_CallingContextRef callingContext,
+                                      OTF2_StringRef         name,
+                                      OTF2_Type              type,
+                                      OTF2_AttributeValue    value);
+
+    void
+    writeGlobalInterruptGenerator(OTF2_InterruptGeneratorRef  self,
+                                  OTF2_StringRef              name,
+                                  OTF2_InterruptGeneratorMode interruptGeneratorMode,
+                                  OTF2_Base                   base,
+                                  int64_t                     exponent,
+                                  uint64_t                    period);
+
+    void
+    writeGlobalIoFileProperty(OTF2_IoFileRef ioFile, OTF2_StringRef name, OTF2_Type type, OTF2_AttributeValue value);
+
+    void
+    writeGlobalIoRegularFile(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope);
+
+    void
+    writeGlobalIoDirectory(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope);
+
+    void
+    writeGlobalIoHandle(OTF2_IoHandleRef   self,
+                        OTF2_StringRef     name,
+                        OTF2_IoFileRef     file,
+                        OTF2_IoParadigmRef ioParadigm,
+                        OTF2_IoHandleFlag  ioHandleFlags,
+                        OTF2_CommRef       comm,
+                        OTF2_IoHandleRef   parent);
+
+    void
+    writeGlobalIoPreCreatedHandleState(OTF2_IoHandleRef  ioHandle,
+                                       OTF2_IoAccessMode mode,
+                                       OTF2_IoStatusFlag statusFlags);
+
+    void
+    writeGlobalCallpathParameter(OTF2_CallpathRef    callpath,
+                                 OTF2_ParameterRef   parameter,
+                                 OTF2_Type           type,
+                                 OTF2_AttributeValue value);
+
+    void
+    writeBufferFlushEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_TimeStamp      stopTime);
+
+    void
+    writeMeasurementOnOffEvent(OTF2_LocationRef     location,
+                               OTF2_TimeStamp       time,
+                               OTF2_AttributeList * attributes,
+                               OTF2_MeasurementMode measurementMode);
+
+    void
+    writeEnterEvent(OTF2_LocationRef    location,
+                    OTF2_TimeStamp      time,
+                    OTF2_AttributeList *attributes,
+                    OTF2_RegionRef      region);
+
+    void
+    writeLeaveEvent(OTF2_LocationRef    location,
+                    OTF2_TimeStamp      time,
+                    OTF2_AttributeList *attributes,
+                    OTF2_RegionRef      region);
+
+    void
+    writeMpiSendEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      uint32_t            receiver,
+                      OTF2_CommRef        communicator,
+                      uint32_t            msgTag,
+                      uint64_t            msgLength);
+
+    void
+    writeMpiIsendEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            receiver,
+                       OTF2_CommRef        communicator,
+                       uint32_t            msgTag,
+                       uint64_t            msgLength,
+                       uint64_t            requestID);
+
+    void
+    writeMpiIsendCompleteEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint64_t            requestID);
+
+    void
+    writeMpiIrecvRequestEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint64_t            requestID);
+
+    void
+    writeMpiRecvEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      uint32_t            sender,
+                      OTF2_CommRef        communicator,
+                      uint32_t            msgTag,
+                      uint64_t            msgLength);
+
+    void
+    writeMpiIrecvEvent(OTF2_LocationRef    location,
+                       OTF2_TimeStamp      time,
+                       OTF2_AttributeList *attributes,
+                       uint32_t            sender,
+                       OTF2_CommRef        communicator,
+                       uint32_t            msgTag,
+                       uint64_t            msgLength,
+                       uint64_t            requestID);
+
+    void
+    writeMpiRequestTestEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint64_t            requestID);
+
+    void
+    writeMpiRequestCancelledEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  uint64_t            requestID);
+
+    void
+    writeMpiCollectiveBeginEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes);
+
+    void
+    writeMpiCollectiveEndEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_CollectiveOp   collectiveOp,
+                               OTF2_CommRef        communicator,
+                               uint32_t            root,
+                               uint64_t            sizeSent,
+                               uint64_t            sizeReceived);
+
+    void
+    writeOmpForkEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      uint32_t            numberOfRequestedThreads);
+
+    void
+    writeOmpJoinEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes);
+
+    void
+    writeOmpAcquireLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint32_t            lockID,
+                             uint32_t            acquisitionOrder);
+
+    void
+    writeOmpReleaseLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             uint32_t            lockID,
+                             uint32_t            acquisitionOrder);
+
+    void
+    writeOmpTaskCreateEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            uint64_t            taskID);
+
+    void
+    writeOmpTaskSwitchEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            uint64_t            taskID);
+
+    void
+    writeOmpTaskCompleteEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              uint64_t            taskID);
+
+    void
+    writeMetricEvent(OTF2_LocationRef        location,
+                     OTF2_TimeStamp          time,
+                     OTF2_AttributeList *    attributes,
+                     OTF2_MetricRef          metric,
+                     uint8_t                 numberOfMetrics,
+                     const OTF2_Type *       typeIDs,
+                     const OTF2_MetricValue *metricValues);
+
+    void
+    writeParameterStringEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_ParameterRef   parameter,
+                              OTF2_StringRef      string);
+
+    void
+    writeParameterIntEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_ParameterRef   parameter,
+                           int64_t             value);
+
+    void
+    writeParameterUnsignedIntEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_ParameterRef   parameter,
+                                   uint64_t            value);
+
+    void
+    writeRmaWinCreateEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_RmaWinRef      win);
+
+    void
+    writeRmaWinDestroyEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_RmaWinRef      win);
+
+    void
+    writeRmaCollectiveBeginEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes);
+
+    void
+    writeRmaCollectiveEndEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_CollectiveOp   collectiveOp,
+                               OTF2_RmaSyncLevel   syncLevel,
+                               OTF2_RmaWinRef      win,
+                               uint32_t            root,
+                               uint64_t            bytesSent,
+                               uint64_t            bytesReceived);
+
+    void
+    writeRmaGroupSyncEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_RmaSyncLevel   syncLevel,
+                           OTF2_RmaWinRef      win,
+                           OTF2_GroupRef       group);
+
+    void
+    writeRmaRequestLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win,
+                             uint32_t            remote,
+                             uint64_t            lockId,
+                             OTF2_LockType       lockType);
+
+    void
+    writeRmaAcquireLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win,
+                             uint32_t            remote,
+                             uint64_t            lockId,
+                             OTF2_LockType       lockType);
+
+    void
+    writeRmaTryLockEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_RmaWinRef      win,
+                         uint32_t            remote,
+                         uint64_t            lockId,
+                         OTF2_LockType       lockType);
+
+    void
+    writeRmaReleaseLockEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RmaWinRef      win,
+                             uint32_t            remote,
+                             uint64_t            lockId);
+
+    void
+    writeRmaSyncEvent(OTF2_LocationRef    location,
+                      OTF2_TimeStamp      time,
+                      OTF2_AttributeList *attributes,
+                      OTF2_RmaWinRef      win,
+                      uint32_t            remote,
+                      OTF2_RmaSyncType    syncType);
+
+    void
+    writeRmaWaitChangeEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_RmaWinRef      win);
+
+    void
+    writeRmaPutEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RmaWinRef      win,
+                     uint32_t            remote,
+                     uint64_t            bytes,
+                     uint64_t            matchingId);
+
+    void
+    writeRmaGetEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RmaWinRef      win,
+                     uint32_t            remote,
+                     uint64_t            bytes,
+                     uint64_t            matchingId);
+
+    void
+    writeRmaAtomicEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        OTF2_RmaWinRef      win,
+                        uint32_t            remote,
+                        OTF2_RmaAtomicType  type,
+                        uint64_t            bytesSent,
+                        uint64_t            bytesReceived,
+                        uint64_t            matchingId);
+
+    void
+    writeRmaOpCompleteBlockingEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_RmaWinRef      win,
+                                    uint64_t            matchingId);
+
+    void
+    writeRmaOpCompleteNonBlockingEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_RmaWinRef      win,
+                                       uint64_t            matchingId);
+
+    void
+    writeRmaOpTestEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        OTF2_RmaWinRef      win,
+                        uint64_t            matchingId);
+
+    void
+    writeRmaOpCompleteRemoteEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_RmaWinRef      win,
+                                  uint64_t            matchingId);
+
+    void
+    writeThreadForkEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_Paradigm       model,
+                         uint32_t            numberOfRequestedThreads);
+
+    void
+    writeThreadJoinEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_Paradigm       model);
+
+    void
+    writeThreadTeamBeginEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_CommRef        threadTeam);
+
+    void
+    writeThreadTeamEndEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_CommRef        threadTeam);
+
+    void
+    writeThreadAcquireLockEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_Paradigm       model,
+                                uint32_t            lockID,
+                                uint32_t            acquisitionOrder);
+
+    void
+    writeThreadReleaseLockEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_Paradigm       model,
+                                uint32_t            lockID,
+                                uint32_t            acquisitionOrder);
+
+    void
+    writeThreadTaskCreateEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_CommRef        threadTeam,
+                               uint32_t            creatingThread,
+                               uint32_t            generationNumber);
+
+    void
+    writeThreadTaskSwitchEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_CommRef        threadTeam,
+                               uint32_t            creatingThread,
+                               uint32_t            generationNumber);
+
+    void
+    writeThreadTaskCompleteEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_CommRef        threadTeam,
+                                 uint32_t            creatingThread,
+                                 uint32_t            generationNumber);
+
+    void
+    writeThreadCreateEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_CommRef        threadContingent,
+                           uint64_t            sequenceCount);
+
+    void
+    writeThreadBeginEvent(OTF2_LocationRef    location,
+                          OTF2_TimeStamp      time,
+                          OTF2_AttributeList *attributes,
+                          OTF2_CommRef        threadContingent,
+                          uint64_t            sequenceCount);
+
+    void
+    writeThreadWaitEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         OTF2_CommRef        threadContingent,
+                         uint64_t            sequenceCount);
+
+    void
+    writeThreadEndEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        OTF2_CommRef        threadContingent,
+                        uint64_t            sequenceCount);
+
+    void
+    writeCallingContextEnterEvent(OTF2_LocationRef       location,
+                                  OTF2_TimeStamp         time,
+                                  OTF2_AttributeList *   attributes,
+                                  OTF2_CallingContextRef callingContext,
+                                  uint32_t               unwindDistance);
+
+    void
+    writeCallingContextLeaveEvent(OTF2_LocationRef       location,
+                                  OTF2_TimeStamp         time,
+                                  OTF2_AttributeList *   attributes,
+                                  OTF2_CallingContextRef callingContext);
+
+    void
+    writeCallingContextSampleEvent(OTF2_LocationRef           location,
+                                   OTF2_TimeStamp             time,
+                                   OTF2_AttributeList *       attributes,
+                                   OTF2_CallingContextRef     callingContext,
+                                   uint32_t                   unwindDistance,
+                                   OTF2_InterruptGeneratorRef interruptGenerator);
+
+    void
+    writeIoCreateHandleEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_IoHandleRef    handle,
+                             OTF2_IoAccessMode   mode,
+                             OTF2_IoCreationFlag creationFlags,
+                             OTF2_IoStatusFlag   statusFlags);
+
+    void
+    writeIoDestroyHandleEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_IoHandleRef    handle);
+
+    void
+    writeIoDuplicateHandleEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_IoHandleRef    oldHandle,
+                                OTF2_IoHandleRef    newHandle,
+                                OTF2_IoStatusFlag   statusFlags);
+
+    void
+    writeIoSeekEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_IoHandleRef    handle,
+                     int64_t             offsetRequest,
+                     OTF2_IoSeekOption   whence,
+                     uint64_t            offsetResult);
+
+    void
+    writeIoChangeStatusFlagsEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_IoHandleRef    handle,
+                                  OTF2_IoStatusFlag   statusFlags);
+
+    void
+    writeIoDeleteFileEvent(OTF2_LocationRef    location,
+                           OTF2_TimeStamp      time,
+                           OTF2_AttributeList *attributes,
+                           OTF2_IoParadigmRef  ioParadigm,
+                           OTF2_IoFileRef      file);
+
+    void
+    writeIoOperationBeginEvent(OTF2_LocationRef     location,
+                               OTF2_TimeStamp       time,
+                               OTF2_AttributeList * attributes,
+                               OTF2_IoHandleRef     handle,
+                               OTF2_IoOperationMode mode,
+                               OTF2_IoOperationFlag operationFlags,
+                               uint64_t             bytesRequest,
+                               uint64_t             matchingId);
+
+    void
+    writeIoOperationTestEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_IoHandleRef    handle,
+                              uint64_t            matchingId);
+
+    void
+    writeIoOperationIssuedEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_IoHandleRef    handle,
+                                uint64_t            matchingId);
+
+    void
+    writeIoOperationCompleteEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_IoHandleRef    handle,
+                                  uint64_t            bytesResult,
+                                  uint64_t            matchingId);
+
+    void
+    writeIoOperationCancelledEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_IoHandleRef    handle,
+                                   uint64_t            matchingId);
+
+    void
+    writeIoAcquireLockEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_IoHandleRef    handle,
+                            OTF2_LockType       lockType);
+
+    void
+    writeIoReleaseLockEvent(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList *attributes,
+                            OTF2_IoHandleRef    handle,
+                            OTF2_LockType       lockType);
+
+    void
+    writeIoTryLockEvent(OTF2_LocationRef    location,
+                        OTF2_TimeStamp      time,
+                        OTF2_AttributeList *attributes,
+                        OTF2_IoHandleRef    handle,
+                        OTF2_LockType       lockType);
+
+    void
+    writeProgramBeginEvent(OTF2_LocationRef      location,
+                           OTF2_TimeStamp        time,
+                           OTF2_AttributeList *  attributes,
+                           OTF2_StringRef        programName,
+                           uint32_t              numberOfArguments,
+                           const OTF2_StringRef *programArguments);
+
+    void
+    writeProgramEndEvent(OTF2_LocationRef    location,
+                         OTF2_TimeStamp      time,
+                         OTF2_AttributeList *attributes,
+                         int64_t             exitStatus);
+
+    void
+    add_location(OTF2_LocationRef location);
+
+    /*
+     * The location and its events are not written, see writeGlobalGroup().
+     */
+    void
+    drop_location(OTF2_LocationRef location);
+
+    /*
+     * Intersect the time window of the written events with the window, see
+     * IFilterCallbacks::time_window().
+     */
+    void
+    restrict_time_window(TimeWindow window);
+
+    /*
+     * Whether records of the location may be dropped or changed, asks the
+     * registered filters with event callbacks. Writers handling events
+     * differently have to extend it, otherwise the location is copied.
+     */
+    virtual bool
+    filters_location(OTF2_LocationRef location);
+
+    /*
+     * Count an event of the location the current thread is reading.
+     */
+    inline void
+    count_event(EventType type, bool filtered)
+    {
+        if (m_thread_event_writer.counters != nullptr && m_thread_event_writer.owner == this)
+        {
+            m_thread_event_writer.counters->read[static_cast<std::size_t>(type)]++;
+            m_thread_event_writer.counters->filtered[static_cast<std::size_t>(type)] += filtered;
+        }
+    }
+
+    /*
+     * Count an event written to the location the current thread is reading.
+     */
+    inline void
+    count_written(EventType type)
+    {
+        if (m_thread_event_writer.counters != nullptr && m_thread_event_writer.owner == this)
+        {
+            m_thread_event_writer.counters->written[static_cast<std::size_t>(type)]++;
+        }
+    }
+
+  private:
+    /*
+     * Event writer of the location the current thread is reading.
+     */
+    struct LocationEventWriter
+    {
+        const TraceWriter *owner;
+        OTF2_LocationRef   location;
+        OTF2_EvtWriter *   writer;
+        EventCounters *    counters;
+    };
+
+    /*
+     * Remove the attribute values of dropped types, see
+     * IFilterCallbacks::dropped_attribute_types().
+     */
+    inline void
+    drop_attributes(OTF2_AttributeList *attributes)
+    {
+        if (m_drops_attributes && attributes != nullptr && OTF2_AttributeList_GetNumberOfElements(attributes) != 0)
+        {
+            remove_dropped_attributes(attributes);
+        }
+    }
+
+    void
+    remove_dropped_attributes(OTF2_AttributeList *attributes);
+
+    inline OTF2_EvtWriter *
+    location_event_writer(OTF2_LocationRef location)
+    {
+        if (m_thread_event_writer.owner == this && m_thread_event_writer.location == location)
+        {
+            return m_thread_event_writer.writer;
+        }
+        return cached_event_writer(location);
+    }
+
+    inline OTF2_EvtWriter *
+    cached_event_writer(OTF2_LocationRef location)
+    {
+        auto search = m_location_ordinals.find(location);
+        if (search != m_location_ordinals.end() && m_event_writers[search->second] != nullptr)
+        {
+            return m_event_writers[search->second];
+        }
+        return OTF2_Archive_GetEvtWriter(m_archive.get(), location);
+    }
+
+    /*
+     * Records opening a region or an operation on the location the current
+     * thread is reading. A time window cuts through them, TraceWriter
+     * balances the cut records, see reopen_records() and endLocation().
+     */
+    struct OpenRecord : OpenEvent
+    {
+        bool kept;
+        bool written = false;
+    };
+
+    struct LocationWindow
+    {
+        const TraceWriter      *owner  = nullptr;
+        bool                    before = true;
+        std::vector<OpenRecord> open;
+    };
+
+    /*
+     * Records opened before the time window are filtered as if at its
+     * begin, the kept ones are written there once it is reached.
+     */
+    inline OTF2_TimeStamp
+    window_time(OTF2_TimeStamp time) const
+    {
+        return m_balances_window ? std::max(time, m_time_window.begin) : time;
+    }
+
+    inline void
+    reach_window(OTF2_LocationRef location, OTF2_TimeStamp time)
+    {
+        if (m_thread_window.before && m_thread_window.owner == this && time >= m_time_window.begin)
+        {
+            reopen_records(location, false);
+        }
+    }
+
+    void
+    reopen_records(OTF2_LocationRef location, bool enters_only);
+
+    /*
+     * Open the record, returns whether it is filtered.
+     */
+    bool
+    open_record(OpenRecord record);
+
+    /*
+     * Last open record of the type, I/O operations are matched by their
+     * handle and matching id.
+     */
+    std::vector<OpenRecord>::iterator
+    find_open(EventType type, OTF2_IoHandleRef handle = OTF2_UNDEFINED_IO_HANDLE, uint64_t matching_id = 0);
+
+    /*
+     * Close the record, returns whether the closing record is filtered. It
+     * is kept if the record was written, moved to the end of the window if
+     * read past it, and dropped if it closes no record.
+     */
+    bool
+    close_record(bool filtered, OTF2_TimeStamp &time, std::vector<OpenRecord>::iterator record);
+
+    static thread_local LocationEventWriter m_thread_event_writer;
+    static thread_local LocationWindow m_thread_window;
+    static OTF2_FlushCallbacks              m_flush_callbacks;
+    /*
+     * Declared before the archive, it has to outlive it.
+     */
+    std::unique_ptr<ChunkPool> m_chunk_pool;
+    archive_ptr                m_archive;
+    OTF2_GlobalDefWriter *     m_def_writer;
+    TraceWriterOptions         m_options;
+    std::string                m_directory;
+
+    /*
+     * Event writers of all defined locations, indexed by the ordinal of the
+     * location in the global definitions.
+     */
+    std::unordered_map<OTF2_LocationRef, size_t> m_location_ordinals;
+    std::vector<OTF2_EvtWriter *>                m_event_writers;
+
+    /*
+     * Locations whose definition a filter dropped, they get no writer and
+     * are removed from groups of locations. Metric class recorders and
+     * metric instances recorded by them or scoped to them are dropped too.
+     */
+    std::unordered_set<OTF2_LocationRef> m_dropped_locations;
+
+    /*
+     * With a memory limit, writers are created by beginLocation() and
+     * closed by endLocation() and endLocalDefinitions(). Local definitions
+     * of copied locations are closed as well.
+     */
+    bool              m_memory_limited = false;
+    std::vector<char> m_local_definitions_closed;
+
+    /*
+     * Registered filters with event callbacks.
+     */
+    std::vector<IFilterCallbacks *> m_location_filters;
+
+    /*
+     * Event types dropped as a whole, indexed by EventType.
+     */
+    std::array<bool, number_of_event_types> m_dropped_events{};
+
+    /*
+     * Attribute value types removed from the events, indexed by OTF2_Type.
+     */
+    std::array<bool, 256> m_dropped_attribute_types{};
+    bool                  m_drops_attributes = false;
+
+    /*
+     * Intersection of the time windows of the registered filters, the
+     * clock properties are shrunk to it. Unless it is the whole trace,
+     * records it cuts through are balanced.
+     */
+    TimeWindow m_time_window;
+    bool m_balances_window = false;
+
+    /*
+     * With TraceWriterOptions::referenced_strings, only strings referenced
+     * by the definitions in m_string_references are kept, unless a filter
+     * asks for all of them.
+     */
+    StringTable                   m_strings;
+    std::vector<GlobalDefinition> m_string_references;
+
+    Filter<GlobalClockPropertiesFilter>         m_global_ClockProperties_filter;
+    Filter<GlobalParadigmFilter>                m_global_Paradigm_filter;
+    Filter<GlobalParadigmPropertyFilter>        m_global_ParadigmProperty_filter;
+    Filter<GlobalIoParadigmFilter>              m_global_IoParadigm_filter;
+    Filter<GlobalStringFilter>                  m_global_String_filter;
+    Filter<GlobalAttributeFilter>               m_global_Attribute_filter;
+    Filter<GlobalSystemTreeNodeFilter>          m_global_SystemTreeNode_filter;
+    Filter<GlobalLocationGroupFilter>           m_global_LocationGroup_filter;
+    Filter<GlobalLocationFilter>                m_global_Location_filter;
+    Filter<GlobalRegionFilter>                  m_global_Region_filter;
+    Filter<GlobalCallsiteFilter>                m_global_Callsite_filter;
+    Filter<GlobalCallpathFilter>                m_global_Callpath_filter;
+    Filter<GlobalGroupFilter>                   m_global_Group_filter;
+    Filter<GlobalMetricMemberFilter>            m_global_MetricMember_filter;
+    Filter<GlobalMetricClassFilter>             m_global_MetricClass_filter;
+    Filter<GlobalMetricInstanceFilter>          m_global_MetricInstance_filter;
+    Filter<GlobalCommFilter>                    m_global_Comm_filter;
+    Filter<GlobalParameterFilter>               m_global_Parameter_filter;
+    Filter<GlobalRmaWinFilter>                  m_global_RmaWin_filter;
+    Filter<GlobalMetricClassRecorderFilter>     m_global_MetricClassRecorder_filter;
+    Filter<GlobalSystemTreeNodePropertyFilter>  m_global_SystemTreeNodeProperty_filter;
+    Filter<GlobalSystemTreeNodeDomainFilter>    m_global_SystemTreeNodeDomain_filter;
+    Filter<GlobalLocationGroupPropertyFilter>   m_global_LocationGroupProperty_filter;
+    Filter<GlobalLocationPropertyFilter>        m_global_LocationProperty_filter;
+    Filter<GlobalCartDimensionFilter>           m_global_CartDimension_filter;
+    Filter<GlobalCartTopologyFilter>            m_global_CartTopology_filter;
+    Filter<GlobalCartCoordinateFilter>          m_global_CartCoordinate_filter;
+    Filter<GlobalSourceCodeLocationFilter>      m_global_SourceCodeLocation_filter;
+    Filter<GlobalCallingContextFilter>          m_global_CallingContext_filter;
+    Filter<GlobalCallingContextPropertyFilter>  m_global_CallingContextProperty_filter;
+    Filter<GlobalInterruptGeneratorFilter>      m_global_InterruptGenerator_filter;
+    Filter<GlobalIoFilePropertyFilter>          m_global_IoFileProperty_filter;
+    Filter<GlobalIoRegularFileFilter>           m_global_IoRegularFile_filter;
+    Filter<GlobalIoDirectoryFilter>             m_global_IoDirectory_filter;
+    Filter<GlobalIoHandleFilter>                m_global_IoHandle_filter;
+    Filter<GlobalIoPreCreatedHandleStateFilter> m_global_IoPreCreatedHandleState_filter;
+    Filter<GlobalCallpathParameterFilter>       m_global_CallpathParameter_filter;
+
+    Filter<EventBufferFlushFilter>              m_event_BufferFlush_filter;
+    Filter<EventMeasurementOnOffFilter>         m_event_MeasurementOnOff_filter;
+    Filter<EventEnterFilter>                    m_event_Enter_filter;
+    Filter<EventLeaveFilter>                    m_event_Leave_filter;
+    Filter<EventMpiSendFilter>                  m_event_MpiSend_filter;
+    Filter<EventMpiIsendFilter>                 m_event_MpiIsend_filter;
+    Filter<EventMpiIsendCompleteFilter>         m_event_MpiIsendComplete_filter;
+    Filter<EventMpiIrecvRequestFilter>          m_event_MpiIrecvRequest_filter;
+    Filter<EventMpiRecvFilter>                  m_event_MpiRecv_filter;
+    Filter<EventMpiIrecvFilter>                 m_event_MpiIrecv_filter;
+    Filter<EventMpiRequestTestFilter>           m_event_MpiRequestTest_filter;
+    Filter<EventMpiRequestCancelledFilter>      m_event_MpiRequestCancelled_filter;
+    Filter<EventMpiCollectiveBeginFilter>       m_event_MpiCollectiveBegin_filter;
+    Filter<EventMpiCollectiveEndFilter>         m_event_MpiCollectiveEnd_filter;
+    Filter<EventOmpForkFilter>                  m_event_OmpFork_filter;
+    Filter<EventOmpJoinFilter>                  m_event_OmpJoin_filter;
+    Filter<EventOmpAcquireLockFilter>           m_event_OmpAcquireLock_filter;
+    Filter<EventOmpReleaseLockFilter>           m_event_OmpReleaseLock_filter;
+    Filter<EventOmpTaskCreateFilter>            m_event_OmpTaskCreate_filter;
+    Filter<EventOmpTaskSwitchFilter>            m_event_OmpTaskSwitch_filter;
+    Filter<EventOmpTaskCompleteFilter>          m_event_OmpTaskComplete_filter;
+    Filter<EventMetricFilter>                   m_event_Metric_filter;
+    Filter<EventParameterStringFilter>          m_event_ParameterString_filter;
+    Filter<EventParameterIntFilter>             m_event_ParameterInt_filter;
+    Filter<EventParameterUnsignedIntFilter>     m_event_ParameterUnsignedInt_filter;
+    Filter<EventRmaWinCreateFilter>             m_event_RmaWinCreate_filter;
+    Filter<EventRmaWinDestroyFilter>            m_event_RmaWinDestroy_filter;
+    Filter<EventRmaCollectiveBeginFilter>       m_event_RmaCollectiveBegin_filter;
+    Filter<EventRmaCollectiveEndFilter>         m_event_RmaCollectiveEnd_filter;
+    Filter<EventRmaGroupSyncFilter>             m_event_RmaGroupSync_filter;
+    Filter<EventRmaRequestLockFilter>           m_event_RmaRequestLock_filter;
+    Filter<EventRmaAcquireLockFilter>           m_event_RmaAcquireLock_filter;
+    Filter<EventRmaTryLockFilter>               m_event_RmaTryLock_filter;
+    Filter<EventRmaReleaseLockFilter>           m_event_RmaReleaseLock_filter;
+    Filter<EventRmaSyncFilter>                  m_event_RmaSync_filter;
+    Filter<EventRmaWaitChangeFilter>            m_event_RmaWaitChange_filter;
+    Filter<EventRmaPutFilter>                   m_event_RmaPut_filter;
+    Filter<EventRmaGetFilter>                   m_event_RmaGet_filter;
+    Filter<EventRmaAtomicFilter>                m_event_RmaAtomic_filter;
+    Filter<EventRmaOpCompleteBlockingFilter>    m_event_RmaOpCompleteBlocking_filter;
+    Filter<EventRmaOpCompleteNonBlockingFilter> m_event_RmaOpCompleteNonBlocking_filter;
+    Filter<EventRmaOpTestFilter>                m_event_RmaOpTest_filter;
+    Filter<EventRmaOpCompleteRemoteFilter>      m_event_RmaOpCompleteRemote_filter;
+    Filter<EventThreadForkFilter>               m_event_ThreadFork_filter;
+    Filter<EventThreadJoinFilter>               m_event_ThreadJoin_filter;
+    Filter<EventThreadTeamBeginFilter>          m_event_ThreadTeamBegin_filter;
+    Filter<EventThreadTeamEndFilter>            m_event_ThreadTeamEnd_filter;
+    Filter<EventThreadAcquireLockFilter>        m_event_ThreadAcquireLock_filter;
+    Filter<EventThreadReleaseLockFilter>        m_event_ThreadReleaseLock_filter;
+    Filter<EventThreadTaskCreateFilter>         m_event_ThreadTaskCreate_filter;
+    Filter<EventThreadTaskSwitchFilter>         m_event_ThreadTaskSwitch_filter;
+    Filter<EventThreadTaskCompleteFilter>       m_event_ThreadTaskComplete_filter;
+    Filter<EventThreadCreateFilter>             m_event_ThreadCreate_filter;
+    Filter<EventThreadBeginFilter>              m_event_ThreadBegin_filter;
+    Filter<EventThreadWaitFilter>               m_event_ThreadWait_filter;
+    Filter<EventThreadEndFilter>                m_event_ThreadEnd_filter;
+    Filter<EventCallingContextEnterFilter>      m_event_CallingContextEnter_filter;
+    Filter<EventCallingContextLeaveFilter>      m_event_CallingContextLeave_filter;
+    Filter<EventCallingContextSampleFilter>     m_event_CallingContextSample_filter;
+    Filter<EventIoCreateHandleFilter>           m_event_IoCreateHandle_filter;
+    Filter<EventIoDestroyHandleFilter>          m_event_IoDestroyHandle_filter;
+    Filter<EventIoDuplicateHandleFilter>        m_event_IoDuplicateHandle_filter;
+    Filter<EventIoSeekFilter>                   m_event_IoSeek_filter;
+    Filter<EventIoChangeStatusFlagsFilter>      m_event_IoChangeStatusFlags_filter;
+    Filter<EventIoDeleteFileFilter>             m_event_IoDeleteFile_filter;
+    Filter<EventIoOperationBeginFilter>         m_event_IoOperationBegin_filter;
+    Filter<EventIoOperationTestFilter>          m_event_IoOperationTest_filter;
+    Filter<EventIoOperationIssuedFilter>        m_event_IoOperationIssued_filter;
+    Filter<EventIoOperationCompleteFilter>      m_event_IoOperationComplete_filter;
+    Filter<EventIoOperationCancelledFilter>     m_event_IoOperationCancelled_filter;
+    Filter<EventIoAcquireLockFilter>            m_event_IoAcquireLock_filter;
+    Filter<EventIoReleaseLockFilter>            m_event_IoReleaseLock_filter;
+    Filter<EventIoTryLockFilter>                m_event_IoTryLock_filter;
+    Filter<EventProgramBeginFilter>             m_event_ProgramBegin_filter;
+    Filter<EventProgramEndFilter>               m_event_ProgramEnd_filter;
+};
+
+/*
+ * The event handlers are defined here, a LocalReader<TraceWriter> inlines
+ * them into its callbacks.
+ */
+inline void
+TraceWriter::handleBufferFlushEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_TimeStamp      stopTime)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_BufferFlush_filter.empty() &&
+                    m_event_BufferFlush_filter.process(location, time, attributes, stopTime);
+    count_event(EventType::BufferFlush, filtered);
+    if (!filtered)
+    {
+        writeBufferFlushEvent(location, time, attributes, stopTime);
+    }
+}
+
+inline void
+TraceWriter::handleMeasurementOnOffEvent(OTF2_LocationRef     location,
+                                         OTF2_TimeStamp       time,
+                                         OTF2_AttributeList * attributes,
+                                         OTF2_MeasurementMode measurementMode)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MeasurementOnOff_filter.empty() &&
+                    m_event_MeasurementOnOff_filter.process(location, time, attributes, measurementMode);
+    count_event(EventType::MeasurementOnOff, filtered);
+    if (!filtered)
+    {
+        writeMeasurementOnOffEvent(location, time, attributes, measurementMode);
+    }
+}
+
+inline void
+TraceWriter::handleEnterEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RegionRef      region)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered =
+        !m_event_Enter_filter.empty() && m_event_Enter_filter.process(location, window_time(time), attributes, region);
+    if (m_balances_window)
+    {
+        filtered = open_record({{EventType::Enter, time, region}, !filtered});
+    }
+    count_event(EventType::Enter, filtered);
+    if (!filtered)
+    {
+        writeEnterEvent(location, time, attributes, region);
+    }
+}
+
+inline void
+TraceWriter::handleLeaveEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RegionRef      region)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_Leave_filter.empty() && m_event_Leave_filter.process(location, time, attributes, region);
+    if (m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::Enter));
+    }
+    count_event(EventType::Leave, filtered);
+    if (!filtered)
+    {
+        writeLeaveEvent(location, time, attributes, region);
+    }
+}
+
+inline void
+TraceWriter::handleMpiSendEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                uint32_t            receiver,
+                                OTF2_CommRef        communicator,
+                                uint32_t            msgTag,
+                                uint64_t            msgLength)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiSend_filter.empty() &&
+                    m_event_MpiSend_filter.process(
+                        location, time, attributes, receiver, communicator, msgTag, msgLength);
+    count_event(EventType::MpiSend, filtered);
+    if (!filtered)
+    {
+        writeMpiSendEvent(location, time, attributes, receiver, communicator, msgTag, msgLength);
+    }
+}
+
+inline void
+TraceWriter::handleMpiIsendEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 uint32_t            receiver,
+                                 OTF2_CommRef        communicator,
+                                 uint32_t            msgTag,
+                                 uint64_t            msgLength,
+                                 uint64_t            requestID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiIsend_filter.empty() &&
+                    m_event_MpiIsend_filter.process(
+                        location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+    count_event(EventType::MpiIsend, filtered);
+    if (!filtered)
+    {
+        writeMpiIsendEvent(location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
+    }
+}
+
+inline void
+TraceWriter::handleMpiIsendCompleteEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         uint64_t            requestID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiIsendComplete_filter.empty() &&
+                    m_event_MpiIsendComplete_filter.process(location, time, attributes, requestID);
+    count_event(EventType::MpiIsendComplete, filtered);
+    if (!filtered)
+    {
+        writeMpiIsendCompleteEvent(location, time, attributes, requestID);
+    }
+}
+
+inline void
+TraceWriter::handleMpiIrecvRequestEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        uint64_t            requestID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiIrecvRequest_filter.empty() &&
+                    m_event_MpiIrecvRequest_filter.process(location, time, attributes, requestID);
+    count_event(EventType::MpiIrecvRequest, filtered);
+    if (!filtered)
+    {
+        writeMpiIrecvRequestEvent(location, time, attributes, requestID);
+    }
+}
+
+inline void
+TraceWriter::handleMpiRecvEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                uint32_t            sender,
+                                OTF2_CommRef        communicator,
+                                uint32_t            msgTag,
+                                uint64_t            msgLength)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiRecv_filter.empty() &&
+                    m_event_MpiRecv_filter.process(location, time, attributes, sender, communicator, msgTag, msgLength);
+    count_event(EventType::MpiRecv, filtered);
+    if (!filtered)
+    {
+        writeMpiRecvEvent(location, time, attributes, sender, communicator, msgTag, msgLength);
+    }
+}
+
+inline void
+TraceWriter::handleMpiIrecvEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 uint32_t            sender,
+                                 OTF2_CommRef        communicator,
+                                 uint32_t            msgTag,
+                                 uint64_t            msgLength,
+                                 uint64_t            requestID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiIrecv_filter.empty() &&
+                    m_event_MpiIrecv_filter.process(
+                        location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+    count_event(EventType::MpiIrecv, filtered);
+    if (!filtered)
+    {
+        writeMpiIrecvEvent(location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
+    }
+}
+
+inline void
+TraceWriter::handleMpiRequestTestEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint64_t            requestID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiRequestTest_filter.empty() &&
+                    m_event_MpiRequestTest_filter.process(location, time, attributes, requestID);
+    count_event(EventType::MpiRequestTest, filtered);
+    if (!filtered)
+    {
+        writeMpiRequestTestEvent(location, time, attributes, requestID);
+    }
+}
+
+inline void
+TraceWriter::handleMpiRequestCancelledEvent(OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            uint64_t            requestID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiRequestCancelled_filter.empty() &&
+                    m_event_MpiRequestCancelled_filter.process(location, time, attributes, requestID);
+    count_event(EventType::MpiRequestCancelled, filtered);
+    if (!filtered)
+    {
+        writeMpiRequestCancelledEvent(location, time, attributes, requestID);
+    }
+}
+
+inline void
+TraceWriter::handleMpiCollectiveBeginEvent(OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiCollectiveBegin_filter.empty() &&
+                    m_event_MpiCollectiveBegin_filter.process(location, window_time(time), attributes);
+    if (m_balances_window)
+    {
+        filtered = open_record({{EventType::MpiCollectiveBegin, time}, !filtered});
+    }
+    count_event(EventType::MpiCollectiveBegin, filtered);
+    if (!filtered)
+    {
+        writeMpiCollectiveBeginEvent(location, time, attributes);
+    }
+}
+
+inline void
+TraceWriter::handleMpiCollectiveEndEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_CollectiveOp   collectiveOp,
+                                         OTF2_CommRef        communicator,
+                                         uint32_t            root,
+                                         uint64_t            sizeSent,
+                                         uint64_t            sizeReceived)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_MpiCollectiveEnd_filter.empty() &&
+                    m_event_MpiCollectiveEnd_filter.process(
+                        location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
+    if (m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::MpiCollectiveBegin));
+    }
+    count_event(EventType::MpiCollectiveEnd, filtered);
+    if (!filtered)
+    {
+        writeMpiCollectiveEndEvent(
+            location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
+    }
+}
+
+inline void
+TraceWriter::handleOmpForkEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                uint32_t            numberOfRequestedThreads)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpFork_filter.empty() &&
+                    m_event_OmpFork_filter.process(location, time, attributes, numberOfRequestedThreads);
+    count_event(EventType::OmpFork, filtered);
+    if (!filtered)
+    {
+        writeOmpForkEvent(location, time, attributes, numberOfRequestedThreads);
+    }
+}
+
+inline void
+TraceWriter::handleOmpJoinEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpJoin_filter.empty() && m_event_OmpJoin_filter.process(location, time, attributes);
+    count_event(EventType::OmpJoin, filtered);
+    if (!filtered)
+    {
+        writeOmpJoinEvent(location, time, attributes);
+    }
+}
+
+inline void
+TraceWriter::handleOmpAcquireLockEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint32_t            lockID,
+                                       uint32_t            acquisitionOrder)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpAcquireLock_filter.empty() &&
+                    m_event_OmpAcquireLock_filter.process(location, time, attributes, lockID, acquisitionOrder);
+    count_event(EventType::OmpAcquireLock, filtered);
+    if (!filtered)
+    {
+        writeOmpAcquireLockEvent(location, time, attributes, lockID, acquisitionOrder);
+    }
+}
+
+inline void
+TraceWriter::handleOmpReleaseLockEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint32_t            lockID,
+                                       uint32_t            acquisitionOrder)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpReleaseLock_filter.empty() &&
+                    m_event_OmpReleaseLock_filter.process(location, time, attributes, lockID, acquisitionOrder);
+    count_event(EventType::OmpReleaseLock, filtered);
+    if (!filtered)
+    {
+        writeOmpReleaseLockEvent(location, time, attributes, lockID, acquisitionOrder);
+    }
+}
+
+inline void
+TraceWriter::handleOmpTaskCreateEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      uint64_t            taskID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpTaskCreate_filter.empty() &&
+                    m_event_OmpTaskCreate_filter.process(location, time, attributes, taskID);
+    count_event(EventType::OmpTaskCreate, filtered);
+    if (!filtered)
+    {
+        writeOmpTaskCreateEvent(location, time, attributes, taskID);
+    }
+}
+
+inline void
+TraceWriter::handleOmpTaskSwitchEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      uint64_t            taskID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpTaskSwitch_filter.empty() &&
+                    m_event_OmpTaskSwitch_filter.process(location, time, attributes, taskID);
+    count_event(EventType::OmpTaskSwitch, filtered);
+    if (!filtered)
+    {
+        writeOmpTaskSwitchEvent(location, time, attributes, taskID);
+    }
+}
+
+inline void
+TraceWriter::handleOmpTaskCompleteEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        uint64_t            taskID)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_OmpTaskComplete_filter.empty() &&
+                    m_event_OmpTaskComplete_filter.process(location, time, attributes, taskID);
+    count_event(EventType::OmpTaskComplete, filtered);
+    if (!filtered)
+    {
+        writeOmpTaskCompleteEvent(location, time, attributes, taskID);
+    }
+}
+
+inline void
+TraceWriter::handleMetricEvent(OTF2_LocationRef        location,
+                               OTF2_TimeStamp          time,
+                               OTF2_AttributeList *    attributes,
+                               OTF2_MetricRef          metric,
+                               uint8_t                 numberOfMetrics,
+                               const OTF2_Type *       typeIDs,
+                               const OTF2_MetricValue *metricValues)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_Metric_filter.empty() &&
+                    m_event_Metric_filter.process(
+                        location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+    count_event(EventType::Metric, filtered);
+    if (!filtered)
+    {
+        writeMetricEvent(location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
+    }
+}
+
+inline void
+TraceWriter::handleParameterStringEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_ParameterRef   parameter,
+                                        OTF2_StringRef      string)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ParameterString_filter.empty() &&
+                    m_event_ParameterString_filter.process(location, time, attributes, parameter, string);
+    count_event(EventType::ParameterString, filtered);
+    if (!filtered)
+    {
+        writeParameterStringEvent(location, time, attributes, parameter, string);
+    }
+}
+
+inline void
+TraceWriter::handleParameterIntEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_ParameterRef   parameter,
+                                     int64_t             value)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ParameterInt_filter.empty() &&
+                    m_event_ParameterInt_filter.process(location, time, attributes, parameter, value);
+    count_event(EventType::ParameterInt, filtered);
+    if (!filtered)
+    {
+        writeParameterIntEvent(location, time, attributes, parameter, value);
+    }
+}
+
+inline void
+TraceWriter::handleParameterUnsignedIntEvent(OTF2_LocationRef    location,
+                                             OTF2_TimeStamp      time,
+                                             OTF2_AttributeList *attributes,
+                                             OTF2_ParameterRef   parameter,
+                                             uint64_t            value)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ParameterUnsignedInt_filter.empty() &&
+                    m_event_ParameterUnsignedInt_filter.process(location, time, attributes, parameter, value);
+    count_event(EventType::ParameterUnsignedInt, filtered);
+    if (!filtered)
+    {
+        writeParameterUnsignedIntEvent(location, time, attributes, parameter, value);
+    }
+}
+
+inline void
+TraceWriter::handleRmaWinCreateEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_RmaWinRef      win)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaWinCreate_filter.empty() &&
+                    m_event_RmaWinCreate_filter.process(location, time, attributes, win);
+    count_event(EventType::RmaWinCreate, filtered);
+    if (!filtered)
+    {
+        writeRmaWinCreateEvent(location, time, attributes, win);
+    }
+}
+
+inline void
+TraceWriter::handleRmaWinDestroyEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_RmaWinRef      win)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaWinDestroy_filter.empty() &&
+                    m_event_RmaWinDestroy_filter.process(location, time, attributes, win);
+    count_event(EventType::RmaWinDestroy, filtered);
+    if (!filtered)
+    {
+        writeRmaWinDestroyEvent(location, time, attributes, win);
+    }
+}
+
+inline void
+TraceWriter::handleRmaCollectiveBeginEvent(OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaCollectiveBegin_filter.empty() &&
+                    m_event_RmaCollectiveBegin_filter.process(location, time, attributes);
+    count_event(EventType::RmaCollectiveBegin, filtered);
+    if (!filtered)
+    {
+        writeRmaCollectiveBeginEvent(location, time, attributes);
+    }
+}
+
+inline void
+TraceWriter::handleRmaCollectiveEndEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_CollectiveOp   collectiveOp,
+                                         OTF2_RmaSyncLevel   syncLevel,
+                                         OTF2_RmaWinRef      win,
+                                         uint32_t            root,
+                                         uint64_t            bytesSent,
+                                         uint64_t            bytesReceived)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaCollectiveEnd_filter.empty() &&
+                    m_event_RmaCollectiveEnd_filter.process(
+                        location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+    count_event(EventType::RmaCollectiveEnd, filtered);
+    if (!filtered)
+    {
+        writeRmaCollectiveEndEvent(
+            location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+    }
+}
+
+inline void
+TraceWriter::handleRmaGroupSyncEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_RmaSyncLevel   syncLevel,
+                                     OTF2_RmaWinRef      win,
+                                     OTF2_GroupRef       group)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaGroupSync_filter.empty() &&
+                    m_event_RmaGroupSync_filter.process(location, time, attributes, syncLevel, win, group);
+    count_event(EventType::RmaGroupSync, filtered);
+    if (!filtered)
+    {
+        writeRmaGroupSyncEvent(location, time, attributes, syncLevel, win, group);
+    }
+}
+
+inline void
+TraceWriter::handleRmaRequestLockEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_RmaWinRef      win,
+                                       uint32_t            remote,
+                                       uint64_t            lockId,
+                                       OTF2_LockType       lockType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaRequestLock_filter.empty() &&
+                    m_event_RmaRequestLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
+    count_event(EventType::RmaRequestLock, filtered);
+    if (!filtered)
+    {
+        writeRmaRequestLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+}
+
+inline void
+TraceWriter::handleRmaAcquireLockEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_RmaWinRef      win,
+                                       uint32_t            remote,
+                                       uint64_t            lockId,
+                                       OTF2_LockType       lockType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaAcquireLock_filter.empty() &&
+                    m_event_RmaAcquireLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
+    count_event(EventType::RmaAcquireLock, filtered);
+    if (!filtered)
+    {
+        writeRmaAcquireLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+}
+
+inline void
+TraceWriter::handleRmaTryLockEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_RmaWinRef      win,
+                                   uint32_t            remote,
+                                   uint64_t            lockId,
+                                   OTF2_LockType       lockType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaTryLock_filter.empty() &&
+                    m_event_RmaTryLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
+    count_event(EventType::RmaTryLock, filtered);
+    if (!filtered)
+    {
+        writeRmaTryLockEvent(location, time, attributes, win, remote, lockId, lockType);
+    }
+}
+
+inline void
+TraceWriter::handleRmaReleaseLockEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_RmaWinRef      win,
+                                       uint32_t            remote,
+                                       uint64_t            lockId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaReleaseLock_filter.empty() &&
+                    m_event_RmaReleaseLock_filter.process(location, time, attributes, win, remote, lockId);
+    count_event(EventType::RmaReleaseLock, filtered);
+    if (!filtered)
+    {
+        writeRmaReleaseLockEvent(location, time, attributes, win, remote, lockId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaSyncEvent(OTF2_LocationRef    location,
+                                OTF2_TimeStamp      time,
+                                OTF2_AttributeList *attributes,
+                                OTF2_RmaWinRef      win,
+                                uint32_t            remote,
+                                OTF2_RmaSyncType    syncType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaSync_filter.empty() &&
+                    m_event_RmaSync_filter.process(location, time, attributes, win, remote, syncType);
+    count_event(EventType::RmaSync, filtered);
+    if (!filtered)
+    {
+        writeRmaSyncEvent(location, time, attributes, win, remote, syncType);
+    }
+}
+
+inline void
+TraceWriter::handleRmaWaitChangeEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_RmaWinRef      win)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaWaitChange_filter.empty() &&
+                    m_event_RmaWaitChange_filter.process(location, time, attributes, win);
+    count_event(EventType::RmaWaitChange, filtered);
+    if (!filtered)
+    {
+        writeRmaWaitChangeEvent(location, time, attributes, win);
+    }
+}
+
+inline void
+TraceWriter::handleRmaPutEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_RmaWinRef      win,
+                               uint32_t            remote,
+                               uint64_t            bytes,
+                               uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaPut_filter.empty() &&
+                    m_event_RmaPut_filter.process(location, time, attributes, win, remote, bytes, matchingId);
+    count_event(EventType::RmaPut, filtered);
+    if (!filtered)
+    {
+        writeRmaPutEvent(location, time, attributes, win, remote, bytes, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaGetEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_RmaWinRef      win,
+                               uint32_t            remote,
+                               uint64_t            bytes,
+                               uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaGet_filter.empty() &&
+                    m_event_RmaGet_filter.process(location, time, attributes, win, remote, bytes, matchingId);
+    count_event(EventType::RmaGet, filtered);
+    if (!filtered)
+    {
+        writeRmaGetEvent(location, time, attributes, win, remote, bytes, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaAtomicEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_RmaWinRef      win,
+                                  uint32_t            remote,
+                                  OTF2_RmaAtomicType  type,
+                                  uint64_t            bytesSent,
+                                  uint64_t            bytesReceived,
+                                  uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaAtomic_filter.empty() &&
+                    m_event_RmaAtomic_filter.process(
+                        location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
+    count_event(EventType::RmaAtomic, filtered);
+    if (!filtered)
+    {
+        writeRmaAtomicEvent(location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaOpCompleteBlockingEvent(OTF2_LocationRef    location,
+                                              OTF2_TimeStamp      time,
+                                              OTF2_AttributeList *attributes,
+                                              OTF2_RmaWinRef      win,
+                                              uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaOpCompleteBlocking_filter.empty() &&
+                    m_event_RmaOpCompleteBlocking_filter.process(location, time, attributes, win, matchingId);
+    count_event(EventType::RmaOpCompleteBlocking, filtered);
+    if (!filtered)
+    {
+        writeRmaOpCompleteBlockingEvent(location, time, attributes, win, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaOpCompleteNonBlockingEvent(OTF2_LocationRef    location,
+                                                 OTF2_TimeStamp      time,
+                                                 OTF2_AttributeList *attributes,
+                                                 OTF2_RmaWinRef      win,
+                                                 uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaOpCompleteNonBlocking_filter.empty() &&
+                    m_event_RmaOpCompleteNonBlocking_filter.process(location, time, attributes, win, matchingId);
+    count_event(EventType::RmaOpCompleteNonBlocking, filtered);
+    if (!filtered)
+    {
+        writeRmaOpCompleteNonBlockingEvent(location, time, attributes, win, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaOpTestEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_RmaWinRef      win,
+                                  uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaOpTest_filter.empty() &&
+                    m_event_RmaOpTest_filter.process(location, time, attributes, win, matchingId);
+    count_event(EventType::RmaOpTest, filtered);
+    if (!filtered)
+    {
+        writeRmaOpTestEvent(location, time, attributes, win, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleRmaOpCompleteRemoteEvent(OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_RmaWinRef      win,
+                                            uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_RmaOpCompleteRemote_filter.empty() &&
+                    m_event_RmaOpCompleteRemote_filter.process(location, time, attributes, win, matchingId);
+    count_event(EventType::RmaOpCompleteRemote, filtered);
+    if (!filtered)
+    {
+        writeRmaOpCompleteRemoteEvent(location, time, attributes, win, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleThreadForkEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_Paradigm       model,
+                                   uint32_t            numberOfRequestedThreads)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadFork_filter.empty() &&
+                    m_event_ThreadFork_filter.process(location, time, attributes, model, numberOfRequestedThreads);
+    count_event(EventType::ThreadFork, filtered);
+    if (!filtered)
+    {
+        writeThreadForkEvent(location, time, attributes, model, numberOfRequestedThreads);
+    }
+}
+
+inline void
+TraceWriter::handleThreadJoinEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_Paradigm       model)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadJoin_filter.empty() &&
+                    m_event_ThreadJoin_filter.process(location, time, attributes, model);
+    count_event(EventType::ThreadJoin, filtered);
+    if (!filtered)
+    {
+        writeThreadJoinEvent(location, time, attributes, model);
+    }
+}
+
+inline void
+TraceWriter::handleThreadTeamBeginEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_CommRef        threadTeam)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadTeamBegin_filter.empty() &&
+                    m_event_ThreadTeamBegin_filter.process(location, time, attributes, threadTeam);
+    count_event(EventType::ThreadTeamBegin, filtered);
+    if (!filtered)
+    {
+        writeThreadTeamBeginEvent(location, time, attributes, threadTeam);
+    }
+}
+
+inline void
+TraceWriter::handleThreadTeamEndEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_CommRef        threadTeam)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadTeamEnd_filter.empty() &&
+                    m_event_ThreadTeamEnd_filter.process(location, time, attributes, threadTeam);
+    count_event(EventType::ThreadTeamEnd, filtered);
+    if (!filtered)
+    {
+        writeThreadTeamEndEvent(location, time, attributes, threadTeam);
+    }
+}
+
+inline void
+TraceWriter::handleThreadAcquireLockEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_Paradigm       model,
+                                          uint32_t            lockID,
+                                          uint32_t            acquisitionOrder)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadAcquireLock_filter.empty() &&
+                    m_event_ThreadAcquireLock_filter.process(
+                        location, time, attributes, model, lockID, acquisitionOrder);
+    count_event(EventType::ThreadAcquireLock, filtered);
+    if (!filtered)
+    {
+        writeThreadAcquireLockEvent(location, time, attributes, model, lockID, acquisitionOrder);
+    }
+}
+
+inline void
+TraceWriter::handleThreadReleaseLockEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_Paradigm       model,
+                                          uint32_t            lockID,
+                                          uint32_t            acquisitionOrder)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadReleaseLock_filter.empty() &&
+                    m_event_ThreadReleaseLock_filter.process(
+                        location, time, attributes, model, lockID, acquisitionOrder);
+    count_event(EventType::ThreadReleaseLock, filtered);
+    if (!filtered)
+    {
+        writeThreadReleaseLockEvent(location, time, attributes, model, lockID, acquisitionOrder);
+    }
+}
+
+inline void
+TraceWriter::handleThreadTaskCreateEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_CommRef        threadTeam,
+                                         uint32_t            creatingThread,
+                                         uint32_t            generationNumber)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadTaskCreate_filter.empty() &&
+                    m_event_ThreadTaskCreate_filter.process(
+                        location, time, attributes, threadTeam, creatingThread, generationNumber);
+    count_event(EventType::ThreadTaskCreate, filtered);
+    if (!filtered)
+    {
+        writeThreadTaskCreateEvent(location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+}
+
+inline void
+TraceWriter::handleThreadTaskSwitchEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_CommRef        threadTeam,
+                                         uint32_t            creatingThread,
+                                         uint32_t            generationNumber)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadTaskSwitch_filter.empty() &&
+                    m_event_ThreadTaskSwitch_filter.process(
+                        location, time, attributes, threadTeam, creatingThread, generationNumber);
+    count_event(EventType::ThreadTaskSwitch, filtered);
+    if (!filtered)
+    {
+        writeThreadTaskSwitchEvent(location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+}
+
+inline void
+TraceWriter::handleThreadTaskCompleteEvent(OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes,
+                                           OTF2_CommRef        threadTeam,
+                                           uint32_t            creatingThread,
+                                           uint32_t            generationNumber)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadTaskComplete_filter.empty() &&
+                    m_event_ThreadTaskComplete_filter.process(
+                        location, time, attributes, threadTeam, creatingThread, generationNumber);
+    count_event(EventType::ThreadTaskComplete, filtered);
+    if (!filtered)
+    {
+        writeThreadTaskCompleteEvent(location, time, attributes, threadTeam, creatingThread, generationNumber);
+    }
+}
+
+inline void
+TraceWriter::handleThreadCreateEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_CommRef        threadContingent,
+                                     uint64_t            sequenceCount)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadCreate_filter.empty() &&
+                    m_event_ThreadCreate_filter.process(location, time, attributes, threadContingent, sequenceCount);
+    count_event(EventType::ThreadCreate, filtered);
+    if (!filtered)
+    {
+        writeThreadCreateEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+}
+
+inline void
+TraceWriter::handleThreadBeginEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_CommRef        threadContingent,
+                                    uint64_t            sequenceCount)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadBegin_filter.empty() &&
+                    m_event_ThreadBegin_filter.process(location, time, attributes, threadContingent, sequenceCount);
+    count_event(EventType::ThreadBegin, filtered);
+    if (!filtered)
+    {
+        writeThreadBeginEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+}
+
+inline void
+TraceWriter::handleThreadWaitEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_CommRef        threadContingent,
+                                   uint64_t            sequenceCount)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadWait_filter.empty() &&
+                    m_event_ThreadWait_filter.process(location, time, attributes, threadContingent, sequenceCount);
+    count_event(EventType::ThreadWait, filtered);
+    if (!filtered)
+    {
+        writeThreadWaitEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+}
+
+inline void
+TraceWriter::handleThreadEndEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_CommRef        threadContingent,
+                                  uint64_t            sequenceCount)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ThreadEnd_filter.empty() &&
+                    m_event_ThreadEnd_filter.process(location, time, attributes, threadContingent, sequenceCount);
+    count_event(EventType::ThreadEnd, filtered);
+    if (!filtered)
+    {
+        writeThreadEndEvent(location, time, attributes, threadContingent, sequenceCount);
+    }
+}
+
+inline void
+TraceWriter::handleCallingContextEnterEvent(OTF2_LocationRef       location,
+                                            OTF2_TimeStamp         time,
+                                            OTF2_AttributeList *   attributes,
+                                            OTF2_CallingContextRef callingContext,
+                                            uint32_t               unwindDistance)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_CallingContextEnter_filter.empty() &&
+                    m_event_CallingContextEnter_filter.process(
+                        location, time, attributes, callingContext, unwindDistance);
+    count_event(EventType::CallingContextEnter, filtered);
+    if (!filtered)
+    {
+        writeCallingContextEnterEvent(location, time, attributes, callingContext, unwindDistance);
+    }
+}
+
+inline void
+TraceWriter::handleCallingContextLeaveEvent(OTF2_LocationRef       location,
+                                            OTF2_TimeStamp         time,
+                                            OTF2_AttributeList *   attributes,
+                                            OTF2_CallingContextRef callingContext)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_CallingContextLeave_filter.empty() &&
+                    m_event_CallingContextLeave_filter.process(location, time, attributes, callingContext);
+    count_event(EventType::CallingContextLeave, filtered);
+    if (!filtered)
+    {
+        writeCallingContextLeaveEvent(location, time, attributes, callingContext);
+    }
+}
+
+inline void
+TraceWriter::handleCallingContextSampleEvent(OTF2_LocationRef           location,
+                                             OTF2_TimeStamp             time,
+                                             OTF2_AttributeList *       attributes,
+                                             OTF2_CallingContextRef     callingContext,
+                                             uint32_t                   unwindDistance,
+                                             OTF2_InterruptGeneratorRef interruptGenerator)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_CallingContextSample_filter.empty() &&
+                    m_event_CallingContextSample_filter.process(
+                        location, time, attributes, callingContext, unwindDistance, interruptGenerator);
+    count_event(EventType::CallingContextSample, filtered);
+    if (!filtered)
+    {
+        writeCallingContextSampleEvent(location, time, attributes, callingContext, unwindDistance, interruptGenerator);
+    }
+}
+
+inline void
+TraceWriter::handleIoCreateHandleEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_IoHandleRef    handle,
+                                       OTF2_IoAccessMode   mode,
+                                       OTF2_IoCreationFlag creationFlags,
+                                       OTF2_IoStatusFlag   statusFlags)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoCreateHandle_filter.empty() &&
+                    m_event_IoCreateHandle_filter.process(
+                        location, time, attributes, handle, mode, creationFlags, statusFlags);
+    count_event(EventType::IoCreateHandle, filtered);
+    if (!filtered)
+    {
+        writeIoCreateHandleEvent(location, time, attributes, handle, mode, creationFlags, statusFlags);
+    }
+}
+
+inline void
+TraceWriter::handleIoDestroyHandleEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_IoHandleRef    handle)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoDestroyHandle_filter.empty() &&
+                    m_event_IoDestroyHandle_filter.process(location, time, attributes, handle);
+    count_event(EventType::IoDestroyHandle, filtered);
+    if (!filtered)
+    {
+        writeIoDestroyHandleEvent(location, time, attributes, handle);
+    }
+}
+
+inline void
+TraceWriter::handleIoDuplicateHandleEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_IoHandleRef    oldHandle,
+                                          OTF2_IoHandleRef    newHandle,
+                                          OTF2_IoStatusFlag   statusFlags)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoDuplicateHandle_filter.empty() &&
+                    m_event_IoDuplicateHandle_filter.process(
+                        location, time, attributes, oldHandle, newHandle, statusFlags);
+    count_event(EventType::IoDuplicateHandle, filtered);
+    if (!filtered)
+    {
+        writeIoDuplicateHandleEvent(location, time, attributes, oldHandle, newHandle, statusFlags);
+    }
+}
+
+inline void
+TraceWriter::handleIoSeekEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_IoHandleRef    handle,
+                               int64_t             offsetRequest,
+                               OTF2_IoSeekOption   whence,
+                               uint64_t            offsetResult)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoSeek_filter.empty() &&
+                    m_event_IoSeek_filter.process(
+                        location, time, attributes, handle, offsetRequest, whence, offsetResult);
+    count_event(EventType::IoSeek, filtered);
+    if (!filtered)
+    {
+        writeIoSeekEvent(location, time, attributes, handle, offsetRequest, whence, offsetResult);
+    }
+}
+
+inline void
+TraceWriter::handleIoChangeStatusFlagsEvent(OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_IoHandleRef    handle,
+                                            OTF2_IoStatusFlag   statusFlags)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoChangeStatusFlags_filter.empty() &&
+                    m_event_IoChangeStatusFlags_filter.process(location, time, attributes, handle, statusFlags);
+    count_event(EventType::IoChangeStatusFlags, filtered);
+    if (!filtered)
+    {
+        writeIoChangeStatusFlagsEvent(location, time, attributes, handle, statusFlags);
+    }
+}
+
+inline void
+TraceWriter::handleIoDeleteFileEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_IoParadigmRef  ioParadigm,
+                                     OTF2_IoFileRef      file)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoDeleteFile_filter.empty() &&
+                    m_event_IoDeleteFile_filter.process(location, time, attributes, ioParadigm, file);
+    count_event(EventType::IoDeleteFile, filtered);
+    if (!filtered)
+    {
+        writeIoDeleteFileEvent(location, time, attributes, ioParadigm, file);
+    }
+}
+
+inline void
+TraceWriter::handleIoOperationBeginEvent(OTF2_LocationRef     location,
+                                         OTF2_TimeStamp       time,
+                                         OTF2_AttributeList * attributes,
+                                         OTF2_IoHandleRef     handle,
+                                         OTF2_IoOperationMode mode,
+                                         OTF2_IoOperationFlag operationFlags,
+                                         uint64_t             bytesRequest,
+                                         uint64_t             matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoOperationBegin_filter.empty() &&
+                    m_event_IoOperationBegin_filter.process(location,
+                                                            window_time(time),
+                                                            attributes,
+                                                            handle,
+                                                            mode,
+                                                            operationFlags,
+                                                            bytesRequest,
+                                                            matchingId);
+    if (m_balances_window)
+    {
+        filtered = open_record({{EventType::IoOperationBegin,
+                                 time,
+                                 OTF2_UNDEFINED_REGION,
+                                 handle,
+                                 mode,
+                                 operationFlags,
+                                 bytesRequest,
+                                 matchingId},
+                                !filtered});
+    }
+    count_event(EventType::IoOperationBegin, filtered);
+    if (!filtered)
+    {
+        writeIoOperationBeginEvent(location, time, attributes, handle, mode, operationFlags, bytesRequest, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleIoOperationTestEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_IoHandleRef    handle,
+                                        uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoOperationTest_filter.empty() &&
+                    m_event_IoOperationTest_filter.process(location, time, attributes, handle, matchingId);
+    count_event(EventType::IoOperationTest, filtered);
+    if (!filtered)
+    {
+        writeIoOperationTestEvent(location, time, attributes, handle, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleIoOperationIssuedEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_IoHandleRef    handle,
+                                          uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoOperationIssued_filter.empty() &&
+                    m_event_IoOperationIssued_filter.process(location, time, attributes, handle, matchingId);
+    count_event(EventType::IoOperationIssued, filtered);
+    if (!filtered)
+    {
+        writeIoOperationIssuedEvent(location, time, attributes, handle, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleIoOperationCompleteEvent(OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_IoHandleRef    handle,
+                                            uint64_t            bytesResult,
+                                            uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoOperationComplete_filter.empty() &&
+                    m_event_IoOperationComplete_filter.process(
+                        location, time, attributes, handle, bytesResult, matchingId);
+    if (m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::IoOperationBegin, handle, matchingId));
+    }
+    count_event(EventType::IoOperationComplete, filtered);
+    if (!filtered)
+    {
+        writeIoOperationCompleteEvent(location, time, attributes, handle, bytesResult, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleIoOperationCancelledEvent(OTF2_LocationRef    location,
+                                             OTF2_TimeStamp      time,
+                                             OTF2_AttributeList *attributes,
+                                             OTF2_IoHandleRef    handle,
+                                             uint64_t            matchingId)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoOperationCancelled_filter.empty() &&
+                    m_event_IoOperationCancelled_filter.process(location, time, attributes, handle, matchingId);
+    if (m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::IoOperationBegin, handle, matchingId));
+    }
+    count_event(EventType::IoOperationCancelled, filtered);
+    if (!filtered)
+    {
+        writeIoOperationCancelledEvent(location, time, attributes, handle, matchingId);
+    }
+}
+
+inline void
+TraceWriter::handleIoAcquireLockEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_IoHandleRef    handle,
+                                      OTF2_LockType       lockType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoAcquireLock_filter.empty() &&
+                    m_event_IoAcquireLock_filter.process(location, time, attributes, handle, lockType);
+    count_event(EventType::IoAcquireLock, filtered);
+    if (!filtered)
+    {
+        writeIoAcquireLockEvent(location, time, attributes, handle, lockType);
+    }
+}
+
+inline void
+TraceWriter::handleIoReleaseLockEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_IoHandleRef    handle,
+                                      OTF2_LockType       lockType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoReleaseLock_filter.empty() &&
+                    m_event_IoReleaseLock_filter.process(location, time, attributes, handle, lockType);
+    count_event(EventType::IoReleaseLock, filtered);
+    if (!filtered)
+    {
+        writeIoReleaseLockEvent(location, time, attributes, handle, lockType);
+    }
+}
+
+inline void
+TraceWriter::handleIoTryLockEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_IoHandleRef    handle,
+                                  OTF2_LockType       lockType)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_IoTryLock_filter.empty() &&
+                    m_event_IoTryLock_filter.process(location, time, attributes, handle, lockType);
+    count_event(EventType::IoTryLock, filtered);
+    if (!filtered)
+    {
+        writeIoTryLockEvent(location, time, attributes, handle, lockType);
+    }
+}
+
+inline void
+TraceWriter::handleProgramBeginEvent(OTF2_LocationRef      location,
+                                     OTF2_TimeStamp        time,
+                                     OTF2_AttributeList *  attributes,
+                                     OTF2_StringRef        programName,
+                                     uint32_t              numberOfArguments,
+                                     const OTF2_StringRef *programArguments)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ProgramBegin_filter.empty() &&
+                    m_event_ProgramBegin_filter.process(
+                        location, time, attributes, programName, numberOfArguments, programArguments);
+    count_event(EventType::ProgramBegin, filtered);
+    if (!filtered)
+    {
+        writeProgramBeginEvent(location, time, attributes, programName, numberOfArguments, programArguments);
+    }
+}
+
+inline void
+TraceWriter::handleProgramEndEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   int64_t             exitStatus)
+{
+    if (m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    bool filtered = !m_event_ProgramEnd_filter.empty() &&
+                    m_event_ProgramEnd_filter.process(location, time, attributes, exitStatus);
+    count_event(EventType::ProgramEnd, filtered);
+    if (!filtered)
+    {
+        writeProgramEndEvent(location, time, attributes, exitStatus);
+    }
+}
 
 #endif /* TRACE_WRITER_H */
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <location_queue.hpp>
+
+LocationQueue::LocationQueue(const LocationSchedule &schedule)
+{
+    for (const auto &worker_locations : schedule)
+    {
+        if (worker_locations.empty())
+        {
+            continue;
+        }
+        auto queue = std::make_unique<WorkerQueue>();
+        queue->locations.assign(worker_locations.begin(), worker_locations.end());
+        m_queues.push_back(std::move(queue));
+    }
+}
+
+bool
+LocationQueue::pop(std::size_t worker, OTF2_LocationRef &location)
+{
+    auto &queue = *m_queues.at(worker);
+    bool  taken = false;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.locations.empty())
+        {
+            location = queue.locations.front();
+            queue.locations.pop_front();
+            taken = true;
+        }
+    }
+    if (!taken)
+    {
+        taken = steal(worker, location);
+    }
+    if (taken && m_observer)
+    {
+        m_observer(location);
+    }
+    return taken;
+}
+
+bool
+LocationQueue::steal(std::size_t worker, OTF2_LocationRef &location)
+{
+    for (std::size_t i = 1; i < m_queues.size(); i++)
+    {
+        auto &victim = *m_queues[(worker + i) % m_queues.size()];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.locations.empty())
+        {
+            location = victim.locations.back();
+            victim.locations.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,37 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include <location_scheduler.hpp>
+
+LocationSchedule
+schedule_locations(const std::vector<LocationWeight> &locations, std::size_t nthreads)
+{
+    nthreads = std::max<std::size_t>(nthreads, 1);
+
+    std::vector<LocationWeight> sorted_locations(locations);
+    std::stable_sort(sorted_locations.begin(),
+                     sorted_locations.end(),
+                     [](const LocationWeight &lhs, const LocationWeight &rhs) {
+                         return lhs.number_of_events > rhs.number_of_events;
+                     });
+
+    using ThreadLoad = std::pair<uint64_t, std::size_t>;
+    std::priority_queue<ThreadLoad, std::vector<ThreadLoad>, std::greater<ThreadLoad>> loads;
+    for (std::size_t i = 0; i < nthreads; i++)
+    {
+        loads.push({0, i});
+    }
+
+    LocationSchedule schedule(nthreads);
+    for (const auto &location : sorted_locations)
+    {
+        auto [load, thread] = loads.top();
+        loads.pop();
+
+        schedule[thread].push_back(location.location);
+        loads.push({load + location.number_of_events + 1, thread});
+    }
+    return schedule;
+}
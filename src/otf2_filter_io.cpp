@@ -1,14 +1,147 @@
 #include <cxxopts.hpp>
 
+#include <dry_run_handler.hpp>
 #include <filesystem>
+#include <iomanip>
 #include <io_file_filter.hpp>
 #include <iostream>
+#include <limits>
+#include <location_index.hpp>
+#include <location_selection.hpp>
+#include <memory>
+#include <position_index.hpp>
+#include <record_class_filter.hpp>
+#include <region_filter.hpp>
+#include <stdexcept>
 #include <string>
+#include <time_window_filter.hpp>
 #include <trace_reader.hpp>
+#include <trace_stats.hpp>
 #include <trace_writer.hpp>
 
 namespace fs = std::filesystem;
 
+/*
+ * Parse a size in bytes with an optional K, M or G suffix.
+ *
+ * @throws std::invalid_argument if the size is no number or too large
+ */
+static uint64_t
+parse_size(const std::string &size)
+{
+    std::size_t end   = 0;
+    uint64_t    bytes = 0;
+    try
+    {
+        bytes = size.find('-') == std::string::npos ? std::stoull(size, &end) : 0;
+    }
+    catch (const std::logic_error &)
+    {
+        throw std::invalid_argument("Invalid size: " + size);
+    }
+    if (end == 0 || end + 1 < size.size())
+    {
+        throw std::invalid_argument("Invalid size: " + size);
+    }
+    uint64_t unit = 1;
+    if (end < size.size())
+    {
+        switch (size[end])
+        {
+        case 'G':
+            unit *= 1024;
+            [[fallthrough]];
+        case 'M':
+            unit *= 1024;
+            [[fallthrough]];
+        case 'K':
+            unit *= 1024;
+            break;
+        default:
+            throw std::invalid_argument("Unknown size suffix: " + size);
+        }
+    }
+    if (bytes > std::numeric_limits<uint64_t>::max() / unit)
+    {
+        throw std::invalid_argument("Invalid size: " + size);
+    }
+    return bytes * unit;
+}
+
+/*
+ * Print the hits of each pattern and the records a dry run dropped. The
+ * bytes saved are estimated from the share of dropped records in the event
+ * files of the locations read and in the global definitions.
+ */
+static void
+report_dry_run(const DryRunHandler &handler, const IoFileFilter &filter, const TraceStats &stats, const fs::path &trace)
+{
+    std::cout << std::left << std::setw(40) << "Pattern" << std::right << std::setw(12) << "Files" << std::setw(12)
+              << "Handles" << std::setw(16) << "Events" << '\n';
+    for (const auto &hits : filter.pattern_hits())
+    {
+        std::cout << std::left << std::setw(40) << hits.pattern << std::right << std::setw(12) << hits.files
+                  << std::setw(12) << hits.handles << std::setw(16) << hits.events << '\n';
+    }
+
+    uint64_t definitions         = 0;
+    uint64_t dropped_definitions = 0;
+    std::cout << '\n'
+              << std::left << std::setw(40) << "Definition" << std::right << std::setw(16) << "Handled"
+              << std::setw(16) << "Dropped" << '\n';
+    for (std::size_t type = 0; type < number_of_global_definitions; type++)
+    {
+        definitions += handler.definitions()[type];
+        dropped_definitions += handler.dropped_definitions()[type];
+        if (handler.dropped_definitions()[type] != 0)
+        {
+            std::cout << std::left << std::setw(40) << global_definition_names[type] << std::right << std::setw(16)
+                      << handler.definitions()[type] << std::setw(16) << handler.dropped_definitions()[type] << '\n';
+        }
+    }
+
+    auto events = stats.events();
+    std::cout << '\n'
+              << std::left << std::setw(40) << "Event" << std::right << std::setw(16) << "Read" << std::setw(16)
+              << "Dropped" << '\n';
+    for (std::size_t type = 0; type < number_of_event_types; type++)
+    {
+        if (events.read[type] != 0)
+        {
+            std::cout << std::left << std::setw(40) << event_type_names[type] << std::right << std::setw(16)
+                      << events.read[type] << std::setw(16) << events.filtered[type] << '\n';
+        }
+    }
+
+    std::error_code ec;
+    double          event_bytes    = 0;
+    std::size_t     locations_read = 0;
+    for (const auto &location : handler.locations())
+    {
+        if (!location.second.read)
+        {
+            continue;
+        }
+        locations_read++;
+        auto size = fs::file_size(fs::path(trace).replace_extension() / (std::to_string(location.first) + ".evt"), ec);
+        if (!ec && location.second.announced != 0)
+        {
+            event_bytes += static_cast<double>(size) * location.second.dropped / location.second.announced;
+        }
+    }
+    double definition_bytes = 0;
+    auto   size             = fs::file_size(fs::path(trace).replace_extension(".def"), ec);
+    if (!ec && definitions != 0)
+    {
+        definition_bytes = static_cast<double>(size) * dropped_definitions / definitions;
+    }
+
+    std::cout << "\nLocations read: " << locations_read << " of " << handler.locations().size() << '\n';
+    std::cout << "Estimated bytes saved: " << static_cast<uint64_t>(event_bytes + definition_bytes) << " ("
+              << static_cast<uint64_t>(event_bytes) << " in events, " << static_cast<uint64_t>(definition_bytes)
+              << " in global definitions)\n";
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -25,13 +158,90 @@ main(int argc, char *argv[])
         "t,threads",
         "Number of threads used for "
         "processing",
-        cxxopts::value<size_t>()->default_value("2"))("h,help",
-                                                      "otf2_filter_io -i "
-                                                      "/input/trace.otf2 -o "
-                                                      "/output/folder -f filter");
+        cxxopts::value<size_t>()->default_value("2"))("p,pipeline",
+                                                      "Process events while the "
+                                                      "definitions not needed by "
+                                                      "the filter are written")(
+        "reader-per-worker",
+        "Open a reader on the input trace for "
+        "every thread instead of sharing one")(
+        "prefetch",
+        "Number of locations whose files are read "
+        "ahead of the threads, 0 to disable",
+        cxxopts::value<size_t>()->default_value("0"))(
+        "begin",
+        "Drop the events before this timestamp",
+        cxxopts::value<uint64_t>())("end",
+                                    "Drop the events after this timestamp "
+                                    "and stop reading a location there",
+                                    cxxopts::value<uint64_t>())(
+        "regions",
+        "Drop the Enter and Leave events of the regions "
+        "matched by a pattern or Score-P filter file",
+        cxxopts::value<std::string>())(
+        "locations",
+        "Only keep the locations whose name matches "
+        "one of these patterns",
+        cxxopts::value<std::vector<std::string>>())(
+        "location-groups",
+        "Only keep the locations whose location group or "
+        "system tree node matches one of these patterns",
+        cxxopts::value<std::vector<std::string>>())(
+        "location-types",
+        "Only keep locations of these types: cpu_thread, "
+        "gpu, metric or unknown",
+        cxxopts::value<std::vector<std::string>>())(
+        "drop-records",
+        "Drop all events of these record classes without "
+        "decoding them: omp, thread, rma or calling_context",
+        cxxopts::value<std::vector<std::string>>())(
+        "decode-all",
+        "Rewrite every location instead of copying "
+        "the files of locations the filter does not affect")(
+        "index",
+        "Tell the affected locations from an index next "
+        "to the input trace, the index is written if it "
+        "does not exist yet")("positions",
+                               "Seek each location to --begin with a position "
+                               "index next to the input trace, the index is "
+                               "written if it does not exist yet")("dry-run",
+                               "Only count the records the filter "
+                               "would drop, no output trace is "
+                               "written")("stats",
+                               "Report the events read, filtered and "
+                               "written and the time of each phase, "
+                               "as text or json",
+                               cxxopts::value<std::string>()->implicit_value("text"))("h,help",
+                                                             "otf2_filter_io -i "
+                                                             "/input/trace.otf2 -o "
+                                                             "/output/folder -f filter");
+
+    options.add_options("Output trace")("c,compression",
+                                        "Compression of the output trace, "
+                                        "none or zlib",
+                                        cxxopts::value<std::string>()->default_value("none"))(
+        "event-chunk-size",
+        "Size of the event chunks in bytes, "
+        "auto picks it from the number of "
+        "events of the input locations",
+        cxxopts::value<std::string>()->default_value("1048576"))(
+        "def-chunk-size",
+        "Size of the definition chunks in bytes",
+        cxxopts::value<uint64_t>()->default_value("4194304"))("huge-pages",
+                                                              "Back the chunks with "
+                                                              "transparent huge pages")(
+        "memory-limit",
+        "Bound the memory of the output chunks, "
+        "e.g. 512M or 4G, by reading fewer locations "
+        "at once and flushing early",
+        cxxopts::value<std::string>())("referenced-strings",
+                                       "Only keep the strings the filter "
+                                       "resolves, at the cost of an extra pass "
+                                       "over the global definitions");
 
     auto result = options.parse(argc, argv);
-    if (result.count("help") || result.count("input") == 0 || result.count("output") == 0 ||
+    bool dry_run = result.count("dry-run") > 0;
+    if (result.count("help") || result.count("input") == 0 || (result.count("output") == 0 && !dry_run) ||
         result.count("filter") == 0)
     {
         std::cout << options.help() << '\n';
@@ -46,8 +256,8 @@ main(int argc, char *argv[])
         exit(0);
     }
 
-    fs::path output_trace(result["output"].as<std::string>());
-    if (fs::exists(output_trace))
+    fs::path output_trace(dry_run ? "" : result["output"].as<std::string>());
+    if (!dry_run && fs::exists(output_trace))
     {
         std::cout << "Output trace "
                      "does exists\n";
@@ -64,10 +274,316 @@ main(int argc, char *argv[])
 
     size_t number_of_threads = result["threads"].as<size_t>();
 
+    TraceStats  stats;
+    std::string stats_format;
+    if (result.count("stats"))
+    {
+        stats_format = result["stats"].as<std::string>();
+        if (stats_format != "text" && stats_format != "json")
+        {
+            std::cout << "Unknown statistics format: " << stats_format << '\n';
+            exit(0);
+        }
+    }
+    TraceStats *trace_stats = stats_format.empty() ? nullptr : &stats;
+
+    TraceReaderOptions reader_options;
+    reader_options.pipelined         = result.count("pipeline") > 0;
+    reader_options.copy_locations    = result.count("decode-all") == 0;
+    reader_options.reader_per_worker = result.count("reader-per-worker") > 0;
+    reader_options.prefetch_distance = result["prefetch"].as<size_t>();
+    reader_options.stats             = trace_stats;
+
+    TraceWriterOptions writer_options;
+    auto               compression = result["compression"].as<std::string>();
+    if (compression == "zlib")
+    {
+        writer_options.compression = OTF2_COMPRESSION_ZLIB;
+    }
+    else if (compression != "none")
+    {
+        std::cout << "Unknown compression: " << compression << '\n';
+        exit(0);
+    }
+
+    try
+    {
+        auto chunk_size = result["event-chunk-size"].as<std::string>();
+        if (chunk_size == "auto")
+        {
+            writer_options.event_chunk_size = event_chunk_size(TraceReader::read_locations(input_trace));
+        }
+        else
+        {
+            writer_options.event_chunk_size = parse_size(chunk_size);
+        }
+        if (result.count("memory-limit"))
+        {
+            writer_options.memory_limit = parse_size(result["memory-limit"].as<std::string>());
+        }
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+        exit(0);
+    }
+    writer_options.definition_chunk_size = result["def-chunk-size"].as<uint64_t>();
+    writer_options.huge_pages            = result.count("huge-pages") > 0;
+    writer_options.referenced_strings    = result.count("referenced-strings") > 0;
+    writer_options.stats                 = trace_stats;
+    for (auto size : {writer_options.event_chunk_size, writer_options.definition_chunk_size})
+    {
+        if (size < min_chunk_size || size > max_chunk_size)
+        {
+            std::cout << "Chunk sizes have to be between 256K and 16M: " << size << '\n';
+            exit(0);
+        }
+    }
+    if (result.count("memory-limit"))
+    {
+        reader_options.max_open_locations = open_location_limit(writer_options);
+    }
+
     IoFileFilter filter(filter_file);
-    TraceWriter  writer(output_trace);
-    writer.register_filter(filter);
-    TraceReader reader(input_trace, writer, number_of_threads);
-    reader.read();
+
+    std::unique_ptr<RegionFilter> region_filter;
+    if (result.count("regions"))
+    {
+        fs::path region_file(result["regions"].as<std::string>());
+        try
+        {
+            region_filter = std::make_unique<RegionFilter>(region_file);
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cout << e.what() << '\n';
+            exit(0);
+        }
+    }
+
+    TimeWindow window;
+    if (result.count("begin"))
+    {
+        window.begin = result["begin"].as<uint64_t>();
+    }
+    if (result.count("end"))
+    {
+        window.end = result["end"].as<uint64_t>();
+    }
+    TimeWindowFilter time_filter(window);
+    bool             time_window = result.count("begin") > 0 || result.count("end") > 0;
+
+    LocationSelection selection;
+    bool              select_locations =
+        result.count("locations") > 0 || result.count("location-groups") > 0 || result.count("location-types") > 0;
+    if (result.count("locations"))
+    {
+        for (const auto &pattern : result["locations"].as<std::vector<std::string>>())
+        {
+            selection.add_location_pattern(pattern);
+        }
+    }
+    if (result.count("location-groups"))
+    {
+        for (const auto &pattern : result["location-groups"].as<std::vector<std::string>>())
+        {
+            selection.add_group_pattern(pattern);
+        }
+    }
+    if (result.count("location-types"))
+    {
+        try
+        {
+            for (const auto &type : result["location-types"].as<std::vector<std::string>>())
+            {
+                selection.add_type(LocationSelection::parse_type(type));
+            }
+        }
+        catch (const std::invalid_argument &e)
+        {
+            std::cout << e.what() << '\n';
+            exit(0);
+        }
+    }
+
+    RecordClassFilter record_classes;
+    if (result.count("drop-records"))
+    {
+        try
+        {
+            for (const auto &name : result["drop-records"].as<std::vector<std::string>>())
+            {
+                record_classes.add_class(RecordClassFilter::parse_class(name));
+            }
+        }
+        catch (const std::invalid_argument &e)
+        {
+            std::cout << e.what() << '\n';
+            exit(0);
+        }
+    }
+
+    /*
+     * Without a readable position index, the positions of the events are
+     * sampled while the trace is read.
+     */
+    fs::path                               positions_file = PositionIndex::path_of(input_trace);
+    PositionIndex                          positions;
+    std::unique_ptr<PositionIndexRecorder> position_recorder;
+    if (result.count("positions"))
+    {
+        try
+        {
+            if (fs::exists(positions_file))
+            {
+                positions                = PositionIndex::read(positions_file, input_trace);
+                reader_options.positions = &positions;
+            }
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cout << e.what() << '\n';
+        }
+        if (reader_options.positions == nullptr)
+        {
+            position_recorder                = std::make_unique<PositionIndexRecorder>(input_trace);
+            reader_options.position_recorder = position_recorder.get();
+        }
+    }
+
+    if (dry_run)
+    {
+        fs::path index_file = LocationIndex::path_of(input_trace);
+        try
+        {
+            if (result.count("index") && fs::exists(index_file))
+            {
+                filter.set_location_index(LocationIndex::read(index_file, input_trace));
+            }
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cout << e.what() << '\n';
+        }
+
+        filter.count_pattern_hits();
+        DryRunHandler handler(stats, writer_options.referenced_strings);
+        if (select_locations)
+        {
+            handler.register_filter(selection);
+        }
+        if (time_window)
+        {
+            handler.register_filter(time_filter);
+        }
+        if (region_filter)
+        {
+            handler.register_filter(*region_filter);
+        }
+        if (result.count("drop-records"))
+        {
+            handler.register_filter(record_classes);
+        }
+        handler.register_filter(filter);
+        TraceReader reader(input_trace, handler, number_of_threads, reader_options);
+        reader.read();
+        report_dry_run(handler, filter, stats, input_trace);
+        if (region_filter)
+        {
+            std::cout << "Filtered regions: " << region_filter->filtered_regions().size() << '\n';
+        }
+    }
+    else
+    {
+        TraceWriter writer(output_trace, writer_options);
+        if (select_locations)
+        {
+            writer.register_filter(selection);
+        }
+        if (time_window)
+        {
+            writer.register_filter(time_filter);
+        }
+        if (region_filter)
+        {
+            writer.register_filter(*region_filter);
+        }
+        if (result.count("drop-records"))
+        {
+            writer.register_filter(record_classes);
+        }
+        writer.register_filter(filter);
+
+        /*
+         * Without a readable index, all locations are read once to write
+         * it, an index that cannot be read is replaced. The recorder sees
+         * every event, it is called before the other filters. Reading stops
+         * at the end of a time window and unselected locations are not read
+         * at all, no index is recorded then.
+         */
+        fs::path                               index_file = LocationIndex::path_of(input_trace);
+        std::unique_ptr<LocationIndexRecorder> recorder;
+        if (result.count("index"))
+        {
+            bool index_read = false;
+            try
+            {
+                if (fs::exists(index_file))
+                {
+                    filter.set_location_index(LocationIndex::read(index_file, input_trace));
+                    index_read = true;
+                }
+            }
+            catch (const std::runtime_error &e)
+            {
+                std::cout << e.what() << '\n';
+            }
+            if (!index_read && !time_window && !select_locations)
+            {
+                recorder = std::make_unique<LocationIndexRecorder>(input_trace);
+                writer.register_filter(*recorder, std::numeric_limits<int>::min());
+            }
+        }
+
+        TraceReader reader(input_trace, writer, number_of_threads, reader_options);
+        reader.read();
+
+        if (recorder)
+        {
+            try
+            {
+                recorder->index().write(index_file);
+            }
+            catch (const std::runtime_error &e)
+            {
+                std::cout << e.what() << '\n';
+            }
+        }
+    }
+
+    if (position_recorder)
+    {
+        try
+        {
+            position_recorder->index().write(positions_file);
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cout << e.what() << '\n';
+        }
+    }
+
+    if (trace_stats != nullptr)
+    {
+        stats.set_filtered_files(filter.filtered_files());
+        if (stats_format == "json")
+        {
+            stats.write_json(std::cout);
+        }
+        else
+        {
+            stats.write_text(std::cout);
+        }
+    }
     return 0;
 }
\ No newline at end of file
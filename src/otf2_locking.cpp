@@ -0,0 +1,55 @@
+#include <mutex>
+#include <new>
+
+#include <otf2_locking.hpp>
+
+struct OTF2_LockObject
+{
+    std::mutex mutex;
+};
+
+static OTF2_CallbackCode
+create_lock(void *userData, OTF2_Lock *lock)
+{
+    *lock = new (std::nothrow) OTF2_LockObject;
+    return *lock != nullptr ? OTF2_CALLBACK_SUCCESS : OTF2_CALLBACK_ERROR;
+}
+
+static OTF2_CallbackCode
+destroy_lock(void *userData, OTF2_Lock lock)
+{
+    delete lock;
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+static OTF2_CallbackCode
+lock_lock(void *userData, OTF2_Lock lock)
+{
+    lock->mutex.lock();
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+static OTF2_CallbackCode
+unlock_lock(void *userData, OTF2_Lock lock)
+{
+    lock->mutex.unlock();
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+static const OTF2_LockingCallbacks locking_callbacks = {.otf2_release = nullptr,
+                                                        .otf2_create  = create_lock,
+                                                        .otf2_destroy = destroy_lock,
+                                                        .otf2_lock    = lock_lock,
+                                                        .otf2_unlock  = unlock_lock};
+
+OTF2_ErrorCode
+set_locking_callbacks(OTF2_Archive *archive)
+{
+    return OTF2_Archive_SetLockingCallbacks(archive, &locking_callbacks, nullptr);
+}
+
+OTF2_ErrorCode
+set_locking_callbacks(OTF2_Reader *reader)
+{
+    return OTF2_Reader_SetLockingCallbacks(reader, &locking_callbacks, nullptr);
+}
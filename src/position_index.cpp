@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <position_index.hpp>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char *index_header = "otf2_filter_io position index 2";
+
+fs::path
+event_file(const fs::path &trace, OTF2_LocationRef location)
+{
+    return fs::path(trace).replace_extension() / (std::to_string(location) + ".evt");
+}
+} // namespace
+
+fs::path
+PositionIndex::path_of(const fs::path &trace)
+{
+    return fs::path(trace).replace_extension(".positions");
+}
+
+void
+PositionIndex::add(OTF2_LocationRef location, LocationPositions positions)
+{
+    m_locations[location] = std::move(positions);
+}
+
+/*
+ * Events at the time of a sample may precede it, only samples before the
+ * time are used.
+ */
+const PositionSample *
+PositionIndex::seek_sample(OTF2_LocationRef location, OTF2_TimeStamp time) const
+{
+    auto search = m_locations.find(location);
+    if (search == m_locations.end())
+    {
+        return nullptr;
+    }
+    auto        earlier = [](const PositionSample &sample, OTF2_TimeStamp t) { return sample.time < t; };
+    const auto &samples = search->second.samples;
+    auto        after   = std::lower_bound(samples.begin(), samples.end(), time, earlier);
+    return after == samples.begin() ? nullptr : &*std::prev(after);
+}
+
+uint64_t
+PositionIndex::seek_position(OTF2_LocationRef location, OTF2_TimeStamp time) const
+{
+    const auto *sample = seek_sample(location, time);
+    return sample != nullptr ? sample->position : 0;
+}
+
+/*
+ * One line per location, followed by a line per sample with the number of
+ * open events and their fields:
+ *
+ *     location <ref> <event file size>
+ *     <time> <position> <open events> [<type> <time> <region> <handle>
+ *         <mode> <flags> <bytes request> <matching id>]...
+ */
+void
+PositionIndex::write(const fs::path &index) const
+{
+    std::ofstream out(index, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+    {
+        throw std::runtime_error("Could not write position index: " + index.string());
+    }
+    out << index_header << '\n';
+    for (const auto &location : m_locations)
+    {
+        out << "location " << location.first << ' ' << location.second.event_file_size << '\n';
+        for (const auto &sample : location.second.samples)
+        {
+            out << sample.time << ' ' << sample.position << ' ' << sample.open.size();
+            for (const auto &event : sample.open)
+            {
+                out << ' ' << static_cast<std::size_t>(event.type) << ' ' << event.time << ' ' << event.region << ' '
+                    << event.handle << ' ' << static_cast<uint64_t>(event.mode) << ' '
+                    << static_cast<uint64_t>(event.flags) << ' ' << event.bytes_request << ' ' << event.matching_id;
+            }
+            out << '\n';
+        }
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Could not write position index: " + index.string());
+    }
+}
+
+PositionIndex
+PositionIndex::read(const fs::path &index, const fs::path &trace)
+{
+    std::ifstream in(index, std::ios::in);
+    std::string   line;
+    if (!in.is_open() || !std::getline(in, line) || line != index_header)
+    {
+        throw std::runtime_error("Could not read position index: " + index.string());
+    }
+
+    PositionIndex       result;
+    LocationPositions * positions = nullptr;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        if (line.compare(0, 9, "location ") == 0)
+        {
+            std::string      keyword;
+            OTF2_LocationRef location = OTF2_UNDEFINED_LOCATION;
+            fields >> keyword >> location;
+            positions = &result.m_locations[location];
+            fields >> positions->event_file_size;
+        }
+        else if (positions != nullptr)
+        {
+            PositionSample sample{};
+            std::size_t    open = 0;
+            fields >> sample.time >> sample.position >> open;
+            for (std::size_t i = 0; i < open && fields; i++)
+            {
+                std::size_t type = 0;
+                uint64_t    mode = 0;
+                uint64_t    flags = 0;
+                OpenEvent   event{EventType::Enter};
+                fields >> type >> event.time >> event.region >> event.handle >> mode >> flags >> event.bytes_request >>
+                    event.matching_id;
+                if (type >= number_of_event_types)
+                {
+                    throw std::runtime_error("Invalid position index: " + index.string());
+                }
+                event.type  = static_cast<EventType>(type);
+                event.mode  = static_cast<OTF2_IoOperationMode>(mode);
+                event.flags = static_cast<OTF2_IoOperationFlag>(flags);
+                sample.open.push_back(event);
+            }
+            positions->samples.push_back(std::move(sample));
+        }
+        else
+        {
+            throw std::runtime_error("Invalid position index: " + index.string());
+        }
+        if (fields.fail())
+        {
+            throw std::runtime_error("Invalid position index: " + index.string());
+        }
+    }
+
+    for (auto it = result.m_locations.begin(); it != result.m_locations.end();)
+    {
+        std::error_code ec;
+        auto            size = fs::file_size(event_file(trace, it->first), ec);
+        if (ec || size != it->second.event_file_size)
+        {
+            it = result.m_locations.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return result;
+}
+
+PositionIndexRecorder::PositionIndexRecorder(const fs::path &trace, uint64_t interval)
+    : m_trace(trace), m_interval(std::max<uint64_t>(interval, 1))
+{
+}
+
+void
+PositionIndexRecorder::add(OTF2_LocationRef location, std::vector<PositionSample> samples)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_samples[location] = std::move(samples);
+}
+
+PositionIndex
+PositionIndexRecorder::index() const
+{
+    PositionIndex               result;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &location : m_samples)
+    {
+        LocationPositions positions;
+        std::error_code   ec;
+        positions.event_file_size = fs::file_size(event_file(m_trace, location.first), ec);
+        positions.samples         = location.second;
+        result.add(location.first, std::move(positions));
+    }
+    return result;
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <prefetcher.hpp>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <unistd.h>
+}
+
+namespace
+{
+/*
+ * Missing files, e.g. of locations without local definitions, are
+ * ignored.
+ */
+void
+advise_file(const std::filesystem::path &file)
+{
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+}
+} // namespace
+
+Prefetcher::Prefetcher(const std::filesystem::path &directory,
+                       const LocationSchedule &     schedule,
+                       std::size_t                  distance,
+                       AdviseFunction               advise)
+    : m_directory(directory), m_distance(distance), m_advise(advise ? std::move(advise) : advise_file)
+{
+    std::size_t rounds = 0;
+    for (const auto &locations : schedule)
+    {
+        rounds = std::max(rounds, locations.size());
+    }
+    for (std::size_t round = 0; round < rounds; round++)
+    {
+        for (const auto &locations : schedule)
+        {
+            if (round < locations.size())
+            {
+                m_order.push_back(locations[round]);
+            }
+        }
+    }
+    m_thread = std::thread(&Prefetcher::run, this);
+}
+
+Prefetcher::~Prefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void
+Prefetcher::advance()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_taken++;
+    }
+    m_condition.notify_one();
+}
+
+void
+Prefetcher::run()
+{
+    while (true)
+    {
+        OTF2_LocationRef location;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stop || m_advised < m_taken + m_distance; });
+            if (m_stop || m_advised == m_order.size())
+            {
+                return;
+            }
+            location = m_order[m_advised++];
+        }
+        m_advise(m_directory / (std::to_string(location) + ".evt"));
+        m_advise(m_directory / (std::to_string(location) + ".def"));
+    }
+}
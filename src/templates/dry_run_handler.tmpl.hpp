@@ -0,0 +1,349 @@
+#ifndef DRY_RUN_HANDLER_H
+#define DRY_RUN_HANDLER_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+    #include <otf2/otf2.h>
+}
+
+#include <filter.hpp>
+#include <otf2_handler.hpp>
+#include <string_table.hpp>
+#include <trace_stats.hpp>
+
+/*
+ * Applies registered filters like TraceWriter, but only counts the records
+ * they would drop instead of writing an archive.
+ *
+ * Only event types a filter has a callback for or drops as a whole are
+ * decoded, see handlesEvent(), and locations no filter affects are not
+ * read at all.
+ * Events are counted in the thread statistics of a TraceStats.
+ */
+class DryRunHandler: public Otf2Handler
+{
+  public:
+    /*
+     * Events of a location, the number is announced by its definition.
+     */
+    struct LocationEvents
+    {
+        uint64_t announced = 0;
+        uint64_t dropped = 0;
+        uint64_t kept = 0;
+        bool read = false;
+    };
+
+    /*
+     * @param stats statistics the events are counted in, has to outlive
+     *        the handler
+     * @param referenced_strings only keep the strings the filters resolve,
+     *        see TraceWriterOptions::referenced_strings
+     */
+    explicit DryRunHandler(TraceStats &stats, bool referenced_strings = false)
+    :m_stats(stats)
+    {
+        if(referenced_strings)
+        {
+            m_strings.set_mode(StringTable::Mode::Referenced);
+        }
+    }
+
+    /*
+     * Register the callbacks of a filter, see TraceWriter::register_filter().
+     */
+    void
+    register_filter(IFilterCallbacks & filter, int priority = 0)
+    {
+        for(auto definition: filter.string_references())
+        {
+            if(definition == GlobalDefinition::String)
+            {
+                m_strings.set_mode(StringTable::Mode::All);
+            }
+            else if(std::find(m_string_references.begin(),
+                              m_string_references.end(),
+                              definition) == m_string_references.end())
+            {
+                m_string_references.push_back(definition);
+            }
+        }
+        filter.set_string_table(m_strings);
+
+        auto window = filter.time_window();
+        m_time_window.begin = std::max(m_time_window.begin, window.begin);
+        m_time_window.end = std::min(m_time_window.end, window.end);
+
+        auto cbs = filter.get_callbacks();
+        bool handles_events = false;
+
+        @otf2 for def in defs|global_defs:
+        if(cbs.global_@@def.lower@@_callback)
+        {
+            m_global_@@def.name@@_filter.add(cbs.global_@@def.lower@@_callback, priority);
+        }
+        @otf2 endfor
+
+        @otf2 for event in events:
+        if(cbs.event_@@event.lower@@_callback)
+        {
+            m_event_@@event.name@@_filter.add(cbs.event_@@event.lower@@_callback, priority);
+            m_handled_events[static_cast<std::size_t>(EventType::@@event.name@@)] = true;
+            handles_events = true;
+        }
+        @otf2 endfor
+
+        /*
+         * The writer would not decode events of dropped types, they are
+         * still read here to count them.
+         */
+        for(auto type: filter.dropped_event_types())
+        {
+            m_handled_events[static_cast<std::size_t>(type)] = true;
+            m_dropped_events[static_cast<std::size_t>(type)] = true;
+            handles_events = true;
+        }
+
+        if(handles_events)
+        {
+            m_location_filters.push_back(&filter);
+        }
+    }
+
+    /*
+     * Global definitions handled and dropped, indexed by GlobalDefinition.
+     */
+    inline const std::array<uint64_t, number_of_global_definitions> &
+    definitions() const
+    {
+        return m_definitions;
+    }
+
+    inline const std::array<uint64_t, number_of_global_definitions> &
+    dropped_definitions() const
+    {
+        return m_dropped_definitions;
+    }
+
+    inline const std::unordered_map<OTF2_LocationRef, LocationEvents> &
+    locations() const
+    {
+        return m_locations;
+    }
+
+    virtual std::vector<GlobalDefinition>
+    stringReferencingDefinitions() override
+    {
+        if(m_strings.mode() == StringTable::Mode::All)
+        {
+            return {};
+        }
+        return m_string_references;
+    }
+
+    virtual void
+    handleStringReference(GlobalDefinition definition, OTF2_StringRef string) override
+    {
+        m_strings.reference(string);
+    }
+
+    /*
+     * Begin and end of the time window of the registered filters, the
+     * locations are read like by a TraceWriter.
+     */
+    virtual OTF2_TimeStamp
+    eventsBegin() override
+    {
+        return m_time_window.begin;
+    }
+
+    virtual OTF2_TimeStamp
+    eventsEnd() override
+    {
+        return m_time_window.end;
+    }
+
+    virtual bool
+    handlesEvent(EventType type) override
+    {
+        return m_handled_events[static_cast<std::size_t>(type)];
+    }
+
+    /*
+     * Locations no filter affects need not be read, nothing is copied.
+     */
+    virtual bool
+    copyLocation(const ArchiveLayout &input, OTF2_LocationRef location) override
+    {
+        return std::none_of(m_location_filters.begin(), m_location_filters.end(),
+                            [location](IFilterCallbacks * filter){ return filter->affects_location(location); });
+    }
+
+    /*
+     * Locations whose definition a filter dropped are not read.
+     */
+    virtual bool
+    selectsLocation(OTF2_LocationRef location) override
+    {
+        return m_locations.count(location) > 0;
+    }
+
+    virtual void
+    beginLocation(OTF2_LocationRef location) override
+    {
+        auto search = m_locations.find(location);
+        LocationEvents * events = search != m_locations.end() ? &search->second : nullptr;
+        if(events != nullptr)
+        {
+            events->read = true;
+        }
+        m_thread_location = {
+            .owner = this,
+            .events = events,
+            .counters = &m_stats.thread_stats().events};
+    }
+
+    virtual void
+    endLocation(OTF2_LocationRef location) override
+    {
+        /*
+         * With a time window every event type is decoded, the events not
+         * read lie outside of the window and are dropped.
+         */
+        auto * events = m_thread_location.events;
+        if(events != nullptr && (m_time_window.begin != 0 || m_time_window.end != OTF2_UNDEFINED_TIMESTAMP))
+        {
+            events->dropped = std::max(events->dropped, events->announced - std::min(events->announced, events->kept));
+        }
+        m_thread_location = {.owner = nullptr, .events = nullptr, .counters = nullptr};
+    }
+
+    /*
+     * Handle global definitions
+     */
+    @otf2 for def in defs|global_defs:
+
+    virtual void
+    handleGlobal@@def.name@@(@@def.funcargs(leading_comma=False)@@) override
+    {
+        @otf2  if def.name == 'Location':
+        m_locations[self].announced = numberOfEvents;
+        @otf2 endif
+        @otf2  if def.name == 'String':
+        m_strings.add(self, string);
+        @otf2 endif
+        bool dropped = ! m_global_@@def.name@@_filter.empty() &&
+                       m_global_@@def.name@@_filter.process(@@def.callargs(leading_comma=False)@@);
+        count_definition(GlobalDefinition::@@def.name@@, dropped);
+        @otf2  if def.name == 'Location':
+        if(dropped)
+        {
+            m_locations.erase(self);
+        }
+        @otf2 endif
+    }
+
+    @otf2 endfor
+
+    /*
+     * Local definitions are not filtered.
+     */
+    @otf2 for def in defs|local_defs:
+    @otf2 if "MappingTable" == def.name or "ClockOffset" == def.name:
+
+    virtual void
+    handleLocal@@def.name@@(OTF2_LocationRef readLocation,
+                            @@def.funcargs(leading_comma=False)@@) override
+    {}
+
+    @otf2 endif
+    @otf2 endfor
+
+    /*
+     * Handle events.
+     */
+    @otf2 for event in events:
+
+    virtual void
+    handle@@event.name@@Event(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList* attributes@@event.funcargs()@@) override
+    {
+        bool dropped = ! m_event_@@event.name@@_filter.empty() &&
+                       m_event_@@event.name@@_filter.process(location, time, attributes@@event.callargs()@@);
+        count_event(EventType::@@event.name@@, dropped);
+    }
+
+    @otf2 endfor
+
+  private:
+    /*
+     * Location the current thread is reading.
+     */
+    struct ThreadLocation
+    {
+        const DryRunHandler * owner;
+        LocationEvents * events;
+        EventCounters * counters;
+    };
+
+    inline void
+    count_definition(GlobalDefinition definition, bool dropped)
+    {
+        m_definitions[static_cast<std::size_t>(definition)]++;
+        m_dropped_definitions[static_cast<std::size_t>(definition)] += dropped;
+    }
+
+    inline void
+    count_event(EventType type, bool dropped)
+    {
+        if(m_thread_location.owner != this)
+        {
+            return;
+        }
+        dropped = dropped || m_dropped_events[static_cast<std::size_t>(type)];
+        m_thread_location.counters->read[static_cast<std::size_t>(type)]++;
+        m_thread_location.counters->filtered[static_cast<std::size_t>(type)] += dropped;
+        if(m_thread_location.events != nullptr)
+        {
+            m_thread_location.events->dropped += dropped;
+            m_thread_location.events->kept += ! dropped;
+        }
+    }
+
+    static inline thread_local ThreadLocation m_thread_location = {
+        .owner = nullptr, .events = nullptr, .counters = nullptr};
+
+    TraceStats & m_stats;
+    StringTable m_strings;
+    std::vector<GlobalDefinition> m_string_references;
+    std::vector<IFilterCallbacks *> m_location_filters;
+    TimeWindow m_time_window;
+    std::array<bool, number_of_event_types> m_handled_events{};
+    std::array<bool, number_of_event_types> m_dropped_events{};
+    std::array<uint64_t, number_of_global_definitions> m_definitions{};
+    std::array<uint64_t, number_of_global_definitions> m_dropped_definitions{};
+
+    /*
+     * Created with the location definitions, the entry of a location is
+     * only written by the worker reading it.
+     */
+    std::unordered_map<OTF2_LocationRef, LocationEvents> m_locations;
+
+    @otf2 for def in defs|global_defs:
+    Filter<Global@@def.name@@Filter> m_global_@@def.name@@_filter;
+    @otf2 endfor
+
+    @otf2 for event in events:
+    Filter<Event@@event.name@@Filter> m_event_@@event.name@@_filter;
+    @otf2 endfor
+};
+
+#endif /* DRY_RUN_HANDLER_H */
@@ -1,14 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 extern "C"
 {
     #include <otf2/otf2.h>
 }
 
+#include <otf2_handler.hpp>
+#include <string_table.hpp>
+
 template<typename...ArgTypes>
 using FilterCallback = std::function<bool(ArgTypes...args)>;
 
@@ -72,6 +79,19 @@ OTF2_LocationRef
 
 @otf2 endfor
 
+/*
+ * Record tags, select the record a static filter is invoked for.
+ */
+namespace record
+{
+@otf2 for def in defs|global_defs:
+struct Global@@def.name@@ {};
+@otf2 endfor
+@otf2 for event in events:
+struct Event@@event.name@@ {};
+@otf2 endfor
+}
+
 class IFilterCallbacks
 {
 public:
@@ -105,27 +125,227 @@ public:
         @otf2 endfor
     };
     virtual Callbacks get_callbacks() = 0;
+
+    /*
+     * Global definition types whose string references the filter looks up
+     * in the string table, GlobalDefinition::String asks for all strings.
+     */
+    virtual std::vector<GlobalDefinition> string_references() const
+    {
+        return {};
+    }
+
+    /*
+     * Attach the string table of the writer the filter is registered at.
+     */
+    virtual void set_string_table(const StringTable & strings)
+    {
+        m_string_table = &strings;
+    }
+
+    /*
+     * Whether the filter may drop records of the given location, asked
+     * once the global definitions the events depend on were handled.
+     * Locations no filter affects are copied without reading their events.
+     * Only asked if the filter has event or local definition callbacks.
+     */
+    virtual bool affects_location(OTF2_LocationRef location)
+    {
+        return true;
+    }
+
+    /*
+     * Time window outside of which the filter drops every event. Readers
+     * stop reading a location once its events pass the end.
+     */
+    virtual TimeWindow time_window() const
+    {
+        return {};
+    }
+
+    /*
+     * Event types the filter drops as a whole. Writers do not let the
+     * reader register callbacks for them, their events are skipped while
+     * decoding and never reach a filter or handler.
+     */
+    virtual std::vector<EventType> dropped_event_types() const
+    {
+        return {};
+    }
+
+    /*
+     * Types of attribute values the filter removes from the attribute
+     * lists of the events, e.g. references to definitions it drops.
+     * Locations with events cannot be copied then.
+     */
+    virtual std::vector<OTF2_Type> dropped_attribute_types() const
+    {
+        return {};
+    }
+
+protected:
+    const StringTable * m_string_table = nullptr;
 };
 
+/*
+ * Filter chain of one record type, assembled at runtime.
+ *
+ * Callbacks are evaluated in ascending order of their priority and, for
+ * equal priorities, in the order they were added. The first callback
+ * returning true drops the record and the remaining callbacks do not see
+ * it. Callbacks that have to observe every record, e.g. to collect
+ * definitions, need a lower priority value than the callbacks dropping
+ * records of the same type. Expensive callbacks should get a high value.
+ */
 template<typename T>
 class Filter
 {
 public:
-    inline void add(T & f)
+    /*
+     * @param f callback returning true if the record should be dropped
+     * @param priority callbacks with lower values are evaluated first
+     */
+    inline void add(const T & f, int priority = 0)
     {
-        m_callbacks.push_back(f);
+        auto position = std::upper_bound(m_callbacks.begin(),
+                                         m_callbacks.end(),
+                                         priority,
+                                         [](int p, const Entry & e)
+                                         {
+                                             return p < e.priority;
+                                         });
+        m_callbacks.insert(position, {priority, f});
+    }
+
+    inline bool empty() const
+    {
+        return m_callbacks.empty();
     }
 
     template<typename...ArgTypes>
     inline bool process(ArgTypes...args)
     {
-        bool b = false;
-        for(auto f: m_callbacks)
+        for(const auto & entry: m_callbacks)
+        {
+            if(entry.callback(args...))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+private:
+    struct Entry
+    {
+        int priority;
+        T callback;
+    };
+
+    std::vector<Entry> m_callbacks;
+};
+
+/*
+ * Filters composed at compile time.
+ *
+ * Each filter is a class with call operators taking the record tag as first
+ * argument followed by the record arguments, e.g.
+ *
+ *     bool operator()(record::EventEnter, OTF2_LocationRef location,
+ *                     OTF2_TimeStamp time, OTF2_AttributeList *attributes,
+ *                     OTF2_RegionRef region);
+ *
+ * Filters are evaluated in the order of the template parameters. As with
+ * Filter<T>, the first filter returning true drops the record and the
+ * following filters do not see it. Calls are resolved at compile time,
+ * records without any operator do not touch a filter at all.
+ */
+template<typename...Filters>
+class StaticFilter
+{
+public:
+    explicit StaticFilter(Filters...filters)
+    :m_filters(std::forward<Filters>(filters)...)
+    {}
+
+    template<typename Record, typename...ArgTypes>
+    static constexpr bool handles = (std::is_invocable_r_v<bool, Filters &, Record, ArgTypes...> || ...);
+
+    template<typename Record, typename...ArgTypes>
+    inline bool process(Record record, ArgTypes...args)
+    {
+        if constexpr(handles<Record, ArgTypes...>)
+        {
+            return std::apply([&](auto &...filters)
+                              {
+                                  return (invoke(filters, record, args...) || ...);
+                              },
+                              m_filters);
+        }
+        else
         {
-            b |= f(args...);
+            return false;
         }
-        return b;
     }
+
+    /*
+     * Intersection of the windows of the filters with a time_window()
+     * member, see IFilterCallbacks::time_window().
+     */
+    TimeWindow time_window() const
+    {
+        TimeWindow window;
+        std::apply([&](const auto &...filters)
+                   {
+                       (restrict_window(window, filters), ...);
+                   },
+                   m_filters);
+        return window;
+    }
+
 private:
-    std::vector<T> m_callbacks;
+    template<typename F>
+    static inline void restrict_window(TimeWindow & window, const F & filter)
+    {
+        if constexpr(HasTimeWindow<F>::value)
+        {
+            TimeWindow filter_window = filter.time_window();
+            window.begin = std::max(window.begin, filter_window.begin);
+            window.end = std::min(window.end, filter_window.end);
+        }
+    }
+
+    template<typename F, typename = void>
+    struct HasTimeWindow: std::false_type
+    {};
+
+    template<typename F>
+    struct HasTimeWindow<F, std::void_t<decltype(std::declval<const F &>().time_window())>>: std::true_type
+    {};
+
+    template<typename F, typename Record, typename...ArgTypes>
+    static inline bool invoke(F & filter, Record record, ArgTypes...args)
+    {
+        if constexpr(std::is_invocable_r_v<bool, F &, Record, ArgTypes...>)
+        {
+            return filter(record, args...);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    std::tuple<Filters...> m_filters;
 };
+
+/*
+ * Whether a StaticFilter handles a record passed with the arguments of the
+ * given FilterCallback type.
+ */
+template<typename Filter, typename Record, typename Callback>
+struct StaticFilterHandles;
+
+template<typename Filter, typename Record, typename...ArgTypes>
+struct StaticFilterHandles<Filter, Record, FilterCallback<ArgTypes...>>
+: std::bool_constant<Filter::template handles<Record, ArgTypes...>>
+{};
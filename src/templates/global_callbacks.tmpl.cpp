@@ -14,11 +14,35 @@ namespace definition
         {
             return OTF2_CALLBACK_INTERRUPT;
         }
-        tr->m_locations.push_back(self);
+        tr->m_locations.push_back({self, numberOfEvents});
         @otf2 endif
         tr->handler().handleGlobal@@def.name@@(@@def.callargs(leading_comma=False)@@);
         return OTF2_CALLBACK_SUCCESS;
     }
 
+    @otf2 endfor
+}
+
+namespace string_reference
+{
+    static inline void
+    reference(void* userData, GlobalDefinition definition, OTF2_StringRef string)
+    {
+        static_cast<Otf2Handler *>(userData)->handleStringReference(definition, string);
+    }
+
+    @otf2 for def in defs|global_defs:
+
+    OTF2_CallbackCode
+    Global@@def.name@@Cb( void* userData @@def.funcargs()@@ )
+    {
+        @otf2 for attr in def.attributes:
+        @otf2  if str(attr.type) == "OTF2_StringRef":
+        reference(userData, GlobalDefinition::@@def.name@@, @@attr.name@@);
+        @otf2  endif
+        @otf2 endfor
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     @otf2 endfor
 }
\ No newline at end of file
@@ -16,4 +16,18 @@ namespace definition
     @otf2 endfor
 }
 
+/*
+ * Callbacks of the pass collecting string references, userData is the
+ * Otf2Handler.
+ */
+namespace string_reference
+{
+    @otf2 for def in defs|global_defs:
+
+    OTF2_CallbackCode
+    Global@@def.name@@Cb( void* userData @@def.funcargs()@@ );
+
+    @otf2 endfor
+}
+
 #endif /* GLOBAL_CALLBACKS_HPP */
\ No newline at end of file
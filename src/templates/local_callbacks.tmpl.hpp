@@ -1,21 +1,105 @@
 #ifndef EVENT_CALLBACKS_HPP
 #define EVENT_CALLBACKS_HPP
 
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 extern "C"
 {
     #include <otf2/otf2.h>
 }
 
+#include <otf2_handler.hpp>
+
+template <typename Handler>
+class LocalReader;
+
+template <typename Handler>
+using ReaderLocationPair = std::pair<LocalReader<Handler> &, size_t>;
+
+/*
+ * The callbacks of a LocalReader<Handler> call the overrides of Handler
+ * directly. They are inlined where the overrides are defined in a header,
+ * as by TraceWriter and StaticTraceWriter. The dynamic type of the handler
+ * has to be Handler then. Only calls to an Otf2Handler are dispatched
+ * virtually.
+ */
+template <typename Handler>
+inline constexpr bool dispatch_virtually = std::is_same_v<Handler, Otf2Handler>;
+
+template <typename Handler>
+inline bool
+reads_past_end(Handler & handler, OTF2_LocationRef location)
+{
+    if constexpr (dispatch_virtually<Handler>)
+    {
+        return handler.readsPastEnd(location);
+    }
+    else
+    {
+        return handler.Handler::readsPastEnd(location);
+    }
+}
+
 namespace event
 {
     @otf2 for event in events:
 
+    template <typename Handler>
     OTF2_CallbackCode
     Local@@event.name@@Cb(OTF2_LocationRef    location,
-                     OTF2_TimeStamp      time,
-                     uint64_t            eventPosition,
-                     void*               userData,
-                     OTF2_AttributeList* attributes@@event.funcargs()@@);
+                          OTF2_TimeStamp      time,
+                          uint64_t            eventPosition,
+                          void*               userData,
+                          OTF2_AttributeList* attributes@@event.funcargs()@@)
+    {
+        auto * tr = static_cast<LocalReader<Handler> *>(userData);
+        assert(tr != nullptr);
+        if(time > tr->events_end() && ! reads_past_end(tr->handler(), location))
+        {
+            return OTF2_CALLBACK_INTERRUPT;
+        }
+        if(eventPosition >= tr->next_sample())
+        {
+            tr->sample(time, eventPosition);
+        }
+        @otf2 if event.name == 'Enter':
+        tr->open_event({EventType::Enter, time, region});
+        @otf2 endif
+        @otf2 if event.name == 'Leave':
+        tr->close_event(EventType::Enter);
+        @otf2 endif
+        @otf2 if event.name == 'MpiCollectiveBegin':
+        tr->open_event({EventType::MpiCollectiveBegin, time});
+        @otf2 endif
+        @otf2 if event.name == 'MpiCollectiveEnd':
+        tr->close_event(EventType::MpiCollectiveBegin);
+        @otf2 endif
+        @otf2 if event.name == 'IoOperationBegin':
+        tr->open_event({EventType::IoOperationBegin, time, OTF2_UNDEFINED_REGION,
+                        handle, mode, operationFlags, bytesRequest, matchingId});
+        @otf2 endif
+        @otf2 if event.name in ['IoOperationComplete', 'IoOperationCancelled']:
+        tr->close_event(EventType::IoOperationBegin, handle, matchingId);
+        @otf2 endif
+
+        if constexpr (dispatch_virtually<Handler>)
+        {
+            tr->handler().handle@@event.name@@Event(location,
+                                                    time,
+                                                    attributes@@event.callargs()@@);
+        }
+        else
+        {
+            tr->handler().Handler::handle@@event.name@@Event(location,
+                                                             time,
+                                                             attributes@@event.callargs()@@);
+        }
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     @otf2 endfor
 }
@@ -25,10 +109,25 @@ namespace definition
     @otf2 for def in defs|local_defs:
     @otf2 if "MappingTable" == def.name or "ClockOffset" == def.name:
 
+    template <typename Handler>
     OTF2_CallbackCode
-    Local@@def.name@@Cb(void* userData @@def.funcargs()@@);
+    Local@@def.name@@Cb(void* userData @@def.funcargs()@@)
+    {
+        auto * tr = static_cast<ReaderLocationPair<Handler> *>(userData);
+        size_t self_location = tr->second;
+
+        if constexpr (dispatch_virtually<Handler>)
+        {
+            tr->first.handler().handleLocal@@def.name@@(self_location@@def.callargs()@@);
+        }
+        else
+        {
+            tr->first.handler().Handler::handleLocal@@def.name@@(self_location@@def.callargs()@@);
+        }
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     @otf2 endif
     @otf2 endfor
 }
-#endif /* EVENT_CALLBACKS_HPP */
\ No newline at end of file
+#endif /* EVENT_CALLBACKS_HPP */
@@ -0,0 +1,315 @@
+#ifndef LOCAL_READER_H
+#define LOCAL_READER_H
+
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <local_callbacks.hpp>
+#include <location_queue.hpp>
+#include <otf2_handler.hpp>
+#include <position_index.hpp>
+#include <trace_stats.hpp>
+
+extern "C"
+{
+    #include <otf2/otf2.h>
+}
+
+/*
+ * Reads the events and local definitions of locations and passes them to a
+ * handler.
+ *
+ * The decoding callbacks are instantiated for the handler type, the calls
+ * of a concrete Handler are bound at compile time. The handler has to be
+ * of exactly that type, see TraceReader. LocalReader<Otf2Handler> accepts
+ * any handler and dispatches virtually.
+ */
+template <typename Handler>
+class LocalReader
+{
+  public:
+    /*
+     * @param stats statistics the time spent reading is added to, may be
+     *        nullptr
+     * @param positions index the locations are sought in before reading
+     *        them, may be nullptr
+     * @param position_recorder receives samples of the positions of the
+     *        events read, may be nullptr
+     */
+    LocalReader(Handler & handler,
+                TraceStats * stats = nullptr,
+                const PositionIndex * positions = nullptr,
+                PositionIndexRecorder * position_recorder = nullptr)
+    :m_handler(handler), m_stats(stats), m_positions(positions), m_position_recorder(position_recorder)
+    {
+    }
+
+    /*
+     * Read events and local definitions of the locations taken from the queue
+     * until no location is left.
+     */
+    void
+    operator()(OTF2_Reader *reader, LocationQueue &queue, size_t worker);
+
+    size_t
+    current_location()
+    {
+        return m_current_location;
+    }
+
+    Handler &
+    handler()
+    {
+        return m_handler;
+    }
+
+    /*
+     * Events after this time interrupt reading their location, see
+     * Otf2Handler::eventsEnd() and Otf2Handler::readsPastEnd().
+     */
+    inline OTF2_TimeStamp
+    events_end() const
+    {
+        return m_events_end;
+    }
+
+    /*
+     * Position of the next event sampled for the PositionIndexRecorder,
+     * never reached without one.
+     */
+    inline uint64_t
+    next_sample() const
+    {
+        return m_next_sample;
+    }
+
+    inline void
+    sample(OTF2_TimeStamp time, uint64_t position)
+    {
+        m_samples.push_back({time, position, m_open});
+        m_next_sample = position + m_position_recorder->interval();
+    }
+
+    /*
+     * Track the events open at the next sample, only while recording.
+     */
+    inline void
+    open_event(const OpenEvent & event)
+    {
+        if(m_position_recorder != nullptr)
+        {
+            m_open.push_back(event);
+        }
+    }
+
+    inline void
+    close_event(EventType opening_type,
+                OTF2_IoHandleRef handle = OTF2_UNDEFINED_IO_HANDLE,
+                uint64_t matching_id = 0)
+    {
+        if(m_position_recorder != nullptr)
+        {
+            auto open = find_open(m_open, opening_type, handle, matching_id);
+            if(open != m_open.end())
+            {
+                m_open.erase(open);
+            }
+        }
+    }
+
+  private:
+    inline std::vector<size_t>
+    read_events(OTF2_Reader *reader, LocationQueue &queue, size_t worker);
+
+    inline void
+    read_definitions(OTF2_Reader *reader, const std::vector<size_t> &locations);
+
+    /*
+     * Pass the events open at the sought sample to the handler, as if they
+     * were read.
+     */
+    inline void
+    replay_open(OTF2_LocationRef location, const PositionSample & sample);
+
+    Handler &      m_handler;
+    TraceStats *   m_stats;
+    const PositionIndex * m_positions;
+    PositionIndexRecorder * m_position_recorder;
+    size_t         m_current_location;
+    OTF2_TimeStamp m_events_begin = 0;
+    OTF2_TimeStamp m_events_end = OTF2_UNDEFINED_TIMESTAMP;
+
+    /*
+     * Samples of the location being read.
+     */
+    std::vector<PositionSample> m_samples;
+    uint64_t m_next_sample = std::numeric_limits<uint64_t>::max();
+    std::vector<OpenEvent> m_open;
+};
+
+template <typename Handler>
+void
+LocalReader<Handler>::replay_open(OTF2_LocationRef location, const PositionSample & sample)
+{
+    for(const auto & event : sample.open)
+    {
+        open_event(event);
+        if(! m_handler.handlesEvent(event.type))
+        {
+            continue;
+        }
+        switch(event.type)
+        {
+            case EventType::Enter:
+                m_handler.handleEnterEvent(location, event.time, nullptr, event.region);
+                break;
+            case EventType::MpiCollectiveBegin:
+                m_handler.handleMpiCollectiveBeginEvent(location, event.time, nullptr);
+                break;
+            case EventType::IoOperationBegin:
+                m_handler.handleIoOperationBeginEvent(location, event.time, nullptr, event.handle, event.mode,
+                                                      event.flags, event.bytes_request, event.matching_id);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+template <typename Handler>
+void
+LocalReader<Handler>::read_definitions(OTF2_Reader* reader, const std::vector<size_t> & locations)
+{
+    bool successful_open_def_files = OTF2_Reader_OpenDefFiles( reader ) == OTF2_SUCCESS;
+
+    OTF2_DefReaderCallbacks* def_callbacks = OTF2_DefReaderCallbacks_New();
+
+    @otf2 for def in defs|local_defs:
+    @otf2 if "MappingTable" == def.name or "ClockOffset" == def.name:
+
+    OTF2_DefReaderCallbacks_Set@@def.name@@Callback(def_callbacks, definition::Local@@def.name@@Cb<Handler>);
+
+    @otf2 endif
+    @otf2 endfor
+
+    for (auto location: locations)
+    {
+        if ( successful_open_def_files )
+        {
+            OTF2_DefReader* def_reader = OTF2_Reader_GetDefReader( reader, location );
+
+            ReaderLocationPair<Handler> reader_location{*this, location};
+            OTF2_Reader_RegisterDefCallbacks(reader, def_reader, def_callbacks, &reader_location);
+            if ( def_reader )
+            {
+                uint64_t def_reads = 0;
+                // FIXME Assume to save state is not good
+                // but put all in a pair pointer is also not great
+                m_current_location = location;
+                OTF2_Reader_ReadAllLocalDefinitions( reader,
+                                                    def_reader,
+                                                    &def_reads );
+                OTF2_Reader_CloseDefReader( reader, def_reader );
+            }
+        }
+        m_handler.endLocalDefinitions(location);
+        [[maybe_unused]]
+        OTF2_EvtReader* evt_reader = OTF2_Reader_GetEvtReader( reader, location );
+    }
+    if ( successful_open_def_files )
+    {
+        OTF2_Reader_CloseDefFiles( reader );
+    }
+}
+
+template <typename Handler>
+std::vector<size_t>
+LocalReader<Handler>::read_events(OTF2_Reader* reader, LocationQueue & queue, size_t worker)
+{
+    std::vector<size_t> locations;
+
+    OTF2_Reader_OpenEvtFiles( reader );
+    m_events_begin = m_handler.eventsBegin();
+    m_events_end = m_handler.eventsEnd();
+
+    OTF2_EvtReaderCallbacks* evt_callbacks = OTF2_EvtReaderCallbacks_New();
+
+    @otf2 for event in events:
+
+    if(m_handler.handlesEvent(EventType::@@event.name@@))
+    {
+        OTF2_EvtReaderCallbacks_Set@@event.name@@Callback(evt_callbacks,
+                                                          event::Local@@event.name@@Cb<Handler>);
+    }
+
+    @otf2 endfor
+
+    OTF2_LocationRef location;
+    while (queue.pop(worker, location))
+    {
+        locations.push_back(location);
+
+        OTF2_EvtReader *  evt_reader = OTF2_Reader_GetEvtReader( reader, location);
+        OTF2_Reader_RegisterEvtCallbacks(reader,
+                                            evt_reader,
+                                            evt_callbacks,
+                                            this);
+        if(evt_reader)
+        {
+            m_handler.beginLocation(location);
+
+            if(m_position_recorder != nullptr)
+            {
+                m_samples.clear();
+                m_open.clear();
+                m_next_sample = 0;
+            }
+            const PositionSample * sample = m_positions != nullptr ?
+                                            m_positions->seek_sample(location, m_events_begin) : nullptr;
+            if(sample != nullptr)
+            {
+                OTF2_EvtReader_Seek(evt_reader, sample->position);
+                replay_open(location, *sample);
+            }
+
+            uint64_t events_read;
+            OTF2_Reader_ReadAllLocalEvents(reader,
+                                            evt_reader,
+                                            &events_read);
+
+            if(m_position_recorder != nullptr)
+            {
+                m_position_recorder->add(location, std::move(m_samples));
+            }
+            m_handler.endLocation(location);
+
+            OTF2_Reader_CloseEvtReader(reader,
+                                        evt_reader);
+        }
+    }
+    OTF2_EvtReaderCallbacks_Delete( evt_callbacks );
+    OTF2_Reader_CloseEvtFiles( reader );
+
+    return locations;
+}
+
+template <typename Handler>
+void
+LocalReader<Handler>::operator() (OTF2_Reader* reader, LocationQueue & queue, size_t worker)
+{
+    std::vector<size_t> locations;
+    {
+        PhaseTimer timer(m_stats, Phase::Events);
+        locations = read_events(reader, queue, worker);
+    }
+
+    if ( ! locations.empty() )
+    {
+        PhaseTimer timer(m_stats, Phase::LocalDefinitions);
+        read_definitions(reader, locations);
+    }
+}
+
+#endif /* LOCAL_READER_H */
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <location_index.hpp>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char *index_header = "otf2_filter_io location index 1";
+
+fs::path
+event_file(const fs::path &trace, OTF2_LocationRef location)
+{
+    return fs::path(trace).replace_extension() / (std::to_string(location) + ".evt");
+}
+} // namespace
+
+fs::path
+LocationIndex::path_of(const fs::path &trace)
+{
+    return fs::path(trace).replace_extension(".index");
+}
+
+const char *
+LocationIndex::event_name(EventType type)
+{
+    return event_type_names[static_cast<std::size_t>(type)];
+}
+
+void
+LocationIndex::add(OTF2_LocationRef location, LocationUsage usage)
+{
+    m_locations[location] = std::move(usage);
+}
+
+const LocationUsage *
+LocationIndex::find(OTF2_LocationRef location) const
+{
+    auto search = m_locations.find(location);
+    return search != m_locations.end() ? &search->second : nullptr;
+}
+
+/*
+ * One line per location, followed by lines with its event counts, handles
+ * and files:
+ *
+ *     location <ref> <event file size>
+ *     events <event type> <count>
+ *     handles <ref>...
+ *     files <ref>...
+ */
+void
+LocationIndex::write(const fs::path &index) const
+{
+    std::ofstream out(index, std::ios::out | std::ios::trunc);
+    if(! out.is_open())
+    {
+        throw std::runtime_error("Could not write location index: " + index.string());
+    }
+    out << index_header << '\n';
+    for(const auto &location : m_locations)
+    {
+        const auto &usage = location.second;
+        out << "location " << location.first << ' ' << usage.event_file_size << '\n';
+        for(std::size_t type = 0; type < usage.event_counts.size(); type++)
+        {
+            if(usage.event_counts[type] != 0)
+            {
+                out << "events " << event_type_names[type] << ' ' << usage.event_counts[type] << '\n';
+            }
+        }
+        out << "handles";
+        for(auto handle : usage.io_handles)
+        {
+            out << ' ' << handle;
+        }
+        out << "\nfiles";
+        for(auto file : usage.io_files)
+        {
+            out << ' ' << file;
+        }
+        out << '\n';
+    }
+    if(! out)
+    {
+        throw std::runtime_error("Could not write location index: " + index.string());
+    }
+}
+
+LocationIndex
+LocationIndex::read(const fs::path &index, const fs::path &trace)
+{
+    std::ifstream in(index, std::ios::in);
+    std::string   line;
+    if(! in.is_open() || ! std::getline(in, line) || line != index_header)
+    {
+        throw std::runtime_error("Could not read location index: " + index.string());
+    }
+
+    std::unordered_map<std::string, std::size_t> event_types;
+    for(std::size_t type = 0; type < number_of_event_types; type++)
+    {
+        event_types[event_type_names[type]] = type;
+    }
+
+    LocationIndex     result;
+    OTF2_LocationRef  location = OTF2_UNDEFINED_LOCATION;
+    LocationUsage *   usage    = nullptr;
+    while(std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string        keyword;
+        fields >> keyword;
+        if(keyword == "location")
+        {
+            fields >> location;
+            usage = &result.m_locations[location];
+            fields >> usage->event_file_size;
+            usage->event_counts.assign(number_of_event_types, 0);
+        }
+        else if(usage != nullptr && keyword == "events")
+        {
+            std::string name;
+            uint64_t    count = 0;
+            fields >> name >> count;
+            auto type = event_types.find(name);
+            if(type != event_types.end())
+            {
+                usage->event_counts[type->second] = count;
+            }
+        }
+        else if(usage != nullptr && keyword == "handles")
+        {
+            usage->io_handles.assign(std::istream_iterator<uint64_t>(fields), std::istream_iterator<uint64_t>());
+        }
+        else if(usage != nullptr && keyword == "files")
+        {
+            usage->io_files.assign(std::istream_iterator<uint64_t>(fields), std::istream_iterator<uint64_t>());
+        }
+        else
+        {
+            throw std::runtime_error("Invalid location index: " + index.string());
+        }
+        if(fields.fail() && !fields.eof())
+        {
+            throw std::runtime_error("Invalid location index: " + index.string());
+        }
+    }
+
+    for(auto it = result.m_locations.begin(); it != result.m_locations.end();)
+    {
+        std::error_code ec;
+        auto            size = fs::file_size(event_file(trace, it->first), ec);
+        if(ec || size != it->second.event_file_size)
+        {
+            it = result.m_locations.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return result;
+}
+
+LocationIndexRecorder::LocationIndexRecorder(const fs::path &trace) : m_trace(trace)
+{
+}
+
+LocationIndex
+LocationIndexRecorder::index() const
+{
+    LocationIndex result;
+    for(const auto &location : m_usage)
+    {
+        LocationUsage usage;
+        std::error_code ec;
+        usage.event_file_size = fs::file_size(event_file(m_trace, location.first), ec);
+        usage.event_counts    = location.second->event_counts;
+        usage.io_handles.assign(location.second->io_handles.begin(), location.second->io_handles.end());
+        usage.io_files.assign(location.second->io_files.begin(), location.second->io_files.end());
+        std::sort(usage.io_handles.begin(), usage.io_handles.end());
+        std::sort(usage.io_files.begin(), usage.io_files.end());
+        result.add(location.first, std::move(usage));
+    }
+    return result;
+}
+
+IFilterCallbacks::Callbacks
+LocationIndexRecorder::get_callbacks()
+{
+    Callbacks c;
+
+    c.global_location_callback = [this](OTF2_LocationRef      self,
+                                        OTF2_StringRef        name,
+                                        OTF2_LocationType     locationType,
+                                        uint64_t              numberOfEvents,
+                                        OTF2_LocationGroupRef locationGroup) {
+        auto &usage = m_usage[self];
+        if(! usage)
+        {
+            usage = std::make_unique<Usage>();
+            usage->event_counts.assign(number_of_event_types, 0);
+        }
+        return false;
+    };
+
+    @otf2 for evt in events:
+    c.event_@@evt.lower@@_callback = [this](OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList* attributes@@evt.funcargs()@@)
+    {
+    @otf2  if evt.name == "IoDuplicateHandle":
+        record(location, EventType::@@evt.name@@, oldHandle);
+        record_handle(location, newHandle);
+    @otf2  endif
+    @otf2  if evt.name == "IoDeleteFile":
+        record_file(location, EventType::@@evt.name@@, file);
+    @otf2  endif
+    @otf2  if evt.lower.startswith("io_") and evt.name != "IoDuplicateHandle" and evt.name != "IoDeleteFile":
+        record(location, EventType::@@evt.name@@, handle);
+    @otf2  endif
+    @otf2  if not evt.lower.startswith("io_"):
+        record(location, EventType::@@evt.name@@);
+    @otf2  endif
+        return false;
+    };
+    @otf2 endfor
+
+    return c;
+}
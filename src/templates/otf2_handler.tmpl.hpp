@@ -1,11 +1,86 @@
 #ifndef OTF2_HANDLER_H
 #define OTF2_HANDLER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
 extern "C"
 {
     #include <otf2/otf2.h>
 }
 
+enum class GlobalDefinition
+{
+    @otf2 for def in defs|global_defs:
+    @@def.name@@,
+    @otf2 endfor
+};
+
+/*
+ * Names of the global definition types, indexed by GlobalDefinition.
+ */
+inline constexpr const char* global_definition_names[] = {
+    @otf2 for def in defs|global_defs:
+    "@@def.name@@",
+    @otf2 endfor
+};
+
+inline constexpr std::size_t number_of_global_definitions = std::size(global_definition_names);
+
+/*
+ * Event record types, in the order of the OTF2 event callbacks.
+ */
+enum class EventType
+{
+    @otf2 for event in events:
+    @@event.name@@,
+    @otf2 endfor
+};
+
+/*
+ * Names of the event record types, indexed by EventType.
+ */
+inline constexpr const char* event_type_names[] = {
+    @otf2 for event in events:
+    "@@event.name@@",
+    @otf2 endfor
+};
+
+inline constexpr std::size_t number_of_event_types = std::size(event_type_names);
+
+/*
+ * Storage of the archive the events are read from.
+ */
+struct ArchiveLayout
+{
+    /*
+     * Folder holding the event and local definition files, which are
+     * named after the location, e.g. 0.evt and 0.def.
+     */
+    std::string      directory;
+    uint64_t         event_chunk_size;
+    uint64_t         definition_chunk_size;
+    OTF2_Compression compression;
+};
+
+/*
+ * Range of timestamps, both bounds are included.
+ */
+struct TimeWindow
+{
+    OTF2_TimeStamp begin = 0;
+    OTF2_TimeStamp end   = OTF2_UNDEFINED_TIMESTAMP;
+
+    inline bool
+    contains(OTF2_TimeStamp time) const
+    {
+        return begin <= time && time <= end;
+    }
+};
+
 class Otf2Handler{
 public:
 
@@ -43,6 +118,126 @@ public:
                               OTF2_AttributeList* attributes@@event.funcargs()@@) = 0;
 
     @otf2 endfor
+
+    /*
+     * Enclose the events of a location. Both are called by the worker
+     * reading the location, which is the only one handling its events
+     * until endLocation() returns.
+     */
+    virtual void
+    beginLocation(OTF2_LocationRef location)
+    {}
+
+    virtual void
+    endLocation(OTF2_LocationRef location)
+    {}
+
+    /*
+     * Called by the worker reading the local definitions of a location
+     * after they were handled.
+     */
+    virtual void
+    endLocalDefinitions(OTF2_LocationRef location)
+    {}
+
+    /*
+     * Global definition types whose string references have to be known
+     * before the global definitions are handled. If the list is not empty,
+     * the reader passes these references to handleStringReference() in an
+     * extra pass over the global definitions.
+     */
+    virtual std::vector<GlobalDefinition>
+    stringReferencingDefinitions()
+    {
+        return {};
+    }
+
+    virtual void
+    handleStringReference(GlobalDefinition definition, OTF2_StringRef string)
+    {}
+
+    /*
+     * Whether events can only be handled after all global definitions of
+     * the given type were handled. In pipelined reading, the reader handles
+     * these definitions first and the others while the events are read.
+     * Locations are always handled first.
+     */
+    virtual bool
+    eventsDependOn(GlobalDefinition definition)
+    {
+        return true;
+    }
+
+    /*
+     * Whether events of the type are handled at all. The reader only
+     * registers callbacks for handled event types, other events are
+     * skipped while decoding.
+     */
+    virtual bool
+    handlesEvent(EventType type)
+    {
+        return true;
+    }
+
+    /*
+     * Events before this time are not needed. A reader with a PositionIndex
+     * starts reading a location at the last sampled event before it, some
+     * earlier events may still be passed.
+     */
+    virtual OTF2_TimeStamp
+    eventsBegin()
+    {
+        return 0;
+    }
+
+    /*
+     * Events after this time are not needed. The reader stops reading a
+     * location at its first later event, the events of a location are
+     * ordered by time.
+     */
+    virtual OTF2_TimeStamp
+    eventsEnd()
+    {
+        return OTF2_UNDEFINED_TIMESTAMP;
+    }
+
+    /*
+     * Whether the reader keeps reading the location past eventsEnd(), asked
+     * for each later event, e.g. to read the end of an operation begun in
+     * the window.
+     */
+    virtual bool
+    readsPastEnd(OTF2_LocationRef location)
+    {
+        return false;
+    }
+
+    /*
+     * Whether the events and local definitions of a location are needed at
+     * all. Asked by the reader for every location once the global
+     * definitions the events depend on were handled, locations not
+     * selected are neither selected at the OTF2 reader nor opened.
+     */
+    virtual bool
+    selectsLocation(OTF2_LocationRef location)
+    {
+        return true;
+    }
+
+    /*
+     * Take over the event and local definition files of a location without
+     * handling its records. Asked by the reader for every location once the
+     * global definitions the events depend on were handled. The reader
+     * skips the locations taken over.
+     *
+     * @param input archive the location is read from
+     * @return true if the location was taken over
+     */
+    virtual bool
+    copyLocation(const ArchiveLayout &input, OTF2_LocationRef location)
+    {
+        return false;
+    }
 };
 
 #endif /* OTF2_HANDLER_H */
\ No newline at end of file
@@ -0,0 +1,135 @@
+#ifndef STATIC_TRACE_WRITER_H
+#define STATIC_TRACE_WRITER_H
+
+#include <string>
+#include <utility>
+
+#include <filter.hpp>
+#include <trace_writer.hpp>
+
+/*
+ * Trace writer with a filter chain composed at compile time.
+ *
+ * The filters are passed as template parameters, see StaticFilter for the
+ * interface a filter has to provide. Filters can be held by value or, by
+ * passing a reference type, refer to an object owned by the caller.
+ * Records no filter is interested in are written directly.
+ *
+ * Filters registered at runtime are not supported, use TraceWriter for
+ * these. As with registered filters, definitions of dropped locations are
+ * left out and the clock properties shrunk to the time window of the
+ * filters with a time_window() member, see StaticFilter::time_window().
+ */
+template<typename...Filters>
+class StaticTraceWriter: public TraceWriter
+{
+  public:
+    /*
+     * @param path specify the folder of trace to be written
+     * @param filters filters applied to every record in the given order
+     */
+    StaticTraceWriter(const std::string &path, Filters...filters)
+    :TraceWriter(path), m_filters(std::forward<Filters>(filters)...)
+    {
+        restrict_time_window(m_filters.time_window());
+    }
+
+    /*
+     * @param options compression and chunk sizes of the archive
+     */
+    StaticTraceWriter(const std::string &path, const TraceWriterOptions &options, Filters...filters)
+    :TraceWriter(path, options), m_filters(std::forward<Filters>(filters)...)
+    {
+        restrict_time_window(m_filters.time_window());
+    }
+
+    void
+    register_filter(IFilterCallbacks & filter, int priority = 0) = delete;
+
+    /*
+     * Definitions handled by one of the filters are read before the events.
+     */
+    virtual bool
+    eventsDependOn(GlobalDefinition definition) override
+    {
+        switch(definition)
+        {
+        @otf2 for def in defs|global_defs:
+        case GlobalDefinition::@@def.name@@:
+            return TraceWriter::eventsDependOn(definition) ||
+                   filters_handle<record::Global@@def.name@@, Global@@def.name@@Filter>;
+        @otf2 endfor
+        }
+        return true;
+    }
+
+    /*
+     * Static filters cannot tell which locations they affect, locations are
+     * only copied if no filter handles events.
+     */
+    virtual bool
+    filters_location(OTF2_LocationRef location) override
+    {
+        return filters_events || TraceWriter::filters_location(location);
+    }
+
+    /*
+     * Handle global definitions
+     */
+    @otf2 for def in defs|global_defs:
+
+    virtual void
+    handleGlobal@@def.name@@(@@def.funcargs(leading_comma=False)@@) override
+    {
+        @otf2  if def.name == 'String':
+        string_table().add(self, string);
+        @otf2 endif
+
+        if(! m_filters.process(record::Global@@def.name@@{}@@def.callargs()@@))
+        {
+            writeGlobal@@def.name@@(@@def.callargs(leading_comma=False)@@);
+        }
+        @otf2  if def.name == 'Location':
+        else
+        {
+            drop_location(self);
+        }
+        @otf2 endif
+    }
+
+    @otf2 endfor
+
+    /*
+     * Handle events.
+     */
+    @otf2 for event in events:
+
+    virtual void
+    handle@@event.name@@Event(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList* attributes@@event.funcargs()@@) override
+    {
+        bool filtered = m_filters.process(record::Event@@event.name@@{}, location, time, attributes@@event.callargs()@@);
+        count_event(EventType::@@event.name@@, filtered);
+        if(! filtered)
+        {
+            write@@event.name@@Event(location, time, attributes@@event.callargs()@@);
+        }
+    }
+
+    @otf2 endfor
+
+  private:
+    template<typename Record, typename Callback>
+    static constexpr bool filters_handle = StaticFilterHandles<StaticFilter<Filters...>, Record, Callback>::value;
+
+    static constexpr bool filters_events =
+        @otf2 for event in events:
+        filters_handle<record::Event@@event.name@@, Event@@event.name@@Filter> ||
+        @otf2 endfor
+        false;
+
+    StaticFilter<Filters...> m_filters;
+};
+
+#endif /* STATIC_TRACE_WRITER_H */
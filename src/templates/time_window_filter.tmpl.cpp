@@ -0,0 +1,31 @@
+#include <time_window_filter.hpp>
+
+TimeWindowFilter::TimeWindowFilter(TimeWindow window)
+:m_window(window)
+{}
+
+TimeWindow
+TimeWindowFilter::time_window() const
+{
+    return m_window;
+}
+
+IFilterCallbacks::Callbacks
+TimeWindowFilter::get_callbacks()
+{
+    Callbacks c;
+
+    auto outside = [this](OTF2_LocationRef location,
+                          OTF2_TimeStamp time,
+                          OTF2_AttributeList* attributes,
+                          auto... args)
+    {
+        return ! m_window.contains(time);
+    };
+
+    @otf2 for evt in events:
+    c.event_@@evt.lower@@_callback = outside;
+    @otf2 endfor
+
+    return c;
+}
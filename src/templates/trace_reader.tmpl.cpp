@@ -1,21 +1,45 @@
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <iostream>
+#include <utility>
 
-#include <local_reader.hpp>
+#include <location_scheduler.hpp>
+#include <otf2_locking.hpp>
 #include <trace_reader.hpp>
 
 TraceReader::TraceReader(const std::string &path,
                          Otf2Handler & handler,
-                         size_t nthreads)
-:m_handler(handler),
+                         size_t nthreads,
+                         const TraceReaderOptions & options)
+:TraceReader(path, handler, nthreads, options,
+             LocalReader<Otf2Handler>(handler, options.stats, options.positions, options.position_recorder))
+{
+}
+
+TraceReader::TraceReader(const std::string &path,
+                         Otf2Handler & handler,
+                         size_t nthreads,
+                         const TraceReaderOptions & options,
+                         local_reader_function local_reader)
+:m_path(path),
+m_handler(handler),
 m_reader(OTF2_Reader_Open(path.c_str()), OTF2_Reader_Close),
 m_location_count(0),
-m_thread_count(nthreads)
+m_thread_count(nthreads),
+m_options(options),
+m_local_reader(std::move(local_reader))
 {
     OTF2_Reader_SetSerialCollectiveCallbacks(m_reader.get());
+    set_locking_callbacks(m_reader.get());
     OTF2_Reader_GetNumberOfLocations(m_reader.get(), &m_location_count);
 
-    read_definitions();
+    auto string_references = m_handler.stringReferencingDefinitions();
+    if(! string_references.empty())
+    {
+        read_string_references(string_references);
+    }
+    read_definitions(m_options.pipelined ? DefinitionPass::EventDependencies : DefinitionPass::All);
 }
 // TODO name it process_events??
 void
@@ -23,31 +47,229 @@ TraceReader::read()
 {
     std::vector<std::thread> workers;
 
-    size_t locations_per_thread = m_locations.size() / m_thread_count;
-    size_t rest_locations = m_locations.size() - locations_per_thread * m_thread_count;
+    select_locations();
+    if(m_options.copy_locations)
+    {
+        copy_locations();
+    }
+    for(const auto & location: m_locations)
+    {
+        OTF2_Reader_SelectLocation(m_reader.get(), location.location);
+    }
 
-    std::vector<size_t> thread_location_count(m_thread_count, locations_per_thread);
-    for(int i = 0; rest_locations > 0; rest_locations--, i++)
+    std::thread definition_worker;
+    if(m_options.pipelined)
     {
-        thread_location_count[i % m_thread_count]++;
+        definition_worker = std::thread(&TraceReader::read_definitions, this, DefinitionPass::Remaining);
     }
 
-    auto src_begin = m_locations.begin();
-    for(size_t i = 0; i < thread_location_count.size(); i++)
+    size_t nworkers = m_thread_count;
+    if(m_options.max_open_locations != 0)
+    {
+        nworkers = std::min(nworkers, m_options.max_open_locations);
+    }
+    LocationSchedule schedule = schedule_locations(m_locations, nworkers);
+    schedule.erase(std::remove_if(schedule.begin(), schedule.end(),
+                                  [](const std::vector<OTF2_LocationRef> & assigned){ return assigned.empty(); }),
+                   schedule.end());
+    LocationQueue queue(schedule);
+    std::unique_ptr<Prefetcher> prefetcher = start_prefetcher(schedule);
+    if(prefetcher)
     {
-        auto thread_locations = std::vector<size_t>(src_begin, src_begin + thread_location_count[i]);
-        workers.emplace_back(LocalReader(m_handler), m_reader.get(), thread_locations);
-        src_begin += thread_location_count[i];
+        queue.set_observer([&prefetcher](OTF2_LocationRef){ prefetcher->advance(); });
+    }
+    for(size_t i = 0; i < queue.workers(); i++)
+    {
+        workers.emplace_back(&TraceReader::read_worker, this, std::ref(queue), std::cref(schedule[i]), i);
     }
     for(auto & w: workers)
     {
         w.join();
     }
+    if(definition_worker.joinable())
+    {
+        definition_worker.join();
+    }
+}
+
+/*
+ * A reader of its own selects the locations scheduled for the worker,
+ * stolen locations are selected when their event reader is created. It
+ * gets the locking callbacks like the shared reader, OTF2 does not
+ * promise a reader to be free of state shared between threads, and the
+ * locks are uncontended while only the worker uses it. If the archive cannot be opened again,
+ * the worker falls back to the shared reader, counted in the statistics.
+ *
+ * Every worker reads with a copy of the local reader, it holds the state
+ * of the location being read.
+ */
+void
+TraceReader::read_worker(LocationQueue & queue, const std::vector<OTF2_LocationRef> & assigned, size_t worker)
+{
+    local_reader_function local_reader = m_local_reader;
+    if(m_options.reader_per_worker)
+    {
+        reader_ptr reader(OTF2_Reader_Open(m_path.c_str()), OTF2_Reader_Close);
+        if(m_options.stats != nullptr)
+        {
+            m_options.stats->add_worker_reader(static_cast<bool>(reader));
+        }
+        if(reader)
+        {
+            OTF2_Reader_SetSerialCollectiveCallbacks(reader.get());
+            set_locking_callbacks(reader.get());
+            for(auto location: assigned)
+            {
+                OTF2_Reader_SelectLocation(reader.get(), location);
+            }
+            local_reader(reader.get(), queue, worker);
+            return;
+        }
+    }
+    local_reader(m_reader.get(), queue, worker);
+}
+
+/*
+ * Collects location definitions until all locations of the trace are known.
+ */
+struct LocationCollector
+{
+    std::vector<LocationWeight> locations;
+    uint64_t location_count;
+};
+
+static OTF2_CallbackCode
+collect_location(void * userData,
+                 OTF2_LocationRef self,
+                 OTF2_StringRef name,
+                 OTF2_LocationType locationType,
+                 uint64_t numberOfEvents,
+                 OTF2_LocationGroupRef locationGroup)
+{
+    auto collector = static_cast<LocationCollector *>(userData);
+    collector->locations.push_back({self, numberOfEvents});
+    if(collector->locations.size() == collector->location_count)
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+std::vector<LocationWeight>
+TraceReader::read_locations(const std::string &path)
+{
+    reader_ptr reader(OTF2_Reader_Open(path.c_str()), OTF2_Reader_Close);
+    if(! reader)
+    {
+        return {};
+    }
+    OTF2_Reader_SetSerialCollectiveCallbacks(reader.get());
+
+    LocationCollector collector{{}, 0};
+    OTF2_Reader_GetNumberOfLocations(reader.get(), &collector.location_count);
+
+    OTF2_GlobalDefReader * global_def_reader = OTF2_Reader_GetGlobalDefReader(reader.get());
+    OTF2_GlobalDefReaderCallbacks* def_callbacks = OTF2_GlobalDefReaderCallbacks_New();
+    OTF2_GlobalDefReaderCallbacks_SetLocationCallback(def_callbacks, collect_location);
+    OTF2_Reader_RegisterGlobalDefCallbacks(reader.get(),
+                                           global_def_reader,
+                                           def_callbacks,
+                                           &collector);
+    OTF2_GlobalDefReaderCallbacks_Delete(def_callbacks);
+
+    uint64_t definitions_read = 0;
+    OTF2_Reader_ReadAllGlobalDefinitions(reader.get(),
+                                         global_def_reader,
+                                         &definitions_read);
+
+    OTF2_Reader_CloseGlobalDefReader(reader.get(),
+                                     global_def_reader);
+    return collector.locations;
+}
+
+OTF2_FileSubstrate
+TraceReader::file_substrate()
+{
+    OTF2_FileSubstrate substrate = OTF2_SUBSTRATE_UNDEFINED;
+    OTF2_Reader_GetFileSubstrate(m_reader.get(), &substrate);
+    return substrate;
+}
+
+/*
+ * Event and definition files of an archive are stored in a folder named
+ * like the anchor file without its extension.
+ */
+std::string
+TraceReader::archive_directory() const
+{
+    return std::filesystem::path(m_path).replace_extension().string();
+}
+
+/*
+ * Locations the handler does not select are forgotten before any of them
+ * is selected at the reader, copied or scheduled.
+ */
+void
+TraceReader::select_locations()
+{
+    auto unselected = [this](const LocationWeight & location)
+                      { return ! m_handler.selectsLocation(location.location); };
+    m_locations.erase(std::remove_if(m_locations.begin(), m_locations.end(), unselected), m_locations.end());
+}
+
+void
+TraceReader::copy_locations()
+{
+    if(file_substrate() != OTF2_SUBSTRATE_POSIX)
+    {
+        return;
+    }
+
+    ArchiveLayout input;
+    input.directory = archive_directory();
+    OTF2_Reader_GetChunkSize(m_reader.get(), &input.event_chunk_size, &input.definition_chunk_size);
+    OTF2_Reader_GetCompression(m_reader.get(), &input.compression);
+
+    m_locations.erase(std::remove_if(m_locations.begin(), m_locations.end(),
+                                     [&](const LocationWeight & location){
+                                         return m_handler.copyLocation(input, location.location);
+                                     }),
+                      m_locations.end());
+}
+
+/*
+ * Only files of the POSIX substrate can be advised.
+ */
+std::unique_ptr<Prefetcher>
+TraceReader::start_prefetcher(const LocationSchedule & schedule)
+{
+    if(m_options.prefetch_distance == 0 || file_substrate() != OTF2_SUBSTRATE_POSIX)
+    {
+        return nullptr;
+    }
+    return std::make_unique<Prefetcher>(archive_directory(), schedule, m_options.prefetch_distance);
+}
+
+/*
+ * Locations are always read in the first pass, the workers are scheduled
+ * by them.
+ */
+bool
+TraceReader::select_definition(GlobalDefinition definition, DefinitionPass pass)
+{
+    if(pass == DefinitionPass::All)
+    {
+        return true;
+    }
+    bool dependency = definition == GlobalDefinition::Location || m_handler.eventsDependOn(definition);
+    return dependency == (pass == DefinitionPass::EventDependencies);
 }
 
 void
-TraceReader::read_definitions()
+TraceReader::read_definitions(DefinitionPass pass)
 {
+    PhaseTimer timer(m_options.stats, Phase::GlobalDefinitions);
+
     OTF2_GlobalDefReader * global_def_reader = OTF2_Reader_GetGlobalDefReader(m_reader.get());
 
     // TODO unique pointer
@@ -55,8 +277,11 @@ TraceReader::read_definitions()
 
     @otf2 for def in defs|global_defs:
 
-    OTF2_GlobalDefReaderCallbacks_Set@@def.name@@Callback(def_callbacks,
-                                                          definition::Global@@def.name@@Cb);
+    if(select_definition(GlobalDefinition::@@def.name@@, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_Set@@def.name@@Callback(def_callbacks,
+                                                              definition::Global@@def.name@@Cb);
+    }
 
     @otf2 endfor
 
@@ -67,6 +292,61 @@ TraceReader::read_definitions()
 
     OTF2_GlobalDefReaderCallbacks_Delete(def_callbacks);
 
+    uint64_t definitions_read = 0;
+    if(pass == DefinitionPass::Remaining && m_options.definition_chunk > 0)
+    {
+        /*
+         * Stream the definitions in chunks, the archive is shared with the
+         * event workers during this pass.
+         */
+        do
+        {
+            OTF2_Reader_ReadGlobalDefinitions(m_reader.get(),
+                                              global_def_reader,
+                                              m_options.definition_chunk,
+                                              &definitions_read);
+        } while(definitions_read == m_options.definition_chunk);
+    }
+    else
+    {
+        OTF2_Reader_ReadAllGlobalDefinitions(m_reader.get(),
+                                             global_def_reader,
+                                             &definitions_read);
+    }
+
+    OTF2_Reader_CloseGlobalDefReader(m_reader.get(),
+                                     global_def_reader);
+}
+
+void
+TraceReader::read_string_references(const std::vector<GlobalDefinition> & definitions)
+{
+    PhaseTimer timer(m_options.stats, Phase::StringReferences);
+
+    OTF2_GlobalDefReader * global_def_reader = OTF2_Reader_GetGlobalDefReader(m_reader.get());
+
+    OTF2_GlobalDefReaderCallbacks* def_callbacks = OTF2_GlobalDefReaderCallbacks_New();
+
+    for(auto definition: definitions)
+    {
+        switch(definition)
+        {
+        @otf2 for def in defs|global_defs:
+        case GlobalDefinition::@@def.name@@:
+            OTF2_GlobalDefReaderCallbacks_Set@@def.name@@Callback(def_callbacks,
+                                                                  string_reference::Global@@def.name@@Cb);
+            break;
+        @otf2 endfor
+        }
+    }
+
+    OTF2_Reader_RegisterGlobalDefCallbacks(m_reader.get(),
+                                           global_def_reader,
+                                           def_callbacks,
+                                           &m_handler);
+
+    OTF2_GlobalDefReaderCallbacks_Delete(def_callbacks);
+
     uint64_t definitions_read = 0;
     OTF2_Reader_ReadAllGlobalDefinitions(m_reader.get(),
                                          global_def_reader,
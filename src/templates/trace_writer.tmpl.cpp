@@ -1,6 +1,21 @@
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <file_copy.hpp>
+#include <otf2_locking.hpp>
 #include <trace_writer.hpp>
 
+namespace fs = std::filesystem;
+
+/*
+ * Rough size of an encoded event including its timestamp.
+ */
+constexpr uint64_t estimated_event_size = 16;
+
 OTF2_FlushType pre_flush(void *userData, OTF2_FileType fileType,
                          OTF2_LocationRef location, void *callerData,
                          bool final) {
@@ -10,6 +25,11 @@ OTF2_FlushType pre_flush(void *userData, OTF2_FileType fileType,
 OTF2_FlushCallbacks TraceWriter::m_flush_callbacks = {
     .otf2_pre_flush = pre_flush, .otf2_post_flush = nullptr};
 
+thread_local TraceWriter::LocationEventWriter TraceWriter::m_thread_event_writer = {
+    .owner = nullptr, .location = OTF2_UNDEFINED_LOCATION, .writer = nullptr, .counters = nullptr};
+
+thread_local TraceWriter::LocationWindow TraceWriter::m_thread_window;
+
 void delete_event_writer(OTF2_EvtWriter *writer, OTF2_Archive *archive) {
     if (nullptr != archive && nullptr != writer) {
         OTF2_Archive_CloseEvtWriter(archive, writer);
@@ -22,15 +42,68 @@ void delete_archive(OTF2_Archive *archive) {
     }
 }
 
-TraceWriter::TraceWriter(const std::string &path)
-    : m_archive(nullptr, delete_archive)
+uint64_t event_chunk_size(const std::vector<LocationWeight> &locations) {
+    uint64_t events = 0;
+    for(const auto & location: locations)
+    {
+        events += location.number_of_events;
+    }
+    if(locations.empty())
+    {
+        return TraceWriterOptions().event_chunk_size;
+    }
+
+    uint64_t bytes = events / locations.size() * estimated_event_size;
+    uint64_t chunk_size = min_chunk_size;
+    while(chunk_size < bytes && chunk_size < max_chunk_size)
+    {
+        chunk_size *= 2;
+    }
+    return chunk_size;
+}
+
+std::size_t open_location_limit(const TraceWriterOptions &options) {
+    if(options.memory_limit == 0)
+    {
+        return 0;
+    }
+    /* the global definition writer holds a definition chunk as well */
+    uint64_t budget = options.memory_limit - std::min(options.memory_limit, options.definition_chunk_size);
+    return std::max<uint64_t>(1, budget / (options.event_chunk_size + options.definition_chunk_size));
+}
+
+TraceWriter::TraceWriter(const std::string &path, const TraceWriterOptions &options)
+    : m_archive(nullptr, delete_archive), m_options(options), m_directory(path + "/" + traceName())
 {
     auto *archive =
         OTF2_Archive_Open(path.c_str(), traceName(), OTF2_FILEMODE_WRITE,
-                          1024 * 1024 /* event chunk size */,
-                          4 * 1024 * 1024 /* def chunk size */,
-                          OTF2_SUBSTRATE_POSIX, OTF2_COMPRESSION_NONE);
+                          options.event_chunk_size,
+                          options.definition_chunk_size,
+                          OTF2_SUBSTRATE_POSIX, options.compression);
+    if(archive == nullptr)
+    {
+        throw std::runtime_error("Could not create archive: " + path);
+    }
+    if(options.referenced_strings)
+    {
+        m_strings.set_mode(StringTable::Mode::Referenced);
+    }
+    if(options.memory_limit != 0)
+    {
+        /* buffers grow until the limit is reached */
+        m_memory_limited = true;
+        m_chunk_pool = std::make_unique<ChunkPool>(options.huge_pages,
+                                                   std::numeric_limits<std::size_t>::max(),
+                                                   options.memory_limit);
+        m_chunk_pool->install(archive);
+    }
+    else if(options.pool_chunks)
+    {
+        m_chunk_pool = std::make_unique<ChunkPool>(options.huge_pages);
+        m_chunk_pool->install(archive);
+    }
 
+    set_locking_callbacks(archive);
     OTF2_Archive_SetFlushCallbacks(archive, &m_flush_callbacks, nullptr);
     OTF2_Archive_SetSerialCollectiveCallbacks(archive);
     m_archive.reset(archive);
@@ -42,14 +115,22 @@ TraceWriter::TraceWriter(const std::string &path)
 }
 
 TraceWriter::~TraceWriter() {
+    PhaseTimer timer(m_options.stats, Phase::Close);
     OTF2_Archive_CloseDefFiles(m_archive.get());
-    for(auto location: m_locations)
+    for(const auto & location: m_location_ordinals)
     {
+        if(m_local_definitions_closed[location.second])
+        {
+            continue;
+        }
         OTF2_DefWriter* def_writer = OTF2_Archive_GetDefWriter( m_archive.get(),
-                                                                location );
+                                                                location.first );
         OTF2_Archive_CloseDefWriter( m_archive.get(), def_writer );
     }
     OTF2_Archive_CloseEvtFiles(m_archive.get());
+
+    /* closing the archive writes the remaining buffers */
+    m_archive.reset();
 }
 
 @otf2 for def in defs|global_defs:
@@ -57,15 +138,64 @@ TraceWriter::~TraceWriter() {
 void
 TraceWriter::handleGlobal@@def.name@@(@@def.funcargs(leading_comma=False)@@)
 {
+    @otf2  if def.name == 'String':
+    m_strings.add(self, string);
+    @otf2 endif
     @otf2  if def.name == 'Location':
-    m_locations.insert(self);
+
+    if(! m_global_Location_filter.empty() &&
+       m_global_Location_filter.process(@@def.callargs(leading_comma=False)@@))
+    {
+        drop_location(self);
+        return;
+    }
+    writeGlobalLocation(@@def.callargs(leading_comma=False)@@);
     @otf2 endif
+    @otf2  if def.name != 'Location':
 
-    bool filter_out = m_global_@@def.name@@_filter.process(@@def.callargs(leading_comma=False)@@);
-    if(! filter_out)
+    if(m_global_@@def.name@@_filter.empty() ||
+       ! m_global_@@def.name@@_filter.process(@@def.callargs(leading_comma=False)@@))
     {
-        OTF2_GlobalDefWriter_Write@@def.name@@(m_def_writer@@def.callargs()@@);
+        writeGlobal@@def.name@@(@@def.callargs(leading_comma=False)@@);
     }
+    @otf2 endif
+}
+
+void
+TraceWriter::writeGlobal@@def.name@@(@@def.funcargs(leading_comma=False)@@)
+{
+    @otf2  if def.name == 'ClockProperties':
+    uint64_t end = std::min(globalOffset + traceLength, m_time_window.end);
+    globalOffset = std::max(globalOffset, m_time_window.begin);
+    traceLength = end > globalOffset ? end - globalOffset : 0;
+    @otf2 endif
+    @otf2  if def.name == 'Location':
+    add_location(self);
+    @otf2 endif
+    @otf2  if def.name == 'Group':
+    std::vector<uint64_t> selected_members;
+    if(groupType == OTF2_GROUP_TYPE_LOCATIONS && ! m_dropped_locations.empty())
+    {
+        std::copy_if(members, members + numberOfMembers, std::back_inserter(selected_members),
+                     [this](uint64_t member){ return m_dropped_locations.count(member) == 0; });
+        numberOfMembers = selected_members.size();
+        members = selected_members.data();
+    }
+    @otf2 endif
+    @otf2  if def.name == 'MetricClassRecorder':
+    if(m_dropped_locations.count(recorder) != 0)
+    {
+        return;
+    }
+    @otf2 endif
+    @otf2  if def.name == 'MetricInstance':
+    if(m_dropped_locations.count(recorder) != 0 ||
+       (metricScope == OTF2_SCOPE_LOCATION && m_dropped_locations.count(scope) != 0))
+    {
+        return;
+    }
+    @otf2 endif
+    OTF2_GlobalDefWriter_Write@@def.name@@(m_def_writer@@def.callargs()@@);
 }
 
 @otf2 endfor
@@ -87,38 +217,407 @@ TraceWriter::handleLocal@@def.name@@(OTF2_LocationRef readLocation,
 @otf2 for event in events:
 
 void
-TraceWriter::handle@@event.name@@Event(OTF2_LocationRef    location,
-                                       OTF2_TimeStamp      time,
-                                       OTF2_AttributeList* attributes@@event.funcargs()@@)
+TraceWriter::write@@event.name@@Event(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList* attributes@@event.funcargs()@@)
 {
-    bool filter_out = m_event_@@event.name@@_filter.process(location, time, attributes@@event.callargs()@@);
-    if(! filter_out)
+    drop_attributes(attributes);
+    auto * event_writer = location_event_writer(location);
+    OTF2_EvtWriter_@@event.name@@(event_writer,
+                                attributes,
+                                time@@event.callargs()@@);
+    count_written(EventType::@@event.name@@);
+}
+
+@otf2 endfor
+
+void
+TraceWriter::remove_dropped_attributes(OTF2_AttributeList * attributes)
+{
+    uint32_t index = 0;
+    while(index < OTF2_AttributeList_GetNumberOfElements(attributes))
     {
-        auto * event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_@@event.name@@(event_writer,
-                                    attributes,
-                                    time@@event.callargs()@@);
+        OTF2_AttributeRef attribute;
+        OTF2_Type type;
+        OTF2_AttributeValue value;
+        OTF2_AttributeList_GetAttributeByIndex(attributes, index, &attribute, &type, &value);
+        if(m_dropped_attribute_types[type])
+        {
+            OTF2_AttributeList_RemoveAttribute(attributes, attribute);
+        }
+        else
+        {
+            index++;
+        }
     }
 }
 
-@otf2 endfor
+void
+TraceWriter::restrict_time_window(TimeWindow window)
+{
+    m_time_window.begin = std::max(m_time_window.begin, window.begin);
+    m_time_window.end = std::min(m_time_window.end, window.end);
+    m_balances_window = m_time_window.begin != 0 || m_time_window.end != OTF2_UNDEFINED_TIMESTAMP;
+}
+
+void
+TraceWriter::drop_location(OTF2_LocationRef location)
+{
+    m_dropped_locations.insert(location);
+}
+
+void
+TraceWriter::add_location(OTF2_LocationRef location)
+{
+    if(m_location_ordinals.count(location) > 0)
+    {
+        return;
+    }
+    m_location_ordinals.insert({location, m_event_writers.size()});
+    m_local_definitions_closed.push_back(false);
+    if(m_memory_limited)
+    {
+        m_event_writers.push_back(nullptr);
+        return;
+    }
+    m_event_writers.push_back(OTF2_Archive_GetEvtWriter(m_archive.get(), location));
+}
+
+void
+TraceWriter::beginLocation(OTF2_LocationRef location)
+{
+    auto search = m_location_ordinals.find(location);
+    if(m_memory_limited && search != m_location_ordinals.end())
+    {
+        m_event_writers[search->second] = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
+    }
+    m_thread_event_writer = {
+        .owner = this,
+        .location = location,
+        .writer = cached_event_writer(location),
+        .counters = m_options.stats != nullptr ? &m_options.stats->thread_stats().events : nullptr};
+    m_thread_window.owner = this;
+    m_thread_window.before = true;
+    m_thread_window.open.clear();
+}
+
+/*
+ * Regions entered before the end of the time window and not left in it are
+ * left at its end.
+ */
+void
+TraceWriter::endLocation(OTF2_LocationRef location)
+{
+    if(m_balances_window && m_thread_window.owner == this && m_time_window.end != OTF2_UNDEFINED_TIMESTAMP)
+    {
+        if(m_thread_window.before)
+        {
+            reopen_records(location, true);
+        }
+        const auto & open = m_thread_window.open;
+        for(auto record = open.rbegin(); record != open.rend(); ++record)
+        {
+            if(record->written && record->type == EventType::Enter)
+            {
+                writeLeaveEvent(location, m_time_window.end, nullptr, record->region);
+            }
+        }
+    }
+    m_thread_window.owner = nullptr;
+    m_thread_window.open.clear();
+
+    m_thread_event_writer = {
+        .owner = nullptr, .location = OTF2_UNDEFINED_LOCATION, .writer = nullptr, .counters = nullptr};
+
+    auto search = m_location_ordinals.find(location);
+    if(m_memory_limited && search != m_location_ordinals.end())
+    {
+        OTF2_Archive_CloseEvtWriter(m_archive.get(), m_event_writers[search->second]);
+        m_event_writers[search->second] = nullptr;
+    }
+}
+
+void
+TraceWriter::endLocalDefinitions(OTF2_LocationRef location)
+{
+    auto search = m_location_ordinals.find(location);
+    if(m_memory_limited && search != m_location_ordinals.end())
+    {
+        OTF2_DefWriter* def_writer = OTF2_Archive_GetDefWriter(m_archive.get(), location);
+        OTF2_Archive_CloseDefWriter(m_archive.get(), def_writer);
+        m_local_definitions_closed[search->second] = true;
+    }
+}
+
+/*
+ * Locations are copied while no worker reads events, the writer of the
+ * location is closed first, closing it later would overwrite the copy.
+ * OTF2 names compressed files differently, these are never copied.
+ */
+bool
+TraceWriter::copyLocation(const ArchiveLayout & input, OTF2_LocationRef location)
+{
+    auto search = m_location_ordinals.find(location);
+    if(search == m_location_ordinals.end()
+       || input.compression != OTF2_COMPRESSION_NONE
+       || m_options.compression != OTF2_COMPRESSION_NONE
+       || input.event_chunk_size != m_options.event_chunk_size
+       || input.definition_chunk_size != m_options.definition_chunk_size
+       || filters_location(location))
+    {
+        return false;
+    }
+
+    const fs::path source(input.directory);
+    const fs::path target(m_directory);
+    const auto events = std::to_string(location) + ".evt";
+    const auto definitions = std::to_string(location) + ".def";
+    std::error_code ec;
+    if(! fs::exists(source / events, ec) || (! fs::create_directories(target, ec) && ec))
+    {
+        return false;
+    }
+
+    auto & event_writer = m_event_writers[search->second];
+    if(event_writer != nullptr)
+    {
+        OTF2_Archive_CloseEvtWriter(m_archive.get(), event_writer);
+        event_writer = nullptr;
+    }
+    if(! clone_file(source / events, target / events)
+       || (fs::exists(source / definitions, ec) && ! clone_file(source / definitions, target / definitions)))
+    {
+        fs::remove(target / events, ec);
+        if(! m_memory_limited)
+        {
+            event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
+        }
+        return false;
+    }
+    m_local_definitions_closed[search->second] = true;
+    if(m_options.stats != nullptr)
+    {
+        m_options.stats->add_copied_location();
+    }
+    return true;
+}
+
+bool
+TraceWriter::filters_location(OTF2_LocationRef location)
+{
+    return std::any_of(m_location_filters.begin(), m_location_filters.end(),
+                       [location](IFilterCallbacks * filter){ return filter->affects_location(location); });
+}
+
+std::vector<GlobalDefinition>
+TraceWriter::stringReferencingDefinitions()
+{
+    if(m_strings.mode() == StringTable::Mode::All)
+    {
+        return {};
+    }
+    return m_string_references;
+}
 
 void
-TraceWriter::register_filter(IFilterCallbacks & filter)
+TraceWriter::handleStringReference(GlobalDefinition definition, OTF2_StringRef string)
+{
+    m_strings.reference(string);
+}
+
+/*
+ * Event writers are created for the locations, filters may keep state of
+ * the definitions they see and the string table is read by filters. All
+ * other definitions are only copied and can be written later.
+ */
+bool
+TraceWriter::eventsDependOn(GlobalDefinition definition)
+{
+    switch(definition)
+    {
+    case GlobalDefinition::Location:
+        return true;
+    case GlobalDefinition::String:
+        return m_strings.mode() == StringTable::Mode::All ||
+               ! m_string_references.empty() ||
+               ! m_global_String_filter.empty();
+    @otf2 for def in defs|global_defs:
+    @otf2 if "Location" != def.name and "String" != def.name:
+    case GlobalDefinition::@@def.name@@:
+        return ! m_global_@@def.name@@_filter.empty();
+    @otf2 endif
+    @otf2 endfor
+    }
+    return true;
+}
+
+bool
+TraceWriter::selectsLocation(OTF2_LocationRef location)
+{
+    return m_dropped_locations.count(location) == 0;
+}
+
+bool
+TraceWriter::handlesEvent(EventType type)
+{
+    return ! m_dropped_events[static_cast<std::size_t>(type)];
+}
+
+OTF2_TimeStamp
+TraceWriter::eventsBegin()
+{
+    return m_time_window.begin;
+}
+
+OTF2_TimeStamp
+TraceWriter::eventsEnd()
 {
+    return m_time_window.end;
+}
+
+bool
+TraceWriter::readsPastEnd(OTF2_LocationRef location)
+{
+    if(! m_balances_window || m_thread_window.owner != this)
+    {
+        return false;
+    }
+    const auto & open = m_thread_window.open;
+    return std::any_of(open.begin(), open.end(), [](const OpenRecord & record) {
+        return record.written && record.type != EventType::Enter;
+    });
+}
+
+/*
+ * Records opened before the time window are written at its begin, regions
+ * only if nothing was read in the window, see endLocation(). Filters can
+ * only drop records, the records a window cuts through are balanced here.
+ */
+void
+TraceWriter::reopen_records(OTF2_LocationRef location, bool enters_only)
+{
+    m_thread_window.before = false;
+    for(auto & record: m_thread_window.open)
+    {
+        if(! record.kept || (enters_only && record.type != EventType::Enter))
+        {
+            continue;
+        }
+        record.written = true;
+        switch(record.type)
+        {
+        case EventType::Enter:
+            writeEnterEvent(location, m_time_window.begin, nullptr, record.region);
+            break;
+        case EventType::MpiCollectiveBegin:
+            writeMpiCollectiveBeginEvent(location, m_time_window.begin, nullptr);
+            break;
+        case EventType::IoOperationBegin:
+            writeIoOperationBeginEvent(location, m_time_window.begin, nullptr, record.handle, record.mode,
+                                       record.flags, record.bytes_request, record.matching_id);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+bool
+TraceWriter::open_record(OpenRecord record)
+{
+    record.written = record.kept && m_time_window.contains(record.time);
+    if(m_thread_window.owner == this)
+    {
+        m_thread_window.open.push_back(record);
+    }
+    return ! record.written;
+}
+
+std::vector<TraceWriter::OpenRecord>::iterator
+TraceWriter::find_open(EventType type, OTF2_IoHandleRef handle, uint64_t matching_id)
+{
+    return ::find_open(m_thread_window.open, type, handle, matching_id);
+}
+
+bool
+TraceWriter::close_record(bool filtered, OTF2_TimeStamp & time, std::vector<OpenRecord>::iterator record)
+{
+    if(m_thread_window.owner != this)
+    {
+        return filtered;
+    }
+    if(record == m_thread_window.open.end())
+    {
+        /*
+         * Opened by no event read or replayed, the trace is not balanced.
+         */
+        return true;
+    }
+    bool written = record->written;
+    m_thread_window.open.erase(record);
+    if(time > m_time_window.end)
+    {
+        time = m_time_window.end;
+        return ! written;
+    }
+    return filtered || ! written;
+}
+
+void
+TraceWriter::register_filter(IFilterCallbacks & filter, int priority)
+{
+    for(auto definition: filter.string_references())
+    {
+        if(definition == GlobalDefinition::String)
+        {
+            m_strings.set_mode(StringTable::Mode::All);
+        }
+        else if(std::find(m_string_references.begin(),
+                          m_string_references.end(),
+                          definition) == m_string_references.end())
+        {
+            m_string_references.push_back(definition);
+        }
+    }
+    filter.set_string_table(m_strings);
+
+    restrict_time_window(filter.time_window());
+
     auto cbs = filter.get_callbacks();
+    bool handles_events = false;
 
     @otf2 for def in defs|global_defs:
     if(cbs.global_@@def.lower@@_callback)
     {
-        m_global_@@def.name@@_filter.add(cbs.global_@@def.lower@@_callback);
+        m_global_@@def.name@@_filter.add(cbs.global_@@def.lower@@_callback, priority);
     }
     @otf2 endfor
 
     @otf2 for event in events:
     if(cbs.event_@@event.lower@@_callback)
     {
-        m_event_@@event.name@@_filter.add(cbs.event_@@event.lower@@_callback);
+        m_event_@@event.name@@_filter.add(cbs.event_@@event.lower@@_callback, priority);
+        handles_events = true;
     }
     @otf2 endfor
+
+    /*
+     * Locations with events of dropped types cannot be copied.
+     */
+    for(auto type: filter.dropped_event_types())
+    {
+        m_dropped_events[static_cast<std::size_t>(type)] = true;
+        handles_events = true;
+    }
+    for(auto type: filter.dropped_attribute_types())
+    {
+        m_dropped_attribute_types[type] = true;
+        m_drops_attributes = true;
+        handles_events = true;
+    }
+
+    if(handles_events)
+    {
+        m_location_filters.push_back(&filter);
+    }
 }
\ No newline at end of file
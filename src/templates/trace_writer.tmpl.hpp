@@ -1,20 +1,30 @@
 #ifndef TRACE_WRITER_H
 #define TRACE_WRITER_H
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <otf2/OTF2_GeneralDefinitions.h>
 #include <string>
 #include <functional>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 extern "C"
 {
     #include <otf2/otf2.h>
 }
 
+#include <chunk_pool.hpp>
 #include <otf2_handler.hpp>
 #include <filter.hpp>
+#include <location_scheduler.hpp>
+#include <open_events.hpp>
+#include <string_table.hpp>
+#include <trace_stats.hpp>
 
 using archive_deleter = std::function<void (OTF2_Archive *)>;
 using archive_ptr = std::unique_ptr<OTF2_Archive, archive_deleter>;
@@ -22,14 +32,104 @@ using archive_ptr = std::unique_ptr<OTF2_Archive, archive_deleter>;
 using event_writer_deleter = std::function<void (OTF2_EvtWriter *)>;
 using event_writer_ptr = std::unique_ptr<OTF2_EvtWriter, event_writer_deleter>;
 
+/*
+ * Chunk sizes accepted by OTF2_Archive_Open().
+ */
+inline constexpr uint64_t min_chunk_size = 256 * 1024;
+inline constexpr uint64_t max_chunk_size = 16 * 1024 * 1024;
+
+/*
+ * Layout of the written archive.
+ */
+struct TraceWriterOptions
+{
+    OTF2_Compression compression = OTF2_COMPRESSION_NONE;
+
+    /*
+     * Size of the chunks events are buffered in, every location with
+     * events holds at least one. See event_chunk_size() for deriving it
+     * from the input trace. Chunk sizes have to lie between
+     * min_chunk_size and max_chunk_size.
+     */
+    uint64_t event_chunk_size = 1024 * 1024;
+
+    uint64_t definition_chunk_size = 4 * 1024 * 1024;
+
+    /*
+     * Recycle chunks between the writers of a thread, see ChunkPool.
+     */
+    bool pool_chunks = true;
+
+    /*
+     * Back pooled chunks with transparent huge pages.
+     */
+    bool huge_pages = false;
+
+    /*
+     * Bytes the chunks of the archive may use, 0 for no limit. With a
+     * limit, chunks are always pooled, writers of a location only exist
+     * while it is read and buffers are flushed once the limit is reached.
+     * The number of locations read at once has to be bounded as well, see
+     * open_location_limit().
+     */
+    uint64_t memory_limit = 0;
+
+    /*
+     * Only keep the strings the registered filters resolve, e.g. file
+     * names, instead of every string of the trace. Costs a pass over the
+     * global definitions before reading, for traces whose strings do not
+     * fit into memory.
+     */
+    bool referenced_strings = false;
+
+    /*
+     * Count the handled events and time closing the archive, nullptr to
+     * gather no statistics. Has to outlive the writer.
+     */
+    TraceStats *stats = nullptr;
+};
+
+/*
+ * Event chunk size fitting the number of events announced by the
+ * locations, e.g. read with TraceReader::read_locations().
+ *
+ * A chunk holds the events of an average location, rounded up to a power
+ * of two and within the limits OTF2 accepts. Traces with many small
+ * locations get small chunks, traces with few large locations write in
+ * large blocks.
+ */
+uint64_t
+event_chunk_size(const std::vector<LocationWeight> &locations);
+
+/*
+ * Number of locations whose writers fit into the memory limit at once, each
+ * needs an event and a definition chunk.
+ *
+ * @return 0 if the options do not limit the memory
+ */
+std::size_t
+open_location_limit(const TraceWriterOptions &options);
+
+/*
+ * Writes all handled records into a new archive.
+ *
+ * Global definitions are handled by the thread reading them. Events of a
+ * location are enclosed by beginLocation() and endLocation() and handled
+ * by one worker at a time. That worker owns the event writer of the
+ * location while it reads it, so writing an event needs neither an archive
+ * lookup nor a lock. The remaining shared state of the archive, e.g.
+ * creating writers, is guarded by OTF2 locking callbacks.
+ */
 class TraceWriter: public Otf2Handler {
   public:
     /*
      * Initialize OTF2 archive, event and definition writer.
      *
      * @param path specify the folder of trace to be written
+     * @param options compression and chunk sizes of the archive
+     * @throws std::runtime_error if the archive cannot be created
      */
-    TraceWriter(const std::string &path);
+    TraceWriter(const std::string &path, const TraceWriterOptions &options = TraceWriterOptions());
     virtual ~TraceWriter();
 
     constexpr const char *
@@ -73,14 +173,327 @@ class TraceWriter: public Otf2Handler {
 
     @otf2 endfor
 
+    virtual void
+    beginLocation(OTF2_LocationRef location) override;
+
+    virtual void
+    endLocation(OTF2_LocationRef location) override;
+
+    virtual void
+    endLocalDefinitions(OTF2_LocationRef location) override;
+
+    /*
+     * Register the callbacks of a filter.
+     *
+     * Callbacks of filters registered with a lower priority value are
+     * evaluated first, see Filter<T>. A record is dropped by the first
+     * callback returning true.
+     */
+    void
+    register_filter(IFilterCallbacks & filter, int priority = 0);
+
+    /*
+     * Strings of the trace, shared by all registered filters.
+     */
+    inline StringTable &
+    string_table()
+    {
+        return m_strings;
+    }
+
+    virtual std::vector<GlobalDefinition>
+    stringReferencingDefinitions() override;
+
+    virtual void
+    handleStringReference(GlobalDefinition definition, OTF2_StringRef string) override;
+
+    virtual bool
+    eventsDependOn(GlobalDefinition definition) override;
+
+    /*
+     * Begin and end of the time window of the registered filters.
+     */
+    virtual OTF2_TimeStamp
+    eventsBegin() override;
+    virtual OTF2_TimeStamp
+    eventsEnd() override;
+
+    /*
+     * Collective and I/O operations begun in the time window are read past
+     * its end, their end is written at it.
+     */
+    virtual bool
+    readsPastEnd(OTF2_LocationRef location) override;
+
+    /*
+     * Copy the event and local definition files of a location no filter
+     * affects, see filters_location(). Only uncompressed files split into
+     * chunks of the sizes of this archive are copied.
+     */
+    virtual bool
+    copyLocation(const ArchiveLayout &input, OTF2_LocationRef location) override;
+
+    /*
+     * Locations whose definition a filter dropped are not read.
+     */
+    virtual bool
+    selectsLocation(OTF2_LocationRef location) override;
+
+    /*
+     * Event types a filter drops as a whole are not decoded, see
+     * IFilterCallbacks::dropped_event_types().
+     */
+    virtual bool
+    handlesEvent(EventType type) override;
+
+  protected:
+    /*
+     * Write records to the archive, without applying any filter. Writers
+     * keep the global definitions consistent through them: the clock
+     * properties are shrunk to the time window, written locations get an
+     * event writer and definitions of locations dropped by
+     * drop_location() are left out or pruned. Attribute values of dropped
+     * types are removed from the events.
+     */
+    @otf2 for def in defs|global_defs:
+
+    void
+    writeGlobal@@def.name@@(@@def.funcargs(leading_comma=False)@@);
+
+    @otf2 endfor
+    @otf2 for event in events:
+
+    void
+    write@@event.name@@Event(OTF2_LocationRef    location,
+                            OTF2_TimeStamp      time,
+                            OTF2_AttributeList* attributes@@event.funcargs()@@);
+
+    @otf2 endfor
+
+    void
+    add_location(OTF2_LocationRef location);
+
+    /*
+     * The location and its events are not written, see writeGlobalGroup().
+     */
+    void
+    drop_location(OTF2_LocationRef location);
+
+    /*
+     * Intersect the time window of the written events with the window, see
+     * IFilterCallbacks::time_window().
+     */
     void
-    register_filter(IFilterCallbacks & filter);
+    restrict_time_window(TimeWindow window);
+
+    /*
+     * Whether records of the location may be dropped or changed, asks the
+     * registered filters with event callbacks. Writers handling events
+     * differently have to extend it, otherwise the location is copied.
+     */
+    virtual bool
+    filters_location(OTF2_LocationRef location);
+
+    /*
+     * Count an event of the location the current thread is reading.
+     */
+    inline void
+    count_event(EventType type, bool filtered)
+    {
+        if(m_thread_event_writer.counters != nullptr && m_thread_event_writer.owner == this)
+        {
+            m_thread_event_writer.counters->read[static_cast<std::size_t>(type)]++;
+            m_thread_event_writer.counters->filtered[static_cast<std::size_t>(type)] += filtered;
+        }
+    }
+
+    /*
+     * Count an event written to the location the current thread is reading.
+     */
+    inline void
+    count_written(EventType type)
+    {
+        if(m_thread_event_writer.counters != nullptr && m_thread_event_writer.owner == this)
+        {
+            m_thread_event_writer.counters->written[static_cast<std::size_t>(type)]++;
+        }
+    }
 
   private:
+    /*
+     * Event writer of the location the current thread is reading.
+     */
+    struct LocationEventWriter
+    {
+        const TraceWriter * owner;
+        OTF2_LocationRef location;
+        OTF2_EvtWriter * writer;
+        EventCounters * counters;
+    };
+
+    /*
+     * Remove the attribute values of dropped types, see
+     * IFilterCallbacks::dropped_attribute_types().
+     */
+    inline void
+    drop_attributes(OTF2_AttributeList * attributes)
+    {
+        if(m_drops_attributes && attributes != nullptr && OTF2_AttributeList_GetNumberOfElements(attributes) != 0)
+        {
+            remove_dropped_attributes(attributes);
+        }
+    }
+
+    void
+    remove_dropped_attributes(OTF2_AttributeList * attributes);
+
+    inline OTF2_EvtWriter *
+    location_event_writer(OTF2_LocationRef location)
+    {
+        if(m_thread_event_writer.owner == this && m_thread_event_writer.location == location)
+        {
+            return m_thread_event_writer.writer;
+        }
+        return cached_event_writer(location);
+    }
+
+    inline OTF2_EvtWriter *
+    cached_event_writer(OTF2_LocationRef location)
+    {
+        auto search = m_location_ordinals.find(location);
+        if(search != m_location_ordinals.end() && m_event_writers[search->second] != nullptr)
+        {
+            return m_event_writers[search->second];
+        }
+        return OTF2_Archive_GetEvtWriter(m_archive.get(), location);
+    }
+
+    /*
+     * Records opening a region or an operation on the location the current
+     * thread is reading. A time window cuts through them, TraceWriter
+     * balances the cut records, see reopen_records() and endLocation().
+     */
+    struct OpenRecord : OpenEvent
+    {
+        bool kept;
+        bool written = false;
+    };
+
+    struct LocationWindow
+    {
+        const TraceWriter * owner = nullptr;
+        bool before = true;
+        std::vector<OpenRecord> open;
+    };
+
+    /*
+     * Records opened before the time window are filtered as if at its
+     * begin, the kept ones are written there once it is reached.
+     */
+    inline OTF2_TimeStamp
+    window_time(OTF2_TimeStamp time) const
+    {
+        return m_balances_window ? std::max(time, m_time_window.begin) : time;
+    }
+
+    inline void
+    reach_window(OTF2_LocationRef location, OTF2_TimeStamp time)
+    {
+        if(m_thread_window.before && m_thread_window.owner == this && time >= m_time_window.begin)
+        {
+            reopen_records(location, false);
+        }
+    }
+
+    void
+    reopen_records(OTF2_LocationRef location, bool enters_only);
+
+    /*
+     * Open the record, returns whether it is filtered.
+     */
+    bool
+    open_record(OpenRecord record);
+
+    /*
+     * Last open record of the type, I/O operations are matched by their
+     * handle and matching id.
+     */
+    std::vector<OpenRecord>::iterator
+    find_open(EventType type, OTF2_IoHandleRef handle = OTF2_UNDEFINED_IO_HANDLE, uint64_t matching_id = 0);
+
+    /*
+     * Close the record, returns whether the closing record is filtered. It
+     * is kept if the record was written, moved to the end of the window if
+     * read past it, and dropped if it closes no record.
+     */
+    bool
+    close_record(bool filtered, OTF2_TimeStamp & time, std::vector<OpenRecord>::iterator record);
+
+    static thread_local LocationEventWriter m_thread_event_writer;
+    static thread_local LocationWindow m_thread_window;
     static OTF2_FlushCallbacks m_flush_callbacks;
+    /*
+     * Declared before the archive, it has to outlive it.
+     */
+    std::unique_ptr<ChunkPool> m_chunk_pool;
     archive_ptr m_archive;
     OTF2_GlobalDefWriter* m_def_writer;
-    std::unordered_set<OTF2_LocationRef> m_locations;
+    TraceWriterOptions m_options;
+    std::string m_directory;
+
+    /*
+     * Event writers of all defined locations, indexed by the ordinal of the
+     * location in the global definitions.
+     */
+    std::unordered_map<OTF2_LocationRef, size_t> m_location_ordinals;
+    std::vector<OTF2_EvtWriter *> m_event_writers;
+
+    /*
+     * Locations whose definition a filter dropped, they get no writer and
+     * are removed from groups of locations. Metric class recorders and
+     * metric instances recorded by them or scoped to them are dropped too.
+     */
+    std::unordered_set<OTF2_LocationRef> m_dropped_locations;
+
+    /*
+     * With a memory limit, writers are created by beginLocation() and
+     * closed by endLocation() and endLocalDefinitions(). Local definitions
+     * of copied locations are closed as well.
+     */
+    bool m_memory_limited = false;
+    std::vector<char> m_local_definitions_closed;
+
+    /*
+     * Registered filters with event callbacks.
+     */
+    std::vector<IFilterCallbacks *> m_location_filters;
+
+    /*
+     * Event types dropped as a whole, indexed by EventType.
+     */
+    std::array<bool, number_of_event_types> m_dropped_events{};
+
+    /*
+     * Attribute value types removed from the events, indexed by OTF2_Type.
+     */
+    std::array<bool, 256> m_dropped_attribute_types{};
+    bool m_drops_attributes = false;
+
+    /*
+     * Intersection of the time windows of the registered filters, the
+     * clock properties are shrunk to it. Unless it is the whole trace,
+     * records it cuts through are balanced.
+     */
+    TimeWindow m_time_window;
+    bool m_balances_window = false;
+
+    /*
+     * With TraceWriterOptions::referenced_strings, only strings referenced
+     * by the definitions in m_string_references are kept, unless a filter
+     * asks for all of them.
+     */
+    StringTable m_strings;
+    std::vector<GlobalDefinition> m_string_references;
 
     @otf2 for def in defs|global_defs:
     Filter<Global@@def.name@@Filter> m_global_@@def.name@@_filter;
@@ -91,4 +504,73 @@ class TraceWriter: public Otf2Handler {
     @otf2 endfor
 };
 
+/*
+ * The event handlers are defined here, a LocalReader<TraceWriter> inlines
+ * them into its callbacks.
+ */
+@otf2 for event in events:
+
+inline void
+TraceWriter::handle@@event.name@@Event(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList* attributes@@event.funcargs()@@)
+{
+    if(m_balances_window)
+    {
+        reach_window(location, time);
+    }
+    @otf2  if event.name in ['Enter', 'MpiCollectiveBegin', 'IoOperationBegin']:
+    bool filtered = ! m_event_@@event.name@@_filter.empty() &&
+                    m_event_@@event.name@@_filter.process(location, window_time(time), attributes@@event.callargs()@@);
+    @otf2 endif
+    @otf2  if event.name not in ['Enter', 'MpiCollectiveBegin', 'IoOperationBegin']:
+    bool filtered = ! m_event_@@event.name@@_filter.empty() &&
+                    m_event_@@event.name@@_filter.process(location, time, attributes@@event.callargs()@@);
+    @otf2 endif
+    @otf2  if event.name == 'Enter':
+    if(m_balances_window)
+    {
+        filtered = open_record({{EventType::Enter, time, region}, ! filtered});
+    }
+    @otf2 endif
+    @otf2  if event.name == 'Leave':
+    if(m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::Enter));
+    }
+    @otf2 endif
+    @otf2  if event.name == 'MpiCollectiveBegin':
+    if(m_balances_window)
+    {
+        filtered = open_record({{EventType::MpiCollectiveBegin, time}, ! filtered});
+    }
+    @otf2 endif
+    @otf2  if event.name == 'MpiCollectiveEnd':
+    if(m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::MpiCollectiveBegin));
+    }
+    @otf2 endif
+    @otf2  if event.name == 'IoOperationBegin':
+    if(m_balances_window)
+    {
+        filtered = open_record({{EventType::IoOperationBegin, time, OTF2_UNDEFINED_REGION,
+                                 handle, mode, operationFlags, bytesRequest, matchingId}, ! filtered});
+    }
+    @otf2 endif
+    @otf2  if event.name == 'IoOperationComplete' or event.name == 'IoOperationCancelled':
+    if(m_balances_window)
+    {
+        filtered = close_record(filtered, time, find_open(EventType::IoOperationBegin, handle, matchingId));
+    }
+    @otf2 endif
+    count_event(EventType::@@event.name@@, filtered);
+    if(! filtered)
+    {
+        write@@event.name@@Event(location, time, attributes@@event.callargs()@@);
+    }
+}
+
+@otf2 endfor
+
 #endif /* TRACE_WRITER_H */
\ No newline at end of file
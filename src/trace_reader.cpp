@@ -1,17 +1,43 @@
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <iostream>
+#include <utility>
 
-#include <local_reader.hpp>
+#include <location_scheduler.hpp>
+#include <otf2_locking.hpp>
 #include <trace_reader.hpp>
 
-TraceReader::TraceReader(const std::string &path, Otf2Handler &handler, size_t nthreads)
-    : m_handler(handler), m_reader(OTF2_Reader_Open(path.c_str()), OTF2_Reader_Close), m_location_count(0),
-      m_thread_count(nthreads)
+TraceReader::TraceReader(const std::string &       path,
+                         Otf2Handler &             handler,
+                         size_t                    nthreads,
+                         const TraceReaderOptions &options)
+    : TraceReader(path,
+                  handler,
+                  nthreads,
+                  options,
+                  LocalReader<Otf2Handler>(handler, options.stats, options.positions, options.position_recorder))
+{
+}
+
+TraceReader::TraceReader(const std::string &       path,
+                         Otf2Handler &             handler,
+                         size_t                    nthreads,
+                         const TraceReaderOptions &options,
+                         local_reader_function     local_reader)
+    : m_path(path), m_handler(handler), m_reader(OTF2_Reader_Open(path.c_str()), OTF2_Reader_Close),
+      m_location_count(0), m_thread_count(nthreads), m_options(options), m_local_reader(std::move(local_reader))
 {
     OTF2_Reader_SetSerialCollectiveCallbacks(m_reader.get());
+    set_locking_callbacks(m_reader.get());
     OTF2_Reader_GetNumberOfLocations(m_reader.get(), &m_location_count);
 
-    read_definitions();
+    auto string_references = m_handler.stringReferencingDefinitions();
+    if (!string_references.empty())
+    {
+        read_string_references(string_references);
+    }
+    read_definitions(m_options.pipelined ? DefinitionPass::EventDependencies : DefinitionPass::All);
 }
 // TODO name it process_events??
 void
@@ -19,120 +45,601 @@ TraceReader::read()
 {
     std::vector<std::thread> workers;
 
-    size_t locations_per_thread = m_locations.size() / m_thread_count;
-    size_t rest_locations       = m_locations.size() - locations_per_thread * m_thread_count;
+    select_locations();
+    if (m_options.copy_locations)
+    {
+        copy_locations();
+    }
+    for (const auto &location : m_locations)
+    {
+        OTF2_Reader_SelectLocation(m_reader.get(), location.location);
+    }
 
-    std::vector<size_t> thread_location_count(m_thread_count, locations_per_thread);
-    for (int i = 0; rest_locations > 0; rest_locations--, i++)
+    std::thread definition_worker;
+    if (m_options.pipelined)
     {
-        thread_location_count[i % m_thread_count]++;
+        definition_worker = std::thread(&TraceReader::read_definitions, this, DefinitionPass::Remaining);
     }
 
-    auto src_begin = m_locations.begin();
-    for (size_t i = 0; i < thread_location_count.size(); i++)
+    size_t nworkers = m_thread_count;
+    if (m_options.max_open_locations != 0)
+    {
+        nworkers = std::min(nworkers, m_options.max_open_locations);
+    }
+    LocationSchedule schedule = schedule_locations(m_locations, nworkers);
+    schedule.erase(std::remove_if(schedule.begin(),
+                                  schedule.end(),
+                                  [](const std::vector<OTF2_LocationRef> &assigned) { return assigned.empty(); }),
+                   schedule.end());
+    LocationQueue               queue(schedule);
+    std::unique_ptr<Prefetcher> prefetcher = start_prefetcher(schedule);
+    if (prefetcher)
     {
-        auto thread_locations = std::vector<size_t>(src_begin, src_begin + thread_location_count[i]);
-        workers.emplace_back(LocalReader(m_handler), m_reader.get(), thread_locations);
-        src_begin += thread_location_count[i];
+        queue.set_observer([&prefetcher](OTF2_LocationRef) { prefetcher->advance(); });
+    }
+    for (size_t i = 0; i < queue.workers(); i++)
+    {
+        workers.emplace_back(&TraceReader::read_worker, this, std::ref(queue), std::cref(schedule[i]), i);
     }
     for (auto &w : workers)
     {
         w.join();
     }
+    if (definition_worker.joinable())
+    {
+        definition_worker.join();
+    }
 }
 
+/*
+ * A reader of its own selects the locations scheduled for the worker,
+ * stolen locations are selected when their event reader is created. It
+ * gets the locking callbacks like the shared reader, OTF2 does not
+ * promise a reader to be free of state shared between threads, and the
+ * locks are uncontended while only the worker uses it. If the archive cannot be opened again,
+ * the worker falls back to the shared reader, counted in the statistics.
+ *
+ * Every worker reads with a copy of the local reader, it holds the state
+ * of the location being read.
+ */
 void
-TraceReader::read_definitions()
+TraceReader::read_worker(LocationQueue &queue, const std::vector<OTF2_LocationRef> &assigned, size_t worker)
+{
+    local_reader_function local_reader = m_local_reader;
+    if (m_options.reader_per_worker)
+    {
+        reader_ptr reader(OTF2_Reader_Open(m_path.c_str()), OTF2_Reader_Close);
+        if (m_options.stats != nullptr)
+        {
+            m_options.stats->add_worker_reader(static_cast<bool>(reader));
+        }
+        if (reader)
+        {
+            OTF2_Reader_SetSerialCollectiveCallbacks(reader.get());
+            set_locking_callbacks(reader.get());
+            for (auto location : assigned)
+            {
+                OTF2_Reader_SelectLocation(reader.get(), location);
+            }
+            local_reader(reader.get(), queue, worker);
+            return;
+        }
+    }
+    local_reader(m_reader.get(), queue, worker);
+}
+
+/*
+ * Collects location definitions until all locations of the trace are known.
+ */
+struct LocationCollector
+{
+    std::vector<LocationWeight> locations;
+    uint64_t                    location_count;
+};
+
+static OTF2_CallbackCode
+collect_location(void *                userData,
+                 OTF2_LocationRef      self,
+                 OTF2_StringRef        name,
+                 OTF2_LocationType     locationType,
+                 uint64_t              numberOfEvents,
+                 OTF2_LocationGroupRef locationGroup)
 {
+    auto collector = static_cast<LocationCollector *>(userData);
+    collector->locations.push_back({self, numberOfEvents});
+    if (collector->locations.size() == collector->location_count)
+    {
+        return OTF2_CALLBACK_INTERRUPT;
+    }
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+std::vector<LocationWeight>
+TraceReader::read_locations(const std::string &path)
+{
+    reader_ptr reader(OTF2_Reader_Open(path.c_str()), OTF2_Reader_Close);
+    if (!reader)
+    {
+        return {};
+    }
+    OTF2_Reader_SetSerialCollectiveCallbacks(reader.get());
+
+    LocationCollector collector{{}, 0};
+    OTF2_Reader_GetNumberOfLocations(reader.get(), &collector.location_count);
+
+    OTF2_GlobalDefReader *         global_def_reader = OTF2_Reader_GetGlobalDefReader(reader.get());
+    OTF2_GlobalDefReaderCallbacks *def_callbacks     = OTF2_GlobalDefReaderCallbacks_New();
+    OTF2_GlobalDefReaderCallbacks_SetLocationCallback(def_callbacks, collect_location);
+    OTF2_Reader_RegisterGlobalDefCallbacks(reader.get(), global_def_reader, def_callbacks, &collector);
+    OTF2_GlobalDefReaderCallbacks_Delete(def_callbacks);
+
+    uint64_t definitions_read = 0;
+    OTF2_Reader_ReadAllGlobalDefinitions(reader.get(), global_def_reader, &definitions_read);
+
+    OTF2_Reader_CloseGlobalDefReader(reader.get(), global_def_reader);
+    return collector.locations;
+}
+
+OTF2_FileSubstrate
+TraceReader::file_substrate()
+{
+    OTF2_FileSubstrate substrate = OTF2_SUBSTRATE_UNDEFINED;
+    OTF2_Reader_GetFileSubstrate(m_reader.get(), &substrate);
+    return substrate;
+}
+
+/*
+ * Event and definition files of an archive are stored in a folder named
+ * like the anchor file without its extension.
+ */
+std::string
+TraceReader::archive_directory() const
+{
+    return std::filesystem::path(m_path).replace_extension().string();
+}
+
+/*
+ * Locations the handler does not select are forgotten before any of them
+ * is selected at the reader, copied or scheduled.
+ */
+void
+TraceReader::select_locations()
+{
+    auto unselected = [this](const LocationWeight &location) { return !m_handler.selectsLocation(location.location); };
+    m_locations.erase(std::remove_if(m_locations.begin(), m_locations.end(), unselected), m_locations.end());
+}
+
+void
+TraceReader::copy_locations()
+{
+    if (file_substrate() != OTF2_SUBSTRATE_POSIX)
+    {
+        return;
+    }
+
+    ArchiveLayout input;
+    input.directory = archive_directory();
+    OTF2_Reader_GetChunkSize(m_reader.get(), &input.event_chunk_size, &input.definition_chunk_size);
+    OTF2_Reader_GetCompression(m_reader.get(), &input.compression);
+
+    m_locations.erase(std::remove_if(m_locations.begin(),
+                                     m_locations.end(),
+                                     [&](const LocationWeight &location) {
+                                         return m_handler.copyLocation(input, location.location);
+                                     }),
+                      m_locations.end());
+}
+
+/*
+ * Only files of the POSIX substrate can be advised.
+ */
+std::unique_ptr<Prefetcher>
+TraceReader::start_prefetcher(const LocationSchedule &schedule)
+{
+    if (m_options.prefetch_distance == 0 || file_substrate() != OTF2_SUBSTRATE_POSIX)
+    {
+        return nullptr;
+    }
+    return std::make_unique<Prefetcher>(archive_directory(), schedule, m_options.prefetch_distance);
+}
+
+/*
+ * Locations are always read in the first pass, the workers are scheduled
+ * by them.
+ */
+bool
+TraceReader::select_definition(GlobalDefinition definition, DefinitionPass pass)
+{
+    if (pass == DefinitionPass::All)
+    {
+        return true;
+    }
+    bool dependency = definition == GlobalDefinition::Location || m_handler.eventsDependOn(definition);
+    return dependency == (pass == DefinitionPass::EventDependencies);
+}
+
+void
+TraceReader::read_definitions(DefinitionPass pass)
+{
+    PhaseTimer timer(m_options.stats, Phase::GlobalDefinitions);
+
     OTF2_GlobalDefReader *global_def_reader = OTF2_Reader_GetGlobalDefReader(m_reader.get());
 
     // TODO unique pointer
     OTF2_GlobalDefReaderCallbacks *def_callbacks = OTF2_GlobalDefReaderCallbacks_New();
 
-    OTF2_GlobalDefReaderCallbacks_SetClockPropertiesCallback(def_callbacks, definition::GlobalClockPropertiesCb);
+    if (select_definition(GlobalDefinition::ClockProperties, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetClockPropertiesCallback(def_callbacks, definition::GlobalClockPropertiesCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetParadigmCallback(def_callbacks, definition::GlobalParadigmCb);
+    if (select_definition(GlobalDefinition::Paradigm, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetParadigmCallback(def_callbacks, definition::GlobalParadigmCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetParadigmPropertyCallback(def_callbacks, definition::GlobalParadigmPropertyCb);
+    if (select_definition(GlobalDefinition::ParadigmProperty, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetParadigmPropertyCallback(def_callbacks, definition::GlobalParadigmPropertyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetIoParadigmCallback(def_callbacks, definition::GlobalIoParadigmCb);
+    if (select_definition(GlobalDefinition::IoParadigm, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetIoParadigmCallback(def_callbacks, definition::GlobalIoParadigmCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetStringCallback(def_callbacks, definition::GlobalStringCb);
+    if (select_definition(GlobalDefinition::String, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetStringCallback(def_callbacks, definition::GlobalStringCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetAttributeCallback(def_callbacks, definition::GlobalAttributeCb);
+    if (select_definition(GlobalDefinition::Attribute, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetAttributeCallback(def_callbacks, definition::GlobalAttributeCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodeCallback(def_callbacks, definition::GlobalSystemTreeNodeCb);
+    if (select_definition(GlobalDefinition::SystemTreeNode, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodeCallback(def_callbacks, definition::GlobalSystemTreeNodeCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetLocationGroupCallback(def_callbacks, definition::GlobalLocationGroupCb);
+    if (select_definition(GlobalDefinition::LocationGroup, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetLocationGroupCallback(def_callbacks, definition::GlobalLocationGroupCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetLocationCallback(def_callbacks, definition::GlobalLocationCb);
+    if (select_definition(GlobalDefinition::Location, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetLocationCallback(def_callbacks, definition::GlobalLocationCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetRegionCallback(def_callbacks, definition::GlobalRegionCb);
+    if (select_definition(GlobalDefinition::Region, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetRegionCallback(def_callbacks, definition::GlobalRegionCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCallsiteCallback(def_callbacks, definition::GlobalCallsiteCb);
+    if (select_definition(GlobalDefinition::Callsite, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCallsiteCallback(def_callbacks, definition::GlobalCallsiteCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCallpathCallback(def_callbacks, definition::GlobalCallpathCb);
+    if (select_definition(GlobalDefinition::Callpath, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCallpathCallback(def_callbacks, definition::GlobalCallpathCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetGroupCallback(def_callbacks, definition::GlobalGroupCb);
+    if (select_definition(GlobalDefinition::Group, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetGroupCallback(def_callbacks, definition::GlobalGroupCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetMetricMemberCallback(def_callbacks, definition::GlobalMetricMemberCb);
+    if (select_definition(GlobalDefinition::MetricMember, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetMetricMemberCallback(def_callbacks, definition::GlobalMetricMemberCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetMetricClassCallback(def_callbacks, definition::GlobalMetricClassCb);
+    if (select_definition(GlobalDefinition::MetricClass, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetMetricClassCallback(def_callbacks, definition::GlobalMetricClassCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetMetricInstanceCallback(def_callbacks, definition::GlobalMetricInstanceCb);
+    if (select_definition(GlobalDefinition::MetricInstance, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetMetricInstanceCallback(def_callbacks, definition::GlobalMetricInstanceCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCommCallback(def_callbacks, definition::GlobalCommCb);
+    if (select_definition(GlobalDefinition::Comm, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCommCallback(def_callbacks, definition::GlobalCommCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetParameterCallback(def_callbacks, definition::GlobalParameterCb);
+    if (select_definition(GlobalDefinition::Parameter, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetParameterCallback(def_callbacks, definition::GlobalParameterCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetRmaWinCallback(def_callbacks, definition::GlobalRmaWinCb);
+    if (select_definition(GlobalDefinition::RmaWin, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetRmaWinCallback(def_callbacks, definition::GlobalRmaWinCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetMetricClassRecorderCallback(def_callbacks,
-                                                                 definition::GlobalMetricClassRecorderCb);
+    if (select_definition(GlobalDefinition::MetricClassRecorder, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetMetricClassRecorderCallback(
+            def_callbacks, definition::GlobalMetricClassRecorderCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodePropertyCallback(def_callbacks,
-                                                                    definition::GlobalSystemTreeNodePropertyCb);
+    if (select_definition(GlobalDefinition::SystemTreeNodeProperty, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodePropertyCallback(
+            def_callbacks, definition::GlobalSystemTreeNodePropertyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodeDomainCallback(def_callbacks,
-                                                                  definition::GlobalSystemTreeNodeDomainCb);
+    if (select_definition(GlobalDefinition::SystemTreeNodeDomain, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodeDomainCallback(
+            def_callbacks, definition::GlobalSystemTreeNodeDomainCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetLocationGroupPropertyCallback(def_callbacks,
-                                                                   definition::GlobalLocationGroupPropertyCb);
+    if (select_definition(GlobalDefinition::LocationGroupProperty, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetLocationGroupPropertyCallback(
+            def_callbacks, definition::GlobalLocationGroupPropertyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetLocationPropertyCallback(def_callbacks, definition::GlobalLocationPropertyCb);
+    if (select_definition(GlobalDefinition::LocationProperty, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetLocationPropertyCallback(def_callbacks, definition::GlobalLocationPropertyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCartDimensionCallback(def_callbacks, definition::GlobalCartDimensionCb);
+    if (select_definition(GlobalDefinition::CartDimension, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCartDimensionCallback(def_callbacks, definition::GlobalCartDimensionCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCartTopologyCallback(def_callbacks, definition::GlobalCartTopologyCb);
+    if (select_definition(GlobalDefinition::CartTopology, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCartTopologyCallback(def_callbacks, definition::GlobalCartTopologyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCartCoordinateCallback(def_callbacks, definition::GlobalCartCoordinateCb);
+    if (select_definition(GlobalDefinition::CartCoordinate, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCartCoordinateCallback(def_callbacks, definition::GlobalCartCoordinateCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetSourceCodeLocationCallback(def_callbacks, definition::GlobalSourceCodeLocationCb);
+    if (select_definition(GlobalDefinition::SourceCodeLocation, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetSourceCodeLocationCallback(
+            def_callbacks, definition::GlobalSourceCodeLocationCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCallingContextCallback(def_callbacks, definition::GlobalCallingContextCb);
+    if (select_definition(GlobalDefinition::CallingContext, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCallingContextCallback(def_callbacks, definition::GlobalCallingContextCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCallingContextPropertyCallback(def_callbacks,
-                                                                    definition::GlobalCallingContextPropertyCb);
+    if (select_definition(GlobalDefinition::CallingContextProperty, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCallingContextPropertyCallback(
+            def_callbacks, definition::GlobalCallingContextPropertyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetInterruptGeneratorCallback(def_callbacks, definition::GlobalInterruptGeneratorCb);
+    if (select_definition(GlobalDefinition::InterruptGenerator, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetInterruptGeneratorCallback(
+            def_callbacks, definition::GlobalInterruptGeneratorCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetIoFilePropertyCallback(def_callbacks, definition::GlobalIoFilePropertyCb);
+    if (select_definition(GlobalDefinition::IoFileProperty, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetIoFilePropertyCallback(def_callbacks, definition::GlobalIoFilePropertyCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetIoRegularFileCallback(def_callbacks, definition::GlobalIoRegularFileCb);
+    if (select_definition(GlobalDefinition::IoRegularFile, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetIoRegularFileCallback(def_callbacks, definition::GlobalIoRegularFileCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetIoDirectoryCallback(def_callbacks, definition::GlobalIoDirectoryCb);
+    if (select_definition(GlobalDefinition::IoDirectory, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetIoDirectoryCallback(def_callbacks, definition::GlobalIoDirectoryCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetIoHandleCallback(def_callbacks, definition::GlobalIoHandleCb);
+    if (select_definition(GlobalDefinition::IoHandle, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetIoHandleCallback(def_callbacks, definition::GlobalIoHandleCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetIoPreCreatedHandleStateCallback(def_callbacks,
-                                                                     definition::GlobalIoPreCreatedHandleStateCb);
+    if (select_definition(GlobalDefinition::IoPreCreatedHandleState, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetIoPreCreatedHandleStateCallback(
+            def_callbacks, definition::GlobalIoPreCreatedHandleStateCb);
+    }
 
-    OTF2_GlobalDefReaderCallbacks_SetCallpathParameterCallback(def_callbacks, definition::GlobalCallpathParameterCb);
+    if (select_definition(GlobalDefinition::CallpathParameter, pass))
+    {
+        OTF2_GlobalDefReaderCallbacks_SetCallpathParameterCallback(
+            def_callbacks, definition::GlobalCallpathParameterCb);
+    }
 
     OTF2_Reader_RegisterGlobalDefCallbacks(m_reader.get(), global_def_reader, def_callbacks, this);
 
     OTF2_GlobalDefReaderCallbacks_Delete(def_callbacks);
 
+    uint64_t definitions_read = 0;
+    if (pass == DefinitionPass::Remaining && m_options.definition_chunk > 0)
+    {
+        /*
+         * Stream the definitions in chunks, the archive is shared with the
+         * event workers during this pass.
+         */
+        do
+        {
+            OTF2_Reader_ReadGlobalDefinitions(
+                m_reader.get(), global_def_reader, m_options.definition_chunk, &definitions_read);
+        } while (definitions_read == m_options.definition_chunk);
+    }
+    else
+    {
+        OTF2_Reader_ReadAllGlobalDefinitions(m_reader.get(), global_def_reader, &definitions_read);
+    }
+
+    OTF2_Reader_CloseGlobalDefReader(m_reader.get(), global_def_reader);
+}
+
+void
+TraceReader::read_string_references(const std::vector<GlobalDefinition> &definitions)
+{
+    PhaseTimer timer(m_options.stats, Phase::StringReferences);
+
+    OTF2_GlobalDefReader *global_def_reader = OTF2_Reader_GetGlobalDefReader(m_reader.get());
+
+    OTF2_GlobalDefReaderCallbacks *def_callbacks = OTF2_GlobalDefReaderCallbacks_New();
+
+    for (auto definition : definitions)
+    {
+        switch (definition)
+        {
+        case GlobalDefinition::ClockProperties:
+            OTF2_GlobalDefReaderCallbacks_SetClockPropertiesCallback(
+                def_callbacks, string_reference::GlobalClockPropertiesCb);
+            break;
+        case GlobalDefinition::Paradigm:
+            OTF2_GlobalDefReaderCallbacks_SetParadigmCallback(def_callbacks, string_reference::GlobalParadigmCb);
+            break;
+        case GlobalDefinition::ParadigmProperty:
+            OTF2_GlobalDefReaderCallbacks_SetParadigmPropertyCallback(
+                def_callbacks, string_reference::GlobalParadigmPropertyCb);
+            break;
+        case GlobalDefinition::IoParadigm:
+            OTF2_GlobalDefReaderCallbacks_SetIoParadigmCallback(def_callbacks, string_reference::GlobalIoParadigmCb);
+            break;
+        case GlobalDefinition::String:
+            OTF2_GlobalDefReaderCallbacks_SetStringCallback(def_callbacks, string_reference::GlobalStringCb);
+            break;
+        case GlobalDefinition::Attribute:
+            OTF2_GlobalDefReaderCallbacks_SetAttributeCallback(def_callbacks, string_reference::GlobalAttributeCb);
+            break;
+        case GlobalDefinition::SystemTreeNode:
+            OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodeCallback(
+                def_callbacks, string_reference::GlobalSystemTreeNodeCb);
+            break;
+        case GlobalDefinition::LocationGroup:
+            OTF2_GlobalDefReaderCallbacks_SetLocationGroupCallback(
+                def_callbacks, string_reference::GlobalLocationGroupCb);
+            break;
+        case GlobalDefinition::Location:
+            OTF2_GlobalDefReaderCallbacks_SetLocationCallback(def_callbacks, string_reference::GlobalLocationCb);
+            break;
+        case GlobalDefinition::Region:
+            OTF2_GlobalDefReaderCallbacks_SetRegionCallback(def_callbacks, string_reference::GlobalRegionCb);
+            break;
+        case GlobalDefinition::Callsite:
+            OTF2_GlobalDefReaderCallbacks_SetCallsiteCallback(def_callbacks, string_reference::GlobalCallsiteCb);
+            break;
+        case GlobalDefinition::Callpath:
+            OTF2_GlobalDefReaderCallbacks_SetCallpathCallback(def_callbacks, string_reference::GlobalCallpathCb);
+            break;
+        case GlobalDefinition::Group:
+            OTF2_GlobalDefReaderCallbacks_SetGroupCallback(def_callbacks, string_reference::GlobalGroupCb);
+            break;
+        case GlobalDefinition::MetricMember:
+            OTF2_GlobalDefReaderCallbacks_SetMetricMemberCallback(
+                def_callbacks, string_reference::GlobalMetricMemberCb);
+            break;
+        case GlobalDefinition::MetricClass:
+            OTF2_GlobalDefReaderCallbacks_SetMetricClassCallback(def_callbacks, string_reference::GlobalMetricClassCb);
+            break;
+        case GlobalDefinition::MetricInstance:
+            OTF2_GlobalDefReaderCallbacks_SetMetricInstanceCallback(
+                def_callbacks, string_reference::GlobalMetricInstanceCb);
+            break;
+        case GlobalDefinition::Comm:
+            OTF2_GlobalDefReaderCallbacks_SetCommCallback(def_callbacks, string_reference::GlobalCommCb);
+            break;
+        case GlobalDefinition::Parameter:
+            OTF2_GlobalDefReaderCallbacks_SetParameterCallback(def_callbacks, string_reference::GlobalParameterCb);
+            break;
+        case GlobalDefinition::RmaWin:
+            OTF2_GlobalDefReaderCallbacks_SetRmaWinCallback(def_callbacks, string_reference::GlobalRmaWinCb);
+            break;
+        case GlobalDefinition::MetricClassRecorder:
+            OTF2_GlobalDefReaderCallbacks_SetMetricClassRecorderCallback(
+                def_callbacks, string_reference::GlobalMetricClassRecorderCb);
+            break;
+        case GlobalDefinition::SystemTreeNodeProperty:
+            OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodePropertyCallback(
+                def_callbacks, string_reference::GlobalSystemTreeNodePropertyCb);
+            break;
+        case GlobalDefinition::SystemTreeNodeDomain:
+            OTF2_GlobalDefReaderCallbacks_SetSystemTreeNodeDomainCallback(
+                def_callbacks, string_reference::GlobalSystemTreeNodeDomainCb);
+            break;
+        case GlobalDefinition::LocationGroupProperty:
+            OTF2_GlobalDefReaderCallbacks_SetLocationGroupPropertyCallback(
+                def_callbacks, string_reference::GlobalLocationGroupPropertyCb);
+            break;
+        case GlobalDefinition::LocationProperty:
+            OTF2_GlobalDefReaderCallbacks_SetLocationPropertyCallback(
+                def_callbacks, string_reference::GlobalLocationPropertyCb);
+            break;
+        case GlobalDefinition::CartDimension:
+            OTF2_GlobalDefReaderCallbacks_SetCartDimensionCallback(
+                def_callbacks, string_reference::GlobalCartDimensionCb);
+            break;
+        case GlobalDefinition::CartTopology:
+            OTF2_GlobalDefReaderCallbacks_SetCartTopologyCallback(
+                def_callbacks, string_reference::GlobalCartTopologyCb);
+            break;
+        case GlobalDefinition::CartCoordinate:
+            OTF2_GlobalDefReaderCallbacks_SetCartCoordinateCallback(
+                def_callbacks, string_reference::GlobalCartCoordinateCb);
+            break;
+        case GlobalDefinition::SourceCodeLocation:
+            OTF2_GlobalDefReaderCallbacks_SetSourceCodeLocationCallback(
+                def_callbacks, string_reference::GlobalSourceCodeLocationCb);
+            break;
+        case GlobalDefinition::CallingContext:
+            OTF2_GlobalDefReaderCallbacks_SetCallingContextCallback(
+                def_callbacks, string_reference::GlobalCallingContextCb);
+            break;
+        case GlobalDefinition::CallingContextProperty:
+            OTF2_GlobalDefReaderCallbacks_SetCallingContextPropertyCallback(
+                def_callbacks, string_reference::GlobalCallingContextPropertyCb);
+            break;
+        case GlobalDefinition::InterruptGenerator:
+            OTF2_GlobalDefReaderCallbacks_SetInterruptGeneratorCallback(
+                def_callbacks, string_reference::GlobalInterruptGeneratorCb);
+            break;
+        case GlobalDefinition::IoFileProperty:
+            OTF2_GlobalDefReaderCallbacks_SetIoFilePropertyCallback(
+                def_callbacks, string_reference::GlobalIoFilePropertyCb);
+            break;
+        case GlobalDefinition::IoRegularFile:
+            OTF2_GlobalDefReaderCallbacks_SetIoRegularFileCallback(
+                def_callbacks, string_reference::GlobalIoRegularFileCb);
+            break;
+        case GlobalDefinition::IoDirectory:
+            OTF2_GlobalDefReaderCallbacks_SetIoDirectoryCallback(def_callbacks, string_reference::GlobalIoDirectoryCb);
+            break;
+        case GlobalDefinition::IoHandle:
+            OTF2_GlobalDefReaderCallbacks_SetIoHandleCallback(def_callbacks, string_reference::GlobalIoHandleCb);
+            break;
+        case GlobalDefinition::IoPreCreatedHandleState:
+            OTF2_GlobalDefReaderCallbacks_SetIoPreCreatedHandleStateCallback(
+                def_callbacks, string_reference::GlobalIoPreCreatedHandleStateCb);
+            break;
+        case GlobalDefinition::CallpathParameter:
+            OTF2_GlobalDefReaderCallbacks_SetCallpathParameterCallback(
+                def_callbacks, string_reference::GlobalCallpathParameterCb);
+            break;
+        }
+    }
+
+    OTF2_Reader_RegisterGlobalDefCallbacks(m_reader.get(), global_def_reader, def_callbacks, &m_handler);
+
+    OTF2_GlobalDefReaderCallbacks_Delete(def_callbacks);
+
     uint64_t definitions_read = 0;
     OTF2_Reader_ReadAllGlobalDefinitions(m_reader.get(), global_def_reader, &definitions_read);
 
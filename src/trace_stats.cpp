@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iomanip>
+#include <unordered_map>
+
+#include <trace_stats.hpp>
+
+extern "C"
+{
+#include <sys/resource.h>
+#include <time.h>
+}
+
+namespace
+{
+std::atomic<uint64_t> next_stats_id{1};
+
+constexpr const char *phase_names[number_of_phases]  = {"string_references",
+                                                        "global_definitions",
+                                                        "local_definitions",
+                                                        "events",
+                                                        "close"};
+constexpr const char *phase_labels[number_of_phases] = {"string references",
+                                                        "global definitions",
+                                                        "local definitions",
+                                                        "events",
+                                                        "close"};
+
+double
+seconds(clockid_t clock)
+{
+    struct timespec time;
+    clock_gettime(clock, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+uint64_t
+peak_rss()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void
+write_json_string(std::ostream &out, const std::string &string)
+{
+    out << '"';
+    for (unsigned char c : string)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (c < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+} // namespace
+
+TraceStats::TraceStats() : m_id(next_stats_id++)
+{
+}
+
+/*
+ * Statistics are identified by an id instead of their address, like the
+ * thread caches of ChunkPool.
+ */
+ThreadStats &
+TraceStats::thread_stats()
+{
+    static thread_local std::unordered_map<uint64_t, ThreadStats *> threads;
+
+    auto search = threads.find(m_id);
+    if (search != threads.end())
+    {
+        return *search->second;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.push_back(std::make_unique<ThreadStats>());
+    threads.emplace(m_id, m_threads.back().get());
+    return *m_threads.back();
+}
+
+EventCounters
+TraceStats::events() const
+{
+    EventCounters               result;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &thread : m_threads)
+    {
+        for (std::size_t type = 0; type < number_of_event_types; type++)
+        {
+            result.read[type] += thread->events.read[type];
+            result.filtered[type] += thread->events.filtered[type];
+            result.written[type] += thread->events.written[type];
+        }
+    }
+    return result;
+}
+
+PhaseStats
+TraceStats::phase(Phase phase) const
+{
+    PhaseStats                  result;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &thread : m_threads)
+    {
+        const auto &stats = thread->phases[static_cast<std::size_t>(phase)];
+        result.wall_time  = std::max(result.wall_time, stats.wall_time);
+        result.cpu_time += stats.cpu_time;
+        result.peak_rss = std::max(result.peak_rss, stats.peak_rss);
+    }
+    return result;
+}
+
+void
+TraceStats::add_copied_location()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_copied_locations++;
+}
+
+void
+TraceStats::add_worker_reader(bool own)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    (own ? m_worker_readers : m_shared_readers)++;
+}
+
+uint64_t
+TraceStats::worker_readers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_worker_readers;
+}
+
+uint64_t
+TraceStats::shared_reader_fallbacks() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_shared_readers;
+}
+
+void
+TraceStats::set_filtered_files(std::vector<std::string> files)
+{
+    m_filtered_files = std::move(files);
+}
+
+void
+TraceStats::write_text(std::ostream &out) const
+{
+    out << std::left << std::setw(24) << "Phase" << std::right << std::setw(12) << "Wall [s]" << std::setw(12)
+        << "CPU [s]" << std::setw(16) << "Peak RSS [KiB]" << '\n';
+    out << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < number_of_phases; i++)
+    {
+        auto stats = phase(static_cast<Phase>(i));
+        out << std::left << std::setw(24) << phase_labels[i] << std::right << std::setw(12) << stats.wall_time
+            << std::setw(12) << stats.cpu_time << std::setw(16) << stats.peak_rss << '\n';
+    }
+
+    auto counters = events();
+    out << '\n'
+        << std::left << std::setw(24) << "Event" << std::right << std::setw(16) << "Read" << std::setw(16)
+        << "Filtered" << std::setw(16) << "Written" << '\n';
+    for (std::size_t type = 0; type < number_of_event_types; type++)
+    {
+        if (counters.read[type] != 0 || counters.written[type] != 0)
+        {
+            out << std::left << std::setw(24) << event_type_names[type] << std::right << std::setw(16)
+                << counters.read[type] << std::setw(16) << counters.filtered[type] << std::setw(16)
+                << counters.written[type] << '\n';
+        }
+    }
+
+    out << "\nCopied locations: " << m_copied_locations << '\n';
+    out << "Worker readers: " << m_worker_readers << " (" << m_shared_readers << " fell back to the shared reader)\n";
+    out << "Filtered files: " << m_filtered_files.size() << '\n';
+    for (const auto &file : m_filtered_files)
+    {
+        out << "  " << file << '\n';
+    }
+}
+
+void
+TraceStats::write_json(std::ostream &out) const
+{
+    out << std::fixed << std::setprecision(6);
+    out << "{\n  \"phases\": {";
+    for (std::size_t i = 0; i < number_of_phases; i++)
+    {
+        auto stats = phase(static_cast<Phase>(i));
+        out << (i == 0 ? "\n" : ",\n") << "    \"" << phase_names[i] << "\": {\"wall_time\": " << stats.wall_time
+            << ", \"cpu_time\": " << stats.cpu_time << ", \"peak_rss_kib\": " << stats.peak_rss << '}';
+    }
+
+    auto counters = events();
+    out << "\n  },\n  \"events\": {";
+    bool first = true;
+    for (std::size_t type = 0; type < number_of_event_types; type++)
+    {
+        if (counters.read[type] != 0 || counters.written[type] != 0)
+        {
+            out << (first ? "\n" : ",\n") << "    \"" << event_type_names[type]
+                << "\": {\"read\": " << counters.read[type] << ", \"filtered\": " << counters.filtered[type]
+                << ", \"written\": " << counters.written[type] << '}';
+            first = false;
+        }
+    }
+
+    out << "\n  },\n  \"copied_locations\": " << m_copied_locations << ",\n  \"worker_readers\": " << m_worker_readers
+        << ",\n  \"shared_reader_fallbacks\": " << m_shared_readers << ",\n  \"filtered_files\": [";
+    for (std::size_t i = 0; i < m_filtered_files.size(); i++)
+    {
+        out << (i == 0 ? "\n    " : ",\n    ");
+        write_json_string(out, m_filtered_files[i]);
+    }
+    out << "\n  ]\n}\n";
+}
+
+PhaseTimer::PhaseTimer(TraceStats *stats, Phase phase) : m_stats(stats), m_phase(phase)
+{
+    if (m_stats != nullptr)
+    {
+        m_wall_start = seconds(CLOCK_MONOTONIC);
+        m_cpu_start  = seconds(CLOCK_THREAD_CPUTIME_ID);
+    }
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    if (m_stats != nullptr)
+    {
+        auto &stats = m_stats->thread_stats().phases[static_cast<std::size_t>(m_phase)];
+        stats.wall_time += seconds(CLOCK_MONOTONIC) - m_wall_start;
+        stats.cpu_time += seconds(CLOCK_THREAD_CPUTIME_ID) - m_cpu_start;
+        stats.peak_rss = std::max(stats.peak_rss, peak_rss());
+    }
+}
@@ -1,6 +1,21 @@
+#include <algorithm>
 #include <cassert>
+#include <file_copy.hpp>
+#include <iterator>
+#include <limits>
+#include <otf2_locking.hpp>
+#include <stdexcept>
+#include <string>
+#include <system_error>
 #include <trace_writer.hpp>
 
+namespace fs = std::filesystem;
+
+/*
+ * Rough size of an encoded event including its timestamp.
+ */
+constexpr uint64_t estimated_event_size = 16;
+
 OTF2_FlushType
 pre_flush(void *userData, OTF2_FileType fileType, OTF2_LocationRef location, void *callerData, bool final)
 {
@@ -9,6 +24,11 @@ pre_flush(void *userData, OTF2_FileType fileType, OTF2_LocationRef location, voi
 
 OTF2_FlushCallbacks TraceWriter::m_flush_callbacks = {.otf2_pre_flush = pre_flush, .otf2_post_flush = nullptr};
 
+thread_local TraceWriter::LocationEventWriter TraceWriter::m_thread_event_writer = {
+    .owner = nullptr, .location = OTF2_UNDEFINED_LOCATION, .writer = nullptr, .counters = nullptr};
+
+thread_local TraceWriter::LocationWindow TraceWriter::m_thread_window;
+
 void
 delete_event_writer(OTF2_EvtWriter *writer, OTF2_Archive *archive)
 {
@@ -27,16 +47,73 @@ delete_archive(OTF2_Archive *archive)
     }
 }
 
-TraceWriter::TraceWriter(const std::string &path) : m_archive(nullptr, delete_archive)
+uint64_t
+event_chunk_size(const std::vector<LocationWeight> &locations)
+{
+    uint64_t events = 0;
+    for (const auto &location : locations)
+    {
+        events += location.number_of_events;
+    }
+    if (locations.empty())
+    {
+        return TraceWriterOptions().event_chunk_size;
+    }
+
+    uint64_t bytes      = events / locations.size() * estimated_event_size;
+    uint64_t chunk_size = min_chunk_size;
+    while (chunk_size < bytes && chunk_size < max_chunk_size)
+    {
+        chunk_size *= 2;
+    }
+    return chunk_size;
+}
+
+std::size_t
+open_location_limit(const TraceWriterOptions &options)
+{
+    if (options.memory_limit == 0)
+    {
+        return 0;
+    }
+    /* the global definition writer holds a definition chunk as well */
+    uint64_t budget = options.memory_limit - std::min(options.memory_limit, options.definition_chunk_size);
+    return std::max<uint64_t>(1, budget / (options.event_chunk_size + options.definition_chunk_size));
+}
+
+TraceWriter::TraceWriter(const std::string &path, const TraceWriterOptions &options)
+    : m_archive(nullptr, delete_archive), m_options(options), m_directory(path + "/" + traceName())
 {
     auto *archive = OTF2_Archive_Open(path.c_str(),
                                       traceName(),
                                       OTF2_FILEMODE_WRITE,
-                                      1024 * 1024 /* event chunk size */,
-                                      4 * 1024 * 1024 /* def chunk size */,
+                                      options.event_chunk_size,
+                                      options.definition_chunk_size,
                                       OTF2_SUBSTRATE_POSIX,
-                                      OTF2_COMPRESSION_NONE);
+                                      options.compression);
+    if (archive == nullptr)
+    {
+        throw std::runtime_error("Could not create archive: " + path);
+    }
+    if (options.referenced_strings)
+    {
+        m_strings.set_mode(StringTable::Mode::Referenced);
+    }
+    if (options.memory_limit != 0)
+    {
+        /* buffers grow until the limit is reached */
+        m_memory_limited = true;
+        m_chunk_pool     = std::make_unique<ChunkPool>(
+            options.huge_pages, std::numeric_limits<std::size_t>::max(), options.memory_limit);
+        m_chunk_pool->install(archive);
+    }
+    else if (options.pool_chunks)
+    {
+        m_chunk_pool = std::make_unique<ChunkPool>(options.huge_pages);
+        m_chunk_pool->install(archive);
+    }
 
+    set_locking_callbacks(archive);
     OTF2_Archive_SetFlushCallbacks(archive, &m_flush_callbacks, nullptr);
     OTF2_Archive_SetSerialCollectiveCallbacks(archive);
     m_archive.reset(archive);
@@ -49,37 +126,59 @@ TraceWriter::TraceWriter(const std::string &path) : m_archive(nullptr, delete_ar
 
 TraceWriter::~TraceWriter()
 {
+    PhaseTimer timer(m_options.stats, Phase::Close);
     OTF2_Archive_CloseDefFiles(m_archive.get());
-    for (auto location : m_locations)
+    for (const auto &location : m_location_ordinals)
     {
-        OTF2_DefWriter *def_writer = OTF2_Archive_GetDefWriter(m_archive.get(), location);
+        if (m_local_definitions_closed[location.second])
+        {
+            continue;
+        }
+        OTF2_DefWriter *def_writer = OTF2_Archive_GetDefWriter(m_archive.get(), location.first);
         OTF2_Archive_CloseDefWriter(m_archive.get(), def_writer);
     }
     OTF2_Archive_CloseEvtFiles(m_archive.get());
+
+    /* closing the archive writes the remaining buffers */
+    m_archive.reset();
 }
 
 void
 TraceWriter::handleGlobalClockProperties(uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength)
 {
 
-    bool filter_out = m_global_ClockProperties_filter.process(timerResolution, globalOffset, traceLength);
-    if (!filter_out)
+    if (m_global_ClockProperties_filter.empty() ||
+        !m_global_ClockProperties_filter.process(timerResolution, globalOffset, traceLength))
     {
-        OTF2_GlobalDefWriter_WriteClockProperties(m_def_writer, timerResolution, globalOffset, traceLength);
+        writeGlobalClockProperties(timerResolution, globalOffset, traceLength);
     }
 }
 
+void
+TraceWriter::writeGlobalClockProperties(uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength)
+{
+    uint64_t end = std::min(globalOffset + traceLength, m_time_window.end);
+    globalOffset = std::max(globalOffset, m_time_window.begin);
+    traceLength  = end > globalOffset ? end - globalOffset : 0;
+    OTF2_GlobalDefWriter_WriteClockProperties(m_def_writer, timerResolution, globalOffset, traceLength);
+}
+
 void
 TraceWriter::handleGlobalParadigm(OTF2_Paradigm paradigm, OTF2_StringRef name, OTF2_ParadigmClass paradigmClass)
 {
 
-    bool filter_out = m_global_Paradigm_filter.process(paradigm, name, paradigmClass);
-    if (!filter_out)
+    if (m_global_Paradigm_filter.empty() || !m_global_Paradigm_filter.process(paradigm, name, paradigmClass))
     {
-        OTF2_GlobalDefWriter_WriteParadigm(m_def_writer, paradigm, name, paradigmClass);
+        writeGlobalParadigm(paradigm, name, paradigmClass);
     }
 }
 
+void
+TraceWriter::writeGlobalParadigm(OTF2_Paradigm paradigm, OTF2_StringRef name, OTF2_ParadigmClass paradigmClass)
+{
+    OTF2_GlobalDefWriter_WriteParadigm(m_def_writer, paradigm, name, paradigmClass);
+}
+
 void
 TraceWriter::handleGlobalParadigmProperty(OTF2_Paradigm         paradigm,
                                           OTF2_ParadigmProperty property,
@@ -87,13 +186,22 @@ TraceWriter::handleGlobalParadigmProperty(OTF2_Paradigm         paradigm,
                                           OTF2_AttributeValue   value)
 {
 
-    bool filter_out = m_global_ParadigmProperty_filter.process(paradigm, property, type, value);
-    if (!filter_out)
+    if (m_global_ParadigmProperty_filter.empty() ||
+        !m_global_ParadigmProperty_filter.process(paradigm, property, type, value))
     {
-        OTF2_GlobalDefWriter_WriteParadigmProperty(m_def_writer, paradigm, property, type, value);
+        writeGlobalParadigmProperty(paradigm, property, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalParadigmProperty(OTF2_Paradigm         paradigm,
+                                         OTF2_ParadigmProperty property,
+                                         OTF2_Type             type,
+                                         OTF2_AttributeValue   value)
+{
+    OTF2_GlobalDefWriter_WriteParadigmProperty(m_def_writer, paradigm, property, type, value);
+}
+
 void
 TraceWriter::handleGlobalIoParadigm(OTF2_IoParadigmRef             self,
                                     OTF2_StringRef                 identification,
@@ -106,34 +214,69 @@ TraceWriter::handleGlobalIoParadigm(OTF2_IoParadigmRef             self,
                                     const OTF2_AttributeValue *    values)
 {
 
-    bool filter_out = m_global_IoParadigm_filter.process(
-        self, identification, name, ioParadigmClass, ioParadigmFlags, numberOfProperties, properties, types, values);
-    if (!filter_out)
-    {
-        OTF2_GlobalDefWriter_WriteIoParadigm(m_def_writer,
-                                             self,
-                                             identification,
-                                             name,
-                                             ioParadigmClass,
-                                             ioParadigmFlags,
-                                             numberOfProperties,
-                                             properties,
-                                             types,
-                                             values);
-    }
+    if (m_global_IoParadigm_filter.empty() ||
+        !m_global_IoParadigm_filter.process(self,
+                                            identification,
+                                            name,
+                                            ioParadigmClass,
+                                            ioParadigmFlags,
+                                            numberOfProperties,
+                                            properties,
+                                            types,
+                                            values))
+    {
+        writeGlobalIoParadigm(self,
+                              identification,
+                              name,
+                              ioParadigmClass,
+                              ioParadigmFlags,
+                              numberOfProperties,
+                              properties,
+                              types,
+                              values);
+    }
+}
+
+void
+TraceWriter::writeGlobalIoParadigm(OTF2_IoParadigmRef             self,
+                                   OTF2_StringRef                 identification,
+                                   OTF2_StringRef                 name,
+                                   OTF2_IoParadigmClass           ioParadigmClass,
+                                   OTF2_IoParadigmFlag            ioParadigmFlags,
+                                   uint8_t                        numberOfProperties,
+                                   const OTF2_IoParadigmProperty *properties,
+                                   const OTF2_Type *              types,
+                                   const OTF2_AttributeValue *    values)
+{
+    OTF2_GlobalDefWriter_WriteIoParadigm(m_def_writer,
+                                         self,
+                                         identification,
+                                         name,
+                                         ioParadigmClass,
+                                         ioParadigmFlags,
+                                         numberOfProperties,
+                                         properties,
+                                         types,
+                                         values);
 }
 
 void
 TraceWriter::handleGlobalString(OTF2_StringRef self, const char *string)
 {
+    m_strings.add(self, string);
 
-    bool filter_out = m_global_String_filter.process(self, string);
-    if (!filter_out)
+    if (m_global_String_filter.empty() || !m_global_String_filter.process(self, string))
     {
-        OTF2_GlobalDefWriter_WriteString(m_def_writer, self, string);
+        writeGlobalString(self, string);
     }
 }
 
+void
+TraceWriter::writeGlobalString(OTF2_StringRef self, const char *string)
+{
+    OTF2_GlobalDefWriter_WriteString(m_def_writer, self, string);
+}
+
 void
 TraceWriter::handleGlobalAttribute(OTF2_AttributeRef self,
                                    OTF2_StringRef    name,
@@ -141,13 +284,21 @@ TraceWriter::handleGlobalAttribute(OTF2_AttributeRef self,
                                    OTF2_Type         type)
 {
 
-    bool filter_out = m_global_Attribute_filter.process(self, name, description, type);
-    if (!filter_out)
+    if (m_global_Attribute_filter.empty() || !m_global_Attribute_filter.process(self, name, description, type))
     {
-        OTF2_GlobalDefWriter_WriteAttribute(m_def_writer, self, name, description, type);
+        writeGlobalAttribute(self, name, description, type);
     }
 }
 
+void
+TraceWriter::writeGlobalAttribute(OTF2_AttributeRef self,
+                                  OTF2_StringRef    name,
+                                  OTF2_StringRef    description,
+                                  OTF2_Type         type)
+{
+    OTF2_GlobalDefWriter_WriteAttribute(m_def_writer, self, name, description, type);
+}
+
 void
 TraceWriter::handleGlobalSystemTreeNode(OTF2_SystemTreeNodeRef self,
                                         OTF2_StringRef         name,
@@ -155,13 +306,22 @@ TraceWriter::handleGlobalSystemTreeNode(OTF2_SystemTreeNodeRef self,
                                         OTF2_SystemTreeNodeRef parent)
 {
 
-    bool filter_out = m_global_SystemTreeNode_filter.process(self, name, className, parent);
-    if (!filter_out)
+    if (m_global_SystemTreeNode_filter.empty() ||
+        !m_global_SystemTreeNode_filter.process(self, name, className, parent))
     {
-        OTF2_GlobalDefWriter_WriteSystemTreeNode(m_def_writer, self, name, className, parent);
+        writeGlobalSystemTreeNode(self, name, className, parent);
     }
 }
 
+void
+TraceWriter::writeGlobalSystemTreeNode(OTF2_SystemTreeNodeRef self,
+                                       OTF2_StringRef         name,
+                                       OTF2_StringRef         className,
+                                       OTF2_SystemTreeNodeRef parent)
+{
+    OTF2_GlobalDefWriter_WriteSystemTreeNode(m_def_writer, self, name, className, parent);
+}
+
 void
 TraceWriter::handleGlobalLocationGroup(OTF2_LocationGroupRef  self,
                                        OTF2_StringRef         name,
@@ -169,13 +329,22 @@ TraceWriter::handleGlobalLocationGroup(OTF2_LocationGroupRef  self,
                                        OTF2_SystemTreeNodeRef systemTreeParent)
 {
 
-    bool filter_out = m_global_LocationGroup_filter.process(self, name, locationGroupType, systemTreeParent);
-    if (!filter_out)
+    if (m_global_LocationGroup_filter.empty() ||
+        !m_global_LocationGroup_filter.process(self, name, locationGroupType, systemTreeParent))
     {
-        OTF2_GlobalDefWriter_WriteLocationGroup(m_def_writer, self, name, locationGroupType, systemTreeParent);
+        writeGlobalLocationGroup(self, name, locationGroupType, systemTreeParent);
     }
 }
 
+void
+TraceWriter::writeGlobalLocationGroup(OTF2_LocationGroupRef  self,
+                                      OTF2_StringRef         name,
+                                      OTF2_LocationGroupType locationGroupType,
+                                      OTF2_SystemTreeNodeRef systemTreeParent)
+{
+    OTF2_GlobalDefWriter_WriteLocationGroup(m_def_writer, self, name, locationGroupType, systemTreeParent);
+}
+
 void
 TraceWriter::handleGlobalLocation(OTF2_LocationRef      self,
                                   OTF2_StringRef        name,
@@ -183,13 +352,25 @@ TraceWriter::handleGlobalLocation(OTF2_LocationRef      self,
                                   uint64_t              numberOfEvents,
                                   OTF2_LocationGroupRef locationGroup)
 {
-    m_locations.insert(self);
 
-    bool filter_out = m_global_Location_filter.process(self, name, locationType, numberOfEvents, locationGroup);
-    if (!filter_out)
+    if (!m_global_Location_filter.empty() &&
+        m_global_Location_filter.process(self, name, locationType, numberOfEvents, locationGroup))
     {
-        OTF2_GlobalDefWriter_WriteLocation(m_def_writer, self, name, locationType, numberOfEvents, locationGroup);
+        drop_location(self);
+        return;
     }
+    writeGlobalLocation(self, name, locationType, numberOfEvents, locationGroup);
+}
+
+void
+TraceWriter::writeGlobalLocation(OTF2_LocationRef      self,
+                                 OTF2_StringRef        name,
+                                 OTF2_LocationType     locationType,
+                                 uint64_t              numberOfEvents,
+                                 OTF2_LocationGroupRef locationGroup)
+{
+    add_location(self);
+    OTF2_GlobalDefWriter_WriteLocation(m_def_writer, self, name, locationType, numberOfEvents, locationGroup);
 }
 
 void
@@ -205,32 +386,56 @@ TraceWriter::handleGlobalRegion(OTF2_RegionRef  self,
                                 uint32_t        endLineNumber)
 {
 
-    bool filter_out = m_global_Region_filter.process(self,
-                                                     name,
-                                                     canonicalName,
-                                                     description,
-                                                     regionRole,
-                                                     paradigm,
-                                                     regionFlags,
-                                                     sourceFile,
-                                                     beginLineNumber,
-                                                     endLineNumber);
-    if (!filter_out)
+    if (m_global_Region_filter.empty() ||
+        !m_global_Region_filter.process(self,
+                                        name,
+                                        canonicalName,
+                                        description,
+                                        regionRole,
+                                        paradigm,
+                                        regionFlags,
+                                        sourceFile,
+                                        beginLineNumber,
+                                        endLineNumber))
     {
-        OTF2_GlobalDefWriter_WriteRegion(m_def_writer,
-                                         self,
-                                         name,
-                                         canonicalName,
-                                         description,
-                                         regionRole,
-                                         paradigm,
-                                         regionFlags,
-                                         sourceFile,
-                                         beginLineNumber,
-                                         endLineNumber);
+        writeGlobalRegion(self,
+                          name,
+                          canonicalName,
+                          description,
+                          regionRole,
+                          paradigm,
+                          regionFlags,
+                          sourceFile,
+                          beginLineNumber,
+                          endLineNumber);
     }
 }
 
+void
+TraceWriter::writeGlobalRegion(OTF2_RegionRef  self,
+                               OTF2_StringRef  name,
+                               OTF2_StringRef  canonicalName,
+                               OTF2_StringRef  description,
+                               OTF2_RegionRole regionRole,
+                               OTF2_Paradigm   paradigm,
+                               OTF2_RegionFlag regionFlags,
+                               OTF2_StringRef  sourceFile,
+                               uint32_t        beginLineNumber,
+                               uint32_t        endLineNumber)
+{
+    OTF2_GlobalDefWriter_WriteRegion(m_def_writer,
+                                     self,
+                                     name,
+                                     canonicalName,
+                                     description,
+                                     regionRole,
+                                     paradigm,
+                                     regionFlags,
+                                     sourceFile,
+                                     beginLineNumber,
+                                     endLineNumber);
+}
+
 void
 TraceWriter::handleGlobalCallsite(OTF2_CallsiteRef self,
                                   OTF2_StringRef   sourceFile,
@@ -239,24 +444,39 @@ TraceWriter::handleGlobalCallsite(OTF2_CallsiteRef self,
                                   OTF2_RegionRef   leftRegion)
 {
 
-    bool filter_out = m_global_Callsite_filter.process(self, sourceFile, lineNumber, enteredRegion, leftRegion);
-    if (!filter_out)
+    if (m_global_Callsite_filter.empty() ||
+        !m_global_Callsite_filter.process(self, sourceFile, lineNumber, enteredRegion, leftRegion))
     {
-        OTF2_GlobalDefWriter_WriteCallsite(m_def_writer, self, sourceFile, lineNumber, enteredRegion, leftRegion);
+        writeGlobalCallsite(self, sourceFile, lineNumber, enteredRegion, leftRegion);
     }
 }
 
+void
+TraceWriter::writeGlobalCallsite(OTF2_CallsiteRef self,
+                                 OTF2_StringRef   sourceFile,
+                                 uint32_t         lineNumber,
+                                 OTF2_RegionRef   enteredRegion,
+                                 OTF2_RegionRef   leftRegion)
+{
+    OTF2_GlobalDefWriter_WriteCallsite(m_def_writer, self, sourceFile, lineNumber, enteredRegion, leftRegion);
+}
+
 void
 TraceWriter::handleGlobalCallpath(OTF2_CallpathRef self, OTF2_CallpathRef parent, OTF2_RegionRef region)
 {
 
-    bool filter_out = m_global_Callpath_filter.process(self, parent, region);
-    if (!filter_out)
+    if (m_global_Callpath_filter.empty() || !m_global_Callpath_filter.process(self, parent, region))
     {
-        OTF2_GlobalDefWriter_WriteCallpath(m_def_writer, self, parent, region);
+        writeGlobalCallpath(self, parent, region);
     }
 }
 
+void
+TraceWriter::writeGlobalCallpath(OTF2_CallpathRef self, OTF2_CallpathRef parent, OTF2_RegionRef region)
+{
+    OTF2_GlobalDefWriter_WriteCallpath(m_def_writer, self, parent, region);
+}
+
 void
 TraceWriter::handleGlobalGroup(OTF2_GroupRef   self,
                                OTF2_StringRef  name,
@@ -267,15 +487,36 @@ TraceWriter::handleGlobalGroup(OTF2_GroupRef   self,
                                const uint64_t *members)
 {
 
-    bool filter_out =
-        m_global_Group_filter.process(self, name, groupType, paradigm, groupFlags, numberOfMembers, members);
-    if (!filter_out)
+    if (m_global_Group_filter.empty() ||
+        !m_global_Group_filter.process(self, name, groupType, paradigm, groupFlags, numberOfMembers, members))
     {
-        OTF2_GlobalDefWriter_WriteGroup(
-            m_def_writer, self, name, groupType, paradigm, groupFlags, numberOfMembers, members);
+        writeGlobalGroup(self, name, groupType, paradigm, groupFlags, numberOfMembers, members);
     }
 }
 
+void
+TraceWriter::writeGlobalGroup(OTF2_GroupRef   self,
+                              OTF2_StringRef  name,
+                              OTF2_GroupType  groupType,
+                              OTF2_Paradigm   paradigm,
+                              OTF2_GroupFlag  groupFlags,
+                              uint32_t        numberOfMembers,
+                              const uint64_t *members)
+{
+    std::vector<uint64_t> selected_members;
+    if (groupType == OTF2_GROUP_TYPE_LOCATIONS && !m_dropped_locations.empty())
+    {
+        std::copy_if(members,
+                     members + numberOfMembers,
+                     std::back_inserter(selected_members),
+                     [this](uint64_t member) { return m_dropped_locations.count(member) == 0; });
+        numberOfMembers = selected_members.size();
+        members         = selected_members.data();
+    }
+    OTF2_GlobalDefWriter_WriteGroup(
+        m_def_writer, self, name, groupType, paradigm, groupFlags, numberOfMembers, members);
+}
+
 void
 TraceWriter::handleGlobalMetricMember(OTF2_MetricMemberRef self,
                                       OTF2_StringRef       name,
@@ -288,15 +529,36 @@ TraceWriter::handleGlobalMetricMember(OTF2_MetricMemberRef self,
                                       OTF2_StringRef       unit)
 {
 
-    bool filter_out = m_global_MetricMember_filter.process(
-        self, name, description, metricType, metricMode, valueType, base, exponent, unit);
-    if (!filter_out)
+    if (m_global_MetricMember_filter.empty() ||
+        !m_global_MetricMember_filter.process(self,
+                                              name,
+                                              description,
+                                              metricType,
+                                              metricMode,
+                                              valueType,
+                                              base,
+                                              exponent,
+                                              unit))
     {
-        OTF2_GlobalDefWriter_WriteMetricMember(
-            m_def_writer, self, name, description, metricType, metricMode, valueType, base, exponent, unit);
+        writeGlobalMetricMember(self, name, description, metricType, metricMode, valueType, base, exponent, unit);
     }
 }
 
+void
+TraceWriter::writeGlobalMetricMember(OTF2_MetricMemberRef self,
+                                     OTF2_StringRef       name,
+                                     OTF2_StringRef       description,
+                                     OTF2_MetricType      metricType,
+                                     OTF2_MetricMode      metricMode,
+                                     OTF2_Type            valueType,
+                                     OTF2_Base            base,
+                                     int64_t              exponent,
+                                     OTF2_StringRef       unit)
+{
+    OTF2_GlobalDefWriter_WriteMetricMember(
+        m_def_writer, self, name, description, metricType, metricMode, valueType, base, exponent, unit);
+}
+
 void
 TraceWriter::handleGlobalMetricClass(OTF2_MetricRef              self,
                                      uint8_t                     numberOfMetrics,
@@ -305,15 +567,24 @@ TraceWriter::handleGlobalMetricClass(OTF2_MetricRef              self,
                                      OTF2_RecorderKind           recorderKind)
 {
 
-    bool filter_out =
-        m_global_MetricClass_filter.process(self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind);
-    if (!filter_out)
+    if (m_global_MetricClass_filter.empty() ||
+        !m_global_MetricClass_filter.process(self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind))
     {
-        OTF2_GlobalDefWriter_WriteMetricClass(
-            m_def_writer, self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind);
+        writeGlobalMetricClass(self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind);
     }
 }
 
+void
+TraceWriter::writeGlobalMetricClass(OTF2_MetricRef              self,
+                                    uint8_t                     numberOfMetrics,
+                                    const OTF2_MetricMemberRef *metricMembers,
+                                    OTF2_MetricOccurrence       metricOccurrence,
+                                    OTF2_RecorderKind           recorderKind)
+{
+    OTF2_GlobalDefWriter_WriteMetricClass(
+        m_def_writer, self, numberOfMetrics, metricMembers, metricOccurrence, recorderKind);
+}
+
 void
 TraceWriter::handleGlobalMetricInstance(OTF2_MetricRef   self,
                                         OTF2_MetricRef   metricClass,
@@ -322,55 +593,94 @@ TraceWriter::handleGlobalMetricInstance(OTF2_MetricRef   self,
                                         uint64_t         scope)
 {
 
-    bool filter_out = m_global_MetricInstance_filter.process(self, metricClass, recorder, metricScope, scope);
-    if (!filter_out)
+    if (m_global_MetricInstance_filter.empty() ||
+        !m_global_MetricInstance_filter.process(self, metricClass, recorder, metricScope, scope))
     {
-        OTF2_GlobalDefWriter_WriteMetricInstance(m_def_writer, self, metricClass, recorder, metricScope, scope);
+        writeGlobalMetricInstance(self, metricClass, recorder, metricScope, scope);
     }
 }
 
+void
+TraceWriter::writeGlobalMetricInstance(OTF2_MetricRef   self,
+                                       OTF2_MetricRef   metricClass,
+                                       OTF2_LocationRef recorder,
+                                       OTF2_MetricScope metricScope,
+                                       uint64_t         scope)
+{
+    if (m_dropped_locations.count(recorder) != 0 ||
+        (metricScope == OTF2_SCOPE_LOCATION && m_dropped_locations.count(scope) != 0))
+    {
+        return;
+    }
+    OTF2_GlobalDefWriter_WriteMetricInstance(m_def_writer, self, metricClass, recorder, metricScope, scope);
+}
+
 void
 TraceWriter::handleGlobalComm(OTF2_CommRef self, OTF2_StringRef name, OTF2_GroupRef group, OTF2_CommRef parent)
 {
 
-    bool filter_out = m_global_Comm_filter.process(self, name, group, parent);
-    if (!filter_out)
+    if (m_global_Comm_filter.empty() || !m_global_Comm_filter.process(self, name, group, parent))
     {
-        OTF2_GlobalDefWriter_WriteComm(m_def_writer, self, name, group, parent);
+        writeGlobalComm(self, name, group, parent);
     }
 }
 
+void
+TraceWriter::writeGlobalComm(OTF2_CommRef self, OTF2_StringRef name, OTF2_GroupRef group, OTF2_CommRef parent)
+{
+    OTF2_GlobalDefWriter_WriteComm(m_def_writer, self, name, group, parent);
+}
+
 void
 TraceWriter::handleGlobalParameter(OTF2_ParameterRef self, OTF2_StringRef name, OTF2_ParameterType parameterType)
 {
 
-    bool filter_out = m_global_Parameter_filter.process(self, name, parameterType);
-    if (!filter_out)
+    if (m_global_Parameter_filter.empty() || !m_global_Parameter_filter.process(self, name, parameterType))
     {
-        OTF2_GlobalDefWriter_WriteParameter(m_def_writer, self, name, parameterType);
+        writeGlobalParameter(self, name, parameterType);
     }
 }
 
+void
+TraceWriter::writeGlobalParameter(OTF2_ParameterRef self, OTF2_StringRef name, OTF2_ParameterType parameterType)
+{
+    OTF2_GlobalDefWriter_WriteParameter(m_def_writer, self, name, parameterType);
+}
+
 void
 TraceWriter::handleGlobalRmaWin(OTF2_RmaWinRef self, OTF2_StringRef name, OTF2_CommRef comm)
 {
 
-    bool filter_out = m_global_RmaWin_filter.process(self, name, comm);
-    if (!filter_out)
+    if (m_global_RmaWin_filter.empty() || !m_global_RmaWin_filter.process(self, name, comm))
     {
-        OTF2_GlobalDefWriter_WriteRmaWin(m_def_writer, self, name, comm);
+        writeGlobalRmaWin(self, name, comm);
     }
 }
 
+void
+TraceWriter::writeGlobalRmaWin(OTF2_RmaWinRef self, OTF2_StringRef name, OTF2_CommRef comm)
+{
+    OTF2_GlobalDefWriter_WriteRmaWin(m_def_writer, self, name, comm);
+}
+
 void
 TraceWriter::handleGlobalMetricClassRecorder(OTF2_MetricRef metric, OTF2_LocationRef recorder)
 {
 
-    bool filter_out = m_global_MetricClassRecorder_filter.process(metric, recorder);
-    if (!filter_out)
+    if (m_global_MetricClassRecorder_filter.empty() || !m_global_MetricClassRecorder_filter.process(metric, recorder))
+    {
+        writeGlobalMetricClassRecorder(metric, recorder);
+    }
+}
+
+void
+TraceWriter::writeGlobalMetricClassRecorder(OTF2_MetricRef metric, OTF2_LocationRef recorder)
+{
+    if (m_dropped_locations.count(recorder) != 0)
     {
-        OTF2_GlobalDefWriter_WriteMetricClassRecorder(m_def_writer, metric, recorder);
+        return;
     }
+    OTF2_GlobalDefWriter_WriteMetricClassRecorder(m_def_writer, metric, recorder);
 }
 
 void
@@ -380,25 +690,41 @@ TraceWriter::handleGlobalSystemTreeNodeProperty(OTF2_SystemTreeNodeRef systemTre
                                                 OTF2_AttributeValue    value)
 {
 
-    bool filter_out = m_global_SystemTreeNodeProperty_filter.process(systemTreeNode, name, type, value);
-    if (!filter_out)
+    if (m_global_SystemTreeNodeProperty_filter.empty() ||
+        !m_global_SystemTreeNodeProperty_filter.process(systemTreeNode, name, type, value))
     {
-        OTF2_GlobalDefWriter_WriteSystemTreeNodeProperty(m_def_writer, systemTreeNode, name, type, value);
+        writeGlobalSystemTreeNodeProperty(systemTreeNode, name, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalSystemTreeNodeProperty(OTF2_SystemTreeNodeRef systemTreeNode,
+                                               OTF2_StringRef         name,
+                                               OTF2_Type              type,
+                                               OTF2_AttributeValue    value)
+{
+    OTF2_GlobalDefWriter_WriteSystemTreeNodeProperty(m_def_writer, systemTreeNode, name, type, value);
+}
+
 void
 TraceWriter::handleGlobalSystemTreeNodeDomain(OTF2_SystemTreeNodeRef systemTreeNode,
                                               OTF2_SystemTreeDomain  systemTreeDomain)
 {
 
-    bool filter_out = m_global_SystemTreeNodeDomain_filter.process(systemTreeNode, systemTreeDomain);
-    if (!filter_out)
+    if (m_global_SystemTreeNodeDomain_filter.empty() ||
+        !m_global_SystemTreeNodeDomain_filter.process(systemTreeNode, systemTreeDomain))
     {
-        OTF2_GlobalDefWriter_WriteSystemTreeNodeDomain(m_def_writer, systemTreeNode, systemTreeDomain);
+        writeGlobalSystemTreeNodeDomain(systemTreeNode, systemTreeDomain);
     }
 }
 
+void
+TraceWriter::writeGlobalSystemTreeNodeDomain(OTF2_SystemTreeNodeRef systemTreeNode,
+                                             OTF2_SystemTreeDomain  systemTreeDomain)
+{
+    OTF2_GlobalDefWriter_WriteSystemTreeNodeDomain(m_def_writer, systemTreeNode, systemTreeDomain);
+}
+
 void
 TraceWriter::handleGlobalLocationGroupProperty(OTF2_LocationGroupRef locationGroup,
                                                OTF2_StringRef        name,
@@ -406,13 +732,22 @@ TraceWriter::handleGlobalLocationGroupProperty(OTF2_LocationGroupRef locationGro
                                                OTF2_AttributeValue   value)
 {
 
-    bool filter_out = m_global_LocationGroupProperty_filter.process(locationGroup, name, type, value);
-    if (!filter_out)
+    if (m_global_LocationGroupProperty_filter.empty() ||
+        !m_global_LocationGroupProperty_filter.process(locationGroup, name, type, value))
     {
-        OTF2_GlobalDefWriter_WriteLocationGroupProperty(m_def_writer, locationGroup, name, type, value);
+        writeGlobalLocationGroupProperty(locationGroup, name, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalLocationGroupProperty(OTF2_LocationGroupRef locationGroup,
+                                              OTF2_StringRef        name,
+                                              OTF2_Type             type,
+                                              OTF2_AttributeValue   value)
+{
+    OTF2_GlobalDefWriter_WriteLocationGroupProperty(m_def_writer, locationGroup, name, type, value);
+}
+
 void
 TraceWriter::handleGlobalLocationProperty(OTF2_LocationRef    location,
                                           OTF2_StringRef      name,
@@ -420,13 +755,22 @@ TraceWriter::handleGlobalLocationProperty(OTF2_LocationRef    location,
                                           OTF2_AttributeValue value)
 {
 
-    bool filter_out = m_global_LocationProperty_filter.process(location, name, type, value);
-    if (!filter_out)
+    if (m_global_LocationProperty_filter.empty() ||
+        !m_global_LocationProperty_filter.process(location, name, type, value))
     {
-        OTF2_GlobalDefWriter_WriteLocationProperty(m_def_writer, location, name, type, value);
+        writeGlobalLocationProperty(location, name, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalLocationProperty(OTF2_LocationRef    location,
+                                         OTF2_StringRef      name,
+                                         OTF2_Type           type,
+                                         OTF2_AttributeValue value)
+{
+    OTF2_GlobalDefWriter_WriteLocationProperty(m_def_writer, location, name, type, value);
+}
+
 void
 TraceWriter::handleGlobalCartDimension(OTF2_CartDimensionRef self,
                                        OTF2_StringRef        name,
@@ -434,13 +778,22 @@ TraceWriter::handleGlobalCartDimension(OTF2_CartDimensionRef self,
                                        OTF2_CartPeriodicity  cartPeriodicity)
 {
 
-    bool filter_out = m_global_CartDimension_filter.process(self, name, size, cartPeriodicity);
-    if (!filter_out)
+    if (m_global_CartDimension_filter.empty() ||
+        !m_global_CartDimension_filter.process(self, name, size, cartPeriodicity))
     {
-        OTF2_GlobalDefWriter_WriteCartDimension(m_def_writer, self, name, size, cartPeriodicity);
+        writeGlobalCartDimension(self, name, size, cartPeriodicity);
     }
 }
 
+void
+TraceWriter::writeGlobalCartDimension(OTF2_CartDimensionRef self,
+                                      OTF2_StringRef        name,
+                                      uint32_t              size,
+                                      OTF2_CartPeriodicity  cartPeriodicity)
+{
+    OTF2_GlobalDefWriter_WriteCartDimension(m_def_writer, self, name, size, cartPeriodicity);
+}
+
 void
 TraceWriter::handleGlobalCartTopology(OTF2_CartTopologyRef         self,
                                       OTF2_StringRef               name,
@@ -449,15 +802,23 @@ TraceWriter::handleGlobalCartTopology(OTF2_CartTopologyRef         self,
                                       const OTF2_CartDimensionRef *cartDimensions)
 {
 
-    bool filter_out =
-        m_global_CartTopology_filter.process(self, name, communicator, numberOfDimensions, cartDimensions);
-    if (!filter_out)
+    if (m_global_CartTopology_filter.empty() ||
+        !m_global_CartTopology_filter.process(self, name, communicator, numberOfDimensions, cartDimensions))
     {
-        OTF2_GlobalDefWriter_WriteCartTopology(
-            m_def_writer, self, name, communicator, numberOfDimensions, cartDimensions);
+        writeGlobalCartTopology(self, name, communicator, numberOfDimensions, cartDimensions);
     }
 }
 
+void
+TraceWriter::writeGlobalCartTopology(OTF2_CartTopologyRef         self,
+                                     OTF2_StringRef               name,
+                                     OTF2_CommRef                 communicator,
+                                     uint8_t                      numberOfDimensions,
+                                     const OTF2_CartDimensionRef *cartDimensions)
+{
+    OTF2_GlobalDefWriter_WriteCartTopology(m_def_writer, self, name, communicator, numberOfDimensions, cartDimensions);
+}
+
 void
 TraceWriter::handleGlobalCartCoordinate(OTF2_CartTopologyRef cartTopology,
                                         uint32_t             rank,
@@ -465,24 +826,39 @@ TraceWriter::handleGlobalCartCoordinate(OTF2_CartTopologyRef cartTopology,
                                         const uint32_t *     coordinates)
 {
 
-    bool filter_out = m_global_CartCoordinate_filter.process(cartTopology, rank, numberOfDimensions, coordinates);
-    if (!filter_out)
+    if (m_global_CartCoordinate_filter.empty() ||
+        !m_global_CartCoordinate_filter.process(cartTopology, rank, numberOfDimensions, coordinates))
     {
-        OTF2_GlobalDefWriter_WriteCartCoordinate(m_def_writer, cartTopology, rank, numberOfDimensions, coordinates);
+        writeGlobalCartCoordinate(cartTopology, rank, numberOfDimensions, coordinates);
     }
 }
 
+void
+TraceWriter::writeGlobalCartCoordinate(OTF2_CartTopologyRef cartTopology,
+                                       uint32_t             rank,
+                                       uint8_t              numberOfDimensions,
+                                       const uint32_t *     coordinates)
+{
+    OTF2_GlobalDefWriter_WriteCartCoordinate(m_def_writer, cartTopology, rank, numberOfDimensions, coordinates);
+}
+
 void
 TraceWriter::handleGlobalSourceCodeLocation(OTF2_SourceCodeLocationRef self, OTF2_StringRef file, uint32_t lineNumber)
 {
 
-    bool filter_out = m_global_SourceCodeLocation_filter.process(self, file, lineNumber);
-    if (!filter_out)
+    if (m_global_SourceCodeLocation_filter.empty() ||
+        !m_global_SourceCodeLocation_filter.process(self, file, lineNumber))
     {
-        OTF2_GlobalDefWriter_WriteSourceCodeLocation(m_def_writer, self, file, lineNumber);
+        writeGlobalSourceCodeLocation(self, file, lineNumber);
     }
 }
 
+void
+TraceWriter::writeGlobalSourceCodeLocation(OTF2_SourceCodeLocationRef self, OTF2_StringRef file, uint32_t lineNumber)
+{
+    OTF2_GlobalDefWriter_WriteSourceCodeLocation(m_def_writer, self, file, lineNumber);
+}
+
 void
 TraceWriter::handleGlobalCallingContext(OTF2_CallingContextRef     self,
                                         OTF2_RegionRef             region,
@@ -490,13 +866,22 @@ TraceWriter::handleGlobalCallingContext(OTF2_CallingContextRef     self,
                                         OTF2_CallingContextRef     parent)
 {
 
-    bool filter_out = m_global_CallingContext_filter.process(self, region, sourceCodeLocation, parent);
-    if (!filter_out)
+    if (m_global_CallingContext_filter.empty() ||
+        !m_global_CallingContext_filter.process(self, region, sourceCodeLocation, parent))
     {
-        OTF2_GlobalDefWriter_WriteCallingContext(m_def_writer, self, region, sourceCodeLocation, parent);
+        writeGlobalCallingContext(self, region, sourceCodeLocation, parent);
     }
 }
 
+void
+TraceWriter::writeGlobalCallingContext(OTF2_CallingContextRef     self,
+                                       OTF2_RegionRef             region,
+                                       OTF2_SourceCodeLocationRef sourceCodeLocation,
+                                       OTF2_CallingContextRef     parent)
+{
+    OTF2_GlobalDefWriter_WriteCallingContext(m_def_writer, self, region, sourceCodeLocation, parent);
+}
+
 void
 TraceWriter::handleGlobalCallingContextProperty(OTF2_CallingContextRef callingContext,
                                                 OTF2_StringRef         name,
@@ -504,13 +889,22 @@ TraceWriter::handleGlobalCallingContextProperty(OTF2_CallingContextRef callingCo
                                                 OTF2_AttributeValue    value)
 {
 
-    bool filter_out = m_global_CallingContextProperty_filter.process(callingContext, name, type, value);
-    if (!filter_out)
+    if (m_global_CallingContextProperty_filter.empty() ||
+        !m_global_CallingContextProperty_filter.process(callingContext, name, type, value))
     {
-        OTF2_GlobalDefWriter_WriteCallingContextProperty(m_def_writer, callingContext, name, type, value);
+        writeGlobalCallingContextProperty(callingContext, name, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalCallingContextProperty(OTF2_CallingContextRef callingContext,
+                                               OTF2_StringRef         name,
+                                               OTF2_Type              type,
+                                               OTF2_AttributeValue    value)
+{
+    OTF2_GlobalDefWriter_WriteCallingContextProperty(m_def_writer, callingContext, name, type, value);
+}
+
 void
 TraceWriter::handleGlobalInterruptGenerator(OTF2_InterruptGeneratorRef  self,
                                             OTF2_StringRef              name,
@@ -520,15 +914,25 @@ TraceWriter::handleGlobalInterruptGenerator(OTF2_InterruptGeneratorRef  self,
                                             uint64_t                    period)
 {
 
-    bool filter_out =
-        m_global_InterruptGenerator_filter.process(self, name, interruptGeneratorMode, base, exponent, period);
-    if (!filter_out)
+    if (m_global_InterruptGenerator_filter.empty() ||
+        !m_global_InterruptGenerator_filter.process(self, name, interruptGeneratorMode, base, exponent, period))
     {
-        OTF2_GlobalDefWriter_WriteInterruptGenerator(
-            m_def_writer, self, name, interruptGeneratorMode, base, exponent, period);
+        writeGlobalInterruptGenerator(self, name, interruptGeneratorMode, base, exponent, period);
     }
 }
 
+void
+TraceWriter::writeGlobalInterruptGenerator(OTF2_InterruptGeneratorRef  self,
+                                           OTF2_StringRef              name,
+                                           OTF2_InterruptGeneratorMode interruptGeneratorMode,
+                                           OTF2_Base                   base,
+                                           int64_t                     exponent,
+                                           uint64_t                    period)
+{
+    OTF2_GlobalDefWriter_WriteInterruptGenerator(
+        m_def_writer, self, name, interruptGeneratorMode, base, exponent, period);
+}
+
 void
 TraceWriter::handleGlobalIoFileProperty(OTF2_IoFileRef      ioFile,
                                         OTF2_StringRef      name,
@@ -536,35 +940,53 @@ TraceWriter::handleGlobalIoFileProperty(OTF2_IoFileRef      ioFile,
                                         OTF2_AttributeValue value)
 {
 
-    bool filter_out = m_global_IoFileProperty_filter.process(ioFile, name, type, value);
-    if (!filter_out)
+    if (m_global_IoFileProperty_filter.empty() || !m_global_IoFileProperty_filter.process(ioFile, name, type, value))
     {
-        OTF2_GlobalDefWriter_WriteIoFileProperty(m_def_writer, ioFile, name, type, value);
+        writeGlobalIoFileProperty(ioFile, name, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalIoFileProperty(OTF2_IoFileRef      ioFile,
+                                       OTF2_StringRef      name,
+                                       OTF2_Type           type,
+                                       OTF2_AttributeValue value)
+{
+    OTF2_GlobalDefWriter_WriteIoFileProperty(m_def_writer, ioFile, name, type, value);
+}
+
 void
 TraceWriter::handleGlobalIoRegularFile(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope)
 {
 
-    bool filter_out = m_global_IoRegularFile_filter.process(self, name, scope);
-    if (!filter_out)
+    if (m_global_IoRegularFile_filter.empty() || !m_global_IoRegularFile_filter.process(self, name, scope))
     {
-        OTF2_GlobalDefWriter_WriteIoRegularFile(m_def_writer, self, name, scope);
+        writeGlobalIoRegularFile(self, name, scope);
     }
 }
 
+void
+TraceWriter::writeGlobalIoRegularFile(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope)
+{
+    OTF2_GlobalDefWriter_WriteIoRegularFile(m_def_writer, self, name, scope);
+}
+
 void
 TraceWriter::handleGlobalIoDirectory(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope)
 {
 
-    bool filter_out = m_global_IoDirectory_filter.process(self, name, scope);
-    if (!filter_out)
+    if (m_global_IoDirectory_filter.empty() || !m_global_IoDirectory_filter.process(self, name, scope))
     {
-        OTF2_GlobalDefWriter_WriteIoDirectory(m_def_writer, self, name, scope);
+        writeGlobalIoDirectory(self, name, scope);
     }
 }
 
+void
+TraceWriter::writeGlobalIoDirectory(OTF2_IoFileRef self, OTF2_StringRef name, OTF2_SystemTreeNodeRef scope)
+{
+    OTF2_GlobalDefWriter_WriteIoDirectory(m_def_writer, self, name, scope);
+}
+
 void
 TraceWriter::handleGlobalIoHandle(OTF2_IoHandleRef   self,
                                   OTF2_StringRef     name,
@@ -575,26 +997,46 @@ TraceWriter::handleGlobalIoHandle(OTF2_IoHandleRef   self,
                                   OTF2_IoHandleRef   parent)
 {
 
-    bool filter_out = m_global_IoHandle_filter.process(self, name, file, ioParadigm, ioHandleFlags, comm, parent);
-    if (!filter_out)
+    if (m_global_IoHandle_filter.empty() ||
+        !m_global_IoHandle_filter.process(self, name, file, ioParadigm, ioHandleFlags, comm, parent))
     {
-        OTF2_GlobalDefWriter_WriteIoHandle(m_def_writer, self, name, file, ioParadigm, ioHandleFlags, comm, parent);
+        writeGlobalIoHandle(self, name, file, ioParadigm, ioHandleFlags, comm, parent);
     }
 }
 
+void
+TraceWriter::writeGlobalIoHandle(OTF2_IoHandleRef   self,
+                                 OTF2_StringRef     name,
+                                 OTF2_IoFileRef     file,
+                                 OTF2_IoParadigmRef ioParadigm,
+                                 OTF2_IoHandleFlag  ioHandleFlags,
+                                 OTF2_CommRef       comm,
+                                 OTF2_IoHandleRef   parent)
+{
+    OTF2_GlobalDefWriter_WriteIoHandle(m_def_writer, self, name, file, ioParadigm, ioHandleFlags, comm, parent);
+}
+
 void
 TraceWriter::handleGlobalIoPreCreatedHandleState(OTF2_IoHandleRef  ioHandle,
                                                  OTF2_IoAccessMode mode,
                                                  OTF2_IoStatusFlag statusFlags)
 {
 
-    bool filter_out = m_global_IoPreCreatedHandleState_filter.process(ioHandle, mode, statusFlags);
-    if (!filter_out)
+    if (m_global_IoPreCreatedHandleState_filter.empty() ||
+        !m_global_IoPreCreatedHandleState_filter.process(ioHandle, mode, statusFlags))
     {
-        OTF2_GlobalDefWriter_WriteIoPreCreatedHandleState(m_def_writer, ioHandle, mode, statusFlags);
+        writeGlobalIoPreCreatedHandleState(ioHandle, mode, statusFlags);
     }
 }
 
+void
+TraceWriter::writeGlobalIoPreCreatedHandleState(OTF2_IoHandleRef  ioHandle,
+                                                OTF2_IoAccessMode mode,
+                                                OTF2_IoStatusFlag statusFlags)
+{
+    OTF2_GlobalDefWriter_WriteIoPreCreatedHandleState(m_def_writer, ioHandle, mode, statusFlags);
+}
+
 void
 TraceWriter::handleGlobalCallpathParameter(OTF2_CallpathRef    callpath,
                                            OTF2_ParameterRef   parameter,
@@ -602,13 +1044,22 @@ TraceWriter::handleGlobalCallpathParameter(OTF2_CallpathRef    callpath,
                                            OTF2_AttributeValue value)
 {
 
-    bool filter_out = m_global_CallpathParameter_filter.process(callpath, parameter, type, value);
-    if (!filter_out)
+    if (m_global_CallpathParameter_filter.empty() ||
+        !m_global_CallpathParameter_filter.process(callpath, parameter, type, value))
     {
-        OTF2_GlobalDefWriter_WriteCallpathParameter(m_def_writer, callpath, parameter, type, value);
+        writeGlobalCallpathParameter(callpath, parameter, type, value);
     }
 }
 
+void
+TraceWriter::writeGlobalCallpathParameter(OTF2_CallpathRef    callpath,
+                                          OTF2_ParameterRef   parameter,
+                                          OTF2_Type           type,
+                                          OTF2_AttributeValue value)
+{
+    OTF2_GlobalDefWriter_WriteCallpathParameter(m_def_writer, callpath, parameter, type, value);
+}
+
 void
 TraceWriter::handleLocalMappingTable(OTF2_LocationRef  readLocation,
                                      OTF2_MappingType  mappingType,
@@ -629,1631 +1080,1969 @@ TraceWriter::handleLocalClockOffset(OTF2_LocationRef readLocation,
 }
 
 void
-TraceWriter::handleBufferFlushEvent(OTF2_LocationRef    location,
-                                    OTF2_TimeStamp      time,
-                                    OTF2_AttributeList *attributes,
-                                    OTF2_TimeStamp      stopTime)
+TraceWriter::writeBufferFlushEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_TimeStamp      stopTime)
 {
-    bool filter_out = m_event_BufferFlush_filter.process(location, time, attributes, stopTime);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_BufferFlush(event_writer, attributes, time, stopTime);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_BufferFlush(event_writer, attributes, time, stopTime);
+    count_written(EventType::BufferFlush);
 }
 
 void
-TraceWriter::handleMeasurementOnOffEvent(OTF2_LocationRef     location,
-                                         OTF2_TimeStamp       time,
-                                         OTF2_AttributeList * attributes,
-                                         OTF2_MeasurementMode measurementMode)
+TraceWriter::writeMeasurementOnOffEvent(OTF2_LocationRef     location,
+                                        OTF2_TimeStamp       time,
+                                        OTF2_AttributeList * attributes,
+                                        OTF2_MeasurementMode measurementMode)
 {
-    bool filter_out = m_event_MeasurementOnOff_filter.process(location, time, attributes, measurementMode);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MeasurementOnOff(event_writer, attributes, time, measurementMode);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MeasurementOnOff(event_writer, attributes, time, measurementMode);
+    count_written(EventType::MeasurementOnOff);
 }
 
 void
-TraceWriter::handleEnterEvent(OTF2_LocationRef    location,
-                              OTF2_TimeStamp      time,
-                              OTF2_AttributeList *attributes,
-                              OTF2_RegionRef      region)
+TraceWriter::writeEnterEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RegionRef      region)
 {
-    bool filter_out = m_event_Enter_filter.process(location, time, attributes, region);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_Enter(event_writer, attributes, time, region);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_Enter(event_writer, attributes, time, region);
+    count_written(EventType::Enter);
 }
 
 void
-TraceWriter::handleLeaveEvent(OTF2_LocationRef    location,
-                              OTF2_TimeStamp      time,
-                              OTF2_AttributeList *attributes,
-                              OTF2_RegionRef      region)
+TraceWriter::writeLeaveEvent(OTF2_LocationRef    location,
+                             OTF2_TimeStamp      time,
+                             OTF2_AttributeList *attributes,
+                             OTF2_RegionRef      region)
 {
-    bool filter_out = m_event_Leave_filter.process(location, time, attributes, region);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_Leave(event_writer, attributes, time, region);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_Leave(event_writer, attributes, time, region);
+    count_written(EventType::Leave);
 }
 
 void
-TraceWriter::handleMpiSendEvent(OTF2_LocationRef    location,
+TraceWriter::writeMpiSendEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint32_t            receiver,
+                               OTF2_CommRef        communicator,
+                               uint32_t            msgTag,
+                               uint64_t            msgLength)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiSend(event_writer, attributes, time, receiver, communicator, msgTag, msgLength);
+    count_written(EventType::MpiSend);
+}
+
+void
+TraceWriter::writeMpiIsendEvent(OTF2_LocationRef    location,
                                 OTF2_TimeStamp      time,
                                 OTF2_AttributeList *attributes,
                                 uint32_t            receiver,
                                 OTF2_CommRef        communicator,
                                 uint32_t            msgTag,
-                                uint64_t            msgLength)
+                                uint64_t            msgLength,
+                                uint64_t            requestID)
 {
-    bool filter_out =
-        m_event_MpiSend_filter.process(location, time, attributes, receiver, communicator, msgTag, msgLength);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiSend(event_writer, attributes, time, receiver, communicator, msgTag, msgLength);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiIsend(event_writer, attributes, time, receiver, communicator, msgTag, msgLength, requestID);
+    count_written(EventType::MpiIsend);
 }
 
 void
-TraceWriter::handleMpiIsendEvent(OTF2_LocationRef    location,
-                                 OTF2_TimeStamp      time,
-                                 OTF2_AttributeList *attributes,
-                                 uint32_t            receiver,
-                                 OTF2_CommRef        communicator,
-                                 uint32_t            msgTag,
-                                 uint64_t            msgLength,
-                                 uint64_t            requestID)
+TraceWriter::writeMpiIsendCompleteEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        uint64_t            requestID)
 {
-    bool filter_out = m_event_MpiIsend_filter.process(
-        location, time, attributes, receiver, communicator, msgTag, msgLength, requestID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiIsend(event_writer, attributes, time, receiver, communicator, msgTag, msgLength, requestID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiIsendComplete(event_writer, attributes, time, requestID);
+    count_written(EventType::MpiIsendComplete);
 }
 
 void
-TraceWriter::handleMpiIsendCompleteEvent(OTF2_LocationRef    location,
-                                         OTF2_TimeStamp      time,
-                                         OTF2_AttributeList *attributes,
-                                         uint64_t            requestID)
+TraceWriter::writeMpiIrecvRequestEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       uint64_t            requestID)
 {
-    bool filter_out = m_event_MpiIsendComplete_filter.process(location, time, attributes, requestID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiIsendComplete(event_writer, attributes, time, requestID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiIrecvRequest(event_writer, attributes, time, requestID);
+    count_written(EventType::MpiIrecvRequest);
 }
 
 void
-TraceWriter::handleMpiIrecvRequestEvent(OTF2_LocationRef    location,
-                                        OTF2_TimeStamp      time,
-                                        OTF2_AttributeList *attributes,
-                                        uint64_t            requestID)
+TraceWriter::writeMpiRecvEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint32_t            sender,
+                               OTF2_CommRef        communicator,
+                               uint32_t            msgTag,
+                               uint64_t            msgLength)
 {
-    bool filter_out = m_event_MpiIrecvRequest_filter.process(location, time, attributes, requestID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiIrecvRequest(event_writer, attributes, time, requestID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiRecv(event_writer, attributes, time, sender, communicator, msgTag, msgLength);
+    count_written(EventType::MpiRecv);
 }
 
 void
-TraceWriter::handleMpiRecvEvent(OTF2_LocationRef    location,
+TraceWriter::writeMpiIrecvEvent(OTF2_LocationRef    location,
                                 OTF2_TimeStamp      time,
                                 OTF2_AttributeList *attributes,
                                 uint32_t            sender,
                                 OTF2_CommRef        communicator,
                                 uint32_t            msgTag,
-                                uint64_t            msgLength)
+                                uint64_t            msgLength,
+                                uint64_t            requestID)
 {
-    bool filter_out =
-        m_event_MpiRecv_filter.process(location, time, attributes, sender, communicator, msgTag, msgLength);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiRecv(event_writer, attributes, time, sender, communicator, msgTag, msgLength);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiIrecv(event_writer, attributes, time, sender, communicator, msgTag, msgLength, requestID);
+    count_written(EventType::MpiIrecv);
 }
 
 void
-TraceWriter::handleMpiIrecvEvent(OTF2_LocationRef    location,
-                                 OTF2_TimeStamp      time,
-                                 OTF2_AttributeList *attributes,
-                                 uint32_t            sender,
-                                 OTF2_CommRef        communicator,
-                                 uint32_t            msgTag,
-                                 uint64_t            msgLength,
-                                 uint64_t            requestID)
+TraceWriter::writeMpiRequestTestEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      uint64_t            requestID)
 {
-    bool filter_out =
-        m_event_MpiIrecv_filter.process(location, time, attributes, sender, communicator, msgTag, msgLength, requestID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiIrecv(event_writer, attributes, time, sender, communicator, msgTag, msgLength, requestID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiRequestTest(event_writer, attributes, time, requestID);
+    count_written(EventType::MpiRequestTest);
 }
 
 void
-TraceWriter::handleMpiRequestTestEvent(OTF2_LocationRef    location,
-                                       OTF2_TimeStamp      time,
-                                       OTF2_AttributeList *attributes,
-                                       uint64_t            requestID)
+TraceWriter::writeMpiRequestCancelledEvent(OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes,
+                                           uint64_t            requestID)
 {
-    bool filter_out = m_event_MpiRequestTest_filter.process(location, time, attributes, requestID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiRequestTest(event_writer, attributes, time, requestID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiRequestCancelled(event_writer, attributes, time, requestID);
+    count_written(EventType::MpiRequestCancelled);
 }
 
 void
-TraceWriter::handleMpiRequestCancelledEvent(OTF2_LocationRef    location,
-                                            OTF2_TimeStamp      time,
-                                            OTF2_AttributeList *attributes,
-                                            uint64_t            requestID)
+TraceWriter::writeMpiCollectiveBeginEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes)
 {
-    bool filter_out = m_event_MpiRequestCancelled_filter.process(location, time, attributes, requestID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiRequestCancelled(event_writer, attributes, time, requestID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiCollectiveBegin(event_writer, attributes, time);
+    count_written(EventType::MpiCollectiveBegin);
 }
 
 void
-TraceWriter::handleMpiCollectiveBeginEvent(OTF2_LocationRef    location,
-                                           OTF2_TimeStamp      time,
-                                           OTF2_AttributeList *attributes)
+TraceWriter::writeMpiCollectiveEndEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_CollectiveOp   collectiveOp,
+                                        OTF2_CommRef        communicator,
+                                        uint32_t            root,
+                                        uint64_t            sizeSent,
+                                        uint64_t            sizeReceived)
 {
-    bool filter_out = m_event_MpiCollectiveBegin_filter.process(location, time, attributes);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiCollectiveBegin(event_writer, attributes, time);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_MpiCollectiveEnd(
+        event_writer, attributes, time, collectiveOp, communicator, root, sizeSent, sizeReceived);
+    count_written(EventType::MpiCollectiveEnd);
 }
 
 void
-TraceWriter::handleMpiCollectiveEndEvent(OTF2_LocationRef    location,
-                                         OTF2_TimeStamp      time,
-                                         OTF2_AttributeList *attributes,
-                                         OTF2_CollectiveOp   collectiveOp,
-                                         OTF2_CommRef        communicator,
-                                         uint32_t            root,
-                                         uint64_t            sizeSent,
-                                         uint64_t            sizeReceived)
+TraceWriter::writeOmpForkEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               uint32_t            numberOfRequestedThreads)
 {
-    bool filter_out = m_event_MpiCollectiveEnd_filter.process(
-        location, time, attributes, collectiveOp, communicator, root, sizeSent, sizeReceived);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_MpiCollectiveEnd(
-            event_writer, attributes, time, collectiveOp, communicator, root, sizeSent, sizeReceived);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpFork(event_writer, attributes, time, numberOfRequestedThreads);
+    count_written(EventType::OmpFork);
 }
 
 void
-TraceWriter::handleOmpForkEvent(OTF2_LocationRef    location,
-                                OTF2_TimeStamp      time,
-                                OTF2_AttributeList *attributes,
-                                uint32_t            numberOfRequestedThreads)
+TraceWriter::writeOmpJoinEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes)
 {
-    bool filter_out = m_event_OmpFork_filter.process(location, time, attributes, numberOfRequestedThreads);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpFork(event_writer, attributes, time, numberOfRequestedThreads);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpJoin(event_writer, attributes, time);
+    count_written(EventType::OmpJoin);
 }
 
 void
-TraceWriter::handleOmpJoinEvent(OTF2_LocationRef location, OTF2_TimeStamp time, OTF2_AttributeList *attributes)
+TraceWriter::writeOmpAcquireLockEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      uint32_t            lockID,
+                                      uint32_t            acquisitionOrder)
 {
-    bool filter_out = m_event_OmpJoin_filter.process(location, time, attributes);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpJoin(event_writer, attributes, time);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpAcquireLock(event_writer, attributes, time, lockID, acquisitionOrder);
+    count_written(EventType::OmpAcquireLock);
+}
+
+void
+TraceWriter::writeOmpReleaseLockEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      uint32_t            lockID,
+                                      uint32_t            acquisitionOrder)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpReleaseLock(event_writer, attributes, time, lockID, acquisitionOrder);
+    count_written(EventType::OmpReleaseLock);
+}
+
+void
+TraceWriter::writeOmpTaskCreateEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     uint64_t            taskID)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpTaskCreate(event_writer, attributes, time, taskID);
+    count_written(EventType::OmpTaskCreate);
+}
+
+void
+TraceWriter::writeOmpTaskSwitchEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     uint64_t            taskID)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpTaskSwitch(event_writer, attributes, time, taskID);
+    count_written(EventType::OmpTaskSwitch);
 }
 
 void
-TraceWriter::handleOmpAcquireLockEvent(OTF2_LocationRef    location,
+TraceWriter::writeOmpTaskCompleteEvent(OTF2_LocationRef    location,
                                        OTF2_TimeStamp      time,
                                        OTF2_AttributeList *attributes,
-                                       uint32_t            lockID,
-                                       uint32_t            acquisitionOrder)
+                                       uint64_t            taskID)
 {
-    bool filter_out = m_event_OmpAcquireLock_filter.process(location, time, attributes, lockID, acquisitionOrder);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpAcquireLock(event_writer, attributes, time, lockID, acquisitionOrder);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_OmpTaskComplete(event_writer, attributes, time, taskID);
+    count_written(EventType::OmpTaskComplete);
 }
 
 void
-TraceWriter::handleOmpReleaseLockEvent(OTF2_LocationRef    location,
+TraceWriter::writeMetricEvent(OTF2_LocationRef        location,
+                              OTF2_TimeStamp          time,
+                              OTF2_AttributeList *    attributes,
+                              OTF2_MetricRef          metric,
+                              uint8_t                 numberOfMetrics,
+                              const OTF2_Type *       typeIDs,
+                              const OTF2_MetricValue *metricValues)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_Metric(event_writer, attributes, time, metric, numberOfMetrics, typeIDs, metricValues);
+    count_written(EventType::Metric);
+}
+
+void
+TraceWriter::writeParameterStringEvent(OTF2_LocationRef    location,
                                        OTF2_TimeStamp      time,
                                        OTF2_AttributeList *attributes,
-                                       uint32_t            lockID,
-                                       uint32_t            acquisitionOrder)
+                                       OTF2_ParameterRef   parameter,
+                                       OTF2_StringRef      string)
 {
-    bool filter_out = m_event_OmpReleaseLock_filter.process(location, time, attributes, lockID, acquisitionOrder);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpReleaseLock(event_writer, attributes, time, lockID, acquisitionOrder);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ParameterString(event_writer, attributes, time, parameter, string);
+    count_written(EventType::ParameterString);
+}
+
+void
+TraceWriter::writeParameterIntEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_ParameterRef   parameter,
+                                    int64_t             value)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ParameterInt(event_writer, attributes, time, parameter, value);
+    count_written(EventType::ParameterInt);
+}
+
+void
+TraceWriter::writeParameterUnsignedIntEvent(OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_ParameterRef   parameter,
+                                            uint64_t            value)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ParameterUnsignedInt(event_writer, attributes, time, parameter, value);
+    count_written(EventType::ParameterUnsignedInt);
+}
+
+void
+TraceWriter::writeRmaWinCreateEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_RmaWinRef      win)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaWinCreate(event_writer, attributes, time, win);
+    count_written(EventType::RmaWinCreate);
+}
+
+void
+TraceWriter::writeRmaWinDestroyEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_RmaWinRef      win)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaWinDestroy(event_writer, attributes, time, win);
+    count_written(EventType::RmaWinDestroy);
+}
+
+void
+TraceWriter::writeRmaCollectiveBeginEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaCollectiveBegin(event_writer, attributes, time);
+    count_written(EventType::RmaCollectiveBegin);
+}
+
+void
+TraceWriter::writeRmaCollectiveEndEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_CollectiveOp   collectiveOp,
+                                        OTF2_RmaSyncLevel   syncLevel,
+                                        OTF2_RmaWinRef      win,
+                                        uint32_t            root,
+                                        uint64_t            bytesSent,
+                                        uint64_t            bytesReceived)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaCollectiveEnd(
+        event_writer, attributes, time, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
+    count_written(EventType::RmaCollectiveEnd);
+}
+
+void
+TraceWriter::writeRmaGroupSyncEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_RmaSyncLevel   syncLevel,
+                                    OTF2_RmaWinRef      win,
+                                    OTF2_GroupRef       group)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaGroupSync(event_writer, attributes, time, syncLevel, win, group);
+    count_written(EventType::RmaGroupSync);
 }
 
 void
-TraceWriter::handleOmpTaskCreateEvent(OTF2_LocationRef    location,
+TraceWriter::writeRmaRequestLockEvent(OTF2_LocationRef    location,
                                       OTF2_TimeStamp      time,
                                       OTF2_AttributeList *attributes,
-                                      uint64_t            taskID)
+                                      OTF2_RmaWinRef      win,
+                                      uint32_t            remote,
+                                      uint64_t            lockId,
+                                      OTF2_LockType       lockType)
 {
-    bool filter_out = m_event_OmpTaskCreate_filter.process(location, time, attributes, taskID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpTaskCreate(event_writer, attributes, time, taskID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaRequestLock(event_writer, attributes, time, win, remote, lockId, lockType);
+    count_written(EventType::RmaRequestLock);
 }
 
 void
-TraceWriter::handleOmpTaskSwitchEvent(OTF2_LocationRef    location,
+TraceWriter::writeRmaAcquireLockEvent(OTF2_LocationRef    location,
                                       OTF2_TimeStamp      time,
                                       OTF2_AttributeList *attributes,
-                                      uint64_t            taskID)
+                                      OTF2_RmaWinRef      win,
+                                      uint32_t            remote,
+                                      uint64_t            lockId,
+                                      OTF2_LockType       lockType)
 {
-    bool filter_out = m_event_OmpTaskSwitch_filter.process(location, time, attributes, taskID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpTaskSwitch(event_writer, attributes, time, taskID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaAcquireLock(event_writer, attributes, time, win, remote, lockId, lockType);
+    count_written(EventType::RmaAcquireLock);
 }
 
 void
-TraceWriter::handleOmpTaskCompleteEvent(OTF2_LocationRef    location,
-                                        OTF2_TimeStamp      time,
-                                        OTF2_AttributeList *attributes,
-                                        uint64_t            taskID)
+TraceWriter::writeRmaTryLockEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_RmaWinRef      win,
+                                  uint32_t            remote,
+                                  uint64_t            lockId,
+                                  OTF2_LockType       lockType)
 {
-    bool filter_out = m_event_OmpTaskComplete_filter.process(location, time, attributes, taskID);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_OmpTaskComplete(event_writer, attributes, time, taskID);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaTryLock(event_writer, attributes, time, win, remote, lockId, lockType);
+    count_written(EventType::RmaTryLock);
 }
 
 void
-TraceWriter::handleMetricEvent(OTF2_LocationRef        location,
-                               OTF2_TimeStamp          time,
-                               OTF2_AttributeList *    attributes,
-                               OTF2_MetricRef          metric,
-                               uint8_t                 numberOfMetrics,
-                               const OTF2_Type *       typeIDs,
-                               const OTF2_MetricValue *metricValues)
+TraceWriter::writeRmaReleaseLockEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_RmaWinRef      win,
+                                      uint32_t            remote,
+                                      uint64_t            lockId)
 {
-    bool filter_out =
-        m_event_Metric_filter.process(location, time, attributes, metric, numberOfMetrics, typeIDs, metricValues);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_Metric(event_writer, attributes, time, metric, numberOfMetrics, typeIDs, metricValues);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaReleaseLock(event_writer, attributes, time, win, remote, lockId);
+    count_written(EventType::RmaReleaseLock);
 }
 
 void
-TraceWriter::handleParameterStringEvent(OTF2_LocationRef    location,
-                                        OTF2_TimeStamp      time,
-                                        OTF2_AttributeList *attributes,
-                                        OTF2_ParameterRef   parameter,
-                                        OTF2_StringRef      string)
+TraceWriter::writeRmaSyncEvent(OTF2_LocationRef    location,
+                               OTF2_TimeStamp      time,
+                               OTF2_AttributeList *attributes,
+                               OTF2_RmaWinRef      win,
+                               uint32_t            remote,
+                               OTF2_RmaSyncType    syncType)
 {
-    bool filter_out = m_event_ParameterString_filter.process(location, time, attributes, parameter, string);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ParameterString(event_writer, attributes, time, parameter, string);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaSync(event_writer, attributes, time, win, remote, syncType);
+    count_written(EventType::RmaSync);
 }
 
 void
-TraceWriter::handleParameterIntEvent(OTF2_LocationRef    location,
+TraceWriter::writeRmaWaitChangeEvent(OTF2_LocationRef    location,
                                      OTF2_TimeStamp      time,
                                      OTF2_AttributeList *attributes,
-                                     OTF2_ParameterRef   parameter,
-                                     int64_t             value)
+                                     OTF2_RmaWinRef      win)
 {
-    bool filter_out = m_event_ParameterInt_filter.process(location, time, attributes, parameter, value);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ParameterInt(event_writer, attributes, time, parameter, value);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaWaitChange(event_writer, attributes, time, win);
+    count_written(EventType::RmaWaitChange);
+}
+
+void
+TraceWriter::writeRmaPutEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            bytes,
+                              uint64_t            matchingId)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaPut(event_writer, attributes, time, win, remote, bytes, matchingId);
+    count_written(EventType::RmaPut);
 }
 
 void
-TraceWriter::handleParameterUnsignedIntEvent(OTF2_LocationRef    location,
+TraceWriter::writeRmaGetEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_RmaWinRef      win,
+                              uint32_t            remote,
+                              uint64_t            bytes,
+                              uint64_t            matchingId)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaGet(event_writer, attributes, time, win, remote, bytes, matchingId);
+    count_written(EventType::RmaGet);
+}
+
+void
+TraceWriter::writeRmaAtomicEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_RmaWinRef      win,
+                                 uint32_t            remote,
+                                 OTF2_RmaAtomicType  type,
+                                 uint64_t            bytesSent,
+                                 uint64_t            bytesReceived,
+                                 uint64_t            matchingId)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaAtomic(event_writer, attributes, time, win, remote, type, bytesSent, bytesReceived, matchingId);
+    count_written(EventType::RmaAtomic);
+}
+
+void
+TraceWriter::writeRmaOpCompleteBlockingEvent(OTF2_LocationRef    location,
                                              OTF2_TimeStamp      time,
                                              OTF2_AttributeList *attributes,
-                                             OTF2_ParameterRef   parameter,
-                                             uint64_t            value)
+                                             OTF2_RmaWinRef      win,
+                                             uint64_t            matchingId)
 {
-    bool filter_out = m_event_ParameterUnsignedInt_filter.process(location, time, attributes, parameter, value);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ParameterUnsignedInt(event_writer, attributes, time, parameter, value);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaOpCompleteBlocking(event_writer, attributes, time, win, matchingId);
+    count_written(EventType::RmaOpCompleteBlocking);
 }
 
 void
-TraceWriter::handleRmaWinCreateEvent(OTF2_LocationRef    location,
-                                     OTF2_TimeStamp      time,
-                                     OTF2_AttributeList *attributes,
-                                     OTF2_RmaWinRef      win)
+TraceWriter::writeRmaOpCompleteNonBlockingEvent(OTF2_LocationRef    location,
+                                                OTF2_TimeStamp      time,
+                                                OTF2_AttributeList *attributes,
+                                                OTF2_RmaWinRef      win,
+                                                uint64_t            matchingId)
 {
-    bool filter_out = m_event_RmaWinCreate_filter.process(location, time, attributes, win);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaWinCreate(event_writer, attributes, time, win);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaOpCompleteNonBlocking(event_writer, attributes, time, win, matchingId);
+    count_written(EventType::RmaOpCompleteNonBlocking);
 }
 
 void
-TraceWriter::handleRmaWinDestroyEvent(OTF2_LocationRef    location,
-                                      OTF2_TimeStamp      time,
-                                      OTF2_AttributeList *attributes,
-                                      OTF2_RmaWinRef      win)
+TraceWriter::writeRmaOpTestEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_RmaWinRef      win,
+                                 uint64_t            matchingId)
 {
-    bool filter_out = m_event_RmaWinDestroy_filter.process(location, time, attributes, win);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaWinDestroy(event_writer, attributes, time, win);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaOpTest(event_writer, attributes, time, win, matchingId);
+    count_written(EventType::RmaOpTest);
 }
 
 void
-TraceWriter::handleRmaCollectiveBeginEvent(OTF2_LocationRef    location,
+TraceWriter::writeRmaOpCompleteRemoteEvent(OTF2_LocationRef    location,
                                            OTF2_TimeStamp      time,
-                                           OTF2_AttributeList *attributes)
+                                           OTF2_AttributeList *attributes,
+                                           OTF2_RmaWinRef      win,
+                                           uint64_t            matchingId)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_RmaOpCompleteRemote(event_writer, attributes, time, win, matchingId);
+    count_written(EventType::RmaOpCompleteRemote);
+}
+
+void
+TraceWriter::writeThreadForkEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_Paradigm       model,
+                                  uint32_t            numberOfRequestedThreads)
+{
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadFork(event_writer, attributes, time, model, numberOfRequestedThreads);
+    count_written(EventType::ThreadFork);
+}
+
+void
+TraceWriter::writeThreadJoinEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_Paradigm       model)
 {
-    bool filter_out = m_event_RmaCollectiveBegin_filter.process(location, time, attributes);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaCollectiveBegin(event_writer, attributes, time);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadJoin(event_writer, attributes, time, model);
+    count_written(EventType::ThreadJoin);
 }
 
 void
-TraceWriter::handleRmaCollectiveEndEvent(OTF2_LocationRef    location,
-                                         OTF2_TimeStamp      time,
-                                         OTF2_AttributeList *attributes,
-                                         OTF2_CollectiveOp   collectiveOp,
-                                         OTF2_RmaSyncLevel   syncLevel,
-                                         OTF2_RmaWinRef      win,
-                                         uint32_t            root,
-                                         uint64_t            bytesSent,
-                                         uint64_t            bytesReceived)
+TraceWriter::writeThreadTeamBeginEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_CommRef        threadTeam)
 {
-    bool filter_out = m_event_RmaCollectiveEnd_filter.process(
-        location, time, attributes, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaCollectiveEnd(
-            event_writer, attributes, time, collectiveOp, syncLevel, win, root, bytesSent, bytesReceived);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadTeamBegin(event_writer, attributes, time, threadTeam);
+    count_written(EventType::ThreadTeamBegin);
 }
 
 void
-TraceWriter::handleRmaGroupSyncEvent(OTF2_LocationRef    location,
+TraceWriter::writeThreadTeamEndEvent(OTF2_LocationRef    location,
                                      OTF2_TimeStamp      time,
                                      OTF2_AttributeList *attributes,
-                                     OTF2_RmaSyncLevel   syncLevel,
-                                     OTF2_RmaWinRef      win,
-                                     OTF2_GroupRef       group)
+                                     OTF2_CommRef        threadTeam)
 {
-    bool filter_out = m_event_RmaGroupSync_filter.process(location, time, attributes, syncLevel, win, group);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaGroupSync(event_writer, attributes, time, syncLevel, win, group);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadTeamEnd(event_writer, attributes, time, threadTeam);
+    count_written(EventType::ThreadTeamEnd);
 }
 
 void
-TraceWriter::handleRmaRequestLockEvent(OTF2_LocationRef    location,
-                                       OTF2_TimeStamp      time,
-                                       OTF2_AttributeList *attributes,
-                                       OTF2_RmaWinRef      win,
-                                       uint32_t            remote,
-                                       uint64_t            lockId,
-                                       OTF2_LockType       lockType)
+TraceWriter::writeThreadAcquireLockEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_Paradigm       model,
+                                         uint32_t            lockID,
+                                         uint32_t            acquisitionOrder)
 {
-    bool filter_out = m_event_RmaRequestLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaRequestLock(event_writer, attributes, time, win, remote, lockId, lockType);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadAcquireLock(event_writer, attributes, time, model, lockID, acquisitionOrder);
+    count_written(EventType::ThreadAcquireLock);
 }
 
 void
-TraceWriter::handleRmaAcquireLockEvent(OTF2_LocationRef    location,
-                                       OTF2_TimeStamp      time,
-                                       OTF2_AttributeList *attributes,
-                                       OTF2_RmaWinRef      win,
-                                       uint32_t            remote,
-                                       uint64_t            lockId,
-                                       OTF2_LockType       lockType)
+TraceWriter::writeThreadReleaseLockEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_Paradigm       model,
+                                         uint32_t            lockID,
+                                         uint32_t            acquisitionOrder)
 {
-    bool filter_out = m_event_RmaAcquireLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaAcquireLock(event_writer, attributes, time, win, remote, lockId, lockType);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadReleaseLock(event_writer, attributes, time, model, lockID, acquisitionOrder);
+    count_written(EventType::ThreadReleaseLock);
 }
 
 void
-TraceWriter::handleRmaTryLockEvent(OTF2_LocationRef    location,
-                                   OTF2_TimeStamp      time,
-                                   OTF2_AttributeList *attributes,
-                                   OTF2_RmaWinRef      win,
-                                   uint32_t            remote,
-                                   uint64_t            lockId,
-                                   OTF2_LockType       lockType)
+TraceWriter::writeThreadTaskCreateEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_CommRef        threadTeam,
+                                        uint32_t            creatingThread,
+                                        uint32_t            generationNumber)
 {
-    bool filter_out = m_event_RmaTryLock_filter.process(location, time, attributes, win, remote, lockId, lockType);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaTryLock(event_writer, attributes, time, win, remote, lockId, lockType);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadTaskCreate(event_writer, attributes, time, threadTeam, creatingThread, generationNumber);
+    count_written(EventType::ThreadTaskCreate);
 }
 
 void
-TraceWriter::handleRmaReleaseLockEvent(OTF2_LocationRef    location,
-                                       OTF2_TimeStamp      time,
-                                       OTF2_AttributeList *attributes,
-                                       OTF2_RmaWinRef      win,
-                                       uint32_t            remote,
-                                       uint64_t            lockId)
+TraceWriter::writeThreadTaskSwitchEvent(OTF2_LocationRef    location,
+                                        OTF2_TimeStamp      time,
+                                        OTF2_AttributeList *attributes,
+                                        OTF2_CommRef        threadTeam,
+                                        uint32_t            creatingThread,
+                                        uint32_t            generationNumber)
 {
-    bool filter_out = m_event_RmaReleaseLock_filter.process(location, time, attributes, win, remote, lockId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaReleaseLock(event_writer, attributes, time, win, remote, lockId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadTaskSwitch(event_writer, attributes, time, threadTeam, creatingThread, generationNumber);
+    count_written(EventType::ThreadTaskSwitch);
 }
 
 void
-TraceWriter::handleRmaSyncEvent(OTF2_LocationRef    location,
-                                OTF2_TimeStamp      time,
-                                OTF2_AttributeList *attributes,
-                                OTF2_RmaWinRef      win,
-                                uint32_t            remote,
-                                OTF2_RmaSyncType    syncType)
+TraceWriter::writeThreadTaskCompleteEvent(OTF2_LocationRef    location,
+                                          OTF2_TimeStamp      time,
+                                          OTF2_AttributeList *attributes,
+                                          OTF2_CommRef        threadTeam,
+                                          uint32_t            creatingThread,
+                                          uint32_t            generationNumber)
 {
-    bool filter_out = m_event_RmaSync_filter.process(location, time, attributes, win, remote, syncType);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaSync(event_writer, attributes, time, win, remote, syncType);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadTaskComplete(event_writer, attributes, time, threadTeam, creatingThread, generationNumber);
+    count_written(EventType::ThreadTaskComplete);
 }
 
 void
-TraceWriter::handleRmaWaitChangeEvent(OTF2_LocationRef    location,
-                                      OTF2_TimeStamp      time,
-                                      OTF2_AttributeList *attributes,
-                                      OTF2_RmaWinRef      win)
+TraceWriter::writeThreadCreateEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_CommRef        threadContingent,
+                                    uint64_t            sequenceCount)
 {
-    bool filter_out = m_event_RmaWaitChange_filter.process(location, time, attributes, win);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaWaitChange(event_writer, attributes, time, win);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadCreate(event_writer, attributes, time, threadContingent, sequenceCount);
+    count_written(EventType::ThreadCreate);
 }
 
 void
-TraceWriter::handleRmaPutEvent(OTF2_LocationRef    location,
-                               OTF2_TimeStamp      time,
-                               OTF2_AttributeList *attributes,
-                               OTF2_RmaWinRef      win,
-                               uint32_t            remote,
-                               uint64_t            bytes,
-                               uint64_t            matchingId)
+TraceWriter::writeThreadBeginEvent(OTF2_LocationRef    location,
+                                   OTF2_TimeStamp      time,
+                                   OTF2_AttributeList *attributes,
+                                   OTF2_CommRef        threadContingent,
+                                   uint64_t            sequenceCount)
 {
-    bool filter_out = m_event_RmaPut_filter.process(location, time, attributes, win, remote, bytes, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaPut(event_writer, attributes, time, win, remote, bytes, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadBegin(event_writer, attributes, time, threadContingent, sequenceCount);
+    count_written(EventType::ThreadBegin);
 }
 
 void
-TraceWriter::handleRmaGetEvent(OTF2_LocationRef    location,
-                               OTF2_TimeStamp      time,
-                               OTF2_AttributeList *attributes,
-                               OTF2_RmaWinRef      win,
-                               uint32_t            remote,
-                               uint64_t            bytes,
-                               uint64_t            matchingId)
+TraceWriter::writeThreadWaitEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  OTF2_CommRef        threadContingent,
+                                  uint64_t            sequenceCount)
 {
-    bool filter_out = m_event_RmaGet_filter.process(location, time, attributes, win, remote, bytes, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaGet(event_writer, attributes, time, win, remote, bytes, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadWait(event_writer, attributes, time, threadContingent, sequenceCount);
+    count_written(EventType::ThreadWait);
 }
 
 void
-TraceWriter::handleRmaAtomicEvent(OTF2_LocationRef    location,
-                                  OTF2_TimeStamp      time,
-                                  OTF2_AttributeList *attributes,
-                                  OTF2_RmaWinRef      win,
-                                  uint32_t            remote,
-                                  OTF2_RmaAtomicType  type,
-                                  uint64_t            bytesSent,
-                                  uint64_t            bytesReceived,
-                                  uint64_t            matchingId)
+TraceWriter::writeThreadEndEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_CommRef        threadContingent,
+                                 uint64_t            sequenceCount)
 {
-    bool filter_out = m_event_RmaAtomic_filter.process(
-        location, time, attributes, win, remote, type, bytesSent, bytesReceived, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaAtomic(
-            event_writer, attributes, time, win, remote, type, bytesSent, bytesReceived, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ThreadEnd(event_writer, attributes, time, threadContingent, sequenceCount);
+    count_written(EventType::ThreadEnd);
 }
 
 void
-TraceWriter::handleRmaOpCompleteBlockingEvent(OTF2_LocationRef    location,
-                                              OTF2_TimeStamp      time,
-                                              OTF2_AttributeList *attributes,
-                                              OTF2_RmaWinRef      win,
-                                              uint64_t            matchingId)
+TraceWriter::writeCallingContextEnterEvent(OTF2_LocationRef       location,
+                                           OTF2_TimeStamp         time,
+                                           OTF2_AttributeList *   attributes,
+                                           OTF2_CallingContextRef callingContext,
+                                           uint32_t               unwindDistance)
 {
-    bool filter_out = m_event_RmaOpCompleteBlocking_filter.process(location, time, attributes, win, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaOpCompleteBlocking(event_writer, attributes, time, win, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_CallingContextEnter(event_writer, attributes, time, callingContext, unwindDistance);
+    count_written(EventType::CallingContextEnter);
 }
 
 void
-TraceWriter::handleRmaOpCompleteNonBlockingEvent(OTF2_LocationRef    location,
-                                                 OTF2_TimeStamp      time,
-                                                 OTF2_AttributeList *attributes,
-                                                 OTF2_RmaWinRef      win,
-                                                 uint64_t            matchingId)
+TraceWriter::writeCallingContextLeaveEvent(OTF2_LocationRef       location,
+                                           OTF2_TimeStamp         time,
+                                           OTF2_AttributeList *   attributes,
+                                           OTF2_CallingContextRef callingContext)
 {
-    bool filter_out = m_event_RmaOpCompleteNonBlocking_filter.process(location, time, attributes, win, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaOpCompleteNonBlocking(event_writer, attributes, time, win, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_CallingContextLeave(event_writer, attributes, time, callingContext);
+    count_written(EventType::CallingContextLeave);
 }
 
 void
-TraceWriter::handleRmaOpTestEvent(OTF2_LocationRef    location,
-                                  OTF2_TimeStamp      time,
-                                  OTF2_AttributeList *attributes,
-                                  OTF2_RmaWinRef      win,
-                                  uint64_t            matchingId)
+TraceWriter::writeCallingContextSampleEvent(OTF2_LocationRef           location,
+                                            OTF2_TimeStamp             time,
+                                            OTF2_AttributeList *       attributes,
+                                            OTF2_CallingContextRef     callingContext,
+                                            uint32_t                   unwindDistance,
+                                            OTF2_InterruptGeneratorRef interruptGenerator)
 {
-    bool filter_out = m_event_RmaOpTest_filter.process(location, time, attributes, win, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaOpTest(event_writer, attributes, time, win, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_CallingContextSample(
+        event_writer, attributes, time, callingContext, unwindDistance, interruptGenerator);
+    count_written(EventType::CallingContextSample);
 }
 
 void
-TraceWriter::handleRmaOpCompleteRemoteEvent(OTF2_LocationRef    location,
-                                            OTF2_TimeStamp      time,
-                                            OTF2_AttributeList *attributes,
-                                            OTF2_RmaWinRef      win,
-                                            uint64_t            matchingId)
+TraceWriter::writeIoCreateHandleEvent(OTF2_LocationRef    location,
+                                      OTF2_TimeStamp      time,
+                                      OTF2_AttributeList *attributes,
+                                      OTF2_IoHandleRef    handle,
+                                      OTF2_IoAccessMode   mode,
+                                      OTF2_IoCreationFlag creationFlags,
+                                      OTF2_IoStatusFlag   statusFlags)
 {
-    bool filter_out = m_event_RmaOpCompleteRemote_filter.process(location, time, attributes, win, matchingId);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_RmaOpCompleteRemote(event_writer, attributes, time, win, matchingId);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoCreateHandle(event_writer, attributes, time, handle, mode, creationFlags, statusFlags);
+    count_written(EventType::IoCreateHandle);
 }
 
 void
-TraceWriter::handleThreadForkEvent(OTF2_LocationRef    location,
-                                   OTF2_TimeStamp      time,
-                                   OTF2_AttributeList *attributes,
-                                   OTF2_Paradigm       model,
-                                   uint32_t            numberOfRequestedThreads)
+TraceWriter::writeIoDestroyHandleEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_IoHandleRef    handle)
 {
-    bool filter_out = m_event_ThreadFork_filter.process(location, time, attributes, model, numberOfRequestedThreads);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadFork(event_writer, attributes, time, model, numberOfRequestedThreads);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoDestroyHandle(event_writer, attributes, time, handle);
+    count_written(EventType::IoDestroyHandle);
 }
 
 void
-TraceWriter::handleThreadJoinEvent(OTF2_LocationRef    location,
-                                   OTF2_TimeStamp      time,
-                                   OTF2_AttributeList *attributes,
-                                   OTF2_Paradigm       model)
+TraceWriter::writeIoDuplicateHandleEvent(OTF2_LocationRef    location,
+                                         OTF2_TimeStamp      time,
+                                         OTF2_AttributeList *attributes,
+                                         OTF2_IoHandleRef    oldHandle,
+                                         OTF2_IoHandleRef    newHandle,
+                                         OTF2_IoStatusFlag   statusFlags)
 {
-    bool filter_out = m_event_ThreadJoin_filter.process(location, time, attributes, model);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadJoin(event_writer, attributes, time, model);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoDuplicateHandle(event_writer, attributes, time, oldHandle, newHandle, statusFlags);
+    count_written(EventType::IoDuplicateHandle);
 }
 
 void
-TraceWriter::handleThreadTeamBeginEvent(OTF2_LocationRef    location,
-                                        OTF2_TimeStamp      time,
-                                        OTF2_AttributeList *attributes,
-                                        OTF2_CommRef        threadTeam)
+TraceWriter::writeIoSeekEvent(OTF2_LocationRef    location,
+                              OTF2_TimeStamp      time,
+                              OTF2_AttributeList *attributes,
+                              OTF2_IoHandleRef    handle,
+                              int64_t             offsetRequest,
+                              OTF2_IoSeekOption   whence,
+                              uint64_t            offsetResult)
 {
-    bool filter_out = m_event_ThreadTeamBegin_filter.process(location, time, attributes, threadTeam);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadTeamBegin(event_writer, attributes, time, threadTeam);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoSeek(event_writer, attributes, time, handle, offsetRequest, whence, offsetResult);
+    count_written(EventType::IoSeek);
 }
 
 void
-TraceWriter::handleThreadTeamEndEvent(OTF2_LocationRef    location,
-                                      OTF2_TimeStamp      time,
-                                      OTF2_AttributeList *attributes,
-                                      OTF2_CommRef        threadTeam)
+TraceWriter::writeIoChangeStatusFlagsEvent(OTF2_LocationRef    location,
+                                           OTF2_TimeStamp      time,
+                                           OTF2_AttributeList *attributes,
+                                           OTF2_IoHandleRef    handle,
+                                           OTF2_IoStatusFlag   statusFlags)
 {
-    bool filter_out = m_event_ThreadTeamEnd_filter.process(location, time, attributes, threadTeam);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadTeamEnd(event_writer, attributes, time, threadTeam);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoChangeStatusFlags(event_writer, attributes, time, handle, statusFlags);
+    count_written(EventType::IoChangeStatusFlags);
 }
 
 void
-TraceWriter::handleThreadAcquireLockEvent(OTF2_LocationRef    location,
-                                          OTF2_TimeStamp      time,
-                                          OTF2_AttributeList *attributes,
-                                          OTF2_Paradigm       model,
-                                          uint32_t            lockID,
-                                          uint32_t            acquisitionOrder)
+TraceWriter::writeIoDeleteFileEvent(OTF2_LocationRef    location,
+                                    OTF2_TimeStamp      time,
+                                    OTF2_AttributeList *attributes,
+                                    OTF2_IoParadigmRef  ioParadigm,
+                                    OTF2_IoFileRef      file)
 {
-    bool filter_out =
-        m_event_ThreadAcquireLock_filter.process(location, time, attributes, model, lockID, acquisitionOrder);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadAcquireLock(event_writer, attributes, time, model, lockID, acquisitionOrder);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoDeleteFile(event_writer, attributes, time, ioParadigm, file);
+    count_written(EventType::IoDeleteFile);
 }
 
 void
-TraceWriter::handleThreadReleaseLockEvent(OTF2_LocationRef    location,
-                                          OTF2_TimeStamp      time,
-                                          OTF2_AttributeList *attributes,
-                                          OTF2_Paradigm       model,
-                                          uint32_t            lockID,
-                                          uint32_t            acquisitionOrder)
+TraceWriter::writeIoOperationBeginEvent(OTF2_LocationRef     location,
+                                        OTF2_TimeStamp       time,
+                                        OTF2_AttributeList * attributes,
+                                        OTF2_IoHandleRef     handle,
+                                        OTF2_IoOperationMode mode,
+                                        OTF2_IoOperationFlag operationFlags,
+                                        uint64_t             bytesRequest,
+                                        uint64_t             matchingId)
 {
-    bool filter_out =
-        m_event_ThreadReleaseLock_filter.process(location, time, attributes, model, lockID, acquisitionOrder);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadReleaseLock(event_writer, attributes, time, model, lockID, acquisitionOrder);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoOperationBegin(
+        event_writer, attributes, time, handle, mode, operationFlags, bytesRequest, matchingId);
+    count_written(EventType::IoOperationBegin);
 }
 
 void
-TraceWriter::handleThreadTaskCreateEvent(OTF2_LocationRef    location,
-                                         OTF2_TimeStamp      time,
-                                         OTF2_AttributeList *attributes,
-                                         OTF2_CommRef        threadTeam,
-                                         uint32_t            creatingThread,
-                                         uint32_t            generationNumber)
+TraceWriter::writeIoOperationTestEvent(OTF2_LocationRef    location,
+                                       OTF2_TimeStamp      time,
+                                       OTF2_AttributeList *attributes,
+                                       OTF2_IoHandleRef    handle,
+                                       uint64_t            matchingId)
 {
-    bool filter_out = m_event_ThreadTaskCreate_filter.process(
-        location, time, attributes, threadTeam, creatingThread, generationNumber);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadTaskCreate(event_writer, attributes, time, threadTeam, creatingThread, generationNumber);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoOperationTest(event_writer, attributes, time, handle, matchingId);
+    count_written(EventType::IoOperationTest);
 }
 
 void
-TraceWriter::handleThreadTaskSwitchEvent(OTF2_LocationRef    location,
+TraceWriter::writeIoOperationIssuedEvent(OTF2_LocationRef    location,
                                          OTF2_TimeStamp      time,
                                          OTF2_AttributeList *attributes,
-                                         OTF2_CommRef        threadTeam,
-                                         uint32_t            creatingThread,
-                                         uint32_t            generationNumber)
+                                         OTF2_IoHandleRef    handle,
+                                         uint64_t            matchingId)
 {
-    bool filter_out = m_event_ThreadTaskSwitch_filter.process(
-        location, time, attributes, threadTeam, creatingThread, generationNumber);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadTaskSwitch(event_writer, attributes, time, threadTeam, creatingThread, generationNumber);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoOperationIssued(event_writer, attributes, time, handle, matchingId);
+    count_written(EventType::IoOperationIssued);
 }
 
 void
-TraceWriter::handleThreadTaskCompleteEvent(OTF2_LocationRef    location,
+TraceWriter::writeIoOperationCompleteEvent(OTF2_LocationRef    location,
                                            OTF2_TimeStamp      time,
                                            OTF2_AttributeList *attributes,
-                                           OTF2_CommRef        threadTeam,
-                                           uint32_t            creatingThread,
-                                           uint32_t            generationNumber)
+                                           OTF2_IoHandleRef    handle,
+                                           uint64_t            bytesResult,
+                                           uint64_t            matchingId)
 {
-    bool filter_out = m_event_ThreadTaskComplete_filter.process(
-        location, time, attributes, threadTeam, creatingThread, generationNumber);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadTaskComplete(event_writer, attributes, time, threadTeam, creatingThread, generationNumber);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoOperationComplete(event_writer, attributes, time, handle, bytesResult, matchingId);
+    count_written(EventType::IoOperationComplete);
 }
 
 void
-TraceWriter::handleThreadCreateEvent(OTF2_LocationRef    location,
-                                     OTF2_TimeStamp      time,
-                                     OTF2_AttributeList *attributes,
-                                     OTF2_CommRef        threadContingent,
-                                     uint64_t            sequenceCount)
+TraceWriter::writeIoOperationCancelledEvent(OTF2_LocationRef    location,
+                                            OTF2_TimeStamp      time,
+                                            OTF2_AttributeList *attributes,
+                                            OTF2_IoHandleRef    handle,
+                                            uint64_t            matchingId)
 {
-    bool filter_out = m_event_ThreadCreate_filter.process(location, time, attributes, threadContingent, sequenceCount);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadCreate(event_writer, attributes, time, threadContingent, sequenceCount);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoOperationCancelled(event_writer, attributes, time, handle, matchingId);
+    count_written(EventType::IoOperationCancelled);
 }
 
 void
-TraceWriter::handleThreadBeginEvent(OTF2_LocationRef    location,
-                                    OTF2_TimeStamp      time,
-                                    OTF2_AttributeList *attributes,
-                                    OTF2_CommRef        threadContingent,
-                                    uint64_t            sequenceCount)
+TraceWriter::writeIoAcquireLockEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_IoHandleRef    handle,
+                                     OTF2_LockType       lockType)
 {
-    bool filter_out = m_event_ThreadBegin_filter.process(location, time, attributes, threadContingent, sequenceCount);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadBegin(event_writer, attributes, time, threadContingent, sequenceCount);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoAcquireLock(event_writer, attributes, time, handle, lockType);
+    count_written(EventType::IoAcquireLock);
 }
 
 void
-TraceWriter::handleThreadWaitEvent(OTF2_LocationRef    location,
-                                   OTF2_TimeStamp      time,
-                                   OTF2_AttributeList *attributes,
-                                   OTF2_CommRef        threadContingent,
-                                   uint64_t            sequenceCount)
+TraceWriter::writeIoReleaseLockEvent(OTF2_LocationRef    location,
+                                     OTF2_TimeStamp      time,
+                                     OTF2_AttributeList *attributes,
+                                     OTF2_IoHandleRef    handle,
+                                     OTF2_LockType       lockType)
 {
-    bool filter_out = m_event_ThreadWait_filter.process(location, time, attributes, threadContingent, sequenceCount);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadWait(event_writer, attributes, time, threadContingent, sequenceCount);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoReleaseLock(event_writer, attributes, time, handle, lockType);
+    count_written(EventType::IoReleaseLock);
 }
 
 void
-TraceWriter::handleThreadEndEvent(OTF2_LocationRef    location,
-                                  OTF2_TimeStamp      time,
-                                  OTF2_AttributeList *attributes,
-                                  OTF2_CommRef        threadContingent,
-                                  uint64_t            sequenceCount)
+TraceWriter::writeIoTryLockEvent(OTF2_LocationRef    location,
+                                 OTF2_TimeStamp      time,
+                                 OTF2_AttributeList *attributes,
+                                 OTF2_IoHandleRef    handle,
+                                 OTF2_LockType       lockType)
 {
-    bool filter_out = m_event_ThreadEnd_filter.process(location, time, attributes, threadContingent, sequenceCount);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ThreadEnd(event_writer, attributes, time, threadContingent, sequenceCount);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_IoTryLock(event_writer, attributes, time, handle, lockType);
+    count_written(EventType::IoTryLock);
 }
 
 void
-TraceWriter::handleCallingContextEnterEvent(OTF2_LocationRef       location,
-                                            OTF2_TimeStamp         time,
-                                            OTF2_AttributeList *   attributes,
-                                            OTF2_CallingContextRef callingContext,
-                                            uint32_t               unwindDistance)
+TraceWriter::writeProgramBeginEvent(OTF2_LocationRef      location,
+                                    OTF2_TimeStamp        time,
+                                    OTF2_AttributeList *  attributes,
+                                    OTF2_StringRef        programName,
+                                    uint32_t              numberOfArguments,
+                                    const OTF2_StringRef *programArguments)
 {
-    bool filter_out =
-        m_event_CallingContextEnter_filter.process(location, time, attributes, callingContext, unwindDistance);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_CallingContextEnter(event_writer, attributes, time, callingContext, unwindDistance);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ProgramBegin(event_writer, attributes, time, programName, numberOfArguments, programArguments);
+    count_written(EventType::ProgramBegin);
 }
 
 void
-TraceWriter::handleCallingContextLeaveEvent(OTF2_LocationRef       location,
-                                            OTF2_TimeStamp         time,
-                                            OTF2_AttributeList *   attributes,
-                                            OTF2_CallingContextRef callingContext)
+TraceWriter::writeProgramEndEvent(OTF2_LocationRef    location,
+                                  OTF2_TimeStamp      time,
+                                  OTF2_AttributeList *attributes,
+                                  int64_t             exitStatus)
 {
-    bool filter_out = m_event_CallingContextLeave_filter.process(location, time, attributes, callingContext);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_CallingContextLeave(event_writer, attributes, time, callingContext);
-    }
+    drop_attributes(attributes);
+    auto *event_writer = location_event_writer(location);
+    OTF2_EvtWriter_ProgramEnd(event_writer, attributes, time, exitStatus);
+    count_written(EventType::ProgramEnd);
 }
 
 void
-TraceWriter::handleCallingContextSampleEvent(OTF2_LocationRef           location,
-                                             OTF2_TimeStamp             time,
-                                             OTF2_AttributeList *       attributes,
-                                             OTF2_CallingContextRef     callingContext,
-                                             uint32_t                   unwindDistance,
-                                             OTF2_InterruptGeneratorRef interruptGenerator)
+TraceWriter::remove_dropped_attributes(OTF2_AttributeList *attributes)
 {
-    bool filter_out = m_event_CallingContextSample_filter.process(
-        location, time, attributes, callingContext, unwindDistance, interruptGenerator);
-    if (!filter_out)
+    uint32_t index = 0;
+    while (index < OTF2_AttributeList_GetNumberOfElements(attributes))
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_CallingContextSample(
-            event_writer, attributes, time, callingContext, unwindDistance, interruptGenerator);
+        OTF2_AttributeRef   attribute;
+        OTF2_Type           type;
+        OTF2_AttributeValue value;
+        OTF2_AttributeList_GetAttributeByIndex(attributes, index, &attribute, &type, &value);
+        if (m_dropped_attribute_types[type])
+        {
+            OTF2_AttributeList_RemoveAttribute(attributes, attribute);
+        }
+        else
+        {
+            index++;
+        }
     }
 }
 
 void
-TraceWriter::handleIoCreateHandleEvent(OTF2_LocationRef    location,
-                                       OTF2_TimeStamp      time,
-                                       OTF2_AttributeList *attributes,
-                                       OTF2_IoHandleRef    handle,
-                                       OTF2_IoAccessMode   mode,
-                                       OTF2_IoCreationFlag creationFlags,
-                                       OTF2_IoStatusFlag   statusFlags)
+TraceWriter::restrict_time_window(TimeWindow window)
 {
-    bool filter_out =
-        m_event_IoCreateHandle_filter.process(location, time, attributes, handle, mode, creationFlags, statusFlags);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoCreateHandle(event_writer, attributes, time, handle, mode, creationFlags, statusFlags);
-    }
+    m_time_window.begin = std::max(m_time_window.begin, window.begin);
+    m_time_window.end   = std::min(m_time_window.end, window.end);
+    m_balances_window   = m_time_window.begin != 0 || m_time_window.end != OTF2_UNDEFINED_TIMESTAMP;
 }
 
 void
-TraceWriter::handleIoDestroyHandleEvent(OTF2_LocationRef    location,
-                                        OTF2_TimeStamp      time,
-                                        OTF2_AttributeList *attributes,
-                                        OTF2_IoHandleRef    handle)
+TraceWriter::drop_location(OTF2_LocationRef location)
 {
-    bool filter_out = m_event_IoDestroyHandle_filter.process(location, time, attributes, handle);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoDestroyHandle(event_writer, attributes, time, handle);
-    }
+    m_dropped_locations.insert(location);
 }
 
 void
-TraceWriter::handleIoDuplicateHandleEvent(OTF2_LocationRef    location,
-                                          OTF2_TimeStamp      time,
-                                          OTF2_AttributeList *attributes,
-                                          OTF2_IoHandleRef    oldHandle,
-                                          OTF2_IoHandleRef    newHandle,
-                                          OTF2_IoStatusFlag   statusFlags)
+TraceWriter::add_location(OTF2_LocationRef location)
 {
-    bool filter_out =
-        m_event_IoDuplicateHandle_filter.process(location, time, attributes, oldHandle, newHandle, statusFlags);
-    if (!filter_out)
+    if (m_location_ordinals.count(location) > 0)
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoDuplicateHandle(event_writer, attributes, time, oldHandle, newHandle, statusFlags);
+        return;
     }
-}
-
-void
-TraceWriter::handleIoSeekEvent(OTF2_LocationRef    location,
-                               OTF2_TimeStamp      time,
-                               OTF2_AttributeList *attributes,
-                               OTF2_IoHandleRef    handle,
-                               int64_t             offsetRequest,
-                               OTF2_IoSeekOption   whence,
-                               uint64_t            offsetResult)
-{
-    bool filter_out =
-        m_event_IoSeek_filter.process(location, time, attributes, handle, offsetRequest, whence, offsetResult);
-    if (!filter_out)
+    m_location_ordinals.insert({location, m_event_writers.size()});
+    m_local_definitions_closed.push_back(false);
+    if (m_memory_limited)
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoSeek(event_writer, attributes, time, handle, offsetRequest, whence, offsetResult);
+        m_event_writers.push_back(nullptr);
+        return;
     }
+    m_event_writers.push_back(OTF2_Archive_GetEvtWriter(m_archive.get(), location));
 }
 
 void
-TraceWriter::handleIoChangeStatusFlagsEvent(OTF2_LocationRef    location,
-                                            OTF2_TimeStamp      time,
-                                            OTF2_AttributeList *attributes,
-                                            OTF2_IoHandleRef    handle,
-                                            OTF2_IoStatusFlag   statusFlags)
+TraceWriter::beginLocation(OTF2_LocationRef location)
 {
-    bool filter_out = m_event_IoChangeStatusFlags_filter.process(location, time, attributes, handle, statusFlags);
-    if (!filter_out)
+    auto search = m_location_ordinals.find(location);
+    if (m_memory_limited && search != m_location_ordinals.end())
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoChangeStatusFlags(event_writer, attributes, time, handle, statusFlags);
+        m_event_writers[search->second] = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
     }
+    m_thread_event_writer = {.owner    = this,
+                             .location = location,
+                             .writer   = cached_event_writer(location),
+                             .counters = m_options.stats != nullptr ? &m_options.stats->thread_stats().events : nullptr};
+    m_thread_window.owner  = this;
+    m_thread_window.before = true;
+    m_thread_window.open.clear();
 }
 
+/*
+ * Regions entered before the end of the time window and not left in it are
+ * left at its end.
+ */
 void
-TraceWriter::handleIoDeleteFileEvent(OTF2_LocationRef    location,
-                                     OTF2_TimeStamp      time,
-                                     OTF2_AttributeList *attributes,
-                                     OTF2_IoParadigmRef  ioParadigm,
-                                     OTF2_IoFileRef      file)
+TraceWriter::endLocation(OTF2_LocationRef location)
 {
-    bool filter_out = m_event_IoDeleteFile_filter.process(location, time, attributes, ioParadigm, file);
-    if (!filter_out)
+    if (m_balances_window && m_thread_window.owner == this && m_time_window.end != OTF2_UNDEFINED_TIMESTAMP)
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoDeleteFile(event_writer, attributes, time, ioParadigm, file);
+        if (m_thread_window.before)
+        {
+            reopen_records(location, true);
+        }
+        const auto &open = m_thread_window.open;
+        for (auto record = open.rbegin(); record != open.rend(); ++record)
+        {
+            if (record->written && record->type == EventType::Enter)
+            {
+                writeLeaveEvent(location, m_time_window.end, nullptr, record->region);
+            }
+        }
     }
-}
+    m_thread_window.owner = nullptr;
+    m_thread_window.open.clear();
 
-void
-TraceWriter::handleIoOperationBeginEvent(OTF2_LocationRef     location,
-                                         OTF2_TimeStamp       time,
-                                         OTF2_AttributeList * attributes,
-                                         OTF2_IoHandleRef     handle,
-                                         OTF2_IoOperationMode mode,
-                                         OTF2_IoOperationFlag operationFlags,
-                                         uint64_t             bytesRequest,
-                                         uint64_t             matchingId)
-{
-    bool filter_out = m_event_IoOperationBegin_filter.process(
-        location, time, attributes, handle, mode, operationFlags, bytesRequest, matchingId);
-    if (!filter_out)
+    m_thread_event_writer = {
+        .owner = nullptr, .location = OTF2_UNDEFINED_LOCATION, .writer = nullptr, .counters = nullptr};
+
+    auto search = m_location_ordinals.find(location);
+    if (m_memory_limited && search != m_location_ordinals.end())
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoOperationBegin(
-            event_writer, attributes, time, handle, mode, operationFlags, bytesRequest, matchingId);
+        OTF2_Archive_CloseEvtWriter(m_archive.get(), m_event_writers[search->second]);
+        m_event_writers[search->second] = nullptr;
     }
 }
 
 void
-TraceWriter::handleIoOperationTestEvent(OTF2_LocationRef    location,
-                                        OTF2_TimeStamp      time,
-                                        OTF2_AttributeList *attributes,
-                                        OTF2_IoHandleRef    handle,
-                                        uint64_t            matchingId)
+TraceWriter::endLocalDefinitions(OTF2_LocationRef location)
 {
-    bool filter_out = m_event_IoOperationTest_filter.process(location, time, attributes, handle, matchingId);
-    if (!filter_out)
+    auto search = m_location_ordinals.find(location);
+    if (m_memory_limited && search != m_location_ordinals.end())
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoOperationTest(event_writer, attributes, time, handle, matchingId);
+        OTF2_DefWriter *def_writer = OTF2_Archive_GetDefWriter(m_archive.get(), location);
+        OTF2_Archive_CloseDefWriter(m_archive.get(), def_writer);
+        m_local_definitions_closed[search->second] = true;
     }
 }
 
-void
-TraceWriter::handleIoOperationIssuedEvent(OTF2_LocationRef    location,
-                                          OTF2_TimeStamp      time,
-                                          OTF2_AttributeList *attributes,
-                                          OTF2_IoHandleRef    handle,
-                                          uint64_t            matchingId)
+/*
+ * Locations are copied while no worker reads events, the writer of the
+ * location is closed first, closing it later would overwrite the copy.
+ * OTF2 names compressed files differently, these are never copied.
+ */
+bool
+TraceWriter::copyLocation(const ArchiveLayout &input, OTF2_LocationRef location)
 {
-    bool filter_out = m_event_IoOperationIssued_filter.process(location, time, attributes, handle, matchingId);
-    if (!filter_out)
+    auto search = m_location_ordinals.find(location);
+    if (search == m_location_ordinals.end() || input.compression != OTF2_COMPRESSION_NONE ||
+        m_options.compression != OTF2_COMPRESSION_NONE || input.event_chunk_size != m_options.event_chunk_size ||
+        input.definition_chunk_size != m_options.definition_chunk_size || filters_location(location))
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoOperationIssued(event_writer, attributes, time, handle, matchingId);
+        return false;
     }
-}
 
-void
-TraceWriter::handleIoOperationCompleteEvent(OTF2_LocationRef    location,
-                                            OTF2_TimeStamp      time,
-                                            OTF2_AttributeList *attributes,
-                                            OTF2_IoHandleRef    handle,
-                                            uint64_t            bytesResult,
-                                            uint64_t            matchingId)
-{
-    bool filter_out =
-        m_event_IoOperationComplete_filter.process(location, time, attributes, handle, bytesResult, matchingId);
-    if (!filter_out)
+    const fs::path source(input.directory);
+    const fs::path target(m_directory);
+    const auto     events      = std::to_string(location) + ".evt";
+    const auto     definitions = std::to_string(location) + ".def";
+    std::error_code ec;
+    if (!fs::exists(source / events, ec) || (!fs::create_directories(target, ec) && ec))
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoOperationComplete(event_writer, attributes, time, handle, bytesResult, matchingId);
+        return false;
     }
-}
 
+    auto &event_writer = m_event_writers[search->second];
+    if (event_writer != nullptr)
+    {
+        OTF2_Archive_CloseEvtWriter(m_archive.get(), event_writer);
+        event_writer = nullptr;
+    }
+    if (!clone_file(source / events, target / events) ||
+        (fs::exists(source / definitions, ec) && !clone_file(source / definitions, target / definitions)))
+    {
+        fs::remove(target / events, ec);
+        if (!m_memory_limited)
+        {
+            event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
+        }
+        return false;
+    }
+    m_local_definitions_closed[search->second] = true;
+    if (m_options.stats != nullptr)
+    {
+        m_options.stats->add_copied_location();
+    }
+    return true;
+}
+
+bool
+TraceWriter::filters_location(OTF2_LocationRef location)
+{
+    return std::any_of(m_location_filters.begin(), m_location_filters.end(), [location](IFilterCallbacks *filter) {
+        return filter->affects_location(location);
+    });
+}
+
+std::vector<GlobalDefinition>
+TraceWriter::stringReferencingDefinitions()
+{
+    if (m_strings.mode() == StringTable::Mode::All)
+    {
+        return {};
+    }
+    return m_string_references;
+}
+
+void
+TraceWriter::handleStringReference(GlobalDefinition definition, OTF2_StringRef string)
+{
+    m_strings.reference(string);
+}
+
+/*
+ * Event writers are created for the locations, filters may keep state of
+ * the definitions they see and the string table is read by filters. All
+ * other definitions are only copied and can be written later.
+ */
+bool
+TraceWriter::eventsDependOn(GlobalDefinition definition)
+{
+    switch (definition)
+    {
+    case GlobalDefinition::Location:
+        return true;
+    case GlobalDefinition::String:
+        return m_strings.mode() == StringTable::Mode::All || !m_string_references.empty() ||
+               !m_global_String_filter.empty();
+    case GlobalDefinition::ClockProperties:
+        return !m_global_ClockProperties_filter.empty();
+    case GlobalDefinition::Paradigm:
+        return !m_global_Paradigm_filter.empty();
+    case GlobalDefinition::ParadigmProperty:
+        return !m_global_ParadigmProperty_filter.empty();
+    case GlobalDefinition::IoParadigm:
+        return !m_global_IoParadigm_filter.empty();
+    case GlobalDefinition::Attribute:
+        return !m_global_Attribute_filter.empty();
+    case GlobalDefinition::SystemTreeNode:
+        return !m_global_SystemTreeNode_filter.empty();
+    case GlobalDefinition::LocationGroup:
+        return !m_global_LocationGroup_filter.empty();
+    case GlobalDefinition::Region:
+        return !m_global_Region_filter.empty();
+    case GlobalDefinition::Callsite:
+        return !m_global_Callsite_filter.empty();
+    case GlobalDefinition::Callpath:
+        return !m_global_Callpath_filter.empty();
+    case GlobalDefinition::Group:
+        return !m_global_Group_filter.empty();
+    case GlobalDefinition::MetricMember:
+        return !m_global_MetricMember_filter.empty();
+    case GlobalDefinition::MetricClass:
+        return !m_global_MetricClass_filter.empty();
+    case GlobalDefinition::MetricInstance:
+        return !m_global_MetricInstance_filter.empty();
+    case GlobalDefinition::Comm:
+        return !m_global_Comm_filter.empty();
+    case GlobalDefinition::Parameter:
+        return !m_global_Parameter_filter.empty();
+    case GlobalDefinition::RmaWin:
+        return !m_global_RmaWin_filter.empty();
+    case GlobalDefinition::MetricClassRecorder:
+        return !m_global_MetricClassRecorder_filter.empty();
+    case GlobalDefinition::SystemTreeNodeProperty:
+        return !m_global_SystemTreeNodeProperty_filter.empty();
+    case GlobalDefinition::SystemTreeNodeDomain:
+        return !m_global_SystemTreeNodeDomain_filter.empty();
+    case GlobalDefinition::LocationGroupProperty:
+        return !m_global_LocationGroupProperty_filter.empty();
+    case GlobalDefinition::LocationProperty:
+        return !m_global_LocationProperty_filter.empty();
+    case GlobalDefinition::CartDimension:
+        return !m_global_CartDimension_filter.empty();
+    case GlobalDefinition::CartTopology:
+        return !m_global_CartTopology_filter.empty();
+    case GlobalDefinition::CartCoordinate:
+        return !m_global_CartCoordinate_filter.empty();
+    case GlobalDefinition::SourceCodeLocation:
+        return !m_global_SourceCodeLocation_filter.empty();
+    case GlobalDefinition::CallingContext:
+        return !m_global_CallingContext_filter.empty();
+    case GlobalDefinition::CallingContextProperty:
+        return !m_global_CallingContextProperty_filter.empty();
+    case GlobalDefinition::InterruptGenerator:
+        return !m_global_InterruptGenerator_filter.empty();
+    case GlobalDefinition::IoFileProperty:
+        return !m_global_IoFileProperty_filter.empty();
+    case GlobalDefinition::IoRegularFile:
+        return !m_global_IoRegularFile_filter.empty();
+    case GlobalDefinition::IoDirectory:
+        return !m_global_IoDirectory_filter.empty();
+    case GlobalDefinition::IoHandle:
+        return !m_global_IoHandle_filter.empty();
+    case GlobalDefinition::IoPreCreatedHandleState:
+        return !m_global_IoPreCreatedHandleState_filter.empty();
+    case GlobalDefinition::CallpathParameter:
+        return !m_global_CallpathParameter_filter.empty();
+    }
+    return true;
+}
+
+bool
+TraceWriter::selectsLocation(OTF2_LocationRef location)
+{
+    return m_dropped_locations.count(location) == 0;
+}
+
+bool
+TraceWriter::handlesEvent(EventType type)
+{
+    return !m_dropped_events[static_cast<std::size_t>(type)];
+}
+
+OTF2_TimeStamp
+TraceWriter::eventsBegin()
+{
+    return m_time_window.begin;
+}
+
+OTF2_TimeStamp
+TraceWriter::eventsEnd()
+{
+    return m_time_window.end;
+}
+
+bool
+TraceWriter::readsPastEnd(OTF2_LocationRef location)
+{
+    if (!m_balances_window || m_thread_window.owner != this)
+    {
+        return false;
+    }
+    const auto &open = m_thread_window.open;
+    return std::any_of(open.begin(), open.end(), [](const OpenRecord &record) {
+        return record.written && record.type != EventType::Enter;
+    });
+}
+
+/*
+ * Records opened before the time window are written at its begin, regions
+ * only if nothing was read in the window, see endLocation(). Filters can
+ * only drop records, the records a window cuts through are balanced here.
+ */
 void
-TraceWriter::handleIoOperationCancelledEvent(OTF2_LocationRef    location,
-                                             OTF2_TimeStamp      time,
-                                             OTF2_AttributeList *attributes,
-                                             OTF2_IoHandleRef    handle,
-                                             uint64_t            matchingId)
+TraceWriter::reopen_records(OTF2_LocationRef location, bool enters_only)
 {
-    bool filter_out = m_event_IoOperationCancelled_filter.process(location, time, attributes, handle, matchingId);
-    if (!filter_out)
+    m_thread_window.before = false;
+    for (auto &record : m_thread_window.open)
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoOperationCancelled(event_writer, attributes, time, handle, matchingId);
+        if (!record.kept || (enters_only && record.type != EventType::Enter))
+        {
+            continue;
+        }
+        record.written = true;
+        switch (record.type)
+        {
+        case EventType::Enter:
+            writeEnterEvent(location, m_time_window.begin, nullptr, record.region);
+            break;
+        case EventType::MpiCollectiveBegin:
+            writeMpiCollectiveBeginEvent(location, m_time_window.begin, nullptr);
+            break;
+        case EventType::IoOperationBegin:
+            writeIoOperationBeginEvent(location,
+                                       m_time_window.begin,
+                                       nullptr,
+                                       record.handle,
+                                       record.mode,
+                                       record.flags,
+                                       record.bytes_request,
+                                       record.matching_id);
+            break;
+        default:
+            break;
+        }
     }
 }
 
-void
-TraceWriter::handleIoAcquireLockEvent(OTF2_LocationRef    location,
-                                      OTF2_TimeStamp      time,
-                                      OTF2_AttributeList *attributes,
-                                      OTF2_IoHandleRef    handle,
-                                      OTF2_LockType       lockType)
+bool
+TraceWriter::open_record(OpenRecord record)
 {
-    bool filter_out = m_event_IoAcquireLock_filter.process(location, time, attributes, handle, lockType);
-    if (!filter_out)
+    record.written = record.kept && m_time_window.contains(record.time);
+    if (m_thread_window.owner == this)
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoAcquireLock(event_writer, attributes, time, handle, lockType);
+        m_thread_window.open.push_back(record);
     }
+    return !record.written;
 }
 
-void
-TraceWriter::handleIoReleaseLockEvent(OTF2_LocationRef    location,
-                                      OTF2_TimeStamp      time,
-                                      OTF2_AttributeList *attributes,
-                                      OTF2_IoHandleRef    handle,
-                                      OTF2_LockType       lockType)
+std::vector<TraceWriter::OpenRecord>::iterator
+TraceWriter::find_open(EventType type, OTF2_IoHandleRef handle, uint64_t matching_id)
 {
-    bool filter_out = m_event_IoReleaseLock_filter.process(location, time, attributes, handle, lockType);
-    if (!filter_out)
-    {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoReleaseLock(event_writer, attributes, time, handle, lockType);
-    }
+    return ::find_open(m_thread_window.open, type, handle, matching_id);
 }
 
-void
-TraceWriter::handleIoTryLockEvent(OTF2_LocationRef    location,
-                                  OTF2_TimeStamp      time,
-                                  OTF2_AttributeList *attributes,
-                                  OTF2_IoHandleRef    handle,
-                                  OTF2_LockType       lockType)
+bool
+TraceWriter::close_record(bool filtered, OTF2_TimeStamp &time, std::vector<OpenRecord>::iterator record)
 {
-    bool filter_out = m_event_IoTryLock_filter.process(location, time, attributes, handle, lockType);
-    if (!filter_out)
+    if (m_thread_window.owner != this)
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_IoTryLock(event_writer, attributes, time, handle, lockType);
+        return filtered;
     }
-}
-
-void
-TraceWriter::handleProgramBeginEvent(OTF2_LocationRef      location,
-                                     OTF2_TimeStamp        time,
-                                     OTF2_AttributeList *  attributes,
-                                     OTF2_StringRef        programName,
-                                     uint32_t              numberOfArguments,
-                                     const OTF2_StringRef *programArguments)
-{
-    bool filter_out = m_event_ProgramBegin_filter.process(
-        location, time, attributes, programName, numberOfArguments, programArguments);
-    if (!filter_out)
+    if (record == m_thread_window.open.end())
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ProgramBegin(event_writer, attributes, time, programName, numberOfArguments, programArguments);
+        /*
+         * Opened by no event read or replayed, the trace is not balanced.
+         */
+        return true;
     }
+    bool written = record->written;
+    m_thread_window.open.erase(record);
+    if (time > m_time_window.end)
+    {
+        time = m_time_window.end;
+        return !written;
+    }
+    return filtered || !written;
 }
 
 void
-TraceWriter::handleProgramEndEvent(OTF2_LocationRef    location,
-                                   OTF2_TimeStamp      time,
-                                   OTF2_AttributeList *attributes,
-                                   int64_t             exitStatus)
+TraceWriter::register_filter(IFilterCallbacks &filter, int priority)
 {
-    bool filter_out = m_event_ProgramEnd_filter.process(location, time, attributes, exitStatus);
-    if (!filter_out)
+    for (auto definition : filter.string_references())
     {
-        auto *event_writer = OTF2_Archive_GetEvtWriter(m_archive.get(), location);
-        OTF2_EvtWriter_ProgramEnd(event_writer, attributes, time, exitStatus);
+        if (definition == GlobalDefinition::String)
+        {
+            m_strings.set_mode(StringTable::Mode::All);
+        }
+        else if (std::find(m_string_references.begin(), m_string_references.end(), definition) ==
+                 m_string_references.end())
+        {
+            m_string_references.push_back(definition);
+        }
     }
-}
+    filter.set_string_table(m_strings);
 
-void
-TraceWriter::register_filter(IFilterCallbacks &filter)
-{
-    auto cbs = filter.get_callbacks();
+    restrict_time_window(filter.time_window());
+
+    auto cbs            = filter.get_callbacks();
+    bool handles_events = false;
 
     if (cbs.global_clock_properties_callback)
     {
-        m_global_ClockProperties_filter.add(cbs.global_clock_properties_callback);
+        m_global_ClockProperties_filter.add(cbs.global_clock_properties_callback, priority);
     }
     if (cbs.global_paradigm_callback)
     {
-        m_global_Paradigm_filter.add(cbs.global_paradigm_callback);
+        m_global_Paradigm_filter.add(cbs.global_paradigm_callback, priority);
     }
     if (cbs.global_paradigm_property_callback)
     {
-        m_global_ParadigmProperty_filter.add(cbs.global_paradigm_property_callback);
+        m_global_ParadigmProperty_filter.add(cbs.global_paradigm_property_callback, priority);
     }
     if (cbs.global_io_paradigm_callback)
     {
-        m_global_IoParadigm_filter.add(cbs.global_io_paradigm_callback);
+        m_global_IoParadigm_filter.add(cbs.global_io_paradigm_callback, priority);
     }
     if (cbs.global_string_callback)
     {
-        m_global_String_filter.add(cbs.global_string_callback);
+        m_global_String_filter.add(cbs.global_string_callback, priority);
     }
     if (cbs.global_attribute_callback)
     {
-        m_global_Attribute_filter.add(cbs.global_attribute_callback);
+        m_global_Attribute_filter.add(cbs.global_attribute_callback, priority);
     }
     if (cbs.global_system_tree_node_callback)
     {
-        m_global_SystemTreeNode_filter.add(cbs.global_system_tree_node_callback);
+        m_global_SystemTreeNode_filter.add(cbs.global_system_tree_node_callback, priority);
     }
     if (cbs.global_location_group_callback)
     {
-        m_global_LocationGroup_filter.add(cbs.global_location_group_callback);
+        m_global_LocationGroup_filter.add(cbs.global_location_group_callback, priority);
     }
     if (cbs.global_location_callback)
     {
-        m_global_Location_filter.add(cbs.global_location_callback);
+        m_global_Location_filter.add(cbs.global_location_callback, priority);
     }
     if (cbs.global_region_callback)
     {
-        m_global_Region_filter.add(cbs.global_region_callback);
+        m_global_Region_filter.add(cbs.global_region_callback, priority);
     }
     if (cbs.global_callsite_callback)
     {
-        m_global_Callsite_filter.add(cbs.global_callsite_callback);
+        m_global_Callsite_filter.add(cbs.global_callsite_callback, priority);
     }
     if (cbs.global_callpath_callback)
     {
-        m_global_Callpath_filter.add(cbs.global_callpath_callback);
+        m_global_Callpath_filter.add(cbs.global_callpath_callback, priority);
     }
     if (cbs.global_group_callback)
     {
-        m_global_Group_filter.add(cbs.global_group_callback);
+        m_global_Group_filter.add(cbs.global_group_callback, priority);
     }
     if (cbs.global_metric_member_callback)
     {
-        m_global_MetricMember_filter.add(cbs.global_metric_member_callback);
+        m_global_MetricMember_filter.add(cbs.global_metric_member_callback, priority);
     }
     if (cbs.global_metric_class_callback)
     {
-        m_global_MetricClass_filter.add(cbs.global_metric_class_callback);
+        m_global_MetricClass_filter.add(cbs.global_metric_class_callback, priority);
     }
     if (cbs.global_metric_instance_callback)
     {
-        m_global_MetricInstance_filter.add(cbs.global_metric_instance_callback);
+        m_global_MetricInstance_filter.add(cbs.global_metric_instance_callback, priority);
     }
     if (cbs.global_comm_callback)
     {
-        m_global_Comm_filter.add(cbs.global_comm_callback);
+        m_global_Comm_filter.add(cbs.global_comm_callback, priority);
     }
     if (cbs.global_parameter_callback)
     {
-        m_global_Parameter_filter.add(cbs.global_parameter_callback);
+        m_global_Parameter_filter.add(cbs.global_parameter_callback, priority);
     }
     if (cbs.global_rma_win_callback)
     {
-        m_global_RmaWin_filter.add(cbs.global_rma_win_callback);
+        m_global_RmaWin_filter.add(cbs.global_rma_win_callback, priority);
     }
     if (cbs.global_metric_class_recorder_callback)
     {
-        m_global_MetricClassRecorder_filter.add(cbs.global_metric_class_recorder_callback);
+        m_global_MetricClassRecorder_filter.add(cbs.global_metric_class_recorder_callback, priority);
     }
     if (cbs.global_system_tree_node_property_callback)
     {
-        m_global_SystemTreeNodeProperty_filter.add(cbs.global_system_tree_node_property_callback);
+        m_global_SystemTreeNodeProperty_filter.add(cbs.global_system_tree_node_property_callback, priority);
     }
     if (cbs.global_system_tree_node_domain_callback)
     {
-        m_global_SystemTreeNodeDomain_filter.add(cbs.global_system_tree_node_domain_callback);
+        m_global_SystemTreeNodeDomain_filter.add(cbs.global_system_tree_node_domain_callback, priority);
     }
     if (cbs.global_location_group_property_callback)
     {
-        m_global_LocationGroupProperty_filter.add(cbs.global_location_group_property_callback);
+        m_global_LocationGroupProperty_filter.add(cbs.global_location_group_property_callback, priority);
     }
     if (cbs.global_location_property_callback)
     {
-        m_global_LocationProperty_filter.add(cbs.global_location_property_callback);
+        m_global_LocationProperty_filter.add(cbs.global_location_property_callback, priority);
     }
     if (cbs.global_cart_dimension_callback)
     {
-        m_global_CartDimension_filter.add(cbs.global_cart_dimension_callback);
+        m_global_CartDimension_filter.add(cbs.global_cart_dimension_callback, priority);
     }
     if (cbs.global_cart_topology_callback)
     {
-        m_global_CartTopology_filter.add(cbs.global_cart_topology_callback);
+        m_global_CartTopology_filter.add(cbs.global_cart_topology_callback, priority);
     }
     if (cbs.global_cart_coordinate_callback)
     {
-        m_global_CartCoordinate_filter.add(cbs.global_cart_coordinate_callback);
+        m_global_CartCoordinate_filter.add(cbs.global_cart_coordinate_callback, priority);
     }
     if (cbs.global_source_code_location_callback)
     {
-        m_global_SourceCodeLocation_filter.add(cbs.global_source_code_location_callback);
+        m_global_SourceCodeLocation_filter.add(cbs.global_source_code_location_callback, priority);
     }
     if (cbs.global_calling_context_callback)
     {
-        m_global_CallingContext_filter.add(cbs.global_calling_context_callback);
+        m_global_CallingContext_filter.add(cbs.global_calling_context_callback, priority);
     }
     if (cbs.global_calling_context_property_callback)
     {
-        m_global_CallingContextProperty_filter.add(cbs.global_calling_context_property_callback);
+        m_global_CallingContextProperty_filter.add(cbs.global_calling_context_property_callback, priority);
     }
     if (cbs.global_interrupt_generator_callback)
     {
-        m_global_InterruptGenerator_filter.add(cbs.global_interrupt_generator_callback);
+        m_global_InterruptGenerator_filter.add(cbs.global_interrupt_generator_callback, priority);
     }
     if (cbs.global_io_file_property_callback)
     {
-        m_global_IoFileProperty_filter.add(cbs.global_io_file_property_callback);
+        m_global_IoFileProperty_filter.add(cbs.global_io_file_property_callback, priority);
     }
     if (cbs.global_io_regular_file_callback)
     {
-        m_global_IoRegularFile_filter.add(cbs.global_io_regular_file_callback);
+        m_global_IoRegularFile_filter.add(cbs.global_io_regular_file_callback, priority);
     }
     if (cbs.global_io_directory_callback)
     {
-        m_global_IoDirectory_filter.add(cbs.global_io_directory_callback);
+        m_global_IoDirectory_filter.add(cbs.global_io_directory_callback, priority);
     }
     if (cbs.global_io_handle_callback)
     {
-        m_global_IoHandle_filter.add(cbs.global_io_handle_callback);
+        m_global_IoHandle_filter.add(cbs.global_io_handle_callback, priority);
     }
     if (cbs.global_io_pre_created_handle_state_callback)
     {
-        m_global_IoPreCreatedHandleState_filter.add(cbs.global_io_pre_created_handle_state_callback);
+        m_global_IoPreCreatedHandleState_filter.add(cbs.global_io_pre_created_handle_state_callback, priority);
     }
     if (cbs.global_callpath_parameter_callback)
     {
-        m_global_CallpathParameter_filter.add(cbs.global_callpath_parameter_callback);
+        m_global_CallpathParameter_filter.add(cbs.global_callpath_parameter_callback, priority);
     }
 
     if (cbs.event_buffer_flush_callback)
     {
-        m_event_BufferFlush_filter.add(cbs.event_buffer_flush_callback);
+        m_event_BufferFlush_filter.add(cbs.event_buffer_flush_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_measurement_on_off_callback)
     {
-        m_event_MeasurementOnOff_filter.add(cbs.event_measurement_on_off_callback);
+        m_event_MeasurementOnOff_filter.add(cbs.event_measurement_on_off_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_enter_callback)
     {
-        m_event_Enter_filter.add(cbs.event_enter_callback);
+        m_event_Enter_filter.add(cbs.event_enter_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_leave_callback)
     {
-        m_event_Leave_filter.add(cbs.event_leave_callback);
+        m_event_Leave_filter.add(cbs.event_leave_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_send_callback)
     {
-        m_event_MpiSend_filter.add(cbs.event_mpi_send_callback);
+        m_event_MpiSend_filter.add(cbs.event_mpi_send_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_isend_callback)
     {
-        m_event_MpiIsend_filter.add(cbs.event_mpi_isend_callback);
+        m_event_MpiIsend_filter.add(cbs.event_mpi_isend_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_isend_complete_callback)
     {
-        m_event_MpiIsendComplete_filter.add(cbs.event_mpi_isend_complete_callback);
+        m_event_MpiIsendComplete_filter.add(cbs.event_mpi_isend_complete_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_irecv_request_callback)
     {
-        m_event_MpiIrecvRequest_filter.add(cbs.event_mpi_irecv_request_callback);
+        m_event_MpiIrecvRequest_filter.add(cbs.event_mpi_irecv_request_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_recv_callback)
     {
-        m_event_MpiRecv_filter.add(cbs.event_mpi_recv_callback);
+        m_event_MpiRecv_filter.add(cbs.event_mpi_recv_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_irecv_callback)
     {
-        m_event_MpiIrecv_filter.add(cbs.event_mpi_irecv_callback);
+        m_event_MpiIrecv_filter.add(cbs.event_mpi_irecv_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_request_test_callback)
     {
-        m_event_MpiRequestTest_filter.add(cbs.event_mpi_request_test_callback);
+        m_event_MpiRequestTest_filter.add(cbs.event_mpi_request_test_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_request_cancelled_callback)
     {
-        m_event_MpiRequestCancelled_filter.add(cbs.event_mpi_request_cancelled_callback);
+        m_event_MpiRequestCancelled_filter.add(cbs.event_mpi_request_cancelled_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_collective_begin_callback)
     {
-        m_event_MpiCollectiveBegin_filter.add(cbs.event_mpi_collective_begin_callback);
+        m_event_MpiCollectiveBegin_filter.add(cbs.event_mpi_collective_begin_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_mpi_collective_end_callback)
     {
-        m_event_MpiCollectiveEnd_filter.add(cbs.event_mpi_collective_end_callback);
+        m_event_MpiCollectiveEnd_filter.add(cbs.event_mpi_collective_end_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_fork_callback)
     {
-        m_event_OmpFork_filter.add(cbs.event_omp_fork_callback);
+        m_event_OmpFork_filter.add(cbs.event_omp_fork_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_join_callback)
     {
-        m_event_OmpJoin_filter.add(cbs.event_omp_join_callback);
+        m_event_OmpJoin_filter.add(cbs.event_omp_join_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_acquire_lock_callback)
     {
-        m_event_OmpAcquireLock_filter.add(cbs.event_omp_acquire_lock_callback);
+        m_event_OmpAcquireLock_filter.add(cbs.event_omp_acquire_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_release_lock_callback)
     {
-        m_event_OmpReleaseLock_filter.add(cbs.event_omp_release_lock_callback);
+        m_event_OmpReleaseLock_filter.add(cbs.event_omp_release_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_task_create_callback)
     {
-        m_event_OmpTaskCreate_filter.add(cbs.event_omp_task_create_callback);
+        m_event_OmpTaskCreate_filter.add(cbs.event_omp_task_create_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_task_switch_callback)
     {
-        m_event_OmpTaskSwitch_filter.add(cbs.event_omp_task_switch_callback);
+        m_event_OmpTaskSwitch_filter.add(cbs.event_omp_task_switch_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_omp_task_complete_callback)
     {
-        m_event_OmpTaskComplete_filter.add(cbs.event_omp_task_complete_callback);
+        m_event_OmpTaskComplete_filter.add(cbs.event_omp_task_complete_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_metric_callback)
     {
-        m_event_Metric_filter.add(cbs.event_metric_callback);
+        m_event_Metric_filter.add(cbs.event_metric_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_parameter_string_callback)
     {
-        m_event_ParameterString_filter.add(cbs.event_parameter_string_callback);
+        m_event_ParameterString_filter.add(cbs.event_parameter_string_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_parameter_int_callback)
     {
-        m_event_ParameterInt_filter.add(cbs.event_parameter_int_callback);
+        m_event_ParameterInt_filter.add(cbs.event_parameter_int_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_parameter_unsigned_int_callback)
     {
-        m_event_ParameterUnsignedInt_filter.add(cbs.event_parameter_unsigned_int_callback);
+        m_event_ParameterUnsignedInt_filter.add(cbs.event_parameter_unsigned_int_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_win_create_callback)
     {
-        m_event_RmaWinCreate_filter.add(cbs.event_rma_win_create_callback);
+        m_event_RmaWinCreate_filter.add(cbs.event_rma_win_create_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_win_destroy_callback)
     {
-        m_event_RmaWinDestroy_filter.add(cbs.event_rma_win_destroy_callback);
+        m_event_RmaWinDestroy_filter.add(cbs.event_rma_win_destroy_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_collective_begin_callback)
     {
-        m_event_RmaCollectiveBegin_filter.add(cbs.event_rma_collective_begin_callback);
+        m_event_RmaCollectiveBegin_filter.add(cbs.event_rma_collective_begin_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_collective_end_callback)
     {
-        m_event_RmaCollectiveEnd_filter.add(cbs.event_rma_collective_end_callback);
+        m_event_RmaCollectiveEnd_filter.add(cbs.event_rma_collective_end_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_group_sync_callback)
     {
-        m_event_RmaGroupSync_filter.add(cbs.event_rma_group_sync_callback);
+        m_event_RmaGroupSync_filter.add(cbs.event_rma_group_sync_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_request_lock_callback)
     {
-        m_event_RmaRequestLock_filter.add(cbs.event_rma_request_lock_callback);
+        m_event_RmaRequestLock_filter.add(cbs.event_rma_request_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_acquire_lock_callback)
     {
-        m_event_RmaAcquireLock_filter.add(cbs.event_rma_acquire_lock_callback);
+        m_event_RmaAcquireLock_filter.add(cbs.event_rma_acquire_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_try_lock_callback)
     {
-        m_event_RmaTryLock_filter.add(cbs.event_rma_try_lock_callback);
+        m_event_RmaTryLock_filter.add(cbs.event_rma_try_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_release_lock_callback)
     {
-        m_event_RmaReleaseLock_filter.add(cbs.event_rma_release_lock_callback);
+        m_event_RmaReleaseLock_filter.add(cbs.event_rma_release_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_sync_callback)
     {
-        m_event_RmaSync_filter.add(cbs.event_rma_sync_callback);
+        m_event_RmaSync_filter.add(cbs.event_rma_sync_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_wait_change_callback)
     {
-        m_event_RmaWaitChange_filter.add(cbs.event_rma_wait_change_callback);
+        m_event_RmaWaitChange_filter.add(cbs.event_rma_wait_change_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_put_callback)
     {
-        m_event_RmaPut_filter.add(cbs.event_rma_put_callback);
+        m_event_RmaPut_filter.add(cbs.event_rma_put_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_get_callback)
     {
-        m_event_RmaGet_filter.add(cbs.event_rma_get_callback);
+        m_event_RmaGet_filter.add(cbs.event_rma_get_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_atomic_callback)
     {
-        m_event_RmaAtomic_filter.add(cbs.event_rma_atomic_callback);
+        m_event_RmaAtomic_filter.add(cbs.event_rma_atomic_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_op_complete_blocking_callback)
     {
-        m_event_RmaOpCompleteBlocking_filter.add(cbs.event_rma_op_complete_blocking_callback);
+        m_event_RmaOpCompleteBlocking_filter.add(cbs.event_rma_op_complete_blocking_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_op_complete_non_blocking_callback)
     {
-        m_event_RmaOpCompleteNonBlocking_filter.add(cbs.event_rma_op_complete_non_blocking_callback);
+        m_event_RmaOpCompleteNonBlocking_filter.add(cbs.event_rma_op_complete_non_blocking_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_op_test_callback)
     {
-        m_event_RmaOpTest_filter.add(cbs.event_rma_op_test_callback);
+        m_event_RmaOpTest_filter.add(cbs.event_rma_op_test_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_rma_op_complete_remote_callback)
     {
-        m_event_RmaOpCompleteRemote_filter.add(cbs.event_rma_op_complete_remote_callback);
+        m_event_RmaOpCompleteRemote_filter.add(cbs.event_rma_op_complete_remote_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_fork_callback)
     {
-        m_event_ThreadFork_filter.add(cbs.event_thread_fork_callback);
+        m_event_ThreadFork_filter.add(cbs.event_thread_fork_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_join_callback)
     {
-        m_event_ThreadJoin_filter.add(cbs.event_thread_join_callback);
+        m_event_ThreadJoin_filter.add(cbs.event_thread_join_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_team_begin_callback)
     {
-        m_event_ThreadTeamBegin_filter.add(cbs.event_thread_team_begin_callback);
+        m_event_ThreadTeamBegin_filter.add(cbs.event_thread_team_begin_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_team_end_callback)
     {
-        m_event_ThreadTeamEnd_filter.add(cbs.event_thread_team_end_callback);
+        m_event_ThreadTeamEnd_filter.add(cbs.event_thread_team_end_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_acquire_lock_callback)
     {
-        m_event_ThreadAcquireLock_filter.add(cbs.event_thread_acquire_lock_callback);
+        m_event_ThreadAcquireLock_filter.add(cbs.event_thread_acquire_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_release_lock_callback)
     {
-        m_event_ThreadReleaseLock_filter.add(cbs.event_thread_release_lock_callback);
+        m_event_ThreadReleaseLock_filter.add(cbs.event_thread_release_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_task_create_callback)
     {
-        m_event_ThreadTaskCreate_filter.add(cbs.event_thread_task_create_callback);
+        m_event_ThreadTaskCreate_filter.add(cbs.event_thread_task_create_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_task_switch_callback)
     {
-        m_event_ThreadTaskSwitch_filter.add(cbs.event_thread_task_switch_callback);
+        m_event_ThreadTaskSwitch_filter.add(cbs.event_thread_task_switch_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_task_complete_callback)
     {
-        m_event_ThreadTaskComplete_filter.add(cbs.event_thread_task_complete_callback);
+        m_event_ThreadTaskComplete_filter.add(cbs.event_thread_task_complete_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_create_callback)
     {
-        m_event_ThreadCreate_filter.add(cbs.event_thread_create_callback);
+        m_event_ThreadCreate_filter.add(cbs.event_thread_create_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_begin_callback)
     {
-        m_event_ThreadBegin_filter.add(cbs.event_thread_begin_callback);
+        m_event_ThreadBegin_filter.add(cbs.event_thread_begin_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_wait_callback)
     {
-        m_event_ThreadWait_filter.add(cbs.event_thread_wait_callback);
+        m_event_ThreadWait_filter.add(cbs.event_thread_wait_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_thread_end_callback)
     {
-        m_event_ThreadEnd_filter.add(cbs.event_thread_end_callback);
+        m_event_ThreadEnd_filter.add(cbs.event_thread_end_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_calling_context_enter_callback)
     {
-        m_event_CallingContextEnter_filter.add(cbs.event_calling_context_enter_callback);
+        m_event_CallingContextEnter_filter.add(cbs.event_calling_context_enter_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_calling_context_leave_callback)
     {
-        m_event_CallingContextLeave_filter.add(cbs.event_calling_context_leave_callback);
+        m_event_CallingContextLeave_filter.add(cbs.event_calling_context_leave_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_calling_context_sample_callback)
     {
-        m_event_CallingContextSample_filter.add(cbs.event_calling_context_sample_callback);
+        m_event_CallingContextSample_filter.add(cbs.event_calling_context_sample_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_create_handle_callback)
     {
-        m_event_IoCreateHandle_filter.add(cbs.event_io_create_handle_callback);
+        m_event_IoCreateHandle_filter.add(cbs.event_io_create_handle_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_destroy_handle_callback)
     {
-        m_event_IoDestroyHandle_filter.add(cbs.event_io_destroy_handle_callback);
+        m_event_IoDestroyHandle_filter.add(cbs.event_io_destroy_handle_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_duplicate_handle_callback)
     {
-        m_event_IoDuplicateHandle_filter.add(cbs.event_io_duplicate_handle_callback);
+        m_event_IoDuplicateHandle_filter.add(cbs.event_io_duplicate_handle_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_seek_callback)
     {
-        m_event_IoSeek_filter.add(cbs.event_io_seek_callback);
+        m_event_IoSeek_filter.add(cbs.event_io_seek_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_change_status_flags_callback)
     {
-        m_event_IoChangeStatusFlags_filter.add(cbs.event_io_change_status_flags_callback);
+        m_event_IoChangeStatusFlags_filter.add(cbs.event_io_change_status_flags_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_delete_file_callback)
     {
-        m_event_IoDeleteFile_filter.add(cbs.event_io_delete_file_callback);
+        m_event_IoDeleteFile_filter.add(cbs.event_io_delete_file_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_operation_begin_callback)
     {
-        m_event_IoOperationBegin_filter.add(cbs.event_io_operation_begin_callback);
+        m_event_IoOperationBegin_filter.add(cbs.event_io_operation_begin_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_operation_test_callback)
     {
-        m_event_IoOperationTest_filter.add(cbs.event_io_operation_test_callback);
+        m_event_IoOperationTest_filter.add(cbs.event_io_operation_test_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_operation_issued_callback)
     {
-        m_event_IoOperationIssued_filter.add(cbs.event_io_operation_issued_callback);
+        m_event_IoOperationIssued_filter.add(cbs.event_io_operation_issued_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_operation_complete_callback)
     {
-        m_event_IoOperationComplete_filter.add(cbs.event_io_operation_complete_callback);
+        m_event_IoOperationComplete_filter.add(cbs.event_io_operation_complete_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_operation_cancelled_callback)
     {
-        m_event_IoOperationCancelled_filter.add(cbs.event_io_operation_cancelled_callback);
+        m_event_IoOperationCancelled_filter.add(cbs.event_io_operation_cancelled_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_acquire_lock_callback)
     {
-        m_event_IoAcquireLock_filter.add(cbs.event_io_acquire_lock_callback);
+        m_event_IoAcquireLock_filter.add(cbs.event_io_acquire_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_release_lock_callback)
     {
-        m_event_IoReleaseLock_filter.add(cbs.event_io_release_lock_callback);
+        m_event_IoReleaseLock_filter.add(cbs.event_io_release_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_io_try_lock_callback)
     {
-        m_event_IoTryLock_filter.add(cbs.event_io_try_lock_callback);
+        m_event_IoTryLock_filter.add(cbs.event_io_try_lock_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_program_begin_callback)
     {
-        m_event_ProgramBegin_filter.add(cbs.event_program_begin_callback);
+        m_event_ProgramBegin_filter.add(cbs.event_program_begin_callback, priority);
+        handles_events = true;
     }
     if (cbs.event_program_end_callback)
     {
-        m_event_ProgramEnd_filter.add(cbs.event_program_end_callback);
+        m_event_ProgramEnd_filter.add(cbs.event_program_end_callback, priority);
+        handles_events = true;
+    }
+
+    /*
+     * Locations with events of dropped types cannot be copied.
+     */
+    for (auto type : filter.dropped_event_types())
+    {
+        m_dropped_events[static_cast<std::size_t>(type)] = true;
+        handles_events = true;
+    }
+    for (auto type : filter.dropped_attribute_types())
+    {
+        m_dropped_attribute_types[type] = true;
+        m_drops_attributes = true;
+        handles_events = true;
+    }
+
+    if (handles_events)
+    {
+        m_location_filters.push_back(&filter);
     }
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <chunk_pool.hpp>
+
+TEST_CASE("Test chunks are recycled", "[chunk_pool_recycle]")
+{
+    constexpr uint64_t chunk_size = 256 * 1024;
+    ChunkPool          pool;
+
+    void *chunk = pool.allocate(chunk_size);
+    REQUIRE(chunk != nullptr);
+    REQUIRE(pool.reserved() == ChunkPool::huge_page_size);
+    std::memset(chunk, 0xff, chunk_size);
+
+    pool.release(chunk, chunk_size);
+    REQUIRE(pool.allocate(chunk_size) == chunk);
+
+    /* one slab holds eight chunks of this size */
+    std::set<void *> chunks{chunk};
+    for (int i = 1; i < 8; i++)
+    {
+        chunks.insert(pool.allocate(chunk_size));
+    }
+    REQUIRE(chunks.size() == 8);
+    REQUIRE(pool.reserved() == ChunkPool::huge_page_size);
+
+    chunks.insert(pool.allocate(chunk_size));
+    REQUIRE(chunks.size() == 9);
+    REQUIRE(pool.reserved() == 2 * ChunkPool::huge_page_size);
+}
+
+TEST_CASE("Test chunk sizes are kept apart", "[chunk_pool_sizes]")
+{
+    ChunkPool pool;
+
+    void *small = pool.allocate(256 * 1024);
+    void *large = pool.allocate(4 * 1024 * 1024);
+    REQUIRE(pool.reserved() == ChunkPool::huge_page_size + 4 * 1024 * 1024);
+
+    pool.release(large, 4 * 1024 * 1024);
+    REQUIRE(pool.allocate(256 * 1024) != large);
+    pool.release(small, 256 * 1024);
+    REQUIRE(pool.allocate(4 * 1024 * 1024) == large);
+}
+
+TEST_CASE("Test huge page slabs", "[chunk_pool_huge_pages]")
+{
+    ChunkPool pool(true);
+
+    void *chunk = pool.allocate(3 * 1024 * 1024);
+    REQUIRE(chunk != nullptr);
+    REQUIRE(reinterpret_cast<uintptr_t>(chunk) % ChunkPool::huge_page_size == 0);
+    REQUIRE(pool.reserved() == 2 * ChunkPool::huge_page_size);
+}
+
+TEST_CASE("Test chunks move between threads", "[chunk_pool_threads]")
+{
+    constexpr uint64_t chunk_size = 1024 * 1024;
+    ChunkPool          pool;
+
+    std::vector<void *> chunks;
+    std::thread         producer([&]() {
+        for (int i = 0; i < 64; i++)
+        {
+            chunks.push_back(pool.allocate(chunk_size));
+        }
+        for (auto *chunk : chunks)
+        {
+            pool.release(chunk, chunk_size);
+        }
+    });
+    producer.join();
+    auto reserved = pool.reserved();
+
+    /* chunks beyond the cache of the producer are shared */
+    std::thread consumer([&]() {
+        for (int i = 0; i < 32; i++)
+        {
+            REQUIRE(pool.allocate(chunk_size) != nullptr);
+        }
+    });
+    consumer.join();
+    REQUIRE(pool.reserved() == reserved);
+}
+
+TEST_CASE("Test memory limit", "[chunk_pool_memory_limit]")
+{
+    constexpr uint64_t chunk_size = 1024 * 1024;
+    ChunkPool          pool(false, 1, 2 * ChunkPool::huge_page_size);
+
+    std::vector<void *> chunks;
+    for (int i = 0; i < 4; i++)
+    {
+        chunks.push_back(pool.allocate(chunk_size, false));
+        REQUIRE(chunks.back() != nullptr);
+    }
+    REQUIRE(pool.allocate(chunk_size, false) == nullptr);
+
+    /* released chunks are available to every thread */
+    pool.release(chunks.back(), chunk_size);
+    std::thread other([&]() { REQUIRE(pool.allocate(chunk_size, false) == chunks.back()); });
+    other.join();
+
+    REQUIRE(pool.allocate(chunk_size, true) != nullptr);
+    REQUIRE(pool.reserved() == 3 * ChunkPool::huge_page_size);
+}
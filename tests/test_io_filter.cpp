@@ -1,13 +1,28 @@
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
 #include <ios>
 #include <string>
 #include <iostream>
+#include <random>
+#include <vector>
 
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <dense_ref_set.hpp>
+#include <glob_matcher.hpp>
 #include <io_file_filter.hpp>
+#include <location_index.hpp>
+#include <location_selection.hpp>
+#include <record_class_filter.hpp>
+#include <region_filter.hpp>
+#include <string_table.hpp>
+
+extern "C"
+{
+#include <fnmatch.h>
+}
 
 namespace fs = std::filesystem;
 
@@ -37,4 +52,510 @@ TEST_CASE("Test IoFilterPattern", "[init]")
 
     const std::string proc_file = "/proc/self/1000";
     REQUIRE(ifp.filterFile(proc_file));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test DenseRefSet", "[dense_ref_set]")
+{
+    DenseRefSet refs;
+    REQUIRE(refs.empty());
+    REQUIRE(! refs.contains(0));
+
+    refs.insert(0);
+    refs.insert(63);
+    refs.insert(64);
+    refs.insert(1000);
+
+    REQUIRE(refs.contains(0));
+    REQUIRE(refs.contains(63));
+    REQUIRE(refs.contains(64));
+    REQUIRE(refs.contains(1000));
+    REQUIRE(! refs.contains(1));
+    REQUIRE(! refs.contains(65));
+    REQUIRE(! refs.contains(1001));
+    REQUIRE(! refs.contains(OTF2_UNDEFINED_IO_HANDLE));
+    REQUIRE(! refs.contains(OTF2_UNDEFINED_UINT64));
+}
+
+bool fnmatch_any(const std::vector<std::string> & patterns, const std::string & path)
+{
+    for (const auto & p : patterns)
+    {
+        if (fnmatch(p.c_str(), path.c_str(), FNM_PATHNAME | FNM_LEADING_DIR) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE("Test GlobMatcher against fnmatch", "[glob_matcher]")
+{
+    const std::vector<std::string> patterns = {
+        "/proc/*", "/home/bar/foo.txt", "/usr/lib*/lib?.so", "/tmp/[a-c]*/x",
+        "/scratch/[!0-9]*", "/sys/*/*/power", "*.log", "/data/\\*literal",
+        "/opt/[[:digit:]][[:alpha:]]", "/var/[]a]", "/var/[a-]b", "/broken/[ab",
+        "/escape\\", "/star/*\\/x", "/etc/**/conf", "/mnt/[^a]?", ""};
+
+    const std::vector<std::string> paths = {
+        "", "/", "/proc", "/proc/", "/proc/self/1000", "/home/bar/foo.txt",
+        "/home/bar/foo.txt/sub", "/home/bar/foo.txt2", "/usr/lib64/libc.so",
+        "/usr/lib/libm.so", "/usr/lib/libmm.so", "/tmp/b/x", "/tmp/bq/x/y",
+        "/tmp/d/x", "/scratch/a1", "/scratch/1a", "/sys/a/b/power",
+        "/sys/a/power", "x.log", "dir/x.log", "/data/*literal", "/data/xliteral",
+        "/opt/1a", "/opt/a1", "/var/]", "/var/a", "/var/-b", "/broken/[ab",
+        "/broken/a", "/escape", "/star/a/x", "/etc/a/conf", "/etc/a/b/conf",
+        "/mnt/ba", "/mnt/ab", "relative/path"};
+
+    GlobMatcher matcher(patterns);
+    REQUIRE(matcher.size() == patterns.size());
+
+    for (const auto & path : paths)
+    {
+        INFO("path: " << path);
+        REQUIRE(matcher.match(path) == fnmatch_any(patterns, path));
+
+        std::vector<std::size_t> indices;
+        matcher.matches(path, indices);
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < patterns.size(); ++i)
+        {
+            if (fnmatch(patterns[i].c_str(), path.c_str(), FNM_PATHNAME | FNM_LEADING_DIR) == 0)
+            {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(indices == expected);
+    }
+}
+
+TEST_CASE("Test GlobMatcher with random patterns", "[glob_matcher]")
+{
+    const std::string pattern_chars = "ab/*?[]!-\\";
+    const std::string path_chars = "ab/";
+    std::mt19937 gen(42);
+    auto random_string = [&gen](const std::string & alphabet, std::size_t max_length) {
+        std::uniform_int_distribution<std::size_t> length(0, max_length);
+        std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+        std::string s(length(gen), ' ');
+        for (auto & c : s)
+        {
+            c = alphabet[pick(gen)];
+        }
+        return s;
+    };
+
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<std::string> patterns;
+        for (int i = 0; i < 8; ++i)
+        {
+            patterns.push_back(random_string(pattern_chars, 8));
+        }
+        GlobMatcher matcher(patterns);
+        for (int i = 0; i < 50; ++i)
+        {
+            auto path = random_string(path_chars, 10);
+            INFO("path: " << path);
+            std::vector<std::size_t> indices;
+            matcher.matches(path, indices);
+            for (std::size_t p = 0; p < patterns.size(); ++p)
+            {
+                INFO("pattern: " << patterns[p]);
+                bool expected = fnmatch(patterns[p].c_str(), path.c_str(), FNM_PATHNAME | FNM_LEADING_DIR) == 0;
+                REQUIRE(std::binary_search(indices.begin(), indices.end(), p) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test StringTable", "[string_table]")
+{
+    SECTION("all strings")
+    {
+        StringTable strings(StringTable::Mode::All, 16);
+        REQUIRE(strings.add(0, "/proc/self"));
+        REQUIRE(strings.add(3, "a string longer than a block"));
+        REQUIRE(strings.add(2, "short"));
+        REQUIRE(strings.add(5, "second block"));
+        REQUIRE(! strings.add(OTF2_UNDEFINED_STRING, "undefined"));
+
+        REQUIRE(strings.size() == 4);
+        REQUIRE(std::string(strings.get(0)) == "/proc/self");
+        REQUIRE(std::string(strings.get(2)) == "short");
+        REQUIRE(std::string(strings.get(3)) == "a string longer than a block");
+        REQUIRE(std::string(strings.get(5)) == "second block");
+        REQUIRE(strings.get(1) == nullptr);
+        REQUIRE(strings.get(6) == nullptr);
+        REQUIRE(strings.get(OTF2_UNDEFINED_STRING) == nullptr);
+    }
+
+    SECTION("referenced strings")
+    {
+        StringTable strings(StringTable::Mode::Referenced);
+        strings.reference(1);
+        REQUIRE(! strings.add(0, "region"));
+        REQUIRE(strings.add(1, "/home/bar/foo.txt"));
+
+        REQUIRE(strings.size() == 1);
+        REQUIRE(strings.get(0) == nullptr);
+        REQUIRE(std::string(strings.get(1)) == "/home/bar/foo.txt");
+    }
+}
+
+TEST_CASE("Test IoFileFilter location scopes", "[affects_location]")
+{
+    auto temp = fs::temp_directory_path();
+    temp += "/io_filter_pattern.txt";
+    create_pattern_file(temp);
+
+    IoFileFilter filter(temp);
+    auto c = filter.get_callbacks();
+
+    /* two processes on two nodes, one thread each */
+    c.global_string_callback(0, "/proc/self/1000");
+    c.global_string_callback(1, "/tmp/output.txt");
+    c.global_system_tree_node_callback(0, 0, 0, OTF2_UNDEFINED_SYSTEM_TREE_NODE);
+    c.global_system_tree_node_callback(1, 0, 0, 0);
+    c.global_system_tree_node_callback(2, 0, 0, 0);
+    c.global_location_group_callback(0, 0, OTF2_LOCATION_GROUP_TYPE_PROCESS, 1);
+    c.global_location_group_callback(1, 0, OTF2_LOCATION_GROUP_TYPE_PROCESS, 2);
+    c.global_location_callback(0, 0, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 0);
+    c.global_location_callback(1, 0, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 1);
+
+    SECTION("no filtered file")
+    {
+        REQUIRE(! c.global_io_regular_file_callback(0, 1, OTF2_UNDEFINED_SYSTEM_TREE_NODE));
+        REQUIRE(! filter.affects_location(0));
+        REQUIRE(! filter.affects_location(1));
+    }
+
+    SECTION("handle scoped to a rank")
+    {
+        const uint64_t locations[] = {0, 1};
+        const uint64_t ranks[]     = {0};
+        c.global_group_callback(0, 0, OTF2_GROUP_TYPE_COMM_LOCATIONS, OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE, 2, locations);
+        c.global_group_callback(1, 0, OTF2_GROUP_TYPE_COMM_GROUP, OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE, 1, ranks);
+        c.global_comm_callback(0, 0, 1, OTF2_UNDEFINED_COMM);
+
+        /* the file is local to the node of the first process */
+        REQUIRE(c.global_io_regular_file_callback(0, 0, 1));
+        REQUIRE(c.global_io_handle_callback(0, 0, 0, 0, OTF2_IO_HANDLE_FLAG_NONE, 0, OTF2_UNDEFINED_IO_HANDLE));
+        REQUIRE(filter.affects_location(0));
+        REQUIRE(! filter.affects_location(1));
+    }
+
+    SECTION("handle without scope")
+    {
+        REQUIRE(c.global_io_regular_file_callback(0, 0, 1));
+        REQUIRE(c.global_io_handle_callback(0, 0, 0, 0, OTF2_IO_HANDLE_FLAG_NONE, OTF2_UNDEFINED_COMM, OTF2_UNDEFINED_IO_HANDLE));
+        REQUIRE(filter.affects_location(0));
+        REQUIRE(filter.affects_location(1));
+    }
+}
+
+TEST_CASE("Test LocationIndex", "[location_index]")
+{
+    /* a trace with the event file of one location */
+    auto trace = fs::temp_directory_path() / "index_trace.otf2";
+    fs::create_directories(fs::temp_directory_path() / "index_trace");
+    {
+        std::ofstream evt(fs::temp_directory_path() / "index_trace/0.evt", std::ios::out | std::ios::trunc);
+        evt << "events";
+    }
+
+    LocationUsage reader;
+    reader.event_file_size = 6;
+    reader.event_counts.assign(static_cast<std::size_t>(EventType::ProgramEnd) + 1, 0);
+    reader.event_counts[static_cast<std::size_t>(EventType::IoOperationBegin)] = 4;
+    reader.io_handles = {3, 5};
+    reader.io_files   = {1};
+
+    LocationUsage writer = reader;
+    writer.io_handles    = {7};
+    writer.io_files      = {2};
+
+    LocationIndex index;
+    index.add(0, reader);
+    index.add(1, writer);
+    REQUIRE(std::string(LocationIndex::event_name(EventType::IoOperationBegin)) == "IoOperationBegin");
+    REQUIRE(LocationIndex::path_of(trace) == fs::temp_directory_path() / "index_trace.index");
+
+    index.write(LocationIndex::path_of(trace));
+    auto read = LocationIndex::read(LocationIndex::path_of(trace), trace);
+
+    /* location 1 has no event file, its entry is not trusted */
+    REQUIRE(read.size() == 1);
+    REQUIRE(read.find(1) == nullptr);
+    const auto *usage = read.find(0);
+    REQUIRE(usage != nullptr);
+    REQUIRE(usage->event_file_size == 6);
+    REQUIRE(usage->event_counts == reader.event_counts);
+    REQUIRE(usage->io_handles == reader.io_handles);
+    REQUIRE(usage->io_files == reader.io_files);
+
+    SECTION("filter with index")
+    {
+        auto pattern = fs::temp_directory_path() / "io_filter_pattern.txt";
+        create_pattern_file(pattern);
+
+        IoFileFilter filter(pattern);
+        auto c = filter.get_callbacks();
+        c.global_string_callback(0, "/proc/self/1000");
+        c.global_location_callback(0, 0, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 0);
+        c.global_location_callback(2, 0, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 0);
+        REQUIRE(c.global_io_regular_file_callback(1, 0, OTF2_UNDEFINED_SYSTEM_TREE_NODE));
+        REQUIRE(c.global_io_handle_callback(9, 0, 1, 0, OTF2_IO_HANDLE_FLAG_NONE, OTF2_UNDEFINED_COMM, OTF2_UNDEFINED_IO_HANDLE));
+
+        /* without an index the unscoped handle may be used anywhere */
+        REQUIRE(filter.affects_location(0));
+        filter.set_location_index(read);
+        REQUIRE(filter.affects_location(0));
+        REQUIRE(filter.affects_location(2));
+
+        index = LocationIndex();
+        writer.event_file_size = 6;
+        index.add(0, writer);
+        filter.set_location_index(index);
+        REQUIRE(! filter.affects_location(0));
+    }
+
+    SECTION("invalid index")
+    {
+        std::ofstream out(LocationIndex::path_of(trace), std::ios::out | std::ios::trunc);
+        out << "no index\n";
+        out.close();
+        REQUIRE_THROWS(LocationIndex::read(LocationIndex::path_of(trace), trace));
+    }
+
+    fs::remove_all(fs::temp_directory_path() / "index_trace");
+    fs::remove(LocationIndex::path_of(trace));
+}
+
+TEST_CASE("Test IoFileFilter pattern hits", "[pattern_hits]")
+{
+    auto temp = fs::temp_directory_path();
+    temp += "/io_filter_pattern.txt";
+    create_pattern_file(temp);
+
+    IoFileFilter filter(temp);
+    filter.count_pattern_hits();
+    auto c = filter.get_callbacks();
+
+    c.global_string_callback(0, "/proc/self/1000");
+    c.global_string_callback(1, "/home/bar/foo.txt");
+    c.global_string_callback(2, "/tmp/output.txt");
+    c.global_location_callback(0, 0, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 0);
+    REQUIRE(c.global_io_regular_file_callback(0, 0, OTF2_UNDEFINED_SYSTEM_TREE_NODE));
+    REQUIRE(c.global_io_regular_file_callback(1, 1, OTF2_UNDEFINED_SYSTEM_TREE_NODE));
+    REQUIRE(! c.global_io_regular_file_callback(2, 2, OTF2_UNDEFINED_SYSTEM_TREE_NODE));
+    REQUIRE(c.global_io_handle_callback(0, 0, 0, 0, OTF2_IO_HANDLE_FLAG_NONE, OTF2_UNDEFINED_COMM, OTF2_UNDEFINED_IO_HANDLE));
+    REQUIRE(c.global_io_handle_callback(1, 0, 1, 0, OTF2_IO_HANDLE_FLAG_NONE, OTF2_UNDEFINED_COMM, OTF2_UNDEFINED_IO_HANDLE));
+    REQUIRE(c.global_io_handle_callback(2, 0, OTF2_UNDEFINED_IO_FILE, 0, OTF2_IO_HANDLE_FLAG_NONE, OTF2_UNDEFINED_COMM, 0));
+    REQUIRE(! c.global_io_handle_callback(3, 0, 2, 0, OTF2_IO_HANDLE_FLAG_NONE, OTF2_UNDEFINED_COMM, OTF2_UNDEFINED_IO_HANDLE));
+
+    REQUIRE(c.event_io_destroy_handle_callback(0, 0, nullptr, 0));
+    REQUIRE(c.event_io_destroy_handle_callback(0, 0, nullptr, 1));
+    REQUIRE(c.event_io_acquire_lock_callback(0, 0, nullptr, 1, OTF2_LOCK_EXCLUSIVE));
+    REQUIRE(! c.event_io_destroy_handle_callback(0, 0, nullptr, 3));
+    REQUIRE(c.event_io_delete_file_callback(0, 0, nullptr, 0, 0));
+
+    auto hits = filter.pattern_hits();
+    REQUIRE(hits.size() == 2);
+    REQUIRE(hits[0].pattern == "/proc/*");
+    REQUIRE(hits[0].files == 1);
+    REQUIRE(hits[0].handles == 2);
+    REQUIRE(hits[0].events == 2);
+    REQUIRE(hits[1].pattern == "/home/bar/foo.txt");
+    REQUIRE(hits[1].files == 1);
+    REQUIRE(hits[1].handles == 1);
+    REQUIRE(hits[1].events == 2);
+    REQUIRE(filter.filtered_files() == std::vector<std::string>{"/proc/self/1000", "/home/bar/foo.txt"});
+}
+
+TEST_CASE("Test RegionFilterPattern", "[region_pattern]")
+{
+    auto temp = fs::temp_directory_path();
+    temp += "/region_filter_pattern.txt";
+
+    SECTION("one pattern per line")
+    {
+        {
+            std::ofstream out(temp, std::ios::out);
+            out << "# getters and MPI_Comm_rank\n";
+            out << "get_*\n";
+            out << "  MPI_Comm_rank \t# trailing comment\n";
+            out << "   \n";
+        }
+        RegionFilterPattern pattern(temp);
+        REQUIRE(pattern.filterRegion("get_size", "", ""));
+        REQUIRE(pattern.filterRegion("MPI_Comm_rank", "", ""));
+        REQUIRE(! pattern.filterRegion("# getters and MPI_Comm_rank", "", ""));
+        REQUIRE(! pattern.filterRegion("MPI_Comm_size", "", ""));
+        REQUIRE(! pattern.filterRegion("main", "", ""));
+    }
+
+    SECTION("Score-P syntax")
+    {
+        {
+            std::ofstream out(temp, std::ios::out);
+            out << "# drop everything but MPI\n";
+            out << "SCOREP_REGION_NAMES_BEGIN\n";
+            out << "  EXCLUDE *\n";
+            out << "  INCLUDE main MPI_*\n";
+            out << "          compute\n";
+            out << "  EXCLUDE MPI_Comm_rank # called in every loop\n";
+            out << "  INCLUDE MANGLED _ZN4Keep*\n";
+            out << "SCOREP_REGION_NAMES_END\n";
+            out << "SCOREP_FILE_NAMES_BEGIN\n";
+            out << "  EXCLUDE */generated/*\n";
+            out << "SCOREP_FILE_NAMES_END\n";
+        }
+        RegionFilterPattern pattern(temp);
+        REQUIRE(pattern.filterRegion("get_size", "", ""));
+        REQUIRE(! pattern.filterRegion("main", "", ""));
+        REQUIRE(! pattern.filterRegion("compute", "", ""));
+        REQUIRE(! pattern.filterRegion("MPI_Send", "", ""));
+        REQUIRE(pattern.filterRegion("MPI_Comm_rank", "", ""));
+        REQUIRE(! pattern.filterRegion("Keep::get", "_ZN4Keep3getEv", ""));
+        REQUIRE(pattern.filterRegion("main", "", "/src/generated/main.c"));
+        REQUIRE(! pattern.filterRegion("main", "", "/src/main.c"));
+    }
+
+    SECTION("invalid Score-P syntax")
+    {
+        {
+            std::ofstream out(temp, std::ios::out);
+            out << "SCOREP_REGION_NAMES_BEGIN\n";
+            out << "  main\n";
+            out << "SCOREP_REGION_NAMES_END\n";
+        }
+        REQUIRE_THROWS_AS(RegionFilterPattern(temp), std::runtime_error);
+    }
+
+    fs::remove(temp);
+}
+
+TEST_CASE("Test RegionFilter", "[region_filter]")
+{
+    auto temp = fs::temp_directory_path();
+    temp += "/region_filter_pattern.txt";
+    {
+        std::ofstream out(temp, std::ios::out);
+        out << "get_*\n";
+    }
+
+    RegionFilter filter(temp);
+    auto c = filter.get_callbacks();
+    REQUIRE(! filter.affects_location(0));
+
+    c.global_string_callback(0, "main");
+    c.global_string_callback(1, "get_size");
+    REQUIRE(! c.global_region_callback(0, 0, 0, OTF2_UNDEFINED_STRING, OTF2_REGION_ROLE_FUNCTION,
+                                       OTF2_PARADIGM_COMPILER, OTF2_REGION_FLAG_NONE, OTF2_UNDEFINED_STRING, 0, 0));
+    REQUIRE(! c.global_region_callback(1, 1, 1, OTF2_UNDEFINED_STRING, OTF2_REGION_ROLE_FUNCTION,
+                                       OTF2_PARADIGM_COMPILER, OTF2_REGION_FLAG_NONE, OTF2_UNDEFINED_STRING, 0, 0));
+    REQUIRE(filter.filtered_regions() == std::vector<std::string>{"get_size"});
+    REQUIRE(filter.affects_location(0));
+
+    REQUIRE(! c.event_enter_callback(0, 0, nullptr, 0));
+    REQUIRE(c.event_enter_callback(0, 1, nullptr, 1));
+    REQUIRE(c.event_leave_callback(0, 2, nullptr, 1));
+    REQUIRE(! c.event_leave_callback(0, 3, nullptr, 0));
+    REQUIRE(! c.event_enter_callback(0, 4, nullptr, 2));
+
+    fs::remove(temp);
+}
+
+TEST_CASE("Test LocationSelection", "[location_selection]")
+{
+    LocationSelection selection;
+    auto c = selection.get_callbacks();
+
+    /* two nodes with a process each, the second with a GPU stream */
+    c.global_string_callback(0, "cluster");
+    c.global_string_callback(1, "node1");
+    c.global_string_callback(2, "node2");
+    c.global_string_callback(3, "MPI Rank 0");
+    c.global_string_callback(4, "MPI Rank 1");
+    c.global_string_callback(5, "Master thread");
+    c.global_string_callback(6, "CUDA stream 1");
+    REQUIRE(! c.global_system_tree_node_callback(0, 0, 0, OTF2_UNDEFINED_SYSTEM_TREE_NODE));
+    REQUIRE(! c.global_system_tree_node_callback(1, 1, 0, 0));
+    REQUIRE(! c.global_system_tree_node_callback(2, 2, 0, 0));
+    REQUIRE(! c.global_location_group_callback(0, 3, OTF2_LOCATION_GROUP_TYPE_PROCESS, 1));
+    REQUIRE(! c.global_location_group_callback(1, 4, OTF2_LOCATION_GROUP_TYPE_PROCESS, 2));
+
+    auto dropped = [&c]() {
+        std::vector<OTF2_LocationRef> result;
+        if (c.global_location_callback(0, 5, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 0)) result.push_back(0);
+        if (c.global_location_callback(1, 5, OTF2_LOCATION_TYPE_CPU_THREAD, 10, 1)) result.push_back(1);
+        if (c.global_location_callback(2, 6, OTF2_LOCATION_TYPE_GPU, 10, 1)) result.push_back(2);
+        return result;
+    };
+
+    SECTION("everything")
+    {
+        REQUIRE(dropped().empty());
+    }
+
+    SECTION("by location group")
+    {
+        selection.add_group_pattern("MPI Rank 0");
+        REQUIRE(dropped() == std::vector<OTF2_LocationRef>{1, 2});
+        REQUIRE(selection.dropped_locations() == 2);
+    }
+
+    SECTION("by system tree node")
+    {
+        selection.add_group_pattern("node2");
+        REQUIRE(dropped() == std::vector<OTF2_LocationRef>{0});
+    }
+
+    SECTION("by name or group")
+    {
+        selection.add_location_pattern("CUDA*");
+        selection.add_group_pattern("MPI Rank 0");
+        REQUIRE(dropped() == std::vector<OTF2_LocationRef>{1});
+    }
+
+    SECTION("by type")
+    {
+        selection.add_type(LocationSelection::parse_type("cpu_thread"));
+        REQUIRE(dropped() == std::vector<OTF2_LocationRef>{2});
+        REQUIRE_THROWS_AS(LocationSelection::parse_type("fpga"), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Test RecordClassFilter", "[record_class_filter]")
+{
+    RecordClassFilter filter;
+    REQUIRE(filter.dropped_event_types().empty());
+    REQUIRE(! filter.get_callbacks().global_rma_win_callback);
+
+    filter.add_class(RecordClassFilter::parse_class("rma"));
+    filter.add_class(RecordClassFilter::parse_class("calling_context"));
+    REQUIRE_THROWS_AS(RecordClassFilter::parse_class("mpi"), std::invalid_argument);
+
+    auto types = filter.dropped_event_types();
+    REQUIRE(types.size() == 21);
+    REQUIRE(std::find(types.begin(), types.end(), EventType::RmaPut) != types.end());
+    REQUIRE(std::find(types.begin(), types.end(), EventType::CallingContextSample) != types.end());
+    REQUIRE(std::find(types.begin(), types.end(), EventType::OmpFork) == types.end());
+
+    auto c = filter.get_callbacks();
+    REQUIRE(c.global_rma_win_callback(0, 0, 0));
+    REQUIRE(c.global_calling_context_callback(0, 0, 0, OTF2_UNDEFINED_CALLING_CONTEXT));
+    REQUIRE(! c.global_comm_callback);
+    REQUIRE(! c.event_enter_callback);
+
+    /*
+     * Attribute values and properties referring to dropped definitions.
+     */
+    REQUIRE(filter.dropped_attribute_types().size() == 4);
+    REQUIRE(c.global_attribute_callback(0, 0, 0, OTF2_TYPE_CALLING_CONTEXT));
+    REQUIRE(! c.global_attribute_callback(0, 0, 0, OTF2_TYPE_UINT64));
+    OTF2_AttributeValue value;
+    value.uint64 = 0;
+    REQUIRE(c.global_location_property_callback(0, 0, OTF2_TYPE_RMA_WIN, value));
+    REQUIRE(! c.global_location_property_callback(0, 0, OTF2_TYPE_STRING, value));
+}
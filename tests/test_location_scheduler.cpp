@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <location_queue.hpp>
+#include <location_scheduler.hpp>
+
+static uint64_t
+thread_events(const std::vector<OTF2_LocationRef> &thread_locations, const std::vector<LocationWeight> &locations)
+{
+    uint64_t events = 0;
+    for (auto location : thread_locations)
+    {
+        auto search = std::find_if(locations.begin(), locations.end(), [location](const LocationWeight &w) {
+            return w.location == location;
+        });
+        REQUIRE(search != locations.end());
+        events += search->number_of_events;
+    }
+    return events;
+}
+
+TEST_CASE("Test every location is scheduled once", "[schedule_all]")
+{
+    std::vector<LocationWeight> locations;
+    for (OTF2_LocationRef i = 0; i < 17; i++)
+    {
+        locations.push_back({i, i * 10});
+    }
+
+    auto schedule = schedule_locations(locations, 4);
+    REQUIRE(schedule.size() == 4);
+
+    std::vector<OTF2_LocationRef> scheduled;
+    for (const auto &thread_locations : schedule)
+    {
+        scheduled.insert(scheduled.end(), thread_locations.begin(), thread_locations.end());
+    }
+    std::sort(scheduled.begin(), scheduled.end());
+
+    std::vector<OTF2_LocationRef> expected(locations.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    REQUIRE(scheduled == expected);
+}
+
+TEST_CASE("Test heavy locations get their own thread", "[schedule_weighted]")
+{
+    /*
+     * Two master ranks with 100x the events of the worker threads.
+     */
+    std::vector<LocationWeight> locations = {{0, 100000}, {1, 1000}, {2, 1000}, {3, 1000}, {4, 100000}, {5, 1000}};
+
+    auto schedule = schedule_locations(locations, 3);
+    REQUIRE(schedule.size() == 3);
+
+    std::vector<uint64_t> loads;
+    for (const auto &thread_locations : schedule)
+    {
+        loads.push_back(thread_events(thread_locations, locations));
+    }
+    std::sort(loads.begin(), loads.end());
+    REQUIRE(loads == std::vector<uint64_t>{4000, 100000, 100000});
+}
+
+TEST_CASE("Test locations without events are spread", "[schedule_empty]")
+{
+    std::vector<LocationWeight> locations = {{0, 0}, {1, 0}, {2, 0}, {3, 0}};
+
+    auto schedule = schedule_locations(locations, 2);
+    REQUIRE(schedule[0].size() == 2);
+    REQUIRE(schedule[1].size() == 2);
+
+    REQUIRE(schedule_locations(locations, 0).size() == 1);
+}
+
+TEST_CASE("Test idle workers steal locations", "[queue_steal]")
+{
+    LocationSchedule schedule = {{0, 1, 2, 3}, {}, {4}};
+    LocationQueue    queue(schedule);
+    REQUIRE(queue.workers() == 2);
+
+    OTF2_LocationRef location;
+    REQUIRE(queue.pop(1, location));
+    REQUIRE(location == 4);
+
+    /*
+     * The own deque is empty, so the worker steals from the back of the other one.
+     */
+    REQUIRE(queue.pop(1, location));
+    REQUIRE(location == 3);
+
+    REQUIRE(queue.pop(0, location));
+    REQUIRE(location == 0);
+    REQUIRE(queue.pop(0, location));
+    REQUIRE(location == 1);
+    REQUIRE(queue.pop(1, location));
+    REQUIRE(location == 2);
+
+    REQUIRE(!queue.pop(0, location));
+    REQUIRE(!queue.pop(1, location));
+}
+
+TEST_CASE("Test concurrent workers take every location once", "[queue_concurrent]")
+{
+    std::vector<LocationWeight> locations;
+    for (OTF2_LocationRef i = 0; i < 1000; i++)
+    {
+        locations.push_back({i, i % 7});
+    }
+    LocationQueue queue(schedule_locations(locations, 4));
+
+    std::mutex                    taken_mutex;
+    std::vector<OTF2_LocationRef> taken;
+    std::vector<std::thread>      workers;
+    for (size_t i = 0; i < queue.workers(); i++)
+    {
+        workers.emplace_back([&, i]() {
+            OTF2_LocationRef location;
+            while (queue.pop(i, location))
+            {
+                std::lock_guard<std::mutex> lock(taken_mutex);
+                taken.push_back(location);
+            }
+        });
+    }
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+
+    std::sort(taken.begin(), taken.end());
+    REQUIRE(taken.size() == locations.size());
+    REQUIRE(std::adjacent_find(taken.begin(), taken.end()) == taken.end());
+}
+
+TEST_CASE("Test the observer sees every taken location", "[queue_observer]")
+{
+    LocationQueue queue({{0, 1}, {2}});
+
+    std::vector<OTF2_LocationRef> observed;
+    queue.set_observer([&observed](OTF2_LocationRef location) { observed.push_back(location); });
+
+    OTF2_LocationRef location;
+    REQUIRE(queue.pop(1, location));
+    REQUIRE(queue.pop(1, location));
+    REQUIRE(queue.pop(0, location));
+    REQUIRE(!queue.pop(0, location));
+
+    REQUIRE(observed == std::vector<OTF2_LocationRef>{2, 1, 0});
+}
@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -10,6 +16,7 @@
 
 #include "itest_handler.hpp"
 #include <trace_reader.hpp>
+#include <trace_stats.hpp>
 #include <trace_writer.hpp>
 
 #include "mpi_config.hpp"
@@ -75,6 +82,111 @@ class TestHandler : public ITestHandler
     std::vector<CollectiveEventTuple> m_coll_end_events;
 };
 
+/*
+ * Records the enter times per location and the locations read by each
+ * thread. With stealing forced, the first location begun blocks until all
+ * others were read, so the other worker has to steal from the blocked one.
+ */
+class StealingHandler : public ITestHandler
+{
+  public:
+    explicit StealingHandler(std::size_t locations, bool force_stealing = false)
+        : m_locations(locations), m_force_stealing(force_stealing)
+    {
+    }
+
+    virtual void
+    beginLocation(OTF2_LocationRef location) override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_thread_locations[std::this_thread::get_id()]++;
+        if (m_force_stealing && !m_blocked)
+        {
+            m_blocked = true;
+            m_ended_cv.wait_for(lock, std::chrono::seconds(10), [this] { return m_ended + 1 == m_locations; });
+        }
+    }
+
+    virtual void
+    endLocation(OTF2_LocationRef location) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ended++;
+        m_ended_cv.notify_all();
+    }
+
+    virtual void
+    handleEnterEvent(OTF2_LocationRef    location,
+                     OTF2_TimeStamp      time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef      region) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enter_times[location].push_back(time);
+    }
+
+    /*
+     * Most locations read by one thread.
+     */
+    std::size_t
+    max_thread_locations() const
+    {
+        std::size_t result = 0;
+        for (const auto &thread : m_thread_locations)
+        {
+            result = std::max(result, thread.second);
+        }
+        return result;
+    }
+
+    std::map<OTF2_LocationRef, std::vector<OTF2_TimeStamp>> m_enter_times;
+
+  private:
+    std::size_t                            m_locations;
+    bool                                   m_force_stealing;
+    bool                                   m_blocked = false;
+    std::size_t                            m_ended   = 0;
+    std::mutex                             m_mutex;
+    std::condition_variable                m_ended_cv;
+    std::map<std::thread::id, std::size_t> m_thread_locations;
+};
+
+TEST_CASE("Test a reader per worker with stolen locations", "[trace_mpi_reader_per_worker]")
+{
+    std::stringstream ss;
+    ss << MpiConfigTracePath << '/' << MpiConfigTraceName << ".otf2";
+    fs::path input_trace(ss.str());
+    REQUIRE(fs::exists(input_trace));
+
+    StealingHandler serial_handler(0);
+    {
+        TraceReader tr(input_trace.string(), serial_handler, 1);
+        tr.read();
+    }
+    auto locations = serial_handler.m_enter_times.size();
+    REQUIRE(locations >= 4);
+
+    /*
+     * All ranks write the same events, so two workers get half of the
+     * locations each. One of them blocks on its first location until the
+     * other one read the rest, including the stolen ones.
+     */
+    TraceStats         stats;
+    StealingHandler    handler(locations, true);
+    TraceReaderOptions options;
+    options.reader_per_worker = true;
+    options.stats             = &stats;
+    {
+        TraceReader tr(input_trace.string(), handler, 2, options);
+        tr.read();
+    }
+
+    REQUIRE(handler.max_thread_locations() == locations - 1);
+    REQUIRE(stats.worker_readers() == 2);
+    REQUIRE(stats.shared_reader_fallbacks() == 0);
+    REQUIRE(handler.m_enter_times == serial_handler.m_enter_times);
+}
+
 TEST_CASE("Test trace generation for MPI traces.", "[trace_mpi]")
 {
     std::stringstream ss;
@@ -0,0 +1,124 @@
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <prefetcher.hpp>
+
+namespace
+{
+/*
+ * Records the advised files instead of advising them to the kernel, and
+ * checks the prefetcher stays within its distance of the taken locations.
+ */
+class AdviseRecorder
+{
+  public:
+    explicit AdviseRecorder(std::size_t distance) : m_distance(distance)
+    {
+    }
+
+    void
+    advise(const std::filesystem::path &file)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_files.push_back(file.filename().string());
+        if (file.extension() == ".evt")
+        {
+            m_locations++;
+            m_within_distance = m_within_distance && m_locations <= m_taken + m_distance;
+        }
+        m_condition.notify_all();
+    }
+
+    /*
+     * Count a taken location before the prefetcher is advanced.
+     */
+    void
+    take()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_taken++;
+    }
+
+    /*
+     * Wait until the files of a number of locations were advised, returns
+     * false if they were not within a second.
+     */
+    bool
+    wait_for(std::size_t locations)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_condition.wait_for(lock, std::chrono::seconds(1), [&] {
+            return m_locations >= locations && m_files.size() == 2 * m_locations;
+        });
+    }
+
+    std::vector<std::string>
+    files()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_files;
+    }
+
+    bool
+    within_distance()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_within_distance;
+    }
+
+  private:
+    std::size_t              m_distance;
+    std::size_t              m_taken           = 0;
+    std::size_t              m_locations       = 0;
+    bool                     m_within_distance = true;
+    std::vector<std::string> m_files;
+    std::mutex               m_mutex;
+    std::condition_variable  m_condition;
+};
+} // namespace
+
+TEST_CASE("Test the order and distance of prefetching", "[prefetch]")
+{
+    LocationSchedule schedule{{0, 3, 5}, {1, 4}, {2}};
+    AdviseRecorder   recorder(2);
+    {
+        Prefetcher prefetcher("trace", schedule, 2, [&](const std::filesystem::path &file) { recorder.advise(file); });
+
+        /*
+         * Without taken locations, only the distance is advised.
+         */
+        REQUIRE(recorder.wait_for(2));
+        REQUIRE(!recorder.wait_for(3));
+
+        for (std::size_t taken = 1; taken <= 4; taken++)
+        {
+            recorder.take();
+            prefetcher.advance();
+            REQUIRE(recorder.wait_for(taken + 2));
+        }
+    }
+
+    /*
+     * The first location of every worker, then the second and so on.
+     */
+    REQUIRE(recorder.within_distance());
+    REQUIRE(recorder.files() == std::vector<std::string>{"0.evt",
+                                                         "0.def",
+                                                         "1.evt",
+                                                         "1.def",
+                                                         "2.evt",
+                                                         "2.def",
+                                                         "3.evt",
+                                                         "3.def",
+                                                         "4.evt",
+                                                         "4.def",
+                                                         "5.evt",
+                                                         "5.def"});
+}
@@ -25,3 +25,77 @@ TEST_CASE( "Test reader API", "[trace_read]" )
     tr.read();
     th.verify();
 }
+
+namespace
+{
+class EnterCounter : public ITestHandler
+{
+  public:
+    virtual void
+    handleEnterEvent(OTF2_LocationRef location,
+                     OTF2_TimeStamp time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef region) override
+    {
+        m_enters++;
+    }
+
+    std::size_t m_enters = 0;
+};
+
+class LeaveCounter : public EnterCounter
+{
+  public:
+    virtual void
+    handleEnterEvent(OTF2_LocationRef location,
+                     OTF2_TimeStamp time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef region) override
+    {
+    }
+
+    virtual void
+    handleLeaveEvent(OTF2_LocationRef location,
+                     OTF2_TimeStamp time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef region) override
+    {
+        m_leaves++;
+    }
+
+    std::size_t m_leaves = 0;
+};
+} // namespace
+
+TEST_CASE( "Test dispatch to the handler type", "[trace_read]" )
+{
+    std::string trace_path(TestTrace::TestTracePath);
+    trace_path += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+
+    SECTION( "Concrete handler" )
+    {
+        EnterCounter counter;
+        TraceReader tr(trace_path, counter);
+        tr.read();
+        REQUIRE(counter.m_enters == 2);
+    }
+
+    SECTION( "Derived handler passed as its base" )
+    {
+        LeaveCounter counter;
+        EnterCounter & base = counter;
+        TraceReader tr(trace_path, base);
+        tr.read();
+        REQUIRE(counter.m_enters == 0);
+        REQUIRE(counter.m_leaves == 2);
+    }
+
+    SECTION( "Virtual dispatch" )
+    {
+        EnterCounter counter;
+        Otf2Handler & handler = counter;
+        TraceReader tr(trace_path, handler);
+        tr.read();
+        REQUIRE(counter.m_enters == 2);
+    }
+}
@@ -1,15 +1,27 @@
 #include <functional>
+#include <limits>
 #include <trace_writer.hpp>
+#include <static_trace_writer.hpp>
 #include <trace_reader.hpp>
 #include <string>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <system_error>
 #include <cstring>
+#include <dry_run_handler.hpp>
 
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
 #include <filter.hpp>
+#include <location_index.hpp>
+#include <location_selection.hpp>
+#include <position_index.hpp>
+#include <record_class_filter.hpp>
+#include <time_window_filter.hpp>
+#include <trace_stats.hpp>
 
 #include "test_handler.hpp"
 #include "test_trace.hpp"
@@ -171,4 +183,988 @@ TEST_CASE( "Test filter API", "[trace_write_simple_filter]" )
     std::error_code ec;
     auto err = fs::remove_all(trace_output.parent_path(), ec);
     REQUIRE(err != static_cast<std::uintmax_t>(-1));
-}
\ No newline at end of file
+}
+
+class StaticRegionFilter
+{
+public:
+    bool
+    operator()(record::GlobalString, OTF2_StringRef self, const char * string)
+    {
+        if (strcmp(string, TestTrace::RegionName.data()) == 0)
+        {
+            m_string_ref = self;
+        }
+        return false;
+    }
+
+    bool
+    operator()(record::GlobalRegion, OTF2_RegionRef self, OTF2_StringRef name,
+               OTF2_StringRef canonicalName, OTF2_StringRef description,
+               OTF2_RegionRole regionRole, OTF2_Paradigm paradigm,
+               OTF2_RegionFlag regionFlags, OTF2_StringRef sourceFile,
+               uint32_t beginLineNumber, uint32_t endLineNumber)
+    {
+        if(name == m_string_ref)
+        {
+            m_region_ref = self;
+        }
+        return false;
+    }
+
+    bool
+    operator()(record::EventEnter, OTF2_LocationRef location,
+               OTF2_TimeStamp time, OTF2_AttributeList *attributes,
+               OTF2_RegionRef region)
+    {
+        return region == m_region_ref;
+    }
+
+    bool
+    operator()(record::EventLeave, OTF2_LocationRef location,
+               OTF2_TimeStamp time, OTF2_AttributeList *attributes,
+               OTF2_RegionRef region)
+    {
+        return region == m_region_ref;
+    }
+
+private:
+    OTF2_StringRef m_string_ref = OTF2_UNDEFINED_STRING;
+    OTF2_RegionRef m_region_ref = OTF2_UNDEFINED_REGION;
+};
+
+static_assert(StaticFilter<StaticRegionFilter &>::handles<record::EventEnter,
+                                                          OTF2_LocationRef,
+                                                          OTF2_TimeStamp,
+                                                          OTF2_AttributeList *,
+                                                          OTF2_RegionRef>);
+static_assert(!StaticFilter<StaticRegionFilter &>::handles<record::EventMetric,
+                                                           OTF2_LocationRef,
+                                                           OTF2_TimeStamp,
+                                                           OTF2_AttributeList *,
+                                                           OTF2_MetricRef,
+                                                           uint8_t,
+                                                           const OTF2_Type *,
+                                                           const OTF2_MetricValue *>);
+
+TEST_CASE( "Test static filter API", "[trace_write_static_filter]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+
+    REQUIRE(fs::is_directory(temp));
+    {
+        StaticRegionFilter filter;
+        StaticTraceWriter<StaticRegionFilter &> tw(temp.string(), filter);
+
+        std::string trace_input(TestTrace::TestTracePath);
+        trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+        TraceReader tr(trace_input, tw);
+        tr.read();
+    }
+
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    TestHandler th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+
+    CHECK_THROWS(th.invocation_count(std::string(TestTrace::RegionName)));
+    REQUIRE(th.locations().count(std::string(TestTrace::LocactionName)) == 1);
+    REQUIRE(th.location_groups().count(std::string(TestTrace::LocationGroupName)) == 1);
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test filter priority", "[filter_priority]" )
+{
+    std::vector<int> calls;
+    Filter<FilterCallback<int>> filter;
+    filter.add([&calls](int v) { calls.push_back(2); return v == 2; }, 10);
+    filter.add([&calls](int v) { calls.push_back(0); return v == 0; });
+    filter.add([&calls](int v) { calls.push_back(1); return v == 1; }, 5);
+
+    REQUIRE(! filter.empty());
+
+    REQUIRE(filter.process(0));
+    REQUIRE(calls == std::vector<int>{0});
+
+    calls.clear();
+    REQUIRE(filter.process(1));
+    REQUIRE(calls == std::vector<int>{0, 1});
+
+    calls.clear();
+    REQUIRE(! filter.process(3));
+    REQUIRE(calls == std::vector<int>{0, 1, 2});
+}
+
+TEST_CASE( "Test a reader per worker", "[trace_write_reader_per_worker]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+    {
+        TraceWriter tw(temp.string());
+        MyRegionFilter filter;
+        tw.register_filter(filter);
+
+        std::string trace_input(TestTrace::TestTracePath);
+        trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+        TraceReaderOptions options;
+        options.reader_per_worker = true;
+        TraceReader tr(trace_input, tw, 4, options);
+        tr.read();
+    }
+
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    TestHandler th;
+    TraceReaderOptions options;
+    options.reader_per_worker = true;
+    TraceReader tr(trace_output, th, 4, options);
+    tr.read();
+
+    CHECK_THROWS(th.invocation_count(std::string(TestTrace::RegionName)));
+    REQUIRE(th.locations().count(std::string(TestTrace::LocactionName)) == 1);
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test pipelined definitions", "[trace_write_pipelined]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    uint64_t definition_chunk = 1;
+    SECTION("in chunks")
+    {
+    }
+    SECTION("at once")
+    {
+        definition_chunk = 0;
+    }
+    {
+        TraceWriter tw(temp.string());
+        REQUIRE(tw.eventsDependOn(GlobalDefinition::Location));
+        REQUIRE(! tw.eventsDependOn(GlobalDefinition::Region));
+        REQUIRE(! tw.eventsDependOn(GlobalDefinition::String));
+
+        MyRegionFilter filter;
+        tw.register_filter(filter);
+        REQUIRE(tw.eventsDependOn(GlobalDefinition::Region));
+        REQUIRE(! tw.eventsDependOn(GlobalDefinition::Callpath));
+
+        std::string trace_input(TestTrace::TestTracePath);
+        trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+        TraceReaderOptions options;
+        options.pipelined = true;
+        options.definition_chunk = definition_chunk;
+        TraceReader tr(trace_input, tw, 2, options);
+        tr.read();
+    }
+
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    TestHandler th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+
+    CHECK_THROWS(th.invocation_count(std::string(TestTrace::RegionName)));
+    REQUIRE(th.locations().count(std::string(TestTrace::LocactionName)) == 1);
+    REQUIRE(th.location_groups().count(std::string(TestTrace::LocationGroupName)) == 1);
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+static_assert(StaticFilterHandles<StaticFilter<StaticRegionFilter &>,
+                                  record::GlobalRegion,
+                                  GlobalRegionFilter>::value);
+static_assert(! StaticFilterHandles<StaticFilter<StaticRegionFilter &>,
+                                    record::GlobalCallpath,
+                                    GlobalCallpathFilter>::value);
+
+TEST_CASE( "Test writer options", "[trace_write_options]" )
+{
+    REQUIRE(event_chunk_size({}) == TraceWriterOptions().event_chunk_size);
+    REQUIRE(event_chunk_size({{0, 10}, {1, 20}}) == 256 * 1024);
+    REQUIRE(event_chunk_size({{0, 100000}}) == 2 * 1024 * 1024);
+    REQUIRE(event_chunk_size({{0, 100000}, {1, 0}, {2, 0}, {3, 0}}) == 512 * 1024);
+    REQUIRE(event_chunk_size({{0, uint64_t(1) << 40}}) == 16 * 1024 * 1024);
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    auto locations = TraceReader::read_locations(trace_input);
+    REQUIRE(! locations.empty());
+
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+    {
+        TraceWriterOptions options;
+        options.event_chunk_size = event_chunk_size(locations);
+        options.definition_chunk_size = 256 * 1024;
+        TraceWriter tw(temp.string(), options);
+        TraceReader tr(trace_input, tw);
+        tr.read();
+    }
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    {
+        TestHandler th;
+        TraceReader tr(trace_output, th);
+        tr.read();
+        th.verify();
+    }
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test memory limit", "[trace_write_memory_limit]" )
+{
+    TraceWriterOptions options;
+    REQUIRE(open_location_limit(options) == 0);
+    options.event_chunk_size = 1024 * 1024;
+    options.definition_chunk_size = 1024 * 1024;
+    options.memory_limit = 9 * 1024 * 1024;
+    REQUIRE(open_location_limit(options) == 4);
+    options.memory_limit = 1024 * 1024;
+    REQUIRE(open_location_limit(options) == 1);
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+    {
+        options.memory_limit = 8 * 1024 * 1024;
+        TraceReaderOptions reader_options;
+        reader_options.max_open_locations = open_location_limit(options);
+        TraceWriter tw(temp.string(), options);
+        TraceReader tr(trace_input, tw, 2, reader_options);
+        tr.read();
+    }
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    {
+        TestHandler th;
+        TraceReader tr(trace_output, th);
+        tr.read();
+        th.verify();
+    }
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+static std::string
+read_file(const fs::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE( "Test copying untouched locations", "[trace_write_copy]" )
+{
+    fs::path input_directory(TestTrace::TestTracePath);
+    input_directory /= fs::path(TestTrace::TestTraceName);
+    std::string trace_input = input_directory.string() + ".otf2";
+
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+    {
+        TraceWriter tw(temp.string());
+        TraceReader tr(trace_input, tw);
+        tr.read();
+    }
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    {
+        TestHandler th;
+        TraceReader tr(trace_output, th);
+        tr.read();
+        th.verify();
+    }
+
+    fs::path output_directory(temp / "trace");
+    REQUIRE(read_file(output_directory / "0.evt") == read_file(input_directory / "0.evt"));
+    REQUIRE(read_file(output_directory / "0.def") == read_file(input_directory / "0.def"));
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test recording a location index", "[location_index]" )
+{
+    fs::path input_directory(TestTrace::TestTracePath);
+    input_directory /= fs::path(TestTrace::TestTraceName);
+    std::string trace_input = input_directory.string() + ".otf2";
+
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    LocationIndexRecorder recorder(trace_input);
+    {
+        TraceWriter tw(temp.string());
+        tw.register_filter(recorder, std::numeric_limits<int>::min());
+        TraceReader tr(trace_input, tw);
+        tr.read();
+    }
+
+    auto index = recorder.index();
+    REQUIRE(index.size() == 1);
+    const auto *usage = index.find(0);
+    REQUIRE(usage != nullptr);
+    REQUIRE(usage->event_file_size == fs::file_size(input_directory / "0.evt"));
+    REQUIRE(usage->event_counts[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(usage->event_counts[static_cast<std::size_t>(EventType::Leave)] == 2);
+    REQUIRE(usage->io_handles.empty());
+
+    /* the recorder drops nothing, the events are rewritten */
+    {
+        TestHandler th;
+        TraceReader tr(temp / "trace.otf2", th);
+        tr.read();
+        th.verify();
+    }
+
+    std::error_code ec;
+    auto err = fs::remove_all(temp, ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test statistics", "[trace_write_stats]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    TraceStats stats;
+    {
+        TraceWriterOptions writer_options;
+        writer_options.stats = &stats;
+        TraceWriter tw(temp.string(), writer_options);
+        MyRegionFilter filter;
+        tw.register_filter(filter);
+
+        TraceReaderOptions reader_options;
+        reader_options.stats = &stats;
+        std::string trace_input(TestTrace::TestTracePath);
+        trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+        TraceReader tr(trace_input, tw, 2, reader_options);
+        tr.read();
+    }
+    stats.set_filtered_files({"/tmp/\"quoted\".txt"});
+
+    auto events = stats.events();
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.filtered[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Leave)] == 2);
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Metric)] == 0);
+    REQUIRE(stats.phase(Phase::StringReferences).peak_rss == 0);
+    REQUIRE(stats.phase(Phase::GlobalDefinitions).peak_rss > 0);
+    REQUIRE(stats.phase(Phase::Events).peak_rss > 0);
+    REQUIRE(stats.phase(Phase::Close).peak_rss > 0);
+
+    std::ostringstream json;
+    stats.write_json(json);
+    REQUIRE(json.str().find("\"Enter\": {\"read\": 2, \"filtered\": 2, \"written\": 0}") != std::string::npos);
+    REQUIRE(json.str().find("\"/tmp/\\\"quoted\\\".txt\"") != std::string::npos);
+
+    std::ostringstream text;
+    stats.write_text(text);
+    REQUIRE(text.str().find("Filtered files: 1") != std::string::npos);
+
+    std::error_code ec;
+    auto err = fs::remove_all(temp, ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test dry run", "[dry_run]" )
+{
+    TraceStats stats;
+    DryRunHandler handler(stats);
+    MyRegionFilter filter;
+    handler.register_filter(filter);
+
+    REQUIRE(handler.handlesEvent(EventType::Enter));
+    REQUIRE(handler.handlesEvent(EventType::Leave));
+    REQUIRE(! handler.handlesEvent(EventType::Metric));
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    TraceReader tr(trace_input, handler);
+    tr.read();
+
+    REQUIRE(handler.definitions()[static_cast<std::size_t>(GlobalDefinition::Region)] == 2);
+    REQUIRE(handler.dropped_definitions()[static_cast<std::size_t>(GlobalDefinition::Region)] == 0);
+
+    auto events = stats.events();
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.filtered[static_cast<std::size_t>(EventType::Enter)] == 2);
+
+    REQUIRE(handler.locations().size() == 1);
+    const auto &location = handler.locations().at(0);
+    REQUIRE(location.read);
+    REQUIRE(location.announced == 2);
+    REQUIRE(location.dropped == 4);
+}
+
+TEST_CASE( "Test dry run with a time window", "[dry_run_time_window]" )
+{
+    TraceStats stats;
+    DryRunHandler handler(stats);
+    TimeWindowFilter filter({1, 2});
+    handler.register_filter(filter);
+    REQUIRE(handler.eventsBegin() == 1);
+    REQUIRE(handler.eventsEnd() == 2);
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    TraceReader tr(trace_input, handler);
+    tr.read();
+
+    /*
+     * The leave at time 3 interrupts reading, it is dropped unread.
+     */
+    auto events = stats.events();
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Leave)] == 1);
+    REQUIRE(events.filtered[static_cast<std::size_t>(EventType::Enter)] == 1);
+
+    /*
+     * The test trace announces two events only, all of them are kept.
+     */
+    const auto &location = handler.locations().at(0);
+    REQUIRE(location.kept == 2);
+    REQUIRE(location.dropped == 1);
+}
+
+namespace
+{
+class WindowHandler : public ITestHandler
+{
+  public:
+    virtual void
+    handleGlobalClockProperties(uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength) override
+    {
+        m_offset = globalOffset;
+        m_length = traceLength;
+    }
+
+    virtual void
+    handleEnterEvent(OTF2_LocationRef location,
+                     OTF2_TimeStamp time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef region) override
+    {
+        m_times.push_back(time);
+        m_regions.push_back(region);
+    }
+
+    virtual void
+    handleLeaveEvent(OTF2_LocationRef location,
+                     OTF2_TimeStamp time,
+                     OTF2_AttributeList *attributes,
+                     OTF2_RegionRef region) override
+    {
+        m_times.push_back(time);
+        if(m_regions.empty() || m_regions.back() != region)
+        {
+            m_unbalanced++;
+            return;
+        }
+        m_regions.pop_back();
+    }
+
+    /*
+     * Whether every region entered is left, in reverse order.
+     */
+    bool
+    balanced() const
+    {
+        return m_regions.empty() && m_unbalanced == 0;
+    }
+
+    uint64_t m_offset = 0;
+    uint64_t m_length = 0;
+    std::vector<OTF2_TimeStamp> m_times;
+    std::vector<OTF2_RegionRef> m_regions;
+    std::size_t m_unbalanced = 0;
+};
+} // namespace
+
+TEST_CASE( "Test time window", "[trace_write_time_window]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    TraceStats stats;
+    {
+        TraceWriterOptions writer_options;
+        writer_options.stats = &stats;
+        TraceWriter tw(temp.string(), writer_options);
+        TimeWindowFilter filter({1, 2});
+        tw.register_filter(filter);
+        REQUIRE(tw.eventsEnd() == 2);
+
+        std::string trace_input(TestTrace::TestTracePath);
+        trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+        TraceReader tr(trace_input, tw);
+        tr.read();
+    }
+
+    /*
+     * The last leave at time 3 interrupts reading the location. The filtered
+     * Enter is written at the begin of the window and a Leave is added at its
+     * end.
+     */
+    auto events = stats.events();
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.filtered[static_cast<std::size_t>(EventType::Enter)] == 1);
+    REQUIRE(events.written[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Leave)] == 1);
+    REQUIRE(events.written[static_cast<std::size_t>(EventType::Leave)] == 2);
+
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    WindowHandler th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+
+    /*
+     * The region entered at time 0 is entered at the begin of the window
+     * and left at its end.
+     */
+    REQUIRE(th.m_offset == 1);
+    REQUIRE(th.m_length == 1);
+    REQUIRE(th.m_times == std::vector<OTF2_TimeStamp>{1, 1, 2, 2});
+    REQUIRE(th.balanced());
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test time window through a region", "[trace_write_time_window_balanced]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    {
+        TraceWriter tw(temp.string());
+        TimeWindowFilter filter({1, 3});
+        tw.register_filter(filter);
+
+        std::string trace_input(TestTrace::TestTracePath);
+        trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+        TraceReader tr(trace_input, tw);
+        tr.read();
+    }
+
+    /*
+     * Enter@0 is cut off by the window, its region is entered at time 1
+     * and left by the Leave at time 3.
+     */
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    WindowHandler th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+    REQUIRE(th.m_times == std::vector<OTF2_TimeStamp>{1, 1, 2, 3});
+    REQUIRE(th.balanced());
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+TEST_CASE( "Test position index", "[trace_write_positions]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+    fs::path index_file = fs::temp_directory_path() / "temp_trace.positions";
+
+    /*
+     * Sample every event of location 0: Enter@0, Enter@1, Leave@2, Leave@3.
+     */
+    PositionIndexRecorder recorder(trace_input, 1);
+    {
+        TraceWriter tw(temp.string());
+        TraceReaderOptions options;
+        options.copy_locations = false;
+        options.position_recorder = &recorder;
+        TraceReader tr(trace_input, tw, 1, options);
+        tr.read();
+    }
+    recorder.index().write(index_file);
+
+    auto index = PositionIndex::read(index_file, trace_input);
+    REQUIRE(index.size() == 1);
+    REQUIRE(index.seek_position(0, 0) == 0);
+    REQUIRE(index.seek_position(0, 1) == 1);
+    REQUIRE(index.seek_position(0, 2) == 2);
+    REQUIRE(index.seek_position(0, OTF2_UNDEFINED_TIMESTAMP) == 4);
+    REQUIRE(index.seek_position(1, 2) == 0);
+
+    /*
+     * The Enter at time 0 is still open at the Enter at time 1.
+     */
+    const auto *sample = index.seek_sample(0, 2);
+    REQUIRE(sample != nullptr);
+    REQUIRE(sample->open.size() == 1);
+    REQUIRE(sample->open[0].type == EventType::Enter);
+    REQUIRE(sample->open[0].time == 0);
+
+    std::error_code ec;
+    auto write_window = [&](const PositionIndex *positions, TraceStats &stats) {
+        fs::remove_all(temp, ec);
+        fs::create_directory(temp);
+        {
+            TraceWriterOptions writer_options;
+            writer_options.stats = &stats;
+            TraceWriter tw(temp.string(), writer_options);
+            TimeWindowFilter filter({2, OTF2_UNDEFINED_TIMESTAMP});
+            tw.register_filter(filter);
+            REQUIRE(tw.eventsBegin() == 2);
+
+            TraceReaderOptions options;
+            options.positions = positions;
+            TraceReader tr(trace_input, tw, 1, options);
+            tr.read();
+        }
+        WindowHandler th;
+        TraceReader tr(trace_output, th);
+        tr.read();
+        REQUIRE(th.balanced());
+        return th.m_times;
+    };
+
+    /*
+     * The location is sought to the Enter at time 1, the Enter at time 0 is
+     * not decoded but replayed from the index. Both are written at the begin
+     * of the window, as without the index.
+     */
+    TraceStats stats;
+    auto       times = write_window(&index, stats);
+    REQUIRE(times == std::vector<OTF2_TimeStamp>{2, 2, 2, 3});
+
+    TraceStats unindexed_stats;
+    REQUIRE(write_window(nullptr, unindexed_stats) == times);
+
+    auto events = stats.events();
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.filtered[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.written[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(events.read[static_cast<std::size_t>(EventType::Leave)] == 2);
+    REQUIRE(events.written[static_cast<std::size_t>(EventType::Leave)] == 2);
+
+    fs::remove(index_file, ec);
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+class LocationCounter : public ITestHandler
+{
+  public:
+    virtual void
+    handleGlobalLocation(OTF2_LocationRef self,
+                         OTF2_StringRef name,
+                         OTF2_LocationType locationType,
+                         uint64_t numberOfEvents,
+                         OTF2_LocationGroupRef locationGroup) override
+    {
+        m_locations++;
+    }
+
+    virtual void
+    handleGlobalMetricInstance(OTF2_MetricRef self,
+                               OTF2_MetricRef metricClass,
+                               OTF2_LocationRef recorder,
+                               OTF2_MetricScope metricScope,
+                               uint64_t scope) override
+    {
+        m_metric_definitions++;
+    }
+
+    virtual void
+    handleGlobalMetricClassRecorder(OTF2_MetricRef metric, OTF2_LocationRef recorder) override
+    {
+        m_metric_definitions++;
+    }
+
+    std::size_t m_locations = 0;
+    std::size_t m_metric_definitions = 0;
+};
+
+TEST_CASE( "Test location selection", "[trace_write_location_selection]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+
+    LocationSelection selection;
+    uint64_t events = 0;
+    std::size_t locations = 0;
+
+    SECTION("selected by its group")
+    {
+        selection.add_group_pattern(std::string(TestTrace::LocationGroupName));
+        events = 4;
+        locations = 1;
+    }
+
+    SECTION("selected by the system tree node")
+    {
+        selection.add_group_pattern("My*");
+        selection.add_type(LocationSelection::parse_type("cpu_thread"));
+        events = 4;
+        locations = 1;
+    }
+
+    SECTION("not selected")
+    {
+        selection.add_location_pattern("Worker*");
+    }
+
+    SECTION("not of a selected type")
+    {
+        selection.add_type(LocationSelection::parse_type("gpu"));
+    }
+
+    TraceStats stats;
+    {
+        TraceWriterOptions writer_options;
+        writer_options.stats = &stats;
+        TraceWriter tw(temp.string(), writer_options);
+        tw.register_filter(selection);
+
+        TraceReaderOptions options;
+        options.copy_locations = false;
+        TraceReader tr(trace_input, tw, 1, options);
+        tr.read();
+        REQUIRE(tw.selectsLocation(0) == (locations == 1));
+
+        /*
+         * Metric definitions of the location are dropped with it.
+         */
+        tw.handleGlobalMetricClassRecorder(0, 0);
+        tw.handleGlobalMetricInstance(1, 0, 0, OTF2_SCOPE_LOCATION, 0);
+    }
+    REQUIRE(selection.dropped_locations() == 1 - locations);
+
+    auto counters = stats.events();
+    REQUIRE(counters.read[static_cast<std::size_t>(EventType::Enter)] +
+            counters.read[static_cast<std::size_t>(EventType::Leave)] == events);
+
+    LocationCounter th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+    REQUIRE(th.m_locations == locations);
+    REQUIRE(th.m_metric_definitions == 2 * locations);
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+namespace
+{
+class StaticLocationDropper
+{
+  public:
+    bool
+    operator()(record::GlobalLocation,
+               OTF2_LocationRef self,
+               OTF2_StringRef name,
+               OTF2_LocationType locationType,
+               uint64_t numberOfEvents,
+               OTF2_LocationGroupRef locationGroup)
+    {
+        return true;
+    }
+
+    TimeWindow
+    time_window() const
+    {
+        return {1, 2};
+    }
+};
+} // namespace
+
+TEST_CASE( "Test static location filter", "[trace_write_static_location]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+
+    {
+        StaticTraceWriter<StaticLocationDropper> tw(temp.string(), StaticLocationDropper{});
+        REQUIRE(tw.eventsBegin() == 1);
+        REQUIRE(tw.eventsEnd() == 2);
+
+        TraceReaderOptions options;
+        options.copy_locations = false;
+        TraceReader tr(trace_input, tw, 1, options);
+        tr.read();
+        REQUIRE(! tw.selectsLocation(0));
+
+        /*
+         * Metric definitions of the location are dropped with it, as with
+         * the filters registered at a TraceWriter.
+         */
+        tw.handleGlobalMetricClassRecorder(0, 0);
+        tw.handleGlobalMetricInstance(1, 0, 0, OTF2_SCOPE_LOCATION, 0);
+    }
+
+    LocationCounter th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+    REQUIRE(th.m_locations == 0);
+    REQUIRE(th.m_metric_definitions == 0);
+
+    /*
+     * The clock properties are shrunk to the window of the filter.
+     */
+    WindowHandler window;
+    TraceReader window_reader(trace_output, window);
+    window_reader.read();
+    REQUIRE(window.m_offset == 1);
+    REQUIRE(window.m_length == 1);
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}
+
+namespace
+{
+class EnterLeaveDropper : public IFilterCallbacks
+{
+  public:
+    virtual Callbacks
+    get_callbacks() override
+    {
+        return {};
+    }
+
+    virtual std::vector<EventType>
+    dropped_event_types() const override
+    {
+        return {EventType::Enter, EventType::Leave};
+    }
+};
+} // namespace
+
+TEST_CASE( "Test dropped event types", "[trace_write_dropped_events]" )
+{
+    auto temp = fs::temp_directory_path();
+    temp += fs::path("/temp_trace");
+    fs::create_directory(temp);
+    REQUIRE(fs::is_directory(temp));
+
+    std::string trace_input(TestTrace::TestTracePath);
+    trace_input += std::string("/") + std::string(TestTrace::TestTraceName) + std::string(".otf2");
+    fs::path trace_output(temp);
+    trace_output += fs::path("/trace.otf2");
+
+    RecordClassFilter record_classes;
+    record_classes.add_class(RecordClass::OpenMp);
+    record_classes.add_class(RecordClass::Rma);
+    EnterLeaveDropper dropper;
+
+    TraceStats stats;
+    {
+        TraceWriterOptions writer_options;
+        writer_options.stats = &stats;
+        TraceWriter tw(temp.string(), writer_options);
+        tw.register_filter(record_classes);
+        tw.register_filter(dropper);
+        REQUIRE(! tw.handlesEvent(EventType::OmpFork));
+        REQUIRE(! tw.handlesEvent(EventType::RmaPut));
+        REQUIRE(! tw.handlesEvent(EventType::Enter));
+        REQUIRE(tw.handlesEvent(EventType::ThreadFork));
+        REQUIRE(tw.handlesEvent(EventType::IoOperationBegin));
+
+        TraceReader tr(trace_input, tw);
+        tr.read();
+
+        /*
+         * Attribute values referring to the dropped RMA windows are removed
+         * from the written events.
+         */
+        OTF2_AttributeList *attributes = OTF2_AttributeList_New();
+        OTF2_AttributeList_AddRmaWinRef(attributes, 0, 0);
+        OTF2_AttributeList_AddUint64(attributes, 1, 42);
+        tw.handleProgramEndEvent(0, 3, attributes, 0);
+        REQUIRE(OTF2_AttributeList_GetNumberOfElements(attributes) == 1);
+        OTF2_AttributeList_Delete(attributes);
+    }
+
+    /*
+     * The events are skipped while decoding, the writer never sees them.
+     */
+    auto counters = stats.events();
+    REQUIRE(counters.read[static_cast<std::size_t>(EventType::Enter)] == 0);
+    REQUIRE(counters.read[static_cast<std::size_t>(EventType::Leave)] == 0);
+
+    WindowHandler th;
+    TraceReader tr(trace_output, th);
+    tr.read();
+    REQUIRE(th.m_times.empty());
+
+    TraceStats dry_run_stats;
+    DryRunHandler handler(dry_run_stats);
+    handler.register_filter(dropper);
+    REQUIRE(handler.handlesEvent(EventType::Enter));
+    TraceReader dry_run(trace_input, handler);
+    dry_run.read();
+    REQUIRE(dry_run_stats.events().filtered[static_cast<std::size_t>(EventType::Enter)] == 2);
+    REQUIRE(handler.locations().at(0).dropped == 4);
+
+    std::error_code ec;
+    auto err = fs::remove_all(trace_output.parent_path(), ec);
+    REQUIRE(err != static_cast<std::uintmax_t>(-1));
+}